@@ -7,35 +7,40 @@
   
   KEY FEATURES:
   ✓ Voice: Record → Whisper transcription → GPT-4 chat → Google TTS playback
-  ✓ Alarms: Schedule with countdown, RTTTL audio, one-touch cancellation
+  ✓ Alarms: Many named, recurring, persistent alarms with snooze, on-device RTTTL tone
   ✓ Camera: OV3660 with MJPEG streaming and vision integration
   ✓ Display: 128x64 OLED with animated eyes and status info
   ✓ UI: Web dashboard with real-time WebSocket synchronization
-  ✓ Storage: Persistent chat history and todo lists in SPIFFS
+  ✓ Storage: Persistent chat history and journaled todo lists in SPIFFS
   ✓ Touch: Single/double-tap detection with multi-mode support
   ✓ Networking: WiFi + OTA updates
   
   HARDWARE: Seeed XIAO ESP32S3 with OV3660 camera module
   
-  CODE ORGANIZATION:
-  - Line 103:        Embedded web UI (HTML/CSS/JS in PROGMEM)
-  - Lines 1-450:     Configuration, includes, defines, data structures
-  - Lines 450-700:   Utility functions and state management
-  - Lines 700-1000:  WebSocket/HTTP broadcasting functions
-  - Lines 1000-1300: Initialization (setup)
-  - Lines 1300-1700: Audio processing pipeline (with state broadcast fixes)
-  - Lines 1700-2000: HTTP request handlers
-  - Lines 2000-2300: Main event loop
-  - Lines 2300-2700: Audio I/O (recording, transcription, TTS)
-  - Lines 2700+:     Display and animation engine
+  CODE ORGANIZATION (this file, in order; sections start with "// ========== NAME"):
+  - Configuration, includes, defines, data structures, state machines, event bus
+  - UI & state synchronization: WebSocket deltas, dashboard broadcasts
+  - Camera frame broker: MJPEG capture and per-viewer sender tasks
+  - Initialization (setup)
+  - Tool registry: tool schemas and handlers (alarms, todos, weather, search)
+  - Audio processing pipeline: transcript → intent / chat → speech
+  - HTTP request handlers, background NTP sync
+  - Voice pipeline (main loop) and web server task
+  - Chat request serialization and streaming chat (server-sent events)
+  - Pipelined Whisper upload
+  - Sentence speech queue, speech clip cache, audio playback task
+  - Display & animation engine
+  Engine modules live in the headers next to this file (audio_ring.h, vad.h,
+  alarm_scheduler.h, ...). The web dashboard is web_assets.h, generated from
+  assets/web/ by tools/web_compiler.py.
   
   MAIN FLOW:
   1. User touches button → recordAudio() captures voice
   2. Audio → transcribeWithWhisper() → text
-  3. Text → processAudio() → chatWithGpt() → response
-  4. Response → speakText() → TTS playback
-  5. All state changes broadcast via WebSocket to web clients
-  6. OLED updates show animated feedback
+  3. Text → processAudio() → local intent match, else chatWithGpt() → response
+  4. Response → speakText() → TTS playback (from the flash speech cache when possible)
+  5. All state changes published on the event bus; the web task pushes them to clients
+  6. The display task shows animated feedback and samples the touch pad
   
   DEPENDENCIES:
   - Audio library (ESP32 audio streaming)
@@ -65,10 +70,29 @@
 #include <Wire.h>
 #include <math.h>
 #include "esp_camera.h"
-#include "base64.h"
 #include <map>
 #include <SPIFFS.h>
 #include <WebSocketsServer.h>
+#include <atomic>
+#include <deque>
+#include "api_connection.h"
+#include "api_response.h"
+#include "audio_ring.h"
+#include "vad.h"
+#include "flac_encoder.h"
+#include "chat_ring.h"
+#include "frame_broker.h"
+#include "display_renderer.h"
+#include "sprites.h"
+#include "event_bus.h"
+#include "tts_cache.h"
+#include "tone_synth.h"
+#include "result_cache.h"
+#include "intent_matcher.h"
+#include "alarm_scheduler.h"
+#include "todo_store.h"
+#include "metrics.h"
+#include "web_assets.h"
 
 #define I2S_PDM_CLK_PIN 42
 #define I2S_PDM_DATA_PIN 41
@@ -100,105 +124,26 @@
 #define HREF_GPIO_NUM 47
 #define PCLK_GPIO_NUM 13
 
-// ========== EMBEDDED WEB FILES (For Arduino IDE compatibility without SPIFFS) ==========
-const char INDEX_HTML[] PROGMEM = R"EMBEDDEDHTML(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Kiko - AI Assistant</title>
-    <style>
-:root{--bg-dark:#0a0e27;--bg-card:#1e2139;--primary:#00d4ff;--primary-light:#4fc1ff;--accent:#667eea;--text-main:#e8eaed;--text-dim:#999;--state-idle:#667eea;--state-listening:#f5576c;--state-thinking:#ffa500;--state-speaking:#43e97b;--state-alarm:#fa709a;--state-surveillance:#ff3333;--border-glow:rgba(0,212,255,.2);--border-glow-strong:rgba(0,212,255,.4)}*{margin:0;padding:0;box-sizing:border-box}html{font-size:16px}body{font-family:system-ui,-apple-system,sans-serif;background:linear-gradient(135deg,var(--bg-dark) 0%,#0f1432 100%);color:var(--text-main);line-height:1.6;min-height:100vh;overflow-x:hidden}.container{max-width:1200px;margin:0 auto;padding:20px}.header{background:linear-gradient(135deg,rgba(0,212,255,.12) 0%,rgba(79,193,255,.08) 100%);padding:40px 30px;border-radius:16px;border:1px solid var(--border-glow);margin-bottom:30px;text-align:center;box-shadow:0 8px 32px rgba(0,0,0,.3),inset 0 1px 1px rgba(255,255,255,.1);backdrop-filter:blur(10px)}.header h1{font-size:clamp(2em,5vw,3em);color:var(--primary);margin-bottom:8px;font-weight:700;letter-spacing:2px;text-shadow:0 0 20px rgba(0,212,255,.4)}.header p{color:var(--primary-light);font-size:.95em;letter-spacing:1px}.mic-icon{display:inline-block;font-size:1.3em;margin-right:12px;animation:float 3s ease-in-out infinite}@keyframes float{0%,100%{transform:translateY(0)}50%{transform:translateY(-8px)}}.tabs{display:flex;gap:8px;margin-bottom:30px;border-bottom:2px solid var(--border-glow);padding-bottom:12px;overflow-x:auto;scroll-behavior:smooth}.tabs::-webkit-scrollbar{height:4px}.tabs::-webkit-scrollbar-track{background:0}.tabs::-webkit-scrollbar-thumb{background:var(--primary);border-radius:2px}.tab-btn{background:0;color:var(--text-dim);border:none;padding:12px 24px;cursor:pointer;font-size:.95em;font-weight:500;border-bottom:3px solid transparent;transition:all .3s cubic-bezier(.4,0,.2,1);white-space:nowrap;position:relative}.tab-btn:hover{color:var(--primary)}.tab-btn.active{color:var(--primary);border-bottom-color:var(--primary)}.tab-btn.active::after{content:'';position:absolute;bottom:-12px;left:0;right:0;height:1px;background:radial-gradient(ellipse at center,var(--primary) 0%,transparent 70%);filter:blur(1px)}.tab-content{display:none;animation:fadeInDown .4s cubic-bezier(.4,0,.2,1)}.tab-content.active{display:block}@keyframes fadeInDown{from{opacity:0;transform:translateY(10px)}to{opacity:1;transform:translateY(0)}}.card{background:rgba(30,33,57,.8);border:1px solid var(--border-glow);border-radius:14px;padding:28px;margin-bottom:25px;box-shadow:0 10px 40px rgba(0,0,0,.3),inset 0 1px 1px rgba(255,255,255,.05);backdrop-filter:blur(10px);transition:all .3s cubic-bezier(.4,0,.2,1)}.card:hover{border-color:var(--border-glow-strong);box-shadow:0 15px 50px rgba(0,212,255,.15),inset 0 1px 1px rgba(255,255,255,.05)}.card h2{color:var(--primary);font-size:1.35em;margin-bottom:18px;display:flex;align-items:center;gap:12px;font-weight:600;letter-spacing:.5px}.card h2::before{content:'';display:inline-block;width:4px;height:1.3em;background:linear-gradient(180deg,var(--primary) 0%,var(--primary-light) 100%);border-radius:2px}.state-badge{display:inline-block;padding:16px 36px;border-radius:30px;font-size:clamp(1em,2.5vw,1.2em);font-weight:700;text-align:center;margin:20px auto;letter-spacing:1px;box-shadow:0 8px 25px rgba(0,0,0,.3);transition:all .3s ease;text-transform:uppercase}.state-idle{background:linear-gradient(135deg,var(--state-idle) 0%,#8b9ef6 100%);color:#fff;box-shadow:0 8px 25px rgba(102,126,234,.3)}.state-listening{background:linear-gradient(135deg,var(--state-listening) 0%,#ff7a8e 100%);color:#fff;box-shadow:0 0 25px rgba(245,87,108,.5);animation:pulse-listening 1s ease-in-out infinite}@keyframes pulse-listening{0%,100%{box-shadow:0 0 25px rgba(245,87,108,.5)}50%{box-shadow:0 0 50px rgba(245,87,108,.8)}}.state-thinking{background:linear-gradient(135deg,var(--state-thinking) 0%,#ffb84d 100%);color:#000;box-shadow:0 0 25px rgba(255,165,0,.5);animation:pulse-thinking 1.5s ease-in-out infinite}@keyframes pulse-thinking{0%,100%{box-shadow:0 0 25px rgba(255,165,0,.5)}50%{box-shadow:0 0 50px rgba(255,165,0,.8)}}.state-speaking{background:linear-gradient(135deg,var(--state-speaking) 0%,#61f5a6 100%);color:#000;box-shadow:0 8px 25px rgba(67,233,123,.4);animation:pulse-speaking .8s ease-in-out infinite}@keyframes pulse-speaking{0%,100%{box-shadow:0 8px 25px rgba(67,233,123,.4)}50%{box-shadow:0 8px 40px rgba(67,233,123,.7)}}.state-alarming{background:linear-gradient(135deg,var(--state-alarm) 0%,#ff5a82 100%);color:#fff;box-shadow:0 0 25px rgba(250,112,154,.6);animation:pulse-alarm .5s ease-in-out infinite;font-size:1.4em;font-weight:800}@keyframes pulse-alarm{0%,100%{box-shadow:0 0 25px rgba(250,112,154,.6);transform:scale(1)}50%{box-shadow:0 0 50px rgba(250,112,154,1);transform:scale(1.02)}}@keyframes alarm-ring{0%,100%{box-shadow:0 0 40px rgba(255,59,48,.6),inset 0 0 20px rgba(255,59,48,.2);transform:scale(1)}50%{box-shadow:0 0 60px rgba(255,59,48,.9),inset 0 0 30px rgba(255,59,48,.4);transform:scale(1.03)}}.state-surveillance{background:linear-gradient(135deg,var(--state-surveillance) 0%,#ff6666 100%);color:#fff;box-shadow:0 0 30px rgba(255,51,51,.6);border:2px solid var(--state-surveillance)}#transcription{background:rgba(0,212,255,.08);padding:18px;border-radius:10px;min-height:50px;border:2px dashed var(--primary);font-style:italic;color:var(--primary-light);font-size:.95em;word-wrap:break-word;transition:all .3s ease}#transcription.active{background:rgba(0,212,255,.15);border-style:solid;border-color:var(--primary);box-shadow:inset 0 0 15px rgba(0,212,255,.1)}#chatList{max-height:450px;overflow-y:auto;border:1px solid var(--border-glow);border-radius:10px;padding:15px;background:rgba(0,0,0,.2)}#chatList::-webkit-scrollbar{width:6px}#chatList::-webkit-scrollbar-track{background:rgba(0,212,255,.05);border-radius:3px}#chatList::-webkit-scrollbar-thumb{background:rgba(0,212,255,.3);border-radius:3px}#chatList::-webkit-scrollbar-thumb:hover{background:rgba(0,212,255,.5)}.chat-msg{padding:12px 16px;margin-bottom:12px;border-radius:10px;word-wrap:break-word;animation:slideIn .3s ease;display:flex;align-items:flex-start;gap:10px}@keyframes slideIn{from{opacity:0;transform:translateX(-10px)}to{opacity:1;transform:translateX(0)}}.msg-icon{font-size:1.5em;min-width:24px;text-align:center;flex-shrink:0}.msg-text{flex:1;word-wrap:break-word}.chat-user{background:linear-gradient(135deg,rgba(102,126,234,.2) 0%,rgba(118,75,162,.1) 100%);border-left:3px solid var(--accent);justify-content:flex-end;flex-direction:row-reverse}.chat-user .msg-icon{color:var(--accent)}.chat-ai{background:linear-gradient(135deg,rgba(0,212,255,.15) 0%,rgba(79,193,255,.08) 100%);border-left:3px solid var(--primary)}.chat-ai .msg-icon{color:var(--primary)}#alarmCountdown{font-size:clamp(2em,6vw,3em);font-weight:900;color:var(--state-alarm);text-align:center;font-family:'Courier New',monospace;padding:24px;background:linear-gradient(135deg,rgba(255,107,107,.12) 0%,rgba(255,193,7,.08) 100%);border-radius:12px;border:2px solid rgba(255,107,107,.3);letter-spacing:2px;transition:all .3s ease}#alarmCountdown.active{box-shadow:0 0 30px rgba(250,112,154,.4),inset 0 0 15px rgba(255,107,107,.1);animation:pulse-alarm .6s ease-in-out infinite}#alarmCountdown.alarm-ringing{background:linear-gradient(135deg,rgba(255,59,48,.25) 0%,rgba(255,87,34,.15) 100%);border-color:rgba(255,59,48,.6);box-shadow:0 0 40px rgba(255,59,48,.6),inset 0 0 20px rgba(255,59,48,.2);animation:alarm-ring .4s ease-in-out infinite}#alarmCountdown.alarm-about-to-ring{background:linear-gradient(135deg,rgba(255,152,0,.2) 0%,rgba(255,193,7,.15) 100%);border-color:rgba(255,193,7,.5);animation:pulse-alarm .5s ease-in-out infinite}.alarm-inactive{color:var(--state-speaking);font-size:1.1em;animation:none;box-shadow:none}.todo-list{background:linear-gradient(135deg,rgba(0,212,255,.08) 0%,rgba(79,193,255,.05) 100%);padding:18px;border-radius:10px;border-left:4px solid var(--primary);margin-bottom:18px;box-shadow:inset 0 1px 1px rgba(255,255,255,.05);transition:all .3s ease}.todo-list:hover{background:linear-gradient(135deg,rgba(0,212,255,.12) 0%,rgba(79,193,255,.08) 100%);border-left-color:var(--primary-light)}.todo-list h3{color:var(--primary);font-size:1.05em;margin-bottom:12px;text-transform:capitalize;font-weight:600}.todo-item{padding:10px 12px;background:rgba(255,255,255,.03);border-radius:6px;margin-bottom:6px;display:flex;justify-content:space-between;align-items:center;font-size:.95em;transition:all .2s ease;border-left:2px solid var(--primary-light)}.todo-item:hover{background:rgba(255,255,255,.06);padding-left:14px}.todo-item .qty{background:linear-gradient(135deg,var(--primary) 0%,var(--primary-light) 100%);color:#000;padding:3px 10px;border-radius:12px;font-weight:700;font-size:.8em;min-width:35px;text-align:center;box-shadow:0 4px 12px rgba(0,212,255,.2)}#gallery{display:grid;grid-template-columns:repeat(auto-fill,minmax(250px,1fr));gap:16px;max-height:550px;overflow-y:auto}#gallery::-webkit-scrollbar{width:6px}#gallery::-webkit-scrollbar-track{background:rgba(0,212,255,.05)}#gallery::-webkit-scrollbar-thumb{background:rgba(0,212,255,.3);border-radius:3px}.gallery-item{border-radius:12px;overflow:hidden;border:2px solid var(--border-glow);transition:all .3s cubic-bezier(.4,0,.2,1);box-shadow:0 8px 20px rgba(0,0,0,.3)}.gallery-item:hover{border-color:var(--primary);box-shadow:0 12px 40px rgba(0,212,255,.2);transform:translateY(-4px)}.gallery-item img{width:100%;height:auto;display:block;transition:transform .3s ease}.gallery-item:hover img{transform:scale(1.05)}#cameraContainer{position:relative;border-radius:12px;overflow:hidden;border:2px solid var(--border-glow);box-shadow:0 10px 40px rgba(0,0,0,.3)}#cameraContainer.active{border-color:var(--state-surveillance);box-shadow:0 0 30px rgba(255,51,51,.3)}#cameraFeed{width:100%;height:auto;display:block;border-radius:10px;border:1px solid var(--border-glow)}.btn{background:rgba(0,212,255,.15);color:var(--primary);border:1.5px solid var(--primary);padding:12px 28px;border-radius:8px;cursor:pointer;font-size:.9em;font-weight:600;transition:all .3s cubic-bezier(.4,0,.2,1);margin-top:18px;letter-spacing:.5px}.btn:hover{background:rgba(0,212,255,.25);box-shadow:0 6px 20px rgba(0,212,255,.2);transform:translateY(-2px)}.btn:active{transform:translateY(0);box-shadow:0 3px 10px rgba(0,212,255,.15)}.btn-danger{background:rgba(255,107,107,.15);color:#ff6b6b;border-color:#ff6b6b}.btn-danger:hover{background:rgba(255,107,107,.25);box-shadow:0 6px 20px rgba(255,107,107,.2)}.empty{text-align:center;padding:50px 20px;color:var(--text-dim)}.empty p{margin:10px 0;font-size:.95em}@media (max-width:768px){.container{padding:15px}.header{padding:25px 20px;margin-bottom:20px}.header h1{font-size:1.8em}.card{padding:18px;margin-bottom:18px}.card h2{font-size:1.15em;margin-bottom:12px}.tabs{gap:4px;margin-bottom:20px;padding-bottom:8px}.tab-btn{padding:10px 16px;font-size:.85em}.state-badge{padding:12px 24px;font-size:1em}#chatList{max-height:300px}#gallery{grid-template-columns:1fr;max-height:400px}#alarmCountdown{font-size:2em;padding:18px}.btn{padding:10px 20px;font-size:.85em}}@media (max-width:480px){html{font-size:14px}.container{padding:12px}.header{padding:20px 15px}.header h1{font-size:1.5em}.card{padding:15px}.tabs{gap:2px}.tab-btn{padding:8px 12px;font-size:.75em}#transcription{font-size:.85em}.state-badge{padding:10px 18px;font-size:.9em}}@media (prefers-reduced-motion:reduce){*,*::before,*::after{animation-duration:.01ms!important;animation-iteration-count:1!important;transition-duration:.01ms!important}}
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="header">
-            <h1><span class="mic-icon">🎤</span> Kiko</h1>
-            <p>Smart Voice Assistant</p>
-        </div>
-        
-        <div class="tabs">
-            <button class="tab-btn active" data-tab="status">Status</button>
-            <button class="tab-btn" data-tab="chat">Chat</button>
-            <button class="tab-btn" data-tab="gallery">Gallery</button>
-            <button class="tab-btn" data-tab="camera">Camera</button>
-            <button class="tab-btn" data-tab="tasks">Tasks</button>
-        </div>
-        
-        <div class="tab-content active" id="tab-status">
-            <div class="card">
-                <h2>Current State</h2>
-                <div style="text-align: center;">
-                    <div class="state-badge state-idle" id="stateBadge">Idle</div>
-                </div>
-            </div>
-            <div class="card">
-                <h2>Live Transcription</h2>
-                <div id="transcription">Waiting for voice input...</div>
-            </div>
-        </div>
-        
-        <div class="tab-content" id="tab-chat">
-            <div class="card">
-                <h2>Conversation History</h2>
-                <div id="chatList" class="empty"><p>No messages yet.</p></div>
-                <button class="btn btn-danger" onclick="clearChat()">Clear History</button>
-            </div>
-        </div>
-        
-        <div class="tab-content" id="tab-gallery">
-            <div class="card">
-                <h2>Captured Images</h2>
-                <div id="gallery" class="empty"><p>No images yet.</p></div>
-                <button class="btn btn-danger" onclick="clearGallery()">Clear Gallery</button>
-            </div>
-        </div>
-        
-        <div class="tab-content" id="tab-camera">
-            <div class="card">
-                <h2>Live Camera Feed</h2>
-                <div id="cameraContainer" class="empty"><p>Camera not active.</p></div>
-            </div>
-        </div>
-        
-        <div class="tab-content" id="tab-tasks">
-            <div class="card">
-                <h2>Active Alarm</h2>
-                <div id="alarmCountdown" class="alarm-inactive">No alarm set</div>
-                <button class="btn btn-danger" id="clearAlarmBtn" onclick="clearAlarm()" style="margin-top: 12px; display: none;">Clear Alarm</button>
-            </div>
-            <div class="card">
-                <h2>To-Do Lists</h2>
-                <div id="todoLists" class="empty"><p>No lists.</p></div>
-                <button class="btn btn-danger" onclick="clearTodos()">Clear Todos</button>
-            </div>
-        </div>
-    </div>
-    
-    <script>
-const state={currentTab:'status',ws:null,wsAttempts:0,maxWsAttempts:10,wsRetryDelay:3000,lastState:null,alarmInterval:null};document.addEventListener('DOMContentLoaded',()=>{initTabNavigation();initWebSocket();updateUI()});function initWebSocket(){const protocol=window.location.protocol==='https:'?'wss:':'ws:';const host=window.location.hostname;const wsUrl=protocol+'//'+host+':81';try{state.ws=new WebSocket(wsUrl);state.ws.onopen=()=>{console.log('Connected');state.wsAttempts=0;updateStatusIndicator(true)};state.ws.onmessage=(event)=>{try{const data=JSON.parse(event.data);handleMessage(data)}catch(e){console.error('Failed to parse message:',e)}};state.ws.onerror=(error)=>{console.error('WebSocket error:',error);updateStatusIndicator(false)};state.ws.onclose=()=>{console.log('Disconnected');updateStatusIndicator(false);reconnectWebSocket()}}catch(e){console.error('Failed to create WebSocket:',e);reconnectWebSocket()}}function reconnectWebSocket(){if(state.wsAttempts<state.maxWsAttempts){state.wsAttempts++;setTimeout(()=>{initWebSocket()},state.wsRetryDelay)}}function handleMessage(data){if(data.history&&Array.isArray(data.history)){const chatList=document.getElementById('chatList');if(chatList){chatList.innerHTML='';const filteredMessages=data.history.filter(msg=>msg.role==='user'||msg.role==='assistant');if(filteredMessages.length===0){chatList.innerHTML='<p class="empty">No messages yet.</p>'}else{const lastMessages=filteredMessages.slice(-10);lastMessages.forEach(msg=>{addChatMessage(msg.role,msg.content)})}}}if(data.state)updateState(data.state);if(data.transcript!==undefined)updateTranscription(data.transcript);if(data.alarm_time!==undefined||data.alarm!==undefined||data.is_ringing!==undefined){updateAlarm(data.alarm_time,data.alarm,data.is_ringing,data.remaining)}if(data.lists)updateTodoLists(data.lists);if(data.camera_mode!==undefined)updateCameraMode(data.camera_mode);if(data.message)addChatMessage(data.message.role,data.message.content);if(data.image_ready)loadLastCapturedImage();if(data.gallery&&Array.isArray(data.gallery)){const gallery=document.getElementById('gallery');if(gallery){gallery.innerHTML='';if(data.gallery.length===0){gallery.innerHTML='<div class="empty"><p>No images yet.</p></div>'}}}if(data.image_url)addGalleryImage(data.image_url)}function updateState(newState){if(state.lastState===newState)return;state.lastState=newState;const badge=document.getElementById('stateBadge');if(!badge)return;badge.textContent=newState;badge.className='state-badge';const stateMap={'idle':'state-idle','listening':'state-listening','thinking':'state-thinking','speaking':'state-speaking','alarming':'state-alarming','surveillance':'state-surveillance'};badge.classList.add(stateMap[newState.toLowerCase()]||'state-idle')}function updateTranscription(text){const element=document.getElementById('transcription');if(!element)return;if(text.trim()){element.textContent=text;element.classList.add('active')}else{element.textContent='Waiting for voice input...';element.classList.remove('active')}}function updateAlarm(alarmTime,isActive,isRinging,serverRemaining){const element=document.getElementById('alarmCountdown');const clearBtn=document.getElementById('clearAlarmBtn');if(!element)return;if(state.alarmInterval){clearInterval(state.alarmInterval);state.alarmInterval=null}if(!isActive||!alarmTime){element.textContent='No alarm set';element.className='alarm-inactive';if(clearBtn)clearBtn.style.display='none';return}if(clearBtn)clearBtn.style.display='block';if(isRinging){element.textContent='ALARM';element.classList.remove('alarm-inactive');element.classList.add('alarm-ringing');return}element.classList.remove('alarm-inactive','alarm-ringing');element.classList.add('active');let baseRemaining=serverRemaining?serverRemaining*1000:0;let lastUpdateTime=Date.now();function updateCountdown(){const now=Date.now();const elapsed=now-lastUpdateTime;baseRemaining=Math.max(0,baseRemaining-elapsed);lastUpdateTime=now;if(baseRemaining<=0){element.textContent='00:00';element.classList.add('alarm-about-to-ring');clearInterval(state.alarmInterval);return}const minutes=Math.floor(baseRemaining/60000);const seconds=Math.floor((baseRemaining%60000)/1000);element.textContent=String(minutes).padStart(2,'0')+':'+String(seconds).padStart(2,'0')}updateCountdown();state.alarmInterval=setInterval(updateCountdown,1000)}function clearAlarm(){showConfirm('Cancel alarm?',async ()=>{try{const response=await fetch('/api/alarm/cancel',{method:'POST'});if(response.ok){const clearBtn=document.getElementById('clearAlarmBtn');if(clearBtn)clearBtn.style.display='none'}}catch(e){console.error('Failed:',e)}},'Cancel')}function updateTodoLists(lists){const container=document.getElementById('todoLists');if(!container)return;if(!lists||Object.keys(lists).length===0){container.innerHTML='<div class="empty"><p>No lists yet.</p></div>';return}let html='';for(const[listName,items]of Object.entries(lists)){html+='<div class="todo-list"><h3>'+escapeHtml(listName)+'</h3>';if(items&&Object.keys(items).length>0){html+='<div>';for(const[itemName,quantity]of Object.entries(items)){const qty=parseInt(quantity)||0;html+='<div class="todo-item"><span>'+escapeHtml(itemName)+'</span><span class="qty">('+qty+')</span></div>'}html+='</div>'}else{html+='<p style="color:#999;">Empty</p>'}html+='</div>'}container.innerHTML=html}function updateCameraMode(mode){const container=document.getElementById('cameraContainer');if(!container)return;if(window.cameraRefreshInterval){clearInterval(window.cameraRefreshInterval);window.cameraRefreshInterval=null}if(mode==='live'||mode==='surveillance'){container.innerHTML='<img id="cameraFeed" src="/stream" alt="Camera" style="width: 100%; border-radius: 8px; margin-top: 10px;">';container.classList.add('active');switchTab('camera')}else{container.classList.remove('active');container.innerHTML='<div class="empty"><p>Camera inactive.</p></div>'}}function addChatMessage(role,content){if(role!=='user'&&role!=='assistant')return;const list=document.getElementById('chatList');if(!list)return;if(role==='assistant'){try{const parsed=JSON.parse(content);if(parsed.tool_calls)return}catch(e){}}const empty=list.querySelector('.empty');if(empty)empty.remove();const msg=document.createElement('div');msg.className='chat-msg chat-'+(role==='user'?'user':'ai');const icon=role==='user'?'👤':'🤖';msg.innerHTML='<span class="msg-icon">'+icon+'</span><span class="msg-text">'+escapeHtml(content)+'</span>';const chatMessages=list.querySelectorAll('.chat-msg');if(chatMessages.length>=10)chatMessages[0].remove();list.appendChild(msg);list.scrollTop=list.scrollHeight}function escapeHtml(text){const map={'&':'&amp;','<':'&lt;','>':'&gt;','"':'&quot;',"'":'&#039;'};return text.replace(/[&<>"']/g,m=>map[m])}function clearChat(){showConfirm('Clear chat?',async ()=>{await fetch('/clear_chat');document.getElementById('chatList').innerHTML='<p class="empty">No messages.</p>'})}function loadLastCapturedImage(){const gallery=document.getElementById('gallery');if(!gallery)return;const img=document.createElement('img');img.src='/last_image.jpg?t='+Date.now();img.alt='Image';const existing=gallery.querySelector('img');const empty=gallery.querySelector('.empty');if(existing)existing.remove();if(empty)empty.remove();gallery.appendChild(img);switchTab('gallery')}function addGalleryImage(imageUrl){const gallery=document.getElementById('gallery');if(!gallery)return;const empty=gallery.querySelector('.empty');if(empty)empty.remove();const item=document.createElement('div');item.className='gallery-item';item.innerHTML='<img src="'+escapeHtml(imageUrl)+'" alt="Image">';gallery.appendChild(item)}function clearGallery(){showConfirm('Clear gallery?',async ()=>{await fetch('/clear_gallery');document.getElementById('gallery').innerHTML='<p class="empty">No images.</p>'})}function clearTodos(){showConfirm('Clear todos?',async ()=>{await fetch('/clear_todos');document.getElementById('todoLists').innerHTML='<div class="empty"><p>No lists.</p></div>'})}function initTabNavigation(){const buttons=document.querySelectorAll('.tab-btn');buttons.forEach(btn=>{btn.addEventListener('click',()=>{const tab=btn.getAttribute('data-tab');switchTab(tab)})})}function switchTab(tabName){state.currentTab=tabName;document.querySelectorAll('.tab-btn').forEach(btn=>{if(btn.getAttribute('data-tab')===tabName){btn.classList.add('active')}else{btn.classList.remove('active')}});document.querySelectorAll('.tab-content').forEach(content=>{if(content.id==='tab-'+tabName){content.classList.add('active')}else{content.classList.remove('active')}})}function sendMessage(data){if(state.ws&&state.ws.readyState===WebSocket.OPEN){state.ws.send(JSON.stringify(data))}}function updateStatusIndicator(connected){console.log(connected?'Connected':'Disconnected')}function updateUI(){const transcription=document.getElementById('transcription');if(transcription)transcription.textContent='Waiting...';const alarm=document.getElementById('alarmCountdown');if(alarm){alarm.textContent='No alarm';alarm.className='alarm-inactive'}const chat=document.getElementById('chatList');if(chat)chat.innerHTML='<p class="empty">No messages.</p>';const gallery=document.getElementById('gallery');if(gallery)gallery.innerHTML='<p class="empty">No images.</p>';const todos=document.getElementById('todoLists');if(todos)todos.innerHTML='<div class="empty"><p>No lists.</p></div>';const camera=document.getElementById('cameraContainer');if(camera)camera.innerHTML='<div class="empty"><p>Inactive.</p></div>';const badge=document.getElementById('stateBadge');if(badge){badge.textContent='Idle';badge.className='state-badge state-idle'}}setInterval(()=>{if(state.ws&&state.ws.readyState===WebSocket.OPEN&&state.lastState!=='Surveillance'){sendMessage({type:'ping'})}},30000);setInterval(()=>{if(state.ws&&state.ws.readyState===WebSocket.OPEN){sendMessage({type:'refresh_chat'});sendMessage({type:'refresh_gallery'})}},5000);function showConfirm(message,onConfirm,buttonText='Proceed'){if(confirm(message))onConfirm()}if(typeof module!=='undefined'&&module.exports){module.exports={updateState,addChatMessage,switchTab}}
-    </script>
-</body>
-</html>
-)EMBEDDEDHTML";
-
 WebServer server(80);
 WebSocketsServer webSocket = WebSocketsServer(81);
 
-std::vector<String> transactionHistory; 
 int alarmUpdateCounter = 0;   
-const int MAX_HISTORY_SIZE = 10;    
-std::map<String, std::map<String, int>> todoLists;
 
-struct ChatMessage {
-  String role;
-  String content;
-  String tool_call_id; 
-};
-std::vector<ChatMessage> chatHistory;
-const int MAX_HISTORY_MESSAGES = 50; 
+// Todo lists (see todo_store.h): every edit is appended to a journal; the journal is
+// folded into a snapshot once it outgrows it. Guarded by AppDataGuard.
+TodoStore todoStore;
+#define TODO_SNAPSHOT_PATH "/todo.snap"
+#define TODO_SNAPSHOT_TMP_PATH "/todo.snap.tmp"
+#define TODO_JOURNAL_PATH "/todo.log"
+#define TODO_LEGACY_PATH "/todo_lists.json"
+#define TODO_COMPACT_MIN_BYTES 4096
+size_t todoJournalSize = 0;
+size_t todoSnapshotSize = 0;
+
+// Conversation memory lives in a fixed PSRAM ring (see chat_ring.h). Each request
+// sends only the newest messages that fit the token budget.
+ChatHistoryRing chatRing;
+#define CHAT_CONTEXT_TOKEN_BUDGET 1200
 
 
 struct GptToolCall {
@@ -211,277 +156,255 @@ struct GptResponse {
   String textToSpeak;
   std::vector<GptToolCall> toolCalls; 
   String rawAssistantMessage; 
+  bool alreadySpoken = false;  // Text was played sentence-by-sentence while streaming
 };
 
 const char DEFAULT_INTRODUCTION[] PROGMEM = "Hello, I'm Kiko, your AI assistant, ready to help, What would you like me to do?";
 
-std::vector<uint8_t> lastCapturedImage;
+// Fixed replies; preloaded into the speech cache so they play without the network
+const char PHRASE_TAKING_A_LOOK[] PROGMEM = "Sure thing! Let me take a look.";
+const char PHRASE_STOPPED_WATCHING[] PROGMEM = "I have stopped watching.";
+const char PHRASE_CAMERA_INIT_FAILED[] PROGMEM = "I'm having trouble starting my camera. This is something I'll need help to fix.";
+const char PHRASE_CAMERA_FAILED[] PROGMEM = "Hmm, I'm having trouble with my camera right now. Could you try again?";
+const char PHRASE_VISION_FAILED[] PROGMEM = "I'm sorry, I couldn't understand what I'm seeing.";
+const char PHRASE_TOOL_FAILED[] PROGMEM = "Oops, looks like I ran into a little hiccup while getting that information for you. Let me try again!";
+const char PHRASE_NOT_UNDERSTOOD[] PROGMEM = "Sorry, I didn't quite catch that. Could you say it again?";
+const char* const TTS_PRELOAD_PHRASES[] = {
+  DEFAULT_INTRODUCTION, PHRASE_TAKING_A_LOOK, PHRASE_STOPPED_WATCHING, PHRASE_CAMERA_INIT_FAILED,
+  PHRASE_CAMERA_FAILED, PHRASE_VISION_FAILED, PHRASE_TOOL_FAILED, PHRASE_NOT_UNDERSTOOD
+};
+
+SharedFrame* lastCapturedImage = nullptr;  // Gallery image: the frame that was sent to the vision API
 int imageCaptureCounter = 0;
-volatile bool cameraInUse = false;
 volatile bool inSurveillanceMode = false;
 
-volatile bool streamTaskRunning = false;
-WiFiClient* streamClient = nullptr;
-TaskHandle_t streamTaskHandle = nullptr;
-
-unsigned long alarmTriggerTime = 0;
+FrameBroker frameBroker;
+#define STREAM_DEFAULT_FPS 10             // Capture cap, adjustable with /api/stream?fps=N
+volatile int streamMaxFps = STREAM_DEFAULT_FPS;
+uint32_t cameraFramesCaptured = 0;
+SemaphoreHandle_t cameraLock = nullptr;     // Serializes esp_camera_fb_get between the capture tasks
+#define VISION_PREFETCH_MS 1000           // Background capture interval while nothing is streaming
+#define VISION_MAX_FRAME_AGE_MS 1500      // Older prefetched frames are replaced by a fresh capture
+TaskHandle_t streamCaptureTaskHandle = nullptr;
+WiFiClient* streamPendingClient = nullptr;  // Handed from handleStream to a new sender task
+SemaphoreHandle_t streamHandoff = nullptr;
+
+// Alarms live in a timer wheel keyed on wall-clock time (alarm_scheduler.h), so many named,
+// recurring alarms can be set and none drifts with millis(). They are saved to SPIFFS and
+// resumed after a reboot. Until the clock is synced the wheel runs on seconds of uptime, so
+// relative timers work without NTP; it is rebased onto Unix time when the sync arrives.
+#define ALARM_CAPACITY 32
+#define ALARMS_PATH "/alarms.json"
+#define ALARM_RING_MS 120000
+#define ALARM_SNOOZE_SEC 540
+#define ALARM_MISSED_GRACE_SEC 600        // Alarms missed while powered off still ring if this recent
+#define ALARM_DEFAULT_NAME "alarm"
+AlarmScheduler alarms;
+char lastAlarmName[ALARM_NAME_LEN] = "";  // Name of the alarm ringing or rung last (for snooze)
 unsigned long alarmLoopStartTime = 0;
 bool alarmSoundStarted = false;
+std::atomic<bool> alarmClockSynced{false};  // Wheel moved onto Unix time; set under appDataLock
+
+// The wheel's clock: Unix seconds once synced, seconds of uptime before
+uint32_t alarmNow() {
+  return alarmClockSynced ? (uint32_t)time(nullptr) : millis() / 1000;
+}
+
+// The alarm melody is synthesized on the device (tone_synth.h) into a WAV in SPIFFS,
+// so ringing needs no network; /rtttl/alarm serves the same file
+const char ALARM_RTTTL[] PROGMEM = "Kiko:d=16,o=6,b=140:c,e,g,c7,8p,c,e,g,c7,8p,a5,c,e,a,8p,g5,b5,d,g,4p";
+#define ALARM_SAMPLE_RATE 16000
+#define ALARM_AMPLITUDE 24000             // Q15
+#define ALARM_MAX_NOTES 64
+#define ALARM_WAV_PATH "/alarm.wav"
+#define ALARM_WAV_KEY_PATH "/alarm.key"   // Hash of the melody and settings ALARM_WAV_PATH was rendered from
+#define ALARM_RENDER_SAMPLES 1024
+bool alarmWavReady = false;
 unsigned long lastTapTime = 0;
 #define DOUBLE_TAP_TIME_MS 400
 U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
 
-const unsigned char time_date_icon[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x1f, 0x00, 0x00, 0xf8, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xc0, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x03, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf8, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0x1f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xc0, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0x03, 0x00, 0x00, 
-  0x00, 0x00, 0xf0, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x0f, 0x00, 0x00, 
-  0x00, 0x00, 0xfc, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 
-  0x00, 0x00, 0xfe, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x7f, 0x00, 0x00, 
-  0x00, 0x80, 0xff, 0x01, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x60, 0x00, 0x00, 0x80, 0xff, 0x01, 0x00, 
-  0x00, 0xc0, 0xff, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x01, 0x00, 0x00, 0xff, 0x03, 0x00, 
-  0x00, 0xe0, 0x3f, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0x00, 0x00, 0xfc, 0x07, 0x00, 
-  0x00, 0xf8, 0x1f, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0x00, 0x00, 0xf8, 0x0f, 0x00, 
-  0x00, 0xfc, 0x0f, 0x00, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00, 0xf0, 0x3f, 0x00, 
-  0x00, 0xfe, 0x03, 0x00, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xc0, 0x7f, 0x00, 
-  0x00, 0xfe, 0x01, 0x00, 0x0f, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0xf0, 0x00, 0x80, 0x7f, 0x00, 
-  0x00, 0xff, 0x00, 0x80, 0x07, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0xe0, 0x01, 0x00, 0xff, 0x00, 
-  0x80, 0x7f, 0x00, 0x80, 0x07, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0xe0, 0x01, 0x00, 0xfe, 0x01, 
-  0x80, 0x7f, 0x00, 0x80, 0x07, 0x00, 0x7f, 0x00, 0x00, 0xf8, 0x03, 0xe0, 0x01, 0x00, 0xfe, 0x01, 
-  0xc0, 0x3f, 0x00, 0x80, 0x07, 0x00, 0x3e, 0x00, 0x00, 0xf0, 0x01, 0xe0, 0x01, 0x00, 0xfc, 0x03, 
-  0xe0, 0x3f, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xfc, 0x07, 
-  0xe0, 0x1f, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xf8, 0x07, 
-  0xe0, 0x1f, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0xf8, 0x07, 
-  0xf0, 0x1f, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0xf8, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0x00, 0xf0, 0x0f, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0xe0, 0x7f, 0xfe, 0x07, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x0f, 0x00, 0x80, 0x07, 0x00, 0xf0, 0x7f, 0xfe, 0x0f, 0x00, 0xe0, 0x01, 0x00, 0xf0, 0x0f, 
-  0xf0, 0x1f, 0x00, 0x80, 0x07, 0x00, 0xfc, 0x7f, 0xfe, 0x3f, 0x00, 0xe0, 0x01, 0x00, 0xf8, 0x0f, 
-  0xe0, 0x1f, 0x00, 0x80, 0x07, 0x00, 0xfc, 0x7f, 0xfe, 0x3f, 0x00, 0xe0, 0x01, 0x00, 0xf8, 0x07, 
-  0xe0, 0x1f, 0x00, 0x80, 0x07, 0x00, 0xfe, 0x7f, 0xfe, 0x7f, 0x00, 0xe0, 0x01, 0x00, 0xf8, 0x07, 
-  0xe0, 0x3f, 0x00, 0x80, 0x07, 0x00, 0x3e, 0x00, 0xfe, 0x7f, 0x00, 0xe0, 0x01, 0x00, 0xfc, 0x07, 
-  0xc0, 0x3f, 0x00, 0x80, 0x07, 0x00, 0xfe, 0xff, 0xff, 0x7f, 0x00, 0xe0, 0x01, 0x00, 0xfc, 0x03, 
-  0x80, 0x7f, 0x00, 0x80, 0x07, 0x00, 0xfc, 0xff, 0xff, 0x3f, 0x00, 0xe0, 0x01, 0x00, 0xfe, 0x01, 
-  0x80, 0x7f, 0x00, 0x80, 0x07, 0x00, 0xfc, 0xff, 0xff, 0x3f, 0x00, 0xe0, 0x01, 0x00, 0xfe, 0x01, 
-  0x00, 0xff, 0x00, 0x80, 0x07, 0x00, 0xf8, 0xff, 0xff, 0x1f, 0x00, 0xe0, 0x01, 0x00, 0xff, 0x00, 
-  0x00, 0xfe, 0x01, 0x80, 0x07, 0x00, 0xe0, 0xff, 0xff, 0x07, 0x00, 0xe0, 0x01, 0x80, 0x7f, 0x00, 
-  0x00, 0xfe, 0x03, 0x80, 0x07, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0xe0, 0x01, 0xc0, 0x7f, 0x00, 
-  0x00, 0xfc, 0x0f, 0x80, 0x07, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x00, 0xe0, 0x01, 0xf0, 0x3f, 0x00, 
-  0x00, 0xf8, 0x1f, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0xf8, 0x1f, 0x00, 
-  0x00, 0xe0, 0x3f, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x00, 0xfc, 0x07, 0x00, 
-  0x00, 0xc0, 0xff, 0x00, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xff, 0x03, 0x00, 
-  0x00, 0x80, 0xff, 0x01, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x80, 0xff, 0x01, 0x00, 
-  0x00, 0x00, 0xfe, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x7f, 0x00, 0x00, 
-  0x00, 0x00, 0xfc, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 
-  0x00, 0x00, 0xf0, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x0f, 0x00, 0x00, 
-  0x00, 0x00, 0xc0, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0x03, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf8, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0x1f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xc0, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x03, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x1f, 0x00, 0x00, 0xf8, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
 bool isTimeDateTask = false;
 
-const unsigned char mic_icon[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xc0, 0x07, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xe0, 0x03, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf8, 0x1f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xf8, 0x1f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x3f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfc, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x01, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x7f, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0xfe, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0xff, 0x00, 0xfe, 0xff, 0xff, 0x7f, 0x00, 0xff, 0x3f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf8, 0xff, 0x00, 0xfc, 0xff, 0xff, 0x3f, 0x00, 0xff, 0x1f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf8, 0xff, 0x01, 0xf8, 0xff, 0xff, 0x1f, 0x80, 0xff, 0x1f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf0, 0xff, 0x03, 0xe0, 0xff, 0xff, 0x07, 0xc0, 0xff, 0x0f, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xe0, 0xff, 0x0f, 0x00, 0xff, 0xff, 0x00, 0xf0, 0xff, 0x07, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xc0, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x03, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x80, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x03, 0x00, 0x00, 0xc0, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x3f, 0x00, 0x00, 0xfc, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0xff, 0x1f, 0xf8, 0xff, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char weather_icon[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0x00, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x38, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x1f, 0x00, 0xf8, 0x03, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0xc0, 0x0f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xe0, 0x1f, 0x00, 0xf0, 0x07, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0xf8, 0x03, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x78, 0x00, 0xff, 0x0f, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x78, 0x00, 0xff, 0x07, 0x00, 
-  0x00, 0x00, 0x00, 0x80, 0x0f, 0x00, 0x00, 0x00, 0xe0, 0xf3, 0x03, 0x78, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0x70, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xc0, 0x03, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xe0, 0x03, 0x00, 0x00, 0x00, 0x80, 0x01, 0xe0, 0x0f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xc0, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xc0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xe0, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xe0, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xe0, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0xc0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x80, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x1f, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
 bool isWeatherTask = false;
 
-#define FRAME_DELAY (42)
-#define FRAME_WIDTH (48)
-#define FRAME_HEIGHT (48)
-const byte PROGMEM speaking_frames[][288] = {
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,3,8,32,4,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,131,8,97,134,16,193,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,32,4,16,192,2,8,0,0,16,64,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,64,0,8,32,0,16,192,2,8,96,0,16,192,3,8,96,4,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,193,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,6,16,193,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,4,16,192,2,8,96,0,16,192,0,8,32,0,16,192,0,8,0,0,16,64,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,0,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,64,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,2,8,96,0,16,192,3,8,96,6,16,192,3,8,96,6,16,192,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,6,16,192,3,8,96,6,16,192,2,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,0,0,16,64,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,0,8,32,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,3,8,96,0,16,192,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,32,0,16,192,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,0,0,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,195,195,8,97,132,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,132,16,195,0,8,96,0,16,195,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,0,96,0,0,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,8,96,0,0,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,195,192,8,97,128,16,195,192,8,97,128,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,192,8,97,128,16,195,192,8,97,128,16,195,0,8,96,0,16,195,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,16,192,0,8,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,0,0,0,64,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,0,0,64,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,8,96,0,0,192,0,8,96,0,16,192,0,8,96,0,16,193,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,194,8,97,128,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,194,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,0,8,96,0,16,193,0,8,96,0,16,192,0,8,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,32,0,0,64,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,128,8,96,0,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,194,8,97,132,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,194,8,97,132,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,0,8,96,0,0,195,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,0,0,64,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,193,192,0,97,128,0,195,192,8,97,128,0,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,0,195,192,0,97,128,0,195,0,0,96,0,0,193,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,32,0,0,64,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,0,0,0,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,8,97,128,0,195,192,8,97,128,16,195,192,8,97,128,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,192,8,97,128,16,195,192,8,97,128,16,195,192,8,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,0,0,96,0,0,195,0,0,96,0,0,192,0,0,96,0,0,192,0,0,96,0,0,192,0,0,32,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,0,0,192,128,0,96,0,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,8,97,128,0,195,194,8,97,132,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,194,8,97,132,16,195,192,8,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,128,0,96,0,0,195,0,0,96,0,0,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,192,0,97,128,0,67,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,67,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,97,128,0,3,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,0,97,134,0,195,195,0,97,134,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,97,128,0,195,192,0,33,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,33,128,0,3,192,0,97,128,0,67,192,0,97,128,0,195,194,0,97,132,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,8,97,134,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,194,0,97,132,0,195,192,0,97,128,0,195,192,0,97,128,0,67,192,0,33,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,194,0,97,132,0,67,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,192,0,97,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,194,0,1,132,0,3,195,0,33,134,0,3,195,0,97,134,0,67,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,97,134,0,67,195,0,33,134,0,3,194,0,1,132,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,33,134,0,3,195,0,97,134,0,195,195,0,97,134,0,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,0,97,134,0,195,195,0,97,134,0,195,195,0,33,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,192,0,1,128,0,3,194,0,1,132,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,97,134,0,67,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,0,33,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,194,0,1,132,0,3,192,0,1,128,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,6,0,0,131,0,0,6,0,1,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,8,97,134,16,67,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,67,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,131,0,0,6,0,1,3,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,1,134,16,3,195,8,1,134,16,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,195,0,1,134,0,3,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,4,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,195,0,1,134,0,3,195,0,1,134,0,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,33,134,16,67,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,33,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,0,1,134,0,3,195,0,1,134,0,3,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,2,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,131,8,0,6,16,1,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,33,134,16,67,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,33,134,16,67,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,4,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,8,0,6,16,0,3,8,0,6,16,0,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,67,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,1,134,16,67,195,8,1,134,16,3,195,8,1,134,16,3,195,8,1,134,16,3,3,8,0,6,16,0,3,8,0,6,16,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,2,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,195,8,1,134,16,3,195,8,1,134,16,3,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,1,134,16,3,195,8,1,134,16,3,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,3,0,0,6,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,6,0,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,195,8,33,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,33,134,16,195,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,3,8,0,4,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,192,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,0,6,16,192,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,4,16,0,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,2,8,0,0,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,64,3,8,96,6,16,192,3,8,96,6,16,192,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,6,16,192,3,8,96,6,16,192,3,8,0,6,16,64,3,8,0,6,16,0,3,8,0,6,16,0,3,8,0,6,16,0,2,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,2,8,0,0,16,0,3,8,0,4,16,0,3,8,0,6,16,64,3,8,32,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,195,8,97,134,16,195,3,8,96,6,16,192,3,8,96,6,16,192,3,8,96,6,16,192,3,8,32,6,16,192,3,8,0,6,16,64,3,8,0,4,16,0,2,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,8,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
-};
-
-#define SPEAKING_FRAME_COUNT (sizeof(speaking_frames) / sizeof(speaking_frames[0]))
 #define SAMPLE_RATE 8000
 #define RECORDING_SECONDS 10
 const int audio_buffer_size = SAMPLE_RATE * RECORDING_SECONDS * sizeof(int16_t);
 int16_t* audio_buffer = NULL;
 
+// --- MICROPHONE CAPTURE TASK ---
+// A high-priority task owns the I2S reads and pushes samples into a lock-free ring
+// in PSRAM, so a slow web request or display flush on the main loop can no longer
+// starve the DMA. recordAudio() drains the ring into audio_buffer.
+#define MIC_CHUNK_SAMPLES 256                   // 32 ms at 8 kHz
+#define MIC_RING_SAMPLES (SAMPLE_RATE * 2)      // Main loop may stall up to ~2 s
+#define MIC_UNDERRUN_MS 100                     // No samples for this long while recording = underrun
+AudioRing micRing;
+std::atomic<bool> micCapturing{false};          // Producer only pushes while a recording is active
+TaskHandle_t micCaptureTaskHandle = NULL;
+uint32_t micChunksRead = 0;                     // Total I2S reads, for the stats endpoint
+
+// --- VOICE ACTIVITY DETECTION ---
+// Runs on every 20 ms frame while recording. Silence before the first word is
+// never uploaded, trailing silence is trimmed, a clip without speech is dropped
+// without any network call, and recording stops on its own after a pause.
+#define VAD_ENABLED 1
+#define VAD_PREROLL_MS 250          // Kept before the detected onset (soft word starts)
+#define VAD_TAIL_MS 300             // Kept after the last speech frame
+#define VAD_END_SILENCE_MS 1200     // Pause that ends the turn while the pad is still held
+VoiceActivityDetector vad;
+bool touchReleasePending = false;   // Recording auto-stopped: ignore the pad until it is released
+
+// --- PIPELINED WHISPER UPLOAD ---
+// When enabled, the multipart request is opened as soon as the long-press starts
+// and audio is sent with chunked transfer encoding while the user is still talking.
+// Build with WHISPER_STREAMING_UPLOAD=0 for the buffered upload after the release.
+#ifndef WHISPER_STREAMING_UPLOAD
+#define WHISPER_STREAMING_UPLOAD 1
+#endif
+#define WHISPER_STREAM_CHUNK_BYTES 4096
+
+// --- COMPRESSED UPLOAD ---
+// Audio is sent as lossless FLAC, encoded frame by frame as it is captured.
+// Set to 0 (or if the encoder buffers cannot be allocated) to send raw WAV.
+#define WHISPER_UPLOAD_FLAC 1
+FlacEncoder flacEncoder;
+uint8_t* flacFrameBuffer = NULL;
+bool flacReady = false;
+
+// Every stream has a turn id. Aborting or giving up on a stream bumps the id, which
+// disowns its task: the task stops sending at its next check and its result, tagged
+// with the old id, is dropped instead of being taken for the next turn's transcript.
+struct WhisperUpload {
+  std::atomic<uint32_t> turn{0};        // Stream the running task belongs to, unless bumped since
+  std::atomic<int> samplesCaptured{0};  // Written by recordAudio(), read by the upload task
+  std::atomic<bool> captureDone{false};
+  std::atomic<bool> taskRunning{false}; // Cleared by the task as its last step
+  bool active = false;
+  int samplesSent = 0;        // Of the last finished stream
+  size_t bytesSent = 0;       // Encoded audio bytes (FLAC or PCM) of the last upload, streamed or buffered, excluding the multipart envelope
+  TaskHandle_t taskHandle = nullptr;
+  QueueHandle_t results = nullptr;      // WhisperStreamResult*, one per finished task
+};
+WhisperUpload whisperUpload;
+
+struct WhisperStreamResult {
+  uint32_t turn = 0;
+  bool failed = false;        // Stream could not be opened or broke: use the buffered upload
+  int samplesSent = 0;
+  size_t bytesSent = 0;
+  String transcript;
+};
+unsigned long recordingReleaseTime = 0;     // millis() when the finger lifted
+unsigned long lastTranscribeLatencyMs = 0;  // Release-to-transcript latency of the last turn
+
 const char* openai_host = "api.openai.com";
-const char* whisper_endpoint = "https://api.openai.com/v1/audio/transcriptions";
-const char* chatgpt_endpoint = "https://api.openai.com/v1/chat/completions";
+const char* whisper_path = "/v1/audio/transcriptions";
+const char* chatgpt_path = "/v1/chat/completions";
+
+// Optional local stand-in for the chat API (plain HTTP, e.g. an SSE replay server).
+// Define CHAT_MOCK_HOST and CHAT_MOCK_PORT in secrets.h to use it.
+#ifdef CHAT_MOCK_HOST
+const char* chat_host = CHAT_MOCK_HOST;
+#else
+const char* chat_host = "api.openai.com";
+#endif
+
+// --- STREAMING CHAT RESPONSES ---
+// Request server-sent events and hand each completed sentence to the speech queue
+// as soon as it arrives, so Kiko starts talking while later tokens are in flight.
+#define GPT_STREAMING_RESPONSES 1
+bool speechInterrupted = false;
+std::atomic<bool> firstAudioPending{false};
+unsigned long speechRequestStart = 0;
+unsigned long lastTimeToFirstAudioMs = 0;  // Chat request sent -> first sentence playing
+// Optional local stand-ins for the weather and search APIs (plain HTTP, no TLS), e.g. to
+// exercise the tool cache. Define WEATHER_MOCK_HOST/WEATHER_MOCK_PORT and
+// SEARCH_MOCK_HOST/SEARCH_MOCK_PORT in secrets.h to use them.
+#ifdef WEATHER_MOCK_HOST
+const char* weather_host = WEATHER_MOCK_HOST;
+#else
 const char* weather_host = "api.openweathermap.org";
+#endif
 const char* weather_endpoint = "/data/2.5/weather";
 
+#ifdef SEARCH_MOCK_HOST
+const char* google_search_host = SEARCH_MOCK_HOST;
+#else
+const char* google_search_host = "www.googleapis.com";
+#endif
+
+// --- TOOL RESULT CACHE ---
+// Weather and search answers keyed by tool and normalized argument (see result_cache.h),
+// persisted to SPIFFS so they survive a reboot
+#define TOOL_HTTP_TIMEOUT_MS 5000
+#define WEATHER_CACHE_TTL_S (10 * 60)
+#define WEATHER_CACHE_STALE_S (3 * 3600)
+#define SEARCH_CACHE_TTL_S (6 * 3600)
+#define SEARCH_CACHE_STALE_S (3 * 86400)
+#define TOOL_CACHE_PATH "/tool_cache.json"
+ResultCache toolCache;
+
+// --- API RESPONSE PARSING ---
+// Replies are parsed off the socket through a filter (see api_response.h); per-API
+// sizes and timings are reported in /api/runtime
+ApiParseStats chatParseStats;
+ApiParseStats whisperParseStats;
+ApiParseStats weatherParseStats;
+ApiParseStats searchParseStats;
+
+// --- LOCAL INTENTS ---
+// Deterministic commands (timers, alarms, todo lists, the time) are recognized on the
+// device (see intent_matcher.h) and answered without the chat API. Request-to-first-audio
+// is tracked per path to show what the fast path saves.
+IntentMatcher intentMatcher;
+struct TurnLatency {
+  uint32_t turns = 0;
+  uint32_t firstAudioMsTotal = 0;
+};
+TurnLatency localTurns, modelTurns;
+
+// --- TURN TRACE ---
+// Every answered voice turn prints one "TURN key=value ..." line on the serial console and
+// is kept for /api/runtime, so stage latencies can be compared between builds.
+struct TurnTrace {
+  uint32_t seq = 0;
+  bool local = false;           // Answered by a local intent
+  uint32_t transcribeMs = 0;    // Finger lifted -> transcript
+  uint32_t replyMs = 0;         // Transcript -> reply spoken (chat, tools and speech)
+  uint32_t firstAudioMs = 0;    // Reply requested -> first sentence playing
+  uint32_t totalMs = 0;         // Finger lifted -> reply spoken
+  uint32_t uploadBytes = 0;     // Audio sent for transcription
+  uint32_t heapLow = 0;         // Lowest free heap seen at the stage boundaries
+};
+TurnTrace lastTurn;
+uint32_t turnSeq = 0;
+
+// --- METRICS ---
+// Always-on latency histograms (metrics.h) for the pipeline stages and every tool, served
+// as /api/metrics in the Prometheus text format and pushed to the dashboard periodically.
+enum MetricStage : uint8_t {
+  STAGE_RECORD, STAGE_TRANSCRIBE, STAGE_CHAT, STAGE_TTS_CONNECT, STAGE_SENTENCE, STAGE_TTS_FETCH,
+  STAGE_LOOP_GAP, STAGE_COUNT
+};
+const char* const STAGE_NAMES[STAGE_COUNT] = {
+  "record", "transcribe", "chat", "tts_connect", "sentence", "tts_fetch", "loop_gap"
+};
+LatencyHistogram stageLatency[STAGE_COUNT];
+#define METRICS_PUSH_MS 5000
+
+// Optional local stand-in for the transcription API (plain HTTP, no TLS).
+// Define WHISPER_MOCK_HOST and WHISPER_MOCK_PORT in secrets.h to benchmark against it.
+#ifdef WHISPER_MOCK_HOST
+const char* whisper_host = WHISPER_MOCK_HOST;
+#else
+const char* whisper_host = "api.openai.com";
+#endif
+
+// Shared keep-alive sessions for every outbound API host (see api_connection.h)
+ApiConnectionPool apiPool;
+
 I2SClass I2S;
 Audio audio;
 
@@ -489,12 +412,134 @@ Audio audio;
 enum State { S_IDLE, S_RECORDING, S_TRANSCRIBING };
 State currentState = S_IDLE;
 enum AIState { AI_IDLE, AI_LISTENING, AI_THINKING, AI_SPEAKING, AI_ALARMING, AI_SURVEILLANCE };
-AIState currentAIState = AI_IDLE;
+
+// ========== TASKS & EVENT BUS ==========
+// Each subsystem runs on its own task and they talk through eventBus and queues:
+//   Web       (core 0)  HTTP server, WebSocket, OTA, NTP; the only task that touches the sockets
+//   Display   (core 0)  OLED frames, status LED and touch pad sampling
+//   Audio     (core 1)  the only task that touches `audio`; plays queued sentences and the alarm
+//   loop()    (core 1)  the voice pipeline: record, transcribe, chat, tools, alarms
+//   MicCapture, StreamCapture, VisionPrefetch: camera and microphone capture
+// The AI state is owned by setAIState(), which publishes every change on the bus.
+EventBus eventBus;
+std::atomic<AIState> aiStateValue{AI_IDLE};
+QueueHandle_t pipelineEvents = nullptr;   // Touch, speech progress and web commands for loop()
+QueueHandle_t webEvents = nullptr;        // State changes to push to the dashboard
+QueueHandle_t displayEvents = nullptr;    // State changes that should redraw at once
+TaskHandle_t webTaskHandle = nullptr;
+TaskHandle_t audioTaskHandle = nullptr;
+#define PIPELINE_EVENT_DEPTH 16
+#define WS_OUTBOX_DEPTH 32
+QueueHandle_t wsOutbox = nullptr;         // Serialized messages from other tasks, sent by the web task
+
+AIState aiState() { return aiStateValue.load(std::memory_order_acquire); }
+
+void setAIState(AIState state) {
+  if (aiStateValue.exchange(state, std::memory_order_acq_rel) != state) {
+    eventBus.publish(EV_STATE_CHANGED, state);
+  }
+}
+
+// Dashboard actions that change app data are executed by the pipeline task, in order
+// with its own changes, so chat history and todo lists only ever have one writer
+enum WebCommand : int32_t {
+  WEB_CMD_CLEAR_CHAT, WEB_CMD_CLEAR_GALLERY, WEB_CMD_CLEAR_TODOS, WEB_CMD_STOP_SURVEILLANCE, WEB_CMD_CANCEL_ALARM
+};
+
+void postWebCommand(WebCommand cmd) { eventBus.publish(EV_WEB_COMMAND, cmd); }
+
+// Held by the pipeline while it changes the chat, todo lists, gallery or sync log,
+// and by the web task while it reads them for a snapshot or replay
+SemaphoreHandle_t appDataLock = nullptr;
+
+struct AppDataGuard {
+  AppDataGuard() { xSemaphoreTakeRecursive(appDataLock, portMAX_DELAY); }
+  ~AppDataGuard() { xSemaphoreGiveRecursive(appDataLock); }
+};
+
+// --- AUDIO PLAYBACK TASK ---
+enum AudioOp : uint8_t { AUDIO_SPEAK, AUDIO_ALARM, AUDIO_STOP };
+struct AudioCommand {
+  AudioOp op;
+  String* text;   // AUDIO_SPEAK only; freed by the audio task
+};
+#define AUDIO_COMMAND_DEPTH 16
+#define SPEECH_STALL_MS 30000
+QueueHandle_t audioCommands = nullptr;
+uint32_t speechSubmitted = 0;                 // Sentences handed to the audio task (pipeline only)
+std::atomic<uint32_t> speechCompleted{0};     // Sentences played or dropped (audio task only)
+
+// --- SPEECH CLIP CACHE ---
+// Synthesized sentences kept in SPIFFS (see tts_cache.h). The audio task looks clips
+// up; the TtsCache task downloads them (preloaded phrases and repeated misses).
+#define TTS_LANGUAGE "en"
+#define TTS_CACHE_BUDGET_BYTES (384 * 1024)
+#define TTS_CACHE_MAX_TEXT 180            // Google TTS rejects longer requests
+#define TTS_CACHE_MIN_FREE_BYTES (64 * 1024)
+#define TTS_CACHE_DIR "/tts"
+#define TTS_CACHE_INDEX_PATH "/tts/index.bin"
+#define TTS_CACHE_TMP_PATH "/tts/fetch.tmp"
+#define TTS_FETCH_DEPTH 8
+#define TTS_INDEX_SAVE_MS 60000           // Hits only reorder the LRU; save that at most once a minute
+const char* tts_host = "translate.google.com";
+TtsCacheIndex ttsCache(TTS_CACHE_BUDGET_BYTES);
+SemaphoreHandle_t ttsCacheLock = nullptr;
+QueueHandle_t ttsFetchQueue = nullptr;    // String* sentences to download
+TaskHandle_t ttsCacheTaskHandle = nullptr;
+bool ttsIndexDirty = false;
+uint32_t ttsFetchFailures = 0;
+
+// --- LATENCY COUNTERS ---
+// Worst web task iteration (how long a request could wait to be served) and worst
+// delay between a touch edge and the pipeline acting on it, since boot.
+uint32_t webLoopMaxGapMs = 0;
+uint32_t touchLatencyMaxMs = 0;
+uint32_t touchLatencyLastMs = 0;
+#define TOUCH_POLL_MS 10
+#define TOUCH_LONG_PRESS_MS 500
+
+// --- DASHBOARD ASSETS ---
+// Gzipped pages from web_assets.h, counted on the web task. The page* fields cover the
+// latest request for the page itself and the asset requests that followed it.
+struct WebAssetStats {
+  uint32_t served = 0;          // 200 with the gzip body
+  uint32_t notModified = 0;     // 304, no body
+  uint32_t bodyBytes = 0;
+  uint32_t serveUsTotal = 0;
+  uint32_t serveUsMax = 0;
+  uint32_t pageRequests = 0;
+  uint32_t pageBodyBytes = 0;
+  uint32_t pageServeUs = 0;
+};
+WebAssetStats webAssetStats;
+#define WEB_ASSET_MAX_AGE "public, max-age=31536000, immutable"
 
 // ========== UI & STATE SYNCHRONIZATION ==========
 unsigned long lastStateSync = 0;
 AIState lastSyncedState = (AIState)-1;
-unsigned long lastAlarmSync = 0;
+String lastAlarmJson;          // Last alarm message sent, to drop unchanged repeats
+
+// --- VERSIONED STATE SYNC ---
+// Persistent dashboard state (chat, todo lists, gallery) is published as small
+// sequenced deltas. Each delta is serialized once into a short log, which the web
+// task sends on to every synced client from where that client left off. A
+// reconnecting dashboard says hello with its last sequence number and gets the
+// deltas it missed, or a full snapshot if it is too far behind (or the device
+// rebooted). Live status (AI state, alarm countdown) is not logged:
+// it is simply re-sent fresh after each hello.
+#define SYNC_LOG_MAX 48
+struct SyncDelta {
+  uint32_t seq;
+  String json;
+};
+std::deque<SyncDelta> syncLog;
+uint32_t syncSeq = 0;
+std::atomic<uint32_t> syncPublished{0};                       // syncSeq, readable without the lock
+uint32_t syncEpoch = 0;                                       // Random per boot
+bool wsClientSynced[WEBSOCKETS_SERVER_CLIENT_MAX] = {false};  // Connected and past the hello
+uint32_t wsClientSeq[WEBSOCKETS_SERVER_CLIENT_MAX] = {0};     // Last delta each synced client has
+uint32_t wsMessagesSent = 0;
+uint32_t wsBytesSent = 0;
 
 enum IdleDisplayState { IDLE_EYES, IDLE_INFO }; 
 IdleDisplayState currentIdleDisplay = IDLE_EYES;
@@ -507,80 +552,245 @@ int eyeY = 32;
 int eyeWidth = 40;
 int eyeHeight = 35;
 int pupilRadius = 10;
-float pupilX = 0, pupilY = 0, targetPupilX = 0, targetPupilY = 0;
-float browOffsetLeft = 0, browOffsetRight = 0, targetBrowOffset = 0;
-unsigned long lastMoveTime = 0;
+q8_t pupilX = 0, pupilY = 0, targetPupilX = 0, targetPupilY = 0;  // Q8 fixed point (256 == 1 px)
+q8_t browOffsetLeft = 0, browOffsetRight = 0, targetBrowOffset = 0;
+unsigned long nextMoveTime = 0;
 bool isBlinking = false;
 unsigned long blinkStart = 0;
-unsigned long lastBlink = 0;
+unsigned long nextBlinkTime = 0;
 int speaking_frame_index = 0;
 unsigned long last_speaking_frame_time = 0;
 int currentTouchValue = 0;
 bool introSpoken = false; 
-bool showNetworkInfo = false;  
-unsigned long networkInfoStartTime = 0;  
-
-void updateAnimation();
-void drawEye(int centerX, int centerY, int w, int h, float px, float py);
+volatile bool showNetworkInfo = false;  
+volatile unsigned long networkInfoStartTime = 0;  
+
+// The display task owns the OLED; other code only posts state changes to it
+#define DISPLAY_FPS 30
+enum DisplayScene : uint8_t {
+  SCENE_EYES, SCENE_INFO, SCENE_LISTENING, SCENE_THINKING, SCENE_SPEAKING, SCENE_ALARM,
+  SCENE_WEATHER, SCENE_TIME_DATE, SCENE_SURVEILLANCE, SCENE_NETWORK, SCENE_MESSAGE
+};
+const char* const DISPLAY_SCENE_NAMES[] = {
+  "eyes", "info", "listening", "thinking", "speaking", "alarm",
+  "weather", "time_date", "surveillance", "network", "message"
+};
+TaskHandle_t displayTaskHandle = nullptr;
+DirtyTileFlusher displayFlusher;
+uint32_t spriteDecodes = 0;
+uint32_t spriteDecodeMicros = 0;
+const char* volatile displayMessage = nullptr;  // Full-screen text (OTA), overrides every scene
+volatile int displayProgress = -1;               // 0..100 bar under the message, -1 for none
+
+void initToolRegistry();
+bool startMicCaptureTask();
+void startAudioTask();
+void startTtsCacheTask();
+void startWebTask();
+void publishChatCleared();
+void publishTodosCleared();
+void publishGallery();
+void handleRtttlAlarm();
+void handleRuntimeStatsAPI();
+void startDisplayTask();
+void displayNotify();
+void displayShowMessage(const char* text, int progress = -1);
+void displayShowNetworkInfo();
+void drawEye(int centerX, int centerY, int w, int h, int px, int py);
 void drawBlink(int centerX, int centerY, int w);
-void drawEyebrow(int centerX, int browY, int w, float offset);
+void drawEyebrow(int centerX, int browY, int w, int offset);
 String handleTimeDateRequest();                     
 String handleWeatherRequest(String city);           
+bool fetchWeather(const String& city, String& weatherReport);
+bool fetchGoogleSearch(const String& query, String& result);
 String handleGoogleSearch(String query);
+String urlEncode(const String& text);
+void saveToolCache();
 void showLoadingScreen(String status);
-void addToHistory(String role, String content, String tool_call_id = "");
+bool addToHistory(String role, String content, String tool_call_id = "");
 void broadcastState(AIState state);
 void createWavHeader(byte* header, int wavDataSize);
 void speakText(String text);
 void speakDefaultIntroduction();
 void playAlarmTone();
+bool renderAlarmWav();
 int recordAudio();
 void initCamera();
 void handleVisionRequest();
-GptResponse chatWithGpt(String vision_prompt = "", String image = ""); 
+GptResponse chatWithGpt(String vision_prompt = "", const SharedFrame* image = nullptr); 
+GptResponse chatWithGptStreaming();
+GptResponse requestChatTurn();
+void queueSentence(String sentence);
+std::vector<String> splitSentences(const String& text);
+void sendAudioCommand(AudioOp op, String* text = nullptr);
+void speechIdleHook();
+void drainSpeechQueue();
 int recordAudio();                      
 String transcribeWithWhisper(int audio_len, int16_t* audio_data = NULL);
+String whisperPreFileBody(bool flac);
+uint8_t* encodeFlacClip(const int16_t* samples, int count, size_t& outLen);
+bool startWhisperStream();
+void abortWhisperStream();
+String finishWhisperStream(int samples_recorded);
 void processAudio(int bytes_recorded, int samples_recorded); 
 
+// Runs one HTTPClient request over the pooled keep-alive session for the lease's host.
+// If a reused socket turns out to be stale the request is retried once on a fresh connection.
+// addHeaders is re-applied on every attempt because HTTPClient::begin() clears them.
+int sendPooledRequest(HTTPClient& http, ApiLease& lease, const String& url, const char* method,
+                      const String& body, void (*addHeaders)(HTTPClient&) = nullptr) {
+    if (!lease.valid()) return HTTPC_ERROR_CONNECTION_REFUSED;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool connected = (attempt == 0) ? lease.ensureConnected() : lease.reconnect();
+        if (!connected) return HTTPC_ERROR_CONNECTION_REFUSED;
+        http.begin(lease.client(), url);
+        http.setReuse(true);
+        const char* framingHeaders[] = {"Transfer-Encoding", "Connection"};
+        http.collectHeaders(framingHeaders, 2);   // For pooledResponseHead()
+        if (addHeaders) addHeaders(http);
+        int httpCode = http.sendRequest(method, body);
+        if (httpCode >= 0 || !lease.reused() || !ApiConnectionPool::isStaleConnectionError(httpCode)) {
+            return httpCode;
+        }
+        Serial.printf("[ApiPool] Stale connection to %s, reconnecting\n", lease.host());
+        http.end();
+    }
+    return HTTPC_ERROR_CONNECTION_LOST;
+}
+
+// Framing of a response whose status line and headers HTTPClient has already read, so
+// the body can be read straight off the pooled socket
+HttpResponseHead pooledResponseHead(HTTPClient& http, int httpCode) {
+    HttpResponseHead head;
+    head.status = httpCode;
+    head.contentLength = http.getSize();
+    String encoding = http.header("Transfer-Encoding");
+    encoding.toLowerCase();
+    head.chunked = encoding.indexOf("chunked") >= 0;
+    String connection = http.header("Connection");
+    connection.toLowerCase();
+    head.keepAlive = connection.indexOf("close") < 0;
+    return head;
+}
+
+// Parses the body of a pooled HTTPClient request through a filter. A body that was not
+// read to its end closes the socket, so the next request on the session starts clean.
+bool parsePooledJson(HTTPClient& http, ApiLease& lease, int httpCode, JsonDocument& filter,
+                     ApiJsonResponse& response) {
+    HttpResponseHead head = pooledResponseHead(http, httpCode);
+    HttpBodyReader body(lease.client(), head);
+    bool ok = response.parse(body, filter, TOOL_HTTP_TIMEOUT_MS);
+    if (!body.complete() || !head.keepAlive) lease.close();
+    return ok;
+}
+
+// Lowercased, trimmed, single-spaced: "  New  York " and "new york" share a cache entry
+String normalizeToolArg(String arg) {
+    arg.trim();
+    arg.toLowerCase();
+    String out;
+    out.reserve(arg.length());
+    for (size_t i = 0; i < arg.length(); i++) {
+        char c = isspace((uint8_t)arg[i]) ? ' ' : arg[i];
+        if (c == ' ' && out.endsWith(" ")) continue;
+        out += c;
+    }
+    return out;
+}
+
+// Answers a tool call from the tool cache, fetching on a miss. fetch returns false when the
+// upstream failed (its text is then an apology, used only if there is no stale entry); calls
+// that waited for that fetch get the same apology. Without a valid clock entries cannot be
+// aged, so the cache is bypassed.
+String cachedToolResult(const char* tool, const String& arg, uint32_t ttl, uint32_t staleFor,
+                        bool (*fetch)(const String&, String&)) {
+    String value;
+    time_t now = time(nullptr);
+    if (now < 24 * 3600) {
+        fetch(arg, value);
+        return value;
+    }
+    String key = String(tool) + "|" + arg;
+    bool ok = toolCache.get(key, (uint32_t)now, ttl, staleFor, value,
+                            [&](String& out) { return fetch(arg, out); });
+    if (!ok && value.length() == 0) value = PHRASE_TOOL_FAILED;   // Gave up waiting for the fetch
+    return value;
+}
+
 String handleGoogleSearch(String query) {
-    // Query Google Custom Search API and return snippet of first result
     // Used for: "Hey Kiko, what is...?" or "Tell me about..."
+    return cachedToolResult("google_search", normalizeToolArg(query), SEARCH_CACHE_TTL_S, SEARCH_CACHE_STALE_S,
+                            fetchGoogleSearch);
+}
+
+// Query Google Custom Search API and return snippet of first result
+bool fetchGoogleSearch(const String& query, String& result) {
     Serial.println("Handling Google Search request for: " + query);
-    query.replace(" ", "%20");
-    String url = "https://www.googleapis.com/customsearch/v1";
+    ApiLease lease = apiPool.acquire(google_search_host);
+    String url = lease.baseUrl() + "/customsearch/v1";
     url += "?key=" + String(GOOGLE_SEARCH_API_KEY);
     url += "&cx=" + String(GOOGLE_SEARCH_CX);
-    url += "&q=" + query;
+    url += "&q=" + urlEncode(query);
     url += "&num=1"; 
     
-    WiFiClientSecure client;
-    client.setInsecure(); 
     HTTPClient http;
-    if (!http.begin(client, url)) {
-        Serial.println("Failed to begin HTTP for Google Search");
-        return "Hmm, I had trouble setting that up. Let me try again in a moment.";
-    }
-    
-    int httpCode = http.GET();
-    if (httpCode == HTTP_CODE_OK) {
-        String payload = http.getString();
-        JsonDocument doc;
-        deserializeJson(doc, payload);
-        
+    http.setTimeout(TOOL_HTTP_TIMEOUT_MS);
+    int httpCode = sendPooledRequest(http, lease, url, "GET", "");
+    bool ok = httpCode == HTTP_CODE_OK;
+    if (ok) {
+        StaticJsonDocument<64> filter;
+        filter["items"][0]["snippet"] = true;
+        ApiJsonResponse response(searchParseStats);
+        parsePooledJson(http, lease, httpCode, filter, response);
+        JsonDocument& doc = response.doc();
+
         if (doc.containsKey("items") && doc["items"].size() > 0) {
             String snippet = doc["items"][0]["snippet"];
             snippet.trim();
             Serial.println("Google snippet: " + snippet);
-            return snippet; 
+            result = snippet; 
         } else {
             Serial.println("No search results found.");
-            return "I couldn't find anything on that. Maybe try rephrasing your question?";
+            result = "I couldn't find anything on that. Maybe try rephrasing your question?";
         }
     } else {
         Serial.printf("[HTTP] Google Search failed, error: %s\n", http.errorToString(httpCode).c_str());
-        return "I'm having trouble connecting to the search service right now. Want to try again?";
+        result = "I'm having trouble connecting to the search service right now. Want to try again?";
     }
     http.end();
+    return ok;
+}
+
+void loadToolCache() {
+    File file = SPIFFS.open(TOOL_CACHE_PATH, FILE_READ);
+    if (!file) return;
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, file);
+    file.close();
+    if (err) return;
+    for (JsonObject e : doc.as<JsonArray>()) {
+        toolCache.restore(e["k"].as<String>(), e["v"].as<String>(), e["t"], e["ttl"], e["stale"]);
+    }
+    Serial.printf("Tool cache: %d entries restored\n", toolCache.size());
+}
+
+// Pipeline task, after a round of tool calls
+void saveToolCache() {
+    if (!toolCache.dirty()) return;
+    JsonDocument doc;
+    JsonArray entries = doc.to<JsonArray>();
+    toolCache.forEachStored([&](const ResultCacheEntry& e) {
+        JsonObject o = entries.createNestedObject();
+        o["k"] = e.key;
+        o["v"] = e.value;
+        o["t"] = e.storedAt;
+        o["ttl"] = e.ttl;
+        o["stale"] = e.staleFor;
+    });
+    File file = SPIFFS.open(TOOL_CACHE_PATH, FILE_WRITE);
+    if (!file) return;
+    serializeJson(doc, file);
+    file.close();
 }
 
 
@@ -591,7 +801,7 @@ String handleGoogleSearch(String query) {
 
 
 String stateToString() {
-  switch(currentAIState) {
+  switch(aiState()) {
     case AI_IDLE: return "Idle";
     case AI_LISTENING: return "Listening";
     case AI_THINKING: return "Thinking";
@@ -608,17 +818,20 @@ void saveChatHistory() {
     return;
   }
   
-  DynamicJsonDocument doc(8192);
-  JsonArray arr = doc.createNestedArray("history");
-  for (const auto& msg : chatHistory) {
-    JsonObject msgObj = arr.createNestedObject();
-    msgObj["role"] = msg.role;
-    msgObj["content"] = msg.content;
+  // Streamed entry by entry: the whole history never has to fit in one JsonDocument
+  file.print("{\"history\":[");
+  for (size_t i = 0; i < chatRing.size(); i++) {
+    const ChatEntry& e = chatRing.entry(i);
+    StaticJsonDocument<128> doc;
+    doc["role"] = ChatHistoryRing::roleName(e.role);
+    doc["content"] = chatRing.content(i);
+    if (e.idLen > 0) doc["tool_call_id"] = chatRing.toolCallId(i);
+    if (i > 0) file.print(',');
+    serializeJson(doc, file);
   }
-  
-  serializeJson(doc, file);
+  file.print("]}");
   file.close();
-  Serial.println("Chat history saved: " + String(chatHistory.size()) + " messages");
+  Serial.println("Chat history saved: " + String(chatRing.size()) + " messages");
 }
 
 void loadChatHistory() {
@@ -633,93 +846,214 @@ void loadChatHistory() {
     return;
   }
   
-  DynamicJsonDocument doc(8192);
+  JsonDocument doc;
   deserializeJson(doc, file);
   
-  chatHistory.clear();
+  chatRing.clear();
   JsonArray arr = doc["history"];
   for (JsonObject msgObj : arr) {
-    String role = msgObj["role"].as<String>();
-    String content = msgObj["content"].as<String>();
-    chatHistory.push_back({role, content, ""});
+    addToHistory(msgObj["role"].as<String>(), msgObj["content"].as<String>(), msgObj["tool_call_id"] | "");
   }
   
   file.close();
-  Serial.println("Chat history loaded: " + String(chatHistory.size()) + " messages");
+  Serial.println("Chat history loaded: " + String(chatRing.size()) + " messages");
+}
+
+// Rewrites the whole store as a fresh snapshot and starts an empty journal. The old
+// snapshot is only replaced once the new one is complete.
+void compactTodoLists() {
+  File file = SPIFFS.open(TODO_SNAPSHOT_TMP_PATH, FILE_WRITE);
+  if (!file) {
+    Serial.println("Failed to open todo snapshot for writing");
+    return;
+  }
+  bool ok = true;
+  todoStore.writeSnapshot([&](const uint8_t* data, size_t len) {
+    ok = file.write(data, len) == len;
+  });
+  file.close();
+  if (!ok) {
+    SPIFFS.remove(TODO_SNAPSHOT_TMP_PATH);
+    return;
+  }
+  SPIFFS.remove(TODO_SNAPSHOT_PATH);
+  SPIFFS.rename(TODO_SNAPSHOT_TMP_PATH, TODO_SNAPSHOT_PATH);
+  SPIFFS.remove(TODO_JOURNAL_PATH);
+  todoJournalSize = 0;
+  todoSnapshotSize = todoStore.stats().snapshotBytes;
+  Serial.printf("Todo lists compacted: %u byte snapshot\n", (unsigned)todoSnapshotSize);
 }
 
+// Appends the pending edits to the journal (one small write per edit); compacts once the
+// journal is bigger than the snapshot, so flash writes stay proportional to the edits
 void saveTodoLists() {
-  File file = SPIFFS.open("/todo_lists.json", FILE_WRITE);
+  if (todoStore.pendingJournalBytes() == 0) return;
+  File file = SPIFFS.open(TODO_JOURNAL_PATH, FILE_APPEND);
   if (!file) {
-    Serial.println("Failed to open todo lists file for writing");
+    Serial.println("Failed to open todo journal for writing");
     return;
   }
-  
+  todoStore.drainJournal([&](const uint8_t* data, size_t len) {
+    todoJournalSize += file.write(data, len);
+  });
+  file.close();
+  if (todoJournalSize > max((size_t)TODO_COMPACT_MIN_BYTES, todoSnapshotSize)) compactTodoLists();
+}
+
+// Replays a record file into the store; returns its size (0 if missing)
+size_t replayTodoFile(const char* path) {
+  File file = SPIFFS.open(path, FILE_READ);
+  if (!file) return 0;
+  size_t len = file.size();
+  uint8_t* data = (uint8_t*) ps_malloc(len ? len : 1);
+  if (!data) data = (uint8_t*) malloc(len ? len : 1);
+  size_t used = 0;
+  if (data && file.read(data, len) == len) used = todoStore.replay(data, len);
+  if (used < len) Serial.printf("Todo file %s: ignored %u torn bytes\n", path, (unsigned)(len - used));
+  free(data);
+  file.close();
+  return len;
+}
+
+// Imports the old whole-file JSON format once
+void importLegacyTodoLists() {
+  File file = SPIFFS.open(TODO_LEGACY_PATH, FILE_READ);
+  if (!file) return;
   JsonDocument doc;
-  JsonObject listsObj = doc.createNestedObject("lists");
-  
-  for (auto const& [listName, items] : todoLists) {
-    JsonObject listItems = listsObj.createNestedObject(listName);
-    for (auto const& [item, qty] : items) {
-      listItems[item] = qty;
+  DeserializationError err = deserializeJson(doc, file);
+  file.close();
+  if (err) return;
+  for (JsonPair list : doc["lists"].as<JsonObject>()) {
+    for (JsonPair item : list.value().as<JsonObject>()) {
+      todoStore.add(list.key().c_str(), item.key().c_str(), item.value().as<int>());
     }
   }
-  
-  serializeJson(doc, file);
-  file.close();
-  Serial.println("Todo lists saved");
+  compactTodoLists();
+  SPIFFS.remove(TODO_LEGACY_PATH);
+  Serial.println("Todo lists imported from " TODO_LEGACY_PATH);
 }
 
 void loadTodoLists() {
-  if (!SPIFFS.exists("/todo_lists.json")) {
-    Serial.println("Todo lists file not found");
+  AppDataGuard guard;
+  unsigned long start = millis();
+  if (!SPIFFS.exists(TODO_SNAPSHOT_PATH) && SPIFFS.exists(TODO_SNAPSHOT_TMP_PATH)) {
+    SPIFFS.rename(TODO_SNAPSHOT_TMP_PATH, TODO_SNAPSHOT_PATH);   // Power lost mid-compaction
+  }
+  todoSnapshotSize = replayTodoFile(TODO_SNAPSHOT_PATH);
+  todoJournalSize = replayTodoFile(TODO_JOURNAL_PATH);
+  if (todoSnapshotSize == 0 && todoJournalSize == 0) {
+    importLegacyTodoLists();
     return;
   }
-  
-  File file = SPIFFS.open("/todo_lists.json", FILE_READ);
+  Serial.printf("Todo lists loaded: %d lists, %u+%u bytes in %lu ms\n", todoStore.listCount(),
+                (unsigned)todoSnapshotSize, (unsigned)todoJournalSize, millis() - start);
+  if (todoJournalSize > max((size_t)TODO_COMPACT_MIN_BYTES, todoSnapshotSize)) compactTodoLists();
+}
+
+// Alarms are saved as [{"name","due","repeat"}], due in Unix seconds. Nothing is saved
+// before the clock is synced: uptime due times mean nothing after a reboot, and the file
+// still holds the alarms that loadAlarms() has yet to resume.
+void saveAlarms() {
+  if (!alarmClockSynced) return;
+  JsonDocument doc;
+  JsonArray arr = doc.to<JsonArray>();
+  {
+    AppDataGuard guard;
+    alarms.forEach([&](int id, const AlarmTimer& t) {
+      JsonObject o = arr.createNestedObject();
+      o["name"] = (const char*)t.name;   // Copied, not kept by pointer
+      o["due"] = t.due;
+      o["repeat"] = t.repeatSec;
+    });
+  }
+  File file = SPIFFS.open(ALARMS_PATH, FILE_WRITE);
   if (!file) {
-    Serial.println("Failed to open todo lists file for reading");
+    Serial.println("Failed to open alarms file for writing");
+    return;
+  }
+  serializeJson(doc, file);
+  file.close();
+}
+
+// Resumes the saved alarms. One missed while powered off still rings if it is recent;
+// otherwise a recurring alarm moves on to its next occurrence and a one-shot is dropped.
+void loadAlarms(uint32_t now) {
+  if (!SPIFFS.exists(ALARMS_PATH)) return;
+  File file = SPIFFS.open(ALARMS_PATH, FILE_READ);
+  if (!file) {
+    Serial.println("Failed to open alarms file for reading");
     return;
   }
-  
   JsonDocument doc;
-  deserializeJson(doc, file);
-  
-  todoLists.clear();
-  JsonObject listsObj = doc["lists"];
-  for (JsonPair p : listsObj) {
-    String listName = p.key().c_str();
-    JsonObject items = p.value().as<JsonObject>();
-    for (JsonPair item : items) {
-      todoLists[listName][item.key().c_str()] = item.value().as<int>();
+  DeserializationError err = deserializeJson(doc, file);
+  file.close();
+  if (err) {
+    Serial.println("Alarms file unreadable: " + String(err.c_str()));
+    return;
+  }
+
+  AppDataGuard guard;
+  int resumed = 0, dropped = 0;
+  for (JsonObject o : doc.as<JsonArray>()) {
+    uint32_t due = o["due"] | 0;
+    uint32_t repeat = o["repeat"] | 0;
+    if (due + ALARM_MISSED_GRACE_SEC < now) {
+      if (repeat == 0) {
+        dropped++;
+        continue;
+      }
+      due += ((now - due) / repeat + 1) * repeat;
     }
+    if (alarms.add(o["name"] | ALARM_DEFAULT_NAME, due, repeat) >= 0) resumed++;
   }
-  
-  file.close();
-  Serial.println("Todo lists loaded");
+  Serial.printf("⏰ Alarms resumed: %d (%d missed while powered off)\n", resumed, dropped);
 }
 
 void clearChatHistory() {
-  chatHistory.clear();
-  transactionHistory.clear();
+  AppDataGuard guard;
+  chatRing.clear();
   if (SPIFFS.exists("/chat_history.json")) {
     SPIFFS.remove("/chat_history.json");
   }
   saveChatHistory();
+  publishChatCleared();  // Sync UI
   Serial.println("Chat history cleared");
 }
 
 void clearTodoLists() {
-  todoLists.clear();
-  if (SPIFFS.exists("/todo_lists.json")) {
-    SPIFFS.remove("/todo_lists.json");
-  }
-  saveTodoLists();
+  AppDataGuard guard;
+  todoStore.clear();
+  compactTodoLists();
+  publishTodosCleared();  // Sync UI
   Serial.println("Todo lists cleared");
 }
 
+// Keeps a reference to frame as the gallery image (nullptr clears it)
+void setLastCapturedImage(SharedFrame* frame) {
+  AppDataGuard guard;
+  if (frame) sharedFrameRetain(frame);
+  if (lastCapturedImage) sharedFrameRelease(lastCapturedImage);
+  lastCapturedImage = frame;
+}
+
+void clearGallery() {
+  AppDataGuard guard;
+  setLastCapturedImage(nullptr);
+  imageCaptureCounter = 0;
+  if (SPIFFS.exists("/last_image.jpg")) {
+    SPIFFS.remove("/last_image.jpg");
+  }
+  publishGallery(); // Sync UI
+}
+
 void handleImage() {
-  if (lastCapturedImage.empty()) {
+  SharedFrame* image = nullptr;
+  {
+    AppDataGuard guard;
+    image = lastCapturedImage;
+    if (image) sharedFrameRetain(image);  // The pipeline may replace it while this is sent
+  }
+  if (!image) {
     server.send(404, "text/plain", "No image captured yet.");
     return;
   }
@@ -731,7 +1065,8 @@ void handleImage() {
   // Add ETag based on counter to invalidate cache on new image
   server.sendHeader("ETag", "\"" + String(imageCaptureCounter) + "\"");
   server.sendHeader("Content-Type", "image/jpeg");
-  server.send_P(200, "image/jpeg", (const char*)lastCapturedImage.data(), lastCapturedImage.size());
+  server.send_P(200, "image/jpeg", (const char*)image->data, image->len);
+  sharedFrameRelease(image);
 }
 
 void setLedState(AIState state) {
@@ -766,35 +1101,34 @@ void setLedState(AIState state) {
     }
 }
 
-void broadcastChatHistory();
-void broadcastGallery();
-
-void addToHistory(String role, String content, String tool_call_id) {
-    if (chatHistory.size() >= MAX_HISTORY_MESSAGES) {
-        chatHistory.erase(chatHistory.begin());
+void publishChatMessage(ChatRole role, const char* content);
+
+// False if the ring refused the message: a tool call or result too large to keep, whose
+// whole tool exchange is then left out of the history
+bool addToHistory(String role, String content, String tool_call_id) {
+    AppDataGuard guard;
+    ChatRole chatRole = (role == "user") ? CHAT_ROLE_USER : (role == "tool") ? CHAT_ROLE_TOOL : CHAT_ROLE_ASSISTANT;
+    if (!chatRing.append(chatRole, content.c_str(), tool_call_id.c_str())) {
+        Serial.printf("Chat history: %s message of %u bytes refused, tool exchange dropped\n", role.c_str(),
+                      (unsigned)content.length());
+        return false;
     }
-    chatHistory.push_back({role, content, tool_call_id});
 
-    
-    
-    if (role == "user") {
-        if (transactionHistory.size() >= MAX_HISTORY_SIZE) {
-             transactionHistory.erase(transactionHistory.begin());
-        }
-        transactionHistory.push_back("You: " + content);
-        broadcastChatHistory();  // Broadcast chat update
-    } else if (role == "assistant" && content.length() > 0) {
-         if (transactionHistory.size() >= MAX_HISTORY_SIZE) {
-             transactionHistory.erase(transactionHistory.begin());
-        }
-        transactionHistory.push_back("AI: " + content);
-        broadcastChatHistory();  // Broadcast chat update
+    const ChatEntry& added = chatRing.entry(chatRing.size() - 1);
+    if (added.kind == CHAT_PLAIN && content.length() > 0) {
+        publishChatMessage(chatRole, content.c_str());  // Sync UI
     }
+    return true;
 }
 
 // Function declarations
 void handleRoot();
 void handleStateAPI();
+void handleConnectionStatsAPI();
+void handleAudioStatsAPI();
+void handleStreamStatsAPI();
+void handleDisplayStatsAPI();
+void handleMetricsAPI();
 void handleTasksData();
 void handleClearChat();
 void handleClearGallery();
@@ -807,19 +1141,17 @@ String getContentType(const String& filename);
 // Broadcast state changes to web clients
 void broadcastState(AIState state);
 void broadcastTranscription(String text);
-void broadcastAlarm(unsigned long triggerTime, bool active);
-void broadcastTodoLists();
+void broadcastAlarm();
+void broadcastMetrics();
+void stopAlarm(const char* reason, bool broadcast = true);
+void publishTodoItem(const String& listName, const String& item, int qty);
+void publishTodoListRemoved(const String& listName);
 void broadcastCameraMode(String mode);
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length);
-void sendToAllClients(String json);
+void sendToAllClients(String& json);
 
 // Broadcast state to WebSocket clients
-void broadcastState(AIState state) {
-  // Rate-limit updates to 500ms intervals
-  if (lastSyncedState == state && (millis() - lastStateSync) < 500) return;
-  lastSyncedState = state;
-  lastStateSync = millis();
-  
+String stateMessage(AIState state) {
   String stateStr = "";
   switch(state) {
     case AI_IDLE: stateStr = "Idle"; break;
@@ -834,6 +1166,17 @@ void broadcastState(AIState state) {
   doc["state"] = stateStr;
   String json;
   serializeJson(doc, json);
+  return json;
+}
+
+// Runs on the web task for every EV_STATE_CHANGED
+void broadcastState(AIState state) {
+  // Rate-limit updates to 500ms intervals
+  if (lastSyncedState == state && (millis() - lastStateSync) < 500) return;
+  lastSyncedState = state;
+  lastStateSync = millis();
+  
+  String json = stateMessage(state);
   sendToAllClients(json);
 }
 
@@ -845,52 +1188,76 @@ void broadcastTranscription(String text) {
   sendToAllClients(json);
 }
 
-void broadcastAlarm(unsigned long triggerTime, bool active) {
-  // Rate-limit to 200ms intervals
-  if ((millis() - lastAlarmSync) < 200) return;
-  lastAlarmSync = millis();
-  
-  StaticJsonDocument<128> doc;
-  if (active && triggerTime > 0) {
-    unsigned long remaining = (triggerTime > millis()) ? (triggerTime - millis()) : 0;
-    time_t currentUnixTime = time(nullptr);
-    
-    // Only send if time is synced (for valid timestamps)
-    if (currentUnixTime > 1700000000) {
-      unsigned long alarmUnixTime = (currentUnixTime * 1000) + remaining;
-      doc["alarm"] = true;
-      doc["alarm_time"] = alarmUnixTime;
-      doc["remaining"] = remaining / 1000;
-      doc["is_ringing"] = (currentAIState == AI_ALARMING);
-    } else {
-      doc["alarm"] = false;
-      return;
-    }
+// Describes the ringing alarm, else the next one due. alarm_time is on the wheel's clock,
+// so it is in uptime until the clock is synced; the dashboard counts down from remaining.
+String alarmMessage() {
+  AppDataGuard guard;
+  StaticJsonDocument<192> doc;
+  uint32_t now = alarmNow();
+  bool ringing = (aiState() == AI_ALARMING);
+  int next = alarms.started() ? alarms.earliest() : -1;
+  if (ringing || next >= 0) {
+    uint32_t due = ringing ? now : alarms.get(next)->due;
+    uint32_t remaining = due > now ? due - now : 0;
+    doc["alarm"] = true;
+    doc["alarm_time"] = (uint64_t)due * 1000;
+    doc["remaining"] = remaining;
+    doc["is_ringing"] = ringing;
+    doc["name"] = ringing ? lastAlarmName : alarms.get(next)->name;
+    doc["count"] = alarms.count();
   } else {
     doc["alarm"] = false;
   }
   
   String json;
   serializeJson(doc, json);
-  sendToAllClients(json);
+  return json;
 }
 
-void broadcastTodoLists() {
-  DynamicJsonDocument doc(512);
-  JsonObject lists = doc.createNestedObject("lists");
-  
-  for (auto const& [listName, items] : todoLists) {
-    JsonObject list = lists.createNestedObject(listName);
-    for (auto const& [item, qty] : items) {
-      list[item] = qty;
-    }
-  }
-  
-  String json;
-  serializeJson(doc, json);
+// Every caller changed the alarm state, so only an unchanged repeat is dropped:
+// a time-based rate limit here could swallow the last of two quick changes
+void broadcastAlarm() {
+  String json = alarmMessage();
+  if (json.length() == 0 || json == lastAlarmJson) return;
+  lastAlarmJson = json;
   sendToAllClients(json);
 }
 
+// Serializes a delta once into the log; pumpSyncLog() sends it on from the web task
+void publishDelta(JsonDocument& doc) {
+  AppDataGuard guard;
+  doc["seq"] = ++syncSeq;
+  SyncDelta delta;
+  delta.seq = syncSeq;
+  serializeJson(doc, delta.json);
+  syncLog.push_back(std::move(delta));
+  if (syncLog.size() > SYNC_LOG_MAX) syncLog.pop_front();
+  syncPublished.store(syncSeq, std::memory_order_release);
+}
+
+// Quantity 0 means the item was removed
+void publishTodoItem(const String& listName, const String& item, int qty) {
+  JsonDocument doc;
+  doc["op"] = "todo";
+  doc["list"] = listName;
+  doc["item"] = item;
+  doc["qty"] = qty;
+  publishDelta(doc);
+}
+
+void publishTodoListRemoved(const String& listName) {
+  JsonDocument doc;
+  doc["op"] = "todo_list";
+  doc["list"] = listName;
+  publishDelta(doc);
+}
+
+void publishTodosCleared() {
+  JsonDocument doc;
+  doc["op"] = "todo_clear";
+  publishDelta(doc);
+}
+
 void broadcastCameraMode(String mode) {
   StaticJsonDocument<64> doc;
   doc["camera_mode"] = mode;
@@ -899,59 +1266,155 @@ void broadcastCameraMode(String mode) {
   sendToAllClients(json);
 }
 
-void broadcastChatHistory() {
-  DynamicJsonDocument doc(4096);
-  JsonArray history = doc.createNestedArray("history");
-  
-  for (const auto& msg : chatHistory) {
-    JsonObject msgObj = history.createNestedObject();
-    msgObj["role"] = msg.role;
-    msgObj["content"] = msg.content;
-  }
-  
-  String json;
-  serializeJson(doc, json);
-  sendToAllClients(json);
+void publishChatMessage(ChatRole role, const char* content) {
+  JsonDocument doc;
+  doc["op"] = "chat";
+  doc["role"] = ChatHistoryRing::roleName(role);
+  doc["content"] = content;
+  publishDelta(doc);
 }
 
-void broadcastGallery() {
-  DynamicJsonDocument doc(512);
-  JsonArray gallery = doc.createNestedArray("gallery");
-  
-  if (!lastCapturedImage.empty()) {
+void publishChatCleared() {
+  JsonDocument doc;
+  doc["op"] = "chat_clear";
+  publishDelta(doc);
+}
+
+void addGalleryEntries(JsonArray gallery) {
+  if (lastCapturedImage) {
     JsonObject imgObj = gallery.createNestedObject();
     imgObj["url"] = "/last_image.jpg";
     imgObj["timestamp"] = imageCaptureCounter;
   }
-  
+}
+
+void publishGallery() {
+  JsonDocument doc;
+  doc["op"] = "gallery";
+  addGalleryEntries(doc.createNestedArray("gallery"));
+  publishDelta(doc);
+}
+
+// Web task only
+void sendToClient(uint8_t num, String& json) {
+  if (webSocket.sendTXT(num, json)) {
+    wsMessagesSent++;
+    wsBytesSent += json.length();
+  }
+}
+
+// Only clients that completed the hello get updates; empty slots are skipped.
+// Other tasks hand the message to the web task's outbox instead of touching the socket.
+void sendToAllClients(String& json) {
+  if (xTaskGetCurrentTaskHandle() != webTaskHandle) {
+    String* queued = new String(json);
+    if (xQueueSend(wsOutbox, &queued, 0) != pdTRUE) {
+      delete queued;  // Live status is re-sent on the next change anyway
+    }
+    return;
+  }
+  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+    if (wsClientSynced[i]) sendToClient(i, json);
+  }
+}
+
+void drainWsOutbox() {
+  String* json;
+  while (xQueueReceive(wsOutbox, &json, 0) == pdTRUE) {
+    sendToAllClients(*json);
+    delete json;
+  }
+}
+
+void sendSyncSnapshot(uint8_t num);
+
+// Web task only. Sends each synced client the logged deltas it does not have yet, so a delta
+// published while a hello is being answered is not sent twice. A client the log has already
+// moved past gets a snapshot.
+void pumpSyncLog() {
+  static uint32_t pumped = 0;
+  if (syncPublished.load(std::memory_order_acquire) == pumped) return;
+  AppDataGuard guard;
+  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+    if (!wsClientSynced[i] || wsClientSeq[i] == syncSeq) continue;
+    if (syncLog.empty() || wsClientSeq[i] + 1 < syncLog.front().seq) {
+      sendSyncSnapshot(i);
+    } else {
+      for (SyncDelta& delta : syncLog) {
+        if (delta.seq > wsClientSeq[i]) sendToClient(i, delta.json);
+      }
+    }
+    wsClientSeq[i] = syncSeq;
+  }
+  pumped = syncSeq;
+}
+
+void sendSyncSnapshot(uint8_t num) {
+  JsonDocument doc;
+  doc["op"] = "snapshot";
+  doc["seq"] = syncSeq;
+  doc["epoch"] = syncEpoch;
+
+  JsonArray history = doc.createNestedArray("history");
+  for (size_t i = 0; i < chatRing.size(); i++) {
+    const ChatEntry& e = chatRing.entry(i);
+    if (e.kind != CHAT_PLAIN) continue;  // Tool traffic is not shown in the UI
+    JsonObject msgObj = history.createNestedObject();
+    msgObj["role"] = ChatHistoryRing::roleName(e.role);
+    msgObj["content"] = chatRing.content(i);
+  }
+
+  String lists;  // Written straight from the store, not through the document
+  todoStore.appendJson(lists);
+  doc["lists"] = serialized(lists);
+
+  addGalleryEntries(doc.createNestedArray("gallery"));
+
   String json;
   serializeJson(doc, json);
-  sendToAllClients(json);
+  sendToClient(num, json);
 }
 
-void sendToAllClients(String json) {
-  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
-    if (webSocket.sendTXT(i, json)) {
-      // Message sent
+// Brings a client up to date: replay missed deltas if the log still covers them,
+// otherwise a snapshot. Then the live status, which is never replayed.
+void handleSyncHello(uint8_t num, uint32_t since, uint32_t epoch) {
+  AppDataGuard guard;
+  bool canResume = (epoch == syncEpoch) && since <= syncSeq &&
+                   (since == syncSeq || (!syncLog.empty() && since + 1 >= syncLog.front().seq));
+  if (canResume) {
+    int replayed = 0;
+    for (SyncDelta& delta : syncLog) {
+      if (delta.seq > since) {
+        sendToClient(num, delta.json);
+        replayed++;
+      }
     }
+    Serial.printf("[%u] Sync resumed from %u (%d deltas)\n", num, since, replayed);
+  } else {
+    sendSyncSnapshot(num);
+    Serial.printf("[%u] Sync snapshot at %u\n", num, syncSeq);
   }
+  wsClientSynced[num] = true;
+  wsClientSeq[num] = syncSeq;
+
+  String json = stateMessage(aiState());
+  sendToClient(num, json);
+  json = alarmMessage();
+  if (json.length() > 0) sendToClient(num, json);
 }
 
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length) {
   switch(type) {
     case WStype_DISCONNECTED:
       Serial.printf("[%u] Disconnected\n", num);
+      wsClientSynced[num] = false;
       break;
       
     case WStype_CONNECTED: {
       IPAddress ip = webSocket.remoteIP(num);
       Serial.printf("[%u] Connected from %d.%d.%d.%d\n", num, ip[0], ip[1], ip[2], ip[3]);
-      // Send current state snapshot to new client
-      broadcastState(currentAIState);
-      broadcastAlarm(alarmTriggerTime, alarmTriggerTime != 0);
-      broadcastTodoLists();
-      broadcastChatHistory();
-      broadcastGallery();
+      // Nothing is sent until the client's hello says what it already has
+      wsClientSynced[num] = false;
       break;
     }
     
@@ -966,36 +1429,29 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length
         String type = doc["type"] | "";
         String action = doc["action"] | "";
         
+        if (type == "hello") {
+          handleSyncHello(num, doc["since"] | 0u, doc["epoch"] | 0u);
+        }
+
         if (type == "stop_surveillance") {
           Serial.println("WebSocket: Stop surveillance command received");
-          inSurveillanceMode = false;
-          currentAIState = AI_IDLE;
-          cameraInUse = false;
-          broadcastState(AI_IDLE);
-          broadcastCameraMode("off");
-          Serial.println(">>> Surveillance stopped via web interface");
+          postWebCommand(WEB_CMD_STOP_SURVEILLANCE);
         }
         
         // Handle clear actions from web interface
         if (action == "clear_chat") {
           Serial.println("WebSocket: Clear chat history requested");
-          clearChatHistory();
-          broadcastChatHistory();
+          postWebCommand(WEB_CMD_CLEAR_CHAT);
         }
         
         if (action == "clear_gallery") {
           Serial.println("WebSocket: Clear gallery requested");
-          lastCapturedImage.clear();
-          if (SPIFFS.exists("/last_image.jpg")) {
-            SPIFFS.remove("/last_image.jpg");
-          }
-          broadcastGallery();
+          postWebCommand(WEB_CMD_CLEAR_GALLERY);
         }
         
         if (action == "clear_todos") {
           Serial.println("WebSocket: Clear todos requested");
-          clearTodoLists();
-          broadcastTodoLists();
+          postWebCommand(WEB_CMD_CLEAR_TODOS);
         }
       }
       break;
@@ -1003,69 +1459,111 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length
   }
 }
 
-// Task for handling MJPEG stream on separate core (prevents main loop blocking)
-void streamTask(void *param) {
-    Serial.println("Stream: Task started on separate core");
-    
-    WiFiClient client = server.client();
-    if (!client.connected()) {
-        Serial.println("Stream: Client not connected");
-        streamTaskRunning = false;
-        vTaskDelete(NULL);
-        return;
+// ========== CAMERA FRAME BROKER ==========
+// One capture task reads the camera and fans each JPEG out to every /stream
+// viewer through frameBroker; each viewer is served by its own sender task.
+
+// Grabs one frame into a SharedFrame; nullptr if the camera or PSRAM failed
+SharedFrame* captureSharedFrame() {
+    xSemaphoreTake(cameraLock, portMAX_DELAY);
+    camera_fb_t *fb = esp_camera_fb_get();
+    SharedFrame* frame = nullptr;
+    if (fb && fb->len > 0) {
+        frame = sharedFrameCreate(fb->buf, fb->len, ++cameraFramesCaptured);
+        if (!frame) Serial.println("Camera: Frame copy failed (PSRAM)");
     }
-    
-    String response = "HTTP/1.1 200 OK\r\n";
-    response += "Content-Type: multipart/x-mixed-replace; boundary=frame\r\n";
-    response += "Cache-Control: no-cache\r\n";
-    response += "Connection: keep-alive\r\n\r\n";
-    
-    client.print(response);
-    client.flush();
-    
-    int frameCount = 0;
+    if (fb) esp_camera_fb_return(fb);   // Copied: the driver can refill while the frame is in use
+    xSemaphoreGive(cameraLock);
+    return frame;
+}
+
+// Keeps a recent frame in the broker so a vision request never waits for the sensor.
+// While the stream is running its frames are fresh enough and nothing extra is captured.
+void visionPrefetchTask(void *param) {
+    for (;;) {
+        vTaskDelay(VISION_PREFETCH_MS / portTICK_PERIOD_MS);
+        if (frameBroker.latestAge() < VISION_PREFETCH_MS) continue;
+        SharedFrame* frame = captureSharedFrame();
+        if (frame) frameBroker.publish(frame);
+    }
+}
+
+// Capture task: grabs each frame once, at most streamMaxFps, while anyone is watching.
+// Runs until surveillance mode ends.
+void streamCaptureTask(void *param) {
+    Serial.println("Stream: Capture task started");
     unsigned long streamStartTime = millis();
-    unsigned long lastFrameSendTime = 0;
-    
-    while (client.connected() && inSurveillanceMode) {
-        // 1. Give the main loop time to run (Fixes touch sensor freeze)
-        vTaskDelay(5 / portTICK_PERIOD_MS);
-        
-        // 2. Pause stream if Kiko is speaking or listening to save PSRAM bandwidth
-        if (cameraInUse || currentAIState == AI_LISTENING || currentAIState == AI_SPEAKING) {
+    unsigned long lastCapture = 0;
+
+    while (inSurveillanceMode) {
+        // Pause capture with no viewers, or if Kiko is speaking or listening to save PSRAM bandwidth
+        if (frameBroker.viewerCount() == 0 || aiState() == AI_LISTENING || aiState() == AI_SPEAKING) {
             vTaskDelay(100 / portTICK_PERIOD_MS);
             continue;
         }
-        
+
         // Timeout after 2 hours
         if (millis() - streamStartTime > 7200000) {
             Serial.println("Stream: 2-hour timeout reached");
             break;
         }
-        
-        // Get frame
-        camera_fb_t *fb = esp_camera_fb_get();
-        if (!fb) {
+
+        unsigned long interval = 1000 / (streamMaxFps > 0 ? streamMaxFps : 1);
+        unsigned long elapsed = millis() - lastCapture;
+        if (elapsed < interval) {
+            vTaskDelay((interval - elapsed) / portTICK_PERIOD_MS);
+            continue;
+        }
+        lastCapture = millis();
+
+        SharedFrame* frame = captureSharedFrame();
+        if (!frame) {
             vTaskDelay(10 / portTICK_PERIOD_MS);
             continue;
         }
-        
-        // Send MJPEG frame
-        client.printf("--frame\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n", fb->len);
-        size_t sent = client.write(fb->buf, fb->len);
-        client.print("\r\n");
-        
-        esp_camera_fb_return(fb);
-        frameCount++;
-        
-        if (frameCount % 30 == 0) {
-            Serial.printf("Stream: Sent %d frames\n", frameCount);
+        frameBroker.publish(frame);
+    }
+
+    Serial.printf("Stream: Capture task ended. Frames captured: %u\n", cameraFramesCaptured);
+    streamCaptureTaskHandle = nullptr;
+    vTaskDelete(NULL);
+}
+
+// Sender task: writes the viewer's queued frames; only this viewer waits on its socket
+void streamViewerTask(void *param) {
+    int slot = (int)(intptr_t)param;
+    StreamViewer& viewer = frameBroker.viewer(slot);
+    WiFiClient client = *streamPendingClient;
+    delete streamPendingClient;
+    streamPendingClient = nullptr;
+    xSemaphoreGive(streamHandoff);
+
+    client.setNoDelay(true);
+    client.print("HTTP/1.1 200 OK\r\n"
+                 "Content-Type: multipart/x-mixed-replace; boundary=frame\r\n"
+                 "Cache-Control: no-cache\r\n"
+                 "Connection: keep-alive\r\n\r\n");
+
+    while (client.connected() && inSurveillanceMode) {
+        SharedFrame* frame = frameBroker.next(slot, 500 / portTICK_PERIOD_MS);
+        if (!frame) continue;
+
+        char header[96];
+        int headerLen = snprintf(header, sizeof(header), "--frame\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n", (unsigned)frame->len);
+        bool ok = client.write((const uint8_t*)header, headerLen) == (size_t)headerLen &&
+                  client.write(frame->data, frame->len) == frame->len &&
+                  client.write((const uint8_t*)"\r\n", 2) == 2;
+        if (ok) {
+            viewer.framesSent++;
+            viewer.bytesSent += headerLen + frame->len + 2;
         }
+        sharedFrameRelease(frame);
+        if (!ok) break;
     }
-    
-    Serial.printf("Stream: Task ended. Total frames: %d\n", frameCount);
+
+    Serial.printf("Stream: Viewer %d ended. Sent %u, dropped %u\n", slot, (unsigned)viewer.framesSent, (unsigned)viewer.framesDropped);
     client.stop();
-    streamTaskRunning = false;
+    frameBroker.unsubscribe(slot);
     vTaskDelete(NULL);
 }
 
@@ -1076,30 +1574,83 @@ void handleStream() {
         Serial.println("Stream: Rejected - surveillance not active");
         return;
     }
-    
-    // Stop previous task if still running
-    if (streamTaskRunning && streamTaskHandle != nullptr) {
-        vTaskDelete(streamTaskHandle);
-        streamTaskHandle = nullptr;
-        vTaskDelay(100 / portTICK_PERIOD_MS);
+
+    WiFiClient client = server.client();
+    int slot = frameBroker.subscribe((uint32_t)client.remoteIP());
+    if (slot < 0) {
+        server.send(503, "text/plain", "Too many viewers");
+        Serial.println("Stream: Rejected - all viewer slots in use");
+        return;
     }
-    
-    streamTaskRunning = true;
-    Serial.println("Stream: Creating task on Core 1");
-    
-    // Create task on Core 1 (prevents WiFi interference from Core 0)
-    // Core 0 handles WiFi/network stack, Core 1 runs main app
-    xTaskCreatePinnedToCore(
-        streamTask,           // Task function
-        "StreamTask",         // Task name
-        8192,                 // Stack size (bytes) - reduced to save RAM
-        NULL,                 // Parameter
-        1,                    // Priority (1 = lower than main loop)
-        &streamTaskHandle,    // Task handle
-        1                     // Core 1 (prevents WiFi packet interference)
-    );
-    
-    // Don't send anything - let the task handle the client
+
+    // Hand the connection to the sender task and wait until it has taken its copy
+    streamPendingClient = new WiFiClient(client);
+    char name[16];
+    snprintf(name, sizeof(name), "StreamView%d", slot);
+    if (xTaskCreatePinnedToCore(streamViewerTask, name, 4096, (void*)(intptr_t)slot, 1,
+                                &frameBroker.viewer(slot).task, 1) != pdPASS) {
+        delete streamPendingClient;
+        streamPendingClient = nullptr;
+        frameBroker.unsubscribe(slot);
+        server.send(503, "text/plain", "Stream task failed");
+        return;
+    }
+    xSemaphoreTake(streamHandoff, portMAX_DELAY);
+    Serial.printf("Stream: Viewer %d connected (%d watching)\n", slot, frameBroker.viewerCount());
+
+    if (streamCaptureTaskHandle == nullptr) {
+        // Core 1 (prevents WiFi packet interference on Core 0), below the main loop
+        xTaskCreatePinnedToCore(streamCaptureTask, "StreamCapture", 4096, NULL, 1, &streamCaptureTaskHandle, 1);
+    }
+
+    // Don't send anything - the sender task owns the client now
+}
+
+// Per-viewer counters, shared by /api/stream and the dashboard
+void writeStreamStats(JsonObject out) {
+    out["maxFps"] = streamMaxFps;
+    out["captured"] = cameraFramesCaptured;
+    JsonArray viewers = out.createNestedArray("viewers");
+    for (int i = 0; i < STREAM_MAX_VIEWERS; i++) {
+        StreamViewer& v = frameBroker.viewer(i);
+        if (!v.active) continue;
+        JsonObject o = viewers.createNestedObject();
+        o["ip"] = IPAddress(v.ip).toString();
+        o["sent"] = (uint32_t)v.framesSent;
+        o["dropped"] = (uint32_t)v.framesDropped;
+        o["kb"] = (uint32_t)v.bytesSent / 1024;
+        o["secs"] = (millis() - v.connectedAt) / 1000;
+    }
+}
+
+// GET /api/stream[?fps=N]: viewer stats; fps changes the capture cap
+void handleStreamStatsAPI() {
+    if (server.hasArg("fps")) {
+        int fps = server.arg("fps").toInt();
+        if (fps >= 1 && fps <= 30) streamMaxFps = fps;
+    }
+    JsonDocument doc;
+    writeStreamStats(doc.to<JsonObject>());
+    String json;
+    serializeJson(doc, json);
+    server.send(200, "application/json", json);
+}
+
+// Pushes viewer stats to the dashboard every 2 s while anyone is watching
+void broadcastStreamStats() {
+    static unsigned long lastStreamStats = 0;
+    static int lastViewerCount = 0;
+    int viewers = frameBroker.viewerCount();
+    if (viewers == 0 && lastViewerCount == 0) return;
+    if (viewers == lastViewerCount && millis() - lastStreamStats < 2000) return;
+    lastStreamStats = millis();
+    lastViewerCount = viewers;
+
+    JsonDocument doc;
+    writeStreamStats(doc.createNestedObject("stream"));
+    String json;
+    serializeJson(doc, json);
+    sendToAllClients(json);
 }
 
 // ========== INITIALIZATION (SETUP) ==========
@@ -1107,6 +1658,18 @@ void handleStream() {
 
 void setup() {
     Serial.begin(115200);
+
+    // Queues first: anything below may already publish events or dashboard updates
+    appDataLock = xSemaphoreCreateRecursiveMutex();
+    pipelineEvents = eventBus.subscribe(EVENT_MASK(EV_TOUCH_DOWN) | EVENT_MASK(EV_TOUCH_UP) | EVENT_MASK(EV_LONG_PRESS) |
+                                        EVENT_MASK(EV_SENTENCE_DONE) | EVENT_MASK(EV_WEB_COMMAND), PIPELINE_EVENT_DEPTH);
+    webEvents = eventBus.subscribe(EVENT_MASK(EV_STATE_CHANGED), 8);
+    displayEvents = eventBus.subscribe(EVENT_MASK(EV_STATE_CHANGED), 4);
+    wsOutbox = xQueueCreate(WS_OUTBOX_DEPTH, sizeof(String*));
+    audioCommands = xQueueCreate(AUDIO_COMMAND_DEPTH, sizeof(AudioCommand));
+    ttsCacheLock = xSemaphoreCreateMutex();
+    toolCache.begin();
+    ttsFetchQueue = xQueueCreate(TTS_FETCH_DEPTH, sizeof(String*));
     Wire.begin(OLED_SDA_PIN, OLED_SCL_PIN);
 
     // Initialize SPIFFS for persistent data storage
@@ -1115,15 +1678,20 @@ void setup() {
     } else {
         Serial.println("SPIFFS Mount Successful");
         loadTodoLists();
+        loadToolCache();
+        alarmWavReady = renderAlarmWav();
     }
 
+    initToolRegistry();
+    intentMatcher.begin();
+
     // Initialize OLED display
     u8g2.begin();
     u8g2.clearBuffer();
     u8g2.sendBuffer();
     u8g2.setFontMode(1);
 
-    currentAIState = AI_IDLE;
+    setAIState(AI_IDLE);
     introSpoken = false;
 
     pinMode(RGB_RED_PIN, OUTPUT);
@@ -1131,11 +1699,24 @@ void setup() {
     pinMode(RGB_BLUE_PIN, OUTPUT);
     setLedState(AI_IDLE);
 
+    if (!chatRing.begin()) {
+        Serial.println("FATAL: Failed to allocate chat history memory!");
+        while(1);
+    }
+    frameBroker.begin();
+    streamHandoff = xSemaphoreCreateBinary();
+    cameraLock = xSemaphoreCreateMutex();
+
     audio_buffer = (int16_t*) ps_malloc(audio_buffer_size);
     if (!audio_buffer) {
         Serial.println("FATAL: Failed to allocate audio buffer memory!");
         while(1);
     }
+#if WHISPER_UPLOAD_FLAC
+    flacFrameBuffer = (uint8_t*) ps_malloc(FLAC_MAX_FRAME_BYTES);
+    flacReady = flacFrameBuffer && flacEncoder.begin(SAMPLE_RATE);
+    if (!flacReady) Serial.println("⚠ FLAC encoder unavailable, uploading WAV");
+#endif
 
     // Connect to WiFi with optimizations
     Serial.println("\n===== WiFi CONNECTION =====");
@@ -1190,6 +1771,26 @@ void setup() {
     }
     Serial.println("===========================\n");
 
+    // Register every outbound API host with the keep-alive connection pool
+    apiPool.addHost(openai_host);
+#ifdef WEATHER_MOCK_HOST
+    apiPool.addHost(weather_host, WEATHER_MOCK_PORT, false);
+#else
+    apiPool.addHost(weather_host);
+#endif
+#ifdef SEARCH_MOCK_HOST
+    apiPool.addHost(google_search_host, SEARCH_MOCK_PORT, false);
+#else
+    apiPool.addHost(google_search_host);
+#endif
+    apiPool.addHost(tts_host);
+#ifdef WHISPER_MOCK_HOST
+    apiPool.addHost(whisper_host, WHISPER_MOCK_PORT, false);
+#endif
+#ifdef CHAT_MOCK_HOST
+    apiPool.addHost(chat_host, CHAT_MOCK_PORT, false);
+#endif
+
     // Display IP address on OLED screen briefly
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_ncenB10_tr);
@@ -1215,10 +1816,7 @@ void setup() {
                 type = "filesystem";
             Serial.println("Start updating " + type);
             // Display OTA status on OLED
-            u8g2.clearBuffer();
-            u8g2.setFont(u8g2_font_ncenB10_tr);
-            u8g2.drawStr(20, 35, "OTA Update...");
-            u8g2.sendBuffer();
+            displayShowMessage("OTA Update...", 0);
         })
         .onEnd([]() {
             Serial.println("\nEnd");
@@ -1231,10 +1829,7 @@ void setup() {
             delay(500);
             digitalWrite(RGB_GREEN_PIN, LOW);
             // --- END LED INDICATION ---
-            u8g2.clearBuffer();
-            u8g2.setFont(u8g2_font_ncenB10_tr);
-            u8g2.drawStr(20, 35, "Update OK!");
-            u8g2.sendBuffer();
+            displayShowMessage("Update OK!");
             delay(1000);
         })
         .onProgress([](unsigned int progress, unsigned int total) {
@@ -1247,9 +1842,7 @@ void setup() {
             digitalWrite(RGB_BLUE_PIN,  (cycle == 2) ? LOW : HIGH);
             // --- END LED INDICATION ---
             // Update OLED progress bar
-            u8g2.drawFrame(10, 50, 108, 10);
-            u8g2.drawBox(12, 52, (104 * progress) / total, 6);
-            u8g2.sendBuffer();
+            displayShowMessage("OTA Update...", (int)((uint64_t)progress * 100 / total));
         })
         .onError([](ota_error_t error) {
             Serial.printf("Error[%u]: ", error);
@@ -1271,11 +1864,9 @@ void setup() {
             delay(500);
             digitalWrite(RGB_RED_PIN, LOW);
             // --- END LED INDICATION ---
-            u8g2.clearBuffer();
-            u8g2.setFont(u8g2_font_ncenB10_tr);
-            u8g2.drawStr(20, 35, "OTA Error!");
-            u8g2.sendBuffer();
+            displayShowMessage("OTA Error!");
             delay(2000);
+            displayShowMessage(nullptr);
         });
 
     ArduinoOTA.begin(); // Start the OTA service
@@ -1350,6 +1941,10 @@ void setup() {
         }
     }
     
+    if (micInitSuccess) {
+        startMicCaptureTask();
+    }
+
     if (!micInitSuccess) {
         Serial.println("❌ Failed to initialize I2S microphone after 3 attempts!");
         Serial.println("⚠️  Kiko will continue without microphone. Voice input will not work.");
@@ -1359,20 +1954,24 @@ void setup() {
     // Initialize I2S audio output
     audio.setPinout(I2S_BCLK, I2S_LRC, I2S_DOUT);
     audio.setVolume(21); // Set default volume (0-10)
+    startAudioTask();
+    startTtsCacheTask();
 
     showLoadingScreen("Camera...");
     delay(2000); 
     initCamera(); // Initialize camera
     Serial.println("✅ Camera Hardware Initialized");
-    // Setup web server routes (SPIFFS-backed)
-    // Root and static assets are served from SPIFFS via handleFile() or server.serveStatic
-    server.on("/", handleFile);          // Root serves /index.html from SPIFFS
+    // Setup web server routes
+    // The dashboard is served gzipped from flash (web_assets.h); other paths fall back to SPIFFS
+    server.on("/", handleFile);          // Root serves /index.html
     server.on("/index.html", handleFile);
     server.on("/style.css", handleFile);
     server.on("/app.js", handleFile);
     server.on("/favicon.ico", handleFile);
 
     server.on("/api/state", handleStateAPI); // Handle API requests for state updates
+    server.on("/api/connections", handleConnectionStatsAPI); // Per-host handshake/reuse counters
+    server.on("/api/audio", handleAudioStatsAPI);              // Mic ring buffer counters
     server.on("/tasks_data", handleTasksData); // Handle tasks tab data updates (serves small fragment)
     server.on("/clear_chat", handleClearChat); // Handle clear chat history
     server.on("/clear_gallery", handleClearGallery); // Handle clear gallery
@@ -1381,13 +1980,20 @@ void setup() {
     server.on("/rtttl/alarm", handleRtttlAlarm);
     server.on("/last_image.jpg", handleImage);
     server.on("/stream", handleStream);  // Live MJPEG stream for surveillance
+    server.on("/api/stream", handleStreamStatsAPI);            // Stream viewers, fps cap
+    server.on("/api/display", handleDisplayStatsAPI);          // OLED frames and bytes per scene
+    server.on("/api/runtime", handleRuntimeStatsAPI);          // Task stacks, event bus, worst-case latencies
+    server.on("/api/metrics", handleMetricsAPI);               // Latency histograms and gauges (Prometheus text)
 
     server.onNotFound(handleFile); // Catch-all: attempt to serve requested path from SPIFFS
 
+    const char* cacheHeaders[] = {"If-None-Match"};
+    server.collectHeaders(cacheHeaders, 1);  // Revalidation of the dashboard assets
     server.begin();                      // Start the web server
-    Serial.println("Web server started (SPIFFS-backed).");
+    Serial.println("Web server started.");
     
     // --- INITIALIZE WEBSOCKET SERVER ---
+    syncEpoch = esp_random() | 1;  // Non-zero, so a fresh page (epoch 0) always gets a snapshot
     webSocket.begin();
     webSocket.onEvent(webSocketEvent);
     Serial.println("WebSocket server started on port 81.");
@@ -1404,86 +2010,591 @@ void setup() {
     u8g2.drawStr(35, 50, "Ready!");
     u8g2.sendBuffer();
     delay(2000);
+    startDisplayTask();
+    startWebTask();
 
     // Set initial state and inactivity timer
-    currentAIState = AI_IDLE;
+    setAIState(AI_IDLE);
 
-    // Wait for NTP time sync before speaking - critical for TTS
-    Serial.println("Waiting for NTP time sync before introduction...");
-    int ntp_wait = 0;
-    time_t currentTime = time(nullptr);
-    while (currentTime < 24 * 3600 && ntp_wait < 30) {  // Wait up to 15 seconds
-        // Keep systems responsive during NTP wait
-        ArduinoOTA.handle();  // Handle OTA if initiated
-        delay(500);
-        currentTime = time(nullptr);
-        ntp_wait++;
-        if (ntp_wait % 4 == 0) Serial.print(".");
+    // Flag to speak introduction in main loop (not here in setup)
+    introSpoken = false;
+}
+
+// ========== TOOL REGISTRY ==========
+// Every tool the model can call is declared once here: its name, the JSON schema
+// sent to the model, its handler and how it may be executed. The registry is the
+// single source for both dispatch (hashed lookup) and the request's "tools" array.
+//
+// Independent network-bound tools without side effects (weather, search) run
+// concurrently on worker tasks; everything else runs on the main task, in order.
+// Results are always recorded in the order the model issued the calls.
+
+typedef String (*ToolHandler)(JsonObject args);
+
+struct ToolDef {
+    const char* name;
+    const char* schema;        // PROGMEM JSON object for the request's "tools" array
+    ToolHandler handler;
+    bool hasSideEffects;       // Changes device state: must run on the main task
+    bool networkBound;         // Slow upstream call: may run on a worker task
+    bool speakResultDirectly;  // Result is the final answer: no summary call to the model
+    uint32_t hash;             // FNV-1a of name, filled by initToolRegistry()
+};
+
+const char TOOL_SCHEMA_GET_WEATHER[] PROGMEM = R"JSON({"type":"function","function":{"name":"get_weather","description":"Gets the current weather for a specific city.","parameters":{"type":"object","properties":{"city":{"type":"string","description":"The city, e.g., 'San Francisco'"}},"required":["city"]}}})JSON";
+const char TOOL_SCHEMA_GET_NETWORK_INFO[] PROGMEM = R"JSON({"type":"function","function":{"name":"get_network_info","description":"Gets the device's local network information including WiFi SSID, IP address, and signal strength. This is safe to share as it's the user's own device's information.","parameters":{"type":"object","properties":{}}}})JSON";
+const char TOOL_SCHEMA_GOOGLE_SEARCH[] PROGMEM = R"JSON({"type":"function","function":{"name":"google_search","description":"Searches Google for real-time information, news, definitions, or facts not in your knowledge base.","parameters":{"type":"object","properties":{"query":{"type":"string","description":"The search query, e.g., 'latest news on Mars rover'"}},"required":["query"]}}})JSON";
+const char TOOL_SCHEMA_SET_ALARM_RELATIVE[] PROGMEM = R"JSON({"type":"function","function":{"name":"set_alarm_relative","description":"Sets an alarm (timer) to go off after a specified duration, e.g., 'in 5 minutes' or 'for 30 seconds'. Several alarms can be set at once.","parameters":{"type":"object","properties":{"delay_seconds":{"type":"number","description":"The number of seconds from now to set the alarm for."},"label":{"type":"string","description":"Optional short name for the alarm, e.g., 'pasta'."}},"required":["delay_seconds"]}}})JSON";
+const char TOOL_SCHEMA_SET_ALARM_ABSOLUTE[] PROGMEM = R"JSON({"type":"function","function":{"name":"set_alarm_absolute","description":"Sets an alarm for a specific time of day, e.g., 'at 2:30 PM' or 'every day at 7 AM'. Several alarms can be set at once.","parameters":{"type":"object","properties":{"hour":{"type":"number","description":"The target hour, in 1-12 format."},"minute":{"type":"number","description":"The target minute (0-59)."},"period":{"type":"string","description":"The period of day, either 'AM' or 'PM'."},"label":{"type":"string","description":"Optional short name for the alarm, e.g., 'wake up'."},"repeat":{"type":"string","enum":["once","daily","weekly"],"description":"How often the alarm repeats. Defaults to 'once'."}},"required":["hour","minute","period"]}}})JSON";
+const char TOOL_SCHEMA_GET_ALARM_STATUS[] PROGMEM = R"JSON({"type":"function","function":{"name":"get_alarm_status","description":"Checks which alarms are set and when the next one is scheduled to ring."}})JSON";
+const char TOOL_SCHEMA_CANCEL_ALARM[] PROGMEM = R"JSON({"type":"function","function":{"name":"cancel_alarm","description":"Cancels the alarm with the given label, or every alarm if no label is given.","parameters":{"type":"object","properties":{"label":{"type":"string","description":"The name of the alarm to cancel, e.g., 'pasta'."}}}}})JSON";
+const char TOOL_SCHEMA_SNOOZE_ALARM[] PROGMEM = R"JSON({"type":"function","function":{"name":"snooze_alarm","description":"Snoozes the alarm that is ringing or just rang, so it rings again later.","parameters":{"type":"object","properties":{"minutes":{"type":"number","description":"Minutes until it rings again. Defaults to 9."}}}}})JSON";
+const char TOOL_SCHEMA_ADD_TODO_ITEM[] PROGMEM = R"JSON({"type":"function","function":{"name":"add_todo_item","description":"Adds an item to a to-do list. If the item already exists, its quantity is increased.","parameters":{"type":"object","properties":{"list_name":{"type":"string","description":"The name of the list, e.g., 'groceries', 'work'."},"item":{"type":"string","description":"The name of the item. If units are given (e.g., kg, litres), include them in the name. e.g., 'apples', 'rice (kg)', 'milk (litres)'."},"quantity":{"type":"number","description":"The quantity for the item. Must be extracted from the user's request (e.g., '1' for '1 kg rice', '3' for '3 apples'). Defaults to 1 if not specified."}},"required":["list_name","item"]}}})JSON";
+const char TOOL_SCHEMA_REMOVE_TODO_ITEM[] PROGMEM = R"JSON({"type":"function","function":{"name":"remove_todo_item","description":"Removes an item from a to-do list. If quantity is provided, it subtracts that amount. If no quantity is provided, it removes the item entirely.","parameters":{"type":"object","properties":{"list_name":{"type":"string","description":"The name of the list, e.g., 'groceries'."},"item":{"type":"string","description":"The name of the item to remove. Must match the stored name, e.g., 'apples', 'rice (kg)'."},"quantity":{"type":"number","description":"The quantity to remove. If not specified, all items of this type are removed."}},"required":["list_name","item"]}}})JSON";
+const char TOOL_SCHEMA_LIST_TODO_ITEMS[] PROGMEM = R"JSON({"type":"function","function":{"name":"list_todo_items","description":"Gets all items and their quantities from a specific to-do list. If no list_name is given, it lists all available to-do lists.","parameters":{"type":"object","properties":{"list_name":{"type":"string","description":"The name of the list to read, e.g., 'groceries'."}}}}})JSON";
+const char TOOL_SCHEMA_CLEAR_TODO_LIST[] PROGMEM = R"JSON({"type":"function","function":{"name":"clear_todo_list","description":"Removes all items from a specific to-do list, deleting the list.","parameters":{"type":"object","properties":{"list_name":{"type":"string","description":"The name of the list to clear, e.g., 'groceries'."}},"required":["list_name"]}}})JSON";
+
+String toolGetWeather(JsonObject args) {
+    String city = args["city"].as<String>();
+    return handleWeatherRequest(city);
+}
+
+String toolGetNetworkInfo(JsonObject args) {
+    // Provide device's local network information
+    String ssid = WiFi.SSID();
+    String ipAddr = WiFi.localIP().toString();
+    long rssi = WiFi.RSSI();
+    displayShowNetworkInfo();
+    return "Your WiFi network is '" + ssid + "'. Your device's IP address is " + ipAddr + ". Signal strength is " + String(rssi) + " dBm.";
+}
+
+String toolGoogleSearch(JsonObject args) {
+    String query = args["query"].as<String>();
+    return handleGoogleSearch(query);
+}
+
+// Alarm label from the tool arguments, lowercased; "alarm" when none was given
+String alarmLabel(JsonObject args) {
+    String label = args["label"] | "";
+    label.trim();
+    label.toLowerCase();
+    if (label.length() == 0) label = ALARM_DEFAULT_NAME;
+    return label.substring(0, ALARM_NAME_LEN - 1);
+}
+
+String spokenDuration(uint32_t seconds) {
+    uint32_t hours = seconds / 3600;
+    uint32_t minutes = (seconds % 3600) / 60;
+    if (hours > 0) {
+        return String(hours) + " hour" + (hours > 1 ? "s" : "") + " and " + String(minutes) + " minute" + (minutes != 1 ? "s" : "");
     }
-    if (currentTime >= 24 * 3600) {
-        Serial.println("\n✓ NTP synced! Time is valid.");
-    } else {
-        Serial.println("\n⚠️  NTP sync timeout - may affect TTS");
+    return String(minutes) + " minute" + (minutes != 1 ? "s" : "") + " and " + String(seconds % 60) + " seconds";
+}
+
+// Adds an alarm due at a Unix time, saves the set and tells the dashboard. False if the
+// clock is not synced yet or every alarm slot is taken.
+bool scheduleAlarm(const String& label, uint32_t due, uint32_t repeatSec) {
+    {
+        AppDataGuard guard;
+        if (!alarmClockSynced || !alarms.started() || alarms.add(label.c_str(), due, repeatSec) < 0) return false;
     }
-    delay(1000);  // Additional buffer to ensure all systems are ready
+    saveAlarms();
+    alarmUpdateCounter++;
+    broadcastAlarm(); // --- SYNC TO UI ---
+    return true;
+}
 
-    // Flag to speak introduction in main loop (not here in setup)
-    introSpoken = false;
+// One-shot alarm in `seconds`, on whichever clock the wheel runs: works before NTP answers.
+// The due time is taken under the lock so a rebase cannot slip in between. False if every
+// alarm slot is taken.
+bool scheduleAlarmIn(const String& label, uint32_t seconds) {
+    {
+        AppDataGuard guard;
+        if (!alarms.started() || alarms.add(label.c_str(), alarmNow() + seconds, 0) < 0) return false;
+    }
+    saveAlarms();
+    alarmUpdateCounter++;
+    broadcastAlarm(); // --- SYNC TO UI ---
+    return true;
+}
+
+// Stops the ringing alarm, or takes the one that rang last, and sets it to ring again.
+// A one-shot alarm of that name still pending (snoozed before) is moved rather than
+// duplicated; a recurring one keeps its schedule and gets a one-shot snooze beside it.
+bool snoozeAlarm(uint32_t seconds) {
+    if (lastAlarmName[0] == '\0') return false;
+    if (aiState() == AI_ALARMING) stopAlarm("😴 Alarm snoozed", false);  // One broadcast below
+    int id = -1;
+    {
+        AppDataGuard guard;
+        id = alarms.started() ? alarms.find(lastAlarmName) : -1;
+        if (id >= 0 && alarms.get(id)->repeatSec > 0) {
+            id = -1;
+            alarms.forEach([&](int i, const AlarmTimer& t) {
+                if (id < 0 && t.repeatSec == 0 && strcmp(t.name, lastAlarmName) == 0) id = i;
+            });
+        }
+        if (id >= 0) alarms.reschedule(id, alarmNow() + seconds);
+    }
+    if (id < 0) {
+        if (scheduleAlarmIn(lastAlarmName, seconds)) return true;
+        broadcastAlarm();   // Stopped, but no slot to ring again in
+        return false;
+    }
+    saveAlarms();
+    alarmUpdateCounter++;
+    broadcastAlarm(); // --- SYNC TO UI ---
+    return true;
+}
+
+String toolSetAlarmRelative(JsonObject args) {
+    int delay_seconds = args["delay_seconds"].as<int>();
+    if (delay_seconds <= 0) {
+        return "That time doesn't look right. Could you try again?";
+    }
+    if (!scheduleAlarmIn(alarmLabel(args), delay_seconds)) {
+        return alarms.started() ? "You already have too many alarms. Could you cancel one first?"
+                                : "I'm having trouble reading the time right now. Can you try setting the alarm again?";
+    }
+    setAIState(AI_IDLE);
+    int minutes = delay_seconds / 60;
+    int seconds = delay_seconds % 60;
+    if (minutes > 0) {
+        return "Got it! I'll wake you in " + String(minutes) + " minute" + (minutes > 1 ? "s" : "") + ".";
+    }
+    return "All set! Your alarm is ready in " + String(seconds) + " seconds.";
+}
+
+String toolSetAlarmAbsolute(JsonObject args) {
+    int targetHour = args["hour"].as<int>();
+    int targetMinute = args["minute"].as<int>();
+    String period = args["period"].as<String>();
+    period.toUpperCase();
+    String repeat = args["repeat"] | "once";
+    struct tm timeinfo_alarm; 
+    if (!getLocalTime(&timeinfo_alarm)) {
+        return "I'm having trouble reading the time right now. Can you try setting the alarm again?";
+    }
+    int targetHour24 = targetHour;
+    if (period == "PM" && targetHour != 12) { targetHour24 += 12; }
+    if (period == "AM" && targetHour == 12) { targetHour24 = 0; }
+    // Due time from the local calendar, so it is right across DST changes
+    time_t now = time(nullptr);
+    timeinfo_alarm.tm_hour = targetHour24;
+    timeinfo_alarm.tm_min = targetMinute;
+    timeinfo_alarm.tm_sec = 0;
+    time_t due = mktime(&timeinfo_alarm);
+    if (due - now < 10) { 
+        due += 86400; 
+    }
+    uint32_t repeatSec = repeat == "daily" ? 86400 : repeat == "weekly" ? 604800 : 0;
+    if (!scheduleAlarm(alarmLabel(args), due, repeatSec)) {
+        return alarmClockSynced ? "You already have too many alarms. Could you cancel one first?"
+                                : "I'm having trouble reading the time right now. Can you try setting the alarm again?";
+    }
+    setAIState(AI_IDLE);
+    String minuteStr = (targetMinute < 10) ? "0" + String(targetMinute) : String(targetMinute);
+    String every = repeatSec == 86400 ? " every day" : repeatSec == 604800 ? " every week" : "";
+    return "Perfect! I'll alarm you at " + String(targetHour) + ":" + minuteStr + " " + period + every + ".";
+}
+
+String toolGetAlarmStatus(JsonObject args) {
+    if (aiState() == AI_ALARMING) {
+        return "Your alarm is going off right now!";
+    }
+    AppDataGuard guard;
+    int next = alarms.started() ? alarms.earliest() : -1;
+    if (next < 0) {
+        return "You don't have any alarms set right now.";
+    }
+    const AlarmTimer* t = alarms.get(next);
+    uint32_t now = alarmNow();
+    String in = "in about " + spokenDuration(t->due > now ? t->due - now : 0);
+    String name = strcmp(t->name, ALARM_DEFAULT_NAME) == 0 ? String("") : " '" + String(t->name) + "'";
+    if (alarms.count() == 1) {
+        return "You've got an alarm" + name + " coming up " + in + ".";
+    }
+    return "You have " + String(alarms.count()) + " alarms set. The next one" + name + " rings " + in + ".";
+}
+
+String toolCancelAlarm(JsonObject args) {
+    String label = args["label"] | "";
+    label.toLowerCase();
+    int cancelled = 0;
+    {
+        AppDataGuard guard;
+        std::vector<int> ids;
+        alarms.forEach([&](int id, const AlarmTimer& t) {
+            if (label.length() == 0 || label == t.name) ids.push_back(id);
+        });
+        for (int id : ids) cancelled += alarms.cancel(id);
+    }
+    if (cancelled == 0) {
+        return label.length() ? "I couldn't find an alarm called " + label + "." : "No alarm to cancel right now.";
+    }
+    saveAlarms();
+    alarmUpdateCounter++;
+    broadcastAlarm(); // --- SYNC TO UI ---
+    if (cancelled > 1) return "Done! I've cancelled " + String(cancelled) + " alarms.";
+    return "Done! I've cancelled your alarm.";
+}
+
+String toolSnoozeAlarm(JsonObject args) {
+    int minutes = args["minutes"] | ALARM_SNOOZE_SEC / 60;
+    if (minutes <= 0) minutes = ALARM_SNOOZE_SEC / 60;
+    if (!snoozeAlarm(minutes * 60)) {
+        return "There's no alarm to snooze right now.";
+    }
+    return "Okay, I'll ring again in " + String(minutes) + " minute" + (minutes > 1 ? "s" : "") + ".";
+}
+
+// Todo names are matched loosely (see todoNormalize), so the tools answer with the
+// spelling already on the list
+String toolAddTodoItem(JsonObject args) {
+    AppDataGuard guard;  // The web task may be reading the lists for a snapshot
+    String listName = args["list_name"].as<String>();
+    listName.toLowerCase();
+    String item = args["item"].as<String>();
+    item.toLowerCase(); 
+    
+    int quantity = 1; 
+    if (args.containsKey("quantity")) {
+        quantity = args["quantity"].as<int>();
+    }
+    
+    if (listName.length() == 0 || item.length() == 0 || quantity <= 0) {
+        return "I need a list name, item, and a quantity to add something. Can you try that again?";
+    }
+    int total = todoStore.add(listName.c_str(), item.c_str(), quantity);
+    listName = todoStore.listName(todoStore.findList(listName.c_str()));
+    item = todoStore.itemName(listName.c_str(), item.c_str());
+    saveTodoLists();
+    publishTodoItem(listName, item, total); // --- SYNC TO UI ---
+    
+    return "Got it! I've added " + String(quantity) + " '" + item + "' to your " + listName + " list. You now have " + String(total) + ".";
+}
+
+String toolRemoveTodoItem(JsonObject args) {
+    AppDataGuard guard;
+    String listName = args["list_name"].as<String>();
+    listName.toLowerCase();
+    String item = args["item"].as<String>();
+    item.toLowerCase();
+
+    String shownItem = todoStore.itemName(listName.c_str(), item.c_str());
+    if (shownItem.length() == 0) {
+        return "Hmm, I can't find '" + item + "' on your " + listName + " list.";
+    }
+    String shownList = todoStore.listName(todoStore.findList(listName.c_str()));
+    int quantityToRemove = args["quantity"] | 0;
+    int left = todoStore.remove(listName.c_str(), item.c_str(), quantityToRemove);
+    saveTodoLists();
+    publishTodoItem(shownList, shownItem, left); // --- SYNC TO UI ---
+    if (quantityToRemove <= 0) {
+        return "Perfect! I've cleared all '" + shownItem + "' from your " + shownList + " list.";
+    }
+    if (left <= 0) {
+        return "All done! I've crossed off all '" + shownItem + "' from your " + shownList + " list.";
+    }
+    return "Got it! I removed " + String(quantityToRemove) + " '" + shownItem + "'. You still have " + String(left) + " left.";
+}
+
+String toolListTodoItems(JsonObject args) {
+    AppDataGuard guard;
+    String toolResult = "";
+    if (args.containsKey("list_name")) {
+        String listName = args["list_name"].as<String>();
+        listName.toLowerCase();
+
+        int list = todoStore.findList(listName.c_str());
+        if (list < 0 || todoStore.itemCount(list) == 0) {
+            return "Your " + listName + " list is empty.";
+        }
+        toolResult = "Here's what's on your " + String(todoStore.listName(list)) + " list: ";
+        todoStore.forEachItem(list, [&](const char* item_name, int quantity) {
+            toolResult += item_name;
+            if (quantity > 1) {
+                toolResult += " (" + String(quantity) + ")";
+            }
+            toolResult += ", ";
+        });
+        return toolResult;
+    }
+    int lists = todoStore.listCount();
+    if (lists == 0) {
+        return "You haven't created any to-do lists yet.";
+    }
+    toolResult = "You have " + String(lists) + " list" + (lists > 1 ? "s" : "") + ": ";
+    todoStore.forEachList([&](int list, const char* listName) {
+        int items = todoStore.itemCount(list);
+        toolResult += String(listName) + " (with " + String(items) + " item" + (items != 1 ? "s" : "") + "), ";
+    });
+    return toolResult;
+}
+
+String toolClearTodoList(JsonObject args) {
+    AppDataGuard guard;
+    String listName = args["list_name"].as<String>();
+    listName.toLowerCase();
+
+    int list = todoStore.findList(listName.c_str());
+    if (list < 0) {
+        return "Sorry, I couldn't find a list named '" + listName + "' to clear.";
+    }
+    listName = todoStore.listName(list);
+    todoStore.removeList(listName.c_str());
+    saveTodoLists();
+    publishTodoListRemoved(listName); // --- SYNC TO UI ---
+    return "I've cleared your entire " + listName + " list.";
+}
+
+//                                                                side    network speak
+ToolDef toolRegistry[] = {                                     // effects bound   directly
+    {"get_weather",        TOOL_SCHEMA_GET_WEATHER,        toolGetWeather,        false,  true,   false},
+    {"get_network_info",   TOOL_SCHEMA_GET_NETWORK_INFO,   toolGetNetworkInfo,    true,   false,  false},
+    {"google_search",      TOOL_SCHEMA_GOOGLE_SEARCH,      toolGoogleSearch,      false,  true,   false},
+    {"set_alarm_relative", TOOL_SCHEMA_SET_ALARM_RELATIVE, toolSetAlarmRelative,  true,   false,  true},
+    {"set_alarm_absolute", TOOL_SCHEMA_SET_ALARM_ABSOLUTE, toolSetAlarmAbsolute,  true,   false,  true},
+    {"get_alarm_status",   TOOL_SCHEMA_GET_ALARM_STATUS,   toolGetAlarmStatus,    false,  false,  false},
+    {"cancel_alarm",       TOOL_SCHEMA_CANCEL_ALARM,       toolCancelAlarm,       true,   false,  true},
+    {"snooze_alarm",       TOOL_SCHEMA_SNOOZE_ALARM,       toolSnoozeAlarm,       true,   false,  true},
+    {"add_todo_item",      TOOL_SCHEMA_ADD_TODO_ITEM,      toolAddTodoItem,       true,   false,  false},
+    {"remove_todo_item",   TOOL_SCHEMA_REMOVE_TODO_ITEM,   toolRemoveTodoItem,    true,   false,  false},
+    {"list_todo_items",    TOOL_SCHEMA_LIST_TODO_ITEMS,    toolListTodoItems,     false,  false,  false},
+    {"clear_todo_list",    TOOL_SCHEMA_CLEAR_TODO_LIST,    toolClearTodoList,     true,   false,  false},
+};
+const int TOOL_COUNT = sizeof(toolRegistry) / sizeof(toolRegistry[0]);
+LatencyHistogram toolLatency[TOOL_COUNT];
+
+// Every tool runs through here, so each handler's latency lands in its histogram
+String runTool(const ToolDef* tool, JsonObject args) {
+    SpanTimer span(toolLatency[tool - toolRegistry]);
+    return tool->handler(args);
+}
+
+// Open-addressed hash index into toolRegistry (power of two, at least 2x the tool count)
+#define TOOL_INDEX_SIZE 32
+int8_t toolIndex[TOOL_INDEX_SIZE];
+
+uint32_t fnv1aHash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) { h ^= (uint8_t)*s++; h *= 16777619u; }
+    return h;
+}
+
+void initToolRegistry() {
+    memset(toolIndex, -1, sizeof(toolIndex));
+    for (int i = 0; i < TOOL_COUNT; i++) {
+        toolRegistry[i].hash = fnv1aHash(toolRegistry[i].name);
+        uint32_t slot = toolRegistry[i].hash & (TOOL_INDEX_SIZE - 1);
+        while (toolIndex[slot] >= 0) slot = (slot + 1) & (TOOL_INDEX_SIZE - 1);
+        toolIndex[slot] = i;
+    }
+}
+
+const ToolDef* findTool(const String& name) {
+    uint32_t h = fnv1aHash(name.c_str());
+    for (uint32_t slot = h & (TOOL_INDEX_SIZE - 1); toolIndex[slot] >= 0; slot = (slot + 1) & (TOOL_INDEX_SIZE - 1)) {
+        const ToolDef& tool = toolRegistry[toolIndex[slot]];
+        if (tool.hash == h && name == tool.name) return &tool;
+    }
+    return nullptr;
+}
+
+// Writes the request's "tools" array straight from the registry's flash fragments
+void writeToolSchemas(Print& out) {
+    out.print('[');
+    for (int i = 0; i < TOOL_COUNT; i++) {
+        if (i > 0) out.print(',');
+        out.print(FPSTR(toolRegistry[i].schema));
+    }
+    out.print(']');
+}
+
+// One model-issued tool call on its way through the dispatcher
+struct ToolJob {
+    const GptToolCall* call;
+    const ToolDef* tool;
+    JsonDocument args;
+    String result;
+    SemaphoreHandle_t done = nullptr;
+};
+
+void toolWorkerTask(void* param) {
+    ToolJob* job = (ToolJob*)param;
+    job->result = runTool(job->tool, job->args.as<JsonObject>());
+    xSemaphoreGive(job->done);
+    vTaskDelete(NULL);
+}
+
+// Runs every tool call of a model turn and returns the results in call order.
+// Sets allBypass if every tool produced final text (no summary call needed).
+std::vector<String> runToolCalls(const std::vector<GptToolCall>& calls, bool& allBypass) {
+    std::vector<ToolJob> jobs(calls.size());
+    allBypass = true;
+
+    // Start the independent network-bound calls first so they overlap with everything else
+    for (size_t i = 0; i < calls.size(); i++) {
+        ToolJob& job = jobs[i];
+        job.call = &calls[i];
+        job.tool = findTool(calls[i].toolToCall);
+        if (!job.tool) {
+            job.result = "Unknown tool: " + calls[i].toolToCall;
+            continue;
+        }
+        if (!job.tool->speakResultDirectly) allBypass = false;
+        deserializeJson(job.args, calls[i].toolArguments);
+        if (strcmp(job.tool->name, "get_weather") == 0) isWeatherTask = true;
+
+        if (job.tool->networkBound && !job.tool->hasSideEffects) {
+            job.done = xSemaphoreCreateBinary();
+            if (xTaskCreatePinnedToCore(toolWorkerTask, "ToolWorker", 12288, &job, 1, NULL, 0) != pdPASS) {
+                vSemaphoreDelete(job.done);
+                job.done = nullptr;  // Fall back to running it inline below
+            }
+        }
+    }
+
+    // Main-task tools run in call order while the workers are busy
+    for (ToolJob& job : jobs) {
+        if (job.tool && job.done == nullptr) {
+            job.result = runTool(job.tool, job.args.as<JsonObject>());
+        }
+    }
+
+    // Collect worker results (the web and display tasks keep running meanwhile)
+    for (ToolJob& job : jobs) {
+        if (job.done == nullptr) continue;
+        xSemaphoreTake(job.done, portMAX_DELAY);
+        vSemaphoreDelete(job.done);
+    }
+    isWeatherTask = false;
+    saveToolCache();
+
+    std::vector<String> results;
+    results.reserve(jobs.size());
+    for (ToolJob& job : jobs) results.push_back(job.result);
+    return results;
 }
 
 // ========== AUDIO PROCESSING PIPELINE ==========
 // Recording -> Transcription -> GPT processing -> Response
 
+// Answers a locally matched command with the same handlers the model's tool calls use.
+// Returns the reply to speak, or "" if the intent is not a command.
+String runLocalIntent(const IntentMatch& intent) {
+    JsonDocument args;
+    const char* toolName = nullptr;
+    switch (intent.intent) {
+        case INTENT_TIME_DATE: {
+            isTimeDateTask = true;
+            String reply = handleTimeDateRequest();
+            isTimeDateTask = false;
+            return reply;
+        }
+        case INTENT_SET_TIMER:
+            toolName = "set_alarm_relative";
+            args["delay_seconds"] = intent.seconds;
+            break;
+        case INTENT_SET_ALARM:
+            toolName = "set_alarm_absolute";
+            args["hour"] = intent.hour;
+            args["minute"] = intent.minute;
+            args["period"] = intent.pm ? "PM" : "AM";
+            break;
+        case INTENT_CANCEL_ALARM:
+            toolName = "cancel_alarm";
+            break;
+        case INTENT_ALARM_STATUS:
+            toolName = "get_alarm_status";
+            break;
+        case INTENT_ADD_ITEM:
+        case INTENT_REMOVE_ITEM:
+            toolName = intent.intent == INTENT_ADD_ITEM ? "add_todo_item" : "remove_todo_item";
+            args["list_name"] = intent.list;
+            args["item"] = intent.item;
+            if (intent.quantity > 0) args["quantity"] = intent.quantity;
+            break;
+        case INTENT_LIST_ITEMS:
+        case INTENT_CLEAR_LIST:
+            toolName = intent.intent == INTENT_LIST_ITEMS ? "list_todo_items" : "clear_todo_list";
+            args["list_name"] = intent.list;
+            break;
+        default:
+            return "";
+    }
+    const ToolDef* tool = findTool(toolName);
+    if (!tool) return "";
+    String reply = runTool(tool, args.as<JsonObject>());
+    if (reply.endsWith(", ")) reply.remove(reply.length() - 2);   // Lists are joined with ", "
+    return reply;
+}
+
+void traceHeap(TurnTrace& trace) {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (trace.heapLow == 0 || freeHeap < trace.heapLow) trace.heapLow = freeHeap;
+}
+
+void finishTurnTrace(TurnTrace& trace, unsigned long transcriptAt, bool local) {
+    traceHeap(trace);
+    trace.seq = ++turnSeq;
+    trace.local = local;
+    trace.replyMs = millis() - transcriptAt;
+    trace.totalMs = millis() - recordingReleaseTime;
+    trace.firstAudioMs = lastTimeToFirstAudioMs;
+    Serial.printf("TURN seq=%u path=%s transcribe_ms=%u reply_ms=%u first_audio_ms=%u total_ms=%u upload_bytes=%u heap_low=%u\n",
+                  trace.seq, local ? "local" : "model", trace.transcribeMs, trace.replyMs, trace.firstAudioMs,
+                  trace.totalMs, trace.uploadBytes, trace.heapLow);
+    lastTurn = trace;
+}
+
+void noteTurnLatency(TurnLatency& path) {
+    if (lastTimeToFirstAudioMs == 0) return;   // Nothing was played (interrupted, or no speech)
+    path.turns++;
+    path.firstAudioMsTotal += lastTimeToFirstAudioMs;
+}
+
 void processAudio(int bytes_recorded, int samples_recorded) {
-    currentAIState = AI_THINKING;
-    broadcastState(AI_THINKING); // --- SYNC TO UI ---
-    updateAnimation();
+    setAIState(AI_THINKING);
     if (samples_recorded > 1000) {
-        String transcribedText = transcribeWithWhisper(bytes_recorded);
+        bool streamed = whisperUpload.active;
+        String transcribedText = streamed ? finishWhisperStream(samples_recorded)
+                                          : transcribeWithWhisper(bytes_recorded);
+        lastTranscribeLatencyMs = millis() - recordingReleaseTime;
+        stageLatency[STAGE_TRANSCRIBE].record(lastTranscribeLatencyMs);
+        Serial.printf("⏱️ Release-to-transcript: %lu ms (%s upload)\n", lastTranscribeLatencyMs, streamed ? "streamed" : "buffered");
         
         if (transcribedText.length() == 0 || transcribedText.equalsIgnoreCase("you")) {
              Serial.println("❌ Transcription was empty or garbled. Skipping.");
              currentState = S_IDLE;
-             currentAIState = AI_IDLE;
-        broadcastState(AI_IDLE); // --- SYNC TO UI ---
+             setAIState(AI_IDLE);
              return; 
         }
 
         Serial.print("🗣️ You said: "); Serial.println(transcribedText);
         broadcastTranscription(transcribedText);
-        String lowerCaseText = transcribedText;
-        lowerCaseText.toLowerCase();
+        TurnTrace trace;
+        trace.transcribeMs = lastTranscribeLatencyMs;
+        trace.uploadBytes = whisperUpload.bytesSent;
+        traceHeap(trace);
+        unsigned long transcriptAt = millis();
+        IntentMatch intent;
+        intentMatcher.match(transcribedText, intent);
+        lastTimeToFirstAudioMs = 0;
         
         // Check for vision requests (describe what I see)
-        if (lowerCaseText.indexOf("what do you see") != -1 || lowerCaseText.indexOf("describe") != -1) {
+        if (intent.intent == INTENT_VISION) {
             Serial.println("Vision request detected");
             handleVisionRequest(); 
             currentState = S_IDLE;
-            currentAIState = AI_IDLE;
-            broadcastState(AI_IDLE); // --- SYNC TO UI ---
+            setAIState(AI_IDLE);
             return; 
         }
         
-        // Check for story requests - try Wikipedia > OpenAI (Gutendex commented out)
-        if (lowerCaseText.indexOf("tell me") != -1 && lowerCaseText.indexOf("story") != -1) {
-            Serial.println("Story request detected - trying Wikipedia then OpenAI");
-            currentAIState = AI_THINKING;
-            broadcastState(AI_THINKING);
-            
-            String storyQuery = transcribedText;
-            int storyIdx = lowerCaseText.indexOf("story");
-            if (storyIdx != -1 && storyIdx + 5 < storyQuery.length()) {
-                storyQuery = storyQuery.substring(storyIdx + 5);
-                storyQuery.trim();
-                if (storyQuery.startsWith("of ")) {
-                    storyQuery = storyQuery.substring(3);
-                    storyQuery.trim();
-                }
-                if (storyQuery.startsWith("about ")) {
-                    storyQuery = storyQuery.substring(6);
-                    storyQuery.trim();
-                }
-            }
+        // Story requests ("tell me ... story")
+        if (intent.intent == INTENT_STORY) {
+            Serial.println("Story request detected");
+            setAIState(AI_THINKING);
             
             // Story functionality removed
             Serial.println("Story requests disabled");
@@ -1492,8 +2603,7 @@ void processAudio(int bytes_recorded, int samples_recorded) {
             addToHistory("assistant", message);
             
             currentState = S_IDLE;
-            currentAIState = AI_IDLE;
-            broadcastState(AI_IDLE);
+            setAIState(AI_IDLE);
             return;
         }
 
@@ -1510,282 +2620,71 @@ void processAudio(int bytes_recorded, int samples_recorded) {
         }
         addToHistory("user", promptForAI);
 
-        // Check if user is asking for introduction/greeting
-        String lowerText = transcribedText;
-        lowerText.toLowerCase();
-        bool isIntroRequest = (lowerText.indexOf("who are you") != -1 || 
-                               lowerText.indexOf("what is your name") != -1 ||
-                               lowerText.indexOf("introduce yourself") != -1 ||
-                               lowerText.indexOf("tell me about yourself") != -1 ||
-                               lowerText.indexOf("hello") != -1);
-        
         // If asking for introduction, use stored intro instead of OpenAI
-        if (isIntroRequest) {
+        if (intent.intent == INTENT_INTRODUCE) {
             Serial.println("Introduction request detected - using stored introduction");
             speakDefaultIntroduction();
             currentState = S_IDLE;
-            currentAIState = AI_IDLE;
-            broadcastState(AI_IDLE); // --- SYNC TO UI ---
+            setAIState(AI_IDLE);
             return;
         }
 
-        GptResponse response1 = chatWithGpt();
+        // Deterministic commands: answer locally, no chat round trip
+        if (intent.intent != INTENT_NONE) {
+            Serial.printf("⚡ Local intent: %s\n", INTENT_NAMES[intent.intent]);
+            firstAudioPending = true;
+            speechRequestStart = millis();
+            String reply = runLocalIntent(intent);
+            if (reply.length() > 0) {
+                speakText(reply);
+                addToHistory("assistant", reply);
+                noteTurnLatency(localTurns);
+                finishTurnTrace(trace, transcriptAt, true);
+                currentState = S_IDLE;
+                setAIState(AI_IDLE);
+                return;
+            }
+            firstAudioPending = false;
+        }
+
+        GptResponse response1 = requestChatTurn();
+        traceHeap(trace);
 
         // Process tool calls from ChatGPT response
         if (!response1.toolCalls.empty()) { 
-            addToHistory("assistant", response1.rawAssistantMessage);
+            bool kept = addToHistory("assistant", response1.rawAssistantMessage);
             
             bool allBypass = true;
             String combinedToolResults = ""; 
+            std::vector<String> toolResults = runToolCalls(response1.toolCalls, allBypass);
 
-            // Execute each tool call
-            for (const auto& call : response1.toolCalls) {
-                String toolResult = "";
-                bool bypassAiCall2 = false; 
-
-                // Tool execution dispatcher
-                if (call.toolToCall == "get_weather") {
-                    isWeatherTask = true; 
-                    updateAnimation();
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    String city = argsDoc["city"].as<String>();
-                    toolResult = handleWeatherRequest(city);
-                    isWeatherTask = false;
-                    allBypass = false; 
-                } else if (call.toolToCall == "get_network_info") {
-                    // Provide device's local network information
-                    String ssid = WiFi.SSID();
-                    String ipAddr = WiFi.localIP().toString();
-                    long rssi = WiFi.RSSI();
-                    toolResult = "Your WiFi network is '" + ssid + "'. Your device's IP address is " + ipAddr + ". Signal strength is " + String(rssi) + " dBm.";
-                    showNetworkInfo = true;
-                    networkInfoStartTime = millis();
-                    allBypass = false;
-                } else if (call.toolToCall == "google_search") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    String query = argsDoc["query"].as<String>();
-                    toolResult = handleGoogleSearch(query);
-                    allBypass = false; 
-                } else if (call.toolToCall == "set_alarm_relative") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    int delay_seconds = argsDoc["delay_seconds"].as<int>();
-                    if (delay_seconds > 0) {
-                        alarmTriggerTime = millis() + (unsigned long)delay_seconds * 1000UL;
-                        alarmUpdateCounter++;
-                        broadcastAlarm(alarmTriggerTime, true); // --- SYNC TO UI ---
-                        currentAIState = AI_IDLE; 
-                        int minutes = delay_seconds / 60;
-                        int seconds = delay_seconds % 60;
-                        if (minutes > 0) {
-                            toolResult = "Got it! I'll wake you in " + String(minutes) + " minute" + (minutes > 1 ? "s" : "") + ".";
-                        } else {
-                            toolResult = "All set! Your alarm is ready in " + String(seconds) + " seconds.";
-                        }
-                    } else {
-                        toolResult = "That time doesn't look right. Could you try again?";
-                    }
-                    bypassAiCall2 = true;
-                } else if (call.toolToCall == "set_alarm_absolute") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    int targetHour = argsDoc["hour"].as<int>();
-                    int targetMinute = argsDoc["minute"].as<int>();
-                    String period = argsDoc["period"].as<String>();
-                    period.toUpperCase();
-                    struct tm timeinfo_alarm; 
-                    if (!getLocalTime(&timeinfo_alarm)) {
-                        toolResult = "I'm having trouble reading the time right now. Can you try setting the alarm again?";
-                    } else {
-                        int targetHour24 = targetHour;
-                        if (period == "PM" && targetHour != 12) { targetHour24 += 12; }
-                        if (period == "AM" && targetHour == 12) { targetHour24 = 0; }
-                        long targetTotalSeconds = targetHour24 * 3600 + targetMinute * 60;
-                        long currentTotalSeconds = timeinfo_alarm.tm_hour * 3600 + timeinfo_alarm.tm_min * 60 + timeinfo_alarm.tm_sec;
-                        long delay_seconds = targetTotalSeconds - currentTotalSeconds;
-                        if (delay_seconds < 10) { 
-                            delay_seconds += 86400; 
-                        }
-                        alarmTriggerTime = millis() + (unsigned long)delay_seconds * 1000UL;
-                        alarmUpdateCounter++;  // Increment counter for UI update
-                        currentAIState = AI_IDLE;
-                        String minuteStr = (targetMinute < 10) ? "0" + String(targetMinute) : String(targetMinute);
-                        toolResult = "Perfect! I'll alarm you at " + String(targetHour) + ":" + minuteStr + " " + period + ".";
-                    }
-                    bypassAiCall2 = true; 
-                } else if (call.toolToCall == "get_alarm_status") {
-                    if (currentAIState == AI_ALARMING) {
-                        toolResult = "Your alarm is going off right now!";
-                    } else if (alarmTriggerTime != 0) {
-                        unsigned long ms_remaining = alarmTriggerTime - millis();
-                        int seconds_remaining = ms_remaining / 1000UL;
-                        int minutes = seconds_remaining / 60;
-                        int seconds = seconds_remaining % 60;
-                        toolResult = "You've got an alarm coming up in about " + String(minutes) + " minute" + (minutes > 1 ? "s" : "") + " and " + String(seconds) + " seconds.";
-                    } else {
-                        toolResult = "You don't have any alarms set right now.";
-                    }
-                    allBypass = false;
-                } else if (call.toolToCall == "cancel_alarm") {
-                    if (alarmTriggerTime != 0) {
-                        alarmTriggerTime = 0; 
-                        toolResult = "Done! I've cancelled your alarm.";
-                    } else {
-                        toolResult = "No alarm to cancel right now.";
-                    }
-                    bypassAiCall2 = true; 
-                
-                // --- TODO HANDLERS ---
-                } else if (call.toolToCall == "add_todo_item") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    
-                    String listName = argsDoc["list_name"].as<String>();
-                    listName.toLowerCase();
-                    String item = argsDoc["item"].as<String>();
-                    item.toLowerCase(); 
-                    
-                    int quantity = 1; 
-                    if (argsDoc.containsKey("quantity")) {
-                        quantity = argsDoc["quantity"].as<int>();
-                    }
-                    
-                    if (listName.length() > 0 && item.length() > 0 && quantity > 0) {
-                        int current_quantity = todoLists[listName][item];
-                        todoLists[listName][item] = current_quantity + quantity;
-                        saveTodoLists();
-                        broadcastTodoLists(); // --- SYNC TO UI ---
-                        
-                        int total = todoLists[listName][item];
-                        toolResult = "Got it! I've added " + String(quantity) + " '" + item + "' to your " + listName + " list. You now have " + String(total) + ".";
-                    } else {
-                        toolResult = "I need a list name, item, and a quantity to add something. Can you try that again?";
-                    }
-                    allBypass = false; 
-
-                } else if (call.toolToCall == "remove_todo_item") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    
-                    String listName = argsDoc["list_name"].as<String>();
-                    listName.toLowerCase();
-                    String item = argsDoc["item"].as<String>();
-                    item.toLowerCase();
-
-                    if (todoLists.find(listName) == todoLists.end() || todoLists[listName].find(item) == todoLists[listName].end()) {
-                        toolResult = "Hmm, I can't find '" + item + "' on your " + listName + " list.";
-                    } else {
-                        if (argsDoc.containsKey("quantity")) {
-                            int quantityToRemove = argsDoc["quantity"].as<int>();
-                            int current_quantity = todoLists[listName][item];
-                            todoLists[listName][item] = current_quantity - quantityToRemove;
-
-                            if (todoLists[listName][item] <= 0) {
-                                todoLists[listName].erase(item);
-                                saveTodoLists();
-                                broadcastTodoLists(); // --- SYNC TO UI ---
-                                toolResult = "All done! I've crossed off all '" + item + "' from your " + listName + " list.";
-                            } else {
-                                saveTodoLists();
-                                broadcastTodoLists(); // --- SYNC TO UI ---
-                                toolResult = "Got it! I removed " + String(quantityToRemove) + " '" + item + "'. You still have " + String(todoLists[listName][item]) + " left.";
-                            }
-                        } else {
-                            todoLists[listName].erase(item);
-                            saveTodoLists();
-                            broadcastTodoLists(); // --- SYNC TO UI ---
-                            toolResult = "Perfect! I've cleared all '" + item + "' from your " + listName + " list.";
-                        }
-                    }
-                    allBypass = false; 
-
-                } else if (call.toolToCall == "list_todo_items") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    
-                    if (argsDoc.containsKey("list_name")) {
-                        String listName = argsDoc["list_name"].as<String>();
-                        listName.toLowerCase();
-
-                        if (todoLists.find(listName) == todoLists.end() || todoLists[listName].empty()) {
-                            toolResult = "Your " + listName + " list is empty.";
-                        } else {
-                            std::map<String, int> &list = todoLists[listName];
-                            toolResult = "Here's what's on your " + listName + " list: ";
-                            for (auto const& [item_name, quantity] : list) {
-                                toolResult += item_name;
-                                if (quantity > 1) {
-                                    toolResult += " (" + String(quantity) + ")";
-                                }
-                                toolResult += ", ";
-                            }
-                        }
-                    } else {
-                        if (todoLists.empty()) {
-                            toolResult = "You haven't created any to-do lists yet.";
-                        } else {
-                            toolResult = "You have " + String(todoLists.size()) + " list" + (todoLists.size() > 1 ? "s" : "") + ": ";
-                            for (auto const& [listName, innerMap] : todoLists) {
-                                toolResult += listName + " (with " + String(innerMap.size()) + " item" + (innerMap.size() > 1 ? "s" : "") + "), ";
-                            }
-                        }
-                    }
-                    
-                    // --- THIS IS THE FIX ---
-                    allBypass = false; 
-                    // --- END FIX ---
-
-                } else if (call.toolToCall == "clear_todo_list") {
-                    JsonDocument argsDoc;
-                    deserializeJson(argsDoc, call.toolArguments);
-                    
-                    String listName = argsDoc["list_name"].as<String>();
-                    listName.toLowerCase();
-
-                    if (todoLists.find(listName) == todoLists.end()) {
-                        toolResult = "Sorry, I couldn't find a list named '" + listName + "' to clear.";
-                    } else {
-                        todoLists.erase(listName);
-                        broadcastTodoLists(); // --- SYNC TO UI ---
-                        toolResult = "I've cleared your entire " + listName + " list.";
-                    }
-                    allBypass = false;
-                
-                } else {
-                    toolResult = "Unknown tool: " + call.toolToCall;
-                    bypassAiCall2 = true;
-                }
-                // --- End of Tool execution block ---
-
-                Serial.println("Tool result: " + toolResult);
-                addToHistory("tool", toolResult, call.toolCallId); 
-                
-                if (bypassAiCall2) {
-                    combinedToolResults += toolResult + " ";
-                }
-                if (!bypassAiCall2) {
-                    allBypass = false; 
-                }
-            } // --- END of loop through tool calls ---
+            for (size_t i = 0; i < toolResults.size(); i++) {
+                Serial.println("Tool result: " + toolResults[i]);
+                kept = addToHistory("tool", toolResults[i], response1.toolCalls[i].toolCallId) && kept; 
+                combinedToolResults += toolResults[i] + " ";
+            }
 
-            
             // --- Decide what to do after all tools have run ---
-            if (allBypass) {
+            if (!kept && !allBypass) {
+                // The exchange was too large for the history, so the model would not see the results
+                String errorMsg = PHRASE_TOOL_FAILED;
+                speakText(errorMsg);
+                addToHistory("assistant", errorMsg);
+            } else if (allBypass) {
                 Serial.println("Bypassing AI Call 2. Speaking combined tool results.");
                 speakText(combinedToolResults); 
             } else {
                 Serial.println("Sending tool results to AI for summary...");
-                GptResponse response2 = chatWithGpt();
+                GptResponse response2 = requestChatTurn();
+                traceHeap(trace);
                 if (response2.textToSpeak.length() > 0) {
                     String cleanedText = response2.textToSpeak;
                     cleanedText.replace("**", ""); 
                     cleanedText.replace("*", "");  
-                    speakText(cleanedText); 
+                    if (!response2.alreadySpoken) speakText(cleanedText); 
                     addToHistory("assistant", cleanedText);
                 } else {
-                    String errorMsg = "Oops, looks like I ran into a little hiccup while getting that information for you. Let me try again!";
+                    String errorMsg = PHRASE_TOOL_FAILED;
                     speakText(errorMsg);
                     addToHistory("assistant", errorMsg); 
                 }
@@ -1802,23 +2701,24 @@ void processAudio(int bytes_recorded, int samples_recorded) {
             if (lowerResponse.indexOf("ip address") != -1 || lowerResponse.indexOf("ip:") != -1 || 
                 lowerResponse.indexOf("wifi") != -1 || lowerResponse.indexOf("wi fi") != -1 || 
                 lowerResponse.indexOf("network") != -1 || lowerResponse.indexOf("ssid") != -1) {
-                showNetworkInfo = true;
-                networkInfoStartTime = millis();
+                displayShowNetworkInfo();
             }
             
-            speakText(cleanedText); 
+            if (!response1.alreadySpoken) speakText(cleanedText); 
             addToHistory("assistant", cleanedText);
         } else {
-            String errorMsg = "Sorry, I didn't quite catch that. Could you say it again?";
+            String errorMsg = PHRASE_NOT_UNDERSTOOD;
             speakText(errorMsg);
             addToHistory("assistant", errorMsg); 
         }
+        noteTurnLatency(modelTurns);
+        finishTurnTrace(trace, transcriptAt, false);
     } else {
-        Serial.println("❌ Recording too short.");
+        abortWhisperStream();
+        Serial.println("❌ Recording too short or no speech detected.");
     }
     currentState = S_IDLE;
-    currentAIState = AI_IDLE;
-    broadcastState(AI_IDLE); // --- SYNC TO UI ---
+    setAIState(AI_IDLE);
 }
 
 // ========== HTTP REQUEST HANDLERS ==========
@@ -1826,7 +2726,65 @@ void processAudio(int bytes_recorded, int samples_recorded) {
 
 void handleStateAPI() {
   String state = stateToString();
-  String json = "{\"state\":\"" + state + "\",\"historyCount\":" + String(transactionHistory.size()) + ",\"imageCount\":" + String(imageCaptureCounter) + ",\"alarmCount\":" + String(alarmUpdateCounter) + "}";
+  String json = "{\"state\":\"" + state + "\",\"historyCount\":" + String(chatRing.size()) + ",\"imageCount\":" + String(imageCaptureCounter) + ",\"alarmCount\":" + String(alarmUpdateCounter) + ",\"syncSeq\":" + String(syncSeq) + ",\"wsMessages\":" + String(wsMessagesSent) + ",\"wsBytes\":" + String(wsBytesSent) + "}";
+  server.send(200, "application/json", json);
+}
+
+void handleAudioStatsAPI() {
+  JsonDocument doc;
+  doc["captureTask"] = micCaptureTaskHandle != NULL;
+  doc["ringCapacity"] = micRing.capacity();
+  doc["peakFill"] = micRing.peakFill();
+  doc["overruns"] = micRing.overruns();
+  doc["droppedSamples"] = micRing.droppedSamples();
+  doc["underruns"] = micRing.underruns();
+  doc["chunksRead"] = micChunksRead;
+  JsonObject tts = doc.createNestedObject("ttsCache");
+  xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+  const TtsCacheStats& stats = ttsCache.stats();
+  tts["clips"] = ttsCache.count();
+  tts["usedBytes"] = ttsCache.usedBytes();
+  tts["budgetBytes"] = ttsCache.budgetBytes();
+  tts["hits"] = stats.hits;
+  tts["misses"] = stats.misses;
+  tts["hitRate"] = (stats.hits + stats.misses) ? (float)stats.hits / (stats.hits + stats.misses) : 0.0f;
+  tts["bytesSaved"] = stats.bytesSaved;
+  tts["fetched"] = stats.inserts;
+  tts["fetchFailures"] = ttsFetchFailures;
+  tts["evictions"] = stats.evictions;
+  xSemaphoreGive(ttsCacheLock);
+  String json;
+  serializeJson(doc, json);
+  server.send(200, "application/json", json);
+}
+
+void handleConnectionStatsAPI() {
+  JsonDocument doc;
+  JsonArray hosts = doc.createNestedArray("hosts");
+  for (int i = 0; i < apiPool.hostCount(); i++) {
+    const ApiHostSession& s = apiPool.session(i);
+    JsonObject h = hosts.createNestedObject();
+    h["host"] = s.host;
+    h["requests"] = s.requests;
+    h["handshakes"] = s.handshakes;
+    h["reuses"] = s.reuses;
+    h["reconnects"] = s.reconnects;
+    h["failures"] = s.failures;
+    h["evictions"] = s.evictions;
+    h["last_handshake_ms"] = s.lastHandshakeMs;
+  }
+  ResultCacheStats cache = toolCache.stats();
+  JsonObject tc = doc.createNestedObject("tool_cache");
+  tc["entries"] = toolCache.size();
+  tc["hits"] = cache.hits;
+  tc["misses"] = cache.misses;
+  tc["coalesced"] = cache.coalesced;
+  tc["stale_served"] = cache.staleServed;
+  tc["fetch_failures"] = cache.fetchFailures;
+  tc["avg_fetch_ms"] = cache.misses ? cache.fetchMsTotal / cache.misses : 0;
+  tc["max_fetch_ms"] = cache.fetchMsMax;
+  String json;
+  serializeJson(doc, json);
   server.send(200, "application/json", json);
 }
 
@@ -1843,19 +2801,64 @@ String getContentType(const String& filename) {
   return "application/octet-stream";
 }
 
+const WebAsset* findWebAsset(const String& path) {
+  for (int i = 0; i < WEB_ASSET_COUNT; i++) {
+    if (path == WEB_ASSETS[i].path) return &WEB_ASSETS[i];
+  }
+  return nullptr;
+}
+
+// If-None-Match may hold a list of tags, weak ones (W/"...") included, or "*"
+bool etagMatches(const String& ifNoneMatch, const char* etag) {
+  if (ifNoneMatch.length() == 0) return false;
+  return ifNoneMatch.indexOf(etag) >= 0 || ifNoneMatch.indexOf('*') >= 0;
+}
+
+// Sends a dashboard asset as stored: gzip, which every browser that runs the dashboard
+// accepts. Assets linked with their ?v= hash are cached for good; the page itself is
+// revalidated on each load and answered with a bodiless 304 while its ETag holds.
+void serveWebAsset(const WebAsset& asset, bool pageLoad) {
+  unsigned long start = micros();
+  bool pinned = asset.versioned && server.arg("v") == asset.version;
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", pinned ? WEB_ASSET_MAX_AGE : "no-cache");
+  server.sendHeader("Vary", "Accept-Encoding");
+  uint32_t body = 0;
+  if (etagMatches(server.header("If-None-Match"), asset.etag)) {
+    server.send(304);
+    webAssetStats.notModified++;
+  } else {
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, asset.contentType, (const char*)asset.data, asset.length);
+    body = asset.length;
+    webAssetStats.served++;
+  }
+  uint32_t us = micros() - start;
+  webAssetStats.bodyBytes += body;
+  webAssetStats.serveUsTotal += us;
+  if (us > webAssetStats.serveUsMax) webAssetStats.serveUsMax = us;
+  if (pageLoad) {
+    webAssetStats.pageRequests = 0;
+    webAssetStats.pageBodyBytes = 0;
+    webAssetStats.pageServeUs = 0;
+  }
+  webAssetStats.pageRequests++;
+  webAssetStats.pageBodyBytes += body;
+  webAssetStats.pageServeUs += us;
+}
+
 void handleFile() {
-  // Serve static files from embedded data
   String path = server.uri();
   if (path == "/") path = "/index.html";
   if (!path.startsWith("/")) path = "/" + path;
 
-  // Serve embedded HTML directly
-  if (path == "/index.html") {
-    server.send_P(200, PSTR("text/html"), INDEX_HTML);
+  const WebAsset* asset = findWebAsset(path);
+  if (asset) {
+    serveWebAsset(*asset, path == "/index.html");
     return;
   }
 
-  // Fallback to SPIFFS for other files (CSS, JS, images)
+  // Fallback to SPIFFS for other files (images, templates)
   if (SPIFFS.exists(path)) {
     File f = SPIFFS.open(path, "r");
     if (!f) {
@@ -1886,142 +2889,85 @@ void handleTasksData() {
 
   // Minimal fallback (keeps response small and avoids inlining the full page)
   String html = "";
-  if (alarmTriggerTime != 0) {
-    unsigned long ms_remaining = (alarmTriggerTime > millis()) ? (alarmTriggerTime - millis()) : 0;
-    if (ms_remaining > 0) {
-      unsigned long seconds = ms_remaining / 1000;
-      unsigned long minutes = seconds / 60;
-      unsigned long secs = seconds % 60;
-      html += "<div class='alarm-active'>";
-      html += "<p>Alarm Active</p>";
-      html += "<p>";
-      if (minutes > 0) html += String(minutes) + " min ";
-      html += String(secs) + " sec";
-      html += "</p></div>";
-    } else {
-      html += "<div class='alarm-inactive'><p>No active alarm</p></div>";
-    }
+  uint32_t seconds = 0;
+  {
+    AppDataGuard guard;
+    int next = alarms.started() ? alarms.earliest() : -1;
+    uint32_t now = alarmNow();
+    if (next >= 0 && alarms.get(next)->due > now) seconds = alarms.get(next)->due - now;
+  }
+  if (seconds > 0) {
+    unsigned long minutes = seconds / 60;
+    unsigned long secs = seconds % 60;
+    html += "<div class='alarm-active'>";
+    html += "<p>Alarm Active</p>";
+    html += "<p>";
+    if (minutes > 0) html += String(minutes) + " min ";
+    html += String(secs) + " sec";
+    html += "</p></div>";
   } else {
     html += "<div class='alarm-inactive'><p>No active alarm</p></div>";
   }
   server.send(200, "text/html", html);
 }
 
+// The clear and cancel handlers only queue the work for the pipeline task and answer at
+// once; the dashboard sees the result through the usual sync deltas.
 void handleClearChat() {
-  clearChatHistory();
-  broadcastChatHistory(); // Sync UI
+  postWebCommand(WEB_CMD_CLEAR_CHAT);
   server.send(200, "text/plain", "Chat history cleared");
 }
 
 void handleClearGallery() {
-  lastCapturedImage.clear();
-  imageCaptureCounter = 0;
-  if (SPIFFS.exists("/last_image.jpg")) {
-    SPIFFS.remove("/last_image.jpg");
-  }
-  broadcastGallery(); // Sync UI
+  postWebCommand(WEB_CMD_CLEAR_GALLERY);
   server.send(200, "text/plain", "Gallery cleared");
 }
 
 void handleClearTodos() {
-  clearTodoLists();
-  broadcastTodoLists(); // Sync UI
+  postWebCommand(WEB_CMD_CLEAR_TODOS);
   server.send(200, "text/plain", "Todo lists cleared");
 }
 
 void handleCancelAlarm() {
-  if (alarmTriggerTime != 0 || currentAIState == AI_ALARMING) {
-    alarmTriggerTime = 0;
-    audio.stopSong();
-    alarmSoundStarted = false; // <--- Reset flag
-    currentAIState = AI_IDLE;
-    broadcastState(AI_IDLE);
-    broadcastAlarm(0, false);
+  if (alarms.count() > 0 || aiState() == AI_ALARMING) {
+    postWebCommand(WEB_CMD_CANCEL_ALARM);
     server.send(200, "application/json", "{\"status\":\"alarm_cancelled\"}");
   } else {
     server.send(200, "application/json", "{\"status\":\"no_alarm_to_cancel\"}");
   }
 }
 
-// --- DIRECT ALARM TONE GENERATION (using I2S audio out) ---
-void generateAlarmBeep() {
-    // Generate a simple beep tone using the Audio library's built-in capabilities
-    // This creates a pure sine wave and plays it through the I2S speaker
-    
-    Serial.println("🔊 Playing alarm beep...");
-    
-    // Use the Audio library's tone generation if available
-    // For now, play a brief silence to clear any buffered audio first
-    audio.stopSong();
-    yield();
-    
-    // Alternative: Generate simple PWM beep on a GPIO pin if available
-    // For now just log that we're playing
-    Serial.println("✓ Beep sent to I2S");
-}
-
 // --- RTTTL ENDPOINT (fallback, kept for compatibility) ---
+// Serves the rendered alarm melody as a WAV file; if it is not in SPIFFS it is
+// synthesized on the fly, one buffer per sendContent() call.
 void handleRtttlAlarm() {
-  // This endpoint serves a quick WAV beep that the audio library can play
-  Serial.println("📞 Serving WAV alarm beep from HTTP...");
-  
-  // ULTRA-SHORT beep to minimize HTTP transfer time and blocking
-  const int sampleRate = 8000; // Very low sample rate for small size
-  const float duration = 0.15; // Only 150ms
-  const int frequency = 1000;
-  const int numSamples = (int)(sampleRate * duration);
-  
-  uint8_t wavHeader[44];
-  int fileSize = 36 + numSamples * 2;
-  
-  wavHeader[0] = 'R'; wavHeader[1] = 'I'; wavHeader[2] = 'F'; wavHeader[3] = 'F';
-  wavHeader[4] = (fileSize) & 0xFF;
-  wavHeader[5] = (fileSize >> 8) & 0xFF;
-  wavHeader[6] = (fileSize >> 16) & 0xFF;
-  wavHeader[7] = (fileSize >> 24) & 0xFF;
-  wavHeader[8] = 'W'; wavHeader[9] = 'A'; wavHeader[10] = 'V'; wavHeader[11] = 'E';
-  
-  wavHeader[12] = 'f'; wavHeader[13] = 'm'; wavHeader[14] = 't'; wavHeader[15] = ' ';
-  wavHeader[16] = 16; wavHeader[17] = 0; wavHeader[18] = 0; wavHeader[19] = 0;
-  wavHeader[20] = 1; wavHeader[21] = 0;
-  wavHeader[22] = 1; wavHeader[23] = 0;
-  wavHeader[24] = (sampleRate) & 0xFF;
-  wavHeader[25] = (sampleRate >> 8) & 0xFF;
-  wavHeader[26] = (sampleRate >> 16) & 0xFF;
-  wavHeader[27] = (sampleRate >> 24) & 0xFF;
-  wavHeader[28] = (sampleRate * 2) & 0xFF;
-  wavHeader[29] = (sampleRate * 2 >> 8) & 0xFF;
-  wavHeader[30] = (sampleRate * 2 >> 16) & 0xFF;
-  wavHeader[31] = (sampleRate * 2 >> 24) & 0xFF;
-  wavHeader[32] = 2; wavHeader[33] = 0;
-  wavHeader[34] = 16; wavHeader[35] = 0;
-  
-  wavHeader[36] = 'd'; wavHeader[37] = 'a'; wavHeader[38] = 't'; wavHeader[39] = 'a';
-  wavHeader[40] = (numSamples * 2) & 0xFF;
-  wavHeader[41] = (numSamples * 2 >> 8) & 0xFF;
-  wavHeader[42] = (numSamples * 2 >> 16) & 0xFF;
-  wavHeader[43] = (numSamples * 2 >> 24) & 0xFF;
-  
-  server.setContentLength(44 + numSamples * 2);
-  server.send(200, "audio/wav", "");
-  
-  // Send WAV header quickly
-  for (int i = 0; i < 44; i++) {
-    server.sendContent((const char*)&wavHeader[i], 1);
+  File file = SPIFFS.open(ALARM_WAV_PATH, FILE_READ);
+  if (file) {
+    server.streamFile(file, "audio/wav");
+    file.close();
+    return;
   }
-  
-  // Generate samples ultra-fast
-  for (int i = 0; i < numSamples; i++) {
-    float phase = 2.0 * 3.14159265 * frequency * i / sampleRate;
-    int16_t sample = (int16_t)(10000.0 * sin(phase)); // Lower amplitude to be safe
-    
-    uint8_t low = sample & 0xFF;
-    uint8_t high = (sample >> 8) & 0xFF;
-    server.sendContent((const char*)&low, 1);
-    server.sendContent((const char*)&high, 1);
+
+  RtttlNote notes[ALARM_MAX_NOTES];
+  int count = rtttlParse(ALARM_RTTTL, notes, ALARM_MAX_NOTES);
+  if (count <= 0) {
+    server.send(500, "text/plain", "Alarm melody unavailable");
+    return;
+  }
+  uint32_t dataBytes = ToneSynth::totalSamples(notes, count, ALARM_SAMPLE_RATE) * sizeof(int16_t);
+  uint8_t header[TONE_WAV_HEADER_BYTES];
+  toneWavHeader(header, ALARM_SAMPLE_RATE, dataBytes);
+  server.setContentLength(sizeof(header) + dataBytes);
+  server.send(200, "audio/wav", "");
+  server.sendContent((const char*)header, sizeof(header));
+
+  int16_t block[ALARM_RENDER_SAMPLES / 2];
+  ToneSynth synth;
+  synth.begin(notes, count, ALARM_SAMPLE_RATE, ALARM_AMPLITUDE);
+  size_t n;
+  while ((n = synth.render(block, ALARM_RENDER_SAMPLES / 2)) > 0) {
+    server.sendContent((const char*)block, n * sizeof(int16_t));
   }
-  
-  Serial.println("✓ Quick WAV beep served (150ms)");
 }
 
 void handleRoot() {
@@ -2029,24 +2975,16 @@ void handleRoot() {
 }
 
 // ========== BACKGROUND NTP SYNC ==========
-// Continuously tries to sync time if not yet synced
+// Continuously tries to sync time if not yet synced. Runs on the web task, so it
+// never waits: SNTP works in the background and the result is checked on later calls.
 void backgroundNTPSync() {
     static unsigned long last_ntp_attempt = 0;
+    static bool attempt_pending = false;
     time_t current_time = time(nullptr);
     
-    // Try NTP sync every 60 seconds if time is not synced
-    if (current_time < 24 * 3600 && millis() - last_ntp_attempt > 60000) {
-        last_ntp_attempt = millis();
-        Serial.println("\n🔄 Background NTP sync attempt...");
-        
-        // Refresh time from NTP servers (auto-discovery)
-        configTime(5 * 3600 + 30 * 60, 0, 
-                  "pool.ntp.org", "time.nist.gov", "time.google.com");
-        
-        delay(3000);  // Wait 3 seconds for sync attempt
-        
-        current_time = time(nullptr);
-        if (current_time > 24 * 3600) {
+    if (current_time > 24 * 3600) {
+        if (attempt_pending) {
+            attempt_pending = false;
             Serial.println("✓ Background NTP sync successful!");
             struct tm timeinfo;
             localtime_r(&current_time, &timeinfo);
@@ -2054,11 +2992,23 @@ void backgroundNTPSync() {
             strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S IST", &timeinfo);
             Serial.printf("  Current time: %s\n", buffer);
         }
+        return;
     }
-}
 
-void initCamera() {
-    camera_config_t config;
+    // Try NTP sync every 60 seconds if time is not synced
+    if (millis() - last_ntp_attempt > 60000) {
+        last_ntp_attempt = millis();
+        attempt_pending = true;
+        Serial.println("\n🔄 Background NTP sync attempt...");
+        
+        // Refresh time from NTP servers (auto-discovery)
+        configTime(5 * 3600 + 30 * 60, 0, 
+                  "pool.ntp.org", "time.nist.gov", "time.google.com");
+    }
+}
+
+void initCamera() {
+    camera_config_t config;
     config.ledc_channel = LEDC_CHANNEL_0;
     config.ledc_timer = LEDC_TIMER_0;
     
@@ -2091,15 +3041,15 @@ void initCamera() {
     config.pixel_format = PIXFORMAT_JPEG;
     config.frame_size = FRAMESIZE_QVGA;  // 320x240 - optimized for speed/vision API
     config.jpeg_quality = 15;            // 0-63, lower means higher quality
-    config.fb_count = 1;                 // Dual frame buffers for smoother streaming
+    config.fb_count = 2;                 // Dual frame buffers: the driver keeps filling one while the other is read
     config.fb_location = CAMERA_FB_IN_PSRAM;
-    config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
+    config.grab_mode = CAMERA_GRAB_LATEST;   // Always hand out the newest frame, never a stale queued one
 
     // Initialize the hardware
     esp_err_t err = esp_camera_init(&config);
     if (err != ESP_OK) {
         Serial.printf("Camera init failed with error 0x%x", err);
-        speakText("I'm having trouble starting my camera. This is something I'll need help to fix.");
+        speakText(PHRASE_CAMERA_INIT_FAILED);
         while(1); // Halt if camera fails
     }
     
@@ -2119,461 +3069,859 @@ void initCamera() {
     }
     
     Serial.println("Camera initialized.");
+    xTaskCreatePinnedToCore(visionPrefetchTask, "VisionPrefetch", 3072, NULL, 1, NULL, 1);
 }
 
 void handleVisionRequest() {
-    cameraInUse = true;  // Signal that camera is needed
-    
-    speakText("Sure thing! Let me take a look.");
-    currentAIState = AI_THINKING;
-    
-    // Flush old frames from buffer to ensure a fresh image
-    for (int i = 0; i < 3; i++) {
-        camera_fb_t *fb_flush = esp_camera_fb_get();
-        if (fb_flush) { esp_camera_fb_return(fb_flush); }
-        delay(100);
+    unsigned long requestStart = millis();
+    uint32_t heapBefore = ESP.getFreeHeap();
+
+    // Take the frame first, so it shows the moment the question was asked
+    SharedFrame* frame = frameBroker.latest(VISION_MAX_FRAME_AGE_MS);
+    if (!frame) {
+        frame = captureSharedFrame();
     }
-    
-    // Now capture a fresh frame
-    delay(200);  // Wait for camera sensor to settle
-    camera_fb_t *fb = esp_camera_fb_get();
-    
-    if (!fb || fb->len == 0) {
+    if (!frame) {
         Serial.println("Camera capture failed");
-        speakText("Hmm, I'm having trouble with my camera right now. Could you try again?");
-        cameraInUse = false;  // Release flag
+        speakText(PHRASE_CAMERA_FAILED);
         return;
     }
-    
-    Serial.printf("📸 Captured frame size: %d bytes\n", fb->len);
-    
-    // Store for the Web UI gallery
-    lastCapturedImage.assign(fb->buf, fb->buf + fb->len);
-    imageCaptureCounter++;  
-    
+    Serial.printf("📸 Frame %u bytes, %lu ms old, ready after %lu ms\n",
+                  (unsigned)frame->len, millis() - frame->capturedAt, millis() - requestStart);
+
+    // The gallery shares the frame instead of copying it
+    setLastCapturedImage(frame);
+    imageCaptureCounter++;
+
     // Notify Web UI via WebSocket
     StaticJsonDocument<32> doc;
     doc["image_ready"] = true;
     String json;
     serializeJson(doc, json);
     sendToAllClients(json); 
-    broadcastGallery();  
+    publishGallery();  
 
-    // Encode to Base64 for the API request
-    String encodedImage = base64::encode(fb->buf, fb->len);
-    esp_camera_fb_return(fb);
-    cameraInUse = false;  // Release flag
-    
-    // Send to GPT-4o-mini with a specific vision prompt
-    GptResponse visionResponse = chatWithGpt("Describe what you see in a short sentence.", encodedImage);
+    speakText(PHRASE_TAKING_A_LOOK);
+    setAIState(AI_THINKING);
+
+    // Send to GPT-4o-mini with a specific vision prompt; the JPEG is base64-encoded into the request body
+    GptResponse visionResponse = chatWithGpt("Describe what you see in a short sentence.", frame);
+    sharedFrameRelease(frame);
+    Serial.printf("[Vision] Heap free: %u before, %u after, %u lowest since boot\n",
+                  heapBefore, ESP.getFreeHeap(), ESP.getMinFreeHeap());
     
     if (visionResponse.textToSpeak.length() > 0) {
         Serial.print("🤖 Vision says: "); Serial.println(visionResponse.textToSpeak);
         speakText(visionResponse.textToSpeak);
         
     } else {
-        speakText("I'm sorry, I couldn't understand what I'm seeing.");
+        speakText(PHRASE_VISION_FAILED);
     }
 }
 
-void loop() {
-    ArduinoOTA.handle();
-    server.handleClient();
-    webSocket.loop();
-    
-    static unsigned long lastAudioLoop = 0;
-    static unsigned long audioLoopStart = 0;
-    
-    if (!audio.isRunning()) {
-        audioLoopStart = millis();
+// ========== VOICE PIPELINE (MAIN LOOP) ==========
+// loop() is the pipeline task. It sleeps on its event queue and runs one voice turn at
+// a time; a turn may block on the network for seconds because the web server, audio
+// playback and the display run on their own tasks.
+
+// Touch events that arrive while a turn is speaking are kept for loop(), in order
+std::deque<KikoEvent> deferredEvents;
+#define DEFERRED_EVENTS_MAX 8
+
+void noteTouchLatency(const KikoEvent& ev) {
+    touchLatencyLastMs = millis() - ev.at;
+    if (touchLatencyLastMs > touchLatencyMaxMs) touchLatencyMaxMs = touchLatencyLastMs;
+}
+
+void sendAudioCommand(AudioOp op, String* text) {
+    AudioCommand cmd = {op, text};
+    xQueueSend(audioCommands, &cmd, portMAX_DELAY);
+}
+
+void stopAlarm(const char* reason, bool broadcast) {
+    Serial.println(reason);
+    sendAudioCommand(AUDIO_STOP);
+    alarmSoundStarted = false;
+    setAIState(AI_IDLE);
+    if (broadcast) broadcastAlarm();
+}
+
+// Starts the alarm wheel on uptime, moves it onto Unix time and resumes the saved alarms
+// once the clock is synced, rings for alarms that came due (the audio task loops the tone)
+// and ends a ring that has gone on for ALARM_RING_MS
+void serviceAlarm() {
+    if (!alarms.started()) {
+        AppDataGuard guard;
+        alarms.begin(ALARM_CAPACITY, alarmNow());
+    }
+    time_t wall = time(nullptr);
+    if (!alarmClockSynced && wall > 1700000000) {
+        {
+            AppDataGuard guard;
+            alarms.rebase((uint32_t)wall - millis() / 1000);   // Timers set so far keep their time left
+            alarmClockSynced = true;
+        }
+        loadAlarms(wall);
+        saveAlarms();
+        broadcastAlarm();
+    }
+    uint32_t now = alarmNow();
+
+    char fired[ALARM_NAME_LEN] = "";
+    int count;
+    {
+        AppDataGuard guard;
+        count = alarms.advance(now, [&](const AlarmTimer& t) {
+            snprintf(fired, sizeof(fired), "%s", t.name);
+        });
+    }
+    if (count > 0) {
+        saveAlarms();
+        alarmUpdateCounter++;
+        snprintf(lastAlarmName, sizeof(lastAlarmName), "%s", fired);
+        alarmLoopStartTime = millis();   // One that comes due while ringing extends the ring
+        if (aiState() != AI_ALARMING) {
+            setAIState(AI_ALARMING);
+            alarmSoundStarted = true;
+            sendAudioCommand(AUDIO_ALARM);
+        }
+        Serial.printf("ALARM TRIGGERED: %s\n", fired);
+        broadcastAlarm();
     }
     
-    audio.loop();
-    
-    for (int i = 0; i < 10; i++) yield();
-    
-    backgroundNTPSync();
+    if (aiState() == AI_ALARMING && millis() - alarmLoopStartTime > ALARM_RING_MS) {
+        stopAlarm("⏱️  Alarm timeout - stopping after 120 seconds");
+    }
+}
+
+// The dashboard's button stops a ringing alarm, else cancels the one it counts down to
+void cancelAlarmFromWeb() {
+    if (aiState() == AI_ALARMING) {
+        stopAlarm("Alarm cancelled from the web interface.");
+        return;
+    }
+    bool cancelled;
+    {
+        AppDataGuard guard;
+        cancelled = alarms.started() && alarms.cancel(alarms.earliest());
+    }
+    if (!cancelled) return;
+    Serial.println("Alarm cancelled from the web interface.");
+    saveAlarms();
+    alarmUpdateCounter++;
+    broadcastAlarm();
+}
+
+void runWebCommand(WebCommand cmd) {
+    switch (cmd) {
+        case WEB_CMD_CLEAR_CHAT:
+            clearChatHistory();
+            break;
+        case WEB_CMD_CLEAR_GALLERY:
+            clearGallery();
+            break;
+        case WEB_CMD_CLEAR_TODOS:
+            clearTodoLists();
+            break;
+        case WEB_CMD_STOP_SURVEILLANCE:
+            inSurveillanceMode = false;
+            setAIState(AI_IDLE);
+            broadcastCameraMode("off");
+            Serial.println(">>> Surveillance stopped via web interface");
+            break;
+        case WEB_CMD_CANCEL_ALARM:
+            cancelAlarmFromWeb();
+            break;
+    }
+}
+
+// Next event from the queue; web commands are run on the way, in the middle of a turn too
+bool receivePipelineEvent(KikoEvent& ev, TickType_t wait) {
+    while (xQueueReceive(pipelineEvents, &ev, wait) == pdTRUE) {
+        if (ev.type != EV_WEB_COMMAND) return true;
+        runWebCommand((WebCommand)ev.arg);
+        wait = 0;
+    }
+    return false;
+}
+
+// Keeps an event for loop(), which takes it before anything still queued
+void deferPipelineEvent(const KikoEvent& ev) {
+    if (deferredEvents.size() >= DEFERRED_EVENTS_MAX) deferredEvents.pop_front();
+    deferredEvents.push_back(ev);
+}
+
+// Like receivePipelineEvent(), but touches deferred during speech come first
+bool nextPipelineEvent(KikoEvent& ev, TickType_t wait) {
+    if (!deferredEvents.empty()) {
+        ev = deferredEvents.front();
+        deferredEvents.pop_front();
+        return true;
+    }
+    return receivePipelineEvent(ev, wait);
+}
+
+void handleTouchEvent(const KikoEvent& ev) {
+    noteTouchLatency(ev);
+
+    // Alarm dismissal works anytime (even before the intro): a tap stops it, a long press snoozes
+    if (aiState() == AI_ALARMING) {
+        if (ev.type == EV_LONG_PRESS) {
+            snoozeAlarm(ALARM_SNOOZE_SEC);
+            touchReleasePending = true;
+        } else if (ev.type == EV_TOUCH_UP) {
+            stopAlarm("Alarm stopped by touch.");
+        }
+        return;
+    }
+
+    // Only allow normal touch interactions once the intro is complete
+    if (!introSpoken || currentState != S_IDLE) return;
+    if (touchReleasePending) {
+        if (ev.type == EV_TOUCH_UP) touchReleasePending = false;
+        return;
+    }
+
+    if (ev.type == EV_LONG_PRESS) {
+        Serial.println("Long press detected - starting recording.");
+        currentState = S_RECORDING; 
+        int samples_recorded = recordAudio(); 
+        int bytes_recorded = samples_recorded * sizeof(int16_t); 
+        currentState = S_TRANSCRIBING; 
+        processAudio(bytes_recorded, samples_recorded); 
+        return;
+    }
+
+    if (ev.type != EV_TOUCH_UP || ev.arg >= TOUCH_LONG_PRESS_MS) return;
+
+    if (ev.at - lastTapTime < DOUBLE_TAP_TIME_MS) {
+        Serial.println("Double-tap detected - toggling surveillance mode");
+        if (aiState() != AI_SURVEILLANCE) {
+            inSurveillanceMode = true;
+            setAIState(AI_SURVEILLANCE);
+            broadcastCameraMode("live");
+            Serial.println(">>> System now ready for MJPEG streaming - surveillance started.");
+            Serial.println("🔊 Surveillance activated");
+        } else {
+            inSurveillanceMode = false;
+            setAIState(AI_IDLE);
+            broadcastCameraMode("off");
+            Serial.println(">>> Surveillance mode stopped.");
+            
+            speakText(PHRASE_STOPPED_WATCHING);
+        }
+        lastTapTime = 0;
+    } else {
+        lastTapTime = ev.at;
+        
+        // Only toggle display if NOT in surveillance mode
+        if (aiState() == AI_IDLE) {
+            Serial.println("Short tap detected - switching idle mode.");
+            currentIdleDisplay = (currentIdleDisplay == IDLE_EYES) ? IDLE_INFO : IDLE_EYES;
+            displayNotify();
+        }
+    }
+}
+
+// TTS needs a valid clock; give NTP up to 15 s more before the introduction
+void waitForClock() {
+    Serial.println("Waiting for NTP time sync before introduction...");
+    unsigned long waitStart = millis();
+    while (time(nullptr) < 24 * 3600 && millis() - waitStart < 15000) {
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+    if (time(nullptr) >= 24 * 3600) {
+        Serial.println("✓ NTP synced! Time is valid.");
+    } else {
+        Serial.println("⚠️  NTP sync timeout - may affect TTS");
+    }
+}
+
+void loop() {
+    static unsigned long lastLoop = 0;
+    unsigned long now = millis();
+    if (lastLoop) stageLatency[STAGE_LOOP_GAP].record(now - lastLoop);
+    lastLoop = now;
 
     // Speak introduction on first loop iteration after setup completes
-    if (!introSpoken && currentAIState == AI_IDLE) {
+    if (!introSpoken && aiState() == AI_IDLE) {
+        waitForClock();
         speakDefaultIntroduction(); // Execution stays here until intro finishes
         introSpoken = true;          // The "lock" is now disengaged
         Serial.println("✅ Intro finished. Touch controls activated.");
     }
 
-    // --- ALARM TRIGGER AND LOOP LOGIC ---
-    if (alarmTriggerTime != 0 && millis() >= alarmTriggerTime) {
-        currentAIState = AI_ALARMING;
-        alarmSoundStarted = false;
-        alarmLoopStartTime = millis();
-        broadcastState(AI_ALARMING);
-        broadcastAlarm(alarmTriggerTime, true);
-        Serial.println("ALARM TRIGGERED!");
-        alarmTriggerTime = 0;
-    }
-    
-    if (currentAIState == AI_ALARMING) {
-        // Keep restarting alarm sound until timeout (120 seconds)
-        if (!audio.isRunning()) {
-            // Audio finished playing, restart it for continuous alarm
-            Serial.println("🔊 ALARM - restarting audio...");
-            playAlarmTone();
-        }
-        
-        // Auto-stop alarm after 120 seconds
-        if (millis() - alarmLoopStartTime > 120000) {
-            Serial.println("⏱️  Alarm timeout - stopping after 120 seconds");
-            audio.stopSong();
-            currentAIState = AI_IDLE;
-            alarmSoundStarted = false;
-            broadcastState(AI_IDLE);
+    KikoEvent ev;
+    if (nextPipelineEvent(ev, pdMS_TO_TICKS(100))) {
+        if (ev.type == EV_TOUCH_DOWN || ev.type == EV_TOUCH_UP || ev.type == EV_LONG_PRESS) {
+            handleTouchEvent(ev);
         }
     }
-    // --- END ALARM LOGIC ---
-    
-    updateAnimation(); 
 
-    // Allow touch for alarm dismissal OR normal interactions once intro is complete
-    currentTouchValue = touchRead(BUTTON_PIN);
-    bool currentTouchState = (touchRead(BUTTON_PIN) > TOUCH_THRESHOLD);
-    
-    // Special case: allow alarm dismissal anytime (even before intro)
-    if (currentAIState == AI_ALARMING) {
-        static unsigned long alarmTouchStart = 0;
-        static bool alarmTouchActive = false;
-        
-        if (currentTouchState && !alarmTouchActive) {
-            alarmTouchStart = millis();
-            alarmTouchActive = true;
-        } else if (!currentTouchState && alarmTouchActive) {
-            Serial.println("Alarm stopped by touch.");
-            audio.stopSong();
-            currentAIState = AI_IDLE;
-            alarmTriggerTime = 0;
-            alarmSoundStarted = false;
-            broadcastState(AI_IDLE);
-            broadcastAlarm(0, false);
-            alarmTouchActive = false;
+    serviceAlarm();
+    apiPool.evictIdle();
+}
+
+// ========== WEB SERVER TASK ==========
+// The only task that touches the HTTP server, the WebSocket and OTA. Other tasks reach
+// the dashboard through wsOutbox (sendToAllClients) and the event bus (state changes).
+void webTask(void *param) {
+    unsigned long lastIteration = millis();
+    for (;;) {
+        // Worst time a request could have waited to be picked up
+        unsigned long now = millis();
+        if (now - lastIteration > webLoopMaxGapMs) webLoopMaxGapMs = now - lastIteration;
+        lastIteration = now;
+
+        ArduinoOTA.handle();
+        server.handleClient();
+        webSocket.loop();
+
+        KikoEvent ev;
+        while (xQueueReceive(webEvents, &ev, 0) == pdTRUE) {
+            if (ev.type == EV_STATE_CHANGED) broadcastState((AIState)ev.arg);
         }
+        drainWsOutbox();
+        pumpSyncLog();
+        broadcastStreamStats();
+        broadcastMetrics();
+        backgroundNTPSync();
+        vTaskDelay(pdMS_TO_TICKS(2));
     }
+}
 
-    // Only allow normal touch interactions once the intro is complete
-    if (introSpoken) {
-        static unsigned long touchStartTime = 0; 
-        static bool touchActive = false; 
-        unsigned long touchDuration = 0;
-
-        if (currentTouchState && !touchActive) {
-            touchStartTime = millis(); 
-            touchActive = true;
-            // No delay here - non-blocking debounce using millis() instead
-        } else if (!currentTouchState && touchActive) {
-            touchDuration = millis() - touchStartTime;
-
-            if (currentAIState != AI_ALARMING) {
-                if (currentState == S_IDLE && touchDuration < 500) {
-                    unsigned long now = millis();
-                    
-                    if (now - lastTapTime < DOUBLE_TAP_TIME_MS) {
-                        Serial.println("Double-tap detected - toggling surveillance mode");
-                        if (currentAIState != AI_SURVEILLANCE) {
-                            inSurveillanceMode = true;
-                            currentAIState = AI_SURVEILLANCE;
-                            cameraInUse = false;
-                            broadcastState(AI_SURVEILLANCE);
-                            broadcastCameraMode("live");
-                            Serial.println(">>> System now ready for MJPEG streaming - surveillance started.");
-                            
-                            audio.setVolume(21);
-                            Serial.println("🔊 Surveillance activated");
-                        } else {
-                            inSurveillanceMode = false;
-                            currentAIState = AI_IDLE;
-                            cameraInUse = false;
-                            broadcastState(AI_IDLE);
-                            broadcastCameraMode("off");
-                            Serial.println(">>> Surveillance mode stopped.");
-                            
-                            speakText("I have stopped watching.");
-                        }
-                        lastTapTime = 0;
-                    } else {
-                        lastTapTime = now;
-                        
-                        // Only toggle display if NOT in surveillance mode
-                        if (currentAIState == AI_IDLE) {
-                            Serial.println("Short tap detected - switching idle mode.");
-                            currentIdleDisplay = (currentIdleDisplay == IDLE_EYES) ? IDLE_INFO : IDLE_EYES;
-                            updateAnimation(); 
-                        }
-                    }
-                }
-            }
-            
-            touchActive = false; 
-        } else if (currentTouchState && touchActive && currentState == S_IDLE) {
-            touchDuration = millis() - touchStartTime;
-            if (touchDuration >= 500) {
-                Serial.println("Long press detected - starting recording.");
-                currentState = S_RECORDING; 
-                int samples_recorded = recordAudio(); 
-                int bytes_recorded = samples_recorded * sizeof(int16_t); 
-                currentState = S_TRANSCRIBING; 
-                processAudio(bytes_recorded, samples_recorded); 
-                touchActive = false;
-            }
+void startWebTask() {
+    // Core 0, next to the WiFi stack
+    xTaskCreatePinnedToCore(webTask, "Web", 8192, NULL, 2, &webTaskHandle, 0);
+}
+
+// GET /api/runtime: stack headroom per task, event bus counters and worst-case latencies
+void handleRuntimeStatsAPI() {
+  JsonDocument doc;
+  JsonObject stacks = doc.createNestedObject("stackFree");
+  TaskHandle_t tasks[] = {webTaskHandle, audioTaskHandle, displayTaskHandle, micCaptureTaskHandle, ttsCacheTaskHandle,
+                          xTaskGetHandle("loopTask")};
+  const char* names[] = {"web", "audio", "display", "mic", "ttsCache", "pipeline"};
+  for (int i = 0; i < 6; i++) {
+    if (tasks[i]) stacks[names[i]] = uxTaskGetStackHighWaterMark(tasks[i]);
+  }
+  doc["eventsPublished"] = eventBus.published();
+  doc["eventsDropped"] = eventBus.dropped();
+  doc["webLoopMaxGapMs"] = webLoopMaxGapMs;
+  doc["touchLatencyMaxMs"] = touchLatencyMaxMs;
+  doc["touchLatencyLastMs"] = touchLatencyLastMs;
+  doc["sentencesQueued"] = speechSubmitted;
+  doc["sentencesDone"] = (uint32_t)speechCompleted;
+  JsonObject intents = doc.createNestedObject("intents");
+  uint32_t localMs = localTurns.turns ? localTurns.firstAudioMsTotal / localTurns.turns : 0;
+  uint32_t modelMs = modelTurns.turns ? modelTurns.firstAudioMsTotal / modelTurns.turns : 0;
+  intents["localTurns"] = localTurns.turns;
+  intents["modelTurns"] = modelTurns.turns;
+  intents["localFirstAudioMs"] = localMs;
+  intents["modelFirstAudioMs"] = modelMs;
+  intents["savedPerLocalTurnMs"] = (localTurns.turns && modelTurns.turns && modelMs > localMs) ? modelMs - localMs : 0;
+  if (lastTurn.seq > 0) {
+    JsonObject turn = doc.createNestedObject("lastTurn");
+    turn["seq"] = lastTurn.seq;
+    turn["path"] = lastTurn.local ? "local" : "model";
+    turn["transcribeMs"] = lastTurn.transcribeMs;
+    turn["replyMs"] = lastTurn.replyMs;
+    turn["firstAudioMs"] = lastTurn.firstAudioMs;
+    turn["totalMs"] = lastTurn.totalMs;
+    turn["uploadBytes"] = lastTurn.uploadBytes;
+    turn["heapLow"] = lastTurn.heapLow;
+  }
+  {
+    AppDataGuard guard;
+    JsonObject alarmStats = doc.createNestedObject("alarms");
+    alarmStats["active"] = alarms.count();
+    alarmStats["capacity"] = alarms.capacity();
+    alarmStats["ticks"] = alarms.stats().ticks;
+    alarmStats["cascaded"] = alarms.stats().cascaded;
+    alarmStats["fired"] = alarms.stats().fired;
+    alarmStats["clockJumps"] = alarms.stats().refiles;
+  }
+  {
+    AppDataGuard guard;
+    JsonObject todos = doc.createNestedObject("todos");
+    todos["lists"] = todoStore.listCount();
+    todos["arenaBytes"] = todoStore.arenaBytes();
+    todos["mutations"] = todoStore.stats().mutations;
+    todos["journalBytesWritten"] = todoStore.stats().journalBytes;
+    todos["journalBytes"] = todoJournalSize;
+    todos["snapshotBytes"] = todoSnapshotSize;
+    todos["compactions"] = todoStore.stats().compactions;
+  }
+  JsonObject parsing = doc.createNestedObject("parsing");
+  const ApiParseStats* parseStats[] = {&chatParseStats, &whisperParseStats, &weatherParseStats, &searchParseStats};
+  const char* parseNames[] = {"chat", "whisper", "weather", "search"};
+  for (int i = 0; i < 4; i++) {
+    const ApiParseStats& s = *parseStats[i];
+    JsonObject api = parsing.createNestedObject(parseNames[i]);
+    api["responses"] = s.responses;
+    api["failures"] = s.failures;
+    api["bodyBytes"] = s.bodyBytes;
+    api["avgParseUs"] = s.responses ? s.parseUsTotal / s.responses : 0;
+    api["maxParseUs"] = s.parseUsMax;
+    api["peakDocBytes"] = s.peakDocBytes;
+  }
+  uint32_t assetRequests = webAssetStats.served + webAssetStats.notModified;
+  JsonObject web = doc.createNestedObject("dashboard");
+  web["served"] = webAssetStats.served;
+  web["notModified"] = webAssetStats.notModified;
+  web["bodyBytes"] = webAssetStats.bodyBytes;
+  web["avgServeUs"] = assetRequests ? webAssetStats.serveUsTotal / assetRequests : 0;
+  web["maxServeUs"] = webAssetStats.serveUsMax;
+  web["lastPageRequests"] = webAssetStats.pageRequests;
+  web["lastPageBodyBytes"] = webAssetStats.pageBodyBytes;
+  web["lastPageServeUs"] = webAssetStats.pageServeUs;
+  String json;
+  serializeJson(doc, json);
+  server.send(200, "application/json", json);
+}
+
+void appendGauge(String& out, const char* name, const char* help, long value) {
+  char line[160];
+  snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s gauge\n%s %ld\n", name, help, name, name, value);
+  out += line;
+}
+
+// GET /api/metrics: stage and tool latency histograms plus memory and Wi-Fi gauges, in the
+// Prometheus text format. Sent chunked, one histogram at a time.
+void handleMetricsAPI() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain; version=0.0.4", "");
+  String chunk;
+  chunk.reserve(1536);
+
+  chunk = "# HELP kiko_stage_duration_seconds Voice pipeline stage latency\n"
+          "# TYPE kiko_stage_duration_seconds histogram\n";
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    stageLatency[i].appendPrometheus(chunk, "kiko_stage_duration_seconds", "stage", STAGE_NAMES[i]);
+    server.sendContent(chunk);
+    chunk = "";
+  }
+  chunk = "# HELP kiko_tool_duration_seconds Tool handler latency\n"
+          "# TYPE kiko_tool_duration_seconds histogram\n";
+  for (int i = 0; i < TOOL_COUNT; i++) {
+    toolLatency[i].appendPrometheus(chunk, "kiko_tool_duration_seconds", "tool", toolRegistry[i].name);
+    server.sendContent(chunk);
+    chunk = "";
+  }
+
+  appendGauge(chunk, "kiko_heap_free_bytes", "Free internal heap", ESP.getFreeHeap());
+  appendGauge(chunk, "kiko_heap_min_free_bytes", "Lowest free internal heap since boot", ESP.getMinFreeHeap());
+  appendGauge(chunk, "kiko_psram_free_bytes", "Free PSRAM", ESP.getFreePsram());
+  appendGauge(chunk, "kiko_psram_min_free_bytes", "Lowest free PSRAM since boot", ESP.getMinFreePsram());
+  appendGauge(chunk, "kiko_wifi_rssi_dbm", "Wi-Fi signal strength", WiFi.RSSI());
+  appendGauge(chunk, "kiko_uptime_seconds", "Time since boot", millis() / 1000);
+  appendGauge(chunk, "kiko_web_loop_max_gap_ms", "Longest web task iteration gap", webLoopMaxGapMs);
+  appendGauge(chunk, "kiko_events_dropped", "Event bus messages dropped", eventBus.dropped());
+  server.sendContent(chunk);
+  server.sendContent("");
+}
+
+// Compact metrics frame for the dashboard: [count, p50 ms, p95 ms] per stage, plus gauges
+void broadcastMetrics() {
+  static unsigned long lastPush = 0;
+  if (millis() - lastPush < METRICS_PUSH_MS) return;
+  lastPush = millis();
+
+  JsonDocument doc;
+  JsonObject m = doc.createNestedObject("metrics");
+  JsonObject stages = m.createNestedObject("stages");
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    JsonArray a = stages.createNestedArray(STAGE_NAMES[i]);
+    a.add(stageLatency[i].count());
+    a.add(stageLatency[i].quantileMs(0.5f));
+    a.add(stageLatency[i].quantileMs(0.95f));
+  }
+  m["heap"] = ESP.getFreeHeap();
+  m["heapMin"] = ESP.getMinFreeHeap();
+  m["psram"] = ESP.getFreePsram();
+  m["psramMin"] = ESP.getMinFreePsram();
+  m["rssi"] = WiFi.RSSI();
+  String json;
+  serializeJson(doc, json);
+  sendToAllClients(json);
+}
+
+// --- MICROPHONE CAPTURE TASK ---
+// Reads the PDM microphone continuously so the DMA never overflows; samples are
+// only kept while micCapturing is set, everything else is read and dropped.
+void micCaptureTask(void* param) {
+    int16_t chunk[MIC_CHUNK_SAMPLES];
+    for (;;) {
+        size_t bytes_read = I2S.readBytes((char*)chunk, sizeof(chunk));
+        micChunksRead++;
+        if (bytes_read > 0 && micCapturing.load(std::memory_order_acquire)) {
+            micRing.write(chunk, bytes_read / sizeof(int16_t));
         }
     }
 }
 
+bool startMicCaptureTask() {
+    if (!micRing.begin(MIC_RING_SAMPLES)) {
+        Serial.println("❌ Failed to allocate microphone ring buffer!");
+        return false;
+    }
+    BaseType_t created = xTaskCreatePinnedToCore(
+        micCaptureTask,
+        "MicCapture",
+        4096,
+        NULL,
+        configMAX_PRIORITIES - 2,   // Above the main loop and the network tasks
+        &micCaptureTaskHandle,
+        1
+    );
+    if (created != pdPASS) {
+        Serial.println("❌ Failed to start microphone capture task!");
+        return false;
+    }
+    Serial.printf("✓ Mic capture task started (ring: %u samples)\n", (unsigned)micRing.capacity());
+    return true;
+}
+
+// Moves everything the capture task has produced into audio_buffer.
+int drainMicRing(int samples_read, int max_samples) {
+    while (samples_read < max_samples) {
+        size_t n = micRing.read(audio_buffer + samples_read, max_samples - samples_read);
+        if (n == 0) break;
+        samples_read += n;
+    }
+    return samples_read;
+}
+
 int recordAudio() {
+    SpanTimer span(stageLatency[STAGE_RECORD]);
     Serial.println("\n🎤 Listening... (press and hold)");
-    currentAIState = AI_LISTENING;
-    broadcastState(AI_LISTENING);
-    updateAnimation(); 
+    setAIState(AI_LISTENING);
     int samples_read = 0;
     int max_samples = audio_buffer_size / sizeof(int16_t);
+    if (micCaptureTaskHandle == NULL) {
+        Serial.println("❌ Microphone not available.");
+        return 0;
+    }
+
+    micRing.discard();
+    micRing.resetStats();
+    micCapturing.store(true, std::memory_order_release);
+    startWhisperStream();  // Open the upload now so it overlaps with the user talking
+    unsigned long recordStart = millis();
+    unsigned long lastSampleTime = recordStart;
+    vad.reset();
+    int vad_pos = 0;          // Next sample of audio_buffer the VAD has not seen
+    int trimmed_front = 0;    // Leading silence discarded before the onset
+    bool autoStopped = false;
+    const int preroll = SAMPLE_RATE * VAD_PREROLL_MS / 1000;
+    const int tail = SAMPLE_RATE * VAD_TAIL_MS / 1000;
+    bool released = false;
     
-    while (touchRead(BUTTON_PIN) > TOUCH_THRESHOLD && samples_read < max_samples) {
-        server.handleClient();
+    while (!released && samples_read < max_samples) {
+        // The display task reports the release; anything else the pad does is ignored here,
+        // and other events are put back for loop() once the turn is done
+        KikoEvent ev;
+        std::vector<KikoEvent> others;
+        while (nextPipelineEvent(ev, 0)) {
+            if (ev.type == EV_TOUCH_UP) {
+                noteTouchLatency(ev);
+                released = true;
+            } else if (ev.type != EV_TOUCH_DOWN && ev.type != EV_LONG_PRESS) {
+                others.push_back(ev);
+            }
+        }
+        for (const KikoEvent& other : others) deferPipelineEvent(other);
+
+        int before = samples_read;
+        samples_read = drainMicRing(samples_read, max_samples);
+        if (samples_read != before) {
+            lastSampleTime = millis();
+        } else if (millis() - lastSampleTime > MIC_UNDERRUN_MS) {
+            micRing.noteUnderrun();  // Capture task is not delivering
+            lastSampleTime = millis();
+        }
 
-        int16_t sample_chunk[256];
-        size_t bytes_read = I2S.readBytes((char*)sample_chunk, sizeof(sample_chunk));
-        int samples_in_chunk_read = bytes_read / sizeof(int16_t);
-        
-        for (int i = 0; i < samples_in_chunk_read && samples_read < max_samples; i++) {
-            audio_buffer[samples_read++] = sample_chunk[i];
+        int publish = samples_read;
+#if VAD_ENABLED
+        while (samples_read - vad_pos >= VAD_FRAME_SAMPLES) {
+            vad.process(audio_buffer + vad_pos, vad_pos);
+            vad_pos += VAD_FRAME_SAMPLES;
+        }
+        if (!vad.speechDetected()) {
+            // Nothing has been published yet, so the front of the clip can still be dropped
+            int drop = (int)vad.candidateStart(vad_pos) - preroll;
+            if (drop >= SAMPLE_RATE / 2) {
+                memmove(audio_buffer, audio_buffer + drop, (samples_read - drop) * sizeof(int16_t));
+                samples_read -= drop;
+                vad_pos -= drop;
+                trimmed_front += drop;
+                vad.rebase(drop);
+            }
+            publish = 0;
+            if (millis() - recordStart > RECORDING_SECONDS * 1000UL) break;  // Held without talking
+        } else {
+            // Hold back silence after the last word until speech resumes
+            publish = min(samples_read, (int)vad.speechEnd() + tail);
+            if (vad_pos - (int)vad.speechEnd() > SAMPLE_RATE * VAD_END_SILENCE_MS / 1000) {
+                autoStopped = true;
+                break;
+            }
+        }
+#endif
+        if (whisperUpload.active) {
+            whisperUpload.samplesCaptured.store(publish, std::memory_order_release);
         }
-        updateAnimation();
         delay(1);
     }
+    micCapturing.store(false, std::memory_order_release);
+    delay(2);  // Let a write that was already in progress land before the final drain
+    samples_read = drainMicRing(samples_read, max_samples);
     
+    recordingReleaseTime = millis();
     Serial.printf("✅ Recording finished. %d samples read.\n", samples_read);
+    Serial.printf("🎙️ Mic ring: peak %u/%u samples, %u overruns (%u samples dropped), %u underruns\n",
+                  (unsigned)micRing.peakFill(), (unsigned)micRing.capacity(),
+                  micRing.overruns(), micRing.droppedSamples(), micRing.underruns());
+
+#if VAD_ENABLED
+    int captured = samples_read + trimmed_front;
+    if (!vad.speechDetected()) {
+        samples_read = 0;   // No speech: processAudio() drops the clip without uploading
+    } else {
+        samples_read = min(samples_read, (int)vad.speechEnd() + tail);
+    }
+    Serial.printf("🗣️ VAD: kept %d of %d samples (%d bytes saved), %u/%u speech frames, %.1f us/frame%s\n",
+                  samples_read, captured, (captured - samples_read) * (int)sizeof(int16_t),
+                  vad.speechFrames(), vad.frames(), vad.microsPerFrame(),
+                  autoStopped ? ", stopped at end of speech" : "");
+    if (autoStopped) touchReleasePending = true;
+#endif
     return samples_read;
 }
 
 
-GptResponse chatWithGpt(String vision_prompt, String image) {
-    currentAIState = AI_THINKING;
-    broadcastState(AI_THINKING);
-    GptResponse response;
-    StaticJsonDocument<8192> doc;
-    doc["model"] = "gpt-4o-mini";
-    doc["max_tokens"] = 150;
-    JsonArray messages = doc.createNestedArray("messages");
-    bool isVisionRequest = (image.length() > 0);
-    
-    // Build system prompt with current time context
-    String systemPrompt = "You are Kiko, a friendly and helpful voice AI assistant. You're warm, approachable, and always ready to help. Speak in a conversational and natural way, like a helpful friend. Be enthusiastic when appropriate. Keep responses concise but friendly. Use simple language that's easy to understand. When using tools, do so naturally without mentioning them. Never make up information - if you don't know something, say so. Always be honest and genuine in your responses. Do not use emojis in your responses. ";
-    
-    // Add current date/time to system prompt so GPT knows it's available
+// ========== CHAT REQUEST SERIALIZATION ==========
+// Everything constant about a chat request (model settings, system prompt and the
+// tool schemas from the tool registry) is a compile-time fragment in flash. At runtime only the timestamp
+// and the chat history are serialized, and the body is streamed straight onto the
+// socket: a counting pass computes Content-Length, a second pass sends it.
+
+const char GPT_REQUEST_PREFIX[] PROGMEM = "{\"model\":\"gpt-4o-mini\",\"max_tokens\":150,";
+const char GPT_REQUEST_STREAM[] PROGMEM = "\"stream\":true,";
+const char GPT_REQUEST_MESSAGES[] PROGMEM = "\"messages\":[{\"role\":\"system\",\"content\":\"";
+
+const char GPT_SYSTEM_PROMPT[] PROGMEM = "You are Kiko, a friendly and helpful voice AI assistant. You're warm, approachable, and always ready to help. Speak in a conversational and natural way, like a helpful friend. Be enthusiastic when appropriate. Keep responses concise but friendly. Use simple language that's easy to understand. When using tools, do so naturally without mentioning them. Never make up information - if you don't know something, say so. Always be honest and genuine in your responses. Do not use emojis in your responses. ";
+
+
+// Print sink that only counts bytes (first pass, for Content-Length)
+class CountingPrint : public Print {
+ public:
+  size_t count = 0;
+  size_t write(uint8_t) override { count++; return 1; }
+  size_t write(const uint8_t*, size_t size) override { count += size; return size; }
+};
+
+// Coalesces the many small writes from ArduinoJson into full TLS records
+class BufferedClientPrint : public Print {
+ public:
+  explicit BufferedClientPrint(WiFiClient& client) : client_(client) {}
+  ~BufferedClientPrint() { flush(); }
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* data, size_t size) override {
+    size_t written = 0;
+    while (written < size) {
+      if (used_ == sizeof(buffer_)) flush();
+      size_t n = min(size - written, sizeof(buffer_) - used_);
+      memcpy(buffer_ + used_, data + written, n);
+      used_ += n;
+      written += n;
+    }
+    return failed_ ? 0 : size;
+  }
+  void flush() override {
+    if (used_ > 0 && client_.write(buffer_, used_) != used_) failed_ = true;
+    used_ = 0;
+  }
+  bool failed() const { return failed_; }
+
+ private:
+  WiFiClient& client_;
+  uint8_t buffer_[1024];
+  size_t used_ = 0;
+  bool failed_ = false;
+};
+
+// "Current date and time: 3:05 PM on Monday, ..." or empty if NTP has not synced yet
+String gptTimeContext() {
     time_t now = time(nullptr);
-    if (now > 24 * 3600) {  // If time is synced
-        struct tm timeinfo;
-        localtime_r(&now, &timeinfo);
-        char buffer[100];
-        strftime(buffer, sizeof(buffer), "Current date and time: %I:%M %p on %A, %B %d, %Y", &timeinfo);
-        if (buffer[0] == '0') {
-            systemPrompt += String(buffer).substring(1);  // Remove leading zero from hour
-        } else {
-            systemPrompt += String(buffer);
-        }
-    }
-    JsonObject systemMessage = messages.createNestedObject();
-    systemMessage["role"] = "system";
-    systemMessage["content"] = systemPrompt;
-
-    if (isVisionRequest) {  
-        JsonObject userMessage = messages.createNestedObject();
-        userMessage["role"] = "user";
-        JsonArray content = userMessage.createNestedArray("content");
-        JsonObject textPart = content.createNestedObject();
-        textPart["type"] = "text";
-        textPart["text"] = vision_prompt;
-        JsonObject imagePart = content.createNestedObject();
-        imagePart["type"] = "image_url";
-        imagePart["image_url"]["url"] = "data:image/jpeg;base64," + image;
-    } else {
-        for (const auto& msg : chatHistory) {
-            JsonObject message = messages.createNestedObject();
-            message["role"] = msg.role;
-            if (msg.role == "assistant") {
-                
-                JsonDocument assistantMsgDoc;
-                if (deserializeJson(assistantMsgDoc, msg.content) == DeserializationError::Ok && assistantMsgDoc.containsKey("tool_calls")) {
-                    
-                    message.set(assistantMsgDoc.as<JsonObject>());
-                } else {
-                    message["content"] = msg.content;
-                }
-            } else if (msg.role == "tool") {
-                message["content"] = msg.content;
-                message["tool_call_id"] = msg.tool_call_id;
-            } else {
-                
-                message["content"] = msg.content;
-            }
+    if (now <= 24 * 3600) return "";
+    struct tm timeinfo;
+    localtime_r(&now, &timeinfo);
+    char buffer[100];
+    strftime(buffer, sizeof(buffer), "Current date and time: %I:%M %p on %A, %B %d, %Y", &timeinfo);
+    if (buffer[0] == '0') {
+        return String(buffer).substring(1);  // Remove leading zero from hour
+    }
+    return String(buffer);
+}
+
+// Writes one history entry as a chat message object
+void writeHistoryMessage(Print& out, size_t i) {
+    const ChatEntry& e = chatRing.entry(i);
+    // Assistant tool-call turns are stored as the raw message JSON returned by the API
+    if (e.kind == CHAT_TOOL_CALL) {
+        out.print(chatRing.content(i));
+        return;
+    }
+    StaticJsonDocument<128> doc;
+    doc["role"] = ChatHistoryRing::roleName(e.role);
+    doc["content"] = chatRing.content(i);
+    if (e.kind == CHAT_TOOL_RESULT) {
+        doc["tool_call_id"] = chatRing.toolCallId(i);
+    }
+    serializeJson(doc, out);
+}
+
+// Base64-encodes data straight into out in small chunks, without building a String
+void writeBase64(Print& out, const uint8_t* data, size_t len) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char chunk[128];   // Multiple of 4
+    size_t used = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t n = (uint32_t)data[i] << 16;
+        if (i + 1 < len) n |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) n |= data[i + 2];
+        chunk[used++] = alphabet[(n >> 18) & 63];
+        chunk[used++] = alphabet[(n >> 12) & 63];
+        chunk[used++] = i + 1 < len ? alphabet[(n >> 6) & 63] : '=';
+        chunk[used++] = i + 2 < len ? alphabet[n & 63] : '=';
+        if (used == sizeof(chunk)) {
+            out.write((const uint8_t*)chunk, used);
+            used = 0;
         }
+    }
+    if (used > 0) out.write((const uint8_t*)chunk, used);
+}
 
-        // --- ALL CORRECTED TOOLS ARE DEFINED HERE ---
-        JsonArray tools = doc.createNestedArray("tools"); 
-        
-        JsonObject getWeatherTool = tools.createNestedObject();
-        getWeatherTool["type"] = "function";
-        JsonObject getWeatherFunc = getWeatherTool.createNestedObject("function");
-        getWeatherFunc["name"] = "get_weather";
-        getWeatherFunc["description"] = "Gets the current weather for a specific city.";
-        JsonObject weatherParams = getWeatherFunc.createNestedObject("parameters");
-        weatherParams["type"] = "object";
-        JsonObject weatherProps = weatherParams.createNestedObject("properties");
-        weatherProps["city"]["type"] = "string";
-        weatherProps["city"]["description"] = "The city, e.g., 'San Francisco'";
-        weatherParams["required"][0] = "city";      
-        
-        JsonObject getNetworkTool = tools.createNestedObject();
-        getNetworkTool["type"] = "function";
-        JsonObject getNetworkFunc = getNetworkTool.createNestedObject("function");
-        getNetworkFunc["name"] = "get_network_info";
-        getNetworkFunc["description"] = "Gets the device's local network information including WiFi SSID, IP address, and signal strength. This is safe to share as it's the user's own device's information.";
-        JsonObject networkParams = getNetworkFunc.createNestedObject("parameters");
-        networkParams["type"] = "object";
-        JsonObject networkProps = networkParams.createNestedObject("properties");  // Add empty properties object
-        
-        JsonObject getSearchTool = tools.createNestedObject();
-        getSearchTool["type"] = "function";
-        JsonObject getSearchFunc = getSearchTool.createNestedObject("function");
-        getSearchFunc["name"] = "google_search";
-        getSearchFunc["description"] = "Searches Google for real-time information, news, definitions, or facts not in your knowledge base.";
-        JsonObject searchParams = getSearchFunc.createNestedObject("parameters");
-        searchParams["type"] = "object";
-        JsonObject searchProps = searchParams.createNestedObject("properties");
-        searchProps["query"]["type"] = "string";
-        searchProps["query"]["description"] = "The search query, e.g., 'latest news on Mars rover'";
-        searchParams["required"][0] = "query";
-        
-        // --- ALARM TOOLS (Unchanged) ---
-        JsonObject setAlarmRelTool = tools.createNestedObject();
-        setAlarmRelTool["type"] = "function";
-        JsonObject setAlarmRelFunc = setAlarmRelTool.createNestedObject("function");
-        setAlarmRelFunc["name"] = "set_alarm_relative";
-        setAlarmRelFunc["description"] = "Sets an alarm to go off after a specified duration, e.g., 'in 5 minutes' or 'for 30 seconds'.";
-        JsonObject alarmRelParams = setAlarmRelFunc.createNestedObject("parameters");
-        alarmRelParams["type"] = "object";
-        JsonObject alarmRelProps = alarmRelParams.createNestedObject("properties");
-        alarmRelProps["delay_seconds"]["type"] = "number";
-        alarmRelProps["delay_seconds"]["description"] = "The number of seconds from now to set the alarm for.";
-        alarmRelParams["required"][0] = "delay_seconds";
-        JsonObject setAlarmAbsTool = tools.createNestedObject();
-        setAlarmAbsTool["type"] = "function";
-        JsonObject setAlarmAbsFunc = setAlarmAbsTool.createNestedObject("function");
-        setAlarmAbsFunc["name"] = "set_alarm_absolute";
-        setAlarmAbsFunc["description"] = "Sets an alarm for a specific time of day, e.g., 'at 2:30 PM' or 'for 11:00 AM'.";
-        JsonObject alarmAbsParams = setAlarmAbsFunc.createNestedObject("parameters");
-        alarmAbsParams["type"] = "object";
-        JsonObject alarmAbsProps = alarmAbsParams.createNestedObject("properties");
-        alarmAbsProps["hour"]["type"] = "number";
-        alarmAbsProps["hour"]["description"] = "The target hour, in 1-12 format.";
-        alarmAbsProps["minute"]["type"] = "number";
-        alarmAbsProps["minute"]["description"] = "The target minute (0-59).";
-        alarmAbsProps["period"]["type"] = "string";
-        alarmAbsProps["period"]["description"] = "The period of day, either 'AM' or 'PM'.";
-        alarmAbsParams["required"][0] = "hour";
-        alarmAbsParams["required"][1] = "minute";
-        alarmAbsParams["required"][2] = "period";
-        JsonObject getAlarmTool = tools.createNestedObject();
-        getAlarmTool["type"] = "function";
-        JsonObject getAlarmFunc = getAlarmTool.createNestedObject("function");
-        getAlarmFunc["name"] = "get_alarm_status";
-        getAlarmFunc["description"] = "Checks if an alarm is currently set and, if so, when it is scheduled to ring.";
-        JsonObject cancelAlarmTool = tools.createNestedObject();
-        cancelAlarmTool["type"] = "function";
-        JsonObject cancelAlarmFunc = cancelAlarmTool.createNestedObject("function");
-        cancelAlarmFunc["name"] = "cancel_alarm";
-        cancelAlarmFunc["description"] = "Cancels any alarm that is currently set and waiting to ring.";
-
-        // --- MODIFIED: TODO LIST TOOLS (Smarter Prompts) ---
-
-        // 1. Add To-Do
-        JsonObject addTodoTool = tools.createNestedObject();
-        addTodoTool["type"] = "function";
-        JsonObject addTodoFunc = addTodoTool.createNestedObject("function");
-        addTodoFunc["name"] = "add_todo_item";
-        addTodoFunc["description"] = "Adds an item to a to-do list. If the item already exists, its quantity is increased.";
-        JsonObject todoAddParams = addTodoFunc.createNestedObject("parameters");
-        todoAddParams["type"] = "object";
-        JsonObject todoAddProps = todoAddParams.createNestedObject("properties");
-        todoAddProps["list_name"]["type"] = "string";
-        todoAddProps["list_name"]["description"] = "The name of the list, e.g., 'groceries', 'work'.";
-        todoAddProps["item"]["type"] = "string";
-        // --- THIS DESCRIPTION IS MODIFIED ---
-        todoAddProps["item"]["description"] = "The name of the item. If units are given (e.g., kg, litres), include them in the name. e.g., 'apples', 'rice (kg)', 'milk (litres)'.";
-        todoAddProps["quantity"]["type"] = "number";
-        // --- THIS DESCRIPTION IS MODIFIED ---
-        todoAddProps["quantity"]["description"] = "The quantity for the item. Must be extracted from the user's request (e.g., '1' for '1 kg rice', '3' for '3 apples'). Defaults to 1 if not specified.";
-        todoAddParams["required"][0] = "list_name";
-        todoAddParams["required"][1] = "item";
-
-        // 2. Remove To-Do
-        JsonObject removeTodoTool = tools.createNestedObject();
-        removeTodoTool["type"] = "function";
-        JsonObject removeTodoFunc = removeTodoTool.createNestedObject("function");
-        removeTodoFunc["name"] = "remove_todo_item";
-        removeTodoFunc["description"] = "Removes an item from a to-do list. If quantity is provided, it subtracts that amount. If no quantity is provided, it removes the item entirely.";
-        JsonObject todoRemoveParams = removeTodoFunc.createNestedObject("parameters");
-        todoRemoveParams["type"] = "object";
-        JsonObject todoRemoveProps = todoRemoveParams.createNestedObject("properties");
-        todoRemoveProps["list_name"]["type"] = "string";
-        todoRemoveProps["list_name"]["description"] = "The name of the list, e.g., 'groceries'.";
-        todoRemoveProps["item"]["type"] = "string";
-        // --- THIS DESCRIPTION IS MODIFIED ---
-        todoRemoveProps["item"]["description"] = "The name of the item to remove. Must match the stored name, e.g., 'apples', 'rice (kg)'.";
-        todoRemoveProps["quantity"]["type"] = "number";
-        todoRemoveProps["quantity"]["description"] = "The quantity to remove. If not specified, all items of this type are removed.";
-        todoRemoveParams["required"][0] = "list_name";
-        todoRemoveParams["required"][1] = "item";
-
-        // 3. List To-Dos (Unchanged)
-        JsonObject listTodoTool = tools.createNestedObject();
-        listTodoTool["type"] = "function";
-        JsonObject listTodoFunc = listTodoTool.createNestedObject("function");
-        listTodoFunc["name"] = "list_todo_items";
-        listTodoFunc["description"] = "Gets all items and their quantities from a specific to-do list. If no list_name is given, it lists all available to-do lists.";
-        JsonObject todoListParams = listTodoFunc.createNestedObject("parameters");
-        todoListParams["type"] = "object";
-        JsonObject todoListProps = todoListParams.createNestedObject("properties");
-        todoListProps["list_name"]["type"] = "string";
-        todoListProps["list_name"]["description"] = "The name of the list to read, e.g., 'groceries'.";
-
-        // 4. Clear To-Dos (Unchanged)
-        JsonObject clearTodoTool = tools.createNestedObject();
-        clearTodoTool["type"] = "function";
-        JsonObject clearTodoFunc = clearTodoTool.createNestedObject("function");
-        clearTodoFunc["name"] = "clear_todo_list";
-        clearTodoFunc["description"] = "Removes all items from a specific to-do list, deleting the list.";
-        JsonObject todoClearParams = clearTodoFunc.createNestedObject("parameters");
-        todoClearParams["type"] = "object";
-        JsonObject todoClearProps = todoClearParams.createNestedObject("properties");
-        todoClearProps["list_name"]["type"] = "string";
-        todoClearProps["list_name"]["description"] = "The name of the list to clear, e.g., 'groceries'.";
-        todoClearParams["required"][0] = "list_name";
-        
-    } // This is the closing brace for 'else' (non-vision) block
+size_t toolSchemaBytes() {
+    CountingPrint counter;
+    writeToolSchemas(counter);
+    return counter.count;
+}
 
-    String requestBody;
-    serializeJson(doc, requestBody);
-    
-    HTTPClient http;
-    http.begin(chatgpt_endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.addHeader("Authorization", "Bearer " + String(OPENAI_API_KEY));
-    http.setTimeout(20000); 
-    int httpCode = http.POST(requestBody);
+// Writes the complete request body. Called twice: once into a CountingPrint, once onto the socket.
+void writeChatRequestBody(Print& out, bool stream, const String& timeContext, const String& vision_prompt, const SharedFrame* image) {
+    out.print(FPSTR(GPT_REQUEST_PREFIX));
+    if (stream) out.print(FPSTR(GPT_REQUEST_STREAM));
+    out.print(FPSTR(GPT_REQUEST_MESSAGES));
+    out.print(FPSTR(GPT_SYSTEM_PROMPT));
+    out.print(timeContext);
+    out.print("\"}");
+
+    if (image) {
+        StaticJsonDocument<64> promptDoc;
+        promptDoc.set(vision_prompt.c_str());
+        out.print(",{\"role\":\"user\",\"content\":[{\"type\":\"text\",\"text\":");
+        serializeJson(promptDoc, out);
+        out.print("},{\"type\":\"image_url\",\"image_url\":{\"url\":\"data:image/jpeg;base64,");
+        writeBase64(out, image->data, image->len);
+        out.print("\"}}]}]}");
+        return;
+    }
 
-    if (httpCode == HTTP_CODE_OK) {
-        String responsePayload = http.getString();
-        JsonDocument response_doc;
-        deserializeJson(response_doc, responsePayload);     
-        JsonObject choice = response_doc["choices"][0];
+    for (size_t i = chatRing.windowStart(CHAT_CONTEXT_TOKEN_BUDGET); i < chatRing.size(); i++) {
+        out.print(',');
+        writeHistoryMessage(out, i);
+    }
+    out.print("],\"tools\":");
+    writeToolSchemas(out);
+    out.print('}');
+}
+
+// Sends the request line, headers and streamed body on the pooled OpenAI session
+bool sendChatRequest(WiFiClient& client, size_t contentLength, bool stream, const String& timeContext,
+                     const String& vision_prompt, const SharedFrame* image) {
+    String head = "POST " + String(chatgpt_path) + " HTTP/1.1\r\n"
+                  "Host: " + String(openai_host) + "\r\n"
+                  "Authorization: Bearer " + String(OPENAI_API_KEY) + "\r\n"
+                  "Content-Type: application/json\r\n"
+                  "Connection: keep-alive\r\n"
+                  "Content-Length: " + String(contentLength) + "\r\n\r\n";
+    if (client.print(head) != head.length()) return false;
+    BufferedClientPrint body(client);
+    writeChatRequestBody(body, stream, timeContext, vision_prompt, image);
+    body.flush();
+    return !body.failed();
+}
+
+// Sends a chat request and reads the response status line and headers.
+// On success the lease's socket is positioned at the response body.
+bool openChatRequest(ApiLease& lease, bool stream, const String& vision_prompt, const SharedFrame* image,
+                     HttpResponseHead& head) {
+    unsigned long buildStart = micros();
+    String timeContext = gptTimeContext();
+    CountingPrint counter;
+    writeChatRequestBody(counter, stream, timeContext, vision_prompt, image);
+    Serial.printf("[GPT] Request body %u bytes (%u constant), length pass %lu us\n",
+                  (unsigned)counter.count, (unsigned)(toolSchemaBytes() + strlen_P(GPT_SYSTEM_PROMPT)),
+                  micros() - buildStart);
+    if (!image) {
+        uint32_t windowTokens = 0;
+        size_t first = chatRing.windowStart(CHAT_CONTEXT_TOKEN_BUDGET, &windowTokens);
+        Serial.printf("[GPT] Context window: %u of %u messages, ~%u tokens (budget %u)\n",
+                      (unsigned)(chatRing.size() - first), (unsigned)chatRing.size(),
+                      (unsigned)windowTokens, (unsigned)CHAT_CONTEXT_TOKEN_BUDGET);
+    }
+
+    bool sent = lease.valid() && lease.ensureConnected() &&
+                sendChatRequest(lease.client(), counter.count, stream, timeContext, vision_prompt, image);
+    if (!sent && lease.valid() && lease.reused() && lease.reconnect()) {
+        Serial.println("[ApiPool] Stale connection to OpenAI, retried");
+        sent = sendChatRequest(lease.client(), counter.count, stream, timeContext, vision_prompt, image);
+    }
+    if (!sent) {
+        Serial.printf("[GPT] Failed to send request (%u bytes)\n", (unsigned)counter.count);
+        if (lease.valid()) lease.close();
+        return false;
+    }
+    if (image) {
+        Serial.printf("[Vision] Capture to request sent: %lu ms, heap free at send %u\n",
+                      millis() - image->capturedAt, ESP.getFreeHeap());
+    }
+    if (!readHttpResponseHead(lease.client(), head, 20000)) {
+        lease.close();
+        return false;
+    }
+    return true;
+}
+
+GptResponse chatWithGpt(String vision_prompt, const SharedFrame* image) {
+    SpanTimer span(stageLatency[STAGE_CHAT]);
+    setAIState(AI_THINKING);
+    GptResponse response;
+
+    ApiLease lease = apiPool.acquire(chat_host);
+    HttpResponseHead head;
+
+    // Only choices[0].message is used; an error reply keeps just its message
+    StaticJsonDocument<128> filter;
+    JsonObject messageFilter = filter["choices"][0].createNestedObject("message");
+    messageFilter["role"] = true;
+    messageFilter["content"] = true;
+    messageFilter["tool_calls"] = true;
+    filter["error"]["message"] = true;
+    ApiJsonResponse reply(chatParseStats);
+    bool received = false;
+    if (openChatRequest(lease, false, vision_prompt, image, head)) {
+        HttpBodyReader body(lease.client(), head);
+        received = reply.parse(body, filter, 20000);
+        if (!body.complete() || !head.keepAlive) lease.close();
+    } else if (lease.valid()) {
+        lease.close();
+    }
+
+    if (received && head.status == HTTP_CODE_OK) {
+        JsonObject choice = reply.doc()["choices"][0];
         JsonObject message = choice["message"];     
         
         if (message.containsKey("tool_calls")) {
@@ -2595,21 +3943,266 @@ GptResponse chatWithGpt(String vision_prompt, String image) {
         }
     
     } else { 
-        Serial.printf("[HTTP] POST failed, error: %s\n", http.errorToString(httpCode).c_str());
+        Serial.printf("[HTTP] POST failed, status: %d\n", head.status);
         
         response.textToSpeak = "Oops! I'm having trouble connecting right now. Let me try again in a moment.";
-        
-        Serial.println("Failed request body:");
-        Serial.println(requestBody);
-        Serial.println("Failed response body:");
-        Serial.println(http.getString());
+
+        const char* error = reply.doc()["error"]["message"];
+        if (head.status > 0) Serial.printf("Failed response: %s\n", error ? error : reply.error().c_str());
+    }
+
+    return response;
+}
+
+
+
+// ========== STREAMING CHAT (SERVER-SENT EVENTS) ==========
+
+// Text turn of the voice pipeline: streamed and spoken on the fly when enabled
+GptResponse requestChatTurn() {
+#if GPT_STREAMING_RESPONSES
+    return chatWithGptStreaming();
+#else
+    return chatWithGpt();
+#endif
+}
+
+struct StreamedToolCall {
+    String id;
+    String name;
+    String arguments;
+};
+
+// Moves every complete sentence from pending into the speech queue. A sentence ends at
+// '.', '!' or '?' followed by whitespace, so "3.5" or "e.g" mid-token is not split.
+void queueCompleteSentences(String& pending) {
+    while (true) {
+        int cut = -1;
+        for (int i = 0; i + 1 < (int)pending.length(); i++) {
+            char c = pending[i];
+            if ((c == '.' || c == '!' || c == '?') && isspace((unsigned char)pending[i + 1])) {
+                cut = i;
+                break;
+            }
+        }
+        if (cut < 0) return;
+        queueSentence(pending.substring(0, cut + 1));
+        pending = pending.substring(cut + 1);
+    }
+}
+
+// Builds the assistant message stored in history for a streamed tool-call turn
+String buildToolCallMessage(const std::vector<StreamedToolCall>& calls) {
+    JsonDocument doc;
+    doc["role"] = "assistant";
+    doc["content"] = nullptr;
+    JsonArray toolCalls = doc.createNestedArray("tool_calls");
+    for (const auto& call : calls) {
+        JsonObject tc = toolCalls.createNestedObject();
+        tc["id"] = call.id;
+        tc["type"] = "function";
+        tc["function"]["name"] = call.name;
+        tc["function"]["arguments"] = call.arguments;
+    }
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+// Like chatWithGpt(), but with "stream":true. Text deltas are spoken sentence by
+// sentence while the response is still arriving; tool-call deltas are gathered
+// from the same stream. Returns after the last sentence has finished playing.
+GptResponse chatWithGptStreaming() {
+    SpanTimer span(stageLatency[STAGE_CHAT]);
+    setAIState(AI_THINKING);
+    GptResponse response;
+    speechInterrupted = false;
+    firstAudioPending = true;
+    speechRequestStart = millis();
+
+    ApiLease lease = apiPool.acquire(chat_host);
+    HttpResponseHead head;
+    if (!openChatRequest(lease, true, "", nullptr, head) || head.status != HTTP_CODE_OK) {
+        Serial.printf("[HTTP] Streaming POST failed, status: %d\n", head.status);
+        if (lease.valid() && head.status > 0) {
+            StaticJsonDocument<32> errorFilter;
+            errorFilter["error"]["message"] = true;
+            ApiJsonResponse reply(chatParseStats);
+            HttpBodyReader body(lease.client(), head);
+            reply.parse(body, errorFilter, 5000);
+            const char* error = reply.doc()["error"]["message"];
+            Serial.printf("Failed response: %s\n", error ? error : reply.error().c_str());
+        }
+        if (lease.valid()) lease.close();
+        response.textToSpeak = "Oops! I'm having trouble connecting right now. Let me try again in a moment.";
+        return response;
+    }
+
+    // Only choices[0].delta is needed from each event
+    StaticJsonDocument<64> filter;
+    filter["choices"][0]["delta"] = true;
+
+    HttpBodyReader reader(lease.client(), head, speechIdleHook);
+    std::vector<StreamedToolCall> toolCalls;
+    String fullText = "";
+    String pending = "";
+    String line;
+    bool sawDone = false;
+
+    while (!speechInterrupted && reader.readLine(line, millis() + 20000)) {
+        if (!line.startsWith("data:")) continue;  // Blank separators and SSE comments
+        String data = line.substring(5);
+        data.trim();
+        if (data == "[DONE]") {
+            sawDone = true;
+            break;
+        }
+
+        JsonDocument event;
+        if (deserializeJson(event, data, DeserializationOption::Filter(filter)) != DeserializationError::Ok) continue;
+        JsonObject delta = event["choices"][0]["delta"];
+
+        const char* content = delta["content"];
+        if (content != nullptr && content[0] != '\0') {
+            fullText += content;
+            pending += content;
+            queueCompleteSentences(pending);
+        }
+
+        for (JsonObject tc : delta["tool_calls"].as<JsonArray>()) {
+            size_t index = tc["index"] | 0;
+            if (index >= toolCalls.size()) toolCalls.resize(index + 1);
+            if (tc.containsKey("id")) toolCalls[index].id = tc["id"].as<String>();
+            const char* name = tc["function"]["name"];
+            const char* args = tc["function"]["arguments"];
+            if (name) toolCalls[index].name += name;
+            if (args) toolCalls[index].arguments += args;
+        }
+    }
+
+    // Drain the rest of the body (terminating chunk) so the socket can be reused
+    if (sawDone) {
+        unsigned long deadline = millis() + 2000;
+        while (reader.read(deadline) >= 0) {}
+    } else {
+        reader.abandon();
+    }
+    if (!reader.complete() || !head.keepAlive) {
+        lease.close();
+    }
+    lease.release();
+
+    if (speechInterrupted) {
+        Serial.println("✋ Streaming response interrupted");
+        response.textToSpeak = fullText;
+        response.alreadySpoken = true;
+        return response;
+    }
+
+    if (!toolCalls.empty()) {
+        Serial.println("AI requested tool calls.");
+        for (const auto& tc : toolCalls) {
+            response.toolCalls.push_back({tc.name, tc.arguments, tc.id});
+        }
+        response.rawAssistantMessage = buildToolCallMessage(toolCalls);
+        return response;
+    }
+
+    queueSentence(pending);
+    fullText.trim();
+    response.textToSpeak = fullText;
+    response.alreadySpoken = fullText.length() > 0;
+    drainSpeechQueue();
+    return response;
+}
+
+// Multipart framing shared by the buffered and the pipelined Whisper uploads
+const char* whisper_boundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+String whisperPreFileBody(bool flac) {
+    return "--" + String(whisper_boundary) + "\r\n"
+           "Content-Disposition: form-data; name=\"file\"; filename=\"" + String(flac ? "audio.flac" : "audio.wav") + "\"\r\n"
+           "Content-Type: " + String(flac ? "audio/flac" : "audio/wav") + "\r\n\r\n";
+}
+
+// Encodes a whole clip to FLAC in PSRAM. Returns NULL if the buffer cannot be allocated.
+uint8_t* encodeFlacClip(const int16_t* samples, int count, size_t& outLen) {
+    size_t frames = (count + FLAC_BLOCK_SIZE - 1) / FLAC_BLOCK_SIZE;
+    uint8_t* out = (uint8_t*) ps_malloc(FLAC_STREAM_HEADER_BYTES + frames * FLAC_MAX_FRAME_BYTES);
+    if (!out) return NULL;
+    outLen = flacEncoder.writeStreamHeader(out, count);
+    for (int i = 0; i < count; i += FLAC_BLOCK_SIZE) {
+        outLen += flacEncoder.encodeFrame(samples + i, min(FLAC_BLOCK_SIZE, count - i), out + outLen);
+    }
+    return out;
+}
+
+String whisperPostFileBody() {
+    return "\r\n--" + String(whisper_boundary) + "\r\n"
+           "Content-Disposition: form-data; name=\"model\"\r\n\r\n"
+           "whisper-1\r\n"
+           "--" + String(whisper_boundary) + "\r\n"
+           "Content-Disposition: form-data; name=\"language\"\r\n\r\n"
+           "en\r\n"
+           "--" + String(whisper_boundary) + "--\r\n";
+}
+
+bool sendWhisperRequestHeaders(WiFiClient& client, const String& lengthHeader) {
+    String head = "POST " + String(whisper_path) + " HTTP/1.1\r\n"
+                  "Host: " + String(openai_host) + "\r\n"
+                  "Authorization: Bearer " + String(OPENAI_API_KEY) + "\r\n"
+                  "Content-Type: multipart/form-data; boundary=" + String(whisper_boundary) + "\r\n"
+                  "Connection: keep-alive\r\n" +
+                  lengthHeader + "\r\n\r\n";
+    return client.print(head) == head.length();
+}
+
+// Connects (or reuses) the pooled session and sends the request headers.
+// A kept-alive socket the server already closed fails on the first write; retry once on a fresh one.
+bool beginWhisperRequest(ApiLease& lease, const String& lengthHeader) {
+    if (!lease.valid() || !lease.ensureConnected()) return false;
+    if (sendWhisperRequestHeaders(lease.client(), lengthHeader)) return true;
+    if (!lease.reused() || !lease.reconnect()) return false;
+    return sendWhisperRequestHeaders(lease.client(), lengthHeader);
+}
+
+// Waits for the Whisper reply and extracts the "text" field.
+String readWhisperResponse(ApiLease& lease) {
+    WiFiClient& client = lease.client();
+    unsigned long timeout = millis();
+    while (client.connected() && !client.available()) {
+        if (millis() - timeout > 30000UL) {
+            Serial.println("Client timeout!"); lease.close(); return "";
+        }
+        delay(1);
     }
     
-    http.end();
-    return response;
-}
+    HttpResponseHead head;
+    if (!readHttpResponseHead(client, head, 5000)) {
+        Serial.println("No response from Whisper API.");
+        lease.close();
+        return "";
+    }
 
+    StaticJsonDocument<64> filter;
+    filter["text"] = true;
+    filter["error"]["message"] = true;
+    ApiJsonResponse reply(whisperParseStats);
+    HttpBodyReader body(client, head);
+    bool parsed = reply.parse(body, filter, 5000);
+    if (!body.complete() || !head.keepAlive) lease.close();
 
+    String transcription = "";
+    JsonDocument& doc = reply.doc();
+    if (parsed && doc.containsKey("text")) {
+        transcription = doc["text"].as<String>();
+    } else {
+        const char* error = doc["error"]["message"];
+        Serial.printf("Error in Whisper response (status %d): %s\n", head.status,
+                      error ? error : reply.error().c_str());
+    }
+    return transcription;
+}
 
 // Send audio buffer to OpenAI Whisper API for speech-to-text transcription
 // Returns transcribed text or empty string on error
@@ -2621,86 +4214,303 @@ String transcribeWithWhisper(int audio_len, int16_t* audio_data) {
     }
     
     Serial.println("🧠 Transcribing with Whisper...");
-    currentAIState = AI_THINKING;
-    broadcastState(AI_THINKING);
-    updateAnimation();
+    setAIState(AI_THINKING);
+
+    // Content-Length must be known up front, so the clip is encoded completely first
+    size_t flac_len = 0;
+    uint8_t* flac_data = flacReady ? encodeFlacClip(audio_data, audio_len / sizeof(int16_t), flac_len) : NULL;
+    bool flac = (flac_data != NULL);
 
-    String transcription = "";
-    WiFiClientSecure client;
-    client.setInsecure();
-    if (!client.connect(openai_host, 443)) {
-        Serial.println("Connection to OpenAI failed!");
-        return "";
-    }
-    String boundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
     byte header[44];
     createWavHeader(header, audio_len);
-    String pre_file_body = "--" + boundary + "\r\n"
-                                     "Content-Disposition: form-data; name=\"file\"; filename=\"audio.wav\"\r\n"
-                                     "Content-Type: audio/wav\r\n\r\n";
-    String post_file_body = "\r\n--" + boundary + "\r\n"
-                                         "Content-Disposition: form-data; name=\"model\"\r\n\r\n"
-                                         "whisper-1\r\n"
-                                         "--" + boundary + "\r\n"
-                                         "Content-Disposition: form-data; name=\"language\"\r\n\r\n"
-                                         "en\r\n"
-                                         "--" + boundary + "--\r\n";
-    int total_len = pre_file_body.length() + sizeof(header) + audio_len + post_file_body.length();
+    String pre_file_body = whisperPreFileBody(flac);
+    String post_file_body = whisperPostFileBody();
+    const uint8_t* payload = flac ? flac_data : (const uint8_t*)audio_data;
+    int payload_len = flac ? (int)flac_len : audio_len;
+    int total_len = pre_file_body.length() + (flac ? 0 : sizeof(header)) + payload_len + post_file_body.length();
+    if (flac) {
+        Serial.printf("Whisper upload: %d PCM bytes -> %d FLAC bytes\n", audio_len, payload_len);
+    }
     
-    client.println("POST " + String(whisper_endpoint) + " HTTP/1.1");
-    client.println("Host: " + String(openai_host));
-    client.println("Authorization: Bearer " + String(OPENAI_API_KEY));
-    client.println("Content-Type: multipart/form-data; boundary=" + boundary);
-    client.println("Content-Length: " + String(total_len));
-    client.println();
+    ApiLease lease = apiPool.acquire(whisper_host);
+    if (!beginWhisperRequest(lease, "Content-Length: " + String(total_len))) {
+        Serial.println("Connection to OpenAI failed!");
+        free(flac_data);
+        return "";
+    }
+    WiFiClient& client = lease.client();
     client.print(pre_file_body);
-    client.write(header, sizeof(header));
+    if (!flac) client.write(header, sizeof(header));
     int chunk_size = 4096;
-    for (int i = 0; i < audio_len; i += chunk_size) {
-        int size_to_write = min(chunk_size, audio_len - i);
-        client.write((uint8_t*)audio_data + i, size_to_write);  // Use passed-in audio_data pointer
+    for (int i = 0; i < payload_len; i += chunk_size) {
+        int size_to_write = min(chunk_size, payload_len - i);
+        client.write(payload + i, size_to_write);
     }
     client.print(post_file_body);
+    free(flac_data);
+    whisperUpload.bytesSent = (flac ? 0 : sizeof(header)) + payload_len;
     
-    unsigned long timeout = millis();
-    while (client.connected() && !client.available()) {
-        if (millis() - timeout > 30000UL) {
-            Serial.println("Client timeout!"); client.stop(); return "";
+    return readWhisperResponse(lease);
+}
+
+// ========== PIPELINED WHISPER UPLOAD ==========
+// recordAudio() publishes how many samples of audio_buffer are valid; this task
+// trails behind it, sending each full chunk as soon as it is captured. When the
+// finger lifts only the tail of the clip (< one chunk) is left to send.
+
+bool writeHttpChunk(WiFiClient& client, const uint8_t* data, size_t len) {
+    if (len == 0) return true;
+    char sizeLine[12];
+    snprintf(sizeLine, sizeof(sizeLine), "%X\r\n", (unsigned int)len);
+    if (client.print(sizeLine) == 0) return false;
+    if (client.write(data, len) != len) return false;
+    return client.print("\r\n") == 2;
+}
+
+// True once the stream of this turn was aborted or given up on
+bool whisperStreamDisowned(uint32_t turn) {
+    return whisperUpload.turn.load(std::memory_order_acquire) != turn;
+}
+
+// Runs the whole streamed request for result.turn. Kept separate from the task body so
+// that locals are destroyed before vTaskDelete() (which never returns).
+void runWhisperUpload(WhisperStreamResult& result) {
+    ApiLease lease = apiPool.acquire(whisper_host);
+
+    if (!beginWhisperRequest(lease, "Transfer-Encoding: chunked")) {
+        Serial.println("Whisper stream: connection failed, will fall back to buffered upload");
+        result.failed = true;
+    } else {
+        WiFiClient& client = lease.client();
+
+        // Length of the clip is unknown up front: FLAC leaves the sample count as 0 ("unknown"),
+        // WAV uses the streaming convention of 0xFFFFFFFF sizes
+        bool flac = flacReady;
+        byte header[FLAC_STREAM_HEADER_BYTES > 44 ? FLAC_STREAM_HEADER_BYTES : 44];
+        size_t header_len = sizeof(header);
+        if (flac) {
+            header_len = flacEncoder.writeStreamHeader(header, 0);
+        } else {
+            createWavHeader(header, 0);
+            header_len = 44;
+            header[4] = header[5] = header[6] = header[7] = 0xFF;
+            header[40] = header[41] = header[42] = header[43] = 0xFF;
+        }
+        String pre_file_body = whisperPreFileBody(flac);
+        bool ok = writeHttpChunk(client, (const uint8_t*)pre_file_body.c_str(), pre_file_body.length()) &&
+                  writeHttpChunk(client, header, header_len);
+        result.bytesSent = header_len;
+
+        // One FLAC frame per chunk; frames are only cut short at the end of the clip
+        const int chunkSamples = flac ? FLAC_BLOCK_SIZE : WHISPER_STREAM_CHUNK_BYTES / sizeof(int16_t);
+        while (ok && !whisperStreamDisowned(result.turn)) {
+            bool done = whisperUpload.captureDone.load(std::memory_order_acquire);
+            int captured = whisperUpload.samplesCaptured.load(std::memory_order_acquire);
+            int pending = captured - result.samplesSent;
+
+            if (pending >= chunkSamples || (done && pending > 0)) {
+                int toSend = min(pending, chunkSamples);
+                const int16_t* samples = audio_buffer + result.samplesSent;
+                size_t len;
+                if (flac) {
+                    len = flacEncoder.encodeFrame(samples, toSend, flacFrameBuffer);
+                    ok = writeHttpChunk(client, flacFrameBuffer, len);
+                } else {
+                    len = toSend * sizeof(int16_t);
+                    ok = writeHttpChunk(client, (const uint8_t*)samples, len);
+                }
+                if (ok) {
+                    result.samplesSent += toSend;
+                    result.bytesSent += len;
+                }
+            } else if (done) {
+                break;
+            } else {
+                vTaskDelay(5 / portTICK_PERIOD_MS);
+            }
+        }
+
+        bool disowned = whisperStreamDisowned(result.turn);
+        if (ok && !disowned) {
+            String post_file_body = whisperPostFileBody();
+            ok = writeHttpChunk(client, (const uint8_t*)post_file_body.c_str(), post_file_body.length()) &&
+                 client.print("0\r\n\r\n") == 5;
         }
-        delay(1); updateAnimation();
-    }
-    
-    String response = "";
-    bool headersEnded = false;
-    while(client.available()){
-        String line = client.readStringUntil('\n');
-        if (!headersEnded) { if (line == "\r") headersEnded = true; } 
-        else { response += line; }
-    }
-    client.stop();
 
-    if (response.length() > 0) {
-        JsonDocument doc;
-        deserializeJson(doc, response);
-        if (doc.containsKey("text")) {
-            transcription = doc["text"].as<String>();
+        if (!ok) {
+            Serial.println("Whisper stream: upload interrupted, will fall back to buffered upload");
+            result.failed = true;
+            lease.close();
+        } else if (disowned) {
+            lease.close();  // Request body is incomplete, the socket cannot be reused
         } else {
-             Serial.println("Error in Whisper response: " + response);
+            result.transcript = readWhisperResponse(lease);
         }
-    } else {
-        Serial.println("No response from Whisper API.");
     }
-    return transcription;
 }
 
-// Speak the default introduction stored in flash memory
-// This is guaranteed to work even if all APIs fail
+void whisperUploadTask(void* param) {
+    WhisperStreamResult* result = new WhisperStreamResult();
+    result->turn = (uint32_t)(uintptr_t)param;
+    runWhisperUpload(*result);
+    if (xQueueSend(whisperUpload.results, &result, 0) != pdTRUE) delete result;
+    whisperUpload.taskRunning.store(false, std::memory_order_release);
+    vTaskDelete(NULL);
+}
+
+// Waits for the result of the given turn, dropping results of disowned turns on the way.
+// nullptr on timeout; the caller owns the result.
+WhisperStreamResult* takeWhisperResult(uint32_t turn, uint32_t timeoutMs) {
+    unsigned long start = millis();
+    WhisperStreamResult* result = nullptr;
+    for (;;) {
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= timeoutMs) return nullptr;
+        if (xQueueReceive(whisperUpload.results, &result, pdMS_TO_TICKS(timeoutMs - elapsed)) != pdTRUE) return nullptr;
+        if (result->turn == turn) return result;
+        delete result;
+    }
+}
+
+// Called when the long-press starts. The TLS handshake runs on core 0 while recording continues.
+// A task left over from a disowned stream shares the encoder and the audio buffer, so no
+// new stream starts until it is gone; that turn uses the buffered upload instead.
+bool startWhisperStream() {
+#if WHISPER_STREAMING_UPLOAD
+    if (whisperUpload.results == nullptr) {
+        whisperUpload.results = xQueueCreate(2, sizeof(WhisperStreamResult*));
+    }
+    if (whisperUpload.taskRunning.load(std::memory_order_acquire)) {
+        Serial.println("Whisper stream: previous upload still closing, using buffered upload");
+        return false;
+    }
+    WhisperStreamResult* stale;
+    while (xQueueReceive(whisperUpload.results, &stale, 0) == pdTRUE) delete stale;
+
+    uint32_t turn = whisperUpload.turn.fetch_add(1) + 1;
+    whisperUpload.samplesCaptured = 0;
+    whisperUpload.captureDone = false;
+    whisperUpload.samplesSent = 0;
+    whisperUpload.bytesSent = 0;
+    whisperUpload.taskRunning = true;
+
+    BaseType_t created = xTaskCreatePinnedToCore(
+        whisperUploadTask,
+        "WhisperUpload",
+        12288,                      // TLS needs a generous stack
+        (void*)(uintptr_t)turn,
+        2,
+        &whisperUpload.taskHandle,
+        0                           // Core 0, next to the WiFi stack
+    );
+    if (created != pdPASS) whisperUpload.taskRunning = false;
+    whisperUpload.active = (created == pdPASS);
+    return whisperUpload.active;
+#else
+    return false;
+#endif
+}
+
+// Disowns the stream without waiting: the task closes its socket on its own
+void abortWhisperStream() {
+    if (!whisperUpload.active) return;
+    whisperUpload.turn.fetch_add(1);
+    whisperUpload.captureDone.store(true, std::memory_order_release);
+    whisperUpload.active = false;
+}
+
+// Called after the finger lifts. Returns the transcript, falling back to the
+// buffered upload if the stream could not be opened or broke mid-way.
+String finishWhisperStream(int samples_recorded) {
+    Serial.println("🧠 Transcribing with Whisper (streamed)...");
+    uint32_t turn = whisperUpload.turn.load();
+    whisperUpload.samplesCaptured.store(samples_recorded, std::memory_order_release);
+    whisperUpload.captureDone.store(true, std::memory_order_release);
+
+    WhisperStreamResult* result = takeWhisperResult(turn, 35000);
+    whisperUpload.active = false;
+    if (!result) {
+        Serial.println("Whisper stream: timeout");
+        whisperUpload.turn.fetch_add(1);   // A late transcript must not answer the next turn
+        return "";
+    }
+    whisperUpload.samplesSent = result->samplesSent;
+    whisperUpload.bytesSent = result->bytesSent;
+    bool failed = result->failed;
+    String transcript = result->transcript;
+    delete result;
+
+    if (failed) {
+        return transcribeWithWhisper(samples_recorded * sizeof(int16_t));
+    }
+    Serial.printf("Whisper stream: %d samples sent as %u bytes (%s)\n", whisperUpload.samplesSent,
+                  (unsigned)whisperUpload.bytesSent, flacReady ? "FLAC" : "WAV");
+    return transcript;
+}
+
+// Renders ALARM_RTTTL into ALARM_WAV_PATH, unless a render of the same melody, rate and
+// amplitude is already there. The key file is written only after a complete render, so a
+// render cut short by a reset is redone.
+bool renderAlarmWav() {
+    RtttlNote notes[ALARM_MAX_NOTES];
+    int count = rtttlParse(ALARM_RTTTL, notes, ALARM_MAX_NOTES);
+    if (count <= 0) {
+        Serial.println("❌ Alarm melody could not be parsed");
+        return false;
+    }
+    uint32_t dataBytes = ToneSynth::totalSamples(notes, count, ALARM_SAMPLE_RATE) * sizeof(int16_t);
+    String settings = String(ALARM_RTTTL) + "|" + String(ALARM_SAMPLE_RATE) + "|" + String(ALARM_AMPLITUDE);
+    uint32_t key = fnv1aHash(settings.c_str());
+    File existing = SPIFFS.open(ALARM_WAV_PATH, FILE_READ);
+    File savedKey = SPIFFS.open(ALARM_WAV_KEY_PATH, FILE_READ);
+    uint32_t saved = 0;
+    bool same = existing && savedKey && existing.size() == TONE_WAV_HEADER_BYTES + dataBytes &&
+                savedKey.read((uint8_t*)&saved, sizeof(saved)) == sizeof(saved) && saved == key;
+    if (existing) existing.close();
+    if (savedKey) savedKey.close();
+    if (same) return true;
+
+    unsigned long start = millis();
+    SPIFFS.remove(ALARM_WAV_KEY_PATH);
+    File file = SPIFFS.open(ALARM_WAV_PATH, FILE_WRITE);
+    if (!file) return false;
+    uint8_t header[TONE_WAV_HEADER_BYTES];
+    toneWavHeader(header, ALARM_SAMPLE_RATE, dataBytes);
+    size_t written = file.write(header, sizeof(header));
+    int16_t* block = (int16_t*) malloc(ALARM_RENDER_SAMPLES * sizeof(int16_t));
+    ToneSynth synth;
+    synth.begin(notes, count, ALARM_SAMPLE_RATE, ALARM_AMPLITUDE);
+    size_t n;
+    while (block && (n = synth.render(block, ALARM_RENDER_SAMPLES)) > 0) {
+        written += file.write((const uint8_t*)block, n * sizeof(int16_t));
+    }
+    free(block);
+    file.close();
+    if (written != TONE_WAV_HEADER_BYTES + dataBytes) {
+        SPIFFS.remove(ALARM_WAV_PATH);
+        Serial.println("❌ Alarm tone render failed");
+        return false;
+    }
+    File keyFile = SPIFFS.open(ALARM_WAV_KEY_PATH, FILE_WRITE);
+    if (keyFile) {
+        keyFile.write((const uint8_t*)&key, sizeof(key));
+        keyFile.close();
+    }
+    Serial.printf("🔔 Alarm tone rendered: %d notes, %u bytes in %lu ms\n", count, (unsigned)written, millis() - start);
+    return true;
+}
+
+// Audio task only. Plays the rendered melody from flash; the old online sound
+// is only a fallback for when the render failed.
 void playAlarmTone() {
     audio.setVolume(21);
-    // Use connecttohost to stream the alarm audio and set it to loop
+    if (alarmWavReady && audio.connecttoFS(SPIFFS, ALARM_WAV_PATH)) return;
     audio.connecttohost("https://assets.mixkit.co/active_storage/sfx/2869/2869-preview.mp3");
 }
 
+// Speak the default introduction stored in flash memory
+// This is guaranteed to work even if all APIs fail
+
 void speakDefaultIntroduction() {
     // Read the default introduction from flash memory (PROGMEM)
     char introBuffer[256];
@@ -2710,78 +4520,374 @@ void speakDefaultIntroduction() {
     speakText(intro);
 }
 
+// ========== SENTENCE SPEECH QUEUE ==========
+// Sentences are handed to the audio task as soon as they are known (the streaming chat
+// path queues them while later tokens are still in flight). The pipeline then waits for
+// the audio task to report them played, and stops playback if the pad is touched.
+
+// Strips markdown emphasis and whitespace; the result is also what the speech cache is keyed on
+String speechSentence(String sentence) {
+    sentence.replace("**", "");
+    sentence.replace("*", "");
+    sentence.trim();
+    return sentence;
+}
+
+// Splits text after every '.', '!' and '?' into cleaned up, non-empty sentences
+std::vector<String> splitSentences(const String& text) {
+    std::vector<String> sentences;
+    int last_index = 0;
+    for (int i = 0; i <= (int)text.length(); i++) {
+        if (i == (int)text.length() || text[i] == '.' || text[i] == '!' || text[i] == '?') {
+            String sentence = speechSentence(text.substring(last_index, i + 1));
+            if (sentence.length() > 0) sentences.push_back(sentence);
+            last_index = i + 1;
+        }
+    }
+    return sentences;
+}
+
+void queueSentence(String sentence) {
+    sentence = speechSentence(sentence);
+    if (sentence.length() == 0 || speechInterrupted) return;
+    speechSubmitted++;
+    sendAudioCommand(AUDIO_SPEAK, new String(sentence));
+}
+
+// Drops everything queued and stops what is playing
+void interruptSpeech() {
+    if (speechInterrupted) return;
+    Serial.println("✋ Speak interrupted by touch!");
+    speechInterrupted = true;
+    sendAudioCommand(AUDIO_STOP);
+}
+
+// Waits up to `wait` for pipeline events while speech is pending. A touch (once the
+// intro is done) interrupts; touch events are deferred so loop() still sees them.
+void pollSpeechEvents(TickType_t wait) {
+    KikoEvent ev;
+    while (receivePipelineEvent(ev, wait)) {
+        wait = 0;
+        if (ev.type == EV_SENTENCE_DONE) continue;
+        if (ev.type == EV_TOUCH_DOWN && introSpoken) {
+            noteTouchLatency(ev);
+            interruptSpeech();
+        }
+        deferPipelineEvent(ev);
+    }
+}
+
+// Runs while the streaming reader waits for bytes
+void speechIdleHook() {
+    pollSpeechEvents(1);
+}
+
+// Blocks until every queued sentence has been played (or dropped after an interruption)
+void drainSpeechQueue() {
+    unsigned long lastProgress = millis();
+    uint32_t completed = speechCompleted.load(std::memory_order_acquire);
+    while ((int32_t)(speechSubmitted - completed) > 0) {
+        pollSpeechEvents(pdMS_TO_TICKS(100));
+        uint32_t now = speechCompleted.load(std::memory_order_acquire);
+        if (now != completed) {
+            completed = now;
+            lastProgress = millis();
+        } else if (millis() - lastProgress > SPEECH_STALL_MS) {
+            Serial.println("Speech queue stalled, giving up");
+            sendAudioCommand(AUDIO_STOP);
+            break;
+        }
+    }
+}
+
+// Speaks text sentence by sentence and returns when it has been played. Afterwards the
+// state is what it was before, or idle if a touch cut the speech short.
 void speakText(String text) {
     Serial.println("📢 Speaking...");
-    AIState previousState = currentAIState;
-    currentAIState = AI_SPEAKING;
-    broadcastState(AI_SPEAKING);
-    speaking_frame_index = 0;
-    audio.setVolume(21);
-    
-    time_t currentTime = time(nullptr);
-    if (currentTime < 24 * 3600) {
-        // ... (existing NTP sync wait code) ...
+    AIState previousState = aiState();
+    speechInterrupted = false;
+
+    for (const String& sentence : splitSentences(text)) queueSentence(sentence);
+    drainSpeechQueue();
+
+    if (aiState() == AI_ALARMING) return;
+    setAIState(speechInterrupted ? AI_IDLE : previousState);
+}
+
+// ========== SPEECH CLIP CACHE ==========
+// Clips live in /tts/<key>.mp3 next to a small index file. ttsCacheLock guards the
+// index and the clip files: the audio task takes it for lookups, the TtsCache task
+// while it adds or evicts clips (never during a download).
+
+String ttsClipPath(uint32_t key) {
+    char path[24];
+    snprintf(path, sizeof(path), TTS_CACHE_DIR "/%08x.mp3", (unsigned)key);
+    return String(path);
+}
+
+void ttsRemoveClip(uint32_t key) {
+    SPIFFS.remove(ttsClipPath(key));
+}
+
+// Caller holds ttsCacheLock
+void ttsSaveIndex() {
+    uint8_t* blob = (uint8_t*) malloc(ttsCache.serializedSize());
+    if (!blob) return;
+    size_t len = ttsCache.serialize(blob);
+    File file = SPIFFS.open(TTS_CACHE_INDEX_PATH, FILE_WRITE);
+    if (file) {
+        file.write(blob, len);
+        file.close();
+        ttsIndexDirty = false;
     }
-    
-    int last_index = 0;
-    for (int i = 0; i <= text.length(); i++) {
-        if (introSpoken) {
-            if (touchRead(BUTTON_PIN) > TOUCH_THRESHOLD) {
-                Serial.println("✋ Speak interrupted by touch!");
-                audio.stopSong(); 
-                currentAIState = AI_IDLE;
-                broadcastState(AI_IDLE);
-                return; // Exit the entire speaking function
-            }
+    free(blob);
+}
+
+// Restores the index, then drops entries whose clip is missing and clips nothing indexes
+void ttsLoadIndex() {
+    File file = SPIFFS.open(TTS_CACHE_INDEX_PATH, FILE_READ);
+    if (file) {
+        size_t len = file.size();
+        uint8_t* blob = (uint8_t*) malloc(len);
+        if (blob && file.read(blob, len) == len) ttsCache.deserialize(blob, len);
+        free(blob);
+        file.close();
+    }
+    for (int i = ttsCache.count() - 1; i >= 0; i--) {
+        const TtsCacheEntry& e = ttsCache.entry(i);
+        File clip = SPIFFS.open(ttsClipPath(e.key), FILE_READ);
+        bool valid = clip && clip.size() == e.bytes;
+        if (clip) clip.close();
+        if (!valid) ttsCache.remove(e.key);
+    }
+    File dir = SPIFFS.open(TTS_CACHE_DIR);
+    std::vector<String> orphans;
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        String path = f.path();
+        f.close();
+        if (path == TTS_CACHE_INDEX_PATH) continue;
+        uint32_t key = strtoul(path.c_str() + strlen(TTS_CACHE_DIR "/"), nullptr, 16);
+        if (!path.endsWith(".mp3") || !ttsCache.contains(key)) orphans.push_back(path);
+    }
+    for (const String& path : orphans) SPIFFS.remove(path);
+    ttsSaveIndex();
+    Serial.printf("🗂️ Speech cache: %d clips, %u bytes\n", ttsCache.count(), (unsigned)ttsCache.usedBytes());
+}
+
+// Audio task: fills path and returns true if the sentence can be played from flash.
+// A sentence that misses twice is queued for download.
+bool ttsCacheLookup(const String& sentence, uint32_t& key, String& path) {
+    key = ttsCacheKey(TTS_LANGUAGE, sentence.c_str());
+    xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+    bool hit = ttsCache.lookup(key);
+    bool fetch = !hit && ttsCache.noteMiss(key) && sentence.length() <= TTS_CACHE_MAX_TEXT;
+    if (hit) ttsIndexDirty = true;
+    xSemaphoreGive(ttsCacheLock);
+    if (hit) {
+        path = ttsClipPath(key);
+    } else if (fetch && ttsFetchQueue) {
+        String* copy = new String(sentence);
+        if (xQueueSend(ttsFetchQueue, &copy, 0) != pdTRUE) delete copy;
+    }
+    return hit;
+}
+
+// Audio task: a clip that fails to play is dropped so the next miss downloads it again
+void ttsCacheDrop(uint32_t key) {
+    xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+    ttsCache.remove(key);
+    ttsRemoveClip(key);
+    ttsSaveIndex();
+    xSemaphoreGive(ttsCacheLock);
+}
+
+String urlEncode(const String& text) {
+    static const char hex[] = "0123456789ABCDEF";
+    String out;
+    out.reserve(text.length() * 3);
+    for (size_t i = 0; i < text.length(); i++) {
+        uint8_t c = text[i];
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out += (char)c;
+        } else {
+            out += '%';
+            out += hex[c >> 4];
+            out += hex[c & 0x0F];
         }
+    }
+    return out;
+}
 
-        if (currentAIState == AI_ALARMING) {
-            return;
+// Downloads one sentence from the same endpoint connecttospeech() streams from
+bool ttsFetchClip(const String& sentence) {
+    uint32_t key = ttsCacheKey(TTS_LANGUAGE, sentence.c_str());
+    xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+    bool cached = ttsCache.contains(key);
+    xSemaphoreGive(ttsCacheLock);
+    if (cached || sentence.length() > TTS_CACHE_MAX_TEXT) return cached;
+    SpanTimer span(stageLatency[STAGE_TTS_FETCH]);
+    if (SPIFFS.totalBytes() - SPIFFS.usedBytes() < TTS_CACHE_MIN_FREE_BYTES) return false;
+
+    String url = "https://" + String(tts_host) + "/translate_tts?ie=UTF-8&tl=" TTS_LANGUAGE "&client=tw-ob&q=" +
+                 urlEncode(sentence);
+    ApiLease lease = apiPool.acquire(tts_host);
+    HTTPClient http;
+    int httpCode = sendPooledRequest(http, lease, url, "GET", "");
+    int written = -1;
+    if (httpCode == HTTP_CODE_OK) {
+        File file = SPIFFS.open(TTS_CACHE_TMP_PATH, FILE_WRITE);
+        if (file) {
+            written = http.writeToStream(&file);
+            file.close();
         }
-        
-        if (i == text.length() || text[i] == '.' || text[i] == '!' || text[i] == '?') {
-            String sentence = text.substring(last_index, i + 1);
-            sentence.trim();
-            if (sentence.length() > 0) {
-                audio.connecttospeech(sentence.c_str(), "en");
-                
-                unsigned long speech_timeout = millis();
-                bool was_running = false;
-                
-                while ((millis() - speech_timeout < 30000)) { 
-                    if (introSpoken) {
-                        if (touchRead(BUTTON_PIN) > TOUCH_THRESHOLD) {
-                            audio.stopSong();
-                            currentAIState = AI_IDLE;
-                            broadcastState(AI_IDLE);
-                            return; 
-                        }
-                    }
-
-                    if (currentAIState == AI_ALARMING) {
-                        audio.stopSong();
-                        return;
-                    }
-                    
-                    server.handleClient(); 
-                    webSocket.loop();
-                    audio.loop(); 
-                    updateAnimation(); 
-                    yield();
-                    
-                    if (audio.isRunning()) {
-                        was_running = true;
-                    } else if (was_running) {
-                        delayMicroseconds(100000); 
-                        break;
-                    }
+    } else {
+        Serial.printf("[TTS cache] GET failed: %s\n", http.errorToString(httpCode).c_str());
+    }
+    http.end();
+
+    bool stored = false;
+    if (written > 0) {
+        xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+        if (ttsCache.insert(key, written, ttsRemoveClip)) {
+            String path = ttsClipPath(key);
+            SPIFFS.remove(path);
+            stored = SPIFFS.rename(TTS_CACHE_TMP_PATH, path);
+            if (!stored) ttsCache.remove(key);
+            ttsSaveIndex();
+        }
+        xSemaphoreGive(ttsCacheLock);
+    }
+    if (!stored) {
+        SPIFFS.remove(TTS_CACHE_TMP_PATH);
+        ttsFetchFailures++;
+    }
+    return stored;
+}
+
+// Fills the cache with the fixed phrases, then downloads sentences the audio task asks for.
+// Runs on core 0 at low priority so downloads never hold up playback or the pipeline.
+void ttsCacheTask(void* param) {
+    xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+    ttsLoadIndex();
+    xSemaphoreGive(ttsCacheLock);
+
+    // TLS needs a valid clock
+    while (time(nullptr) < 24 * 3600) vTaskDelay(pdMS_TO_TICKS(500));
+    int fetched = 0;
+    for (const char* phrase : TTS_PRELOAD_PHRASES) {
+        for (const String& sentence : splitSentences(String(phrase))) {
+            if (ttsFetchClip(sentence)) fetched++;
+        }
+    }
+    Serial.printf("🗂️ Speech cache: %d preloaded sentences ready\n", fetched);
+
+    unsigned long lastSave = millis();
+    for (;;) {
+        String* sentence;
+        if (xQueueReceive(ttsFetchQueue, &sentence, pdMS_TO_TICKS(TTS_INDEX_SAVE_MS)) == pdTRUE) {
+            ttsFetchClip(*sentence);
+            delete sentence;
+        }
+        if (millis() - lastSave >= TTS_INDEX_SAVE_MS) {
+            lastSave = millis();
+            xSemaphoreTake(ttsCacheLock, portMAX_DELAY);
+            if (ttsIndexDirty) ttsSaveIndex();
+            xSemaphoreGive(ttsCacheLock);
+        }
+    }
+}
+
+void startTtsCacheTask() {
+    if (SPIFFS.totalBytes() == 0) {
+        Serial.println("⚠️  SPIFFS not mounted, speech cache disabled");
+        return;
+    }
+    xTaskCreatePinnedToCore(ttsCacheTask, "TtsCache", 12288, NULL, 1, &ttsCacheTaskHandle, 0);
+}
+
+// ========== AUDIO PLAYBACK TASK ==========
+// The only code that touches `audio`. Queued sentences are played back to back, from
+// the speech cache when possible;
+// AUDIO_ALARM replaces them with the alarm tone, looped until AUDIO_STOP.
+
+void finishSentences(uint32_t count) {
+    if (count == 0) return;
+    uint32_t done = speechCompleted.fetch_add(count, std::memory_order_acq_rel) + count;
+    eventBus.publish(EV_SENTENCE_DONE, done);
+}
+
+void audioTask(void *param) {
+    std::deque<String*> sentences;
+    bool speaking = false;       // A sentence was started and has not finished yet
+    bool alarmLooping = false;
+    unsigned long sentenceStart = 0;
+    for (;;) {
+        // Sleep while there is nothing to play; otherwise just check for new commands
+        bool busy = speaking || alarmLooping || !sentences.empty();
+        TickType_t wait = busy ? 0 : pdMS_TO_TICKS(20);
+        AudioCommand cmd;
+        while (xQueueReceive(audioCommands, &cmd, wait) == pdTRUE) {
+            wait = 0;
+            if (cmd.op == AUDIO_SPEAK) {
+                sentences.push_back(cmd.text);
+                continue;
+            }
+            uint32_t dropped = sentences.size() + (speaking ? 1 : 0);
+            for (String* s : sentences) delete s;
+            sentences.clear();
+            audio.stopSong();
+            speaking = false;
+            finishSentences(dropped);
+            alarmLooping = (cmd.op == AUDIO_ALARM);
+            if (alarmLooping) playAlarmTone();
+        }
+
+        audio.loop();
+
+        if (!audio.isRunning()) {
+            if (speaking) {
+                speaking = false;
+                stageLatency[STAGE_SENTENCE].record(millis() - sentenceStart);
+                finishSentences(1);
+            }
+            if (alarmLooping) {
+                // Audio finished playing, restart it for continuous alarm
+                Serial.println("🔊 ALARM - restarting audio...");
+                playAlarmTone();
+            } else if (!sentences.empty()) {
+                String* sentence = sentences.front();
+                sentences.pop_front();
+                if (aiState() != AI_SPEAKING) {
+                    setAIState(AI_SPEAKING);
+                    speaking_frame_index = 0;
+                }
+                audio.setVolume(21);
+                sentenceStart = millis();
+                uint32_t key;
+                String clip;
+                if (ttsCacheLookup(*sentence, key, clip)) {
+                    speaking = audio.connecttoFS(SPIFFS, clip.c_str());
+                    if (!speaking) ttsCacheDrop(key);
+                }
+                if (!speaking) speaking = audio.connecttospeech(sentence->c_str(), TTS_LANGUAGE);
+                stageLatency[STAGE_TTS_CONNECT].record(millis() - sentenceStart);
+                delete sentence;
+                if (!speaking) {
+                    finishSentences(1);
+                } else if (firstAudioPending.exchange(false)) {
+                    lastTimeToFirstAudioMs = millis() - speechRequestStart;
+                    Serial.printf("⏱️ Time to first audio: %lu ms\n", lastTimeToFirstAudioMs);
                 }
             }
-            last_index = i + 1;
         }
+        vTaskDelay(1);
     }
-    currentAIState = previousState;
-    broadcastState(previousState);
+}
+
+void startAudioTask() {
+    // Core 1, above the pipeline: the decoder must be fed every few milliseconds.
+    // connecttospeech() does its own TLS handshake, hence the stack size.
+    xTaskCreatePinnedToCore(audioTask, "Audio", 12288, NULL, 3, &audioTaskHandle, 1);
 }
 
 String handleTimeDateRequest() {
@@ -2797,17 +4903,27 @@ String handleTimeDateRequest() {
 }
 
 String handleWeatherRequest(String city) {
-    city.replace(" ", "%20");
-    String path = String(weather_endpoint) + "?q=" + city + "&appid=" + String(OPENWEATHER_API_KEY) + "&units=metric";
-    String fullUrl = "https://" + String(weather_host) + path;
+    return cachedToolResult("get_weather", normalizeToolArg(city), WEATHER_CACHE_TTL_S, WEATHER_CACHE_STALE_S,
+                            fetchWeather);
+}
+
+bool fetchWeather(const String& city, String& weatherReport) {
+    ApiLease lease = apiPool.acquire(weather_host);
+    String path = String(weather_endpoint) + "?q=" + urlEncode(city) + "&appid=" + String(OPENWEATHER_API_KEY) + "&units=metric";
+    String fullUrl = lease.baseUrl() + path;
     HTTPClient http;
-    http.begin(fullUrl);
-    int httpCode = http.GET();
-    String weatherReport = "";
+    http.setTimeout(TOOL_HTTP_TIMEOUT_MS);
+    int httpCode = sendPooledRequest(http, lease, fullUrl, "GET", "");
+    bool ok = httpCode == HTTP_CODE_OK;
     
-    if (httpCode == HTTP_CODE_OK) {
-        JsonDocument doc;
-        deserializeJson(doc, http.getString());
+    if (ok) {
+        StaticJsonDocument<128> filter;
+        filter["weather"][0]["description"] = true;
+        filter["main"]["temp"] = true;
+        filter["name"] = true;
+        ApiJsonResponse response(weatherParseStats);
+        parsePooledJson(http, lease, httpCode, filter, response);
+        JsonDocument& doc = response.doc();
         if (doc.containsKey("weather")) {
             String description = doc["weather"][0]["description"];
             float temp = doc["main"]["temp"];
@@ -2822,7 +4938,7 @@ String handleWeatherRequest(String city) {
         weatherReport = "Sorry, I could not get the weather information.";
     }
     http.end();
-    return weatherReport;
+    return ok;
 }
 
 void createWavHeader(byte* header, int wavDataSize) {
@@ -2844,7 +4960,7 @@ void createWavHeader(byte* header, int wavDataSize) {
     header[40] = (byte)(wavDataSize & 0xFF); header[41] = (byte)((wavDataSize >> 8) & 0xFF); header[42] = (byte)((wavDataSize >> 16) & 0xFF); header[43] = (byte)((wavDataSize >> 24) & 0xFF);
 }
 
-void drawEye(int centerX, int centerY, int w, int h, float px, float py) {
+void drawEye(int centerX, int centerY, int w, int h, int px, int py) {
   int topLeftX = centerX - w / 2;
   int topLeftY = centerY - h / 2;
   u8g2.drawRBox(topLeftX, topLeftY, w, h, 6);
@@ -2860,7 +4976,7 @@ void drawBlink(int centerX, int centerY, int w) {
   u8g2.drawBox(topLeftX, centerY - 2, w, 4);
 }
 
-void drawEyebrow(int centerX, int browY, int w, float offset) {
+void drawEyebrow(int centerX, int browY, int w, int offset) {
   int topLeftX = centerX - w / 2;
   int browWidth = w - 4;
   u8g2.drawLine(topLeftX, browY + 2 + offset, topLeftX + browWidth / 2, browY + offset);
@@ -2886,181 +5002,286 @@ void showLoadingScreen(String status) {
 }
 
 // ========== DISPLAY & ANIMATION ENGINE ==========
-// OLED rendering: eyes, status, network info, and state-based visuals
+// OLED rendering: eyes, status, network info, and state-based visuals.
+// Runs on its own task at DISPLAY_FPS; only tiles that changed are sent over I2C.
+
+// Sends dirty tiles from the U8g2 buffer (which is the frame being flushed)
+class U8g2Sink : public DisplaySink {
+ public:
+  void pushTiles(uint8_t tx, uint8_t ty, uint8_t tw, const uint8_t*) override {
+    u8g2.updateDisplayArea(tx, ty, tw, 1);
+  }
+};
+U8g2Sink oledSink;
 
-void updateAnimation() {
+// Wakes the display task so a state change shows up without waiting for the next frame
+void displayNotify() {
+    if (displayTaskHandle) xTaskNotifyGive(displayTaskHandle);
+}
+
+// Shows text over every scene until called with nullptr
+void displayShowMessage(const char* text, int progress) {
+    displayProgress = progress;
+    displayMessage = text;
+    displayNotify();
+}
+
+void displayShowNetworkInfo() {
+    networkInfoStartTime = millis();
+    showNetworkInfo = true;
+    displayNotify();
+}
+
+// Decodes a compressed sprite straight into the U8g2 tile buffer (y must be a multiple of 8)
+void drawSprite(const SpriteSet& sprite, uint8_t frame, int x, int y) {
+    unsigned long t0 = micros();
+    spriteDraw(u8g2.getBufferPtr(), OLED_ROW_BYTES, OLED_TILE_ROWS, sprite, frame, x, y / 8);
+    spriteDecodeMicros += micros() - t0;
+    spriteDecodes++;
+}
+
+// Eases pupils and brows toward their targets (rates are /256 per frame); new gaze every 1-2.5 s
+void tweenEyes(unsigned long now, int32_t pupilRate, int32_t browRate, q8_t horRange, q8_t verRange) {
+    if ((long)(now - nextMoveTime) >= 0) {
+        q8Direction(random(16), horRange, verRange, targetPupilX, targetPupilY);
+        nextMoveTime = now + random(1000, 2500);
+    }
+    pupilX = tweenQ8(pupilX, targetPupilX, pupilRate);
+    pupilY = tweenQ8(pupilY, targetPupilY, pupilRate);
+    browOffsetLeft = tweenQ8(browOffsetLeft, targetBrowOffset, browRate);
+    browOffsetRight = tweenQ8(browOffsetRight, targetBrowOffset, browRate);
+}
+
+void drawEyes(bool blink) {
+    int px = q8ToInt(pupilX), py = q8ToInt(pupilY);
+    if (blink) {
+        drawBlink(leftEyeX, eyeY, eyeWidth);
+        drawBlink(rightEyeX, eyeY, eyeWidth);
+    } else {
+        drawEye(leftEyeX, eyeY, eyeWidth, eyeHeight, px, py);
+        drawEye(rightEyeX, eyeY, eyeWidth, eyeHeight, px, py);
+    }
+    drawEyebrow(leftEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, q8ToInt(browOffsetLeft));
+    drawEyebrow(rightEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, q8ToInt(browOffsetRight));
+}
+
+// Draws the current scene into the U8g2 buffer (no bus traffic) and reports which one it was
+DisplayScene renderDisplayScene(unsigned long now) {
     u8g2.clearBuffer();
-    
-    setLedState(currentAIState);
-    unsigned long now = millis(); 
-    
+    AIState state = aiState();
+
+    const char* message = displayMessage;
+    if (message) {
+        u8g2.setFont(u8g2_font_ncenB10_tr);
+        u8g2.drawStr(20, 35, message);
+        int progress = displayProgress;
+        if (progress >= 0) {
+            u8g2.drawFrame(10, 50, 108, 10);
+            u8g2.drawBox(12, 52, (104 * progress) / 100, 6);
+        }
+        return SCENE_MESSAGE;
+    }
+
     // Display surveillance mode with REC indicator
-    if (currentAIState == AI_SURVEILLANCE) {
+    if (state == AI_SURVEILLANCE) {
         u8g2.setFont(u8g2_font_ncenB10_tr);
         u8g2.drawStr(0, 35, "SURVEILLANCE");
-        if (millis() % 1000 < 500) {
+        if (now % 1000 < 500) {
             u8g2.drawDisc(115, 10, 5); // Flashing REC dot
         }
-        u8g2.sendBuffer();
-        return; // Stop here so it doesn't draw eyes
+        return SCENE_SURVEILLANCE;
     }
 
     // Display network credentials if requested (show for 10 seconds)
-    if (showNetworkInfo && (now - networkInfoStartTime < 10000)){
-        u8g2.setFont(u8g2_font_ncenB10_tr);
-        u8g2.drawStr(0, 15, "Network Info");
-        
-        u8g2.setFont(u8g2_font_6x10_tr);
-        String ssidLabel = "WiFi: " + WiFi.SSID();
-        u8g2.drawStr(0, 30, ssidLabel.c_str());
-        
-        String ipLabel = "IP: " + WiFi.localIP().toString();
-        u8g2.drawStr(0, 45, ipLabel.c_str());
-        
-        long rssi = WiFi.RSSI();
-        String signalLabel = "Signal: " + String(rssi) + " dBm";
-        u8g2.drawStr(0, 60, signalLabel.c_str());
-        
-        u8g2.sendBuffer();
-        return;
-    } else if (showNetworkInfo && (now - networkInfoStartTime >= 15000)) {
+    if (showNetworkInfo) {
+        if (now - networkInfoStartTime < 10000) {
+            u8g2.setFont(u8g2_font_ncenB10_tr);
+            u8g2.drawStr(0, 15, "Network Info");
+            
+            u8g2.setFont(u8g2_font_6x10_tr);
+            String ssidLabel = "WiFi: " + WiFi.SSID();
+            u8g2.drawStr(0, 30, ssidLabel.c_str());
+            
+            String ipLabel = "IP: " + WiFi.localIP().toString();
+            u8g2.drawStr(0, 45, ipLabel.c_str());
+            
+            String signalLabel = "Signal: " + String(WiFi.RSSI()) + " dBm";
+            u8g2.drawStr(0, 60, signalLabel.c_str());
+            return SCENE_NETWORK;
+        }
         showNetworkInfo = false;  // Timeout expired, stop showing
     }
     
-    if (currentAIState == AI_ALARMING) {
+    if (state == AI_ALARMING) {
         u8g2.setFont(u8g2_font_logisoso24_tn);
         int textWidth = u8g2.getStrWidth("ALARM!");
         u8g2.drawStr((128 - textWidth) / 2, 35, "ALARM!");
         
         u8g2.setFont(u8g2_font_ncenB10_tr);
         u8g2.drawStr(12, 55, "Tap to dismiss");
-    } else if (isWeatherTask) {
-        
-        u8g2.drawXBM(0, 0, 128, 64, weather_icon);
-    } else if (isTimeDateTask) {
-        
-        u8g2.drawXBM(0, 0, 128, 64, time_date_icon);
-    } else if (currentAIState == AI_LISTENING) {
-        
-        u8g2.drawXBM(0, 0, 128, 64, mic_icon);
-    } else if (currentAIState == AI_SPEAKING) {
-        
-        if (now - last_speaking_frame_time > FRAME_DELAY) {
+        return SCENE_ALARM;
+    }
+    if (isWeatherTask) {
+        drawSprite(weather_icon, 0, 0, 0);
+        return SCENE_WEATHER;
+    }
+    if (isTimeDateTask) {
+        drawSprite(time_date_icon, 0, 0, 0);
+        return SCENE_TIME_DATE;
+    }
+    if (state == AI_LISTENING) {
+        drawSprite(mic_icon, 0, 0, 0);
+        return SCENE_LISTENING;
+    }
+    if (state == AI_SPEAKING) {
+        if (now - last_speaking_frame_time > speaking_sprite.frameDelayMs) {
             last_speaking_frame_time = now;
-            speaking_frame_index = (speaking_frame_index + 1) % SPEAKING_FRAME_COUNT;
+            speaking_frame_index = (speaking_frame_index + 1) % speaking_sprite.frameCount;
         }
-        u8g2.drawXBM(40, 8, FRAME_WIDTH, FRAME_HEIGHT, speaking_frames[speaking_frame_index]);
-    } else {
-        
-        if (currentAIState == AI_IDLE) {  
-            switch (currentIdleDisplay) {
-                case IDLE_EYES:
-                    { 
-                        isBlinking = false;
-                        float pupilSpeed = 0.05; float browSpeed = 0.05; float horRange = 4; float verRange = 2; targetBrowOffset = 0;
-
-                        if (now - lastMoveTime > random(1000, 2500)) {
-                           targetPupilX = horRange * cos(random(0, 360) * 3.14 / 180.0);
-                           targetPupilY = verRange * sin(random(0, 360) * 3.14 / 180.0);
-                           lastMoveTime = now;
-                        }
-                        pupilX += (targetPupilX - pupilX) * pupilSpeed;
-                        pupilY += (targetPupilY - pupilY) * pupilSpeed;
-                        browOffsetLeft += (targetBrowOffset - browOffsetLeft) * browSpeed;
-                        browOffsetRight += (targetBrowOffset - browOffsetRight) * browSpeed;
-
-                        drawEye(leftEyeX, eyeY, eyeWidth, eyeHeight, pupilX, pupilY);
-                        drawEye(rightEyeX, eyeY, eyeWidth, eyeHeight, pupilX, pupilY);
-                        drawEyebrow(leftEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, browOffsetLeft);
-                        drawEyebrow(rightEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, browOffsetRight);
-                    }
-                    break; 
-
-                case IDLE_INFO: 
-                    {
-                        
-                        struct tm timeinfo;
-                        if (getLocalTime(&timeinfo)) {
-                            char timeHourMin[6]; 
-                            char dateStr[12];    
-                            strftime(timeHourMin, sizeof(timeHourMin), "%H:%M", &timeinfo);
-                            strftime(dateStr, sizeof(dateStr), "%b %d", &timeinfo); 
-
-                            u8g2.setFont(u8g2_font_logisoso24_tn); 
-                            int timeWidth = u8g2.getStrWidth(timeHourMin);
-                            u8g2.drawStr((128 - timeWidth) / 2, 35, timeHourMin); 
-
-                            u8g2.setFont(u8g2_font_ncenB10_tr); 
-                            int dateWidth = u8g2.getStrWidth(dateStr);
-                            u8g2.drawStr((128 - dateWidth) / 2, 55, dateStr); 
-                        } else {
-                            
-                            u8g2.setFont(u8g2_font_ncenB10_tr);
-                            u8g2.drawStr(20, 35, "Time N/A");
-                        }
-
-                        
-                        long rssi = WiFi.RSSI();
-                        int bars = 0;
-                        
-                        if (rssi >= -60) { bars = 4; }       
-                        else if (rssi >= -70) { bars = 3; }  
-                        else if (rssi >= -80) { bars = 2; }  
-                        else if (rssi >= -90) { bars = 1; }  
-                        else { bars = 0; }                   
-
-                        
-                        int barX = 115; 
-                        int barY = 5;   
-                        int barW = 3;   
-                        int barH[] = {2, 4, 6, 8}; 
-                        int barGap = 1; 
-
-                        for (int i = 0; i < 4; i++) {
-                            if (bars > i) {
-                                
-                                u8g2.drawBox(barX + i * (barW + barGap), barY + (barH[3] - barH[i]), barW, barH[i]);
-                            }   
-                        }
-                    }
-                    break; 
-            } 
-        } 
-        else if (currentAIState == AI_THINKING) {
-             
-             if (!isBlinking && (now - lastBlink > random(1000, 2500))) {
-                 isBlinking = true;
-                 blinkStart = now;
-                 lastBlink = now;
-             }
-             if (isBlinking && now - blinkStart > 180) {
-                 isBlinking = false;
-             }
-
-             float pupilSpeed = 0.12; float browSpeed = 0.10; float horRange = 8; float verRange = 4; targetBrowOffset = -3;
-
-             if (!isBlinking && now - lastMoveTime > random(1000, 2500)) {
-               targetPupilX = horRange * cos(random(0, 360) * 3.14 / 180.0);
-               targetPupilY = verRange * sin(random(0, 360) * 3.14 / 180.0);
-               lastMoveTime = now;
-             }
-             pupilX += (targetPupilX - pupilX) * pupilSpeed;
-             pupilY += (targetPupilY - pupilY) * pupilSpeed;
-             browOffsetLeft += (targetBrowOffset - browOffsetLeft) * browSpeed;
-             browOffsetRight += (targetBrowOffset - browOffsetRight) * browSpeed;
-
-             if (isBlinking) {
-                 drawBlink(leftEyeX, eyeY, eyeWidth);
-                 drawBlink(rightEyeX, eyeY, eyeWidth);
-             } else {
-                 drawEye(leftEyeX, eyeY, eyeWidth, eyeHeight, pupilX, pupilY);
-                 drawEye(rightEyeX, eyeY, eyeWidth, eyeHeight, pupilX, pupilY);
-             }
-             drawEyebrow(leftEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, browOffsetLeft);
-             drawEyebrow(rightEyeX, eyeY - eyeHeight / 2 - 7, eyeWidth, browOffsetRight);
-        } 
-
-    } 
-
-    u8g2.sendBuffer(); 
-}
\ No newline at end of file
+        drawSprite(speaking_sprite, speaking_frame_index, 40, 8);
+        return SCENE_SPEAKING;
+    }
+
+    if (state == AI_THINKING) {
+        if (!isBlinking && (long)(now - nextBlinkTime) >= 0) {
+            isBlinking = true;
+            blinkStart = now;
+            nextBlinkTime = now + random(1000, 2500);
+        }
+        if (isBlinking && now - blinkStart > 180) {
+            isBlinking = false;
+        }
+        targetBrowOffset = Q8(-3);
+        if (!isBlinking) tweenEyes(now, 31, 26, Q8(8), Q8(4));   // ~0.12 and ~0.10 per frame
+        drawEyes(isBlinking);
+        return SCENE_THINKING;
+    }
+
+    if (currentIdleDisplay == IDLE_INFO) {
+        struct tm timeinfo;
+        if (getLocalTime(&timeinfo, 0)) {
+            char timeHourMin[6]; 
+            char dateStr[12];    
+            strftime(timeHourMin, sizeof(timeHourMin), "%H:%M", &timeinfo);
+            strftime(dateStr, sizeof(dateStr), "%b %d", &timeinfo); 
+
+            u8g2.setFont(u8g2_font_logisoso24_tn); 
+            int timeWidth = u8g2.getStrWidth(timeHourMin);
+            u8g2.drawStr((128 - timeWidth) / 2, 35, timeHourMin); 
+
+            u8g2.setFont(u8g2_font_ncenB10_tr); 
+            int dateWidth = u8g2.getStrWidth(dateStr);
+            u8g2.drawStr((128 - dateWidth) / 2, 55, dateStr); 
+        } else {
+            u8g2.setFont(u8g2_font_ncenB10_tr);
+            u8g2.drawStr(20, 35, "Time N/A");
+        }
+
+        long rssi = WiFi.RSSI();
+        int bars = 0;
+        if (rssi >= -60) { bars = 4; }       
+        else if (rssi >= -70) { bars = 3; }  
+        else if (rssi >= -80) { bars = 2; }  
+        else if (rssi >= -90) { bars = 1; }  
+
+        int barX = 115; 
+        int barY = 5;   
+        int barW = 3;   
+        int barH[] = {2, 4, 6, 8}; 
+        int barGap = 1; 
+        for (int i = 0; i < bars; i++) {
+            u8g2.drawBox(barX + i * (barW + barGap), barY + (barH[3] - barH[i]), barW, barH[i]);
+        }
+        return SCENE_INFO;
+    }
+
+    isBlinking = false;
+    targetBrowOffset = 0;
+    tweenEyes(now, 13, 13, Q8(4), Q8(2));   // ~0.05 per frame
+    drawEyes(false);
+    return SCENE_EYES;
+}
+
+// Samples the touch pad and publishes its edges. A long press is published while the
+// pad is still held, so recording starts without waiting for the release.
+void pollTouch(unsigned long now) {
+    static bool down = false;
+    static bool longPressSent = false;
+    static unsigned long downAt = 0;
+
+    currentTouchValue = touchRead(BUTTON_PIN);
+    bool touched = currentTouchValue > TOUCH_THRESHOLD;
+    if (touched && !down) {
+        down = true;
+        longPressSent = false;
+        downAt = now;
+        eventBus.publish(EV_TOUCH_DOWN);
+    } else if (touched && !longPressSent && now - downAt >= TOUCH_LONG_PRESS_MS) {
+        longPressSent = true;
+        eventBus.publish(EV_LONG_PRESS);
+    } else if (!touched && down) {
+        down = false;
+        eventBus.publish(EV_TOUCH_UP, now - downAt);
+    }
+}
+
+// Renders at most DISPLAY_FPS frames per second and flushes only the changed tiles.
+// Also owns the status LED, which follows the state shown on screen, and samples
+// the touch pad every TOUCH_POLL_MS between frames.
+void displayTask(void *param) {
+    const unsigned long framePeriod = 1000 / DISPLAY_FPS;
+    unsigned long nextFrame = 0;
+    int ledState = -1;
+    for (;;) {
+        unsigned long now = millis();
+        pollTouch(now);
+
+        // A state change or a posted message is drawn at once, everything else at the frame rate
+        bool redraw = (long)(now - nextFrame) >= 0 || ulTaskNotifyTake(pdTRUE, 0) > 0;
+        KikoEvent ev;
+        while (xQueueReceive(displayEvents, &ev, 0) == pdTRUE) redraw = true;
+
+        if (redraw) {
+            AIState state = aiState();
+            if (state != ledState || state == AI_ALARMING) {  // Alarm flashes, so refresh it every frame
+                setLedState(state);
+                ledState = state;
+            }
+
+            DisplayScene scene = renderDisplayScene(now);
+            displayFlusher.flush(u8g2.getBufferPtr(), oledSink, scene, now);
+            nextFrame = now + framePeriod;
+        }
+
+        // Sleep until the next touch sample; a state change ends the wait early
+        xQueuePeek(displayEvents, &ev, pdMS_TO_TICKS(TOUCH_POLL_MS));
+    }
+}
+
+void startDisplayTask() {
+    displayFlusher.invalidate();  // Setup drew the panel directly
+    // Core 0, next to the network stack: keeps I2C transfers off the audio loop's core
+    xTaskCreatePinnedToCore(displayTask, "Display", 4096, NULL, 1, &displayTaskHandle, 0);
+}
+
+// GET /api/display: per-scene frames and I2C bytes pushed (total and over the last second)
+void handleDisplayStatsAPI() {
+    JsonDocument doc;
+    doc["fps"] = DISPLAY_FPS;
+    doc["frames"] = displayFlusher.frames();
+    doc["spriteDecodes"] = spriteDecodes;
+    doc["spriteDecodeUs"] = spriteDecodes ? (float)spriteDecodeMicros / spriteDecodes : 0.0f;
+    JsonArray scenes = doc.createNestedArray("scenes");
+    for (uint8_t i = 0; i <= SCENE_MESSAGE; i++) {
+        const DisplaySceneStats& st = displayFlusher.scene(i);
+        if (st.frames == 0) continue;
+        JsonObject o = scenes.createNestedObject();
+        o["scene"] = DISPLAY_SCENE_NAMES[i];
+        o["frames"] = st.frames;
+        o["bytes"] = st.bytes;
+        o["bytesPerSec"] = st.bytesPerSec;
+    }
+    String json;
+    serializeJson(doc, json);
+    server.send(200, "application/json", json);
+}
@@ -0,0 +1,315 @@
+/*
+================================================================================
+  KIKO - Alarm scheduler (hierarchical timer wheel)
+================================================================================
+  Named alarms keyed on wall-clock time (Unix seconds), so they do not drift
+  with millis() and can be written to flash and resumed after a reboot.
+
+  - Four wheels of 64 slots: 1 s, 64 s, ~68 min and ~3 days per slot
+    (about 194 days in total); later alarms wait in an overflow list.
+  - An alarm sits in the lowest wheel whose block it shares with the current
+    time. When the clock enters a new block, the matching slot of the next
+    wheel is cascaded down, so a tick costs O(1) plus the alarms it fires.
+  - Alarms are pooled and linked into their slot both ways, so adding,
+    cancelling and snoozing are O(1) too.
+  - Recurring alarms (repeatSec > 0) are re-armed when they fire; anything
+    already due when added fires on the next advance().
+  - A clock jump further than ALARM_WHEEL_MAX_CATCHUP seconds (NTP correction,
+    long power-off) re-files every alarm instead of stepping through it.
+  - A wheel started on a provisional clock (seconds of uptime, before NTP) is
+    moved onto Unix time with rebase(), which keeps every alarm's remaining time.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+
+#define ALARM_WHEEL_BITS 6
+#define ALARM_WHEEL_SLOTS (1 << ALARM_WHEEL_BITS)
+#define ALARM_WHEEL_LEVELS 4
+#define ALARM_WHEEL_MAX_CATCHUP 4096       // Larger jumps re-file instead of stepping
+#define ALARM_NAME_LEN 24
+
+struct AlarmTimer {
+  char name[ALARM_NAME_LEN];
+  uint32_t due = 0;            // Unix seconds
+  uint32_t repeatSec = 0;      // 0 for a one-shot alarm
+  bool active = false;
+  int16_t prev = -1;           // Links within the slot (or free list)
+  int16_t next = -1;
+  int16_t* head = nullptr;     // List the alarm is linked into
+};
+
+struct AlarmSchedulerStats {
+  uint32_t ticks = 0;          // Seconds stepped through
+  uint32_t cascaded = 0;       // Alarms moved down a wheel
+  uint32_t fired = 0;
+  uint32_t refiles = 0;        // Clock jumps handled by re-filing everything
+};
+
+class AlarmScheduler {
+ public:
+  // capacity is the most alarms that can exist at once; now is the current Unix time
+  void begin(int capacity, uint32_t now) {
+    timers_.assign(capacity, AlarmTimer());
+    for (int l = 0; l < ALARM_WHEEL_LEVELS; l++) {
+      for (int s = 0; s < ALARM_WHEEL_SLOTS; s++) wheel_[l][s] = -1;
+    }
+    overflow_ = -1;
+    due_ = -1;
+    free_ = -1;
+    for (int i = capacity - 1; i >= 0; i--) link(i, &free_);
+    count_ = 0;
+    now_ = now;
+  }
+
+  bool started() const { return !timers_.empty(); }
+
+  // Adds an alarm; returns its id, or -1 if the pool is full
+  int add(const char* name, uint32_t due, uint32_t repeatSec) {
+    int id = free_;
+    if (id < 0) return -1;
+    unlink(id);
+    AlarmTimer& t = timers_[id];
+    strncpy(t.name, name, ALARM_NAME_LEN - 1);
+    t.name[ALARM_NAME_LEN - 1] = '\0';
+    t.due = due;
+    t.repeatSec = repeatSec;
+    t.active = true;
+    schedule(id);
+    count_++;
+    return id;
+  }
+
+  bool cancel(int id) {
+    if (!valid(id)) return false;
+    unlink(id);
+    timers_[id].active = false;
+    link(id, &free_);
+    count_--;
+    return true;
+  }
+
+  // Moves an alarm to a new due time (snooze, edit)
+  bool reschedule(int id, uint32_t due) {
+    if (!valid(id)) return false;
+    unlink(id);
+    timers_[id].due = due;
+    schedule(id);
+    return true;
+  }
+
+  // Id of the alarm with this name (case-sensitive), or -1
+  int find(const char* name) const {
+    for (int i = 0; i < (int)timers_.size(); i++) {
+      if (timers_[i].active && strcmp(timers_[i].name, name) == 0) return i;
+    }
+    return -1;
+  }
+
+  // Id of the alarm that is due first, or -1. O(capacity): for status, not per tick.
+  int earliest() const {
+    int best = -1;
+    for (int i = 0; i < (int)timers_.size(); i++) {
+      if (timers_[i].active && (best < 0 || timers_[i].due < timers_[best].due)) best = i;
+    }
+    return best;
+  }
+
+  // Brings the wheel up to now and calls onFire(timer) for every alarm that came due, in
+  // due order. Recurring alarms are re-armed after their callback. Returns the number fired.
+  template <typename FireFn>
+  int advance(uint32_t now, FireFn onFire) {
+    if (!started()) return 0;
+    int fired = fireList(&due_, onFire);
+    if ((int32_t)(now - now_) <= 0) return fired;
+    if (now - now_ > ALARM_WHEEL_MAX_CATCHUP) {
+      stats_.refiles++;
+      return fired + refile(now, onFire);
+    }
+    while (now_ != now) {
+      now_++;
+      stats_.ticks++;
+      if ((now_ & (ALARM_WHEEL_SLOTS - 1)) == 0) cascade();
+      fired += fireList(&wheel_[0][now_ & (ALARM_WHEEL_SLOTS - 1)], onFire);
+    }
+    return fired;
+  }
+
+  // Moves the clock and every alarm forward by offset seconds without firing anything
+  void rebase(uint32_t offset) {
+    std::vector<int16_t> ids = detachAll();
+    now_ += offset;
+    for (int16_t id : ids) {
+      timers_[id].due += offset;
+      schedule(id);
+    }
+  }
+
+  // Calls fn(id, timer) for every active alarm
+  template <typename Fn>
+  void forEach(Fn fn) const {
+    for (int i = 0; i < (int)timers_.size(); i++) {
+      if (timers_[i].active) fn(i, timers_[i]);
+    }
+  }
+
+  const AlarmTimer* get(int id) const { return valid(id) ? &timers_[id] : nullptr; }
+  int count() const { return count_; }
+  int capacity() const { return timers_.size(); }
+  uint32_t now() const { return now_; }
+  const AlarmSchedulerStats& stats() const { return stats_; }
+
+ private:
+  bool valid(int id) const { return id >= 0 && id < (int)timers_.size() && timers_[id].active; }
+
+  void link(int id, int16_t* head) {
+    AlarmTimer& t = timers_[id];
+    t.head = head;
+    t.prev = -1;
+    t.next = *head;
+    if (*head >= 0) timers_[*head].prev = id;
+    *head = id;
+  }
+
+  void unlink(int id) {
+    AlarmTimer& t = timers_[id];
+    if (!t.head) return;                          // Being fired
+    if (t.prev >= 0) timers_[t.prev].next = t.next;
+    else *t.head = t.next;
+    if (t.next >= 0) timers_[t.next].prev = t.prev;
+    t.prev = t.next = -1;
+    t.head = nullptr;
+  }
+
+  // Alarms added already due go to the due list: their wheel slot may have been passed
+  void schedule(int id) {
+    if ((int32_t)(timers_[id].due - now_) <= 0) linkDue(id);
+    else file(id);
+  }
+
+  // Inserts into the due list after every alarm due no later, so it fires in due order and
+  // alarms due at the same second fire in the order they were added
+  void linkDue(int id) {
+    AlarmTimer& t = timers_[id];
+    int prev = -1;
+    for (int i = due_; i >= 0 && (int32_t)(timers_[i].due - t.due) <= 0; i = timers_[i].next) prev = i;
+    if (prev < 0) {
+      link(id, &due_);
+      return;
+    }
+    t.head = &due_;
+    t.prev = prev;
+    t.next = timers_[prev].next;
+    if (t.next >= 0) timers_[t.next].prev = id;
+    timers_[prev].next = id;
+  }
+
+  // Links an alarm into the lowest wheel whose block it shares with now_ (due >= now_)
+  void file(int id) {
+    uint32_t due = timers_[id].due;
+    for (int l = 0; l < ALARM_WHEEL_LEVELS; l++) {
+      int shift = ALARM_WHEEL_BITS * (l + 1);
+      if (shift >= 32 || (due >> shift) == (now_ >> shift)) {
+        link(id, &wheel_[l][(due >> (ALARM_WHEEL_BITS * l)) & (ALARM_WHEEL_SLOTS - 1)]);
+        return;
+      }
+    }
+    link(id, &overflow_);
+  }
+
+  // now_ just entered a new block of wheel 0: pull the matching slots of the higher wheels
+  // down, top wheel first, so an alarm can fall through several wheels in one step
+  void cascade() {
+    const uint32_t mask = ALARM_WHEEL_SLOTS - 1;
+    int top = 1;
+    while (top < ALARM_WHEEL_LEVELS - 1 && ((now_ >> (ALARM_WHEEL_BITS * top)) & mask) == 0) top++;
+    if (top == ALARM_WHEEL_LEVELS - 1 && ((now_ >> (ALARM_WHEEL_BITS * top)) & mask) == 0) {
+      refileList(&overflow_);
+    }
+    for (int l = top; l >= 1; l--) {
+      refileList(&wheel_[l][(now_ >> (ALARM_WHEEL_BITS * l)) & mask]);
+    }
+  }
+
+  // Detaches a whole list first: overflow alarms may be filed back into the overflow list
+  void refileList(int16_t* head) {
+    int16_t pending = *head;
+    *head = -1;
+    while (pending >= 0) {
+      int id = pending;
+      pending = timers_[id].next;
+      timers_[id].prev = timers_[id].next = -1;
+      timers_[id].head = nullptr;
+      file(id);
+      stats_.cascaded++;
+    }
+  }
+
+  // Fires every alarm in a list; all of them are due
+  template <typename FireFn>
+  int fireList(int16_t* head, FireFn& onFire) {
+    int fired = 0;
+    while (*head >= 0) {
+      int id = *head;
+      unlink(id);
+      fired += fire(id, onFire);
+    }
+    return fired;
+  }
+
+  template <typename FireFn>
+  int fire(int id, FireFn& onFire) {
+    AlarmTimer& t = timers_[id];
+    stats_.fired++;
+    onFire(t);
+    if (!t.active) return 1;                      // Cancelled by the callback
+    if (t.head) return 1;                         // Rescheduled by the callback
+    if (t.repeatSec > 0) {
+      while ((int32_t)(t.due - now_) <= 0) t.due += t.repeatSec;
+      file(id);
+    } else {
+      t.active = false;
+      link(id, &free_);
+      count_--;
+    }
+    return 1;
+  }
+
+  // Clock jump: fires everything due by now in due order, then files the rest against now
+  template <typename FireFn>
+  int refile(uint32_t now, FireFn& onFire) {
+    std::vector<int16_t> ids = detachAll();
+    now_ = now;
+    int fired = 0;
+    for (int16_t id : ids) {
+      if ((int32_t)(timers_[id].due - now_) <= 0) fired += fire(id, onFire);
+      else file(id);
+    }
+    return fired;
+  }
+
+  // Unlinks every active alarm; returns their ids in due order
+  std::vector<int16_t> detachAll() {
+    std::vector<int16_t> ids;
+    for (int i = 0; i < (int)timers_.size(); i++) {
+      if (timers_[i].active) {
+        unlink(i);
+        ids.push_back(i);
+      }
+    }
+    std::sort(ids.begin(), ids.end(), [this](int16_t a, int16_t b) { return timers_[a].due < timers_[b].due; });
+    return ids;
+  }
+
+  std::vector<AlarmTimer> timers_;
+  int16_t wheel_[ALARM_WHEEL_LEVELS][ALARM_WHEEL_SLOTS];
+  int16_t overflow_ = -1;
+  int16_t due_ = -1;            // Added when already due
+  int16_t free_ = -1;
+  int count_ = 0;
+  uint32_t now_ = 0;
+  AlarmSchedulerStats stats_;
+};
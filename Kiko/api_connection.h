@@ -0,0 +1,370 @@
+/*
+================================================================================
+  KIKO - Keep-alive connection manager for outbound API calls
+================================================================================
+  One pooled socket per API host (OpenAI, OpenWeather, Google). A voice turn
+  that calls tools talks to api.openai.com up to three times in a row; keeping
+  the TLS session open means only the first request pays for the handshake.
+
+  - Per-host lock: a session is used by one request at a time (tool workers and
+    the Whisper upload task run concurrently with the main loop).
+  - Idle eviction: sockets unused for longer than the idle timeout are closed
+    from loop() so the server never sees us holding dead sessions.
+  - Reconnect-on-failure: a kept-alive socket the server already dropped shows
+    up as a send error; callers retry once on a fresh connection.
+
+  Also contains a minimal HTTP/1.1 response reader (status line, headers,
+  Content-Length and chunked bodies) for callers that drive the socket
+  directly instead of going through HTTPClient.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+
+#define API_POOL_MAX_HOSTS 6
+#define API_POOL_IDLE_TIMEOUT_MS 30000UL
+#define API_POOL_LOCK_TIMEOUT_MS 30000UL
+
+struct ApiHostSession {
+  const char* host = nullptr;
+  uint16_t port = 443;
+  bool secure = true;
+  WiFiClient* client = nullptr;
+  SemaphoreHandle_t lock = nullptr;
+  unsigned long lastUsed = 0;
+
+  // Statistics
+  uint32_t requests = 0;
+  uint32_t handshakes = 0;     // New TCP/TLS connections opened
+  uint32_t reuses = 0;         // Requests served on an already-open connection
+  uint32_t reconnects = 0;     // Stale kept-alive sockets replaced mid-request
+  uint32_t failures = 0;       // Connection attempts that failed
+  uint32_t evictions = 0;      // Idle sockets closed
+  unsigned long lastHandshakeMs = 0;
+};
+
+class ApiConnectionPool;
+
+// Exclusive use of one host session for the duration of a request.
+// Releases the host lock when it goes out of scope.
+class ApiLease {
+ public:
+  ApiLease() {}
+  ApiLease(ApiConnectionPool* pool, ApiHostSession* session) : pool_(pool), session_(session) {}
+  ApiLease(const ApiLease&) = delete;
+  ApiLease& operator=(const ApiLease&) = delete;
+  ApiLease(ApiLease&& other) { *this = std::move(other); }
+  ApiLease& operator=(ApiLease&& other) {
+    release();
+    pool_ = other.pool_; session_ = other.session_; reused_ = other.reused_;
+    other.pool_ = nullptr; other.session_ = nullptr;
+    return *this;
+  }
+  ~ApiLease() { release(); }
+
+  bool valid() const { return session_ != nullptr; }
+  WiFiClient& client() { return *session_->client; }
+  const char* host() const { return session_ ? session_->host : ""; }
+
+  // URL prefix for HTTPClient requests: "https://host", or "http://host:port" for plain stand-ins
+  String baseUrl() const {
+    if (!session_) return String();
+    if (session_->secure && session_->port == 443) return "https://" + String(session_->host);
+    return String(session_->secure ? "https://" : "http://") + session_->host + ":" + String(session_->port);
+  }
+
+  // True if the last ensureConnected() picked up an already-open socket
+  bool reused() const { return reused_; }
+
+  // Opens the connection if needed. Counts a handshake or a reuse.
+  bool ensureConnected() {
+    if (!session_) return false;
+    session_->requests++;
+    if (session_->client->connected()) {
+      session_->reuses++;
+      reused_ = true;
+      return true;
+    }
+    reused_ = false;
+    return connect();
+  }
+
+  // Drops a stale socket and opens a fresh one
+  bool reconnect() {
+    if (!session_) return false;
+    session_->reconnects++;
+    session_->client->stop();
+    reused_ = false;
+    return connect();
+  }
+
+  // Close the socket after this request (server asked for it or the body was not fully read)
+  void close() {
+    if (session_) session_->client->stop();
+  }
+
+  void release() {
+    if (session_) {
+      session_->lastUsed = millis();
+      xSemaphoreGive(session_->lock);
+    }
+    session_ = nullptr;
+    pool_ = nullptr;
+  }
+
+ private:
+  bool connect() {
+    unsigned long start = millis();
+    if (!session_->client->connect(session_->host, session_->port)) {
+      session_->failures++;
+      Serial.printf("[ApiPool] Connect to %s failed\n", session_->host);
+      return false;
+    }
+    session_->handshakes++;
+    session_->lastHandshakeMs = millis() - start;
+    Serial.printf("[ApiPool] Handshake with %s took %lu ms (#%u)\n",
+                  session_->host, session_->lastHandshakeMs, (unsigned)session_->handshakes);
+    return true;
+  }
+
+  ApiConnectionPool* pool_ = nullptr;
+  ApiHostSession* session_ = nullptr;
+  bool reused_ = false;
+};
+
+class ApiConnectionPool {
+ public:
+  // Registers a host. Call once from setup() before any request.
+  void addHost(const char* host, uint16_t port = 443, bool secure = true) {
+    if (find(host) || hostCount_ >= API_POOL_MAX_HOSTS) return;
+    ApiHostSession& s = sessions_[hostCount_++];
+    s.host = host;
+    s.port = port;
+    s.secure = secure;
+    if (secure) {
+      WiFiClientSecure* tls = new WiFiClientSecure();
+      tls->setInsecure();
+      s.client = tls;
+    } else {
+      s.client = new WiFiClient();
+    }
+    s.lock = xSemaphoreCreateMutex();
+  }
+
+  // Blocks until the host session is free. Returns an invalid lease for unknown hosts or on timeout.
+  ApiLease acquire(const char* host) {
+    ApiHostSession* s = find(host);
+    if (!s) {
+      Serial.printf("[ApiPool] Unknown host %s\n", host);
+      return ApiLease();
+    }
+    if (xSemaphoreTake(s->lock, pdMS_TO_TICKS(API_POOL_LOCK_TIMEOUT_MS)) != pdTRUE) {
+      Serial.printf("[ApiPool] Timed out waiting for %s\n", host);
+      return ApiLease();
+    }
+    return ApiLease(this, s);
+  }
+
+  // Closes sockets that have been idle too long. Skips sessions currently in use.
+  void evictIdle(unsigned long idleMs = API_POOL_IDLE_TIMEOUT_MS) {
+    unsigned long now = millis();
+    for (int i = 0; i < hostCount_; i++) {
+      ApiHostSession& s = sessions_[i];
+      if (now - s.lastUsed < idleMs) continue;
+      if (xSemaphoreTake(s.lock, 0) != pdTRUE) continue;
+      if (s.client->connected()) {
+        s.client->stop();
+        s.evictions++;
+        Serial.printf("[ApiPool] Evicted idle connection to %s\n", s.host);
+      }
+      xSemaphoreGive(s.lock);
+    }
+  }
+
+  int hostCount() const { return hostCount_; }
+  const ApiHostSession& session(int i) const { return sessions_[i]; }
+
+  // Errors that indicate the kept-alive socket was dead before we used it
+  static bool isStaleConnectionError(int httpCode) {
+    return httpCode == -2 /* SEND_HEADER_FAILED */ ||
+           httpCode == -3 /* SEND_PAYLOAD_FAILED */ ||
+           httpCode == -4 /* NOT_CONNECTED */ ||
+           httpCode == -5 /* CONNECTION_LOST */;
+  }
+
+ private:
+  ApiHostSession* find(const char* host) {
+    for (int i = 0; i < hostCount_; i++) {
+      if (strcmp(sessions_[i].host, host) == 0) return &sessions_[i];
+    }
+    return nullptr;
+  }
+
+  ApiHostSession sessions_[API_POOL_MAX_HOSTS];
+  int hostCount_ = 0;
+};
+
+// ========== MINIMAL HTTP/1.1 RESPONSE READER ==========
+
+struct HttpResponseHead {
+  int status = -1;
+  long contentLength = -1;  // -1 when not given
+  bool chunked = false;
+  bool keepAlive = true;    // HTTP/1.1 default
+};
+
+// Called while a reader waits for the next byte (e.g. to keep audio playback fed)
+typedef void (*HttpIdleHook)();
+
+// Reads one byte, waiting up to the deadline. Returns -1 on timeout or disconnect.
+inline int httpTimedRead(Client& c, unsigned long deadline, HttpIdleHook idle = nullptr) {
+  while (!c.available()) {
+    if (!c.connected() || (long)(millis() - deadline) >= 0) return -1;
+    if (idle) idle(); else vTaskDelay(1);
+  }
+  return c.read();
+}
+
+// Reads a CRLF-terminated line (without the line ending). Returns false on timeout.
+inline bool httpReadLine(Client& c, String& line, unsigned long deadline, HttpIdleHook idle = nullptr) {
+  line = "";
+  while (true) {
+    int ch = httpTimedRead(c, deadline, idle);
+    if (ch < 0) return false;
+    if (ch == '\n') break;
+    if (ch != '\r') line += (char)ch;
+  }
+  return true;
+}
+
+// Parses the status line and headers. Leaves the socket positioned at the body.
+inline bool readHttpResponseHead(Client& c, HttpResponseHead& head, uint32_t timeoutMs) {
+  unsigned long deadline = millis() + timeoutMs;
+  String line;
+  if (!httpReadLine(c, line, deadline)) return false;
+  // "HTTP/1.1 200 OK"
+  int sp = line.indexOf(' ');
+  if (!line.startsWith("HTTP/") || sp < 0) return false;
+  head.status = line.substring(sp + 1, sp + 4).toInt();
+  head.keepAlive = !line.startsWith("HTTP/1.0");
+
+  while (httpReadLine(c, line, deadline)) {
+    if (line.length() == 0) return true;
+    int colon = line.indexOf(':');
+    if (colon < 0) continue;
+    String name = line.substring(0, colon);
+    String value = line.substring(colon + 1);
+    value.trim();
+    if (name.equalsIgnoreCase("Content-Length")) {
+      head.contentLength = value.toInt();
+    } else if (name.equalsIgnoreCase("Transfer-Encoding")) {
+      value.toLowerCase();
+      head.chunked = value.indexOf("chunked") >= 0;
+    } else if (name.equalsIgnoreCase("Connection")) {
+      value.toLowerCase();
+      if (value.indexOf("close") >= 0) head.keepAlive = false;
+      if (value.indexOf("keep-alive") >= 0) head.keepAlive = true;
+    }
+  }
+  return false;
+}
+
+// Incremental body reader: hides Content-Length / chunked framing so callers
+// can consume a response as it arrives (e.g. server-sent events).
+class HttpBodyReader {
+ public:
+  HttpBodyReader(Client& c, const HttpResponseHead& head, HttpIdleHook idle = nullptr)
+      : c_(c), head_(head), idle_(idle) {
+    remaining_ = head.chunked ? 0 : head.contentLength;
+  }
+
+  // Next body byte, or -1 at the end of the body, on timeout or disconnect
+  int read(unsigned long deadline) {
+    if (done_) return -1;
+    if (head_.chunked) {
+      if (remaining_ == 0 && !nextChunk(deadline)) return -1;
+    } else if (head_.contentLength >= 0 && remaining_ == 0) {
+      done_ = complete_ = true;
+      return -1;
+    }
+    int ch = httpTimedRead(c_, deadline, idle_);
+    if (ch < 0) {
+      done_ = true;
+      // An unframed body legitimately ends when the server closes the connection
+      if (!head_.chunked && head_.contentLength < 0 && !c_.connected()) complete_ = true;
+      return -1;
+    }
+    if (remaining_ > 0) remaining_--;
+    return ch;
+  }
+
+  // Reads up to and excluding the next LF (CR is dropped). False once the body is exhausted.
+  bool readLine(String& line, unsigned long deadline) {
+    line = "";
+    bool any = false;
+    while (true) {
+      int ch = read(deadline);
+      if (ch < 0) return any;
+      any = true;
+      if (ch == '\n') return true;
+      if (ch != '\r') line += (char)ch;
+    }
+  }
+
+  // Stop reading early (e.g. interrupted). The socket must then be closed.
+  void abandon() { done_ = true; complete_ = false; }
+
+  // True once the whole body has been consumed; only then can the socket be reused
+  bool complete() const { return complete_; }
+
+ private:
+  bool nextChunk(unsigned long deadline) {
+    String line;
+    if (started_ && !httpReadLine(c_, line, deadline, idle_)) { done_ = true; return false; }  // CRLF after previous chunk
+    started_ = true;
+    if (!httpReadLine(c_, line, deadline, idle_)) { done_ = true; return false; }
+    // chunk-size is one or more hex digits, then optionally whitespace or ";" extensions.
+    // Anything else means the framing is lost: the body fails and the socket is not reused.
+    const char* size = line.c_str();
+    char* end = nullptr;
+    remaining_ = isxdigit((unsigned char)size[0]) ? strtol(size, &end, 16) : -1;
+    if (remaining_ < 0 || (*end != '\0' && *end != ';' && *end != ' ' && *end != '\t')) {
+      done_ = true;
+      return false;
+    }
+    if (remaining_ == 0) {
+      // Trailer section ends with an empty line; without it the socket is not at the next response
+      bool ended = false;
+      while (!ended && httpReadLine(c_, line, deadline, idle_)) ended = line.length() == 0;
+      done_ = true;
+      complete_ = ended;
+      return false;
+    }
+    return true;
+  }
+
+  Client& c_;
+  HttpResponseHead head_;
+  HttpIdleHook idle_;
+  long remaining_ = 0;
+  bool started_ = false;
+  bool done_ = false;
+  bool complete_ = false;
+};
+
+// Reads the whole body described by head into out, decoding chunked transfer encoding.
+// Returns false if the body could not be read completely (the socket must then be closed).
+inline bool readHttpResponseBody(Client& c, const HttpResponseHead& head, String& out, uint32_t timeoutMs) {
+  unsigned long deadline = millis() + timeoutMs;
+  out = "";
+  if (head.contentLength > 0) out.reserve(head.contentLength);
+  HttpBodyReader reader(c, head);
+  int ch;
+  while ((ch = reader.read(deadline)) >= 0) {
+    out += (char)ch;
+  }
+  return reader.complete();
+}
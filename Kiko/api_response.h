@@ -0,0 +1,143 @@
+/*
+================================================================================
+  KIKO - Filtered JSON parsing of API responses
+================================================================================
+  API replies are parsed straight off the socket instead of being copied into
+  a String first, and an ArduinoJson filter keeps only the fields the caller
+  uses. A chat completion, for example, is reduced to choices[0].message.
+
+  - HttpJsonReader adapts HttpBodyReader (Content-Length, chunked or
+    close-delimited bodies) to ArduinoJson's custom reader interface.
+  - ApiJsonResponse owns the document and a counting allocator, so every
+    parse reports the most memory its document held (peakDocBytes).
+  - ApiParseStats collects per-API counts, body bytes, parse time and peak
+    document size for /api/runtime.
+
+  Parse time is measured from the first body byte requested to the end of
+  the body, so it includes waiting for the network.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "api_connection.h"
+
+struct ApiParseStats {
+  uint32_t responses = 0;
+  uint32_t failures = 0;       // Invalid JSON or a body cut short
+  uint32_t bodyBytes = 0;
+  uint32_t parseUsTotal = 0;
+  uint32_t parseUsMax = 0;
+  uint32_t peakDocBytes = 0;   // Largest document kept after filtering
+};
+
+// ArduinoJson custom reader over an HTTP body
+class HttpJsonReader {
+ public:
+  HttpJsonReader(HttpBodyReader& body, unsigned long deadline) : body_(body), deadline_(deadline) {}
+
+  int read() {
+    int ch = body_.read(deadline_);
+    if (ch >= 0) bytes_++;
+    return ch;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) {
+      int ch = read();
+      if (ch < 0) break;
+      buffer[n++] = (char)ch;
+    }
+    return n;
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  HttpBodyReader& body_;
+  unsigned long deadline_;
+  size_t bytes_ = 0;
+};
+
+// Heap allocator that remembers the most a document held at once
+class PeakTrackingAllocator : public ArduinoJson::Allocator {
+ public:
+  void* allocate(size_t size) override {
+    uint8_t* p = (uint8_t*)malloc(size + HEADER);
+    if (!p) return nullptr;
+    *(size_t*)p = size;
+    grow(size);
+    return p + HEADER;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr) return;
+    uint8_t* p = (uint8_t*)ptr - HEADER;
+    live_ -= *(size_t*)p;
+    free(p);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    if (!ptr) return allocate(size);
+    uint8_t* p = (uint8_t*)ptr - HEADER;
+    size_t old = *(size_t*)p;
+    uint8_t* q = (uint8_t*)realloc(p, size + HEADER);
+    if (!q) return nullptr;
+    *(size_t*)q = size;
+    live_ -= old;
+    grow(size);
+    return q + HEADER;
+  }
+
+  size_t peak() const { return peak_; }
+
+ private:
+  static const size_t HEADER = 8;   // Keeps the returned blocks 8-byte aligned
+
+  void grow(size_t size) {
+    live_ += size;
+    if (live_ > peak_) peak_ = live_;
+  }
+
+  size_t live_ = 0;
+  size_t peak_ = 0;
+};
+
+// One response parsed with a filter. The document lives as long as this object.
+class ApiJsonResponse {
+ public:
+  explicit ApiJsonResponse(ApiParseStats& stats) : stats_(stats), doc_(&alloc_) {}
+
+  // Parses the body, then reads what follows the JSON value so a kept-alive socket
+  // is left at the next response. Returns false on invalid JSON; check body.complete()
+  // before reusing the socket.
+  bool parse(HttpBodyReader& body, JsonDocument& filter, uint32_t timeoutMs) {
+    unsigned long start = micros();
+    unsigned long deadline = millis() + timeoutMs;
+    HttpJsonReader reader(body, deadline);
+    error_ = deserializeJson(doc_, reader, DeserializationOption::Filter(filter));
+    size_t drained = 0;
+    while (body.read(deadline) >= 0) drained++;
+    uint32_t us = micros() - start;
+
+    bool ok = !error_ && body.complete();
+    stats_.responses++;
+    if (!ok) stats_.failures++;
+    stats_.bodyBytes += reader.bytes() + drained;
+    stats_.parseUsTotal += us;
+    if (us > stats_.parseUsMax) stats_.parseUsMax = us;
+    if (alloc_.peak() > stats_.peakDocBytes) stats_.peakDocBytes = alloc_.peak();
+    return !error_;
+  }
+
+  JsonDocument& doc() { return doc_; }
+  DeserializationError error() const { return error_; }
+
+ private:
+  ApiParseStats& stats_;
+  PeakTrackingAllocator alloc_;
+  JsonDocument doc_;
+  DeserializationError error_;
+};
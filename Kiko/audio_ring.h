@@ -0,0 +1,113 @@
+/*
+================================================================================
+  KIKO - Lock-free ring buffer for microphone samples
+================================================================================
+  Single producer (the I2S capture task) and single consumer (the recording
+  loop, which feeds the DSP and upload stages). Head and tail are free-running
+  counters: only the producer writes head, only the consumer writes tail, so
+  no lock is needed and neither side can block the other.
+
+  - Storage lives in PSRAM; capacity is rounded up to a power of two.
+  - Overrun: the consumer fell behind and the ring was full. Samples that do
+    not fit are dropped (the newest ones) and counted.
+  - Underrun: the consumer expected samples but the producer delivered none
+    for longer than the consumer's deadline (reported via noteUnderrun()).
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+class AudioRing {
+ public:
+  bool begin(size_t minCapacity) {
+    size_t capacity = 1;
+    while (capacity < minCapacity) capacity <<= 1;
+    buffer_ = (int16_t*)ps_malloc(capacity * sizeof(int16_t));
+    if (!buffer_) return false;
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+    return true;
+  }
+
+  // Producer side. Returns the number of samples stored; the rest were dropped.
+  size_t write(const int16_t* samples, size_t count) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    size_t space = capacity_ - (head - tail);
+    size_t n = count < space ? count : space;
+    if (n < count) {
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+      droppedSamples_.fetch_add(count - n, std::memory_order_relaxed);
+    }
+    copyIn(head, samples, n);
+    head_.store(head + n, std::memory_order_release);
+
+    size_t fill = (head + n) - tail;
+    if (fill > peakFill_.load(std::memory_order_relaxed)) peakFill_.store(fill, std::memory_order_relaxed);
+    return n;
+  }
+
+  // Consumer side. Returns the number of samples copied into out.
+  size_t read(int16_t* out, size_t maxCount) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    uint32_t head = head_.load(std::memory_order_acquire);
+    size_t avail = head - tail;
+    if (avail == 0) return 0;
+    size_t n = maxCount < avail ? maxCount : avail;
+    copyOut(tail, out, n);
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  size_t available() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+  }
+
+  void noteUnderrun() { underruns_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Consumer side: drop everything captured so far (e.g. before a new recording).
+  void discard() {
+    tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  void resetStats() {
+    overruns_ = 0;
+    underruns_ = 0;
+    droppedSamples_ = 0;
+    peakFill_ = 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+  uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+  uint32_t underruns() const { return underruns_.load(std::memory_order_relaxed); }
+  uint32_t droppedSamples() const { return droppedSamples_.load(std::memory_order_relaxed); }
+  size_t peakFill() const { return peakFill_.load(std::memory_order_relaxed); }
+
+ private:
+  void copyIn(uint32_t pos, const int16_t* src, size_t n) {
+    size_t start = pos & mask_;
+    size_t first = n < capacity_ - start ? n : capacity_ - start;
+    memcpy(buffer_ + start, src, first * sizeof(int16_t));
+    memcpy(buffer_, src + first, (n - first) * sizeof(int16_t));
+  }
+
+  void copyOut(uint32_t pos, int16_t* dst, size_t n) {
+    size_t start = pos & mask_;
+    size_t first = n < capacity_ - start ? n : capacity_ - start;
+    memcpy(dst, buffer_ + start, first * sizeof(int16_t));
+    memcpy(dst + first, buffer_, (n - first) * sizeof(int16_t));
+  }
+
+  int16_t* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t mask_ = 0;
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+
+  std::atomic<uint32_t> overruns_{0};
+  std::atomic<uint32_t> underruns_{0};
+  std::atomic<uint32_t> droppedSamples_{0};
+  std::atomic<size_t> peakFill_{0};
+};
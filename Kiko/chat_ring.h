@@ -0,0 +1,201 @@
+/*
+================================================================================
+  KIKO - Bounded chat history with a token-budgeted context window
+================================================================================
+  Fixed-capacity ring of message headers plus a circular byte arena for the
+  message bodies, both in PSRAM. Appending never moves existing messages:
+  when either the ring or the arena is full the oldest messages are evicted.
+
+  Each entry is classified once, when it is added:
+  - CHAT_PLAIN        user text or assistant text
+  - CHAT_TOOL_CALL    assistant turn carrying "tool_calls" (raw API JSON)
+  - CHAT_TOOL_RESULT  tool output, answered by tool_call_id
+
+  and carries an estimated token count, so the request builder can pick the
+  newest messages that fit a token budget without parsing anything. The
+  window never starts with a tool result whose tool call was left out.
+
+  Plain text longer than CHAT_MAX_CONTENT is truncated. Tool calls and tool
+  results are never cut (the API rejects a half tool-call JSON or a call
+  without its results): an oversized one is refused, and the whole tool
+  exchange it belongs to is dropped with it.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define CHAT_RING_MAX_ENTRIES 64
+#define CHAT_ARENA_BYTES (32 * 1024)
+#define CHAT_TOKEN_OVERHEAD 4          // Per-message framing (role, separators)
+#define CHAT_MAX_CONTENT (CHAT_ARENA_BYTES / 2)   // Keeps room for the rest of the conversation
+
+enum ChatRole : uint8_t { CHAT_ROLE_USER, CHAT_ROLE_ASSISTANT, CHAT_ROLE_TOOL };
+enum ChatKind : uint8_t { CHAT_PLAIN, CHAT_TOOL_CALL, CHAT_TOOL_RESULT };
+
+struct ChatEntry {
+  uint32_t offset;      // Free-running arena position of the body: content\0tool_call_id\0
+  uint16_t contentLen;
+  uint8_t idLen;
+  ChatRole role;
+  ChatKind kind;
+  uint16_t tokens;      // Estimated prompt tokens, including framing
+};
+
+class ChatHistoryRing {
+ public:
+  bool begin() {
+    entries_ = (ChatEntry*)ps_malloc(CHAT_RING_MAX_ENTRIES * sizeof(ChatEntry));
+    arena_ = (char*)ps_malloc(CHAT_ARENA_BYTES);
+    clear();
+    return entries_ && arena_;
+  }
+
+  void clear() {
+    first_ = 0;
+    count_ = 0;
+    arenaHead_ = 0;
+    arenaTail_ = 0;
+    refusingResults_ = false;
+  }
+
+  static ChatKind classify(ChatRole role, const char* content) {
+    if (role == CHAT_ROLE_TOOL) return CHAT_TOOL_RESULT;
+    if (role == CHAT_ROLE_ASSISTANT && content[0] == '{' && strstr(content, "\"tool_calls\"")) return CHAT_TOOL_CALL;
+    return CHAT_PLAIN;
+  }
+
+  // Roughly 4 characters per token for English text and JSON
+  static uint16_t estimateTokens(size_t bytes) {
+    size_t t = (bytes + 3) / 4 + CHAT_TOKEN_OVERHEAD;
+    return t > 0xFFFF ? 0xFFFF : (uint16_t)t;
+  }
+
+  // Returns false if the message was refused: an oversized tool call or result (its
+  // exchange is dropped), or a result of a tool call that was refused
+  bool append(ChatRole role, const char* content, const char* toolCallId = "") {
+    if (!entries_ || !arena_) return false;
+    ChatKind kind = classify(role, content);
+    if (kind != CHAT_TOOL_RESULT) refusingResults_ = false;
+    else if (refusingResults_) return false;
+    size_t contentLen = strlen(content);
+    size_t idLen = strlen(toolCallId);
+    if (idLen > 255) idLen = 255;
+    if (contentLen > CHAT_MAX_CONTENT) {
+      if (kind != CHAT_PLAIN) {
+        if (kind == CHAT_TOOL_RESULT) dropToolExchange();
+        refusingResults_ = true;
+        return false;
+      }
+      contentLen = CHAT_MAX_CONTENT;
+    }
+    size_t need = contentLen + 1 + idLen + 1;
+
+    // Bodies are stored contiguously; if one would wrap, skip to the start of the arena
+    uint32_t pos = arenaHead_;
+    size_t untilEnd = CHAT_ARENA_BYTES - (pos % CHAT_ARENA_BYTES);
+    size_t skip = need > untilEnd ? untilEnd : 0;
+
+    while (count_ > 0 && (count_ == CHAT_RING_MAX_ENTRIES || (arenaHead_ - arenaTail_) + skip + need > CHAT_ARENA_BYTES)) {
+      dropOldest();
+    }
+    if (count_ == 0) {
+      arenaHead_ = arenaTail_ = 0;
+      pos = 0;
+      skip = 0;
+    }
+    pos += skip;
+
+    char* body = arena_ + (pos % CHAT_ARENA_BYTES);
+    memcpy(body, content, contentLen);
+    body[contentLen] = '\0';
+    memcpy(body + contentLen + 1, toolCallId, idLen);
+    body[contentLen + 1 + idLen] = '\0';
+
+    ChatEntry& e = entries_[(first_ + count_) % CHAT_RING_MAX_ENTRIES];
+    e.offset = pos;
+    e.contentLen = contentLen;
+    e.idLen = idLen;
+    e.role = role;
+    e.kind = kind;
+    e.tokens = estimateTokens(contentLen + idLen);
+    count_++;
+    arenaHead_ = pos + need;
+    appended_++;
+    return true;
+  }
+
+  size_t size() const { return count_; }
+  uint32_t appended() const { return appended_; }             // Total messages ever added
+  size_t arenaUsed() const { return arenaHead_ - arenaTail_; }
+
+  // i = 0 is the oldest retained message
+  const ChatEntry& entry(size_t i) const { return entries_[(first_ + i) % CHAT_RING_MAX_ENTRIES]; }
+  const char* content(size_t i) const { return arena_ + (entry(i).offset % CHAT_ARENA_BYTES); }
+  const char* toolCallId(size_t i) const { return content(i) + entry(i).contentLen + 1; }
+
+  static const char* roleName(ChatRole role) {
+    switch (role) {
+      case CHAT_ROLE_USER: return "user";
+      case CHAT_ROLE_ASSISTANT: return "assistant";
+      default: return "tool";
+    }
+  }
+
+  // Index of the oldest message to send so that the window fits the token budget.
+  // The newest message is always included. tokensOut receives the window's estimate.
+  size_t windowStart(uint32_t budget, uint32_t* tokensOut = nullptr) const {
+    if (count_ == 0) {
+      if (tokensOut) *tokensOut = 0;
+      return 0;
+    }
+    size_t start = count_ - 1;
+    uint32_t tokens = entry(start).tokens;
+    while (start > 0 && tokens + entry(start - 1).tokens <= budget) {
+      start--;
+      tokens += entry(start).tokens;
+    }
+    // A tool result is only valid right after the assistant turn that requested it
+    while (start < count_ - 1 && entry(start).kind == CHAT_TOOL_RESULT) {
+      tokens -= entry(start).tokens;
+      start++;
+    }
+    if (tokensOut) *tokensOut = tokens;
+    return start;
+  }
+
+ private:
+  void dropOldest() {
+    const ChatEntry& e = entries_[first_];
+    arenaTail_ = e.offset + e.contentLen + 1 + e.idLen + 1;
+    first_ = (first_ + 1) % CHAT_RING_MAX_ENTRIES;
+    count_--;
+    // Evicting a tool call orphans its results: drop them too
+    while (count_ > 0 && entries_[first_].kind == CHAT_TOOL_RESULT) {
+      const ChatEntry& r = entries_[first_];
+      arenaTail_ = r.offset + r.contentLen + 1 + r.idLen + 1;
+      first_ = (first_ + 1) % CHAT_RING_MAX_ENTRIES;
+      count_--;
+    }
+  }
+
+  // Removes the tool exchange being appended: its results so far and the call they answer
+  void dropToolExchange() {
+    while (count_ > 0 && entry(count_ - 1).kind == CHAT_TOOL_RESULT) dropNewest();
+    if (count_ > 0 && entry(count_ - 1).kind == CHAT_TOOL_CALL) dropNewest();
+  }
+
+  void dropNewest() {
+    count_--;
+    arenaHead_ = count_ > 0 ? entry(count_).offset : arenaTail_;
+  }
+
+  ChatEntry* entries_ = nullptr;
+  char* arena_ = nullptr;
+  size_t first_ = 0;
+  size_t count_ = 0;
+  uint32_t arenaHead_ = 0;    // Free-running byte positions
+  uint32_t arenaTail_ = 0;
+  uint32_t appended_ = 0;
+  bool refusingResults_ = false;  // The last tool call was refused: so are its results
+};
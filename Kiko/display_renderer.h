@@ -0,0 +1,131 @@
+/*
+================================================================================
+  KIKO - Dirty-region flushing and fixed-point tweening for the OLED
+================================================================================
+  The 128x64 panel is 8 tile rows of 16 tiles (8x8 px, 8 bytes each); the
+  U8g2 full buffer stores one 128-byte page per tile row.
+
+  - DirtyTileFlusher keeps a copy of the last frame that reached the panel.
+    For every tile row it finds the first and last tile that changed and
+    pushes just that span, so a static scene costs no bus traffic at all.
+  - The transport is a DisplaySink: on the device it wraps
+    U8g2::updateDisplayArea(); FramebufferSink mirrors the pushed tiles into
+    memory for host-side benchmarks and checks.
+  - Bytes pushed are counted per scene, with a per-second rate that is
+    refreshed once a second.
+  - Eye and brow animation uses Q8 fixed point (256 == 1 px) and a 16-step
+    direction table instead of float cos()/sin().
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define OLED_TILE_COLS 16
+#define OLED_TILE_ROWS 8
+#define OLED_ROW_BYTES (OLED_TILE_COLS * 8)
+#define OLED_FRAME_BYTES (OLED_TILE_ROWS * OLED_ROW_BYTES)
+#define DISPLAY_MAX_SCENES 12
+
+class DisplaySink {
+ public:
+  virtual ~DisplaySink() {}
+  // Push tiles [tx, tx + tw) of tile row ty; frame is the full page-major buffer
+  virtual void pushTiles(uint8_t tx, uint8_t ty, uint8_t tw, const uint8_t* frame) = 0;
+};
+
+// Mirrors every push into its own framebuffer (host benchmarks, no panel needed)
+class FramebufferSink : public DisplaySink {
+ public:
+  void pushTiles(uint8_t tx, uint8_t ty, uint8_t tw, const uint8_t* frame) override {
+    size_t offset = ty * OLED_ROW_BYTES + tx * 8;
+    memcpy(pixels + offset, frame + offset, tw * 8);
+    pushes++;
+  }
+  uint8_t pixels[OLED_FRAME_BYTES] = {0};
+  uint32_t pushes = 0;
+};
+
+struct DisplaySceneStats {
+  uint32_t frames = 0;
+  uint32_t bytes = 0;          // Total pushed since boot
+  uint32_t bytesPerSec = 0;    // Over the last full second
+  uint32_t windowBytes = 0;
+};
+
+class DirtyTileFlusher {
+ public:
+  // Next flush pushes the whole frame (the panel was drawn by someone else)
+  void invalidate() { full_ = true; }
+
+  // Pushes the tiles of frame that differ from the last pushed frame. Returns bytes pushed.
+  size_t flush(const uint8_t* frame, DisplaySink& sink, uint8_t scene, unsigned long now) {
+    size_t pushed = 0;
+    for (uint8_t ty = 0; ty < OLED_TILE_ROWS; ty++) {
+      const uint8_t* row = frame + ty * OLED_ROW_BYTES;
+      uint8_t* shadow = shadow_ + ty * OLED_ROW_BYTES;
+      int first = -1, last = -1;
+      for (int tx = 0; tx < OLED_TILE_COLS; tx++) {
+        if (full_ || memcmp(row + tx * 8, shadow + tx * 8, 8) != 0) {
+          if (first < 0) first = tx;
+          last = tx;
+        }
+      }
+      if (first < 0) continue;
+      uint8_t tw = last - first + 1;
+      sink.pushTiles(first, ty, tw, frame);
+      memcpy(shadow + first * 8, row + first * 8, tw * 8);
+      pushed += tw * 8;
+    }
+    full_ = false;
+
+    if (scene >= DISPLAY_MAX_SCENES) scene = DISPLAY_MAX_SCENES - 1;
+    stats_[scene].frames++;
+    stats_[scene].bytes += pushed;
+    stats_[scene].windowBytes += pushed;
+    frames_++;
+    if (now - windowStart_ >= 1000) {
+      unsigned long elapsed = now - windowStart_;
+      for (int i = 0; i < DISPLAY_MAX_SCENES; i++) {
+        stats_[i].bytesPerSec = (uint64_t)stats_[i].windowBytes * 1000 / elapsed;
+        stats_[i].windowBytes = 0;
+      }
+      windowStart_ = now;
+    }
+    return pushed;
+  }
+
+  const DisplaySceneStats& scene(uint8_t i) const { return stats_[i]; }
+  uint32_t frames() const { return frames_; }
+
+ private:
+  uint8_t shadow_[OLED_FRAME_BYTES] = {0};
+  bool full_ = true;
+  DisplaySceneStats stats_[DISPLAY_MAX_SCENES];
+  uint32_t frames_ = 0;
+  unsigned long windowStart_ = 0;
+};
+
+// ---- Q8 fixed point ----
+
+typedef int32_t q8_t;
+#define Q8(x) ((q8_t)((x) * 256))
+
+// Moves pos toward target by rate/256 of the remaining distance
+inline q8_t tweenQ8(q8_t pos, q8_t target, int32_t rate) {
+  return pos + (((target - pos) * rate) >> 8);
+}
+
+// Nearest whole pixel
+inline int q8ToInt(q8_t v) { return (v + 128) >> 8; }
+
+// cos() of 16 evenly spaced directions, in Q8; sin(i) == cos(i - 4)
+static const int16_t Q8_DIRECTION_COS[16] = {
+  256, 237, 181, 98, 0, -98, -181, -237, -256, -237, -181, -98, 0, 98, 181, 237
+};
+
+// A point on the ellipse (rangeX, rangeY) in one of 16 directions
+inline void q8Direction(uint8_t dir, q8_t rangeX, q8_t rangeY, q8_t& x, q8_t& y) {
+  x = (rangeX * Q8_DIRECTION_COS[dir & 15]) >> 8;
+  y = (rangeY * Q8_DIRECTION_COS[(dir - 4) & 15]) >> 8;
+}
@@ -0,0 +1,77 @@
+/*
+================================================================================
+  KIKO - Event bus between the firmware tasks
+================================================================================
+  Every long-running part of the firmware is its own FreeRTOS task (web
+  server, audio playback, UI/display, the voice pipeline, camera and mic
+  capture). Instead of polling each other's globals they publish small
+  events; each task subscribes once, at setup, to the event types it cares
+  about and gets its own queue.
+
+  - Publishing never blocks: a subscriber whose queue is full misses the
+    event and the miss is counted, so a stuck task cannot stall the others.
+  - Each event carries the millis() it was published at, which lets the
+    receiver measure how long it waited in the queue.
+  - Subscriptions are fixed after setup, so publish() needs no lock.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define EVENT_BUS_MAX_SUBSCRIBERS 6
+
+enum KikoEventType : uint8_t {
+  EV_STATE_CHANGED,   // arg: new AIState
+  EV_TOUCH_DOWN,      // Pad pressed
+  EV_TOUCH_UP,        // Pad released, arg: hold time in ms
+  EV_LONG_PRESS,      // Pad still held after the long-press time
+  EV_SENTENCE_DONE,   // Audio task finished (or dropped) a sentence, arg: sentences completed so far
+  EV_WEB_COMMAND,     // arg: WebCommand, executed by the pipeline task
+  EV_TYPE_COUNT
+};
+
+#define EVENT_MASK(type) (1u << (type))
+
+struct KikoEvent {
+  uint8_t type;
+  int32_t arg;
+  uint32_t at;        // millis() when published
+};
+
+class EventBus {
+ public:
+  // Returns the subscriber's queue, or nullptr if all slots are taken. Setup only.
+  QueueHandle_t subscribe(uint32_t mask, UBaseType_t depth) {
+    if (count_ >= EVENT_BUS_MAX_SUBSCRIBERS) return nullptr;
+    QueueHandle_t queue = xQueueCreate(depth, sizeof(KikoEvent));
+    if (!queue) return nullptr;
+    subs_[count_].mask = mask;
+    subs_[count_].queue = queue;
+    count_++;
+    return queue;
+  }
+
+  void publish(uint8_t type, int32_t arg = 0) {
+    KikoEvent ev = {type, arg, (uint32_t)millis()};
+    published_.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < count_; i++) {
+      if (!(subs_[i].mask & EVENT_MASK(type))) continue;
+      if (xQueueSend(subs_[i].queue, &ev, 0) != pdTRUE) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t published() const { return published_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Subscriber {
+    uint32_t mask = 0;
+    QueueHandle_t queue = nullptr;
+  };
+  Subscriber subs_[EVENT_BUS_MAX_SUBSCRIBERS];
+  int count_ = 0;
+  std::atomic<uint32_t> published_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
@@ -0,0 +1,299 @@
+/*
+================================================================================
+  KIKO - Incremental FLAC encoder for microphone uploads
+================================================================================
+  Lossless 16-bit mono FLAC, small enough to run on the upload path:
+
+  - Stream header ("fLaC" + STREAMINFO) is written once. When the clip length
+    is not known yet (streamed upload) total samples and MD5 are left as 0,
+    which the format defines as "unknown".
+  - Each frame holds up to FLAC_BLOCK_SIZE samples and is encoded on its own,
+    so frames can be produced while recording and sent as they complete.
+  - Subframes use the fixed polynomial predictors (order 0-4) with partitioned
+    Rice coding of the residual; CONSTANT and VERBATIM are used when cheaper.
+    No LPC: fixed predictors get most of the gain on 8 kHz speech for a
+    fraction of the CPU.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define FLAC_BLOCK_SIZE 4096
+#define FLAC_MAX_FIXED_ORDER 4
+#define FLAC_MAX_PARTITION_ORDER 8
+#define FLAC_MAX_RICE_PARAM 14            // 15 is the escape code in the 4-bit parameter field
+#define FLAC_STREAM_HEADER_BYTES 42       // "fLaC" + metadata block header + 34-byte STREAMINFO
+
+// Worst case is a VERBATIM frame: header (<= 16 bytes) + 2 bytes per sample + subframe header + CRC
+#define FLAC_MAX_FRAME_BYTES (FLAC_BLOCK_SIZE * 2 + 32)
+
+class FlacBitWriter {
+ public:
+  explicit FlacBitWriter(uint8_t* out) : out_(out) {}
+
+  void write(uint32_t value, int bits) {
+    while (bits > 0) {
+      int take = bits > 24 ? 24 : bits;
+      bits -= take;
+      acc_ = (acc_ << take) | ((value >> bits) & ((1u << take) - 1));
+      accBits_ += take;
+      while (accBits_ >= 8) {
+        accBits_ -= 8;
+        out_[pos_++] = (uint8_t)(acc_ >> accBits_);
+      }
+    }
+  }
+
+  void writeZeros(uint32_t count) {
+    while (count >= 24) { write(0, 24); count -= 24; }
+    if (count) write(0, count);
+  }
+
+  void writeRice(uint32_t u, int k) {
+    writeZeros(u >> k);
+    write(1, 1);
+    if (k) write(u & ((1u << k) - 1), k);
+  }
+
+  void alignToByte() {
+    if (accBits_) write(0, 8 - accBits_);
+  }
+
+  size_t bytes() const { return pos_; }
+
+ private:
+  uint8_t* out_;
+  size_t pos_ = 0;
+  uint64_t acc_ = 0;
+  int accBits_ = 0;
+};
+
+class FlacEncoder {
+ public:
+  bool begin(uint32_t sampleRate) {
+    sampleRate_ = sampleRate;
+    frameNumber_ = 0;
+    if (!residual_) residual_ = (uint32_t*)ps_malloc(FLAC_BLOCK_SIZE * sizeof(uint32_t));
+    buildCrcTables();
+    return residual_ != nullptr;
+  }
+
+  // Starts a new stream: writes "fLaC" and STREAMINFO. totalSamples = 0 means not known yet.
+  size_t writeStreamHeader(uint8_t* out, uint32_t totalSamples) {
+    frameNumber_ = 0;
+    uint32_t block = FLAC_BLOCK_SIZE;
+    if (totalSamples > 0 && totalSamples < block) block = totalSamples < 16 ? 16 : totalSamples;
+    FlacBitWriter w(out);
+    w.write('f', 8); w.write('L', 8); w.write('a', 8); w.write('C', 8);
+    w.write(1, 1);                  // Last metadata block
+    w.write(0, 7);                  // STREAMINFO
+    w.write(34, 24);
+    w.write(block, 16);             // Min block size
+    w.write(block, 16);             // Max block size
+    w.write(0, 24);                 // Min frame size (unknown)
+    w.write(0, 24);                 // Max frame size (unknown)
+    w.write(sampleRate_, 20);
+    w.write(0, 3);                  // Channels - 1
+    w.write(15, 5);                 // Bits per sample - 1
+    w.write(0, 4);                  // Total samples, upper 4 of 36 bits
+    w.write(totalSamples, 32);
+    for (int i = 0; i < 4; i++) w.write(0, 32);   // MD5 (unknown)
+    return w.bytes();
+  }
+
+  // Encodes one frame of n samples (1 <= n <= FLAC_BLOCK_SIZE) into out, which
+  // must hold FLAC_MAX_FRAME_BYTES. Returns the number of bytes written.
+  size_t encodeFrame(const int16_t* x, int n, uint8_t* out) {
+    FlacBitWriter w(out);
+
+    // --- Frame header ---
+    w.write(0x3FFE, 14);            // Sync
+    w.write(0, 1);                  // Reserved
+    w.write(0, 1);                  // Fixed block size: header carries the frame number
+    w.write(n == FLAC_BLOCK_SIZE ? 0xC : 0x7, 4);
+    w.write(sampleRateCode(), 4);
+    w.write(0, 4);                  // Mono
+    w.write(4, 3);                  // 16 bits per sample
+    w.write(0, 1);                  // Reserved
+    writeUtf8(w, frameNumber_++);
+    if (n != FLAC_BLOCK_SIZE) w.write(n - 1, 16);
+    w.alignToByte();
+    w.write(crc8(out, w.bytes()), 8);
+
+    writeSubframe(w, x, n);
+
+    w.alignToByte();
+    uint16_t crc = crc16(out, w.bytes());
+    w.write(crc, 16);
+    return w.bytes();
+  }
+
+ private:
+  uint32_t sampleRateCode() const {
+    switch (sampleRate_) {
+      case 8000: return 0x4;
+      case 16000: return 0x5;
+      case 22050: return 0x6;
+      case 24000: return 0x7;
+      case 32000: return 0x8;
+      case 44100: return 0x9;
+      case 48000: return 0xA;
+      default: return 0x0;          // Take it from STREAMINFO
+    }
+  }
+
+  static void writeUtf8(FlacBitWriter& w, uint32_t v) {
+    if (v < 0x80) { w.write(v, 8); return; }
+    int extra = v < 0x800 ? 1 : v < 0x10000 ? 2 : v < 0x200000 ? 3 : v < 0x4000000 ? 4 : 5;
+    static const uint8_t lead[] = {0, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
+    w.write(lead[extra] | (v >> (6 * extra)), 8);
+    for (int i = extra - 1; i >= 0; i--) w.write(0x80 | ((v >> (6 * i)) & 0x3F), 8);
+  }
+
+  static inline int32_t fixedResidual(const int16_t* x, int i, int order) {
+    switch (order) {
+      case 0: return x[i];
+      case 1: return x[i] - x[i - 1];
+      case 2: return x[i] - 2 * x[i - 1] + x[i - 2];
+      case 3: return x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3];
+      default: return x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+    }
+  }
+
+  // Picks the fixed predictor order with the smallest total absolute residual (single pass)
+  static int bestFixedOrder(const int16_t* x, int n) {
+    if (n <= FLAC_MAX_FIXED_ORDER) return 0;
+    uint64_t err[5] = {0, 0, 0, 0, 0};
+    int32_t e1p = x[3] - x[2];
+    int32_t e2p = e1p - (x[2] - x[1]);
+    int32_t e3p = e2p - ((x[2] - x[1]) - (x[1] - x[0]));
+    int32_t prev = x[3];
+    for (int i = 4; i < n; i++) {
+      int32_t e0 = x[i];
+      int32_t e1 = e0 - prev;
+      int32_t e2 = e1 - e1p;
+      int32_t e3 = e2 - e2p;
+      int32_t e4 = e3 - e3p;
+      err[0] += e0 < 0 ? -e0 : e0;
+      err[1] += e1 < 0 ? -e1 : e1;
+      err[2] += e2 < 0 ? -e2 : e2;
+      err[3] += e3 < 0 ? -e3 : e3;
+      err[4] += e4 < 0 ? -e4 : e4;
+      prev = e0; e1p = e1; e2p = e2; e3p = e3;
+    }
+    int best = 0;
+    for (int o = 1; o <= FLAC_MAX_FIXED_ORDER; o++) if (err[o] < err[best]) best = o;
+    return best;
+  }
+
+  // Estimated Rice cost of a partition: count * (k + 1) + sum >> k
+  static uint64_t riceCost(uint64_t sum, uint32_t count, int& bestK) {
+    uint64_t best = UINT64_MAX;
+    for (int k = 0; k <= FLAC_MAX_RICE_PARAM; k++) {
+      uint64_t bits = (uint64_t)count * (k + 1) + (sum >> k);
+      if (bits < best) { best = bits; bestK = k; }
+    }
+    return best;
+  }
+
+  void writeSubframe(FlacBitWriter& w, const int16_t* x, int n) {
+    bool constant = true;
+    for (int i = 1; i < n && constant; i++) constant = (x[i] == x[0]);
+    if (constant) {
+      w.write(0, 8);                // Padding bit, CONSTANT, no wasted bits
+      w.write((uint16_t)x[0], 16);
+      return;
+    }
+
+    int order = bestFixedOrder(x, n);
+    for (int i = order; i < n; i++) {
+      int32_t r = fixedResidual(x, i, order);
+      residual_[i] = (uint32_t)((r << 1) ^ (r >> 31));   // Zigzag to unsigned
+    }
+
+    // Partition sums at the finest usable order, then merged pairwise for coarser orders
+    int maxP = 0;
+    while (maxP < FLAC_MAX_PARTITION_ORDER && (n % (2 << maxP)) == 0 && (n >> (maxP + 1)) > order) maxP++;
+    uint64_t sums[1 << FLAC_MAX_PARTITION_ORDER];
+    int parts = 1 << maxP;
+    int partLen = n >> maxP;
+    for (int p = 0; p < parts; p++) {
+      uint64_t s = 0;
+      for (int i = (p == 0 ? order : p * partLen); i < (p + 1) * partLen; i++) s += residual_[i];
+      sums[p] = s;
+    }
+
+    uint64_t bestBits = UINT64_MAX;
+    int bestP = 0;
+    for (int p = maxP; p >= 0; p--) {
+      if (p < maxP) {
+        for (int i = 0; i < (1 << p); i++) sums[i] = sums[2 * i] + sums[2 * i + 1];
+      }
+      uint64_t bits = 4;
+      int len = n >> p;
+      for (int i = 0; i < (1 << p); i++) {
+        int k;
+        bits += 4 + riceCost(sums[i], i == 0 ? len - order : len, k);
+      }
+      if (bits <= bestBits) { bestBits = bits; bestP = p; }
+    }
+
+    uint64_t fixedBits = 8 + 16 * order + 2 + bestBits;
+    if (fixedBits >= 8 + 16ULL * n) {
+      w.write(0x02, 8);             // VERBATIM
+      for (int i = 0; i < n; i++) w.write((uint16_t)x[i], 16);
+      return;
+    }
+
+    w.write(0x10 | (order << 1), 8);  // FIXED, order, no wasted bits
+    for (int i = 0; i < order; i++) w.write((uint16_t)x[i], 16);
+    w.write(0, 2);                  // Rice coding, 4-bit parameters
+    w.write(bestP, 4);
+    int len = n >> bestP;
+    for (int p = 0; p < (1 << bestP); p++) {
+      int start = (p == 0) ? order : p * len;
+      int end = (p + 1) * len;
+      uint64_t s = 0;
+      for (int i = start; i < end; i++) s += residual_[i];
+      int k = 0;
+      riceCost(s, end - start, k);
+      w.write(k, 4);
+      for (int i = start; i < end; i++) w.writeRice(residual_[i], k);
+    }
+  }
+
+  void buildCrcTables() {
+    if (crcReady_) return;
+    for (int i = 0; i < 256; i++) {
+      uint8_t c8 = i;
+      uint16_t c16 = i << 8;
+      for (int b = 0; b < 8; b++) {
+        c8 = (c8 & 0x80) ? (c8 << 1) ^ 0x07 : (c8 << 1);
+        c16 = (c16 & 0x8000) ? (c16 << 1) ^ 0x8005 : (c16 << 1);
+      }
+      crc8Table_[i] = c8;
+      crc16Table_[i] = c16;
+    }
+    crcReady_ = true;
+  }
+
+  uint8_t crc8(const uint8_t* data, size_t len) const {
+    uint8_t crc = 0;
+    while (len--) crc = crc8Table_[crc ^ *data++];
+    return crc;
+  }
+
+  uint16_t crc16(const uint8_t* data, size_t len) const {
+    uint16_t crc = 0;
+    while (len--) crc = (crc << 8) ^ crc16Table_[(crc >> 8) ^ *data++];
+    return crc;
+  }
+
+  uint32_t sampleRate_ = 8000;
+  uint32_t frameNumber_ = 0;
+  uint32_t* residual_ = nullptr;
+  bool crcReady_ = false;
+  uint8_t crc8Table_[256];
+  uint16_t crc16Table_[256];
+};
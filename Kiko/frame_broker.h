@@ -0,0 +1,172 @@
+/*
+================================================================================
+  KIKO - Camera frame broker for multi-viewer MJPEG streaming
+================================================================================
+  The camera is read by one capture task; each JPEG is copied once into a
+  reference-counted SharedFrame and offered to every subscribed viewer.
+
+  - Each viewer has its own small queue and its own sender task, so a slow
+    client only ever delays itself.
+  - Offering never blocks: when a viewer's queue is full its oldest pending
+    frame is dropped (and counted) to make room for the newest one.
+  - A frame is freed when the last queue or sender releases it.
+  - The broker also keeps the newest frame (from the stream or from the
+    vision prefetch), so a vision request can take it without waiting for
+    the sensor.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <climits>
+
+#define STREAM_MAX_VIEWERS 4
+#define STREAM_QUEUE_DEPTH 2
+
+struct SharedFrame {
+  uint8_t* data;
+  size_t len;
+  uint32_t seq;
+  unsigned long capturedAt;
+  std::atomic<int> refs;
+};
+
+// Copies a JPEG out of the camera buffer so the driver gets its buffer back at once
+inline SharedFrame* sharedFrameCreate(const uint8_t* jpeg, size_t len, uint32_t seq) {
+  SharedFrame* f = new SharedFrame();
+  f->data = (uint8_t*)ps_malloc(len);
+  if (!f->data) {
+    delete f;
+    return nullptr;
+  }
+  memcpy(f->data, jpeg, len);
+  f->len = len;
+  f->seq = seq;
+  f->capturedAt = millis();
+  f->refs = 1;
+  return f;
+}
+
+inline void sharedFrameRetain(SharedFrame* f) { f->refs.fetch_add(1, std::memory_order_relaxed); }
+
+inline void sharedFrameRelease(SharedFrame* f) {
+  if (f->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    free(f->data);
+    delete f;
+  }
+}
+
+struct StreamViewer {
+  bool active = false;
+  QueueHandle_t queue = nullptr;
+  TaskHandle_t task = nullptr;
+  uint32_t ip = 0;
+  unsigned long connectedAt = 0;
+  std::atomic<uint32_t> framesSent{0};
+  std::atomic<uint32_t> framesDropped{0};
+  std::atomic<uint32_t> bytesSent{0};
+};
+
+class FrameBroker {
+ public:
+  void begin() { lock_ = xSemaphoreCreateMutex(); }
+
+  // Returns the viewer slot, or -1 if all slots are taken
+  int subscribe(uint32_t ip) {
+    int slot = -1;
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    for (int i = 0; i < STREAM_MAX_VIEWERS; i++) {
+      if (!viewers_[i].active) {
+        StreamViewer& v = viewers_[i];
+        if (!v.queue) v.queue = xQueueCreate(STREAM_QUEUE_DEPTH, sizeof(SharedFrame*));
+        if (!v.queue) break;
+        v.ip = ip;
+        v.connectedAt = millis();
+        v.framesSent = 0;
+        v.framesDropped = 0;
+        v.bytesSent = 0;
+        v.task = nullptr;
+        v.active = true;
+        slot = i;
+        break;
+      }
+    }
+    xSemaphoreGive(lock_);
+    return slot;
+  }
+
+  void unsubscribe(int slot) {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    StreamViewer& v = viewers_[slot];
+    v.active = false;
+    SharedFrame* f;
+    while (xQueueReceive(v.queue, &f, 0) == pdTRUE) sharedFrameRelease(f);
+    xSemaphoreGive(lock_);
+  }
+
+  // Hands a frame to every viewer without blocking. Consumes the caller's reference.
+  void publish(SharedFrame* frame) {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    if (latest_) sharedFrameRelease(latest_);
+    latest_ = frame;
+    sharedFrameRetain(frame);
+    for (int i = 0; i < STREAM_MAX_VIEWERS; i++) {
+      StreamViewer& v = viewers_[i];
+      if (!v.active) continue;
+      sharedFrameRetain(frame);
+      if (xQueueSend(v.queue, &frame, 0) != pdTRUE) {
+        SharedFrame* stale;
+        if (xQueueReceive(v.queue, &stale, 0) == pdTRUE) {
+          sharedFrameRelease(stale);
+          v.framesDropped++;
+        }
+        if (xQueueSend(v.queue, &frame, 0) != pdTRUE) {
+          sharedFrameRelease(frame);
+          v.framesDropped++;
+        }
+      }
+    }
+    xSemaphoreGive(lock_);
+    sharedFrameRelease(frame);
+  }
+
+  // Blocks the viewer's sender task until a frame arrives (or the timeout expires)
+  SharedFrame* next(int slot, TickType_t timeout) {
+    SharedFrame* f = nullptr;
+    if (xQueueReceive(viewers_[slot].queue, &f, timeout) != pdTRUE) return nullptr;
+    return f;
+  }
+
+  // The newest frame if it is at most maxAgeMs old, with a reference for the caller
+  SharedFrame* latest(unsigned long maxAgeMs) {
+    SharedFrame* f = nullptr;
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    if (latest_ && millis() - latest_->capturedAt <= maxAgeMs) {
+      f = latest_;
+      sharedFrameRetain(f);
+    }
+    xSemaphoreGive(lock_);
+    return f;
+  }
+
+  unsigned long latestAge() {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    unsigned long age = latest_ ? millis() - latest_->capturedAt : ULONG_MAX;
+    xSemaphoreGive(lock_);
+    return age;
+  }
+
+  int viewerCount() const {
+    int n = 0;
+    for (int i = 0; i < STREAM_MAX_VIEWERS; i++) if (viewers_[i].active) n++;
+    return n;
+  }
+
+  StreamViewer& viewer(int slot) { return viewers_[slot]; }
+
+ private:
+  SemaphoreHandle_t lock_ = nullptr;
+  SharedFrame* latest_ = nullptr;
+  StreamViewer viewers_[STREAM_MAX_VIEWERS];
+};
@@ -0,0 +1,514 @@
+/*
+================================================================================
+  KIKO - Local intent matcher for deterministic voice commands
+================================================================================
+  Recognizes the commands that need no language model ("set a timer for five
+  minutes", "add 2 apples to my groceries list", "what time is it", "cancel
+  the alarm") so they skip both chat round trips.
+
+  - The transcript is normalized (lowercase, no punctuation, "a.m." -> "am",
+    single spaces) and scanned once with an Aho-Corasick automaton compiled
+    from the cue phrase table below. Phrases are padded with spaces, so they
+    only match whole words.
+  - A command cue is accepted only when everything before it is filler
+    ("hey kiko, can you set a ...") and everything after it parses completely
+    into the intent's slots (duration, clock time, quantity, item, list).
+    Anything left over means the request says more than we understand, and
+    it goes to the model instead: precision over recall.
+  - Vision, story and introduction keep their old "keyword anywhere" rules.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include <algorithm>
+
+#define INTENT_MAX_ITEM_WORDS 4
+#define INTENT_MAX_LIST_WORDS 3
+
+enum IntentId : uint8_t {
+  INTENT_NONE, INTENT_VISION, INTENT_STORY, INTENT_INTRODUCE, INTENT_TIME_DATE, INTENT_SET_TIMER,
+  INTENT_SET_ALARM, INTENT_CANCEL_ALARM, INTENT_ALARM_STATUS, INTENT_ADD_ITEM, INTENT_REMOVE_ITEM,
+  INTENT_LIST_ITEMS, INTENT_CLEAR_LIST, INTENT_COUNT
+};
+
+const char* const INTENT_NAMES[INTENT_COUNT] = {
+  "none", "vision", "story", "introduce", "time_date", "set_timer",
+  "set_alarm", "cancel_alarm", "alarm_status", "add_item", "remove_item",
+  "list_items", "clear_list"
+};
+
+struct IntentMatch {
+  IntentId intent = INTENT_NONE;
+  uint32_t seconds = 0;          // INTENT_SET_TIMER
+  uint8_t hour = 0;              // INTENT_SET_ALARM, 1-12
+  uint8_t minute = 0;
+  bool pm = false;
+  int quantity = 0;              // 0 when none was said
+  String item;
+  String list;
+};
+
+enum IntentCue : uint8_t {
+  CUE_VISION, CUE_STORY, CUE_TELL_ME, CUE_INTRODUCE,   // Keyword anywhere
+  CUE_TIME_DATE, CUE_ALARM_STATUS,                     // The whole request
+  CUE_ALARM,        // + duration or clock time
+  CUE_CANCEL,       // + alarm/timer
+  CUE_ADD,          // + [qty] item to/on list
+  CUE_REMOVE,       // + [qty] item from/off list, or alarm/timer
+  CUE_LIST_QUERY,   // + list
+  CUE_CLEAR,        // + list, or alarm/timer
+};
+
+struct IntentPhrase {
+  const char* text;
+  uint8_t cue;
+};
+
+const IntentPhrase INTENT_PHRASES[] = {
+  {"what do you see", CUE_VISION}, {"describe", CUE_VISION},
+  {"story", CUE_STORY}, {"tell me", CUE_TELL_ME},
+  {"who are you", CUE_INTRODUCE}, {"what is your name", CUE_INTRODUCE}, {"whats your name", CUE_INTRODUCE},
+  {"introduce yourself", CUE_INTRODUCE}, {"tell me about yourself", CUE_INTRODUCE}, {"hello", CUE_INTRODUCE},
+
+  {"what time is it", CUE_TIME_DATE}, {"whats the time", CUE_TIME_DATE}, {"what is the time", CUE_TIME_DATE},
+  {"tell me the time", CUE_TIME_DATE}, {"what day is it", CUE_TIME_DATE}, {"whats the date", CUE_TIME_DATE},
+  {"what is the date", CUE_TIME_DATE}, {"whats todays date", CUE_TIME_DATE}, {"what is todays date", CUE_TIME_DATE},
+  {"what is the time and date", CUE_TIME_DATE}, {"whats the time and date", CUE_TIME_DATE},
+
+  {"when is my alarm", CUE_ALARM_STATUS}, {"when is the alarm", CUE_ALARM_STATUS},
+  {"when does my alarm go off", CUE_ALARM_STATUS}, {"is my alarm set", CUE_ALARM_STATUS},
+  {"is there an alarm", CUE_ALARM_STATUS}, {"do i have an alarm", CUE_ALARM_STATUS},
+  {"do i have any alarms", CUE_ALARM_STATUS}, {"alarm status", CUE_ALARM_STATUS},
+  {"how long until my alarm", CUE_ALARM_STATUS}, {"how long until the alarm", CUE_ALARM_STATUS},
+  {"how much time is left on my timer", CUE_ALARM_STATUS}, {"how much time is left on the timer", CUE_ALARM_STATUS},
+
+  {"timer for", CUE_ALARM}, {"alarm for", CUE_ALARM}, {"alarm in", CUE_ALARM}, {"alarm at", CUE_ALARM},
+  {"wake me up in", CUE_ALARM}, {"wake me up at", CUE_ALARM}, {"wake me in", CUE_ALARM}, {"wake me at", CUE_ALARM},
+
+  {"cancel", CUE_CANCEL}, {"stop", CUE_CANCEL}, {"turn off", CUE_CANCEL}, {"dismiss", CUE_CANCEL},
+  {"add", CUE_ADD}, {"put", CUE_ADD},
+  {"remove", CUE_REMOVE}, {"delete", CUE_REMOVE}, {"take", CUE_REMOVE},
+  {"whats on", CUE_LIST_QUERY}, {"what is on", CUE_LIST_QUERY}, {"whats in", CUE_LIST_QUERY},
+  {"what is in", CUE_LIST_QUERY}, {"what do i have on", CUE_LIST_QUERY}, {"read", CUE_LIST_QUERY},
+  {"read me", CUE_LIST_QUERY}, {"show me", CUE_LIST_QUERY}, {"show", CUE_LIST_QUERY},
+  {"clear", CUE_CLEAR}, {"clear out", CUE_CLEAR}, {"empty", CUE_CLEAR},
+};
+
+// Words that may precede a command cue, and that may end any request
+const char* const INTENT_LEAD_FILLERS[] = {
+  "hey", "hi", "hello", "ok", "okay", "kiko", "please", "can", "could", "would", "will", "you", "i", "want",
+  "need", "to", "set", "start", "create", "make", "a", "an", "the", "me", "up", "just", "go", "ahead", "new"
+};
+const char* const INTENT_TAIL_FILLERS[] = {"please", "now", "thanks", "kiko", "today", "ok", "okay"};
+const char* const INTENT_TAIL_PAIRS[][2] = {{"from", "now"}, {"thank", "you"}, {"for", "me"}, {"right", "now"}};
+
+// Lowercase words separated by single spaces, with a space at both ends.
+// Apostrophes and dots go ("what's" -> "whats", "p.m." -> "pm") except a dot or
+// colon between digits ("7:30", "1.5"); other punctuation separates words.
+inline String intentNormalize(const String& text) {
+  String out = " ";
+  out.reserve(text.length() + 2);
+  for (size_t i = 0; i < text.length(); i++) {
+    char c = tolower((uint8_t)text[i]);
+    bool digitsAround = i > 0 && i + 1 < text.length() && isdigit((uint8_t)text[i - 1]) && isdigit((uint8_t)text[i + 1]);
+    if (isalnum((uint8_t)c)) {
+      out += c;
+    } else if ((c == ':' || c == '.') && digitsAround) {
+      out += c;
+    } else if (c == '\'' || c == '.') {
+      continue;
+    } else if (!out.endsWith(" ")) {
+      out += ' ';
+    }
+  }
+  if (!out.endsWith(" ")) out += ' ';
+  return out;
+}
+
+// Aho-Corasick automaton over bytes. Edges are kept as sibling lists: a few
+// hundred nodes, instead of a dense table per node.
+class PhraseAutomaton {
+ public:
+  void add(const char* phrase, uint8_t id) {
+    if (nodes_.empty()) nodes_.push_back(Node());
+    int node = 0;
+    for (const char* p = phrase; *p; p++) {
+      int next = child(node, *p);
+      if (next < 0) {
+        next = nodes_.size();
+        nodes_.push_back(Node());
+        edges_.push_back({*p, (int16_t)next, nodes_[node].edges});
+        nodes_[node].edges = edges_.size() - 1;
+      }
+      node = next;
+    }
+    nodes_[node].id = id;
+    nodes_[node].length = strlen(phrase);
+  }
+
+  // Fills in failure and output links (breadth first)
+  void build() {
+    std::vector<int> queue;
+    for (int e = nodes_[0].edges; e >= 0; e = edges_[e].next) queue.push_back(edges_[e].to);
+    for (size_t q = 0; q < queue.size(); q++) {
+      int u = queue[q];
+      for (int e = nodes_[u].edges; e >= 0; e = edges_[e].next) {
+        int v = edges_[e].to;
+        int f = nodes_[u].fail;
+        while (f > 0 && child(f, edges_[e].c) < 0) f = nodes_[f].fail;
+        int target = child(f, edges_[e].c);
+        nodes_[v].fail = (target >= 0 && target != v) ? target : 0;
+        int fv = nodes_[v].fail;
+        nodes_[v].output = nodes_[fv].id >= 0 ? fv : nodes_[fv].output;
+        queue.push_back(v);
+      }
+    }
+  }
+
+  // Calls fn(id, start, length) for every phrase occurrence in text
+  template <typename Fn>
+  void scan(const char* text, Fn fn) const {
+    int node = 0;
+    for (int i = 0; text[i]; i++) {
+      while (node > 0 && child(node, text[i]) < 0) node = nodes_[node].fail;
+      int next = child(node, text[i]);
+      node = next >= 0 ? next : 0;
+      for (int o = nodes_[node].id >= 0 ? node : nodes_[node].output; o > 0; o = nodes_[o].output) {
+        fn(nodes_[o].id, i + 1 - nodes_[o].length, nodes_[o].length);
+      }
+    }
+  }
+
+  int nodeCount() const { return nodes_.size(); }
+
+ private:
+  struct Node {
+    int16_t fail = 0;
+    int16_t edges = -1;     // First edge in edges_
+    int16_t output = -1;    // Nearest node on the failure chain that ends a phrase
+    int16_t id = -1;        // Phrase ending here
+    uint8_t length = 0;
+  };
+  struct Edge {
+    char c;
+    int16_t to;
+    int16_t next;           // Next sibling
+  };
+
+  int child(int node, char c) const {
+    for (int e = nodes_[node].edges; e >= 0; e = edges_[e].next) {
+      if (edges_[e].c == c) return edges_[e].to;
+    }
+    return -1;
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+};
+
+class IntentMatcher {
+ public:
+  void begin() {
+    for (size_t i = 0; i < sizeof(INTENT_PHRASES) / sizeof(INTENT_PHRASES[0]); i++) {
+      String padded = " " + String(INTENT_PHRASES[i].text) + " ";
+      automaton_.add(padded.c_str(), i);
+    }
+    automaton_.build();
+  }
+
+  bool match(const String& utterance, IntentMatch& out) {
+    out = IntentMatch();
+    String text = intentNormalize(utterance);
+    words_.clear();
+    int start = -1;
+    for (int i = 1; i < (int)text.length(); i++) {
+      if (text[i] == ' ') {
+        if (start >= 0) words_.push_back(text.substring(start, i));
+        start = -1;
+      } else if (start < 0) {
+        start = i;
+      }
+    }
+
+    // Phrase hits as word ranges [first, last)
+    struct Hit { uint8_t cue; int first; int last; };
+    std::vector<Hit> hits;
+    uint32_t cues = 0;
+    automaton_.scan(text.c_str(), [&](int id, int pos, int len) {
+      int first = 0, words = 0;
+      for (int i = 0; i < pos; i++) if (text[i] == ' ') first++;        // Spaces before = words before
+      for (int i = pos + 1; i < pos + len; i++) if (text[i] == ' ') words++;
+      hits.push_back({INTENT_PHRASES[id].cue, first, first + words});
+      cues |= 1u << INTENT_PHRASES[id].cue;
+    });
+
+    if (cues & (1u << CUE_VISION)) return found(out, INTENT_VISION);
+    if ((cues & (1u << CUE_STORY)) && (cues & (1u << CUE_TELL_ME))) return found(out, INTENT_STORY);
+
+    int end = trimTail((int)words_.size());
+    // Earliest cue first; among cues starting at the same word, the longest
+    std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+      return a.first != b.first ? a.first < b.first : a.last > b.last;
+    });
+    for (const Hit& h : hits) {
+      if (h.last > end || !leadIsFiller(h.first)) continue;
+      if (matchCommand(h.cue, h.last, end, out)) return true;
+    }
+
+    out = IntentMatch();   // Drop slots filled by cues that did not parse
+    if (cues & (1u << CUE_INTRODUCE)) return found(out, INTENT_INTRODUCE);
+    return false;
+  }
+
+  int automatonNodes() const { return automaton_.nodeCount(); }
+
+ private:
+  bool found(IntentMatch& out, IntentId intent) {
+    out.intent = intent;
+    return true;
+  }
+
+  // Parses the words after a cue, which must be used up completely
+  bool matchCommand(uint8_t cue, int pos, int end, IntentMatch& out) {
+    switch (cue) {
+      case CUE_TIME_DATE:
+        return pos == end && found(out, INTENT_TIME_DATE);
+      case CUE_ALARM_STATUS:
+        return pos == end && found(out, INTENT_ALARM_STATUS);
+      case CUE_ALARM:
+        if (parseDuration(pos, end, out.seconds)) return found(out, INTENT_SET_TIMER);
+        if (parseClockTime(pos, end, out)) return found(out, INTENT_SET_ALARM);
+        return false;
+      case CUE_CANCEL:
+        return isAlarmTarget(pos, end) && found(out, INTENT_CANCEL_ALARM);
+      case CUE_ADD:
+        return parseItemAndList(pos, end, "to", "on", out) && found(out, INTENT_ADD_ITEM);
+      case CUE_REMOVE:
+        if (isAlarmTarget(pos, end)) return found(out, INTENT_CANCEL_ALARM);
+        return parseItemAndList(pos, end, "from", "off", out) && found(out, INTENT_REMOVE_ITEM);
+      case CUE_LIST_QUERY:
+        return parseListName(pos, end, true, out.list) && found(out, INTENT_LIST_ITEMS);
+      case CUE_CLEAR:
+        if (isAlarmTarget(pos, end)) return found(out, INTENT_CANCEL_ALARM);
+        return parseListName(pos, end, true, out.list) && found(out, INTENT_CLEAR_LIST);
+    }
+    return false;
+  }
+
+  static bool isOneOf(const String& word, const char* const* set, size_t n) {
+    for (size_t i = 0; i < n; i++) if (word == set[i]) return true;
+    return false;
+  }
+
+  bool leadIsFiller(int first) const {
+    for (int i = 0; i < first; i++) {
+      if (!isOneOf(words_[i], INTENT_LEAD_FILLERS, sizeof(INTENT_LEAD_FILLERS) / sizeof(INTENT_LEAD_FILLERS[0]))) return false;
+    }
+    return true;
+  }
+
+  // End of the request without trailing fillers ("... from now, please")
+  int trimTail(int end) const {
+    for (;;) {
+      bool trimmed = false;
+      for (const auto& pair : INTENT_TAIL_PAIRS) {
+        if (end >= 2 && words_[end - 2] == pair[0] && words_[end - 1] == pair[1]) { end -= 2; trimmed = true; }
+      }
+      if (end >= 1 && isOneOf(words_[end - 1], INTENT_TAIL_FILLERS, sizeof(INTENT_TAIL_FILLERS) / sizeof(INTENT_TAIL_FILLERS[0]))) {
+        end--;
+        trimmed = true;
+      }
+      if (!trimmed) return end;
+    }
+  }
+
+  // "the alarm", "my timer", "all alarms", ...
+  bool isAlarmTarget(int pos, int end) const {
+    static const char* const DETERMINERS[] = {"the", "my", "that", "this", "all", "current"};
+    while (pos < end && isOneOf(words_[pos], DETERMINERS, 6)) pos++;
+    if (pos + 1 != end) return false;
+    const String& w = words_[pos];
+    return w == "alarm" || w == "alarms" || w == "timer" || w == "timers";
+  }
+
+  // Cardinal number in digits or words (up to 99); "a"/"an" count as one
+  bool parseNumber(int& pos, int end, int& value) const {
+    static const char* const ONES[] = {"zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
+                                       "ten", "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen",
+                                       "seventeen", "eighteen", "nineteen"};
+    static const char* const TENS[] = {"twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty", "ninety"};
+    if (pos >= end) return false;
+    const String& w = words_[pos];
+    if (isdigit((uint8_t)w[0])) {
+      for (size_t i = 0; i < w.length(); i++) if (!isdigit((uint8_t)w[i])) return false;
+      value = w.toInt();
+      pos++;
+      return true;
+    }
+    if (w == "a" || w == "an") { value = 1; pos++; return true; }
+    for (int i = 0; i < 20; i++) {
+      if (w == ONES[i]) { value = i; pos++; return true; }
+    }
+    for (int i = 0; i < 8; i++) {
+      if (w != TENS[i]) continue;
+      value = (i + 2) * 10;
+      pos++;
+      for (int j = 1; j < 10 && pos < end; j++) {
+        if (words_[pos] == ONES[j]) { value += j; pos++; break; }
+      }
+      return true;
+    }
+    return false;
+  }
+
+  static uint32_t unitSeconds(const String& w) {
+    if (w == "second" || w == "seconds" || w == "sec" || w == "secs") return 1;
+    if (w == "minute" || w == "minutes" || w == "min" || w == "mins") return 60;
+    if (w == "hour" || w == "hours" || w == "hr" || w == "hrs") return 3600;
+    return 0;
+  }
+
+  // "5 minutes", "an hour and a half", "1 hour 30 minutes", "half an hour"
+  bool parseDuration(int pos, int end, uint32_t& seconds) const {
+    seconds = 0;
+    bool any = false;
+    while (pos < end) {
+      if (any && words_[pos] == "and") pos++;
+      bool half = false;
+      int value = 0;
+      if (pos + 1 < end && words_[pos] == "half" && (words_[pos + 1] == "an" || words_[pos + 1] == "a")) {
+        pos += 2;
+        half = true;
+      } else if (!parseNumber(pos, end, value)) {
+        return false;
+      }
+      bool andHalf = pos + 2 < end && words_[pos] == "and" && words_[pos + 1] == "a" && words_[pos + 2] == "half";
+      if (andHalf) pos += 3;                         // "one and a half hours"
+      if (pos >= end) return false;
+      uint32_t unit = unitSeconds(words_[pos++]);
+      if (unit == 0) return false;
+      if (!andHalf && pos + 3 <= end && words_[pos] == "and" && words_[pos + 1] == "a" && words_[pos + 2] == "half") {
+        andHalf = true;                              // "an hour and a half"
+        pos += 3;
+      }
+      seconds += half ? unit / 2 : value * unit + (andHalf ? unit / 2 : 0);
+      any = true;
+    }
+    return any && seconds > 0;
+  }
+
+  // "7 am", "7:30 pm", "seven thirty pm", "6 oclock in the evening", "noon", "midnight"
+  bool parseClockTime(int pos, int end, IntentMatch& out) const {
+    if (pos + 1 == end && (words_[pos] == "noon" || words_[pos] == "midnight")) {
+      out.hour = 12;
+      out.minute = 0;
+      out.pm = words_[pos] == "noon";
+      return true;
+    }
+    int hour = -1, minute = 0;
+    if (pos >= end) return false;
+    const String& w = words_[pos];
+    int sep = max(w.indexOf(':'), w.indexOf('.'));
+    if (sep > 0) {
+      if (w.length() - sep - 1 != 2) return false;   // "1.5" is no clock time
+      hour = w.substring(0, sep).toInt();
+      minute = w.substring(sep + 1).toInt();
+      pos++;
+    } else if (isdigit((uint8_t)w[0]) && (w.length() == 3 || w.length() == 4)) {
+      int v = w.toInt();                             // "730 pm"
+      hour = v / 100;
+      minute = v % 100;
+      pos++;
+    } else {
+      if (w == "a" || w == "an" || !parseNumber(pos, end, hour)) return false;
+      int next = pos, m = 0;
+      if (pos < end && words_[pos] == "oh") {        // "seven oh five"
+        next = pos + 1;
+        if (!parseNumber(next, end, m) || m > 9) return false;
+        minute = m;
+        pos = next;
+      } else if (parseNumber(next, end, m) && m >= 10) {   // "seven thirty"
+        minute = m;
+        pos = next;
+      }
+    }
+    if (pos < end && words_[pos] == "oclock") pos++;
+    bool pm;
+    if (pos + 1 == end && (words_[pos] == "am" || words_[pos] == "pm")) {
+      pm = words_[pos] == "pm";
+    } else if (pos + 3 == end && words_[pos] == "in" && words_[pos + 1] == "the") {
+      if (words_[pos + 2] == "morning") pm = false;
+      else if (words_[pos + 2] == "afternoon" || words_[pos + 2] == "evening") pm = true;
+      else return false;
+    } else if (pos + 1 == end && words_[pos] == "tonight") {
+      pm = true;
+    } else {
+      return false;                                  // No am/pm: let the model ask
+    }
+    if (hour < 1 || hour > 12 || minute < 0 || minute > 59) return false;
+    out.hour = hour;
+    out.minute = minute;
+    out.pm = pm;
+    return true;
+  }
+
+  // [my|the|our] name [list]. The name must come after a determiner or before "list",
+  // so "add a reminder to call mom" is not taken for a list called "call mom".
+  // Requests that only name a list ("show me the news") need the word "list" itself.
+  bool parseListName(int pos, int end, bool needListWord, String& list) const {
+    bool marked = false;
+    if (pos < end && (words_[pos] == "my" || words_[pos] == "the" || words_[pos] == "our")) {
+      pos++;
+      marked = true;
+    }
+    bool listWord = end > pos && (words_[end - 1] == "list" || words_[end - 1] == "lists");
+    if (listWord) end--;
+    if (!(listWord || (marked && !needListWord))) return false;
+    if (end - pos < 1 || end - pos > INTENT_MAX_LIST_WORDS) return false;
+    list = joinWords(pos, end);
+    return true;
+  }
+
+  // [qty] item <sep> list; sep is the last "to"/"on" (or "from"/"off") in the request
+  // that is not the start of "to do"
+  bool parseItemAndList(int pos, int end, const char* sep1, const char* sep2, IntentMatch& out) const {
+    int sep = -1;
+    for (int i = end - 1; i > pos; i--) {
+      if (words_[i] == "to" && i + 1 < end && words_[i + 1] == "do") continue;   // The "to do" list
+      if (words_[i] == sep1 || words_[i] == sep2) { sep = i; break; }
+    }
+    if (sep < 0) return false;
+    int listStart = sep + 1;
+    if (listStart < end && words_[sep] == "off" && words_[listStart] == "of") listStart++;   // "off of my list"
+    if (!parseListName(listStart, end, false, out.list)) return false;
+
+    int itemStart = pos, qty = 0;
+    if (parseNumber(itemStart, sep, qty)) {
+      if (words_[pos] == "a" || words_[pos] == "an") qty = 0;   // "a loaf of bread": no count
+    } else if (words_[pos] == "some" || words_[pos] == "the") {
+      itemStart++;
+    }
+    int itemWords = sep - itemStart;
+    if (itemWords < 1 || itemWords > INTENT_MAX_ITEM_WORDS) return false;
+    for (int i = itemStart; i < sep; i++) {
+      if (words_[i] == "and" || words_[i] == "to" || words_[i] == "from") return false;   // Several items: model
+    }
+    out.quantity = qty;
+    out.item = joinWords(itemStart, sep);
+    return true;
+  }
+
+  String joinWords(int from, int to) const {
+    String s;
+    for (int i = from; i < to; i++) {
+      if (i > from) s += ' ';
+      s += words_[i];
+    }
+    return s;
+  }
+
+  PhraseAutomaton automaton_;
+  std::vector<String> words_;
+};
@@ -0,0 +1,93 @@
+/*
+================================================================================
+  KIKO - Latency histograms and span timing
+================================================================================
+  Always-on instrumentation for the voice pipeline:
+
+  - LatencyHistogram: fixed buckets (10 ms .. 30 s and +Inf), a count and a
+    sum, updated with relaxed atomics so any task can record without a lock.
+    Memory and cost per sample are constant; nothing is allocated.
+  - SpanTimer: times a scope with the monotonic microsecond clock and
+    records it into a histogram when the scope ends.
+  - appendPrometheus() writes one histogram in the Prometheus text format
+    (seconds, cumulative "le" buckets); quantileMs() gives a bucket-bound
+    estimate for the dashboard.
+
+  Readers may see a sample counted in one field and not yet in another;
+  that is fine for monitoring.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define METRIC_BUCKETS 12
+
+// Upper bounds of the finite buckets, in ms; the last bucket is +Inf
+static const uint32_t METRIC_BUCKET_MS[METRIC_BUCKETS - 1] = {
+  10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000
+};
+
+class LatencyHistogram {
+ public:
+  void record(uint32_t ms) {
+    int b = 0;
+    while (b < METRIC_BUCKETS - 1 && ms > METRIC_BUCKET_MS[b]) b++;
+    buckets_[b].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumMs_.fetch_add(ms, std::memory_order_relaxed);
+  }
+
+  uint32_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint32_t sumMs() const { return sumMs_.load(std::memory_order_relaxed); }
+
+  // Upper bound of the bucket holding quantile q (0..1); 0 without samples
+  uint32_t quantileMs(float q) const {
+    uint32_t total = count();
+    if (total == 0) return 0;
+    uint32_t rank = (uint32_t)(q * total + 0.5f);
+    if (rank == 0) rank = 1;
+    uint32_t seen = 0;
+    for (int b = 0; b < METRIC_BUCKETS - 1; b++) {
+      seen += buckets_[b].load(std::memory_order_relaxed);
+      if (seen >= rank) return METRIC_BUCKET_MS[b];
+    }
+    return METRIC_BUCKET_MS[METRIC_BUCKETS - 2];   // In the +Inf bucket: at least the last bound
+  }
+
+  // name_bucket{label="value",le="..."} lines plus _sum and _count
+  void appendPrometheus(String& out, const char* name, const char* label, const char* value) const {
+    char line[160];
+    uint32_t cumulative = 0;
+    for (int b = 0; b < METRIC_BUCKETS; b++) {
+      cumulative += buckets_[b].load(std::memory_order_relaxed);
+      if (b < METRIC_BUCKETS - 1) {
+        snprintf(line, sizeof(line), "%s_bucket{%s=\"%s\",le=\"%g\"} %u\n", name, label, value,
+                 METRIC_BUCKET_MS[b] / 1000.0, cumulative);
+      } else {
+        snprintf(line, sizeof(line), "%s_bucket{%s=\"%s\",le=\"+Inf\"} %u\n", name, label, value, cumulative);
+      }
+      out += line;
+    }
+    snprintf(line, sizeof(line), "%s_sum{%s=\"%s\"} %.3f\n%s_count{%s=\"%s\"} %u\n",
+             name, label, value, sumMs() / 1000.0, name, label, value, count());
+    out += line;
+  }
+
+ private:
+  std::atomic<uint32_t> buckets_[METRIC_BUCKETS] = {};
+  std::atomic<uint32_t> count_{0};
+  std::atomic<uint32_t> sumMs_{0};
+};
+
+// Records the lifetime of the enclosing scope into a histogram
+class SpanTimer {
+ public:
+  explicit SpanTimer(LatencyHistogram& hist) : hist_(hist), start_(micros()) {}
+  ~SpanTimer() { hist_.record((micros() - start_) / 1000); }
+
+ private:
+  LatencyHistogram& hist_;
+  unsigned long start_;
+};
@@ -0,0 +1,219 @@
+/*
+================================================================================
+  KIKO - Tool result cache with request coalescing
+================================================================================
+  Results of network-bound tools (weather, search) keyed by tool name and
+  normalized arguments, so asking for the same city twice in a few minutes
+  costs one upstream request.
+
+  - Per-entry TTL chosen by the caller; timestamps are wall-clock seconds so
+    entries restored from flash after a reboot keep their age.
+  - Coalescing: the first caller of a missing key becomes the leader and
+    fetches; callers of the same key that arrive meanwhile wait for its
+    result instead of issuing their own request. They get the leader's
+    outcome too: a failed fetch is not repeated once per waiter.
+  - Stale-if-error: expired entries are kept (up to their stale limit) and
+    handed out when the upstream fetch fails.
+  - Bounded: at most RESULT_CACHE_MAX_ENTRIES; the oldest idle entry goes.
+
+  Waiting uses one binary semaphore per in-flight key that waiters pass on
+  to each other (take, then give back), so every waiter wakes up.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#define RESULT_CACHE_MAX_ENTRIES 24
+#define RESULT_CACHE_WAIT_MS 15000       // Longest a waiter waits for the leader
+
+struct ResultCacheStats {
+  uint32_t hits = 0;
+  uint32_t misses = 0;          // Lookups that led to an upstream fetch
+  uint32_t coalesced = 0;       // Lookups that waited for another caller's fetch
+  uint32_t staleServed = 0;     // Failed fetches answered from an expired entry
+  uint32_t fetchFailures = 0;
+  uint32_t fetchMsTotal = 0;
+  uint32_t fetchMsMax = 0;
+};
+
+struct ResultCacheEntry {
+  String key;
+  String value;
+  uint32_t storedAt = 0;        // Wall-clock seconds; 0 while nothing was stored yet
+  uint32_t ttl = 0;
+  uint32_t staleFor = 0;        // How long after expiry the value may still be used on errors
+  bool inFlight = false;
+  uint8_t waiters = 0;
+  String result;                // The leader's answer and outcome, kept for its waiters
+  bool resultOk = false;
+  SemaphoreHandle_t ready = nullptr;
+};
+
+class ResultCache {
+ public:
+  void begin() { lock_ = xSemaphoreCreateMutex(); }
+
+  // Returns the fresh cached value, or fetch()'s result. fetch(value) returns false on an
+  // upstream failure; a stale value is used then if there is one, else fetch's own text.
+  // Returns true if the result came from the cache or a successful fetch.
+  template <typename FetchFn>
+  bool get(const String& key, uint32_t now, uint32_t ttl, uint32_t staleFor, String& value, FetchFn fetch) {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    ResultCacheEntry* e = find(key);
+    if (e && !e->inFlight && e->storedAt && now - e->storedAt < e->ttl) {
+      value = e->value;
+      stats_.hits++;
+      xSemaphoreGive(lock_);
+      return true;
+    }
+    if (e && e->inFlight) return waitFor(e, now, value);   // Releases the lock
+    if (!e) e = allocate(key);
+    if (!e) {                                         // Every slot busy: fetch uncached
+      stats_.misses++;
+      xSemaphoreGive(lock_);
+      return fetch(value);
+    }
+    e->inFlight = true;
+    if (!e->ready) e->ready = xSemaphoreCreateBinary();
+    stats_.misses++;
+    xSemaphoreGive(lock_);
+
+    unsigned long start = millis();
+    String fetched;
+    bool ok = fetch(fetched);
+    uint32_t elapsed = millis() - start;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    stats_.fetchMsTotal += elapsed;
+    if (elapsed > stats_.fetchMsMax) stats_.fetchMsMax = elapsed;
+    if (ok) {
+      e->value = fetched;
+      e->storedAt = now;
+      e->ttl = ttl;
+      e->staleFor = staleFor;
+      dirty_ = true;
+    } else {
+      stats_.fetchFailures++;
+    }
+    bool stale = !ok && e->storedAt && now - e->storedAt < e->ttl + e->staleFor;
+    if (stale) stats_.staleServed++;
+    value = (ok || stale) ? e->value : fetched;
+    e->inFlight = false;
+    if (e->waiters > 0) {
+      e->result = value;
+      e->resultOk = ok || stale;
+      xSemaphoreGive(e->ready);
+    } else {
+      finishFlight(e);
+    }
+    xSemaphoreGive(lock_);
+    return ok || stale;
+  }
+
+  // Restores an entry loaded from flash (setup only)
+  void restore(const String& key, const String& value, uint32_t storedAt, uint32_t ttl, uint32_t staleFor) {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    ResultCacheEntry* e = find(key);
+    if (!e) e = allocate(key);
+    if (e) {
+      e->value = value;
+      e->storedAt = storedAt;
+      e->ttl = ttl;
+      e->staleFor = staleFor;
+    }
+    xSemaphoreGive(lock_);
+  }
+
+  // Calls fn(entry) for every stored entry and clears the dirty flag. fn must not use the cache.
+  template <typename Fn>
+  void forEachStored(Fn fn) {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    for (const ResultCacheEntry& e : entries_) {
+      if (e.storedAt) fn(e);
+    }
+    dirty_ = false;
+    xSemaphoreGive(lock_);
+  }
+
+  bool dirty() const { return dirty_; }
+
+  ResultCacheStats stats() {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    ResultCacheStats s = stats_;
+    xSemaphoreGive(lock_);
+    return s;
+  }
+
+  int size() {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    int n = entries_.size();
+    xSemaphoreGive(lock_);
+    return n;
+  }
+
+ private:
+  ResultCacheEntry* find(const String& key) {
+    for (ResultCacheEntry& e : entries_) {
+      if (e.key == key) return &e;
+    }
+    return nullptr;
+  }
+
+  // New entry for key, replacing the oldest idle one when full. Caller holds lock_.
+  ResultCacheEntry* allocate(const String& key) {
+    if (entries_.size() < RESULT_CACHE_MAX_ENTRIES) {
+      entries_.reserve(RESULT_CACHE_MAX_ENTRIES);   // Entry pointers must stay valid
+      entries_.emplace_back();
+      entries_.back().key = key;
+      return &entries_.back();
+    }
+    ResultCacheEntry* oldest = nullptr;
+    for (ResultCacheEntry& e : entries_) {
+      if (e.inFlight || e.waiters > 0) continue;
+      if (!oldest || e.storedAt < oldest->storedAt) oldest = &e;
+    }
+    if (!oldest) return nullptr;
+    oldest->key = key;
+    oldest->value = String();
+    oldest->storedAt = 0;
+    return oldest;
+  }
+
+  // Waits for the leader of e and takes its result; called with lock_ held, returns with it
+  // released. If the leader takes too long, only a usable stored value is returned.
+  bool waitFor(ResultCacheEntry* e, uint32_t now, String& value) {
+    e->waiters++;
+    stats_.coalesced++;
+    SemaphoreHandle_t ready = e->ready;
+    xSemaphoreGive(lock_);
+    bool woke = xSemaphoreTake(ready, pdMS_TO_TICKS(RESULT_CACHE_WAIT_MS)) == pdTRUE;
+    if (woke) xSemaphoreGive(ready);   // Pass it on to the next waiter
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    bool ok;
+    if (woke) {
+      ok = e->resultOk;
+      value = e->result;
+    } else {
+      ok = e->storedAt && now - e->storedAt < e->ttl + e->staleFor;
+      value = ok ? e->value : String();
+    }
+    e->waiters--;
+    if (e->waiters == 0 && !e->inFlight) finishFlight(e);
+    xSemaphoreGive(lock_);
+    return ok;
+  }
+
+  // The last party of a flight leaves the semaphore cleared for the next one
+  void finishFlight(ResultCacheEntry* e) {
+    xSemaphoreTake(e->ready, 0);
+    e->result = String();
+  }
+
+  std::vector<ResultCacheEntry> entries_;
+  SemaphoreHandle_t lock_ = nullptr;
+  ResultCacheStats stats_;
+  bool dirty_ = false;
+};
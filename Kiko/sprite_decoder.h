@@ -0,0 +1,71 @@
+/*
+================================================================================
+  KIKO - Streaming decoder for compressed OLED sprites
+================================================================================
+  Sprites are built by tools/sprite_compiler.py into sprites.h. Each frame is
+  stored in U8g2 page order (one byte = 8 vertical pixels), so runs decode
+  straight into the tile buffer: no bit shuffling and no scratch frame.
+
+  Frame stream: one kind byte (SPRITE_KEY or SPRITE_DELTA), then runs
+    0x00-0x7F  c + 1 literal bytes follow
+    0x80-0xFF  the next byte repeated (c & 0x7F) + 2 times
+  A key frame overwrites its area; a delta is XORed onto the previous frame,
+  so drawing a delta frame first draws the key frame before it and replays
+  the deltas in between (the compiler keeps those chains short). Zero runs in
+  a delta are skipped without touching the buffer.
+
+  Sprites are opaque and their top edge must sit on a page (y % 8 == 0).
+  Parts outside the buffer are clipped.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define SPRITE_KEY 0
+#define SPRITE_DELTA 1
+
+struct SpriteSet {
+  uint8_t width;
+  uint8_t height;            // Multiple of 8
+  uint8_t frameCount;
+  uint16_t frameDelayMs;     // Animation speed from the source (0 for still images)
+  const uint16_t* offsets;   // frameCount + 1 offsets into data
+  const uint8_t* data;
+};
+
+// Decodes one frame stream onto buf (page-major, bufWidth bytes per page, bufPages pages)
+inline void spriteApplyFrame(uint8_t* buf, int bufWidth, int bufPages, const SpriteSet& s, uint8_t frame,
+                             int x, int page) {
+  const uint8_t* p = s.data + s.offsets[frame];
+  const uint8_t* end = s.data + s.offsets[frame + 1];
+  bool delta = *p++ == SPRITE_DELTA;
+  int col = 0, pg = 0;
+  while (p < end) {
+    uint8_t c = *p++;
+    bool run = c >= 0x80;
+    int n = run ? (c & 0x7F) + 2 : c + 1;
+    uint8_t v = run ? *p++ : 0;
+    if (run && delta && v == 0) {   // Unchanged span: just move on
+      col += n;
+      while (col >= s.width) { col -= s.width; pg++; }
+      continue;
+    }
+    while (n-- > 0) {
+      if (!run) v = *p++;
+      int dx = x + col, dp = page + pg;
+      if (dx >= 0 && dx < bufWidth && dp >= 0 && dp < bufPages) {
+        uint8_t* d = buf + dp * bufWidth + dx;
+        *d = delta ? *d ^ v : v;
+      }
+      if (++col == s.width) { col = 0; pg++; }
+    }
+  }
+}
+
+inline void spriteDraw(uint8_t* buf, int bufWidth, int bufPages, const SpriteSet& s, uint8_t frame, int x, int page) {
+  if (frame >= s.frameCount) return;
+  uint8_t key = frame;
+  while (key > 0 && s.data[s.offsets[key]] != SPRITE_KEY) key--;
+  for (uint8_t f = key; f <= frame; f++) spriteApplyFrame(buf, bufWidth, bufPages, s, f, x, page);
+}
@@ -0,0 +1,250 @@
+/*
+  Generated by tools/sprite_compiler.py from assets/sprites/sprites.txt.
+  Do not edit; change the sources and run the compiler again.
+
+  sprite           frames deltas  XBM bytes  encoded
+  time_date_icon        1      0       1024      440
+  mic_icon              1      0       1024      205
+  weather_icon          1      0       1024      185
+  speaking_sprite      28     24       8064     2595
+  total                               11136     3425
+*/
+#pragma once
+
+#include "sprite_decoder.h"
+
+// time_date.png
+const uint8_t time_date_icon_data[] PROGMEM = {
+  0x00, 0x9c, 0x00, 0x80, 0x80, 0x82, 0xc0, 0x82, 0xe0, 0x83, 0xf0, 0x80, 0xf8, 0x84, 0x78, 0x00,
+  0x38, 0x92, 0x3c, 0x00, 0x38, 0x84, 0x78, 0x80, 0xf8, 0x83, 0xf0, 0x82, 0xe0, 0x82, 0xc0, 0x80,
+  0x80, 0xaa, 0x00, 0x00, 0x80, 0x80, 0xc0, 0x00, 0xe0, 0x80, 0xf0, 0x80, 0xf8, 0x80, 0xfc, 0x00,
+  0x7e, 0x80, 0x3e, 0x80, 0x1f, 0x81, 0x0f, 0x81, 0x07, 0x81, 0x03, 0x82, 0x01, 0x84, 0x00, 0x80,
+  0x80, 0x80, 0xc0, 0x81, 0x80, 0x92, 0x00, 0x80, 0x80, 0x80, 0xc0, 0x80, 0x80, 0x83, 0x00, 0x82,
+  0x01, 0x81, 0x03, 0x81, 0x07, 0x81, 0x0f, 0x80, 0x1f, 0x80, 0x3e, 0x00, 0x7e, 0x80, 0xfc, 0x80,
+  0xf8, 0x80, 0xf0, 0x00, 0xe0, 0x80, 0xc0, 0x00, 0x80, 0x93, 0x00, 0x03, 0xc0, 0xe0, 0xf8, 0xfc,
+  0x80, 0xfe, 0x80, 0xff, 0x02, 0x3f, 0x1f, 0x0f, 0x80, 0x07, 0x01, 0x03, 0x01, 0x87, 0x00, 0x01,
+  0xe0, 0xf0, 0x80, 0xf8, 0x00, 0x1c, 0x8a, 0x0c, 0x85, 0xff, 0x92, 0x0c, 0x85, 0xff, 0x88, 0x0c,
+  0x00, 0x1c, 0x80, 0xf8, 0x01, 0xf0, 0xe0, 0x87, 0x00, 0x01, 0x01, 0x03, 0x80, 0x07, 0x02, 0x0f,
+  0x1f, 0x3f, 0x80, 0xff, 0x00, 0xfe, 0x80, 0xfc, 0x02, 0xf8, 0xe0, 0xc0, 0x89, 0x00, 0x01, 0xf0,
+  0xfe, 0x84, 0xff, 0x01, 0x1f, 0x03, 0x8f, 0x00, 0x82, 0xff, 0x8c, 0x18, 0x83, 0x19, 0x84, 0x18,
+  0x86, 0x98, 0x86, 0x18, 0x83, 0x19, 0x8a, 0x18, 0x82, 0xff, 0x8f, 0x00, 0x01, 0x03, 0x1f, 0x84,
+  0xff, 0x01, 0xfe, 0xf0, 0x86, 0x00, 0x01, 0x0f, 0x7f, 0x84, 0xff, 0x01, 0xf8, 0xc0, 0x8f, 0x00,
+  0x82, 0xff, 0x8c, 0x00, 0x00, 0xe0, 0x80, 0xf8, 0x02, 0xfc, 0xfe, 0xbe, 0x86, 0xbf, 0x80, 0x81,
+  0x86, 0xff, 0x80, 0xfe, 0x00, 0xfc, 0x80, 0xf8, 0x00, 0xe0, 0x8c, 0x00, 0x82, 0xff, 0x8f, 0x00,
+  0x01, 0xc0, 0xf8, 0x84, 0xff, 0x01, 0x7f, 0x0f, 0x89, 0x00, 0x03, 0x03, 0x07, 0x1f, 0x3f, 0x80,
+  0x7f, 0x80, 0xff, 0x02, 0xfc, 0xf8, 0xf0, 0x80, 0xe0, 0x01, 0xc0, 0x80, 0x87, 0x00, 0x00, 0x7f,
+  0x81, 0xff, 0x81, 0x80, 0x8a, 0x00, 0x00, 0x03, 0x80, 0x07, 0x80, 0x0f, 0x81, 0x1f, 0x8a, 0x3f,
+  0x81, 0x1f, 0x80, 0x0f, 0x80, 0x07, 0x00, 0x03, 0x8a, 0x00, 0x81, 0x80, 0x81, 0xff, 0x00, 0x7f,
+  0x87, 0x00, 0x01, 0x80, 0xc0, 0x80, 0xe0, 0x02, 0xf0, 0xf8, 0xfc, 0x80, 0xff, 0x80, 0x7f, 0x03,
+  0x3f, 0x1f, 0x07, 0x03, 0x93, 0x00, 0x00, 0x01, 0x80, 0x03, 0x00, 0x07, 0x80, 0x0f, 0x80, 0x1f,
+  0x80, 0x3f, 0x00, 0x7e, 0x80, 0x7c, 0x80, 0xf8, 0x81, 0xf0, 0x00, 0xe0, 0x80, 0xe1, 0x81, 0xc1,
+  0x82, 0x83, 0xaa, 0x03, 0x82, 0x83, 0x00, 0xc3, 0x80, 0xc1, 0x80, 0xe1, 0x00, 0xe0, 0x81, 0xf0,
+  0x80, 0xf8, 0x80, 0x7c, 0x00, 0x7e, 0x80, 0x3f, 0x80, 0x1f, 0x80, 0x0f, 0x00, 0x07, 0x80, 0x03,
+  0x00, 0x01, 0xaa, 0x00, 0x80, 0x01, 0x82, 0x03, 0x82, 0x07, 0x83, 0x0f, 0x80, 0x1f, 0x84, 0x1e,
+  0x00, 0x1c, 0x92, 0x3c, 0x00, 0x1c, 0x84, 0x1e, 0x80, 0x1f, 0x83, 0x0f, 0x82, 0x07, 0x82, 0x03,
+  0x80, 0x01, 0x9c, 0x00,
+};
+const uint16_t time_date_icon_offsets[] PROGMEM = {0, 436};
+const SpriteSet time_date_icon = {128, 64, 1, 0, time_date_icon_offsets, time_date_icon_data};
+
+// mic.png
+const uint8_t mic_icon_data[] PROGMEM = {
+  0x00, 0xad, 0x00, 0x02, 0xc0, 0xe0, 0xf0, 0x80, 0xf8, 0x81, 0xfc, 0x81, 0xfe, 0x8a, 0xff, 0x81,
+  0xfe, 0x81, 0xfc, 0x80, 0xf8, 0x02, 0xf0, 0xe0, 0xc0, 0xdc, 0x00, 0xa0, 0xff, 0xc7, 0x00, 0x00,
+  0xe0, 0x81, 0xf0, 0x83, 0xf8, 0x80, 0xf0, 0x01, 0xe0, 0xc0, 0x86, 0x00, 0xa0, 0xff, 0x86, 0x00,
+  0x01, 0xc0, 0xe0, 0x80, 0xf0, 0x83, 0xf8, 0x81, 0xf0, 0x00, 0xe0, 0xb2, 0x00, 0x8b, 0xff, 0x86,
+  0x00, 0xa0, 0xff, 0x86, 0x00, 0x8b, 0xff, 0xb2, 0x00, 0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0x86,
+  0xff, 0x02, 0xfe, 0xf8, 0xf0, 0x80, 0xe0, 0x00, 0xc0, 0x80, 0x80, 0x03, 0x00, 0x01, 0x03, 0x07,
+  0x80, 0x0f, 0x81, 0x1f, 0x8e, 0x3f, 0x81, 0x1f, 0x80, 0x0f, 0x03, 0x07, 0x03, 0x01, 0x00, 0x80,
+  0x80, 0x00, 0xc0, 0x80, 0xe0, 0x02, 0xf0, 0xf8, 0xfe, 0x86, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f,
+  0x03, 0xb8, 0x00, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x80, 0x0f, 0x81, 0x1f, 0x81, 0x3f, 0x82,
+  0x7f, 0x00, 0xff, 0x82, 0xfe, 0x85, 0xfc, 0x84, 0xf8, 0x85, 0xfc, 0x82, 0xfe, 0x00, 0xff, 0x82,
+  0x7f, 0x81, 0x3f, 0x81, 0x1f, 0x80, 0x0f, 0x80, 0x07, 0x00, 0x03, 0x80, 0x01, 0xd5, 0x00, 0x90,
+  0xff, 0xdb, 0x00, 0x01, 0x10, 0x38, 0x80, 0x7c, 0x80, 0xfc, 0x89, 0xfe, 0x90, 0xff, 0x89, 0xfe,
+  0x80, 0xfc, 0x80, 0x7c, 0x01, 0x38, 0x10, 0xa4, 0x00,
+};
+const uint16_t mic_icon_offsets[] PROGMEM = {0, 201};
+const SpriteSet mic_icon = {128, 64, 1, 0, mic_icon_offsets, mic_icon_data};
+
+// weather.png
+const uint8_t weather_icon_data[] PROGMEM = {
+  0x00, 0xff, 0x00, 0xc8, 0x00, 0x81, 0xf8, 0xdf, 0x00, 0x80, 0x02, 0x80, 0x06, 0x80, 0x0c, 0x01,
+  0x1c, 0x18, 0x80, 0x30, 0x85, 0x00, 0x81, 0x80, 0x86, 0xc0, 0x81, 0xe1, 0x85, 0xc0, 0x81, 0x80,
+  0x85, 0x00, 0x01, 0x10, 0x30, 0x80, 0x18, 0x80, 0x0c, 0x80, 0x06, 0x01, 0x03, 0x02, 0xb5, 0x00,
+  0x80, 0x80, 0x00, 0xc0, 0x80, 0xe0, 0x80, 0x70, 0x00, 0x30, 0x80, 0x38, 0x80, 0x18, 0x00, 0x1c,
+  0x8d, 0x0c, 0x0a, 0x1c, 0x18, 0x19, 0x39, 0x3b, 0x33, 0x71, 0x61, 0xe1, 0xe0, 0xc0, 0x80, 0x80,
+  0x88, 0x00, 0x81, 0x01, 0x80, 0x03, 0x06, 0x07, 0x0f, 0x1e, 0xfe, 0xfc, 0xf8, 0xf0, 0x87, 0x00,
+  0x89, 0xc0, 0x00, 0x40, 0xa0, 0x00, 0x80, 0x80, 0x80, 0xc0, 0x80, 0xe0, 0x02, 0x70, 0x78, 0x3c,
+  0x80, 0x3f, 0x02, 0x0f, 0x03, 0x01, 0x9f, 0x00, 0x01, 0x01, 0x03, 0x80, 0x0f, 0x00, 0x07, 0x80,
+  0x06, 0x84, 0x07, 0x81, 0x06, 0x81, 0x0e, 0x03, 0x1c, 0x3c, 0x38, 0x79, 0x80, 0xf3, 0x02, 0xe3,
+  0xc0, 0x80, 0xb2, 0x00, 0x02, 0x0e, 0x1f, 0x3f, 0x80, 0x7f, 0x01, 0xf1, 0xe0, 0x80, 0xc0, 0xb5,
+  0x80, 0x81, 0xc0, 0x80, 0xe0, 0x06, 0xf0, 0x78, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0xba, 0x00, 0xb8,
+  0x01, 0xff, 0x00, 0xa6, 0x00,
+};
+const uint16_t weather_icon_offsets[] PROGMEM = {0, 181};
+const SpriteSet weather_icon = {128, 64, 1, 0, weather_icon_offsets, weather_icon_data};
+
+// speaking.png
+const uint8_t speaking_sprite_data[] PROGMEM = {
+  0x00, 0x89, 0x00, 0x00, 0xc0, 0x96, 0x00, 0x00, 0xc0, 0x89, 0x00, 0x80, 0x80, 0x87, 0x00, 0x00,
+  0xff, 0x87, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0x80, 0x87, 0x00, 0x00, 0xff, 0x87, 0x00, 0x80,
+  0x80, 0x80, 0xff, 0x82, 0x00, 0x01, 0xe0, 0xf0, 0x81, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xf0,
+  0x82, 0x00, 0x80, 0xff, 0x80, 0x00, 0x80, 0xff, 0x82, 0x00, 0x00, 0xf0, 0x82, 0x00, 0x00, 0xff,
+  0x81, 0x00, 0x01, 0xf0, 0xe0, 0x82, 0x00, 0x82, 0xff, 0x82, 0x00, 0x80, 0x0f, 0x81, 0x00, 0x00,
+  0xff, 0x82, 0x00, 0x00, 0x0f, 0x82, 0x00, 0x80, 0xff, 0x80, 0x00, 0x80, 0xff, 0x82, 0x00, 0x00,
+  0x0f, 0x82, 0x00, 0x00, 0xff, 0x81, 0x00, 0x80, 0x0f, 0x82, 0x00, 0x80, 0xff, 0x01, 0x01, 0x03,
+  0x87, 0x00, 0x00, 0xff, 0x87, 0x00, 0x00, 0x01, 0x82, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0xff,
+  0x87, 0x00, 0x01, 0x03, 0x01, 0x89, 0x00, 0x00, 0x03, 0x96, 0x00, 0x00, 0x03, 0x89, 0x00, 0x01,
+  0x89, 0x00, 0x00, 0x40, 0x96, 0x00, 0x00, 0x40, 0x89, 0x00, 0x00, 0x80, 0x92, 0x00, 0x01, 0x40,
+  0x80, 0x81, 0x00, 0x00, 0x80, 0x91, 0x00, 0x01, 0x60, 0x40, 0x84, 0x00, 0x00, 0x10, 0x90, 0x00,
+  0x00, 0x01, 0x8c, 0x00, 0x01, 0x08, 0x10, 0x9d, 0x00, 0x00, 0x80, 0x8c, 0x00, 0x00, 0x10, 0x85,
+  0x00, 0x01, 0x01, 0x02, 0x91, 0x00, 0x01, 0x02, 0x01, 0x81, 0x00, 0x00, 0x01, 0x91, 0x00, 0x01,
+  0x04, 0x02, 0x89, 0x00, 0x00, 0x02, 0x96, 0x00, 0x00, 0x02, 0x89, 0x00, 0x01, 0x89, 0x00, 0x00,
+  0x80, 0x96, 0x00, 0x00, 0x80, 0x8a, 0x00, 0x00, 0x80, 0x91, 0x00, 0x01, 0x20, 0x60, 0x8b, 0x00,
+  0x00, 0x01, 0x87, 0x00, 0x02, 0x10, 0x20, 0x01, 0x83, 0x00, 0x80, 0x08, 0x86, 0x00, 0x00, 0x08,
+  0x87, 0x00, 0x00, 0x01, 0x82, 0x00, 0x00, 0x08, 0x87, 0x00, 0x00, 0x08, 0x84, 0x00, 0x00, 0x80,
+  0x83, 0x00, 0x80, 0x10, 0x86, 0x00, 0x00, 0x10, 0x87, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0x10,
+  0x87, 0x00, 0x00, 0x10, 0x85, 0x00, 0x00, 0x01, 0x91, 0x00, 0x01, 0x04, 0x06, 0x8b, 0x00, 0x00,
+  0x80, 0x87, 0x00, 0x01, 0x08, 0x04, 0x89, 0x00, 0x00, 0x01, 0x96, 0x00, 0x00, 0x01, 0x89, 0x00,
+  0x01, 0xb9, 0x00, 0x00, 0x03, 0x87, 0x00, 0x01, 0x18, 0x10, 0x8b, 0x00, 0x00, 0x02, 0x87, 0x00,
+  0x03, 0x08, 0x18, 0x00, 0x01, 0x82, 0x00, 0x80, 0x04, 0x86, 0x00, 0x00, 0x04, 0x86, 0x00, 0x80,
+  0x02, 0x82, 0x00, 0x00, 0x04, 0x86, 0x00, 0x80, 0x04, 0x85, 0x00, 0x00, 0x80, 0x82, 0x00, 0x80,
+  0x20, 0x86, 0x00, 0x00, 0x20, 0x86, 0x00, 0x80, 0x40, 0x82, 0x00, 0x00, 0x20, 0x86, 0x00, 0x80,
+  0x20, 0x8f, 0x00, 0x00, 0xc0, 0x87, 0x00, 0x01, 0x18, 0x08, 0x8b, 0x00, 0x00, 0x40, 0x87, 0x00,
+  0x01, 0x10, 0x18, 0xae, 0x00, 0x01, 0xb9, 0x00, 0x00, 0x04, 0x87, 0x00, 0x01, 0x04, 0x0c, 0x8b,
+  0x00, 0x00, 0x04, 0x87, 0x00, 0x80, 0x04, 0x80, 0x02, 0x95, 0x00, 0x00, 0x04, 0x8c, 0x00, 0x80,
+  0x02, 0x84, 0x00, 0x80, 0x40, 0x95, 0x00, 0x00, 0x20, 0x8c, 0x00, 0x80, 0x40, 0x8f, 0x00, 0x00,
+  0x20, 0x87, 0x00, 0x01, 0x20, 0x30, 0x8b, 0x00, 0x00, 0x20, 0x87, 0x00, 0x80, 0x20, 0xae, 0x00,
+  0x01, 0xb9, 0x00, 0x00, 0x08, 0x87, 0x00, 0x80, 0x02, 0x8b, 0x00, 0x00, 0x18, 0x87, 0x00, 0x01,
+  0x03, 0x02, 0x80, 0x04, 0x82, 0x00, 0x80, 0x02, 0x86, 0x00, 0x00, 0x02, 0x87, 0x00, 0x00, 0x04,
+  0x82, 0x00, 0x00, 0x02, 0x86, 0x00, 0x80, 0x01, 0x84, 0x00, 0x80, 0x20, 0x82, 0x00, 0x80, 0x40,
+  0x86, 0x00, 0x00, 0x40, 0x87, 0x00, 0x00, 0x20, 0x82, 0x00, 0x00, 0x40, 0x86, 0x00, 0x80, 0x80,
+  0x8f, 0x00, 0x00, 0x10, 0x87, 0x00, 0x80, 0x40, 0x8b, 0x00, 0x00, 0x18, 0x87, 0x00, 0x01, 0xc0,
+  0x40, 0xae, 0x00, 0x01, 0x93, 0x00, 0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x8a, 0x00, 0x00, 0x10,
+  0x87, 0x00, 0x80, 0x01, 0x8b, 0x00, 0x00, 0x20, 0x81, 0x00, 0x00, 0x80, 0x84, 0x00, 0x01, 0x01,
+  0x08, 0x83, 0x00, 0x80, 0x01, 0x86, 0x00, 0x00, 0x01, 0x86, 0x00, 0x80, 0x08, 0x82, 0x00, 0x00,
+  0x01, 0x8e, 0x00, 0x00, 0x10, 0x83, 0x00, 0x80, 0x80, 0x86, 0x00, 0x00, 0x80, 0x86, 0x00, 0x80,
+  0x10, 0x82, 0x00, 0x00, 0x80, 0x99, 0x00, 0x00, 0x08, 0x87, 0x00, 0x80, 0x80, 0x8b, 0x00, 0x00,
+  0x04, 0x81, 0x00, 0x00, 0x01, 0x84, 0x00, 0x00, 0x80, 0x93, 0x00, 0x00, 0x01, 0x96, 0x00, 0x01,
+  0x01, 0x00, 0x01, 0x93, 0x00, 0x01, 0x40, 0xc0, 0x95, 0x00, 0x01, 0x40, 0xc0, 0x85, 0x00, 0x00,
+  0x80, 0x81, 0x00, 0x00, 0x60, 0x96, 0x00, 0x00, 0x40, 0x82, 0x00, 0x00, 0x80, 0x84, 0x00, 0x01,
+  0x10, 0x08, 0x95, 0x00, 0x00, 0x10, 0x94, 0x00, 0x01, 0x08, 0x10, 0x95, 0x00, 0x00, 0x08, 0x9f,
+  0x00, 0x00, 0x06, 0x96, 0x00, 0x00, 0x03, 0x82, 0x00, 0x00, 0x01, 0x99, 0x00, 0x01, 0x02, 0x03,
+  0x95, 0x00, 0x01, 0x02, 0x03, 0x00, 0x93, 0x00, 0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x85, 0x00,
+  0x80, 0xc0, 0x81, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0xc0, 0x82, 0x00, 0x80, 0xff, 0x86, 0x00,
+  0x00, 0xc0, 0x86, 0x00, 0x01, 0xe0, 0xc0, 0x82, 0x00, 0x80, 0xff, 0x80, 0xf0, 0x82, 0x00, 0x80,
+  0xff, 0x81, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x80, 0xff, 0x80, 0x00, 0x80,
+  0xf0, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xff, 0x81, 0x00, 0x80, 0xff, 0x82, 0x00, 0x80,
+  0xff, 0x80, 0x0f, 0x82, 0x00, 0x80, 0xff, 0x81, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xff, 0x82,
+  0x00, 0x80, 0xff, 0x80, 0x00, 0x80, 0x0f, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xff, 0x81,
+  0x00, 0x80, 0xff, 0x82, 0x00, 0x80, 0xff, 0x84, 0x00, 0x80, 0x03, 0x81, 0x00, 0x00, 0x01, 0x82,
+  0x00, 0x00, 0x03, 0x82, 0x00, 0x80, 0xff, 0x86, 0x00, 0x00, 0x03, 0x86, 0x00, 0x01, 0x07, 0x03,
+  0x82, 0x00, 0x80, 0xff, 0x93, 0x00, 0x00, 0x01, 0x96, 0x00, 0x01, 0x01, 0x00, 0x01, 0x93, 0x00,
+  0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x85, 0x00, 0x80, 0x20, 0x81, 0x00, 0x00, 0x80, 0x82, 0x00,
+  0x00, 0x20, 0x83, 0x00, 0x00, 0x01, 0x86, 0x00, 0x00, 0x20, 0x86, 0x00, 0x01, 0x10, 0x30, 0x82,
+  0x00, 0x80, 0x01, 0x80, 0x08, 0x95, 0x00, 0x80, 0x08, 0x87, 0x00, 0x00, 0x01, 0x89, 0x00, 0x80,
+  0x10, 0x95, 0x00, 0x80, 0x10, 0x87, 0x00, 0x00, 0x80, 0x8f, 0x00, 0x80, 0x04, 0x81, 0x00, 0x00,
+  0x01, 0x82, 0x00, 0x00, 0x04, 0x83, 0x00, 0x00, 0x80, 0x86, 0x00, 0x00, 0x04, 0x86, 0x00, 0x01,
+  0x08, 0x0c, 0x82, 0x00, 0x80, 0x80, 0x93, 0x00, 0x00, 0x01, 0x96, 0x00, 0x01, 0x01, 0x00, 0x01,
+  0xb4, 0x00, 0x01, 0x10, 0x18, 0x86, 0x00, 0x00, 0x10, 0x82, 0x00, 0x01, 0x03, 0x02, 0x86, 0x00,
+  0x00, 0x10, 0x86, 0x00, 0x80, 0x08, 0x82, 0x00, 0x80, 0x02, 0x01, 0x00, 0x04, 0x87, 0x00, 0x00,
+  0x01, 0x8c, 0x00, 0x00, 0x04, 0x87, 0x00, 0x00, 0x02, 0x8a, 0x00, 0x00, 0x20, 0x87, 0x00, 0x00,
+  0x80, 0x8c, 0x00, 0x00, 0x20, 0x87, 0x00, 0x00, 0x40, 0x8f, 0x00, 0x01, 0x08, 0x18, 0x86, 0x00,
+  0x00, 0x08, 0x82, 0x00, 0x01, 0xc0, 0x40, 0x86, 0x00, 0x00, 0x08, 0x86, 0x00, 0x80, 0x10, 0x82,
+  0x00, 0x80, 0x40, 0xae, 0x00, 0x01, 0xb4, 0x00, 0x01, 0x0c, 0x04, 0x86, 0x00, 0x00, 0x0c, 0x82,
+  0x00, 0x80, 0x04, 0x86, 0x00, 0x00, 0x0c, 0x86, 0x00, 0x80, 0x04, 0x82, 0x00, 0x02, 0x04, 0x0c,
+  0x04, 0x88, 0x00, 0x00, 0x02, 0x8b, 0x00, 0x00, 0x04, 0x94, 0x00, 0x00, 0x20, 0x88, 0x00, 0x00,
+  0x40, 0x8b, 0x00, 0x00, 0x20, 0x9a, 0x00, 0x01, 0x30, 0x20, 0x86, 0x00, 0x00, 0x30, 0x82, 0x00,
+  0x80, 0x20, 0x86, 0x00, 0x00, 0x30, 0x86, 0x00, 0x80, 0x20, 0x82, 0x00, 0x01, 0x20, 0x30, 0xae,
+  0x00, 0x01, 0xb4, 0x00, 0x80, 0x02, 0x86, 0x00, 0x00, 0x02, 0x82, 0x00, 0x80, 0x08, 0x86, 0x00,
+  0x00, 0x02, 0x86, 0x00, 0x01, 0x03, 0x02, 0x82, 0x00, 0x01, 0x18, 0x10, 0x80, 0x02, 0x87, 0x00,
+  0x00, 0x04, 0x8b, 0x00, 0x80, 0x02, 0x87, 0x00, 0x00, 0x04, 0x89, 0x00, 0x80, 0x40, 0x87, 0x00,
+  0x00, 0x20, 0x8b, 0x00, 0x80, 0x40, 0x87, 0x00, 0x00, 0x20, 0x8f, 0x00, 0x80, 0x40, 0x86, 0x00,
+  0x00, 0x40, 0x82, 0x00, 0x01, 0x10, 0x18, 0x86, 0x00, 0x00, 0x40, 0x86, 0x00, 0x01, 0xc0, 0x40,
+  0x82, 0x00, 0x01, 0x18, 0x08, 0xae, 0x00, 0x01, 0x84, 0x00, 0x80, 0x80, 0x86, 0x00, 0x00, 0x80,
+  0x8c, 0x00, 0x00, 0x80, 0x86, 0x00, 0x80, 0x80, 0x8a, 0x00, 0x80, 0x01, 0x86, 0x00, 0x00, 0x01,
+  0x82, 0x00, 0x01, 0x10, 0x30, 0x86, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0x01, 0x82, 0x00, 0x03,
+  0x20, 0x60, 0x00, 0x01, 0x96, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0x08, 0x8a, 0x00, 0x00, 0x80,
+  0x96, 0x00, 0x00, 0x80, 0x87, 0x00, 0x00, 0x10, 0x8f, 0x00, 0x80, 0x80, 0x86, 0x00, 0x00, 0x80,
+  0x82, 0x00, 0x01, 0x08, 0x04, 0x86, 0x00, 0x00, 0x80, 0x87, 0x00, 0x00, 0x80, 0x82, 0x00, 0x01,
+  0x04, 0x06, 0x84, 0x00, 0x80, 0x01, 0x86, 0x00, 0x00, 0x01, 0x8c, 0x00, 0x00, 0x01, 0x86, 0x00,
+  0x80, 0x01, 0x84, 0x00, 0x01, 0x84, 0x00, 0x80, 0x40, 0x86, 0x00, 0x00, 0x40, 0x8c, 0x00, 0x00,
+  0x40, 0x86, 0x00, 0x80, 0x40, 0x85, 0x00, 0x00, 0x80, 0x91, 0x00, 0x01, 0x60, 0x40, 0x81, 0x00,
+  0x00, 0x80, 0x91, 0x00, 0x02, 0x40, 0x80, 0x01, 0x88, 0x00, 0x00, 0x08, 0x8b, 0x00, 0x00, 0x01,
+  0x94, 0x00, 0x00, 0x80, 0x88, 0x00, 0x00, 0x10, 0x8b, 0x00, 0x00, 0x80, 0xa9, 0x00, 0x01, 0x06,
+  0x02, 0x95, 0x00, 0x01, 0x03, 0x01, 0x84, 0x00, 0x80, 0x02, 0x86, 0x00, 0x00, 0x02, 0x8c, 0x00,
+  0x00, 0x02, 0x86, 0x00, 0x80, 0x02, 0x84, 0x00, 0x01, 0x84, 0x00, 0x80, 0x40, 0x86, 0x00, 0x00,
+  0x40, 0x8c, 0x00, 0x00, 0x40, 0x86, 0x00, 0x80, 0x40, 0x84, 0x00, 0x01, 0x80, 0x40, 0x92, 0x00,
+  0x00, 0x80, 0x80, 0x00, 0x01, 0x80, 0x40, 0x91, 0x00, 0x00, 0x80, 0xae, 0x00, 0x00, 0x01, 0xad,
+  0x00, 0x02, 0x80, 0x01, 0x03, 0x92, 0x00, 0x00, 0x01, 0x80, 0x00, 0x01, 0x01, 0x03, 0x99, 0x00,
+  0x80, 0x02, 0x86, 0x00, 0x00, 0x02, 0x8c, 0x00, 0x00, 0x02, 0x86, 0x00, 0x80, 0x02, 0x84, 0x00,
+  0x00, 0xae, 0x00, 0x80, 0xe0, 0x82, 0x00, 0x80, 0xfe, 0x86, 0x00, 0x00, 0xfe, 0x86, 0x00, 0x80,
+  0xe0, 0x82, 0x00, 0x00, 0xfe, 0x86, 0x00, 0x80, 0xfe, 0x84, 0x00, 0x80, 0xff, 0x82, 0x00, 0x80,
+  0xff, 0x81, 0x00, 0x00, 0xf8, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x01, 0xff, 0xfe, 0x80, 0x00,
+  0x80, 0xff, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xf8, 0x81, 0x00, 0x80, 0xff, 0x82, 0x00,
+  0x80, 0xfe, 0x80, 0xff, 0x82, 0x00, 0x80, 0xff, 0x81, 0x00, 0x00, 0x1f, 0x82, 0x00, 0x00, 0xff,
+  0x82, 0x00, 0x01, 0xff, 0x7f, 0x80, 0x00, 0x80, 0xff, 0x82, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00,
+  0x1f, 0x81, 0x00, 0x80, 0xff, 0x82, 0x00, 0x80, 0x7f, 0x80, 0x07, 0x82, 0x00, 0x80, 0x7f, 0x86,
+  0x00, 0x00, 0x7f, 0x86, 0x00, 0x80, 0x07, 0x82, 0x00, 0x00, 0x7f, 0x86, 0x00, 0x80, 0x7f, 0xb4,
+  0x00, 0x01, 0xae, 0x00, 0x01, 0x10, 0x18, 0x82, 0x00, 0x80, 0x02, 0x86, 0x00, 0x00, 0x02, 0x86,
+  0x00, 0x01, 0x10, 0x18, 0x82, 0x00, 0x00, 0x02, 0x86, 0x00, 0x80, 0x02, 0x8f, 0x00, 0x00, 0x04,
+  0x87, 0x00, 0x00, 0x01, 0x8c, 0x00, 0x00, 0x04, 0x88, 0x00, 0x00, 0x02, 0x89, 0x00, 0x00, 0x20,
+  0x87, 0x00, 0x01, 0x80, 0x40, 0x8b, 0x00, 0x00, 0x20, 0x87, 0x00, 0x80, 0x40, 0x01, 0x08, 0x18,
+  0x82, 0x00, 0x80, 0x40, 0x86, 0x00, 0x00, 0x40, 0x86, 0x00, 0x01, 0x08, 0x18, 0x82, 0x00, 0x00,
+  0x40, 0x86, 0x00, 0x80, 0x40, 0xb4, 0x00, 0x01, 0xae, 0x00, 0x01, 0x0c, 0x04, 0x82, 0x00, 0x01,
+  0x0c, 0x04, 0x86, 0x00, 0x00, 0x0c, 0x86, 0x00, 0x01, 0x0c, 0x04, 0x82, 0x00, 0x00, 0x0c, 0x86,
+  0x00, 0x01, 0x04, 0x0c, 0x99, 0x00, 0x80, 0x02, 0x95, 0x00, 0x01, 0x02, 0x04, 0x93, 0x00, 0x00,
+  0x40, 0x97, 0x00, 0x02, 0x20, 0x30, 0x20, 0x82, 0x00, 0x01, 0x30, 0x20, 0x86, 0x00, 0x00, 0x30,
+  0x86, 0x00, 0x01, 0x30, 0x20, 0x82, 0x00, 0x00, 0x30, 0x86, 0x00, 0x01, 0x20, 0x30, 0xb4, 0x00,
+  0x01, 0xae, 0x00, 0x80, 0x02, 0x82, 0x00, 0x01, 0x10, 0x18, 0x86, 0x00, 0x00, 0x10, 0x86, 0x00,
+  0x80, 0x02, 0x82, 0x00, 0x00, 0x10, 0x86, 0x00, 0x01, 0x18, 0x10, 0x8f, 0x00, 0x00, 0x02, 0x87,
+  0x00, 0x80, 0x04, 0x8b, 0x00, 0x00, 0x02, 0x87, 0x00, 0x00, 0x04, 0x8a, 0x00, 0x00, 0x40, 0x87,
+  0x00, 0x80, 0x20, 0x8b, 0x00, 0x00, 0x40, 0x87, 0x00, 0x01, 0x20, 0x00, 0x80, 0x40, 0x82, 0x00,
+  0x01, 0x08, 0x18, 0x86, 0x00, 0x00, 0x08, 0x86, 0x00, 0x80, 0x40, 0x82, 0x00, 0x00, 0x08, 0x86,
+  0x00, 0x01, 0x18, 0x08, 0xb4, 0x00, 0x01, 0x01, 0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x93, 0x00,
+  0x80, 0x01, 0x82, 0x00, 0x80, 0x20, 0x86, 0x00, 0x00, 0x20, 0x86, 0x00, 0x80, 0x01, 0x82, 0x00,
+  0x00, 0x20, 0x86, 0x00, 0x80, 0x20, 0x8f, 0x00, 0x00, 0x01, 0x88, 0x00, 0x00, 0x08, 0x8b, 0x00,
+  0x00, 0x01, 0x88, 0x00, 0x00, 0x08, 0x89, 0x00, 0x00, 0x80, 0x88, 0x00, 0x00, 0x10, 0x8b, 0x00,
+  0x00, 0x80, 0x87, 0x00, 0x80, 0x10, 0x80, 0x80, 0x82, 0x00, 0x80, 0x04, 0x86, 0x00, 0x00, 0x04,
+  0x86, 0x00, 0x80, 0x80, 0x82, 0x00, 0x00, 0x04, 0x86, 0x00, 0x80, 0x04, 0x85, 0x00, 0x00, 0x01,
+  0x96, 0x00, 0x00, 0x01, 0x93, 0x00, 0x01, 0x01, 0xc0, 0x40, 0x95, 0x00, 0x01, 0xc0, 0x40, 0x99,
+  0x00, 0x01, 0xc0, 0x40, 0x81, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0xc0, 0x8c, 0x00, 0x00, 0xc0,
+  0x82, 0x00, 0x00, 0x80, 0x81, 0x00, 0x01, 0x40, 0xc0, 0x99, 0x00, 0x01, 0x08, 0x10, 0x95, 0x00,
+  0x01, 0x08, 0x10, 0x93, 0x00, 0x01, 0x10, 0x08, 0x96, 0x00, 0x00, 0x08, 0x84, 0x00, 0x80, 0x03,
+  0x86, 0x00, 0x00, 0x03, 0x8c, 0x00, 0x00, 0x03, 0x86, 0x00, 0x80, 0x03, 0x84, 0x00, 0x01, 0x03,
+  0x02, 0x95, 0x00, 0x01, 0x03, 0x02, 0x93, 0x00, 0x01, 0x01, 0xc0, 0x40, 0x95, 0x00, 0x01, 0xc0,
+  0x40, 0x9a, 0x00, 0x00, 0x80, 0x81, 0x00, 0x00, 0x40, 0x96, 0x00, 0x00, 0x40, 0x81, 0x00, 0x00,
+  0x80, 0x9b, 0x00, 0x00, 0x10, 0x95, 0x00, 0x01, 0x08, 0x10, 0x94, 0x00, 0x00, 0x08, 0x95, 0x00,
+  0x01, 0x10, 0x08, 0x89, 0x00, 0x00, 0x03, 0x96, 0x00, 0x00, 0x03, 0x89, 0x00, 0x01, 0x03, 0x02,
+  0x95, 0x00, 0x01, 0x03, 0x02, 0x93, 0x00, 0x01, 0x01, 0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x93,
+  0x00, 0x00, 0x01, 0x88, 0x00, 0x00, 0x20, 0x8b, 0x00, 0x80, 0x01, 0x87, 0x00, 0x00, 0x20, 0x8f,
+  0x00, 0x80, 0x01, 0x86, 0x00, 0x00, 0x01, 0x82, 0x00, 0x80, 0x08, 0x86, 0x00, 0x00, 0x01, 0x86,
+  0x00, 0x80, 0x01, 0x83, 0x00, 0x00, 0x08, 0x84, 0x00, 0x80, 0x80, 0x86, 0x00, 0x00, 0x80, 0x82,
+  0x00, 0x80, 0x10, 0x86, 0x00, 0x00, 0x80, 0x86, 0x00, 0x80, 0x80, 0x83, 0x00, 0x01, 0x10, 0x80,
+  0x88, 0x00, 0x00, 0x04, 0x8b, 0x00, 0x80, 0x80, 0x87, 0x00, 0x00, 0x04, 0x8a, 0x00, 0x00, 0x01,
+  0x96, 0x00, 0x00, 0x01, 0x93, 0x00, 0x00, 0xae, 0x00, 0x80, 0xfc, 0x87, 0x00, 0x00, 0xf8, 0x8b,
+  0x00, 0x80, 0xfc, 0x87, 0x00, 0x00, 0xf8, 0x89, 0x00, 0x80, 0xff, 0x82, 0x00, 0x80, 0xfc, 0x81,
+  0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0xfc, 0x82, 0x00, 0x01, 0xfc, 0xf8, 0x80, 0x00, 0x80, 0xff,
+  0x82, 0x00, 0x00, 0xfc, 0x82, 0x00, 0x00, 0xff, 0x81, 0x00, 0x80, 0xfc, 0x82, 0x00, 0x80, 0xfc,
+  0x80, 0xff, 0x82, 0x00, 0x80, 0x3f, 0x81, 0x00, 0x00, 0xff, 0x82, 0x00, 0x00, 0x3f, 0x82, 0x00,
+  0x01, 0x3f, 0x1f, 0x80, 0x00, 0x80, 0xff, 0x82, 0x00, 0x00, 0x3f, 0x82, 0x00, 0x00, 0xff, 0x81,
+  0x00, 0x80, 0x3f, 0x82, 0x00, 0x82, 0x3f, 0x87, 0x00, 0x00, 0x1f, 0x8b, 0x00, 0x80, 0x3f, 0x87,
+  0x00, 0x00, 0x1f, 0xb9, 0x00, 0x01, 0xae, 0x00, 0x80, 0x04, 0x87, 0x00, 0x00, 0x04, 0x8b, 0x00,
+  0x01, 0x0c, 0x04, 0x87, 0x00, 0x00, 0x04, 0x9f, 0x00, 0x00, 0x04, 0x95, 0x00, 0x80, 0x02, 0x94,
+  0x00, 0x00, 0x20, 0x95, 0x00, 0x80, 0x40, 0x80, 0x20, 0x87, 0x00, 0x00, 0x20, 0x8b, 0x00, 0x01,
+  0x30, 0x20, 0x87, 0x00, 0x00, 0x20, 0xb9, 0x00, 0x01, 0xae, 0x00, 0x01, 0x18, 0x08, 0x87, 0x00,
+  0x00, 0x02, 0x8b, 0x00, 0x01, 0x10, 0x18, 0x87, 0x00, 0x00, 0x02, 0x8f, 0x00, 0x80, 0x04, 0x86,
+  0x00, 0x00, 0x04, 0x82, 0x00, 0x80, 0x02, 0x86, 0x00, 0x00, 0x04, 0x86, 0x00, 0x80, 0x04, 0x82,
+  0x00, 0x00, 0x01, 0x85, 0x00, 0x80, 0x20, 0x86, 0x00, 0x00, 0x20, 0x82, 0x00, 0x80, 0x40, 0x86,
+  0x00, 0x00, 0x20, 0x86, 0x00, 0x80, 0x20, 0x82, 0x00, 0x03, 0x80, 0x00, 0x18, 0x10, 0x87, 0x00,
+  0x00, 0x40, 0x8b, 0x00, 0x01, 0x08, 0x18, 0x87, 0x00, 0x00, 0x40, 0xb9, 0x00, 0x01, 0x89, 0x00,
+  0x00, 0x80, 0x96, 0x00, 0x00, 0x80, 0x89, 0x00, 0x01, 0x20, 0x10, 0x87, 0x00, 0x00, 0x01, 0x8b,
+  0x00, 0x01, 0x60, 0x20, 0x87, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0x80, 0x85, 0x00, 0x80, 0x08,
+  0x86, 0x00, 0x00, 0x08, 0x82, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0x08, 0x86, 0x00, 0x80, 0x08,
+  0x83, 0x00, 0x00, 0x01, 0x84, 0x00, 0x80, 0x10, 0x86, 0x00, 0x00, 0x10, 0x82, 0x00, 0x00, 0x80,
+  0x87, 0x00, 0x00, 0x10, 0x86, 0x00, 0x80, 0x10, 0x83, 0x00, 0x02, 0x80, 0x04, 0x08, 0x87, 0x00,
+  0x00, 0x80, 0x8b, 0x00, 0x01, 0x06, 0x04, 0x87, 0x00, 0x00, 0x80, 0x87, 0x00, 0x00, 0x01, 0x8a,
+  0x00, 0x00, 0x01, 0x96, 0x00, 0x00, 0x01, 0x89, 0x00,
+};
+const uint16_t speaking_sprite_offsets[] PROGMEM = {0, 143, 220, 320, 405, 464, 547, 642, 709, 861, 959, 1045, 1121, 1207, 1316, 1400, 1472, 1601, 1687, 1760, 1846, 1942, 2024, 2087, 2182, 2293, 2344, 2429, 2537};
+const SpriteSet speaking_sprite = {48, 48, 28, 42, speaking_sprite_offsets, speaking_sprite_data};
@@ -0,0 +1,516 @@
+/*
+================================================================================
+  KIKO - Journaled todo-list store
+================================================================================
+  The todo lists, kept compact in RAM and persisted as an append-only journal
+  so one edit is one small flash write instead of a whole-file rewrite.
+
+  - Names are interned in one arena (no String per map node). Every list and
+    item also has a normalized key (lowercase, punctuation and leading
+    articles dropped, last word singular), so "Apples", "apple" and "the
+    apples" are the same item; the first spelling is the one shown.
+  - Items are found through an open-addressed hash index over (list, key).
+  - Every mutation is encoded as a record and queued for the journal;
+    drainJournal() hands the bytes to the caller to append to flash.
+    Records carry absolute quantities, so replaying them is idempotent.
+  - writeSnapshot() emits the live state as records for compaction, after
+    dropping removed items and their names from memory.
+  - appendJson() writes {"list":{"item":qty}} straight into a String, with
+    no JSON document in between, so the size is not capped.
+
+  Record: op (1 byte), payload length (2 bytes), payload, checksum (1 byte).
+  A torn record at the end of the journal (power loss mid-write) fails its
+  checksum and ends the replay.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#define TODO_NAME_MAX 63
+#define TODO_KEY_MAX 64
+#define TODO_RECORD_MAX (3 + 4 + 2 * (1 + TODO_NAME_MAX) + 1)
+
+enum TodoRecordOp : uint8_t {
+  TODO_OP_SET = 0xA1,          // qty, list, item (qty 0 removes the item)
+  TODO_OP_REMOVE_LIST = 0xA2,  // list
+  TODO_OP_CLEAR = 0xA3,
+};
+
+struct TodoStoreStats {
+  uint32_t mutations = 0;
+  uint32_t journalBytes = 0;   // Handed to drainJournal() since boot
+  uint32_t snapshotBytes = 0;  // Size of the last snapshot
+  uint32_t compactions = 0;
+  uint32_t replayed = 0;       // Records applied by replay()
+};
+
+// Normalized lookup key of a list or item name; returns its length
+inline size_t todoNormalize(const char* in, char* out) {
+  size_t n = 0;
+  bool space = false;
+  for (const char* p = in; *p && n < TODO_KEY_MAX - 1; p++) {
+    uint8_t c = (uint8_t)*p;
+    if (isalnum(c) || c >= 0x80) {           // UTF-8 bytes are kept as they are
+      if (space && n > 0) out[n++] = ' ';
+      if (n < TODO_KEY_MAX - 1) out[n++] = tolower(c);
+      space = false;
+    } else {
+      space = true;
+    }
+  }
+  out[n] = '\0';
+
+  static const char* const ARTICLES[] = {"a ", "an ", "the ", "some ", "my "};
+  for (const char* a : ARTICLES) {
+    size_t len = strlen(a);
+    if (n > len && strncmp(out, a, len) == 0) {
+      memmove(out, out + len, n - len + 1);
+      n -= len;
+      break;
+    }
+  }
+
+  // Singular last word: berries -> berry, tomatoes/boxes/dishes -> tomato/box/dish, eggs -> egg
+  auto hasSuffix = [&](const char* s) {
+    size_t len = strlen(s);
+    return n >= len && strcmp(out + n - len, s) == 0;
+  };
+  auto endsWith = [&](const char* s) { return n > strlen(s) + 1 && hasSuffix(s); };
+  if (endsWith("ies")) {
+    n -= 3;
+    out[n++] = 'y';
+  } else if (endsWith("oes") || endsWith("xes") || endsWith("ches") || endsWith("shes") || endsWith("sses")) {
+    n -= 2;
+  } else if (endsWith("s") && !hasSuffix("ss") && !hasSuffix("us") && !hasSuffix("is")) {
+    n -= 1;
+  }
+  out[n] = '\0';
+  return n;
+}
+
+class TodoStore {
+ public:
+  TodoStore() { index_.assign(64, -1); }
+
+  // Adds qty of an item, creating the list and item as needed. Returns the new quantity.
+  int add(const char* list, const char* item, int qty) {
+    int l = listFor(list, true);
+    int i = find(l, item);
+    if (i < 0) i = newItem(l, item);
+    items_[i].qty += qty;
+    stats_.mutations++;
+    journalSet(i);
+    return items_[i].qty;
+  }
+
+  // Removes qty of an item, or all of it if qty <= 0. Returns what is left, or -1 if the
+  // item is not on the list.
+  int remove(const char* list, const char* item, int qty) {
+    int l = findList(list);
+    int i = l < 0 ? -1 : find(l, item);
+    if (i < 0 || items_[i].qty == 0) return -1;
+    items_[i].qty = qty > 0 ? max(0, items_[i].qty - qty) : 0;
+    stats_.mutations++;
+    journalSet(i);
+    return items_[i].qty;
+  }
+
+  bool removeList(const char* list) {
+    int l = findList(list);
+    if (l < 0) return false;
+    dropList(l);
+    stats_.mutations++;
+    journalName(TODO_OP_REMOVE_LIST, name(lists_[l].name));
+    return true;
+  }
+
+  void clear() {
+    for (int l = 0; l < (int)lists_.size(); l++) {
+      if (lists_[l].live) dropList(l);
+    }
+    stats_.mutations++;
+    uint8_t rec[4];
+    rec[0] = TODO_OP_CLEAR;
+    rec[1] = rec[2] = 0;
+    rec[3] = checksum(rec, 3);
+    queue(rec, sizeof(rec));
+  }
+
+  // List id by (normalized) name, or -1
+  int findList(const char* list) const {
+    char key[TODO_KEY_MAX];
+    todoNormalize(list, key);
+    uint32_t h = hashKey(0xFFFF, key);
+    for (int l = 0; l < (int)lists_.size(); l++) {
+      if (lists_[l].live && lists_[l].hash == h && strcmp(name(lists_[l].key), key) == 0) return l;
+    }
+    return -1;
+  }
+
+  // Quantity of an item, 0 if it is not there
+  int quantity(const char* list, const char* item) const {
+    int l = findList(list);
+    int i = l < 0 ? -1 : find(l, item);
+    return i < 0 ? 0 : items_[i].qty;
+  }
+
+  // Display name of the item matching `item`, or "" if it is not on the list
+  const char* itemName(const char* list, const char* item) const {
+    int l = findList(list);
+    int i = l < 0 ? -1 : find(l, item);
+    return (i < 0 || items_[i].qty == 0) ? "" : name(items_[i].name);
+  }
+
+  const char* listName(int l) const { return name(lists_[l].name); }
+
+  int listCount() const {
+    int n = 0;
+    for (const TodoList& l : lists_) n += l.live;
+    return n;
+  }
+
+  // Number of items with a quantity on list l
+  int itemCount(int l) const {
+    int n = 0;
+    for (int i : lists_[l].items) n += items_[i].qty > 0;
+    return n;
+  }
+
+  // fn(listId, name) for every list, in creation order
+  template <typename Fn>
+  void forEachList(Fn fn) const {
+    for (int l = 0; l < (int)lists_.size(); l++) {
+      if (lists_[l].live) fn(l, name(lists_[l].name));
+    }
+  }
+
+  // fn(name, qty) for every item of list l with a quantity, in insertion order
+  template <typename Fn>
+  void forEachItem(int l, Fn fn) const {
+    for (int i : lists_[l].items) {
+      if (items_[i].qty > 0) fn(name(items_[i].name), items_[i].qty);
+    }
+  }
+
+  // Appends {"list":{"item":qty,...},...}
+  void appendJson(String& out) const {
+    out += '{';
+    bool firstList = true;
+    forEachList([&](int l, const char* list) {
+      if (!firstList) out += ',';
+      firstList = false;
+      appendQuoted(out, list);
+      out += ":{";
+      bool firstItem = true;
+      forEachItem(l, [&](const char* item, int qty) {
+        if (!firstItem) out += ',';
+        firstItem = false;
+        appendQuoted(out, item);
+        out += ':';
+        out += String(qty);
+      });
+      out += '}';
+    });
+    out += '}';
+  }
+
+  // --- Journal ---
+
+  size_t pendingJournalBytes() const { return journal_.size(); }
+
+  // Hands the queued records to write(data, len) and forgets them
+  template <typename WriteFn>
+  void drainJournal(WriteFn write) {
+    if (journal_.empty()) return;
+    write(journal_.data(), journal_.size());
+    stats_.journalBytes += journal_.size();
+    journal_.clear();
+  }
+
+  // Applies records (snapshot, then journal) without queueing them again.
+  // Returns the bytes consumed; less than len if the data ends in a torn record.
+  size_t replay(const uint8_t* data, size_t len) {
+    size_t pos = 0;
+    replaying_ = true;
+    while (pos + 4 <= len) {
+      uint16_t payload = data[pos + 1] | (data[pos + 2] << 8);
+      if (pos + 4 + payload > len || checksum(data + pos, 3 + payload) != data[pos + 3 + payload]) break;
+      if (!apply(data[pos], data + pos + 3, payload)) break;
+      pos += 4 + payload;
+      stats_.replayed++;
+    }
+    replaying_ = false;
+    journal_.clear();
+    return pos;
+  }
+
+  // Drops removed items and lists from memory, then passes the live state as SET records
+  // to write(data, len) in one call. The queued journal is discarded: the snapshot covers it.
+  template <typename WriteFn>
+  void writeSnapshot(WriteFn write) {
+    rebuild();
+    journal_.clear();
+    replaying_ = false;
+    for (int l = 0; l < (int)lists_.size(); l++) {
+      if (lists_[l].items.empty()) {
+        // An empty list is kept by a SET of nothing: the list name with an empty item
+        encodeSet(name(lists_[l].name), "", 0);
+      }
+      for (int i : lists_[l].items) encodeSet(name(lists_[l].name), name(items_[i].name), items_[i].qty);
+    }
+    write(journal_.data(), journal_.size());
+    stats_.snapshotBytes = journal_.size();
+    stats_.compactions++;
+    journal_.clear();
+  }
+
+  size_t arenaBytes() const { return arena_.size(); }
+  const TodoStoreStats& stats() const { return stats_; }
+
+ private:
+  struct TodoItem {
+    uint32_t name;             // Arena offsets
+    uint32_t key;
+    uint32_t hash;
+    uint16_t list;
+    int32_t qty;
+  };
+  struct TodoList {
+    uint32_t name;
+    uint32_t key;
+    uint32_t hash;
+    bool live;
+    std::vector<int> items;
+  };
+
+  const char* name(uint32_t offset) const { return &arena_[offset]; }
+
+  uint32_t intern(const char* s, size_t len) {
+    uint32_t offset = arena_.size();
+    arena_.insert(arena_.end(), s, s + len);
+    arena_.push_back('\0');
+    return offset;
+  }
+
+  // Interns a display name and its key, sharing the bytes when they are the same
+  void internName(const char* display, const char* key, uint32_t& nameOut, uint32_t& keyOut) {
+    size_t len = min(strlen(display), (size_t)TODO_NAME_MAX);
+    nameOut = intern(display, len);
+    keyOut = (strlen(key) == len && strncmp(display, key, len) == 0) ? nameOut : intern(key, strlen(key));
+  }
+
+  static uint32_t hashKey(uint32_t list, const char* key) {
+    uint32_t h = 2166136261u ^ list;
+    h *= 16777619u;
+    for (const char* p = key; *p; p++) { h ^= (uint8_t)*p; h *= 16777619u; }
+    return h;
+  }
+
+  int listFor(const char* list, bool create) {
+    int l = findList(list);
+    if (l >= 0 || !create) return l;
+    char key[TODO_KEY_MAX];
+    todoNormalize(list, key);
+    TodoList rec;
+    internName(list, key, rec.name, rec.key);
+    rec.hash = hashKey(0xFFFF, key);
+    rec.live = true;
+    lists_.push_back(rec);
+    return lists_.size() - 1;
+  }
+
+  int find(int l, const char* item) const {
+    char key[TODO_KEY_MAX];
+    todoNormalize(item, key);
+    uint32_t h = hashKey(l, key);
+    size_t mask = index_.size() - 1;
+    for (size_t slot = h & mask; index_[slot] >= 0; slot = (slot + 1) & mask) {
+      const TodoItem& it = items_[index_[slot]];
+      if (it.hash == h && it.list == l && strcmp(name(it.key), key) == 0) return index_[slot];
+    }
+    return -1;
+  }
+
+  int newItem(int l, const char* item) {
+    char key[TODO_KEY_MAX];
+    todoNormalize(item, key);
+    TodoItem rec;
+    internName(item, key, rec.name, rec.key);
+    rec.hash = hashKey(l, key);
+    rec.list = l;
+    rec.qty = 0;
+    items_.push_back(rec);
+    int id = items_.size() - 1;
+    lists_[l].items.push_back(id);
+    if (items_.size() * 2 > index_.size()) reindex(index_.size() * 2);
+    else insertIndex(id);
+    return id;
+  }
+
+  void insertIndex(int id) {
+    size_t mask = index_.size() - 1;
+    size_t slot = items_[id].hash & mask;
+    while (index_[slot] >= 0) slot = (slot + 1) & mask;
+    index_[slot] = id;
+  }
+
+  void reindex(size_t size) {
+    index_.assign(size, -1);
+    for (int i = 0; i < (int)items_.size(); i++) insertIndex(i);
+  }
+
+  void dropList(int l) {
+    for (int i : lists_[l].items) items_[i].qty = 0;
+    lists_[l].live = false;
+  }
+
+  // Rebuilds the arena, items and index from what is still live
+  void rebuild() {
+    std::vector<char> arena;
+    std::vector<TodoItem> items;
+    std::vector<TodoList> lists;
+    arena.swap(arena_);
+    items.swap(items_);
+    lists.swap(lists_);
+    for (const TodoList& old : lists) {
+      if (!old.live) continue;
+      TodoList rec = old;
+      rec.items.clear();
+      rec.name = intern(&arena[old.name], strlen(&arena[old.name]));
+      rec.key = old.key == old.name ? rec.name : intern(&arena[old.key], strlen(&arena[old.key]));
+      lists_.push_back(rec);
+      int l = lists_.size() - 1;
+      for (int oldId : old.items) {
+        TodoItem it = items[oldId];
+        if (it.qty <= 0) continue;
+        it.name = intern(&arena[items[oldId].name], strlen(&arena[items[oldId].name]));
+        it.key = items[oldId].key == items[oldId].name ? it.name
+                                                       : intern(&arena[items[oldId].key], strlen(&arena[items[oldId].key]));
+        it.list = l;
+        it.hash = hashKey(l, &arena_[it.key]);
+        items_.push_back(it);
+        lists_[l].items.push_back(items_.size() - 1);
+      }
+    }
+    size_t size = 64;
+    while (size < items_.size() * 2) size *= 2;
+    reindex(size);
+  }
+
+  // --- Records ---
+
+  static uint8_t checksum(const uint8_t* p, size_t len) {
+    uint8_t sum = 0x5A;
+    for (size_t i = 0; i < len; i++) sum = (sum << 1 | sum >> 7) ^ p[i];
+    return sum;
+  }
+
+  void queue(const uint8_t* rec, size_t len) {
+    if (replaying_) return;
+    journal_.insert(journal_.end(), rec, rec + len);
+  }
+
+  static size_t putName(uint8_t* p, const char* s) {
+    size_t len = min(strlen(s), (size_t)TODO_NAME_MAX);
+    p[0] = len;
+    memcpy(p + 1, s, len);
+    return 1 + len;
+  }
+
+  void encodeSet(const char* list, const char* item, int32_t qty) {
+    uint8_t rec[TODO_RECORD_MAX];
+    size_t n = 3;
+    rec[0] = TODO_OP_SET;
+    memcpy(rec + n, &qty, 4);
+    n += 4;
+    n += putName(rec + n, list);
+    n += putName(rec + n, item);
+    rec[1] = (n - 3) & 0xFF;
+    rec[2] = (n - 3) >> 8;
+    rec[n] = checksum(rec, n);
+    queue(rec, n + 1);
+  }
+
+  void journalSet(int i) {
+    if (replaying_) return;
+    encodeSet(name(lists_[items_[i].list].name), name(items_[i].name), items_[i].qty);
+  }
+
+  void journalName(uint8_t op, const char* s) {
+    uint8_t rec[3 + 1 + TODO_NAME_MAX + 1];
+    rec[0] = op;
+    size_t n = 3 + putName(rec + 3, s);
+    rec[1] = (n - 3) & 0xFF;
+    rec[2] = (n - 3) >> 8;
+    rec[n] = checksum(rec, n);
+    queue(rec, n + 1);
+  }
+
+  bool apply(uint8_t op, const uint8_t* p, size_t len) {
+    char list[TODO_NAME_MAX + 1];
+    char item[TODO_NAME_MAX + 1];
+    auto getName = [&](size_t& pos, char* out) {
+      if (pos >= len || pos + 1 + p[pos] > len) return false;
+      memcpy(out, p + pos + 1, p[pos]);
+      out[p[pos]] = '\0';
+      pos += 1 + p[pos];
+      return true;
+    };
+    size_t pos = 0;
+    switch (op) {
+      case TODO_OP_SET: {
+        int32_t qty;
+        if (len < 4) return false;
+        memcpy(&qty, p, 4);
+        pos = 4;
+        if (!getName(pos, list) || !getName(pos, item)) return false;
+        int l = listFor(list, true);
+        if (item[0] == '\0') return true;    // Empty list
+        int i = find(l, item);
+        if (i < 0) i = newItem(l, item);
+        items_[i].qty = qty;
+        return true;
+      }
+      case TODO_OP_REMOVE_LIST: {
+        if (!getName(pos, list)) return false;
+        int l = findList(list);
+        if (l >= 0) dropList(l);
+        return true;
+      }
+      case TODO_OP_CLEAR:
+        for (int l = 0; l < (int)lists_.size(); l++) {
+          if (lists_[l].live) dropList(l);
+        }
+        return true;
+    }
+    return false;
+  }
+
+  static void appendQuoted(String& out, const char* s) {
+    out += '"';
+    for (const char* p = s; *p; p++) {
+      char c = *p;
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      } else if ((uint8_t)c < 0x20) {
+        char esc[8];
+        snprintf(esc, sizeof(esc), "\\u%04x", c);
+        out += esc;
+      } else {
+        out += c;
+      }
+    }
+    out += '"';
+  }
+
+  std::vector<char> arena_;
+  std::vector<TodoItem> items_;
+  std::vector<TodoList> lists_;
+  std::vector<int32_t> index_;
+  std::vector<uint8_t> journal_;
+  bool replaying_ = false;
+  TodoStoreStats stats_;
+};
@@ -0,0 +1,210 @@
+/*
+================================================================================
+  KIKO - RTTTL tone synthesizer
+================================================================================
+  Turns a ringtone in RTTTL ("name:d=4,o=5,b=120:8c6,8e6,p,...") into 16-bit
+  mono PCM without any floating point per sample:
+
+  - rtttlParse() converts the song into a note list (frequency, duration).
+  - ToneSynth plays the note list with a 32-bit phase accumulator over a
+    256-entry sine wavetable (linear interpolation between entries), with a
+    short linear attack/release on every note so the edges do not click.
+  - render() is incremental: the caller pulls a buffer at a time, so the
+    whole song never has to be in memory.
+
+  The wavetable is built once, on first use.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+
+#define TONE_TABLE_BITS 8
+#define TONE_TABLE_SIZE (1 << TONE_TABLE_BITS)
+#define TONE_RAMP_MS 4          // Attack and release of every note
+#define TONE_WAV_HEADER_BYTES 44
+
+struct RtttlNote {
+  uint16_t freqHz;              // 0 for a pause
+  uint16_t durationMs;
+};
+
+// Note frequencies of octave 4 (c, c#, d, ... b), in Hz * 16
+static const uint16_t RTTTL_OCTAVE4_X16[12] = {
+  4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902
+};
+
+inline int rtttlReadNumber(const char*& p) {
+  int n = 0;
+  while (*p >= '0' && *p <= '9') n = n * 10 + (*p++ - '0');
+  return n;
+}
+
+// Parses an RTTTL song into out (at most maxNotes). Returns the note count, or -1 if malformed.
+inline int rtttlParse(const char* song, RtttlNote* out, int maxNotes) {
+  const char* p = strchr(song, ':');
+  if (!p) return -1;
+  p++;
+  int defDuration = 4, defOctave = 6, bpm = 63;
+  while (*p && *p != ':') {
+    char key = *p++;
+    if (*p == '=') p++;
+    int value = rtttlReadNumber(p);
+    if (key == 'd' && value > 0) defDuration = value;
+    else if (key == 'o' && value >= 3 && value <= 8) defOctave = value;
+    else if (key == 'b' && value > 0) bpm = value;
+    while (*p == ',' || *p == ' ') p++;
+  }
+  if (*p != ':') return -1;
+  p++;
+
+  uint32_t wholeMs = 240000UL / bpm;   // A whole note is four beats
+  int count = 0;
+  while (*p && count < maxNotes) {
+    while (*p == ' ') p++;
+    int duration = rtttlReadNumber(p);
+    if (duration == 0) duration = defDuration;
+    char name = tolower(*p);
+    if (!name) break;
+    p++;
+    static const int8_t SEMITONES[7] = {9, 11, 0, 2, 4, 5, 7};   // a..g
+    int semitone = -1;
+    if (name >= 'a' && name <= 'g') semitone = SEMITONES[name - 'a'];
+    else if (name != 'p') return -1;
+    if (*p == '#') { semitone++; p++; }
+    uint32_t ms = wholeMs / duration;
+    if (*p == '.') { ms += ms / 2; p++; }
+    int octave = defOctave;
+    if (*p >= '0' && *p <= '9') octave = *p++ - '0';
+    if (*p == '.') { ms += ms / 2; p++; }   // Both dot positions occur in the wild
+
+    uint32_t freq = 0;
+    if (semitone >= 0) {
+      if (semitone == 12) { semitone = 0; octave++; }   // b#
+      uint32_t x16 = RTTTL_OCTAVE4_X16[semitone];
+      freq = octave >= 4 ? (x16 << (octave - 4)) >> 4 : (x16 >> (4 - octave)) >> 4;
+    }
+    out[count].freqHz = (uint16_t)freq;
+    out[count].durationMs = (uint16_t)min(ms, (uint32_t)0xFFFF);
+    count++;
+    while (*p == ',' || *p == ' ') p++;
+  }
+  return count;
+}
+
+inline const int16_t* toneWavetable() {
+  static int16_t table[TONE_TABLE_SIZE + 1];   // One extra entry so interpolation never wraps
+  static bool built = false;
+  if (!built) {
+    for (int i = 0; i <= TONE_TABLE_SIZE; i++) {
+      table[i] = (int16_t)lroundf(32767.0f * sinf(2.0f * (float)M_PI * i / TONE_TABLE_SIZE));
+    }
+    built = true;
+  }
+  return table;
+}
+
+class ToneSynth {
+ public:
+  // amplitude is Q15 (32767 == full scale)
+  void begin(const RtttlNote* notes, int count, uint32_t sampleRate, int16_t amplitude) {
+    notes_ = notes;
+    count_ = count;
+    rate_ = sampleRate;
+    amplitude_ = amplitude;
+    ramp_ = sampleRate * TONE_RAMP_MS / 1000;
+    table_ = toneWavetable();
+    note_ = -1;
+    remaining_ = 0;
+    nextNote();
+  }
+
+  // Number of samples the whole song renders to
+  static uint32_t totalSamples(const RtttlNote* notes, int count, uint32_t sampleRate) {
+    uint32_t total = 0;
+    for (int i = 0; i < count; i++) total += (uint32_t)notes[i].durationMs * sampleRate / 1000;
+    return total;
+  }
+
+  // Fills up to maxSamples; returns how many were written (0 once the song is over)
+  size_t render(int16_t* out, size_t maxSamples) {
+    size_t n = 0;
+    while (n < maxSamples && note_ < count_) {
+      if (remaining_ == 0) {
+        nextNote();
+        continue;
+      }
+      size_t chunk = min(maxSamples - n, (size_t)remaining_);
+      if (step_ == 0) {
+        memset(out + n, 0, chunk * sizeof(int16_t));
+        position_ += chunk;
+      } else {
+        for (size_t i = 0; i < chunk; i++) {
+          uint32_t idx = phase_ >> (32 - TONE_TABLE_BITS);
+          int32_t frac = (phase_ >> (16 - TONE_TABLE_BITS)) & 0xFFFF;
+          int32_t a = table_[idx], b = table_[idx + 1];
+          int32_t s = a + (((b - a) * frac) >> 16);
+          out[n + i] = (int16_t)((s * envelope()) >> 15);
+          phase_ += step_;
+          position_++;
+        }
+      }
+      n += chunk;
+      remaining_ -= chunk;
+    }
+    return n;
+  }
+
+  bool done() const { return note_ >= count_; }
+
+ private:
+  void nextNote() {
+    while (++note_ < count_) {
+      length_ = (uint32_t)notes_[note_].durationMs * rate_ / 1000;
+      if (length_ == 0) continue;
+      remaining_ = length_;
+      position_ = 0;
+      phase_ = 0;
+      step_ = (uint32_t)(((uint64_t)notes_[note_].freqHz << 32) / rate_);
+      return;
+    }
+  }
+
+  // Q15 gain at the current position of the note
+  int32_t envelope() const {
+    uint32_t edge = min(position_, length_ - 1 - position_);
+    if (edge >= ramp_) return amplitude_;
+    return (int32_t)amplitude_ * (int32_t)edge / (int32_t)ramp_;
+  }
+
+  const RtttlNote* notes_ = nullptr;
+  const int16_t* table_ = nullptr;
+  int count_ = 0;
+  int note_ = 0;
+  uint32_t rate_ = 0;
+  uint32_t ramp_ = 0;
+  int16_t amplitude_ = 0;
+  uint32_t phase_ = 0;
+  uint32_t step_ = 0;
+  uint32_t length_ = 0;
+  uint32_t position_ = 0;
+  uint32_t remaining_ = 0;
+};
+
+// 44-byte header of a 16-bit mono PCM WAV file
+inline void toneWavHeader(uint8_t* h, uint32_t sampleRate, uint32_t dataBytes) {
+  auto put32 = [](uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; };
+  memcpy(h, "RIFF", 4);
+  put32(h + 4, 36 + dataBytes);
+  memcpy(h + 8, "WAVEfmt ", 8);
+  put32(h + 16, 16);
+  h[20] = 1; h[21] = 0;              // PCM
+  h[22] = 1; h[23] = 0;              // Mono
+  put32(h + 24, sampleRate);
+  put32(h + 28, sampleRate * 2);
+  h[32] = 2; h[33] = 0;              // Block align
+  h[34] = 16; h[35] = 0;             // Bits per sample
+  memcpy(h + 36, "data", 4);
+  put32(h + 40, dataBytes);
+}
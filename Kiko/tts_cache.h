@@ -0,0 +1,169 @@
+/*
+================================================================================
+  KIKO - Content-addressed cache of synthesized speech clips
+================================================================================
+  Speech clips are stored in flash under the hash of their language and
+  text (/tts/<key>.mp3), so a sentence that was synthesized once plays from
+  flash without any network round trip.
+
+  - Size budget with least-recently-used eviction; the caller deletes the
+    files of evicted keys.
+  - Only sentences worth keeping are fetched: the fixed phrases preloaded
+    at boot, and any sentence that misses a second time (noteMiss() keeps a
+    short ring of recent misses), so one-off model answers never churn the
+    flash.
+  - The index (keys, sizes, LRU clock) is serialized to a small blob so the
+    LRU order survives a reboot.
+  - Hit/miss counters and the bytes served from flash instead of the
+    network are kept for the stats endpoint.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define TTS_CACHE_MAX_ENTRIES 64
+#define TTS_CACHE_RECENT_MISSES 32
+#define TTS_CACHE_MAGIC 0x3143544B   // "KTC1"
+
+struct TtsCacheEntry {
+  uint32_t key;
+  uint32_t bytes;
+  uint32_t lastUse;     // Value of the LRU clock at the last hit or insert
+};
+
+// FNV-1a over "lang\0text"
+inline uint32_t ttsCacheKey(const char* lang, const char* text) {
+  uint32_t h = 2166136261u;
+  for (const char* p = lang; *p; p++) { h ^= (uint8_t)*p; h *= 16777619u; }
+  h *= 16777619u;  // The separator (a zero byte)
+  for (const char* p = text; *p; p++) { h ^= (uint8_t)*p; h *= 16777619u; }
+  return h;
+}
+
+struct TtsCacheStats {
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t bytesSaved = 0;     // Clip bytes played from flash instead of downloaded
+  uint32_t inserts = 0;
+  uint32_t evictions = 0;
+};
+
+class TtsCacheIndex {
+ public:
+  explicit TtsCacheIndex(uint32_t budgetBytes) : budget_(budgetBytes) {}
+
+  // Looks a key up for playback and counts the hit or miss. A hit becomes most recently used.
+  bool lookup(uint32_t key) {
+    int i = find(key);
+    if (i < 0) {
+      stats_.misses++;
+      return false;
+    }
+    entries_[i].lastUse = ++clock_;
+    stats_.hits++;
+    stats_.bytesSaved += entries_[i].bytes;
+    return true;
+  }
+
+  bool contains(uint32_t key) const { return find(key) >= 0; }
+
+  // Remembers a missed key. Returns true if it already missed recently (worth caching).
+  bool noteMiss(uint32_t key) {
+    for (int i = 0; i < TTS_CACHE_RECENT_MISSES; i++) {
+      if (recentMisses_[i] == key) return true;
+    }
+    recentMisses_[recentHead_] = key;
+    recentHead_ = (recentHead_ + 1) % TTS_CACHE_RECENT_MISSES;
+    return false;
+  }
+
+  // Adds a clip, evicting least recently used clips until it fits.
+  // onEvict(key) is called for every evicted clip. Returns false if the clip can never fit.
+  template <typename EvictFn>
+  bool insert(uint32_t key, uint32_t bytes, EvictFn onEvict) {
+    if (bytes > budget_) return false;
+    int existing = find(key);
+    if (existing >= 0) removeAt(existing);
+    while (count_ > 0 && (used_ + bytes > budget_ || count_ >= TTS_CACHE_MAX_ENTRIES)) {
+      int oldest = 0;
+      for (int i = 1; i < count_; i++) {
+        if (entries_[i].lastUse < entries_[oldest].lastUse) oldest = i;
+      }
+      uint32_t evicted = entries_[oldest].key;
+      removeAt(oldest);
+      stats_.evictions++;
+      onEvict(evicted);
+    }
+    entries_[count_++] = {key, bytes, ++clock_};
+    used_ += bytes;
+    stats_.inserts++;
+    return true;
+  }
+
+  void remove(uint32_t key) {
+    int i = find(key);
+    if (i >= 0) removeAt(i);
+  }
+
+  void clear() {
+    count_ = 0;
+    used_ = 0;
+  }
+
+  // Index blob: magic, count, clock, then count entries
+  size_t serializedSize() const { return 12 + count_ * sizeof(TtsCacheEntry); }
+
+  size_t serialize(uint8_t* out) const {
+    uint32_t header[3] = {TTS_CACHE_MAGIC, (uint32_t)count_, clock_};
+    memcpy(out, header, sizeof(header));
+    memcpy(out + sizeof(header), entries_, count_ * sizeof(TtsCacheEntry));
+    return serializedSize();
+  }
+
+  // Restores the index from a blob; entries over the budget or capacity are dropped
+  bool deserialize(const uint8_t* in, size_t len) {
+    clear();
+    uint32_t header[3];
+    if (len < sizeof(header)) return false;
+    memcpy(header, in, sizeof(header));
+    if (header[0] != TTS_CACHE_MAGIC || len < 12 + header[1] * sizeof(TtsCacheEntry)) return false;
+    clock_ = header[2];
+    for (uint32_t i = 0; i < header[1] && count_ < TTS_CACHE_MAX_ENTRIES; i++) {
+      TtsCacheEntry e;
+      memcpy(&e, in + sizeof(header) + i * sizeof(TtsCacheEntry), sizeof(e));
+      if (used_ + e.bytes > budget_) continue;
+      entries_[count_++] = e;
+      used_ += e.bytes;
+    }
+    return true;
+  }
+
+  int count() const { return count_; }
+  const TtsCacheEntry& entry(int i) const { return entries_[i]; }
+  uint32_t usedBytes() const { return used_; }
+  uint32_t budgetBytes() const { return budget_; }
+  const TtsCacheStats& stats() const { return stats_; }
+
+ private:
+  int find(uint32_t key) const {
+    for (int i = 0; i < count_; i++) {
+      if (entries_[i].key == key) return i;
+    }
+    return -1;
+  }
+
+  void removeAt(int i) {
+    used_ -= entries_[i].bytes;
+    entries_[i] = entries_[--count_];
+  }
+
+  TtsCacheEntry entries_[TTS_CACHE_MAX_ENTRIES];
+  int count_ = 0;
+  uint32_t used_ = 0;
+  uint32_t budget_;
+  uint32_t clock_ = 0;
+  uint32_t recentMisses_[TTS_CACHE_RECENT_MISSES] = {0};
+  int recentHead_ = 0;
+  TtsCacheStats stats_;
+};
@@ -0,0 +1,164 @@
+/*
+================================================================================
+  KIKO - Voice activity detection on captured PCM
+================================================================================
+  Frame-based energy / zero-crossing detector used while recording:
+
+  - Each 20 ms frame is reduced to its AC energy and zero-crossing count
+    (around the running DC estimate of the PDM microphone).
+  - The noise floor adapts on non-speech frames (fast down, slow up).
+  - A frame is speech when its energy is well above the floor, or moderately
+    above it with a high zero-crossing rate (unvoiced consonants: s, f, sh).
+  - Onset needs several consecutive speech frames; the end of speech is the
+    last speech frame, and the caller decides how much silence ends a turn.
+
+  vadFrameStatsRef() is the plain reference kernel. vadFrameStats() is the
+  one used on the device: four samples per iteration with independent
+  accumulators, which keeps the ESP32-S3 multiplier pipeline busy and avoids
+  the loop-carried dependency of the reference. Both must return identical
+  results; set VAD_REFERENCE_KERNEL to 1 to run the reference instead.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define VAD_FRAME_SAMPLES 160          // 20 ms at 8 kHz
+#define VAD_ONSET_FRAMES 3             // Consecutive speech frames that start an utterance
+#define VAD_ENERGY_RATIO 4.0f          // Speech: energy above floor * ratio (~6 dB)
+#define VAD_FRICATIVE_RATIO 1.8f       // ...or above floor * this with a high ZCR
+#define VAD_FRICATIVE_ZCR 50           // Zero crossings per frame (~2.5 kHz)
+#define VAD_MIN_ENERGY 400.0f          // Absolute floor (mean square), ignores a dead-quiet room
+#define VAD_REFERENCE_KERNEL 0
+
+struct VadFrameStats {
+  int64_t sum = 0;       // Sum of samples (for the DC estimate)
+  uint64_t sumSq = 0;    // Sum of squares around the DC estimate
+  uint32_t crossings = 0;
+};
+
+inline VadFrameStats vadFrameStatsRef(const int16_t* x, int n, int16_t dc) {
+  VadFrameStats s;
+  int32_t prev = x[0] - dc;
+  for (int i = 0; i < n; i++) {
+    int32_t y = x[i] - dc;
+    s.sum += x[i];
+    s.sumSq += (uint64_t)((int64_t)y * y);
+    if ((y ^ prev) < 0) s.crossings++;
+    prev = y;
+  }
+  return s;
+}
+
+inline VadFrameStats vadFrameStats(const int16_t* x, int n, int16_t dc) {
+#if VAD_REFERENCE_KERNEL
+  return vadFrameStatsRef(x, n, dc);
+#else
+  int32_t sum0 = 0, sum1 = 0;          // 4 * 32767 * 160 fits comfortably in 32 bits
+  uint64_t sq0 = 0, sq1 = 0, sq2 = 0, sq3 = 0;
+  uint32_t zc = 0;
+  int32_t prev = x[0] - dc;
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int32_t a = x[i] - dc, b = x[i + 1] - dc, c = x[i + 2] - dc, d = x[i + 3] - dc;
+    sum0 += x[i] + x[i + 2];
+    sum1 += x[i + 1] + x[i + 3];
+    sq0 += (uint32_t)a * (uint32_t)a;  // |y| <= 65535: the square fits in uint32
+    sq1 += (uint32_t)b * (uint32_t)b;
+    sq2 += (uint32_t)c * (uint32_t)c;
+    sq3 += (uint32_t)d * (uint32_t)d;
+    // Sign bit of (p ^ q) is set when p and q have opposite signs
+    zc += ((uint32_t)(prev ^ a) >> 31) + ((uint32_t)(a ^ b) >> 31) +
+          ((uint32_t)(b ^ c) >> 31) + ((uint32_t)(c ^ d) >> 31);
+    prev = d;
+  }
+  VadFrameStats s;
+  for (; i < n; i++) {
+    int32_t y = x[i] - dc;
+    sum0 += x[i];
+    sq0 += (uint32_t)y * (uint32_t)y;
+    zc += (uint32_t)(prev ^ y) >> 31;
+    prev = y;
+  }
+  s.sum = (int64_t)sum0 + sum1;
+  s.sumSq = sq0 + sq1 + sq2 + sq3;
+  s.crossings = zc;
+  return s;
+#endif
+}
+
+class VoiceActivityDetector {
+ public:
+  void reset() {
+    dc_ = 0;
+    noiseFloor_ = -1.0f;
+    runLength_ = 0;
+    runStart_ = 0;
+    detected_ = false;
+    speechStart_ = 0;
+    speechEnd_ = 0;
+    frames_ = 0;
+    speechFrames_ = 0;
+    busyMicros_ = 0;
+  }
+
+  // Feed one VAD_FRAME_SAMPLES frame starting at sample offset pos of the clip.
+  void process(const int16_t* frame, uint32_t pos) {
+    unsigned long t0 = micros();
+    VadFrameStats s = vadFrameStats(frame, VAD_FRAME_SAMPLES, dc_);
+    float energy = (float)s.sumSq / VAD_FRAME_SAMPLES;
+    dc_ = (int16_t)((dc_ * 7 + s.sum / VAD_FRAME_SAMPLES) / 8);
+
+    if (noiseFloor_ < 0) noiseFloor_ = energy;  // First frame: the finger just touched the pad
+    float floor = noiseFloor_ > VAD_MIN_ENERGY ? noiseFloor_ : VAD_MIN_ENERGY;
+    bool speech = energy > floor * VAD_ENERGY_RATIO ||
+                  (energy > floor * VAD_FRICATIVE_RATIO && s.crossings >= VAD_FRICATIVE_ZCR);
+
+    frames_++;
+    if (speech) {
+      speechFrames_++;
+      if (runLength_ == 0) runStart_ = pos;
+      runLength_++;
+      if (!detected_ && runLength_ >= VAD_ONSET_FRAMES) {
+        detected_ = true;
+        speechStart_ = runStart_;
+      }
+      if (detected_) speechEnd_ = pos + VAD_FRAME_SAMPLES;
+    } else {
+      runLength_ = 0;
+      // Track the background: drop quickly to quieter frames, rise slowly
+      if (energy < noiseFloor_) noiseFloor_ = energy;
+      else noiseFloor_ += (energy - noiseFloor_) * 0.05f;
+    }
+    busyMicros_ += micros() - t0;
+  }
+
+  // Before onset the caller may discard old samples from the front of the clip.
+  // Shifts all stored positions down by the number of samples dropped.
+  void rebase(uint32_t dropped) {
+    runStart_ = runStart_ > dropped ? runStart_ - dropped : 0;
+  }
+
+  // Earliest sample the detector may still report as the start of speech
+  uint32_t candidateStart(uint32_t pos) const { return runLength_ > 0 ? runStart_ : pos; }
+
+  bool speechDetected() const { return detected_; }
+  uint32_t speechStart() const { return speechStart_; }
+  uint32_t speechEnd() const { return speechEnd_; }      // One past the last speech frame
+  uint32_t frames() const { return frames_; }
+  uint32_t speechFrames() const { return speechFrames_; }
+  float microsPerFrame() const { return frames_ ? (float)busyMicros_ / frames_ : 0.0f; }
+  float noiseFloor() const { return noiseFloor_; }
+
+ private:
+  int16_t dc_ = 0;
+  float noiseFloor_ = -1.0f;
+  uint32_t runLength_ = 0;
+  uint32_t runStart_ = 0;
+  bool detected_ = false;
+  uint32_t speechStart_ = 0;
+  uint32_t speechEnd_ = 0;
+  uint32_t frames_ = 0;
+  uint32_t speechFrames_ = 0;
+  unsigned long busyMicros_ = 0;
+};
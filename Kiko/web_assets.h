@@ -0,0 +1,513 @@
+/*
+  Generated by tools/web_compiler.py from assets/web/.
+  Do not edit; change the sources and run the compiler again.
+
+  asset          source minified   gzip  etag
+  /style.css      13489    11723   3019  9c0dd3b1d28d0703
+  /app.js         11912    11911   3663  ef275b8b98dd99a0
+  /index.html      3128     2334    832  2d14589022d67bf0
+  total           28529            7514
+*/
+#pragma once
+
+#include <Arduino.h>
+
+struct WebAsset {
+  const char* path;
+  const char* contentType;
+  const char* etag;             // Quoted strong ETag
+  const char* version;          // The same hash bare, as used in ?v= URLs
+  bool versioned;               // Linked with ?v=, so it may be cached for good
+  const uint8_t* data;          // gzip
+  uint32_t length;
+  uint32_t rawLength;           // Minified size before gzip
+};
+
+// style.css
+const uint8_t web_style_css_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0x5b, 0x8f, 0xa3, 0x38,
+  0x16, 0xfe, 0x2b, 0xac, 0x4a, 0xa3, 0x4e, 0x5a, 0x80, 0xb8, 0x87, 0x90, 0x97, 0x91, 0x66, 0xb5,
+  0xd2, 0x4a, 0xab, 0x7d, 0x9e, 0x7d, 0x34, 0x60, 0x12, 0xb6, 0xb8, 0xad, 0x21, 0x55, 0x95, 0x89,
+  0xf2, 0xdf, 0xf7, 0xd8, 0xe6, 0x62, 0x83, 0xc9, 0xa5, 0xd4, 0x3d, 0xd3, 0xad, 0x2a, 0x30, 0xc7,
+  0xe7, 0x7e, 0xbe, 0x73, 0xec, 0x88, 0xd4, 0x75, 0x77, 0x35, 0x8c, 0xf8, 0x68, 0xa4, 0x88, 0xbc,
+  0x47, 0x6f, 0x16, 0xb2, 0xb0, 0xb3, 0x3b, 0xb0, 0x27, 0x09, 0x22, 0x69, 0xf4, 0x66, 0x63, 0xc7,
+  0x76, 0xf7, 0xf0, 0xa4, 0x21, 0x79, 0x89, 0xc8, 0x05, 0xd6, 0x58, 0xa9, 0x97, 0x65, 0xd3, 0x13,
+  0xa3, 0xc8, 0x8f, 0xa7, 0x2e, 0x7a, 0xf3, 0xb2, 0xc4, 0x66, 0xcf, 0x51, 0x92, 0xe0, 0x0a, 0x1e,
+  0x04, 0xc1, 0x0e, 0x63, 0x04, 0x0f, 0x3a, 0xfc, 0xd5, 0x19, 0x25, 0xca, 0xab, 0xe8, 0x0d, 0x87,
+  0x18, 0xe1, 0x74, 0x78, 0x96, 0xe6, 0x65, 0xf4, 0xb6, 0xdf, 0x53, 0xf2, 0x6d, 0x87, 0x3a, 0x6c,
+  0xe4, 0x69, 0x81, 0x85, 0x0f, 0xf9, 0xc3, 0x22, 0x6f, 0x3b, 0x5c, 0xe5, 0xd5, 0x31, 0x7a, 0xcb,
+  0x7c, 0x7f, 0x17, 0x24, 0xe3, 0x9b, 0xee, 0x94, 0x57, 0xef, 0xfc, 0x45, 0x86, 0x7c, 0xcb, 0x1a,
+  0x5f, 0xb4, 0x0d, 0x46, 0xfc, 0x85, 0xe7, 0xe2, 0xfd, 0x2e, 0x1e, 0x5f, 0xa0, 0x02, 0x11, 0xd8,
+  0x33, 0x43, 0x3b, 0x6b, 0x3f, 0xed, 0xd0, 0x9e, 0xc9, 0x07, 0xce, 0x8b, 0x02, 0x55, 0x09, 0xa6,
+  0xb4, 0x5c, 0xf8, 0x43, 0x95, 0x50, 0x93, 0x14, 0x13, 0xe3, 0x58, 0xd4, 0x9f, 0x11, 0x39, 0xc6,
+  0x68, 0x63, 0xe9, 0x8e, 0xed, 0xe8, 0x8e, 0xef, 0xeb, 0xa6, 0xb3, 0x95, 0x17, 0x00, 0x25, 0x52,
+  0xc3, 0x86, 0xf3, 0x75, 0xde, 0xf6, 0xf6, 0xf3, 0x0a, 0x6a, 0x3a, 0x82, 0xf4, 0xd6, 0xa1, 0x41,
+  0x69, 0x4a, 0xd9, 0xb2, 0x0e, 0x71, 0xfd, 0x65, 0xb4, 0xf9, 0x5f, 0xf4, 0x97, 0x9e, 0x0a, 0x3c,
+  0xb9, 0x9d, 0xba, 0xb2, 0xb8, 0x66, 0x75, 0xd5, 0xd1, 0x77, 0x38, 0xb2, 0x83, 0xe6, 0xeb, 0x16,
+  0xd7, 0xe9, 0x85, 0x3f, 0xcb, 0x50, 0x99, 0x17, 0x97, 0xa8, 0xbd, 0x80, 0x3e, 0x4a, 0xe3, 0x9c,
+  0xeb, 0x06, 0x6a, 0x9a, 0x02, 0xd8, 0x67, 0x0f, 0xf4, 0x16, 0x55, 0xad, 0xd1, 0x62, 0x92, 0x67,
+  0x87, 0x18, 0x25, 0xef, 0x47, 0x52, 0x9f, 0xab, 0x34, 0x2a, 0xf2, 0x0a, 0x23, 0xe0, 0x91, 0xa0,
+  0x34, 0x07, 0xb3, 0x6c, 0x6c, 0xd7, 0x4f, 0xf1, 0x51, 0xff, 0x40, 0x64, 0x33, 0x1a, 0x7e, 0xab,
+  0x59, 0xbf, 0xe9, 0x6f, 0x56, 0x66, 0x7b, 0xae, 0xa3, 0xd9, 0x96, 0xf5, 0xdb, 0xf6, 0x90, 0xd4,
+  0x45, 0x4d, 0x22, 0xbe, 0x6a, 0xb4, 0xdf, 0xf6, 0x40, 0xa9, 0x19, 0x27, 0xcc, 0x2c, 0x6e, 0x9b,
+  0xc1, 0xa1, 0xcc, 0xab, 0xf1, 0x57, 0xcb, 0xfa, 0x38, 0x1d, 0xea, 0x0f, 0x4c, 0x32, 0xaa, 0x8f,
+  0xaf, 0xe8, 0x94, 0xa7, 0x29, 0xae, 0x6e, 0x66, 0x02, 0xbc, 0xc3, 0xc7, 0x98, 0x80, 0x1e, 0xbe,
+  0x8c, 0xcf, 0x3c, 0xed, 0x4e, 0x91, 0xed, 0x58, 0x56, 0xf3, 0x75, 0x18, 0x14, 0xa3, 0xa1, 0x73,
+  0x57, 0x8f, 0xda, 0x71, 0xe0, 0xd5, 0xcd, 0x3c, 0x61, 0x04, 0x6a, 0xb9, 0x3e, 0x16, 0x65, 0xae,
+  0x72, 0xdb, 0x61, 0xf2, 0xb0, 0xc7, 0xbb, 0xbd, 0x6e, 0xef, 0x5d, 0xfe, 0xdc, 0x0a, 0xb7, 0xbd,
+  0x70, 0xc3, 0x46, 0x1e, 0x6c, 0xa4, 0xb9, 0x94, 0x91, 0xde, 0x06, 0x94, 0xf2, 0xb9, 0x65, 0x7a,
+  0xef, 0x1f, 0x45, 0x36, 0x2c, 0x69, 0xeb, 0x22, 0x4f, 0xb5, 0x5e, 0x65, 0x93, 0xcd, 0xb7, 0x3d,
+  0xff, 0xf0, 0xac, 0xeb, 0xea, 0x32, 0x62, 0x94, 0x98, 0xb2, 0x10, 0xc4, 0x44, 0x15, 0xd1, 0x30,
+  0xc0, 0x84, 0x9b, 0xfa, 0x84, 0x52, 0xf0, 0x22, 0x4b, 0x0b, 0xe9, 0x8e, 0x0e, 0xfc, 0xd3, 0x73,
+  0x4d, 0xff, 0x33, 0xdd, 0xad, 0x9e, 0x57, 0x2d, 0xee, 0x34, 0x4b, 0xa3, 0xdb, 0xd9, 0xc3, 0x6b,
+  0xca, 0xf6, 0xf0, 0xd7, 0xb4, 0xb7, 0xcc, 0xac, 0x29, 0xa9, 0x1b, 0x23, 0xcb, 0x0b, 0xa0, 0x1c,
+  0xc5, 0xc5, 0x99, 0x6c, 0x6c, 0xd8, 0x75, 0x3b, 0xa8, 0x4b, 0x3b, 0xd9, 0x82, 0xff, 0x24, 0x05,
+  0x2a, 0x9b, 0x8d, 0x03, 0xbe, 0xe1, 0x7f, 0x7c, 0xea, 0x2e, 0x2e, 0x65, 0xbb, 0xf6, 0x01, 0x3c,
+  0x17, 0x03, 0x58, 0x3c, 0x30, 0x1a, 0x9f, 0xdc, 0xb0, 0x3b, 0x08, 0xac, 0x02, 0x77, 0xb0, 0x21,
+  0xc4, 0x15, 0x4a, 0x98, 0x85, 0x06, 0x41, 0x47, 0xb9, 0x2c, 0x8d, 0x5a, 0x4d, 0x53, 0xb8, 0xff,
+  0xc0, 0x59, 0x73, 0x55, 0xec, 0xcd, 0x93, 0xc7, 0xf6, 0x30, 0xf1, 0x6c, 0xee, 0x7d, 0x5c, 0xce,
+  0xf7, 0xb3, 0xa9, 0x43, 0x94, 0x79, 0x62, 0xe4, 0xe0, 0x4c, 0xd7, 0x34, 0x6f, 0x9b, 0x02, 0x5d,
+  0xa2, 0xbc, 0x62, 0xee, 0x18, 0x17, 0x75, 0xf2, 0x2e, 0x50, 0xb0, 0x4d, 0x90, 0x74, 0x90, 0x89,
+  0x70, 0xdf, 0xa4, 0x0c, 0xa3, 0x0a, 0xb6, 0xec, 0xf2, 0xba, 0x8a, 0xc0, 0x41, 0x51, 0xa7, 0xb9,
+  0xad, 0x86, 0x51, 0x0b, 0x49, 0xa7, 0x32, 0xea, 0x73, 0xa7, 0xe5, 0x55, 0x96, 0x57, 0x79, 0x87,
+  0x6f, 0xbf, 0xbf, 0xe3, 0x4b, 0x46, 0x50, 0x89, 0x5b, 0x8d, 0x2d, 0xbc, 0x82, 0x33, 0x51, 0xbf,
+  0xb9, 0x76, 0x04, 0x22, 0x2c, 0xab, 0x21, 0x81, 0xb0, 0x9f, 0x0a, 0x48, 0x1d, 0xff, 0xd9, 0x58,
+  0xdb, 0x9b, 0xbf, 0xf6, 0xce, 0x08, 0xa9, 0x69, 0x6e, 0x66, 0x87, 0xe2, 0x76, 0xe4, 0x3a, 0x2b,
+  0xf0, 0xd7, 0xe1, 0x88, 0x1a, 0xa6, 0x67, 0x85, 0x03, 0x8d, 0xe9, 0x80, 0x3d, 0x72, 0xee, 0xb9,
+  0x5f, 0xef, 0xc7, 0xc3, 0x5a, 0x26, 0xa5, 0x10, 0x80, 0x2c, 0xa8, 0xda, 0x84, 0xd4, 0x45, 0x61,
+  0xc4, 0xf8, 0x84, 0x3e, 0x72, 0x50, 0x7f, 0x5b, 0x42, 0xce, 0x3f, 0x71, 0x9e, 0xa2, 0x08, 0x6c,
+  0x1c, 0xbf, 0xe7, 0xa0, 0x38, 0xb6, 0x2a, 0x46, 0xe4, 0xda, 0x47, 0xb3, 0x47, 0x35, 0xbe, 0xb2,
+  0xc6, 0x00, 0x11, 0x93, 0x77, 0x31, 0x32, 0xad, 0x3b, 0x6b, 0x4f, 0xe7, 0x32, 0x16, 0xd7, 0xce,
+  0x7c, 0x4f, 0x8e, 0x3c, 0xa7, 0xdf, 0xd6, 0x88, 0xbb, 0x4a, 0xda, 0x60, 0x99, 0x90, 0xa0, 0x78,
+  0x0c, 0x5f, 0x47, 0x55, 0x5d, 0xe1, 0x31, 0xaa, 0xa9, 0x1a, 0x34, 0x07, 0x04, 0x38, 0x24, 0x67,
+  0xd2, 0xc2, 0x47, 0x4d, 0x9d, 0xb3, 0x40, 0x9c, 0x3b, 0x99, 0xe8, 0xe4, 0xb4, 0x7a, 0xc8, 0x9a,
+  0x77, 0x47, 0xcd, 0x33, 0x8b, 0x36, 0x88, 0x40, 0x38, 0x1f, 0xd8, 0xcf, 0x39, 0xf3, 0x22, 0x54,
+  0x14, 0x9a, 0x09, 0x4e, 0x94, 0x9c, 0x63, 0xf0, 0xcc, 0x18, 0xff, 0x95, 0x63, 0xb2, 0x31, 0x3d,
+  0x1a, 0xd0, 0x8e, 0x0e, 0xd1, 0xfa, 0x79, 0xca, 0x59, 0x29, 0x42, 0x50, 0x54, 0xaa, 0xfa, 0x93,
+  0xa0, 0xe6, 0xd0, 0xd4, 0xfd, 0xb7, 0x04, 0x83, 0x87, 0xe4, 0x1f, 0x78, 0x14, 0x36, 0x3a, 0x51,
+  0xc3, 0xa9, 0x42, 0x64, 0x3b, 0xae, 0x31, 0x51, 0x42, 0xbf, 0x51, 0x2e, 0x92, 0x99, 0x37, 0x9e,
+  0xa1, 0x13, 0x45, 0x28, 0xeb, 0xd8, 0x9e, 0xa0, 0x1d, 0x28, 0xd8, 0x3f, 0x7e, 0x4c, 0xfc, 0x81,
+  0x31, 0xeb, 0xe2, 0xdc, 0xe1, 0x43, 0xaf, 0x0c, 0x83, 0xf9, 0x56, 0x81, 0xb3, 0x0e, 0x4c, 0xc1,
+  0x63, 0xca, 0x3a, 0x0c, 0x89, 0x9f, 0x3a, 0xed, 0x64, 0x2a, 0x6a, 0x49, 0x54, 0x4c, 0x59, 0x1a,
+  0x17, 0x45, 0xde, 0xb4, 0x58, 0x83, 0x88, 0xe3, 0x09, 0x51, 0x97, 0xd9, 0xa2, 0xb9, 0x5a, 0xd0,
+  0xb0, 0xb6, 0xa3, 0x19, 0x5a, 0x4a, 0x70, 0x2c, 0xbf, 0x51, 0xde, 0x7b, 0x4e, 0xc7, 0x50, 0x62,
+  0x66, 0x17, 0xc2, 0x1a, 0xf2, 0xcc, 0x3f, 0xab, 0xbf, 0xd7, 0x9f, 0x95, 0x66, 0x7a, 0xab, 0x76,
+  0x91, 0x48, 0x0d, 0x2a, 0x1d, 0x28, 0xb2, 0x5c, 0x22, 0x65, 0x80, 0x91, 0xe6, 0x35, 0x23, 0x75,
+  0x79, 0xad, 0x69, 0x46, 0xea, 0x2e, 0x20, 0xbd, 0x32, 0xe2, 0x79, 0x32, 0xee, 0xea, 0x71, 0x9d,
+  0x7d, 0x58, 0xcb, 0x1a, 0x50, 0x18, 0x01, 0x61, 0x89, 0x4e, 0xce, 0x92, 0xa7, 0x6b, 0xe9, 0xae,
+  0xab, 0xfb, 0x3b, 0xdd, 0x0c, 0xb7, 0x4f, 0xd5, 0xa0, 0x59, 0xe9, 0xa2, 0x7e, 0x3f, 0x16, 0xd2,
+  0x65, 0x8a, 0x71, 0x7c, 0x96, 0x62, 0x84, 0x8a, 0x44, 0x59, 0xd6, 0x3c, 0xeb, 0x3b, 0x25, 0xc9,
+  0xf2, 0xef, 0xd5, 0xa4, 0x17, 0x62, 0x85, 0xeb, 0xa2, 0x8f, 0x81, 0x5e, 0x20, 0xd1, 0x85, 0x97,
+  0x40, 0x6b, 0x3b, 0x13, 0x02, 0xc4, 0xd2, 0x7c, 0x55, 0x05, 0xb2, 0xfd, 0x27, 0x25, 0xe1, 0x3c,
+  0x68, 0x27, 0x47, 0x1d, 0x5f, 0x52, 0x7d, 0xf1, 0xa7, 0x02, 0x33, 0xe4, 0x5e, 0xaa, 0x6a, 0x29,
+  0xc5, 0x33, 0x0c, 0x60, 0x40, 0x0a, 0x28, 0xdb, 0x01, 0x09, 0xd0, 0xac, 0xcf, 0x02, 0x49, 0xcc,
+  0x3c, 0xc1, 0xb2, 0xbc, 0x9a, 0x3e, 0x4d, 0x83, 0x3d, 0x3b, 0x51, 0x14, 0x63, 0x70, 0x1f, 0x2c,
+  0xc6, 0xa9, 0xb2, 0x02, 0x72, 0x64, 0x45, 0xed, 0x3f, 0x02, 0x34, 0x5a, 0x08, 0xef, 0x01, 0xa8,
+  0xd0, 0x9a, 0xb0, 0xa0, 0x18, 0x8f, 0xaa, 0x1a, 0xdd, 0x63, 0x27, 0x45, 0xbe, 0xe6, 0x20, 0x3a,
+  0x46, 0xe9, 0x11, 0xab, 0x6b, 0xf3, 0x98, 0x99, 0x03, 0x8a, 0x7e, 0x82, 0x05, 0xde, 0x62, 0x75,
+  0x6f, 0x0e, 0x5b, 0x6c, 0x80, 0x2d, 0x8e, 0x49, 0x81, 0x8b, 0x6d, 0x3a, 0x14, 0xba, 0xcc, 0x31,
+  0xc9, 0x12, 0x69, 0xf5, 0x70, 0x92, 0x21, 0x11, 0x56, 0xfc, 0x96, 0x30, 0x62, 0x89, 0xc6, 0x68,
+  0x44, 0xcc, 0x5c, 0x5f, 0xe5, 0xb9, 0x14, 0x2a, 0xf0, 0x2d, 0xa7, 0x80, 0x3e, 0x37, 0x0d, 0x26,
+  0x09, 0xbc, 0x18, 0x74, 0x40, 0xfb, 0x97, 0xeb, 0xb3, 0xe0, 0x7b, 0xfa, 0x84, 0xe3, 0xef, 0x30,
+  0xde, 0xe3, 0x2c, 0x90, 0xf0, 0x37, 0xf4, 0x22, 0xd9, 0x3d, 0x8e, 0x6d, 0x0b, 0xa2, 0xc7, 0x09,
+  0x74, 0xc7, 0xf5, 0x28, 0xdf, 0x03, 0x1b, 0x63, 0xc7, 0xf4, 0x22, 0x2f, 0xe3, 0x77, 0x9c, 0xa1,
+  0x2c, 0xdb, 0xa1, 0x10, 0x3f, 0x60, 0xc8, 0x12, 0xd8, 0x71, 0x3c, 0x5f, 0x0f, 0x77, 0x00, 0x96,
+  0x42, 0xdd, 0x84, 0xd4, 0x30, 0x65, 0xe6, 0xe6, 0x5c, 0xb4, 0x02, 0x79, 0xcd, 0x7e, 0x0c, 0xbd,
+  0x66, 0x9f, 0x8c, 0x20, 0xec, 0xc9, 0xcd, 0x19, 0x28, 0x9b, 0xad, 0x9d, 0xf2, 0x83, 0xb8, 0x36,
+  0xa4, 0xa9, 0x58, 0xee, 0x27, 0x5f, 0x54, 0xdb, 0xf0, 0xd9, 0xa0, 0xb5, 0x38, 0xf4, 0x52, 0x59,
+  0x6b, 0x96, 0x65, 0xdd, 0xd1, 0x1a, 0x24, 0x20, 0x3b, 0xf0, 0xa9, 0xeb, 0x29, 0x94, 0x36, 0x10,
+  0xd7, 0x6c, 0xd3, 0x7f, 0x56, 0x6b, 0xa3, 0x1c, 0x8f, 0x95, 0x26, 0xee, 0xfd, 0x40, 0x67, 0xd3,
+  0x52, 0x41, 0x65, 0x43, 0xa7, 0xfd, 0xa2, 0xca, 0x86, 0xcf, 0xb8, 0xca, 0x02, 0x3b, 0xf3, 0x51,
+  0xf0, 0x40, 0x65, 0xb2, 0xe7, 0x07, 0x3b, 0x70, 0x7a, 0x17, 0x9c, 0xdf, 0xa5, 0x4d, 0xc6, 0x42,
+  0x6b, 0x03, 0x7d, 0xcd, 0x0c, 0x9f, 0x55, 0xda, 0x28, 0x89, 0x52, 0x69, 0xf7, 0x76, 0x5f, 0xea,
+  0x2d, 0x94, 0x4a, 0xaa, 0xb8, 0x7a, 0x37, 0xa9, 0x8e, 0xcd, 0x22, 0x5e, 0x57, 0x1d, 0xfb, 0x6c,
+  0x70, 0x35, 0x1f, 0x85, 0xce, 0x2b, 0x01, 0xea, 0x5b, 0xba, 0x0d, 0x95, 0xd1, 0xf6, 0x21, 0x5f,
+  0x04, 0x4b, 0xb5, 0x31, 0xda, 0xda, 0x9a, 0xa3, 0x49, 0x35, 0xd0, 0x9b, 0x01, 0xe8, 0xd0, 0xb2,
+  0x96, 0x3a, 0x65, 0xf4, 0x9e, 0xf1, 0x42, 0x99, 0xad, 0x29, 0xc3, 0xb6, 0x09, 0x2a, 0xf0, 0xc6,
+  0x7e, 0xe8, 0x9a, 0xd3, 0xf7, 0xb6, 0xe2, 0x73, 0xd3, 0x72, 0x40, 0xed, 0x02, 0x77, 0x8c, 0x2f,
+  0xe8, 0x0d, 0xd7, 0x43, 0xc4, 0x93, 0xfc, 0xde, 0xdf, 0xeb, 0x5e, 0x48, 0x59, 0x1b, 0xa1, 0x84,
+  0xd8, 0xef, 0x0a, 0x2b, 0x9c, 0x67, 0x99, 0x0f, 0x54, 0x5f, 0xef, 0x45, 0xfa, 0xae, 0x6a, 0x85,
+  0xa7, 0x94, 0xce, 0x15, 0xe2, 0x51, 0x18, 0x65, 0xbd, 0x1a, 0x93, 0xc2, 0xa7, 0x83, 0x7f, 0x05,
+  0xf0, 0xe7, 0xa1, 0x7f, 0xcd, 0x38, 0xb5, 0xe9, 0xff, 0xd4, 0x8c, 0x3d, 0x7a, 0x9d, 0xb7, 0xb0,
+  0x8a, 0xdd, 0x6e, 0x6f, 0x4c, 0xaa, 0x84, 0xe4, 0x0d, 0xf5, 0xc6, 0x05, 0x28, 0x16, 0xf0, 0x9c,
+  0x15, 0x4e, 0xf3, 0x1b, 0x06, 0xba, 0x66, 0xf8, 0x97, 0x8d, 0x95, 0xa6, 0xa9, 0x94, 0x3f, 0xb5,
+  0xd4, 0x8c, 0x91, 0x14, 0xb5, 0x27, 0x3c, 0x70, 0x32, 0x03, 0x77, 0xdd, 0xa5, 0xc0, 0x51, 0xde,
+  0x01, 0xa4, 0x48, 0x0e, 0x2f, 0xcc, 0x2a, 0x3e, 0x81, 0xba, 0x41, 0xdb, 0xbb, 0x28, 0x26, 0x90,
+  0x42, 0x0c, 0xfa, 0xfb, 0x1a, 0x82, 0x98, 0x09, 0x3a, 0xb4, 0x1f, 0x77, 0xe4, 0xb5, 0xfd, 0x11,
+  0x73, 0x71, 0x06, 0x99, 0x2a, 0x0f, 0x0a, 0x90, 0x2c, 0xb4, 0x82, 0xa3, 0x79, 0x26, 0x77, 0xb2,
+  0x7d, 0x15, 0x38, 0x06, 0xcd, 0x27, 0x27, 0xd4, 0xfd, 0x0b, 0xca, 0x2c, 0x9b, 0xce, 0x0d, 0xdd,
+  0x3f, 0x53, 0xdb, 0x38, 0x4a, 0xb8, 0xf0, 0x51, 0xc2, 0x37, 0xba, 0x11, 0x4b, 0xe8, 0x46, 0x6c,
+  0x7f, 0xd6, 0x28, 0x0a, 0x98, 0xcb, 0x11, 0x18, 0x51, 0x4d, 0x25, 0x38, 0xb6, 0xa5, 0xe3, 0xd0,
+  0x7b, 0xcb, 0x96, 0x83, 0x89, 0x85, 0xf7, 0xf8, 0x73, 0x16, 0xdd, 0x87, 0x34, 0xe7, 0x03, 0x8c,
+  0x39, 0x4d, 0xf7, 0x7b, 0x24, 0x87, 0x6e, 0x67, 0x9d, 0x30, 0xeb, 0x49, 0x80, 0x8c, 0x51, 0xb6,
+  0xc7, 0xab, 0x34, 0xdd, 0x60, 0x03, 0xca, 0x59, 0x03, 0xe2, 0xa8, 0x63, 0x41, 0xe9, 0x9d, 0x53,
+  0xde, 0x6f, 0xc1, 0x8e, 0xd0, 0xe0, 0x4e, 0x10, 0x77, 0xb5, 0x87, 0xa1, 0x0f, 0x68, 0xec, 0x92,
+  0x8e, 0xf7, 0x31, 0x74, 0x48, 0x2b, 0xa4, 0xd4, 0x9e, 0xd0, 0x13, 0x5d, 0xf2, 0x9f, 0x1b, 0xe3,
+  0xb9, 0x36, 0xf9, 0x4f, 0xde, 0x26, 0x83, 0xf4, 0x7c, 0xee, 0x27, 0x96, 0x1f, 0xd6, 0x81, 0x81,
+  0xf4, 0xdc, 0x31, 0xd8, 0xb4, 0x67, 0xd9, 0x0f, 0x70, 0x96, 0x4f, 0x90, 0xe7, 0xdf, 0xe9, 0x88,
+  0x8a, 0x12, 0xa2, 0x8b, 0xae, 0xf4, 0x39, 0x6c, 0xa9, 0x52, 0x4d, 0xaf, 0xf1, 0x73, 0xfb, 0xfc,
+  0xe8, 0x59, 0x02, 0xe1, 0xc2, 0xec, 0xd9, 0xb6, 0x43, 0x7d, 0x47, 0x31, 0x93, 0x43, 0x03, 0x4d,
+  0x6e, 0x9f, 0xd8, 0x24, 0xc5, 0x9d, 0x05, 0x12, 0x3f, 0x38, 0xd9, 0x1e, 0xfe, 0x7b, 0x6e, 0xbb,
+  0x3c, 0xbb, 0x0c, 0x33, 0x0a, 0xae, 0x79, 0x5c, 0xa5, 0x5c, 0x9e, 0x34, 0x27, 0x38, 0xe1, 0x43,
+  0x24, 0x08, 0x4d, 0x82, 0xc1, 0x89, 0x68, 0x03, 0x32, 0xb2, 0xad, 0x4d, 0x0a, 0x13, 0xb3, 0x43,
+  0x4f, 0xbc, 0x5f, 0x88, 0xf2, 0xef, 0x0c, 0xd6, 0xfd, 0x47, 0x83, 0xf5, 0x7b, 0xd2, 0x4d, 0x63,
+  0xa8, 0x9e, 0x83, 0x15, 0x46, 0xc7, 0x75, 0x6f, 0xac, 0x4a, 0xff, 0x01, 0x1c, 0x76, 0x29, 0x9b,
+  0xbf, 0x28, 0xe6, 0xda, 0xc1, 0x30, 0xd7, 0x16, 0xa1, 0xc8, 0xde, 0x92, 0xc7, 0x85, 0x22, 0x6e,
+  0x52, 0x79, 0x89, 0x70, 0xb6, 0xf2, 0x03, 0xb6, 0x23, 0x39, 0x28, 0xf1, 0xdf, 0xf8, 0xf3, 0x87,
+  0x5e, 0xd6, 0x55, 0xcd, 0xe6, 0x77, 0xd3, 0x44, 0xc5, 0x93, 0x73, 0xd8, 0x3d, 0xcd, 0x31, 0xc0,
+  0x6c, 0xed, 0xd8, 0x5f, 0xe9, 0x50, 0x82, 0xbd, 0x00, 0xe5, 0xed, 0x14, 0xaa, 0x1b, 0x42, 0xd7,
+  0x91, 0xcb, 0x16, 0x57, 0xe4, 0x92, 0x2c, 0xe4, 0x1e, 0xd5, 0x68, 0x7e, 0xad, 0xf8, 0xc8, 0x1a,
+  0x1d, 0xab, 0xcf, 0x7a, 0x39, 0x17, 0x70, 0x99, 0x27, 0x82, 0x13, 0x5b, 0xee, 0x20, 0x46, 0x29,
+  0x57, 0x21, 0x65, 0xb0, 0x02, 0xc3, 0x17, 0x2c, 0x8d, 0xc8, 0xec, 0x39, 0x64, 0xbc, 0x00, 0x60,
+  0xbe, 0xac, 0x67, 0xe8, 0xf2, 0x68, 0x58, 0x52, 0xd7, 0x95, 0xf4, 0xcc, 0xfd, 0x63, 0x09, 0xf0,
+  0x0e, 0xbf, 0x0c, 0x07, 0x4e, 0x8a, 0x98, 0x64, 0x62, 0x73, 0xc9, 0x17, 0xf4, 0x80, 0x62, 0x58,
+  0x64, 0x74, 0x35, 0x87, 0xaa, 0xaf, 0xf8, 0x9d, 0xef, 0xf0, 0xb2, 0xaa, 0x72, 0xba, 0x47, 0xca,
+  0xe8, 0x97, 0xf9, 0xaf, 0xf6, 0x07, 0xb7, 0x9e, 0xeb, 0xbc, 0x52, 0x0c, 0xaa, 0x67, 0x7d, 0x9f,
+  0xd4, 0x4b, 0xd8, 0x90, 0xcc, 0xa7, 0xad, 0xd8, 0x54, 0x57, 0x30, 0x03, 0xfd, 0xfd, 0x66, 0x76,
+  0x75, 0x5a, 0xb3, 0x71, 0xc0, 0x37, 0x12, 0x17, 0x8d, 0x32, 0x65, 0xe2, 0xf2, 0xe7, 0x27, 0x82,
+  0x6b, 0x88, 0x52, 0x4c, 0x6c, 0xde, 0x4a, 0x62, 0x53, 0x4d, 0x04, 0x15, 0x50, 0xec, 0xfe, 0x38,
+  0x75, 0x2d, 0x74, 0x27, 0xf9, 0x97, 0xb8, 0xe1, 0x97, 0x9d, 0x8b, 0x0a, 0x52, 0x1a, 0xeb, 0x00,
+  0x58, 0xe0, 0x45, 0x3b, 0xb9, 0x8f, 0xa7, 0xa5, 0x96, 0x62, 0x5a, 0x3a, 0x1e, 0x20, 0x4e, 0x65,
+  0x3f, 0x41, 0x0d, 0xc3, 0xde, 0x7f, 0xe1, 0xf9, 0x78, 0xb4, 0xdf, 0x90, 0xc2, 0x90, 0x09, 0x06,
+  0xd1, 0xa8, 0xe3, 0x59, 0x72, 0x06, 0xa0, 0x64, 0x95, 0x2e, 0xc0, 0xd9, 0x12, 0x39, 0x05, 0xf3,
+  0xc9, 0xed, 0xbc, 0xfe, 0xb2, 0x12, 0x60, 0xc4, 0xb8, 0xfb, 0xc4, 0xb8, 0x52, 0xcd, 0x75, 0xe7,
+  0x1d, 0xc1, 0xdc, 0x88, 0x4e, 0x8f, 0xad, 0x44, 0x2f, 0x72, 0xd4, 0x5e, 0x24, 0xeb, 0x98, 0xee,
+  0xb2, 0x82, 0x13, 0x65, 0x31, 0x83, 0xe9, 0x30, 0x90, 0x51, 0xb7, 0xf9, 0xf9, 0xdd, 0x40, 0x43,
+  0x33, 0xff, 0xd7, 0x5d, 0x9e, 0x6e, 0x07, 0x9f, 0x9c, 0x04, 0x0b, 0x83, 0x9a, 0xc1, 0x2a, 0xb4,
+  0xe6, 0xdb, 0x8a, 0xf3, 0x74, 0x47, 0x71, 0xa4, 0x2c, 0x28, 0x2d, 0x94, 0xc0, 0x9c, 0xeb, 0x3f,
+  0x3e, 0x46, 0xf7, 0x7a, 0xeb, 0x6b, 0xcb, 0x7b, 0x19, 0xb7, 0xb7, 0x23, 0x28, 0x1d, 0x93, 0xcb,
+  0x38, 0x8b, 0x3e, 0x12, 0x68, 0x98, 0xe8, 0x3f, 0x80, 0xfe, 0xca, 0x86, 0x22, 0x4b, 0xea, 0xdd,
+  0xe7, 0xb2, 0x6a, 0x23, 0x82, 0x21, 0x21, 0x75, 0x1b, 0xda, 0xde, 0xd0, 0x03, 0x8c, 0x42, 0x07,
+  0x36, 0xa0, 0x0f, 0xa2, 0x95, 0xaf, 0xf9, 0xd2, 0xed, 0x8c, 0x6c, 0xb7, 0x1c, 0xed, 0x72, 0xb7,
+  0x19, 0x1b, 0x24, 0x5f, 0xd5, 0x20, 0x8d, 0x3b, 0x3f, 0xe8, 0x60, 0xd6, 0x57, 0x3d, 0xd5, 0xc0,
+  0xdc, 0x27, 0xf0, 0xad, 0x6e, 0xc5, 0xec, 0x29, 0xf2, 0x18, 0x53, 0x18, 0x6f, 0x90, 0xb4, 0xbf,
+  0xd4, 0xb1, 0xd6, 0xda, 0x4b, 0xad, 0xe0, 0x0b, 0x47, 0xa5, 0xcb, 0x51, 0xdb, 0xf2, 0x3c, 0x4a,
+  0x66, 0x72, 0xfd, 0xac, 0x48, 0xd5, 0x06, 0x5b, 0xdc, 0x59, 0x3c, 0x4b, 0xe9, 0x31, 0xea, 0x23,
+  0x3a, 0xc3, 0x63, 0xe7, 0x8e, 0xe2, 0xa6, 0x5a, 0x5e, 0x1e, 0x7b, 0x43, 0xd2, 0x10, 0x18, 0xce,
+  0x59, 0x58, 0x73, 0x2c, 0x9d, 0x20, 0x8a, 0xb2, 0x8f, 0xc4, 0x85, 0x64, 0xbe, 0x94, 0x84, 0x91,
+  0x56, 0x8c, 0x76, 0xa8, 0xb9, 0x13, 0x68, 0xb0, 0x08, 0xfa, 0x63, 0xbc, 0x46, 0xb3, 0x38, 0x45,
+  0x3e, 0xfc, 0x22, 0x8b, 0x3d, 0x75, 0x2e, 0xb8, 0xe0, 0x67, 0x82, 0x91, 0x0b, 0x5b, 0x28, 0x46,
+  0x3d, 0x4f, 0x0d, 0x8f, 0xa6, 0x5d, 0xfe, 0x81, 0x71, 0xfa, 0x9c, 0xca, 0x57, 0xab, 0xf6, 0xdd,
+  0x81, 0xc5, 0xcd, 0x9c, 0xdd, 0x34, 0x50, 0xcd, 0x5f, 0xee, 0x1c, 0xb8, 0xd3, 0x56, 0x74, 0x0d,
+  0x0f, 0xc8, 0x17, 0x12, 0x96, 0xc8, 0x22, 0xbc, 0x7f, 0x45, 0x61, 0x36, 0x60, 0xa5, 0xe7, 0x84,
+  0x2f, 0x84, 0x54, 0x5f, 0xe3, 0xba, 0xba, 0xe1, 0x48, 0x44, 0x79, 0xc4, 0x38, 0x5d, 0x3c, 0xb8,
+  0xa3, 0x01, 0xc7, 0x9f, 0x19, 0x2d, 0x98, 0x05, 0xe8, 0xe3, 0x50, 0x72, 0x58, 0x28, 0xd1, 0xdd,
+  0x7a, 0x5f, 0x59, 0x39, 0x14, 0x97, 0xf7, 0x19, 0xaa, 0x89, 0xea, 0x4c, 0x97, 0x51, 0x33, 0x52,
+  0x54, 0x1d, 0x57, 0x6a, 0xe3, 0xd4, 0x93, 0xf8, 0xc2, 0xec, 0x32, 0x88, 0x83, 0x58, 0x46, 0xbd,
+  0xfd, 0x43, 0x91, 0xde, 0x9d, 0x8a, 0x3b, 0x52, 0x7d, 0xa0, 0x14, 0x79, 0x2d, 0x70, 0x0b, 0x85,
+  0x07, 0x2a, 0xf0, 0xb2, 0xaa, 0x0d, 0x3e, 0xc2, 0x86, 0xd9, 0xf4, 0x7b, 0xf5, 0x45, 0x17, 0x3a,
+  0xde, 0x25, 0x18, 0x95, 0x2c, 0xa2, 0x5a, 0x71, 0x12, 0xe2, 0xac, 0x7d, 0x22, 0x7a, 0x00, 0x2d,
+  0x3b, 0x9c, 0x05, 0xad, 0x19, 0x6e, 0x23, 0x32, 0xcd, 0x5a, 0x73, 0xec, 0x72, 0xfb, 0xbd, 0xc4,
+  0x69, 0x8e, 0xb4, 0xcd, 0x74, 0x57, 0x6f, 0x17, 0xd0, 0x6b, 0x4c, 0x57, 0xe1, 0x1e, 0x9f, 0x38,
+  0xd1, 0x1b, 0x2f, 0xea, 0x8d, 0x2d, 0xb2, 0x3f, 0x48, 0x32, 0xbb, 0x79, 0x20, 0xdc, 0xea, 0x93,
+  0xaf, 0xa9, 0xd9, 0x14, 0x00, 0xf4, 0xd7, 0x21, 0x24, 0x20, 0xbe, 0x04, 0xd4, 0xd3, 0x21, 0xbd,
+  0xd4, 0x3f, 0xa8, 0x11, 0x66, 0x7f, 0xf1, 0x8a, 0xd6, 0x6f, 0x4f, 0xc9, 0xce, 0xfc, 0x02, 0x55,
+  0x28, 0xde, 0x3e, 0x92, 0x91, 0x66, 0x20, 0x9d, 0x50, 0x9b, 0x21, 0x55, 0x95, 0x74, 0xf0, 0xbd,
+  0xbc, 0x7d, 0x24, 0x70, 0x08, 0x8b, 0x95, 0x73, 0x56, 0x97, 0xde, 0x82, 0x9c, 0x00, 0x8b, 0x1a,
+  0xa3, 0x00, 0x0a, 0x11, 0xa1, 0x87, 0xc7, 0xbf, 0x59, 0x1d, 0x8e, 0x38, 0xa0, 0x0b, 0x51, 0x8b,
+  0x3c, 0xc3, 0x49, 0xd2, 0x38, 0x96, 0x42, 0x1a, 0x85, 0xe5, 0xbd, 0x90, 0xce, 0xe9, 0xae, 0xf3,
+  0x5b, 0xa9, 0x0c, 0x5b, 0x2a, 0xbc, 0xc1, 0x51, 0x79, 0x03, 0xd3, 0x9e, 0xbf, 0x6e, 0x7a, 0x7f,
+  0x69, 0x7a, 0x5f, 0x32, 0x9d, 0xa3, 0x32, 0x4a, 0x38, 0xa0, 0x7f, 0x41, 0x8a, 0x1d, 0x25, 0x35,
+  0x3b, 0x48, 0x78, 0xce, 0x64, 0x8c, 0xc7, 0x50, 0xa6, 0xb6, 0x17, 0x55, 0xd2, 0x10, 0x9c, 0x61,
+  0xd2, 0x1a, 0x04, 0xa7, 0xe7, 0x04, 0xa7, 0x46, 0x59, 0xf7, 0xf5, 0x97, 0xfe, 0xba, 0xbd, 0xfe,
+  0xd4, 0x7f, 0x0e, 0xb7, 0x34, 0xe8, 0x4f, 0xfc, 0x5a, 0xd5, 0xd8, 0xd0, 0x1a, 0xe9, 0x99, 0xf0,
+  0xce, 0xd6, 0xb4, 0xec, 0xb2, 0xfd, 0x5b, 0x5e, 0x36, 0x35, 0xe9, 0x50, 0xd5, 0x4d, 0x3d, 0x2f,
+  0x05, 0x02, 0x7c, 0x0d, 0x58, 0x1d, 0x4c, 0x1a, 0xd9, 0xc2, 0xaa, 0x29, 0xe9, 0xaf, 0x52, 0xba,
+  0xdd, 0xfe, 0x0f, 0x76, 0xe7, 0xd3, 0x86, 0xcb, 0x2d, 0x00, 0x00,
+};
+
+// app.js
+const uint8_t web_app_js_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x1a, 0x5d, 0x6f, 0xdb, 0x48,
+  0xee, 0xaf, 0x28, 0x5e, 0x6c, 0x46, 0x3a, 0x2b, 0x8a, 0xb3, 0xbd, 0x3d, 0x6c, 0xad, 0x28, 0x45,
+  0x9a, 0xb6, 0xd7, 0xde, 0x35, 0x6d, 0xd1, 0x64, 0xd1, 0x87, 0x22, 0x08, 0x14, 0x69, 0x62, 0x6b,
+  0xa3, 0xaf, 0x68, 0xc6, 0x49, 0x0d, 0xdb, 0x3f, 0xe2, 0x5e, 0xee, 0x75, 0x5f, 0xf6, 0x07, 0xee,
+  0x4f, 0x38, 0x72, 0x3e, 0xa4, 0x91, 0x2c, 0x3b, 0x49, 0xf7, 0x80, 0x20, 0x96, 0x38, 0x1c, 0x0e,
+  0xc9, 0x21, 0x39, 0x24, 0x47, 0x51, 0x91, 0x33, 0x6e, 0x31, 0x1e, 0x72, 0x1a, 0x2c, 0xa2, 0x59,
+  0x55, 0xd1, 0x9c, 0x9f, 0x87, 0x57, 0x63, 0x82, 0xa0, 0x19, 0x23, 0xee, 0x3d, 0x1b, 0xe7, 0xb3,
+  0x34, 0x85, 0xdf, 0x63, 0xce, 0x69, 0x56, 0x72, 0x36, 0x1e, 0xb9, 0x59, 0xf8, 0xed, 0x4b, 0xf3,
+  0x7e, 0x30, 0x82, 0xd1, 0xcf, 0x94, 0x57, 0xf3, 0x57, 0x34, 0x0d, 0xe7, 0xe3, 0x67, 0xa3, 0xd1,
+  0xc8, 0x4d, 0x43, 0xc6, 0xcf, 0x90, 0xac, 0x9c, 0x1e, 0xa6, 0x61, 0x95, 0xbd, 0xcb, 0x39, 0xad,
+  0xee, 0xc2, 0x54, 0x82, 0x04, 0x06, 0xbd, 0x05, 0x72, 0xb4, 0x2c, 0xa2, 0x29, 0xfc, 0xa6, 0x09,
+  0x03, 0x72, 0x8b, 0xd5, 0xca, 0x8f, 0x8b, 0x68, 0x96, 0x01, 0x2b, 0x5e, 0x18, 0xc7, 0xaf, 0xef,
+  0xe0, 0xe1, 0x3d, 0x0c, 0xd1, 0x9c, 0x56, 0x36, 0x79, 0xf5, 0xf1, 0xf4, 0xa4, 0x00, 0x42, 0x00,
+  0x2b, 0xc2, 0x98, 0xc6, 0xc4, 0xb5, 0x9d, 0xe0, 0x68, 0x91, 0xe4, 0x09, 0x32, 0xfe, 0x21, 0xbc,
+  0x4b, 0x26, 0x21, 0x4f, 0x8a, 0xdc, 0x76, 0x7c, 0x84, 0x7d, 0xa1, 0x57, 0x67, 0x45, 0x74, 0x43,
+  0x39, 0xbc, 0xcf, 0xca, 0x18, 0x18, 0xfa, 0xf5, 0x9d, 0xed, 0xac, 0x1c, 0xff, 0x7a, 0x96, 0x47,
+  0x88, 0x67, 0x75, 0xb0, 0x16, 0x91, 0x50, 0x49, 0x59, 0x15, 0xbc, 0x88, 0x8a, 0x34, 0xb8, 0x4f,
+  0xf2, 0xb8, 0xb8, 0xf7, 0xd2, 0x22, 0x12, 0x64, 0xbd, 0x7a, 0x20, 0x08, 0xc8, 0x94, 0xf3, 0x92,
+  0x8d, 0xc9, 0x0b, 0x72, 0xcf, 0xe0, 0x67, 0x0c, 0x3f, 0x63, 0xe2, 0xcb, 0xf9, 0xd3, 0x82, 0xf1,
+  0xb5, 0xb9, 0x08, 0xcc, 0xc3, 0x8c, 0x2a, 0x9c, 0x7b, 0xf6, 0x6b, 0x95, 0x06, 0x9a, 0xe0, 0x90,
+  0xec, 0xef, 0x93, 0x21, 0xa2, 0x0c, 0xc9, 0xf8, 0x97, 0x03, 0xe2, 0x83, 0x42, 0x17, 0x62, 0x67,
+  0xbc, 0x7b, 0x16, 0xe4, 0xf4, 0xde, 0x6a, 0xb8, 0x14, 0x33, 0x1d, 0x5f, 0x8f, 0x7a, 0x45, 0x5e,
+  0x94, 0x34, 0x0f, 0x84, 0x26, 0x90, 0x76, 0x91, 0x52, 0x58, 0x75, 0x62, 0x13, 0x50, 0x55, 0x4e,
+  0x23, 0x0e, 0x6a, 0x6a, 0xb0, 0xf5, 0xc6, 0x05, 0x23, 0xa5, 0x91, 0x33, 0xb1, 0xd7, 0xef, 0xf2,
+  0x38, 0x01, 0x3e, 0x8b, 0xca, 0xe6, 0xd5, 0x8c, 0x02, 0x3a, 0xcd, 0xe3, 0x53, 0xca, 0x58, 0x38,
+  0xa1, 0xf6, 0x82, 0xcf, 0x4b, 0x3a, 0x26, 0x53, 0x9a, 0xa6, 0x05, 0x71, 0x59, 0x92, 0x47, 0x74,
+  0x2c, 0xc9, 0xa9, 0x5d, 0x54, 0x7b, 0x28, 0x61, 0xe2, 0x79, 0xe5, 0xac, 0x4c, 0xfe, 0x32, 0x49,
+  0x29, 0xb0, 0x29, 0x6e, 0x27, 0xf2, 0x89, 0xe2, 0x49, 0x3d, 0x00, 0x0f, 0x61, 0xf0, 0xaf, 0xb3,
+  0x8f, 0x1f, 0xbc, 0x32, 0xac, 0x18, 0x95, 0x28, 0x1e, 0x42, 0x1d, 0x7f, 0x1a, 0xe6, 0x71, 0x4a,
+  0x35, 0x1f, 0x02, 0xb6, 0x02, 0x2e, 0xa3, 0xa9, 0x4d, 0x9d, 0x5a, 0x54, 0x5a, 0x55, 0xc0, 0x36,
+  0x79, 0x13, 0x26, 0x29, 0x8d, 0x2d, 0x5e, 0x58, 0x82, 0x8e, 0xa5, 0xd6, 0x1c, 0x13, 0x97, 0x3a,
+  0xab, 0x16, 0x37, 0x62, 0x02, 0xf0, 0x82, 0x3f, 0xa6, 0xce, 0x14, 0xa1, 0x5a, 0xd1, 0x96, 0x00,
+  0x20, 0x01, 0x81, 0xb9, 0x41, 0x5f, 0xd7, 0x61, 0xca, 0x68, 0x5b, 0xdc, 0x28, 0x2d, 0x18, 0xed,
+  0xd9, 0x8f, 0x57, 0x09, 0x8b, 0x8c, 0x2d, 0xd9, 0x46, 0xcf, 0xaf, 0xa8, 0x42, 0x35, 0xac, 0x73,
+  0xf5, 0x08, 0xe1, 0xa3, 0x8a, 0x02, 0xd1, 0xc6, 0x5a, 0x84, 0xfc, 0x1b, 0xa8, 0xd5, 0x5e, 0xd0,
+  0x37, 0xbc, 0x48, 0xae, 0xed, 0xae, 0xd1, 0x1c, 0x4a, 0x40, 0x2b, 0x02, 0x38, 0x8b, 0x2e, 0xd6,
+  0x70, 0x08, 0xe6, 0xc3, 0xcf, 0x93, 0x8c, 0x16, 0x33, 0x6e, 0xd7, 0x0e, 0x6a, 0x2e, 0xed, 0xea,
+  0x39, 0x4d, 0xe4, 0x30, 0xf9, 0x09, 0xa3, 0x88, 0x96, 0x68, 0x59, 0x76, 0x2c, 0xf8, 0x88, 0xbd,
+  0xa2, 0x44, 0x97, 0x63, 0x79, 0x58, 0xb2, 0x69, 0xc1, 0x89, 0x5e, 0x54, 0x18, 0x5b, 0x10, 0xcb,
+  0x5f, 0xbf, 0x65, 0x94, 0x00, 0x65, 0xf4, 0x16, 0x24, 0xe7, 0xb3, 0x2a, 0xb7, 0xd0, 0xaa, 0x57,
+  0x82, 0x12, 0x00, 0x0f, 0x83, 0x16, 0xa6, 0xa3, 0x70, 0x84, 0xe6, 0x7d, 0x8d, 0xb4, 0x13, 0xb4,
+  0xb1, 0x86, 0x07, 0xb0, 0xe8, 0x5f, 0xf5, 0x0a, 0xdf, 0x5c, 0x6a, 0xf5, 0x10, 0xbf, 0x8d, 0x3e,
+  0xca, 0x32, 0x45, 0x2d, 0xf1, 0xb0, 0xa3, 0x90, 0x68, 0x1a, 0x82, 0x32, 0x20, 0x4e, 0x9e, 0xc0,
+  0x43, 0xed, 0x27, 0x5e, 0x05, 0xa6, 0xe1, 0xc6, 0x5e, 0x24, 0x43, 0xa5, 0xe3, 0x53, 0x58, 0xcd,
+  0xea, 0x4c, 0xbb, 0x8c, 0x52, 0x1a, 0x56, 0x44, 0x87, 0x3c, 0x0c, 0xbf, 0x41, 0x1d, 0x79, 0x27,
+  0x94, 0xbf, 0x4e, 0x29, 0x3e, 0xbe, 0x9c, 0xbf, 0x8b, 0x6d, 0x31, 0x01, 0xa3, 0x30, 0x58, 0x2d,
+  0x90, 0x41, 0x5c, 0x07, 0xff, 0x79, 0x09, 0x58, 0x4d, 0xf5, 0xf6, 0xfc, 0xf4, 0x7d, 0x40, 0x0e,
+  0x4b, 0x2b, 0x02, 0x51, 0x58, 0x30, 0x40, 0x23, 0x98, 0x0f, 0x8e, 0x3e, 0x14, 0xda, 0x07, 0x99,
+  0x35, 0xa7, 0xdc, 0x3b, 0xdc, 0x2f, 0x8f, 0xc8, 0xaa, 0xcb, 0x0a, 0x2f, 0xe2, 0xa2, 0x61, 0x42,
+  0xab, 0x1c, 0xcf, 0x82, 0xaf, 0xb1, 0xf8, 0xbd, 0x58, 0x2e, 0xed, 0x1e, 0x68, 0xb0, 0x58, 0x39,
+  0x72, 0xaf, 0x6e, 0xf9, 0xfc, 0x68, 0xe4, 0xa4, 0x30, 0x90, 0x80, 0xfd, 0x5d, 0x04, 0x02, 0x22,
+  0x45, 0x8e, 0x69, 0x4a, 0xc1, 0x19, 0xea, 0x31, 0xe5, 0x72, 0xe7, 0xb0, 0x26, 0x4a, 0xc3, 0x4c,
+  0xc2, 0x4e, 0x2f, 0x6b, 0x97, 0xa9, 0x90, 0x7a, 0xa1, 0x28, 0xf5, 0x30, 0xf2, 0x1d, 0x34, 0xb5,
+  0xe6, 0x0d, 0x4c, 0x10, 0x67, 0x3b, 0xa1, 0xc6, 0x18, 0x7a, 0x82, 0xa2, 0x30, 0x09, 0x78, 0x50,
+  0x76, 0x3b, 0xcb, 0x63, 0x7a, 0x9d, 0xe4, 0x54, 0xda, 0xca, 0x8e, 0xe1, 0x4d, 0x88, 0xac, 0xcc,
+  0xdd, 0x37, 0x8d, 0x4a, 0x44, 0x56, 0x4d, 0x64, 0x0a, 0x2b, 0x16, 0xd5, 0x7c, 0x77, 0xf7, 0xb8,
+  0xaa, 0xc2, 0xb9, 0x97, 0x30, 0xf1, 0xdb, 0x1a, 0x73, 0xf4, 0x8e, 0x69, 0xc3, 0x78, 0xac, 0xe9,
+  0xe8, 0x37, 0x98, 0xaf, 0x9e, 0x4c, 0x1b, 0xd2, 0xe7, 0xe7, 0x75, 0x92, 0x42, 0xb2, 0x40, 0xb5,
+  0xaf, 0xb1, 0xc0, 0x5c, 0xdb, 0x93, 0xa3, 0x76, 0xc6, 0x26, 0xc1, 0x11, 0xfc, 0x13, 0xd6, 0x8e,
+  0xba, 0x9d, 0x31, 0x5a, 0x91, 0xe5, 0xd2, 0x04, 0x81, 0x3d, 0xc2, 0xa4, 0x30, 0x57, 0xab, 0x77,
+  0xe9, 0x7a, 0x29, 0xcd, 0x27, 0x7c, 0x0a, 0x98, 0xa3, 0x7e, 0x86, 0x9e, 0x60, 0xd4, 0xda, 0x84,
+  0xc1, 0x9b, 0x6b, 0xb6, 0xd7, 0xd6, 0x63, 0x69, 0x12, 0x51, 0x7b, 0xef, 0x60, 0xe4, 0xf8, 0x26,
+  0xa2, 0x77, 0x5d, 0x54, 0xaf, 0x43, 0x88, 0xec, 0x42, 0xa6, 0x45, 0xc7, 0x9f, 0xb5, 0x40, 0x2e,
+  0x3e, 0x68, 0x9f, 0x86, 0x13, 0x76, 0x55, 0xef, 0x98, 0xb0, 0x14, 0xa7, 0x39, 0x4f, 0xa8, 0x09,
+  0xf6, 0x35, 0x16, 0xaf, 0xc2, 0x9c, 0x45, 0x55, 0x52, 0xf2, 0x96, 0x8d, 0x28, 0xb3, 0xab, 0x07,
+  0x31, 0x7d, 0xea, 0xe0, 0x37, 0x34, 0x44, 0x2a, 0x77, 0xc9, 0x21, 0xb6, 0x9b, 0x34, 0x96, 0xcb,
+  0x66, 0xb0, 0x07, 0x9e, 0xb0, 0xcb, 0x2a, 0xc9, 0x27, 0xf0, 0xd7, 0x36, 0x4e, 0xb9, 0xf2, 0x31,
+  0xce, 0xea, 0x52, 0x77, 0x9b, 0x77, 0xb7, 0x43, 0x43, 0xbe, 0x57, 0x34, 0x0b, 0xe1, 0x54, 0xc9,
+  0x27, 0x8d, 0xdd, 0x4a, 0x4f, 0x69, 0x79, 0x55, 0x03, 0xdf, 0xee, 0x5d, 0x9a, 0x44, 0x04, 0xf9,
+  0x59, 0x15, 0x5e, 0x66, 0x45, 0x4c, 0x7b, 0x74, 0x74, 0x22, 0x46, 0x4f, 0x61, 0x70, 0x0d, 0xbb,
+  0xd1, 0x10, 0xe3, 0x70, 0x02, 0x67, 0xf5, 0x66, 0xe0, 0x0b, 0x6e, 0x09, 0x6b, 0x8d, 0xd6, 0xd8,
+  0x19, 0x9c, 0x7f, 0x49, 0xc4, 0x14, 0xfa, 0xa9, 0x7c, 0x6b, 0x0f, 0x19, 0xb8, 0xc2, 0x1e, 0xd6,
+  0xc2, 0xbd, 0x31, 0xa6, 0x22, 0xbf, 0x09, 0xa9, 0x0f, 0x01, 0x4d, 0x26, 0xc9, 0x00, 0x7c, 0x09,
+  0x6c, 0xc4, 0x73, 0x27, 0x85, 0x2c, 0xfa, 0x3d, 0x18, 0xe2, 0x49, 0x58, 0x42, 0x4c, 0xa0, 0xf1,
+  0x3b, 0x1c, 0xb3, 0x1b, 0xdc, 0x49, 0x98, 0xa6, 0x74, 0x43, 0x28, 0x50, 0x63, 0x75, 0x28, 0x50,
+  0xef, 0x9b, 0x23, 0x81, 0x42, 0x90, 0xae, 0xa8, 0x67, 0x2f, 0xd4, 0x43, 0x3b, 0x0c, 0x74, 0xd6,
+  0x6f, 0xf9, 0x69, 0xcf, 0x84, 0xc3, 0x38, 0xb9, 0xeb, 0x38, 0xea, 0x61, 0x89, 0xbe, 0x2a, 0x64,
+  0x6d, 0x3c, 0xf5, 0x70, 0x1f, 0x10, 0xb5, 0xbf, 0xb6, 0x16, 0xd0, 0x0e, 0x98, 0x64, 0xe0, 0x80,
+  0xa0, 0xe0, 0x7f, 0x4a, 0xb8, 0xd4, 0x07, 0x00, 0xbd, 0x59, 0x05, 0x39, 0xfa, 0x0b, 0x1e, 0x90,
+  0x21, 0xbe, 0xa1, 0x89, 0x82, 0x01, 0x65, 0xa5, 0x63, 0xba, 0xa1, 0xd4, 0x2c, 0x60, 0x3a, 0x5d,
+  0x0a, 0x9d, 0xe1, 0x26, 0x98, 0x9b, 0x3e, 0x0b, 0x59, 0xbe, 0x78, 0x30, 0x52, 0xaf, 0xba, 0x90,
+  0x02, 0xd1, 0xeb, 0x61, 0x15, 0xbf, 0xbb, 0x18, 0x7a, 0x5c, 0xc5, 0xd0, 0xab, 0x30, 0x86, 0x8c,
+  0x7b, 0xe3, 0x66, 0x88, 0xd9, 0x2f, 0x11, 0x47, 0xee, 0xc7, 0x8e, 0xc0, 0xd7, 0xb4, 0xc5, 0x8b,
+  0xc7, 0xe9, 0x37, 0xae, 0xca, 0xad, 0x86, 0xba, 0x1c, 0x12, 0xca, 0xfe, 0x00, 0xf6, 0x1f, 0x48,
+  0x4a, 0x7b, 0x02, 0xac, 0xe3, 0xb7, 0x00, 0x9d, 0x86, 0x65, 0xb0, 0x20, 0x09, 0x9c, 0x55, 0x64,
+  0xac, 0x90, 0xc4, 0x8b, 0x4b, 0x52, 0x51, 0xcf, 0x81, 0xef, 0xd6, 0x03, 0x0d, 0xc4, 0x25, 0x7c,
+  0x9a, 0xe4, 0x37, 0xe6, 0x60, 0x0d, 0x70, 0x09, 0x2b, 0x69, 0xd8, 0x1a, 0xab, 0x01, 0x2e, 0x11,
+  0xc1, 0xc2, 0x1c, 0xab, 0x01, 0x30, 0x6f, 0x56, 0xdd, 0xd1, 0x24, 0x4d, 0x43, 0xc8, 0xd2, 0x9a,
+  0xb9, 0x26, 0x70, 0x65, 0x0a, 0x26, 0x8e, 0x01, 0xd8, 0x43, 0x5b, 0x0b, 0xf2, 0x55, 0x8b, 0xef,
+  0xf1, 0xe2, 0x7d, 0x71, 0x4f, 0xab, 0x93, 0x10, 0x4a, 0x15, 0x07, 0x72, 0x13, 0x53, 0xb2, 0xb5,
+  0x7d, 0x6d, 0x07, 0x55, 0x54, 0xa7, 0x76, 0x16, 0x2a, 0xf7, 0x62, 0xf3, 0xfe, 0x70, 0x73, 0xaa,
+  0xda, 0x22, 0x35, 0x49, 0x6f, 0x12, 0x80, 0x90, 0x24, 0xc4, 0xe9, 0x24, 0xb3, 0xc1, 0x0d, 0xd5,
+  0x70, 0x6b, 0xdb, 0xf0, 0xd9, 0xd7, 0x03, 0x6d, 0xd9, 0x48, 0x08, 0xac, 0xde, 0x21, 0xd7, 0xc2,
+  0x1d, 0xfa, 0x66, 0x93, 0x2f, 0x61, 0xc2, 0x41, 0x83, 0x16, 0xb8, 0x87, 0x75, 0x57, 0xc0, 0xd9,
+  0x05, 0x05, 0x73, 0x39, 0xe3, 0x9e, 0xe7, 0x91, 0x1e, 0xaa, 0x10, 0x93, 0x8b, 0x3b, 0x6a, 0x10,
+  0xee, 0xea, 0x43, 0x86, 0x7a, 0xb1, 0x2f, 0x58, 0x1e, 0xb8, 0x10, 0x4f, 0x04, 0x2a, 0x3c, 0x7c,
+  0x56, 0xc1, 0x1d, 0xce, 0xf0, 0x3b, 0x5a, 0x7d, 0xae, 0xa3, 0xfb, 0x63, 0xf5, 0x25, 0x88, 0x9e,
+  0x14, 0xb3, 0x9c, 0x43, 0xd1, 0x8d, 0x0a, 0x53, 0xf9, 0x09, 0xa6, 0x5a, 0x2f, 0x79, 0xbe, 0x25,
+  0x3f, 0x41, 0x0c, 0xc1, 0x18, 0xa0, 0x6d, 0x54, 0xb4, 0x74, 0xb6, 0x56, 0x23, 0x03, 0x58, 0xc3,
+  0xa9, 0xfa, 0xb5, 0x17, 0xc5, 0xef, 0x01, 0x06, 0xd8, 0x00, 0xc1, 0x98, 0xb1, 0xa3, 0xc5, 0x5f,
+  0x2e, 0x77, 0x6a, 0x9d, 0xf4, 0x6f, 0x23, 0x81, 0x58, 0x26, 0x50, 0x2c, 0xa8, 0xac, 0x3a, 0xaa,
+  0x97, 0x5e, 0x28, 0x46, 0xf7, 0x92, 0x5c, 0xe9, 0x5e, 0xe4, 0x5a, 0x4a, 0x76, 0x47, 0x3f, 0xc0,
+  0xe9, 0x33, 0x87, 0x9a, 0x31, 0x4e, 0x58, 0x09, 0x05, 0x57, 0x40, 0x72, 0xa8, 0x85, 0x89, 0xaa,
+  0x38, 0x56, 0x8f, 0x99, 0x70, 0x95, 0x42, 0x01, 0x27, 0x68, 0xd7, 0x1b, 0xb6, 0x81, 0xdf, 0xe3,
+  0xf7, 0xc7, 0x9f, 0x4f, 0xb7, 0xda, 0x48, 0x9b, 0x5f, 0x67, 0xa3, 0x91, 0x0a, 0x3c, 0x75, 0xf4,
+  0x13, 0x5d, 0x40, 0xad, 0x1e, 0x4d, 0xd8, 0x5d, 0xa3, 0xf0, 0x80, 0x37, 0xf8, 0x90, 0xe8, 0x43,
+  0xf0, 0x64, 0xb4, 0xb6, 0xc1, 0xa0, 0x63, 0x93, 0x2f, 0x3a, 0xef, 0x7f, 0x3b, 0x18, 0x8d, 0x46,
+  0xe3, 0x91, 0x98, 0x88, 0xe1, 0xf8, 0x57, 0xe9, 0xfb, 0xb0, 0x99, 0xc1, 0x2b, 0xdc, 0xfd, 0xbc,
+  0xb8, 0xb7, 0x8d, 0x96, 0x93, 0xca, 0x25, 0xb4, 0xa9, 0xd6, 0x4d, 0x27, 0x40, 0x33, 0xf1, 0xb5,
+  0xdd, 0x43, 0xc5, 0x4b, 0xe3, 0x00, 0x60, 0x7b, 0x6d, 0xda, 0x7e, 0x9b, 0xc7, 0xd3, 0x90, 0x4f,
+  0xb1, 0x30, 0xb7, 0x47, 0x6e, 0x6b, 0x60, 0x4f, 0x51, 0x90, 0x09, 0xa7, 0xc1, 0x1a, 0x50, 0xc4,
+  0x8d, 0x6c, 0x21, 0x1f, 0xe2, 0xf9, 0xda, 0xbb, 0x9f, 0x28, 0xe0, 0x88, 0x6c, 0xdf, 0xa4, 0xf0,
+  0x0a, 0xea, 0xfd, 0x3d, 0x5e, 0x08, 0x5d, 0xa3, 0x07, 0x3e, 0xec, 0x1e, 0x6a, 0x37, 0xa5, 0xac,
+  0x10, 0xab, 0x67, 0x1c, 0xb2, 0x66, 0x21, 0xca, 0x75, 0x5a, 0x14, 0x55, 0x9b, 0xbb, 0xfd, 0x7f,
+  0x80, 0x9e, 0x47, 0x5a, 0x33, 0x0c, 0x7b, 0x16, 0x71, 0x0b, 0xbb, 0x8d, 0xfe, 0xa3, 0x44, 0xdf,
+  0x3f, 0x10, 0x93, 0xfa, 0xa4, 0x82, 0xec, 0x0c, 0xf0, 0x6c, 0xb5, 0xae, 0xe3, 0x95, 0x61, 0x0c,
+  0x41, 0xbe, 0xe2, 0xf6, 0x4f, 0x2e, 0x19, 0x11, 0x67, 0x08, 0x27, 0xc5, 0x50, 0xe1, 0xa8, 0xd5,
+  0xd6, 0x70, 0x56, 0x6b, 0xbb, 0xd9, 0xeb, 0xf2, 0xe0, 0xb5, 0xb5, 0x22, 0x3a, 0x33, 0x5c, 0xc1,
+  0x5f, 0x13, 0x29, 0x9b, 0x78, 0x04, 0x96, 0xc1, 0xa6, 0xc5, 0x3d, 0x70, 0x7b, 0x9d, 0xc0, 0x1b,
+  0x39, 0xc1, 0x83, 0x2a, 0x95, 0x71, 0xe0, 0x05, 0x71, 0x43, 0x36, 0xcf, 0x23, 0xcb, 0x6e, 0x77,
+  0xd3, 0x2a, 0xca, 0x4a, 0x78, 0xa0, 0x41, 0x78, 0x0f, 0xa1, 0xdb, 0xba, 0xa6, 0xd8, 0x2f, 0x22,
+  0xfb, 0x61, 0x99, 0xec, 0x8b, 0x79, 0xfb, 0x91, 0x20, 0x42, 0xdc, 0x05, 0xa4, 0x97, 0xd3, 0x22,
+  0x1e, 0x93, 0x4f, 0x1f, 0xcf, 0xce, 0x89, 0xac, 0xa5, 0xf5, 0x64, 0xaf, 0xb8, 0xa9, 0xeb, 0xbb,
+  0xef, 0x89, 0x9f, 0x8f, 0x0b, 0x3c, 0x0f, 0x75, 0xb3, 0x54, 0xe7, 0xce, 0x55, 0x72, 0xf7, 0x9c,
+  0xae, 0x75, 0x2e, 0xaf, 0x32, 0x7f, 0xc5, 0x32, 0xec, 0x2e, 0x58, 0x00, 0xad, 0xb6, 0x1c, 0xae,
+  0x7a, 0xa6, 0x8a, 0xf7, 0xf5, 0x14, 0x23, 0xe2, 0xef, 0x08, 0xa2, 0xcb, 0xe5, 0xc7, 0xab, 0xdf,
+  0x68, 0xc4, 0xbd, 0x1b, 0x3a, 0xd7, 0xeb, 0xb4, 0xab, 0x46, 0x3d, 0xf5, 0x51, 0xf9, 0xa8, 0x20,
+  0xd0, 0x4d, 0x47, 0xb5, 0x17, 0x60, 0xfc, 0x98, 0xf2, 0x2c, 0xc5, 0x04, 0x18, 0x0e, 0x5c, 0x5b,
+  0x88, 0xf3, 0x15, 0xa7, 0x60, 0x88, 0x77, 0xb1, 0x83, 0xc1, 0x2e, 0x8a, 0x6b, 0x4b, 0x71, 0x04,
+  0xd2, 0x54, 0x09, 0xd5, 0x4c, 0x39, 0x0b, 0x9c, 0x3a, 0x6c, 0xaf, 0x8d, 0x72, 0x8a, 0xdc, 0x0a,
+  0xd6, 0x9f, 0x3e, 0x3b, 0x22, 0x43, 0xca, 0xa2, 0xb0, 0xa4, 0x6f, 0x01, 0xd3, 0xd6, 0x74, 0xc1,
+  0xcc, 0x0f, 0xf7, 0x71, 0x50, 0x84, 0x75, 0x5c, 0x63, 0x77, 0xd7, 0x94, 0x59, 0x80, 0xb4, 0xcc,
+  0x47, 0xa3, 0xd6, 0x3a, 0x47, 0x26, 0xa3, 0x88, 0x28, 0x18, 0xbd, 0x9d, 0x41, 0xc1, 0x9d, 0xf0,
+  0x79, 0x0f, 0xaf, 0x92, 0x98, 0xde, 0xa9, 0x5b, 0x3e, 0x0f, 0x44, 0xb3, 0x16, 0x7c, 0xc3, 0xd6,
+  0xb3, 0x9c, 0xe5, 0x72, 0xe4, 0x6f, 0x92, 0x05, 0xe7, 0x83, 0x2c, 0xac, 0x0c, 0xf3, 0xb6, 0x34,
+  0x7a, 0x71, 0x21, 0x8d, 0x18, 0x16, 0x48, 0x7a, 0xf2, 0x2d, 0x6e, 0x81, 0x4d, 0x86, 0xf0, 0x3b,
+  0x24, 0x8e, 0xc6, 0x50, 0xd5, 0x80, 0x5e, 0xcc, 0x2c, 0x0e, 0x34, 0xac, 0xb4, 0x84, 0xe9, 0x06,
+  0x83, 0xa8, 0x48, 0x8b, 0x6a, 0xfc, 0xc3, 0xf3, 0xe7, 0xcf, 0xfd, 0xc1, 0xd1, 0x6b, 0xdc, 0x53,
+  0x59, 0xfa, 0x77, 0x26, 0xf7, 0x99, 0x03, 0xa2, 0xac, 0x67, 0xfc, 0x4d, 0x61, 0x88, 0x01, 0x83,
+  0x35, 0x89, 0xce, 0xb6, 0x9c, 0xbd, 0x9e, 0x54, 0x27, 0x2a, 0xda, 0x62, 0x69, 0xda, 0x0a, 0x6d,
+  0x82, 0xa6, 0x77, 0x97, 0x50, 0xc8, 0x55, 0x75, 0x9b, 0xe3, 0x45, 0x1b, 0x98, 0x85, 0xa5, 0x7d,
+  0x17, 0x1c, 0xdd, 0x79, 0x49, 0x09, 0x91, 0xce, 0x22, 0xc3, 0x3b, 0x8f, 0xc1, 0xd4, 0x21, 0xb1,
+  0xf0, 0xc7, 0x15, 0x80, 0xb8, 0x2a, 0xca, 0x92, 0xc6, 0x00, 0x53, 0x4f, 0x12, 0x7c, 0x73, 0x05,
+  0x90, 0x7f, 0xbf, 0x24, 0x8e, 0xf7, 0x5b, 0x91, 0xe4, 0x36, 0xb1, 0x96, 0x16, 0x86, 0x4b, 0x0b,
+  0x34, 0x2c, 0xd7, 0x80, 0x83, 0xe8, 0x4d, 0xc9, 0x00, 0x72, 0x5d, 0x32, 0x0b, 0x36, 0xc9, 0x81,
+  0x50, 0x4a, 0xba, 0x3a, 0xd0, 0xd5, 0x6e, 0xf6, 0x18, 0xd9, 0x55, 0x35, 0xbc, 0x26, 0xb7, 0x0a,
+  0x7b, 0xc5, 0x3d, 0x0b, 0x4c, 0xab, 0xcd, 0xb0, 0xf9, 0x31, 0xc1, 0xa0, 0xae, 0xba, 0x45, 0x37,
+  0xc1, 0x91, 0x86, 0x7d, 0xbd, 0xb9, 0xf8, 0x3a, 0xba, 0x00, 0x53, 0x16, 0x2a, 0x80, 0x81, 0x1b,
+  0x94, 0xbf, 0xfc, 0x79, 0x04, 0xb2, 0x99, 0x38, 0x07, 0x17, 0x20, 0x40, 0xc6, 0x5c, 0xab, 0x7c,
+  0xfe, 0x73, 0x67, 0xe8, 0x27, 0x39, 0x84, 0x02, 0xb7, 0xa9, 0x82, 0x75, 0x61, 0x92, 0x02, 0xec,
+  0x78, 0xe5, 0x8c, 0x41, 0xe8, 0x7d, 0x4b, 0xc3, 0x12, 0x26, 0x8b, 0x53, 0xaa, 0x82, 0x98, 0x1f,
+  0x03, 0x6b, 0x53, 0x80, 0xc1, 0xb1, 0xf4, 0xd3, 0xdf, 0x1d, 0xa1, 0x46, 0x0b, 0x4f, 0xa0, 0x3e,
+  0x9c, 0xd3, 0x24, 0x37, 0xd0, 0x1c, 0xd7, 0xfa, 0x74, 0xf6, 0xf9, 0xf8, 0xb4, 0x8b, 0x59, 0xb2,
+  0x2a, 0xcc, 0x0c, 0x3c, 0xd7, 0xfa, 0x92, 0xec, 0xbd, 0x49, 0x04, 0xc7, 0x15, 0x63, 0x09, 0x6e,
+  0xde, 0xcb, 0x4c, 0x24, 0x3e, 0x3d, 0xe9, 0x92, 0x08, 0x4f, 0x72, 0xb0, 0xb1, 0x58, 0xc1, 0x3f,
+  0x2a, 0xa7, 0x0a, 0x8e, 0xc0, 0x07, 0xc0, 0xd5, 0x2a, 0xf4, 0x2b, 0x78, 0xd0, 0x3b, 0xbe, 0x1e,
+  0x8d, 0x8d, 0xe6, 0x88, 0x68, 0x88, 0x3c, 0x3e, 0x1a, 0xcb, 0x36, 0xca, 0x89, 0x46, 0xdc, 0x12,
+  0x93, 0xd5, 0x95, 0x9a, 0x9c, 0xf0, 0x99, 0x5e, 0xc3, 0x81, 0x35, 0xdd, 0x94, 0x8e, 0x6f, 0xc5,
+  0xf5, 0xb7, 0x8d, 0xd6, 0x09, 0x3a, 0xca, 0x81, 0x5d, 0xc4, 0x14, 0x13, 0xc3, 0xe5, 0x52, 0xbf,
+  0xb6, 0xea, 0xc6, 0x4d, 0x27, 0x40, 0x92, 0x4d, 0xac, 0x24, 0x86, 0xb8, 0x21, 0x56, 0x78, 0x43,
+  0x69, 0x3c, 0xb0, 0x58, 0x15, 0x05, 0x83, 0x7d, 0xe9, 0xc5, 0x03, 0x38, 0xc7, 0x79, 0x30, 0x90,
+  0x5a, 0x1b, 0xe8, 0x28, 0x73, 0x9f, 0xc4, 0x7c, 0x3a, 0xb6, 0x20, 0x25, 0xf8, 0xd1, 0xb7, 0xae,
+  0x8a, 0x2a, 0xa6, 0xd5, 0x5e, 0x15, 0xc6, 0xc9, 0x8c, 0x8d, 0xad, 0x5f, 0xca, 0x6f, 0xbe, 0x95,
+  0x85, 0x15, 0xa4, 0xb1, 0x90, 0x64, 0x95, 0x88, 0x05, 0x10, 0x88, 0x86, 0x18, 0x24, 0x71, 0x29,
+  0x23, 0x3c, 0x0c, 0x74, 0xe0, 0x93, 0xb0, 0x3d, 0xe1, 0x95, 0x83, 0xfa, 0xc0, 0x69, 0x58, 0xde,
+  0x94, 0x04, 0xb3, 0xfb, 0x04, 0xce, 0xe6, 0xf3, 0xf0, 0x4a, 0x6f, 0x8f, 0x2e, 0x13, 0xfb, 0xa6,
+  0x76, 0xeb, 0x3e, 0xff, 0x09, 0x87, 0xa2, 0x54, 0x80, 0xa5, 0xf3, 0xf5, 0x56, 0x9b, 0xc6, 0xb8,
+  0x00, 0x69, 0xb7, 0xbc, 0x44, 0x97, 0x4b, 0x37, 0xb6, 0xb0, 0x5b, 0x82, 0x80, 0x1d, 0xdd, 0x02,
+  0xde, 0xdd, 0xd5, 0xaf, 0x46, 0xfb, 0xb7, 0x15, 0x2e, 0x9e, 0x72, 0xd9, 0x21, 0xf2, 0x00, 0xc3,
+  0x06, 0x7b, 0x5a, 0xcb, 0x46, 0xfe, 0x25, 0x8e, 0xb3, 0xd8, 0xbc, 0xcf, 0x34, 0xfb, 0x6f, 0x72,
+  0xd4, 0xe3, 0x45, 0x91, 0x5e, 0x46, 0x61, 0x9a, 0x32, 0x47, 0x27, 0xc0, 0x3a, 0x13, 0x5a, 0xa9,
+  0x5c, 0x58, 0x28, 0x28, 0x10, 0x77, 0x2c, 0xb7, 0x33, 0x5a, 0xcd, 0xcf, 0x20, 0x7f, 0x8d, 0xf0,
+  0x7a, 0x90, 0x78, 0xda, 0x63, 0x81, 0x9e, 0x78, 0x74, 0xc4, 0x7f, 0xbd, 0x09, 0x3a, 0x3d, 0xc6,
+  0x4e, 0x72, 0x2d, 0xa1, 0xbc, 0x14, 0x54, 0x42, 0xda, 0x04, 0xb4, 0x0b, 0xf3, 0x45, 0x37, 0xb9,
+  0x29, 0x20, 0x51, 0xea, 0x3d, 0x80, 0x89, 0x96, 0xfe, 0x1e, 0x19, 0xda, 0xad, 0xb6, 0xfa, 0x0b,
+  0xf9, 0x33, 0x26, 0x61, 0x52, 0xd7, 0xd6, 0x09, 0xfc, 0x04, 0x1d, 0xac, 0x3f, 0x7f, 0xff, 0xcf,
+  0x1f, 0x80, 0xf5, 0xe7, 0xef, 0x7f, 0xfc, 0x97, 0x88, 0x15, 0x4c, 0x03, 0x30, 0x4f, 0x64, 0x18,
+  0xdb, 0x43, 0x02, 0x03, 0x08, 0x2e, 0xf8, 0xdb, 0x7f, 0x6e, 0x23, 0x16, 0x1e, 0x6b, 0x83, 0xf6,
+  0x69, 0xaf, 0x75, 0x5a, 0x4f, 0xd2, 0x8d, 0xa7, 0xa8, 0x31, 0x12, 0xd6, 0xa3, 0xbd, 0xe3, 0x34,
+  0x05, 0x05, 0x6a, 0x49, 0x9b, 0x1b, 0x89, 0xce, 0x7d, 0xc0, 0x51, 0x70, 0x30, 0x72, 0x4c, 0x38,
+  0x04, 0xf6, 0x46, 0xbf, 0x82, 0x6c, 0x08, 0x87, 0x61, 0x0e, 0x36, 0x99, 0xa4, 0x31, 0xf6, 0xe7,
+  0x15, 0x94, 0x45, 0xa0, 0x8e, 0xf4, 0xbc, 0x28, 0x03, 0xe3, 0xf5, 0x2d, 0x4d, 0x26, 0x53, 0xde,
+  0xd8, 0xb2, 0x21, 0x87, 0xd9, 0x11, 0xca, 0x44, 0xbb, 0x6c, 0x17, 0x94, 0xb7, 0x1b, 0x66, 0xa5,
+  0x0f, 0x85, 0xeb, 0x21, 0x3e, 0xa7, 0x1c, 0x1f, 0x8f, 0xf0, 0x71, 0x22, 0x1e, 0x07, 0xf8, 0x78,
+  0x3b, 0x2b, 0xf0, 0x65, 0x40, 0x06, 0xf0, 0xf2, 0xc3, 0xe8, 0xd9, 0x73, 0x9f, 0xac, 0xea, 0xab,
+  0x43, 0xec, 0x09, 0x55, 0x14, 0x32, 0xed, 0x88, 0xda, 0xfb, 0x5f, 0x77, 0x0f, 0x8f, 0x06, 0xe4,
+  0x62, 0x7f, 0xe2, 0x66, 0x70, 0x02, 0x86, 0xe5, 0xd7, 0xec, 0xa2, 0x5b, 0x6c, 0xa0, 0x67, 0xad,
+  0xd5, 0x1a, 0x38, 0x20, 0xd4, 0xd9, 0xae, 0x34, 0xda, 0x65, 0x85, 0x98, 0x7e, 0x29, 0x2f, 0x21,
+  0xfd, 0x47, 0xf8, 0xd3, 0x63, 0xaf, 0x56, 0xd4, 0xb5, 0x8a, 0xc1, 0xe8, 0x86, 0x46, 0xf5, 0x77,
+  0xb5, 0x9e, 0x77, 0x74, 0xef, 0xb9, 0x15, 0x13, 0xb0, 0xf3, 0xbb, 0xc9, 0x61, 0x60, 0x0c, 0xa7,
+  0x66, 0x13, 0x0f, 0x43, 0x38, 0xd9, 0xc7, 0x52, 0xfa, 0x52, 0xb4, 0x73, 0xbd, 0xdf, 0xca, 0x89,
+  0xe8, 0x0a, 0x1b, 0x95, 0x3b, 0xe2, 0x61, 0x70, 0x27, 0x82, 0x49, 0x6d, 0x9a, 0xf4, 0x1b, 0xa8,
+  0x00, 0x2b, 0x75, 0xdd, 0x72, 0xee, 0xf8, 0xb5, 0x5c, 0xc3, 0xf4, 0xfe, 0x0d, 0x88, 0xad, 0x00,
+  0xa0, 0x88, 0x3a, 0xfa, 0xa1, 0x31, 0xd3, 0x4d, 0xe1, 0x41, 0x53, 0x35, 0x2d, 0x18, 0xd6, 0x6e,
+  0x85, 0xfc, 0x5a, 0x5d, 0xad, 0x08, 0xdc, 0xe9, 0x89, 0xc3, 0x7f, 0xfc, 0x0e, 0xe5, 0xff, 0xb8,
+  0x05, 0x8f, 0x17, 0x7b, 0x73, 0xdc, 0xc3, 0x42, 0xe0, 0x81, 0xc0, 0x87, 0x28, 0x66, 0xe4, 0x53,
+  0x0b, 0x8a, 0xe2, 0x82, 0xc8, 0xd1, 0xee, 0x49, 0x2e, 0x4e, 0xee, 0x76, 0xc1, 0xa1, 0xe5, 0x1f,
+  0x12, 0x75, 0x94, 0x0b, 0xbd, 0x40, 0xa0, 0xea, 0xd7, 0x30, 0x50, 0xed, 0xfa, 0x9d, 0xd2, 0x67,
+  0xbf, 0xeb, 0x29, 0x22, 0x0f, 0x7b, 0x5f, 0xa3, 0xd7, 0x87, 0x55, 0xff, 0x90, 0xff, 0xc9, 0xeb,
+  0x92, 0x75, 0xef, 0x13, 0x2b, 0x61, 0xb9, 0xcd, 0xfa, 0x99, 0xc5, 0xda, 0x8c, 0x3d, 0xcc, 0xaa,
+  0x40, 0xdb, 0xc6, 0xa8, 0x51, 0x97, 0x3f, 0xbe, 0x9c, 0x6e, 0xa5, 0x0c, 0x06, 0xd3, 0x3d, 0x1f,
+  0x85, 0x29, 0x5b, 0xbd, 0x9a, 0x71, 0x0e, 0x0f, 0x8d, 0x99, 0xf4, 0x1c, 0x12, 0x3c, 0xbc, 0xda,
+  0xbb, 0x12, 0x0d, 0x0d, 0x85, 0x5d, 0x5f, 0x11, 0x01, 0x14, 0xe4, 0x83, 0xff, 0x3d, 0xdf, 0xa7,
+  0x45, 0x69, 0x12, 0xdd, 0xa8, 0x8f, 0xd2, 0xe4, 0x5a, 0x40, 0x27, 0x40, 0x5c, 0x10, 0xf5, 0x98,
+  0x43, 0x09, 0x03, 0xd4, 0x20, 0x53, 0xc2, 0xfb, 0xa0, 0x3d, 0x18, 0x6a, 0x65, 0x5a, 0xf0, 0x8e,
+  0xd7, 0xba, 0x86, 0x08, 0xad, 0x31, 0x51, 0xde, 0xaa, 0xdb, 0xcd, 0xe6, 0x63, 0xbd, 0x40, 0x8d,
+  0xf8, 0x8f, 0x12, 0xa6, 0x23, 0x04, 0xf6, 0xff, 0xb6, 0xf0, 0x06, 0xe7, 0x7a, 0xbd, 0x2e, 0xe2,
+  0x6d, 0xbd, 0x3f, 0x68, 0x23, 0xac, 0x5f, 0x05, 0x38, 0x0f, 0x72, 0xa8, 0x4e, 0x75, 0x83, 0x4b,
+  0x05, 0x91, 0x9c, 0xaa, 0x17, 0x0f, 0x52, 0x5d, 0xfc, 0x90, 0x02, 0x26, 0x90, 0x61, 0xcd, 0x9e,
+  0x1e, 0xdc, 0xca, 0xe2, 0x3a, 0x52, 0x0f, 0x9b, 0x86, 0xf6, 0x8d, 0xaf, 0x7d, 0xea, 0xcf, 0x2c,
+  0xf4, 0x87, 0x4b, 0xbb, 0xbb, 0xf5, 0x07, 0x5f, 0xe2, 0x2a, 0x55, 0xdf, 0xd2, 0xd5, 0x5f, 0x39,
+  0x79, 0x1f, 0x3f, 0xbd, 0xfe, 0xd0, 0x7c, 0x1c, 0x85, 0xb5, 0x75, 0x6c, 0x8b, 0xbc, 0x90, 0x89,
+  0x96, 0x62, 0x72, 0x3d, 0x57, 0xdf, 0x63, 0xac, 0xfa, 0xae, 0x03, 0xcd, 0x4f, 0xc2, 0xea, 0x8f,
+  0xc6, 0x9c, 0xd6, 0xf7, 0x64, 0x35, 0xf8, 0x85, 0xf1, 0xa5, 0xdf, 0xb8, 0xf3, 0x95, 0x59, 0x97,
+  0x36, 0x7e, 0x00, 0xa9, 0x4d, 0xd3, 0xbc, 0x62, 0x7a, 0xd2, 0x4d, 0x54, 0x0b, 0xe4, 0xb4, 0xde,
+  0x7a, 0xef, 0x8f, 0xc4, 0x7d, 0x91, 0x5c, 0x54, 0x74, 0x21, 0x9f, 0x70, 0x8d, 0x03, 0xab, 0x09,
+  0x98, 0xb3, 0x10, 0x3f, 0xfd, 0xb7, 0x22, 0xc4, 0x97, 0x83, 0x9b, 0xef, 0x43, 0x56, 0x4d, 0x7e,
+  0xf8, 0x94, 0x4f, 0x55, 0x44, 0x16, 0xf8, 0xb4, 0xac, 0xc5, 0xff, 0x2b, 0xb7, 0xe1, 0x7d, 0x77,
+  0xdb, 0x0f, 0xc4, 0x69, 0xb5, 0x9e, 0x88, 0xad, 0x8f, 0xee, 0x78, 0x0a, 0x6c, 0x47, 0xfc, 0xff,
+  0xbe, 0x40, 0xab, 0xf3, 0x6d, 0x51, 0xbd, 0x3d, 0xb1, 0xb4, 0x97, 0x40, 0x47, 0xfe, 0x3c, 0xbc,
+  0xfc, 0xbb, 0x9e, 0xd2, 0xf0, 0xfb, 0xee, 0xb8, 0xe5, 0x15, 0xf7, 0x62, 0xfd, 0x72, 0x9b, 0xbc,
+  0xc3, 0xeb, 0xdb, 0xad, 0x57, 0xdb, 0x96, 0x71, 0xcf, 0xbb, 0x5a, 0x99, 0xfd, 0x7c, 0xf9, 0x81,
+  0xe3, 0x53, 0x23, 0x83, 0xc6, 0xaa, 0xef, 0xef, 0xb1, 0x5e, 0x3d, 0x6b, 0x77, 0x16, 0x7a, 0x3e,
+  0x37, 0x2c, 0xf1, 0x6a, 0x05, 0xbf, 0xfd, 0x71, 0x9f, 0xc9, 0xcb, 0x90, 0x26, 0x5a, 0x19, 0xc7,
+  0xb2, 0xb2, 0x48, 0xb7, 0xc8, 0x15, 0xc4, 0x95, 0x87, 0xd8, 0x39, 0xc8, 0x1c, 0x90, 0x4f, 0x55,
+  0x11, 0x51, 0x8c, 0x0d, 0x2a, 0xaa, 0x9a, 0x53, 0x1c, 0xa7, 0x9e, 0x63, 0x8b, 0xcf, 0x62, 0x70,
+  0xd9, 0xe2, 0xda, 0xca, 0x8a, 0x78, 0xa6, 0x4a, 0x6c, 0xfd, 0x51, 0x0c, 0xd4, 0xd9, 0x12, 0xea,
+  0xd1, 0x6f, 0x65, 0x51, 0x61, 0x0b, 0xb3, 0xfd, 0x1e, 0x2c, 0x8c, 0xaf, 0x1b, 0xdc, 0x76, 0x09,
+  0xef, 0xd6, 0x47, 0xdb, 0x6a, 0xf5, 0x3f, 0x46, 0x2b, 0xf3, 0x30, 0x87, 0x2e, 0x00, 0x00,
+};
+
+// index.html
+const uint8_t web_index_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x56, 0xcd, 0x72, 0xd3, 0x30,
+  0x10, 0xbe, 0xf7, 0x29, 0x84, 0x4e, 0x30, 0x83, 0x93, 0x26, 0x0c, 0xd3, 0xbf, 0xd8, 0x4c, 0x1b,
+  0x28, 0x74, 0xe8, 0x40, 0x67, 0x1a, 0x60, 0x38, 0x6e, 0xac, 0x6d, 0x22, 0x2a, 0x4b, 0x1e, 0x49,
+  0x49, 0x9b, 0x97, 0xe0, 0x15, 0xb8, 0xf0, 0x80, 0x3c, 0x02, 0x2b, 0xd9, 0x6e, 0x9d, 0x34, 0x29,
+  0x2d, 0x3d, 0x24, 0xb2, 0x77, 0xb5, 0x3f, 0x9f, 0xf6, 0xdb, 0xb5, 0x06, 0xcf, 0xde, 0x7e, 0x1e,
+  0x8e, 0xbe, 0x9f, 0xbd, 0x63, 0x53, 0x5f, 0xa8, 0x6c, 0x6b, 0x10, 0x16, 0xa6, 0x40, 0x4f, 0x52,
+  0x8e, 0x9a, 0x07, 0x01, 0x82, 0xa0, 0xa5, 0x40, 0x0f, 0x2c, 0x9f, 0x82, 0x75, 0xe8, 0x53, 0xfe,
+  0x65, 0x74, 0x9c, 0xec, 0xf2, 0x46, 0xac, 0xa1, 0xc0, 0x94, 0xcf, 0x25, 0x5e, 0x95, 0xc6, 0x7a,
+  0xce, 0x72, 0xa3, 0x3d, 0x6a, 0xda, 0x76, 0x25, 0x85, 0x9f, 0xa6, 0x02, 0xe7, 0x32, 0xc7, 0x24,
+  0xbe, 0xbc, 0x64, 0x52, 0x4b, 0x2f, 0x41, 0x25, 0x2e, 0x07, 0x85, 0x69, 0xaf, 0xb3, 0x1d, 0xdc,
+  0x78, 0xe9, 0x15, 0x66, 0x1f, 0xe5, 0xa5, 0x61, 0x09, 0x3b, 0x3c, 0x61, 0x87, 0xce, 0x49, 0xe7,
+  0x41, 0xfb, 0x41, 0xb7, 0x52, 0x6d, 0x0d, 0x94, 0xd4, 0x97, 0xcc, 0xa2, 0x4a, 0xb9, 0xf3, 0x0b,
+  0x85, 0x6e, 0x8a, 0x48, 0xa1, 0xa6, 0x16, 0x2f, 0x52, 0xde, 0x8d, 0xa2, 0x4e, 0xee, 0xdc, 0x9b,
+  0x79, 0xba, 0x97, 0x6f, 0x0b, 0xf1, 0x6a, 0xdc, 0x13, 0xfd, 0x5d, 0xb1, 0xbd, 0xb3, 0xfd, 0x2a,
+  0xf8, 0xef, 0xd6, 0x28, 0xc6, 0x46, 0x2c, 0x68, 0x11, 0x72, 0xce, 0x72, 0x05, 0xce, 0xa5, 0x3c,
+  0xe4, 0x0a, 0x52, 0xa3, 0xe5, 0xcb, 0xf2, 0x60, 0x50, 0x09, 0xa7, 0xbd, 0x6c, 0xe0, 0x4a, 0xd0,
+  0x8d, 0xa6, 0x90, 0x79, 0x22, 0xc9, 0x8c, 0x67, 0x7f, 0x7e, 0xfd, 0xfc, 0x3d, 0xe8, 0x06, 0x5d,
+  0xc6, 0x42, 0xee, 0x14, 0xa6, 0x47, 0x06, 0x65, 0x76, 0x5e, 0x80, 0xf5, 0xec, 0xab, 0x21, 0xd8,
+  0x6d, 0x28, 0x65, 0xc8, 0x84, 0x62, 0x2c, 0x47, 0xf2, 0x30, 0x76, 0x21, 0xce, 0x78, 0xe6, 0xbd,
+  0xd1, 0x2d, 0x69, 0x32, 0xf6, 0x9a, 0x41, 0xee, 0xe5, 0x1c, 0x39, 0x13, 0xe0, 0x21, 0x21, 0x61,
+  0x80, 0x0f, 0x7e, 0x46, 0x16, 0xe7, 0x71, 0x1d, 0x74, 0x2b, 0xbb, 0x4d, 0x0e, 0xda, 0x96, 0x54,
+  0x3e, 0xcf, 0xb3, 0x21, 0xfd, 0x3f, 0xc6, 0x6a, 0x02, 0x4a, 0xa1, 0x5d, 0xf0, 0xec, 0x7d, 0xf5,
+  0xf0, 0xa8, 0x88, 0xc4, 0x0c, 0x0b, 0x14, 0x33, 0xae, 0x8f, 0xb1, 0xf4, 0xe0, 0x2e, 0x09, 0xe4,
+  0x28, 0x2c, 0x2d, 0xbb, 0xb5, 0xc7, 0x97, 0xd4, 0x84, 0xbb, 0x39, 0x2c, 0x29, 0x2a, 0x79, 0x73,
+  0x54, 0xcb, 0x15, 0x07, 0x2b, 0x62, 0x5d, 0xfb, 0xd9, 0x70, 0x66, 0x6d, 0xb0, 0x0b, 0x47, 0x89,
+  0x54, 0xbd, 0x7e, 0xbd, 0x33, 0xd2, 0x89, 0x5c, 0xe0, 0xb5, 0x4f, 0x40, 0xc9, 0x89, 0xde, 0x67,
+  0x39, 0xed, 0x43, 0x7b, 0xb0, 0xe2, 0x2b, 0x04, 0xc0, 0x64, 0x0c, 0x62, 0x82, 0xac, 0x7a, 0x96,
+  0x42, 0xd5, 0x09, 0xc4, 0xf7, 0xa3, 0xa0, 0xe2, 0xd9, 0x09, 0x49, 0x9b, 0xdc, 0x97, 0x97, 0xf5,
+  0x89, 0x9d, 0x12, 0x0c, 0x36, 0xb2, 0xa0, 0x5d, 0x6e, 0x65, 0xe9, 0xa5, 0xd1, 0xad, 0xec, 0x22,
+  0xba, 0xb6, 0x8e, 0x67, 0xdf, 0x80, 0x9a, 0x4a, 0x4f, 0xd8, 0x85, 0xb1, 0x6c, 0x1e, 0x69, 0x27,
+  0x75, 0x39, 0xf3, 0x9d, 0x4e, 0xe7, 0x41, 0xe1, 0xce, 0xd0, 0x92, 0x65, 0x01, 0x3a, 0xc7, 0x95,
+  0x38, 0xd4, 0xdf, 0x56, 0xe6, 0x8e, 0x37, 0x46, 0x58, 0x94, 0x9e, 0xa8, 0x40, 0x1c, 0x6f, 0x87,
+  0xac, 0x77, 0xc5, 0x70, 0x65, 0xf6, 0x4f, 0xa0, 0xad, 0x92, 0xdd, 0xd6, 0xaa, 0x22, 0xe7, 0xc6,
+  0x4a, 0x19, 0x3d, 0x47, 0xeb, 0x20, 0xc0, 0x65, 0x1f, 0xa8, 0xa1, 0x4c, 0x20, 0xe2, 0x52, 0xaa,
+  0xc1, 0xc1, 0x29, 0x69, 0xd6, 0xe4, 0xfa, 0xc9, 0x50, 0x8a, 0xce, 0xc1, 0x04, 0x1d, 0x5b, 0xa0,
+  0x5f, 0xca, 0x72, 0x99, 0x89, 0xa1, 0xe5, 0xe8, 0x97, 0x08, 0x9a, 0x80, 0xd4, 0xfe, 0xcc, 0xe8,
+  0x5c, 0xc9, 0xfc, 0x92, 0xbc, 0x2b, 0x04, 0x1b, 0x5a, 0xe7, 0xf9, 0x0b, 0xa2, 0x73, 0x78, 0xb9,
+  0x4d, 0x63, 0x95, 0x9d, 0x0f, 0x44, 0x7c, 0xd3, 0x58, 0x1b, 0x41, 0x43, 0xe9, 0x67, 0x16, 0x05,
+  0x3b, 0x29, 0x42, 0xea, 0x2b, 0x78, 0x1b, 0xf3, 0xb5, 0x70, 0x65, 0xf1, 0x64, 0xb0, 0x75, 0xbb,
+  0xdf, 0xe2, 0xbd, 0xdb, 0xff, 0x8f, 0xac, 0x70, 0x3d, 0x0c, 0xee, 0x25, 0x7d, 0x35, 0x29, 0xd8,
+  0x31, 0xa2, 0x58, 0xad, 0x6f, 0xd4, 0x0c, 0x6f, 0xe6, 0xf5, 0x5d, 0xdc, 0xb5, 0xad, 0x36, 0xcd,
+  0x24, 0x78, 0x02, 0x1d, 0xeb, 0xf9, 0xb3, 0x29, 0xd7, 0xc3, 0xe8, 0x9f, 0x1d, 0x2a, 0xb0, 0xc5,
+  0x4a, 0x9e, 0x10, 0x64, 0x43, 0x33, 0xd3, 0x5e, 0x98, 0x2b, 0x7d, 0x93, 0x66, 0x14, 0x27, 0x52,
+  0xd7, 0x33, 0x2a, 0x14, 0x29, 0x8a, 0x18, 0x7d, 0x50, 0x1f, 0x56, 0x9e, 0x78, 0x08, 0xa1, 0x12,
+  0x31, 0xea, 0x51, 0x98, 0x97, 0xcb, 0x15, 0x8b, 0x72, 0xaa, 0x57, 0x33, 0xbf, 0xe8, 0x2b, 0x34,
+  0x91, 0x3a, 0xf1, 0xa6, 0xdc, 0x67, 0xbd, 0x7e, 0x79, 0x7d, 0xc0, 0x84, 0x74, 0xa5, 0x82, 0xc5,
+  0x3e, 0x9d, 0x91, 0xc6, 0x83, 0xa6, 0xb0, 0x35, 0x8a, 0x7b, 0x86, 0x6c, 0x0b, 0xf9, 0xc8, 0x24,
+  0x6f, 0x0d, 0x0b, 0x8d, 0xb6, 0x4a, 0x48, 0x6f, 0x84, 0x89, 0xf2, 0xf5, 0x94, 0x54, 0x41, 0xf5,
+  0xdf, 0x6c, 0x1c, 0x91, 0x73, 0x77, 0xcb, 0xc5, 0xf8, 0xba, 0x91, 0x89, 0xf5, 0x52, 0x0d, 0x48,
+  0xe6, 0x6c, 0x4e, 0x57, 0x04, 0x28, 0xcb, 0xce, 0x8f, 0x70, 0x3f, 0xc0, 0x8b, 0xfe, 0xce, 0xeb,
+  0xf1, 0xee, 0x78, 0x6f, 0x57, 0x88, 0xbd, 0x3d, 0xa0, 0xfb, 0x07, 0x7d, 0xc3, 0xe3, 0xce, 0x60,
+  0x59, 0xdf, 0x10, 0xba, 0xf1, 0x3a, 0xf4, 0x17, 0x61, 0xe0, 0x74, 0xf5, 0x1e, 0x09, 0x00, 0x00,
+};
+
+const WebAsset WEB_ASSETS[] = {
+  {"/style.css", "text/css", "\"9c0dd3b1d28d0703\"", "9c0dd3b1d28d0703", true, web_style_css_gz, 3019, 11723},
+  {"/app.js", "application/javascript", "\"ef275b8b98dd99a0\"", "ef275b8b98dd99a0", true, web_app_js_gz, 3663, 11911},
+  {"/index.html", "text/html", "\"2d14589022d67bf0\"", "2d14589022d67bf0", false, web_index_html_gz, 832, 2334},
+};
+const int WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
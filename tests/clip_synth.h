@@ -0,0 +1,102 @@
+/*
+  Synthesized voice clips for the host tests: voiced syllables, fricatives,
+  room and fan noise, a PDM DC offset and pad clicks, at the microphone's
+  8 kHz. The labels mark where the speech starts and ends.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <random>
+#include <vector>
+
+#define CLIP_SAMPLE_RATE 8000   // SAMPLE_RATE in Kiko.ino
+
+struct LabeledClip {
+  const char* name;
+  std::vector<int16_t> samples;
+  int speechStart = -1;            // -1: no speech in the clip
+  int speechEnd = -1;
+};
+
+class ClipSynth {
+ public:
+  explicit ClipSynth(uint32_t seed) : rng_(seed) {}
+
+  void silence(int ms) { speech_.resize(speech_.size() + ms * CLIP_SAMPLE_RATE / 1000, 0.0f); }
+
+  // A voiced syllable: harmonics of f0 with a rise/fall envelope and a slight glide
+  void syllable(int ms, float f0, float amp) {
+    mark();
+    int n = ms * CLIP_SAMPLE_RATE / 1000;
+    for (int i = 0; i < n; i++) {
+      float t = (float)i / CLIP_SAMPLE_RATE;
+      float env = sinf(PI * i / n);
+      float f = f0 * (1.0f + 0.1f * t);
+      float v = 0;
+      for (int h = 1; h <= 12 && h * f < CLIP_SAMPLE_RATE / 2; h++) {
+        float formant = (h * f > 300 && h * f < 900) ? 1.0f : 0.35f;
+        v += formant * sinf(TWO_PI * h * f * t + h) / h;
+      }
+      speech_.push_back(amp * env * v);
+    }
+    lastSpeech_ = speech_.size();
+  }
+
+  // Unvoiced consonant: differentiated white noise
+  void fricative(int ms, float amp) {
+    mark();
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    int n = ms * CLIP_SAMPLE_RATE / 1000;
+    float prev = 0;
+    for (int i = 0; i < n; i++) {
+      float w = g(rng_);
+      speech_.push_back(amp * sinf(PI * i / n) * (w - prev));
+      prev = w;
+    }
+    lastSpeech_ = speech_.size();
+  }
+
+  void word(float f0, float amp) {
+    std::uniform_int_distribution<int> len(140, 300), gap(60, 180);
+    int syllables = 1 + rng_() % 3;
+    for (int s = 0; s < syllables; s++) {
+      syllable(len(rng_), f0 * (0.9f + 0.2f * (rng_() % 100) / 100.0f), amp);
+      if (s + 1 < syllables) silence(gap(rng_) / 3);
+    }
+    silence(gap(rng_));
+  }
+
+  // Mixes the background in and returns the clip
+  LabeledClip finish(const char* name, float roomStd, float fanStd, int dc, int clicks) {
+    LabeledClip c;
+    c.name = name;
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    float fan = 0;
+    std::vector<float> mix(speech_);
+    for (size_t i = 0; i < mix.size(); i++) {
+      fan += 0.05f * (g(rng_) * fanStd * 4.5f - fan);   // One-pole low-pass: a fan's rumble
+      mix[i] += roomStd * g(rng_) + fan + dc;
+    }
+    for (int k = 0; k < clicks; k++) {                   // Finger taps on the pad: 5 ms knocks
+      size_t at = CLIP_SAMPLE_RATE / 4 + rng_() % (mix.size() - CLIP_SAMPLE_RATE / 2);
+      for (int i = 0; i < 40; i++) mix[at + i] += 9000.0f * expf(-i / 8.0f) * (i % 2 ? -1 : 1);
+    }
+    for (float v : mix) c.samples.push_back((int16_t)std::max(-32768.0f, std::min(32767.0f, v)));
+    if (firstSpeech_ >= 0) {
+      c.speechStart = firstSpeech_;
+      c.speechEnd = lastSpeech_;
+    }
+    return c;
+  }
+
+ private:
+  void mark() {
+    if (firstSpeech_ < 0) firstSpeech_ = speech_.size();
+  }
+
+  std::mt19937 rng_;
+  std::vector<float> speech_;
+  int firstSpeech_ = -1;
+  int lastSpeech_ = -1;
+};
@@ -0,0 +1,433 @@
+/*
+================================================================================
+  KIKO - Host build of the Arduino core (tests only)
+================================================================================
+  Just enough of the Arduino-ESP32 core for the engine headers, and the
+  sketch itself, to compile and run on a Linux host:
+
+  - String over std::string, Print, Stream, Client, Serial (stdout)
+  - millis()/micros() from the steady clock, delay() sleeps; a harness can
+    skip the waits with hostSkipDelays() while setup() runs
+  - configTime() sets the time zone, the clock itself is the host's
+  - ps_malloc() and the ESP heap queries, backed by heap accounting in
+    host_heap.h, so a test can read the high-water mark of a turn
+  - FreeRTOS tasks, queues and semaphores on std::thread (freertos_host.h);
+    one tick is one millisecond
+
+  Nothing here is used by the firmware build.
+================================================================================
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define FPSTR(p) ((const char*)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcpy_P strcpy
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+#ifndef TWO_PI
+#define TWO_PI 6.28318530717958647692
+#endif
+
+// ---------- Time ----------
+
+inline std::chrono::steady_clock::time_point hostBootTime() {
+  static const auto t0 = std::chrono::steady_clock::now();
+  return t0;
+}
+
+inline unsigned long millis() {
+  using namespace std::chrono;
+  return (unsigned long)duration_cast<milliseconds>(steady_clock::now() - hostBootTime()).count();
+}
+
+inline unsigned long micros() {
+  using namespace std::chrono;
+  return (unsigned long)duration_cast<microseconds>(steady_clock::now() - hostBootTime()).count();
+}
+
+// Set by a harness around setup(), whose splash screens and settle times only cost wall time
+inline std::atomic<bool>& hostSkipDelays() {
+  static std::atomic<bool> skip{false};
+  return skip;
+}
+
+inline void delay(unsigned long ms) {
+  if (hostSkipDelays()) ms = 0;
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+inline void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void yield() { std::this_thread::yield(); }
+
+// ---------- String ----------
+
+class String {
+ public:
+  String() {}
+  String(const char* c) : s_(c ? c : "") {}
+  String(const char* c, size_t n) : s_(c, n) {}
+  String(const std::string& x) : s_(x) {}
+  String(std::string&& x) : s_(std::move(x)) {}
+  explicit String(char c) : s_(1, c) {}
+  String(int v, int base = 10) : s_(toBase((long long)v, base)) {}
+  String(unsigned v, int base = 10) : s_(toBase((unsigned long long)v, base)) {}
+  String(long v, int base = 10) : s_(toBase((long long)v, base)) {}
+  String(unsigned long v, int base = 10) : s_(toBase((unsigned long long)v, base)) {}
+  String(long long v, int base = 10) : s_(toBase(v, base)) {}
+  String(unsigned long long v, int base = 10) : s_(toBase(v, base)) {}
+  String(float v, unsigned decimals = 2) : s_(fixed(v, decimals)) {}
+  String(double v, unsigned decimals = 2) : s_(fixed(v, decimals)) {}
+
+  unsigned length() const { return (unsigned)s_.size(); }
+  bool isEmpty() const { return s_.empty(); }
+  const char* c_str() const { return s_.c_str(); }
+  char* begin() { return &s_[0]; }
+  char* end() { return &s_[0] + s_.size(); }
+  const char* begin() const { return s_.data(); }
+  const char* end() const { return s_.data() + s_.size(); }
+  bool reserve(size_t n) { s_.reserve(n); return true; }
+  void clear() { s_.clear(); }
+  const std::string& str() const { return s_; }
+
+  bool concat(const String& o) { s_ += o.s_; return true; }
+  bool concat(const char* o) { if (o) s_ += o; return true; }
+  bool concat(const char* o, size_t n) { s_.append(o, n); return true; }
+  bool concat(char c) { s_ += c; return true; }
+  template <typename T> bool concat(T v) { s_ += String(v).s_; return true; }
+
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* o) { if (o) s_ += o; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  template <typename T> String& operator+=(T v) { s_ += String(v).s_; return *this; }
+
+  char operator[](size_t i) const { return i < s_.size() ? s_[i] : '\0'; }
+  char& operator[](size_t i) { return s_[i]; }
+  char charAt(size_t i) const { return (*this)[i]; }
+  void setCharAt(size_t i, char c) { if (i < s_.size()) s_[i] = c; }
+
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const { return s_ == (o ? o : ""); }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+  bool operator!=(const char* o) const { return !(*this == o); }
+  bool operator<(const String& o) const { return s_ < o.s_; }
+  bool operator>(const String& o) const { return s_ > o.s_; }
+  bool equals(const String& o) const { return s_ == o.s_; }
+  int compareTo(const String& o) const { return s_.compare(o.s_); }
+  bool equalsIgnoreCase(const String& o) const {
+    if (o.s_.size() != s_.size()) return false;
+    for (size_t i = 0; i < s_.size(); i++) {
+      if (tolower((unsigned char)s_[i]) != tolower((unsigned char)o.s_[i])) return false;
+    }
+    return true;
+  }
+
+  int indexOf(char c, unsigned from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const String& x, unsigned from = 0) const { return pos(s_.find(x.s_, from)); }
+  int indexOf(const char* x, unsigned from = 0) const { return pos(s_.find(x, from)); }
+  int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+  int lastIndexOf(const String& x) const { return pos(s_.rfind(x.s_)); }
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String& p) const {
+    return s_.size() >= p.s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+
+  String substring(unsigned from) const { return from >= s_.size() ? String() : String(s_.substr(from)); }
+  String substring(unsigned from, unsigned to) const {
+    if (to < from) std::swap(from, to);
+    if (from >= s_.size()) return String();
+    return String(s_.substr(from, std::min<size_t>(to, s_.size()) - from));
+  }
+
+  long toInt() const { return atol(s_.c_str()); }
+  float toFloat() const { return (float)atof(s_.c_str()); }
+  double toDouble() const { return atof(s_.c_str()); }
+
+  void trim() {
+    size_t a = 0, b = s_.size();
+    while (a < b && isspace((unsigned char)s_[a])) a++;
+    while (b > a && isspace((unsigned char)s_[b - 1])) b--;
+    s_ = s_.substr(a, b - a);
+  }
+  void toLowerCase() { for (auto& c : s_) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (auto& c : s_) c = (char)toupper((unsigned char)c); }
+  void replace(const String& from, const String& to) {
+    if (from.s_.empty()) return;
+    size_t p = 0;
+    while ((p = s_.find(from.s_, p)) != std::string::npos) {
+      s_.replace(p, from.s_.size(), to.s_);
+      p += to.s_.size();
+    }
+  }
+  void replace(char from, char to) { for (auto& c : s_) if (c == from) c = to; }
+  void remove(unsigned index) { if (index < s_.size()) s_.erase(index); }
+  void remove(unsigned index, unsigned count) { if (index < s_.size()) s_.erase(index, count); }
+  void toCharArray(char* buf, unsigned size) const {
+    if (!size) return;
+    size_t n = std::min<size_t>(size - 1, s_.size());
+    memcpy(buf, s_.data(), n);
+    buf[n] = '\0';
+  }
+  void getBytes(unsigned char* buf, unsigned size) const { toCharArray((char*)buf, size); }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + (b ? b : "")); }
+  friend String operator+(const char* a, const String& b) { return String(std::string(a ? a : "") + b.s_); }
+  friend String operator+(const String& a, char c) { return String(a.s_ + c); }
+  template <typename T> friend String operator+(const String& a, T v) { return String(a.s_ + String(v).s_); }
+
+ private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  static std::string toBase(unsigned long long v, int base) {
+    if (base == 10) return std::to_string(v);
+    std::string out;
+    do {
+      int d = (int)(v % base);
+      out.insert(out.begin(), (char)(d < 10 ? '0' + d : 'a' + d - 10));
+      v /= base;
+    } while (v);
+    return out;
+  }
+  static std::string toBase(long long v, int base) {
+    if (base == 10) return std::to_string(v);
+    return toBase((unsigned long long)v, base);
+  }
+  static std::string fixed(double v, unsigned decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    return buf;
+  }
+
+  std::string s_;
+};
+
+// ---------- Print / Stream ----------
+
+class Print;
+
+class Printable {
+ public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) {
+    size_t k = 0;
+    while (n--) k += write(*buf++);
+    return k;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t write(const char* s, size_t n) { return write((const uint8_t*)s, n); }
+  virtual void flush() {}
+
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(const Printable& x) { return x.printTo(*this); }
+  template <typename T, typename = typename std::enable_if<!std::is_base_of<Printable, T>::value>::type>
+  size_t print(T v) { return print(String(v)); }
+  size_t println() { return print("\n"); }
+  template <typename T> size_t println(const T& v) { return print(v) + print("\n"); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n < sizeof(buf)) return write((const uint8_t*)buf, n);
+    std::string big(n + 1, '\0');
+    va_start(args, fmt);
+    vsnprintf(&big[0], big.size(), fmt, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), n);
+  }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long ms) { timeout_ = ms; }
+
+  size_t readBytes(uint8_t* buf, size_t n) { return readBytes((char*)buf, n); }
+  virtual size_t readBytes(char* buf, size_t n) {
+    size_t got = 0;
+    unsigned long start = millis();
+    while (got < n && millis() - start < timeout_) {
+      int c = read();
+      if (c < 0) { delay(1); continue; }
+      buf[got++] = (char)c;
+    }
+    return got;
+  }
+  String readStringUntil(char end) {
+    std::string out;
+    unsigned long start = millis();
+    while (millis() - start < timeout_) {
+      int c = read();
+      if (c < 0) { delay(1); continue; }
+      if (c == end) break;
+      out += (char)c;
+    }
+    return String(std::move(out));
+  }
+  String readString() {
+    std::string out;
+    unsigned long start = millis();
+    while (millis() - start < timeout_) {
+      int c = read();
+      if (c < 0) { delay(1); continue; }
+      out += (char)c;
+      start = millis();
+    }
+    return String(std::move(out));
+  }
+
+ protected:
+  unsigned long timeout_ = 1000;
+};
+
+// Serial goes to stdout; KIKO_HOST_QUIET silences it so benchmarks print only their results
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override {
+    if (quiet()) return n;
+    return fwrite(buf, 1, n, stdout);
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  operator bool() const { return true; }
+
+ private:
+  static bool quiet() {
+    static const bool q = getenv("KIKO_HOST_QUIET") != nullptr;
+    return q;
+  }
+};
+inline HardwareSerial Serial;
+
+class IPAddress : public Printable {
+ public:
+  IPAddress(uint32_t addr = 0) : addr_(addr) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr_(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+  operator uint32_t() const { return addr_; }
+  uint8_t operator[](int i) const { return (addr_ >> (8 * (i & 3))) & 0xff; }
+  size_t printTo(Print& p) const override { return p.print(toString()); }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", addr_ & 0xff, (addr_ >> 8) & 0xff, (addr_ >> 16) & 0xff, addr_ >> 24);
+    return buf;
+  }
+
+ private:
+  uint32_t addr_;
+};
+
+class Client : public Stream {
+ public:
+  virtual int connect(const char* host, uint16_t port) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void stop() = 0;
+  virtual int read(uint8_t* buf, size_t n) {
+    size_t got = 0;
+    while (got < n) {
+      int c = read();
+      if (c < 0) break;
+      buf[got++] = (uint8_t)c;
+    }
+    return (int)got;
+  }
+  using Stream::read;
+  operator bool() { return connected(); }
+};
+
+// ---------- Misc core ----------
+
+inline long random(long maxValue) { return maxValue > 0 ? rand() % maxValue : 0; }
+inline long random(long minValue, long maxValue) { return maxValue > minValue ? minValue + rand() % (maxValue - minValue) : minValue; }
+inline void randomSeed(unsigned long seed) { srand((unsigned)seed); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+template <typename T, typename L, typename H>
+inline T constrain(T x, L lo, H hi) { return x < (T)lo ? (T)lo : x > (T)hi ? (T)hi : x; }
+
+// NTP is the host's clock; only the zone is taken, as a POSIX TZ such as "<+0530>-5:30"
+inline void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* = nullptr, const char* = nullptr,
+                       const char* = nullptr) {
+  long offset = gmtOffsetSec + daylightOffsetSec;
+  long a = labs(offset);
+  char tz[32];
+  snprintf(tz, sizeof(tz), "<%c%02ld%02ld>%c%ld:%02ld", offset < 0 ? '-' : '+', a / 3600, a / 60 % 60,
+           offset < 0 ? '+' : '-', a / 3600, a / 60 % 60);
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+inline bool getLocalTime(struct tm* info, uint32_t = 5000) {
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return true;
+}
+
+// Pin levels are kept so a test can look at the LED; touch readings are set by the test
+struct HostPins {
+  uint8_t level[64] = {};
+  uint32_t touch[64] = {};
+};
+inline HostPins& hostPins() {
+  static HostPins pins;
+  return pins;
+}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) { hostPins().level[pin & 63] = value; }
+inline int digitalRead(uint8_t pin) { return hostPins().level[pin & 63]; }
+inline void analogWrite(uint8_t pin, int value) { hostPins().level[pin & 63] = value > 0; }
+inline uint32_t touchRead(uint8_t pin) { return hostPins().touch[pin & 63]; }
+
+#include "host_heap.h"
+#include "freertos_host.h"
@@ -0,0 +1,42 @@
+/*
+  ArduinoOTA on the host (tests only): the callbacks are kept, no update ever arrives.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+#define U_FLASH 0
+#define U_SPIFFS 100
+
+typedef enum {
+  OTA_AUTH_ERROR,
+  OTA_BEGIN_ERROR,
+  OTA_CONNECT_ERROR,
+  OTA_RECEIVE_ERROR,
+  OTA_END_ERROR
+} ota_error_t;
+
+class ArduinoOTAClass {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+  typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+  typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+  ArduinoOTAClass& setHostname(const char*) { return *this; }
+  ArduinoOTAClass& setPassword(const char*) { return *this; }
+  ArduinoOTAClass& setPort(uint16_t) { return *this; }
+  ArduinoOTAClass& onStart(THandlerFunction fn) { start_ = fn; return *this; }
+  ArduinoOTAClass& onEnd(THandlerFunction fn) { end_ = fn; return *this; }
+  ArduinoOTAClass& onProgress(THandlerFunction_Progress fn) { progress_ = fn; return *this; }
+  ArduinoOTAClass& onError(THandlerFunction_Error fn) { error_ = fn; return *this; }
+  void begin() {}
+  void handle() {}
+  int getCommand() { return U_FLASH; }
+
+ private:
+  THandlerFunction start_, end_;
+  THandlerFunction_Progress progress_;
+  THandlerFunction_Error error_;
+};
+inline ArduinoOTAClass ArduinoOTA;
@@ -0,0 +1,151 @@
+/*
+  ESP32-audioI2S on the host (tests only): nothing is decoded or heard, but a
+  clip "plays" for as long as it would. connecttoFS() takes the length of a
+  WAV from its header and of an MP3 from its size at Google TTS's 32 kbit/s;
+  connecttospeech() fetches the clip from the TTS endpoint over WiFiClient, as
+  the library does, so it goes wherever the test routed translate.google.com.
+  hostPlaybackSpeed() shortens playback for long scripted runs.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "WiFiClientSecure.h"
+
+#define HOST_MP3_BYTES_PER_SEC 4000
+
+inline std::atomic<uint32_t>& hostPlaybackSpeed() {
+  static std::atomic<uint32_t> speed{1};
+  return speed;
+}
+
+struct HostAudioStats {
+  std::atomic<uint32_t> clips{0};          // Clips started
+  std::atomic<uint32_t> speechFetches{0};  // connecttospeech() downloads
+  std::atomic<uint64_t> speechBytes{0};
+  std::atomic<uint64_t> playedMs{0};
+};
+
+inline HostAudioStats& hostAudioStats() {
+  static HostAudioStats stats;
+  return stats;
+}
+
+class Audio {
+ public:
+  bool setPinout(uint8_t, uint8_t, uint8_t, int8_t = -1) { return true; }
+  void setVolume(uint8_t volume) { volume_ = volume; }
+  uint8_t getVolume() { return volume_; }
+
+  bool connecttoFS(fs::FS& fs, const char* path) {
+    stopSong();
+    File f = fs.open(path, FILE_READ);
+    if (!f) return false;
+    size_t size = f.size();
+    uint32_t ms = 0;
+    uint8_t h[44];
+    if (size >= sizeof(h) && f.read(h, sizeof(h)) == sizeof(h) && memcmp(h, "RIFF", 4) == 0) {
+      uint32_t byteRate = h[28] | (h[29] << 8) | (h[30] << 16) | ((uint32_t)h[31] << 24);
+      ms = byteRate ? (uint32_t)((uint64_t)(size - sizeof(h)) * 1000 / byteRate) : 0;
+    } else {
+      ms = (uint32_t)((uint64_t)size * 1000 / HOST_MP3_BYTES_PER_SEC);
+    }
+    f.close();
+    if (!ms) return false;
+    start(ms);
+    return true;
+  }
+
+  // GET https://translate.google.com/translate_tts?...; the clip plays once it is all in
+  bool connecttospeech(const char* text, const char* lang) {
+    stopSong();
+    WiFiClientSecure client;
+    if (!client.connect("translate.google.com", 443)) return false;
+    String req = String("GET /translate_tts?ie=UTF-8&tl=") + lang + "&client=tw-ob&q=" + urlEncode(text) +
+                 " HTTP/1.1\r\nHost: translate.google.com\r\nConnection: close\r\n\r\n";
+    client.write((const uint8_t*)req.c_str(), req.length());
+    size_t body = 0;
+    bool ok = readClip(client, body);
+    client.stop();
+    hostAudioStats().speechFetches++;
+    hostAudioStats().speechBytes += body;
+    if (!ok || !body) return false;
+    start((uint32_t)((uint64_t)body * 1000 / HOST_MP3_BYTES_PER_SEC));
+    return true;
+  }
+
+  bool connecttohost(const char*) { return false; }
+
+  bool isRunning() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return running_ && (long)(millis() - endsAt_) < 0;
+  }
+
+  void stopSong() {
+    std::lock_guard<std::mutex> guard(lock_);
+    running_ = false;
+  }
+
+  void loop() {}
+
+ private:
+  void start(uint32_t ms) {
+    uint32_t speed = std::max<uint32_t>(1, hostPlaybackSpeed());
+    std::lock_guard<std::mutex> guard(lock_);
+    running_ = true;
+    endsAt_ = millis() + ms / speed;
+    hostAudioStats().clips++;
+    hostAudioStats().playedMs += ms;
+  }
+
+  static String urlEncode(const char* s) {
+    static const char hex[] = "0123456789ABCDEF";
+    String out;
+    for (; *s; s++) {
+      uint8_t c = (uint8_t)*s;
+      if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+        out += (char)c;
+      } else {
+        out += '%';
+        out += hex[c >> 4];
+        out += hex[c & 15];
+      }
+    }
+    return out;
+  }
+
+  // Status line, headers, then a Content-Length or close-delimited body
+  static bool readClip(WiFiClient& c, size_t& body) {
+    std::string head;
+    unsigned long deadline = millis() + 10000;
+    while (head.find("\r\n\r\n") == std::string::npos) {
+      int ch = c.read();
+      if (ch < 0) {
+        if (!c.connected() || (long)(millis() - deadline) > 0) return false;
+        delay(1);
+        continue;
+      }
+      head += (char)ch;
+    }
+    if (head.compare(0, 12, "HTTP/1.1 200") != 0 && head.compare(0, 12, "HTTP/1.0 200") != 0) return false;
+    long length = -1;
+    size_t at = head.find("Content-Length:");
+    if (at != std::string::npos) length = atol(head.c_str() + at + 15);
+    uint8_t buf[1024];
+    while (length < 0 || (long)body < length) {
+      int n = c.read(buf, sizeof(buf));
+      if (n > 0) {
+        body += n;
+        continue;
+      }
+      if (!c.connected() || (long)(millis() - deadline) > 0) break;
+      delay(1);
+    }
+    return length < 0 || (long)body == length;
+  }
+
+  std::mutex lock_;
+  bool running_ = false;
+  unsigned long endsAt_ = 0;
+  uint8_t volume_ = 21;
+};
@@ -0,0 +1,84 @@
+/*
+  ESP_I2S on the host (tests only): the PDM microphone. readBytes() paces
+  itself at the configured sample rate, like the DMA does, and returns what a
+  test queued with hostMicPlay(), or a low noise floor when nothing is queued.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <deque>
+#include <mutex>
+
+#define I2S_HOST_DMA_MS 100
+
+typedef enum { I2S_MODE_STD, I2S_MODE_TDM, I2S_MODE_PDM_TX, I2S_MODE_PDM_RX } i2s_mode_t;
+typedef enum {
+  I2S_DATA_BIT_WIDTH_8BIT = 8,
+  I2S_DATA_BIT_WIDTH_16BIT = 16,
+  I2S_DATA_BIT_WIDTH_24BIT = 24,
+  I2S_DATA_BIT_WIDTH_32BIT = 32
+} i2s_data_bit_width_t;
+typedef enum { I2S_SLOT_MODE_MONO = 1, I2S_SLOT_MODE_STEREO = 2 } i2s_slot_mode_t;
+
+struct HostMic {
+  std::mutex lock;
+  std::deque<int16_t> queued;
+  uint32_t noiseSeed = 1;
+};
+
+inline HostMic& hostMic() {
+  static HostMic mic;
+  return mic;
+}
+
+// Queues samples for the microphone to "hear" next, in real time
+inline void hostMicPlay(const int16_t* samples, size_t count) {
+  HostMic& mic = hostMic();
+  std::lock_guard<std::mutex> guard(mic.lock);
+  mic.queued.insert(mic.queued.end(), samples, samples + count);
+}
+
+inline size_t hostMicQueued() {
+  HostMic& mic = hostMic();
+  std::lock_guard<std::mutex> guard(mic.lock);
+  return mic.queued.size();
+}
+
+class I2SClass {
+ public:
+  void setPinsPdmRx(int8_t, int8_t) {}
+
+  bool begin(i2s_mode_t, uint32_t rate, i2s_data_bit_width_t, i2s_slot_mode_t, int8_t = -1) {
+    rate_ = rate;
+    next_ = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  size_t readBytes(char* buf, size_t n) {
+    size_t samples = n / sizeof(int16_t);
+    // A reader that was away finds at most the DMA buffers' worth of audio waiting
+    auto oldest = std::chrono::steady_clock::now() - std::chrono::milliseconds(I2S_HOST_DMA_MS);
+    if (next_ < oldest) next_ = oldest;
+    next_ += std::chrono::microseconds((uint64_t)samples * 1000000 / rate_);
+    std::this_thread::sleep_until(next_);
+
+    int16_t* out = (int16_t*)buf;
+    HostMic& mic = hostMic();
+    std::lock_guard<std::mutex> guard(mic.lock);
+    for (size_t i = 0; i < samples; i++) {
+      if (!mic.queued.empty()) {
+        out[i] = mic.queued.front();
+        mic.queued.pop_front();
+      } else {
+        mic.noiseSeed = mic.noiseSeed * 1103515245 + 12345;
+        out[i] = (int16_t)((int)((mic.noiseSeed >> 16) % 61) - 30);
+      }
+    }
+    return samples * sizeof(int16_t);
+  }
+
+ private:
+  uint32_t rate_ = 16000;
+  std::chrono::steady_clock::time_point next_;
+};
@@ -0,0 +1,14 @@
+/*
+  mDNS on the host (tests only): nothing is announced.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+class MDNSResponder {
+ public:
+  bool begin(const char*) { return true; }
+  void end() {}
+  void addService(const char*, const char*, uint16_t) {}
+};
+inline MDNSResponder MDNS;
@@ -0,0 +1,263 @@
+/*
+  HTTPClient on the host (tests only): the arduino-esp32 client over a caller's
+  WiFiClient, with its error codes and keep-alive behaviour. sendRequest()
+  connects if the socket is not open, reads the status line and headers, and
+  leaves the body on the socket for writeToStream(), getString() or the
+  caller. end() keeps a reusable connection open and drains what is left of
+  the response, like the library does.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT 5000
+
+typedef enum {
+  HTTP_CODE_OK = 200,
+  HTTP_CODE_NO_CONTENT = 204,
+  HTTP_CODE_MOVED_PERMANENTLY = 301,
+  HTTP_CODE_FOUND = 302,
+  HTTP_CODE_NOT_MODIFIED = 304,
+  HTTP_CODE_BAD_REQUEST = 400,
+  HTTP_CODE_UNAUTHORIZED = 401,
+  HTTP_CODE_FORBIDDEN = 403,
+  HTTP_CODE_NOT_FOUND = 404,
+  HTTP_CODE_TOO_MANY_REQUESTS = 429,
+  HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+  HTTP_CODE_SERVICE_UNAVAILABLE = 503
+} t_http_codes;
+
+class HTTPClient {
+ public:
+  ~HTTPClient() { end(); }
+
+  bool begin(WiFiClient& client, const String& url) {
+    client_ = &client;
+    headers_.clear();
+    collected_.clear();
+    size_ = -1;
+    chunked_ = false;
+    canReuse_ = false;
+    String rest = url;
+    port_ = 80;
+    int scheme = rest.indexOf("://");
+    if (scheme >= 0) {
+      if (rest.substring(0, scheme) == "https") port_ = 443;
+      rest = rest.substring(scheme + 3);
+    }
+    int slash = rest.indexOf('/');
+    host_ = slash >= 0 ? rest.substring(0, slash) : rest;
+    uri_ = slash >= 0 ? rest.substring(slash) : String("/");
+    int colon = host_.indexOf(':');
+    if (colon >= 0) {
+      port_ = (uint16_t)host_.substring(colon + 1).toInt();
+      host_ = host_.substring(0, colon);
+    }
+    return true;
+  }
+
+  void setReuse(bool reuse) { reuse_ = reuse; }
+  void setTimeout(uint16_t ms) { timeout_ = ms; }
+  void setConnectTimeout(int32_t) {}
+  void addHeader(const String& name, const String& value) { headers_ += name + ": " + value + "\r\n"; }
+
+  void collectHeaders(const char* keys[], size_t count) {
+    collected_.clear();
+    for (size_t i = 0; i < count; i++) collected_.push_back({keys[i], String()});
+  }
+  String header(const char* name) {
+    for (const auto& h : collected_) {
+      if (h.first.equalsIgnoreCase(name)) return h.second;
+    }
+    return String();
+  }
+  bool hasHeader(const char* name) { return header(name).length() > 0; }
+
+  int GET() { return sendRequest("GET", String()); }
+  int POST(const String& body) { return sendRequest("POST", body); }
+
+  int sendRequest(const char* method, const String& payload) {
+    if (!client_) return HTTPC_ERROR_NOT_CONNECTED;
+    if (!client_->connected() && !client_->connect(host_.c_str(), port_)) return HTTPC_ERROR_CONNECTION_REFUSED;
+    String head = String(method) + " " + uri_ + " HTTP/1.1\r\nHost: " + host_ +
+                  "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: " + (reuse_ ? "keep-alive" : "close") + "\r\n";
+    if (payload.length() || strcmp(method, "POST") == 0) head += "Content-Length: " + String(payload.length()) + "\r\n";
+    head += headers_ + "\r\n";
+    if (client_->write((const uint8_t*)head.c_str(), head.length()) != head.length()) return HTTPC_ERROR_SEND_HEADER_FAILED;
+    if (payload.length() &&
+        client_->write((const uint8_t*)payload.c_str(), payload.length()) != payload.length()) {
+      return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+    return readHead();
+  }
+
+  int getSize() { return size_; }
+  WiFiClient& getStream() { return *client_; }
+  WiFiClient* getStreamPtr() { return client_; }
+
+  // Writes the body to stream; returns its length or an error
+  int writeToStream(Stream* stream) {
+    if (!stream) return HTTPC_ERROR_NO_STREAM;
+    if (!client_ || !client_->connected()) return HTTPC_ERROR_NOT_CONNECTED;
+    int total = 0;
+    if (!chunked_) {
+      int n = copy(stream, size_);
+      if (n < 0) return n;
+      return n;
+    }
+    for (;;) {
+      String line;
+      if (!readLine(line)) return HTTPC_ERROR_READ_TIMEOUT;
+      long len = strtol(line.c_str(), nullptr, 16);
+      if (len <= 0) {
+        readLine(line);   // Blank line after the last chunk
+        break;
+      }
+      int n = copy(stream, len);
+      if (n < 0) return n;
+      total += n;
+      readLine(line);   // CRLF after the chunk data
+    }
+    return total;
+  }
+
+  String getString() {
+    StringStream out;
+    if (writeToStream(&out) < 0) return String();
+    return String(std::move(out.text));
+  }
+
+  void end() {
+    if (!client_) return;
+    if (reuse_ && canReuse_ && client_->connected()) {
+      while (client_->available() > 0) client_->read();
+    } else {
+      client_->stop();
+    }
+    client_ = nullptr;
+  }
+
+  static String errorToString(int error) {
+    switch (error) {
+      case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+      case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+      case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+      case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+      case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+      case HTTPC_ERROR_NO_STREAM: return "no stream";
+      case HTTPC_ERROR_NO_HTTP_SERVER: return "no HTTP server";
+      case HTTPC_ERROR_TOO_LESS_RAM: return "too less ram";
+      case HTTPC_ERROR_ENCODING: return "Transfer-Encoding not supported";
+      case HTTPC_ERROR_STREAM_WRITE: return "Stream write error";
+      case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+      default: return String();
+    }
+  }
+
+ private:
+  struct StringStream : public Stream {
+    std::string text;
+    size_t write(uint8_t c) override {
+      text += (char)c;
+      return 1;
+    }
+    size_t write(const uint8_t* b, size_t n) override {
+      text.append((const char*)b, n);
+      return n;
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+  };
+
+  bool readLine(String& line) {
+    std::string out;
+    unsigned long deadline = millis() + timeout_;
+    while ((long)(deadline - millis()) > 0) {
+      int c = client_->read();
+      if (c < 0) {
+        if (!client_->connected()) return false;
+        delay(1);
+        continue;
+      }
+      if (c == '\n') {
+        if (!out.empty() && out.back() == '\r') out.pop_back();
+        line = String(std::move(out));
+        return true;
+      }
+      out += (char)c;
+    }
+    return false;
+  }
+
+  int readHead() {
+    String line;
+    if (!readLine(line)) return client_->connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST;
+    if (!line.startsWith("HTTP/1.")) return HTTPC_ERROR_NO_HTTP_SERVER;
+    int code = line.substring(9, 12).toInt();
+    bool close = false;
+    for (;;) {
+      if (!readLine(line)) return HTTPC_ERROR_CONNECTION_LOST;
+      if (line.length() == 0) break;
+      int colon = line.indexOf(':');
+      if (colon < 0) continue;
+      String name = line.substring(0, colon);
+      String value = line.substring(colon + 1);
+      value.trim();
+      if (name.equalsIgnoreCase("Content-Length")) size_ = value.toInt();
+      if (name.equalsIgnoreCase("Transfer-Encoding") && value.equalsIgnoreCase("chunked")) chunked_ = true;
+      if (name.equalsIgnoreCase("Connection") && value.equalsIgnoreCase("close")) close = true;
+      for (auto& h : collected_) {
+        if (h.first.equalsIgnoreCase(name)) h.second = value;
+      }
+    }
+    canReuse_ = !close;
+    return code;
+  }
+
+  // Copies len body bytes, or everything until the server closes when len is -1
+  int copy(Stream* stream, long len) {
+    uint8_t buf[1024];
+    int total = 0;
+    unsigned long deadline = millis() + timeout_;
+    while (len < 0 || total < len) {
+      size_t want = len < 0 ? sizeof(buf) : std::min<size_t>(sizeof(buf), len - total);
+      int n = client_->read(buf, want);
+      if (n <= 0) {
+        if (!client_->connected()) break;
+        if ((long)(deadline - millis()) <= 0) return HTTPC_ERROR_READ_TIMEOUT;
+        delay(1);
+        continue;
+      }
+      if (stream->write(buf, n) != (size_t)n) return HTTPC_ERROR_STREAM_WRITE;
+      total += n;
+      deadline = millis() + timeout_;
+    }
+    if (len >= 0 && total < len) return HTTPC_ERROR_CONNECTION_LOST;
+    return total;
+  }
+
+  WiFiClient* client_ = nullptr;
+  String host_, uri_, headers_;
+  uint16_t port_ = 80;
+  bool reuse_ = true;
+  bool canReuse_ = false;
+  bool chunked_ = false;
+  long size_ = -1;
+  uint16_t timeout_ = HTTPCLIENT_DEFAULT_TCP_TIMEOUT;
+  std::vector<std::pair<String, String>> collected_;
+};
@@ -0,0 +1,209 @@
+/*
+  SPIFFS on the host (tests only): a directory on the host file system. Paths
+  such as "/tts/1a2b.mp3" are files under the root, which is a fresh temporary
+  directory per process unless hostFsRoot() is set before begin(). Directories
+  are created on demand, as SPIFFS has none and any name may contain '/'.
+  Opening a directory lists the files below it through openNextFile().
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+#define HOST_FS_TOTAL_BYTES (1536 * 1024)   // The 4 MB flash layout's SPIFFS partition
+
+inline std::string& hostFsRoot() {
+  static std::string root;
+  return root;
+}
+
+namespace fs {
+
+class File : public Stream {
+ public:
+  File() {}
+
+  // A file, or the listing of a directory
+  File(const std::string& path, const std::string& full, const char* mode) {
+    struct stat st;
+    if (strcmp(mode, "r") == 0 && stat(full.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      auto impl = std::make_shared<Impl>();
+      impl->path = path;
+      list(full, path, impl->entries);
+      impl_ = impl;
+      return;
+    }
+    if (mode[0] != 'r') makeParents(full);
+    FILE* f = fopen(full.c_str(), mode[0] == 'w' ? "wb" : mode[0] == 'a' ? "ab" : "rb");
+    if (!f) return;
+    auto impl = std::make_shared<Impl>();
+    impl->f = f;
+    impl->path = path;
+    impl_ = impl;
+  }
+
+  explicit operator bool() const { return impl_ != nullptr; }
+  bool isDirectory() const { return impl_ && !impl_->f; }
+  const char* path() const { return impl_ ? impl_->path.c_str() : ""; }
+  const char* name() const {
+    const char* p = path();
+    const char* slash = strrchr(p, '/');
+    return slash ? slash + 1 : p;
+  }
+
+  size_t size() const {
+    if (!impl_ || !impl_->f) return 0;
+    long pos = ftell(impl_->f);
+    fseek(impl_->f, 0, SEEK_END);
+    long end = ftell(impl_->f);
+    fseek(impl_->f, pos, SEEK_SET);
+    return end < 0 ? 0 : (size_t)end;
+  }
+  size_t position() const { return impl_ && impl_->f ? (size_t)ftell(impl_->f) : 0; }
+  bool seek(uint32_t pos) { return impl_ && impl_->f && fseek(impl_->f, pos, SEEK_SET) == 0; }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override {
+    if (!impl_ || !impl_->f) return 0;
+    return fwrite(buf, 1, n, impl_->f);
+  }
+  using Print::write;
+  void flush() override {
+    if (impl_ && impl_->f) fflush(impl_->f);
+  }
+
+  int available() override {
+    if (!impl_ || !impl_->f) return 0;
+    return (int)(size() - position());
+  }
+  int read() override {
+    if (!impl_ || !impl_->f) return -1;
+    return fgetc(impl_->f);
+  }
+  int peek() override {
+    int c = read();
+    if (c >= 0) ungetc(c, impl_->f);
+    return c;
+  }
+  size_t read(uint8_t* buf, size_t n) {
+    if (!impl_ || !impl_->f) return 0;
+    return fread(buf, 1, n, impl_->f);
+  }
+  // No waiting: the end of a file is not going to move
+  size_t readBytes(char* buf, size_t n) override { return read((uint8_t*)buf, n); }
+  using Stream::readBytes;
+
+  void close() { impl_.reset(); }
+
+  File openNextFile() {
+    if (!impl_ || impl_->f || impl_->next >= impl_->entries.size()) return File();
+    const Entry& e = impl_->entries[impl_->next++];
+    return File(e.path, e.full, "r");
+  }
+
+ private:
+  struct Entry {
+    std::string path, full;
+  };
+  struct Impl {
+    FILE* f = nullptr;
+    std::string path;
+    std::vector<Entry> entries;
+    size_t next = 0;
+    ~Impl() {
+      if (f) fclose(f);
+    }
+  };
+
+  static void makeParents(const std::string& full) {
+    for (size_t i = 1; i < full.size(); i++) {
+      if (full[i] == '/') mkdir(full.substr(0, i).c_str(), 0755);
+    }
+  }
+
+  static void list(const std::string& full, const std::string& path, std::vector<Entry>& out) {
+    DIR* d = opendir(full.c_str());
+    if (!d) return;
+    while (dirent* e = readdir(d)) {
+      if (e->d_name[0] == '.') continue;
+      std::string base = path == "/" ? "" : path;
+      out.push_back({base + "/" + e->d_name, full + "/" + e->d_name});
+    }
+    closedir(d);
+  }
+
+  std::shared_ptr<Impl> impl_;
+};
+
+class FS {
+ public:
+  bool begin(bool = false) {
+    std::string& root = hostFsRoot();
+    if (root.empty()) {
+      char dir[] = "/tmp/kiko_spiffs_XXXXXX";
+      if (!mkdtemp(dir)) return false;
+      root = dir;
+    }
+    mkdir(root.c_str(), 0755);
+    mounted_ = true;
+    return true;
+  }
+
+  File open(const char* path, const char* mode = FILE_READ) {
+    if (!mounted_) return File();
+    return File(path, full(path), mode);
+  }
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+
+  bool exists(const char* path) {
+    struct stat st;
+    return mounted_ && stat(full(path).c_str(), &st) == 0;
+  }
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path) { return mounted_ && unlink(full(path).c_str()) == 0; }
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rename(const char* from, const char* to) {
+    return mounted_ && ::rename(full(from).c_str(), full(to).c_str()) == 0;
+  }
+  bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+  size_t totalBytes() { return mounted_ ? HOST_FS_TOTAL_BYTES : 0; }
+  size_t usedBytes() { return mounted_ ? used(hostFsRoot()) : 0; }
+
+ private:
+  std::string full(const char* path) const { return hostFsRoot() + (path[0] == '/' ? "" : "/") + path; }
+
+  static size_t used(const std::string& dir) {
+    size_t total = 0;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return 0;
+    while (dirent* e = readdir(d)) {
+      if (e->d_name[0] == '.') continue;
+      std::string p = dir + "/" + e->d_name;
+      struct stat st;
+      if (stat(p.c_str(), &st) != 0) continue;
+      total += S_ISDIR(st.st_mode) ? used(p) : (size_t)st.st_size;
+    }
+    closedir(d);
+    return total;
+  }
+
+  bool mounted_ = false;
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+
+class SPIFFSFS : public fs::FS {};
+inline SPIFFSFS SPIFFS;
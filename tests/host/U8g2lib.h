@@ -0,0 +1,123 @@
+/*
+  U8g2 on the host (tests only): the SH1106 128x64 full-buffer driver. The
+  buffer has the controller's layout (8 pages of 128 bytes, one byte per
+  8-pixel column), so sprite and renderer code can write into it directly.
+  Boxes, frames, discs and lines are drawn; text only advances by the font's
+  nominal width. Transfers take as long as they would on a 400 kHz I2C bus and
+  are counted in hostBytesSent().
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#define U8X8_PIN_NONE 255
+#define U8G2_HOST_I2C_HZ 400000
+
+struct u8g2_cb_t {
+  int rotation;
+};
+inline const u8g2_cb_t u8g2_cb_r0 = {0};
+#define U8G2_R0 (&u8g2_cb_r0)
+
+// Font: nominal glyph width, then height
+inline const uint8_t u8g2_font_6x10_tr[] = {6, 10};
+inline const uint8_t u8g2_font_ncenB10_tr[] = {9, 14};
+inline const uint8_t u8g2_font_logisoso24_tn[] = {14, 24};
+
+class U8G2 {
+ public:
+  static const int WIDTH = 128;
+  static const int HEIGHT = 64;
+
+  bool begin() { return true; }
+  void clearBuffer() { memset(buf_, 0, sizeof(buf_)); }
+  uint8_t* getBufferPtr() { return buf_; }
+  uint32_t hostBytesSent() const { return bytesSent_; }
+
+  void sendBuffer() { transfer(sizeof(buf_)); }
+  // Tile area: tw x th tiles of 8x8 pixels
+  void updateDisplayArea(unsigned tx, unsigned ty, unsigned tw, unsigned th) {
+    (void)tx;
+    (void)ty;
+    transfer(tw * th * 8);
+  }
+
+  void setFont(const uint8_t* font) { font_ = font; }
+  void setFontMode(uint8_t) {}
+  void setDrawColor(uint8_t color) { color_ = color; }
+
+  uint16_t getStrWidth(const char* s) const { return (uint16_t)(strlen(s) * font_[0]); }
+  uint16_t drawStr(int, int, const char* s) { return getStrWidth(s); }
+
+  void drawPixel(int x, int y) {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+    uint8_t& b = buf_[(y / 8) * WIDTH + x];
+    uint8_t bit = 1 << (y & 7);
+    if (color_ == 0) b &= ~bit;
+    else if (color_ == 2) b ^= bit;
+    else b |= bit;
+  }
+  void drawHLine(int x, int y, int w) {
+    for (int i = 0; i < w; i++) drawPixel(x + i, y);
+  }
+  void drawVLine(int x, int y, int h) {
+    for (int i = 0; i < h; i++) drawPixel(x, y + i);
+  }
+  void drawBox(int x, int y, int w, int h) {
+    for (int j = 0; j < h; j++) drawHLine(x, y + j, w);
+  }
+  void drawFrame(int x, int y, int w, int h) {
+    drawHLine(x, y, w);
+    drawHLine(x, y + h - 1, w);
+    drawVLine(x, y, h);
+    drawVLine(x + w - 1, y, h);
+  }
+  void drawRBox(int x, int y, int w, int h, int r) {
+    for (int j = 0; j < h; j++) {
+      int dy = j < r ? r - j : j >= h - r ? j - (h - r - 1) : 0;
+      int inset = dy ? r - (int)sqrtf((float)(r * r - dy * dy)) : 0;
+      drawHLine(x + inset, y + j, w - 2 * inset);
+    }
+  }
+  void drawDisc(int x0, int y0, int r) {
+    for (int dy = -r; dy <= r; dy++) {
+      int dx = (int)sqrtf((float)(r * r - dy * dy));
+      drawHLine(x0 - dx, y0 + dy, 2 * dx + 1);
+    }
+  }
+  void drawLine(int x0, int y0, int x1, int y1) {
+    int dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+      drawPixel(x0, y0);
+      if (x0 == x1 && y0 == y1) break;
+      int e2 = 2 * err;
+      if (e2 >= dy) {
+        err += dy;
+        x0 += sx;
+      }
+      if (e2 <= dx) {
+        err += dx;
+        y0 += sy;
+      }
+    }
+  }
+
+ private:
+  void transfer(uint32_t bytes) {
+    bytesSent_ += bytes;
+    delayMicroseconds((unsigned)((uint64_t)bytes * 9 * 1000000 / U8G2_HOST_I2C_HZ));
+  }
+
+  uint8_t buf_[WIDTH * HEIGHT / 8] = {};
+  const uint8_t* font_ = u8g2_font_6x10_tr;
+  uint8_t color_ = 1;
+  uint32_t bytesSent_ = 0;
+};
+
+class U8G2_SH1106_128X64_NONAME_F_HW_I2C : public U8G2 {
+ public:
+  explicit U8G2_SH1106_128X64_NONAME_F_HW_I2C(const u8g2_cb_t*, uint8_t = U8X8_PIN_NONE, uint8_t = U8X8_PIN_NONE,
+                                              uint8_t = U8X8_PIN_NONE) {}
+};
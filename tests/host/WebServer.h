@@ -0,0 +1,279 @@
+/*
+  WebServer on the host (tests only): the arduino-esp32 server on a loopback
+  socket. begin() listens on an ephemeral port (hostPort()), since port 80 is
+  not ours to take; handleClient() serves at most one request per call, on
+  the calling task, and closes the connection after the response, unless a
+  handler kept a copy of client() (the MJPEG stream does).
+*/
+#pragma once
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+#include <functional>
+#include <vector>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+#define HTTP_MAX_DATA_WAIT 5000
+
+typedef enum { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS } HTTPMethod;
+
+class WebServer {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int = 80) {}
+  ~WebServer() {
+    if (listenFd_ >= 0) close(listenFd_);
+  }
+
+  void begin() {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listenFd_, (sockaddr*)&addr, sizeof(addr));
+    listen(listenFd_, 16);
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd_, (sockaddr*)&addr, &len);
+    port_ = ntohs(addr.sin_port);
+    fcntl(listenFd_, F_SETFL, O_NONBLOCK);
+  }
+  uint16_t hostPort() const { return port_; }
+
+  void on(const String& uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+  void on(const String& uri, HTTPMethod method, THandlerFunction fn) { routes_.push_back({uri, method, fn}); }
+  void onNotFound(THandlerFunction fn) { notFound_ = fn; }
+  void collectHeaders(const char* keys[], size_t count) {
+    collected_.clear();
+    for (size_t i = 0; i < count; i++) collected_.push_back({keys[i], String()});
+  }
+
+  void handleClient() {
+    if (listenFd_ < 0) return;
+    int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0) return;
+    client_ = WiFiClient(fd);
+    if (readRequest()) dispatch();
+    client_.stop();
+  }
+
+  // Request
+  String uri() const { return uri_; }
+  HTTPMethod method() const { return method_; }
+  String arg(const String& name) const {
+    for (const auto& a : args_) {
+      if (a.first == name) return a.second;
+    }
+    return String();
+  }
+  bool hasArg(const String& name) const {
+    for (const auto& a : args_) {
+      if (a.first == name) return true;
+    }
+    return false;
+  }
+  String header(const String& name) const {
+    for (const auto& h : collected_) {
+      if (h.first.equalsIgnoreCase(name)) return h.second;
+    }
+    return String();
+  }
+  WiFiClient& client() { return client_; }
+
+  // Response
+  void sendHeader(const String& name, const String& value, bool first = false) {
+    String line = name + ": " + value + "\r\n";
+    extraHeaders_ = first ? line + extraHeaders_ : extraHeaders_ + line;
+  }
+  void setContentLength(size_t len) { contentLength_ = len; }
+
+  void send(int code, const char* type = nullptr, const String& content = String()) {
+    sendHead(code, type, content.length());
+    if (content.length()) sendContent(content);
+  }
+  void send(int code, const String& type, const String& content) { send(code, type.c_str(), content); }
+  void send(int code, const char* type, const char* content) { send(code, type, String(content)); }
+  void send_P(int code, const char* type, const char* content, size_t len) {
+    sendHead(code, type, len);
+    sendContent(content, len);
+  }
+
+  void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void sendContent(const char* content, size_t len) {
+    if (chunked_) {
+      char size[16];
+      snprintf(size, sizeof(size), "%zx\r\n", len);
+      client_.print(size);
+      if (len) client_.write((const uint8_t*)content, len);
+      client_.print("\r\n");
+      if (!len) chunked_ = false;   // sendContent("") ends the response
+      return;
+    }
+    client_.write((const uint8_t*)content, len);
+  }
+
+  template <typename T>
+  size_t streamFile(T& file, const String& type, int code = 200) {
+    sendHead(code, type.c_str(), file.size());
+    uint8_t buf[1024];
+    size_t total = 0, n;
+    while ((n = file.read(buf, sizeof(buf))) > 0) total += client_.write(buf, n);
+    return total;
+  }
+
+ private:
+  struct Route {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction fn;
+  };
+
+  bool readLine(String& line, unsigned long deadline) {
+    std::string out;
+    while ((long)(deadline - millis()) > 0) {
+      int c = client_.read();
+      if (c < 0) {
+        if (!client_.connected()) return false;
+        delay(1);
+        continue;
+      }
+      if (c == '\n') {
+        if (!out.empty() && out.back() == '\r') out.pop_back();
+        line = String(std::move(out));
+        return true;
+      }
+      out += (char)c;
+    }
+    return false;
+  }
+
+  static String decode(const String& s) {
+    String out;
+    for (size_t i = 0; i < s.length(); i++) {
+      if (s[i] == '+') {
+        out += ' ';
+      } else if (s[i] == '%' && i + 2 < s.length()) {
+        out += (char)strtol(s.substring(i + 1, i + 3).c_str(), nullptr, 16);
+        i += 2;
+      } else {
+        out += s[i];
+      }
+    }
+    return out;
+  }
+
+  void parseArgs(const String& query) {
+    size_t start = 0;
+    while (start < query.length()) {
+      int amp = query.indexOf('&', start);
+      String pair = query.substring(start, amp < 0 ? query.length() : amp);
+      int eq = pair.indexOf('=');
+      if (pair.length()) args_.push_back({decode(eq < 0 ? pair : pair.substring(0, eq)), eq < 0 ? String() : decode(pair.substring(eq + 1))});
+      if (amp < 0) break;
+      start = amp + 1;
+    }
+  }
+
+  bool readRequest() {
+    unsigned long deadline = millis() + HTTP_MAX_DATA_WAIT;
+    args_.clear();
+    for (auto& h : collected_) h.second = String();
+    extraHeaders_ = String();
+    contentLength_ = CONTENT_LENGTH_NOT_SET;
+    chunked_ = false;
+
+    String line;
+    if (!readLine(line, deadline)) return false;
+    int sp1 = line.indexOf(' '), sp2 = line.indexOf(' ', sp1 + 1);
+    if (sp1 < 0 || sp2 < 0) return false;
+    String m = line.substring(0, sp1);
+    method_ = m == "POST" ? HTTP_POST : m == "PUT" ? HTTP_PUT : m == "DELETE" ? HTTP_DELETE : m == "HEAD" ? HTTP_HEAD : HTTP_GET;
+    String target = line.substring(sp1 + 1, sp2);
+    int q = target.indexOf('?');
+    uri_ = q < 0 ? target : target.substring(0, q);
+    if (q >= 0) parseArgs(target.substring(q + 1));
+
+    long bodyLength = 0;
+    String contentType;
+    for (;;) {
+      if (!readLine(line, deadline)) return false;
+      if (line.length() == 0) break;
+      int colon = line.indexOf(':');
+      if (colon < 0) continue;
+      String name = line.substring(0, colon);
+      String value = line.substring(colon + 1);
+      value.trim();
+      if (name.equalsIgnoreCase("Content-Length")) bodyLength = value.toInt();
+      if (name.equalsIgnoreCase("Content-Type")) contentType = value;
+      for (auto& h : collected_) {
+        if (h.first.equalsIgnoreCase(name)) h.second = value;
+      }
+    }
+    std::string body;
+    while ((long)body.size() < bodyLength && (long)(deadline - millis()) > 0) {
+      int c = client_.read();
+      if (c < 0) {
+        if (!client_.connected()) break;
+        delay(1);
+        continue;
+      }
+      body += (char)c;
+    }
+    if (bodyLength) {
+      if (contentType.startsWith("application/x-www-form-urlencoded")) parseArgs(String(body));
+      else args_.push_back({"plain", String(body)});
+    }
+    return true;
+  }
+
+  void dispatch() {
+    for (const Route& r : routes_) {
+      if (r.uri == uri_ && (r.method == HTTP_ANY || r.method == method_)) {
+        r.fn();
+        return;
+      }
+    }
+    if (notFound_) notFound_();
+    else send(404, "text/plain", "Not found");
+  }
+
+  void sendHead(int code, const char* type, size_t len) {
+    if (contentLength_ != CONTENT_LENGTH_NOT_SET) len = contentLength_;
+    chunked_ = len == CONTENT_LENGTH_UNKNOWN;
+    String head = "HTTP/1.1 " + String(code) + " " + reason(code) + "\r\n";
+    if (type && *type) head += "Content-Type: " + String(type) + "\r\n";
+    head += chunked_ ? String("Transfer-Encoding: chunked\r\n") : "Content-Length: " + String((unsigned long)len) + "\r\n";
+    head += extraHeaders_ + "Connection: close\r\n\r\n";
+    client_.print(head);
+    extraHeaders_ = String();
+  }
+
+  static const char* reason(int code) {
+    switch (code) {
+      case 200: return "OK";
+      case 304: return "Not Modified";
+      case 403: return "Forbidden";
+      case 404: return "Not Found";
+      case 500: return "Internal Server Error";
+      case 503: return "Service Unavailable";
+      default: return "";
+    }
+  }
+
+  int listenFd_ = -1;
+  uint16_t port_ = 0;
+  std::vector<Route> routes_;
+  THandlerFunction notFound_;
+  std::vector<std::pair<String, String>> collected_;
+  std::vector<std::pair<String, String>> args_;
+  WiFiClient client_;
+  String uri_;
+  HTTPMethod method_ = HTTP_GET;
+  String extraHeaders_;
+  size_t contentLength_ = CONTENT_LENGTH_NOT_SET;
+  bool chunked_ = false;
+};
@@ -0,0 +1,123 @@
+/*
+  WebSocketsServer on the host (tests only): dashboard clients live in the
+  process. A test connects, sends text and disconnects them with the host*
+  calls; loop() delivers those events to the sketch's handler on the task
+  that calls it, as the library does. What the sketch sends is kept per
+  client, with the bytes it would take on the wire (payload plus the
+  unmasked server frame header).
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+#define HOST_WS_KEEP_MESSAGES 256
+
+typedef enum {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN,
+  WStype_PING,
+  WStype_PONG
+} WStype_t;
+
+struct HostWsClient {
+  bool connected = false;
+  uint32_t ip = 0;
+  uint32_t messages = 0;
+  uint64_t payloadBytes = 0;
+  uint64_t wireBytes = 0;
+  std::deque<std::string> received;   // Last HOST_WS_KEEP_MESSAGES sent by the sketch
+};
+
+class WebSocketsServer {
+ public:
+  typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+
+  explicit WebSocketsServer(uint16_t, const String& = "", const String& = "arduino") {}
+
+  void begin() {}
+  void onEvent(WebSocketServerEvent fn) { event_ = fn; }
+
+  void loop() {
+    for (;;) {
+      Pending p;
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (pending_.empty()) return;
+        p = std::move(pending_.front());
+        pending_.pop_front();
+      }
+      if (event_) event_(p.num, p.type, (uint8_t*)&p.text[0], p.text.size());
+    }
+  }
+
+  bool sendTXT(uint8_t num, const char* payload, size_t length = 0) {
+    if (!length) length = strlen(payload);
+    std::lock_guard<std::mutex> guard(lock_);
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !clients_[num].connected) return false;
+    HostWsClient& c = clients_[num];
+    c.messages++;
+    c.payloadBytes += length;
+    c.wireBytes += length + (length < 126 ? 2 : length < 65536 ? 4 : 10);
+    c.received.emplace_back(payload, length);
+    if (c.received.size() > HOST_WS_KEEP_MESSAGES) c.received.pop_front();
+    return true;
+  }
+  bool sendTXT(uint8_t num, const String& payload) { return sendTXT(num, payload.c_str(), payload.length()); }
+  void broadcastTXT(const String& payload) {
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) sendTXT(i, payload);
+  }
+
+  IPAddress remoteIP(uint8_t num) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return num < WEBSOCKETS_SERVER_CLIENT_MAX ? IPAddress(clients_[num].ip) : IPAddress();
+  }
+
+  // Test side. Returns the client number, or -1 when every slot is taken.
+  int hostConnect(IPAddress ip) {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+      if (clients_[i].connected) continue;
+      clients_[i] = HostWsClient();
+      clients_[i].connected = true;
+      clients_[i].ip = ip;
+      pending_.push_back({i, WStype_CONNECTED, std::string()});
+      return i;
+    }
+    return -1;
+  }
+  void hostSend(uint8_t num, const String& text) {
+    std::lock_guard<std::mutex> guard(lock_);
+    pending_.push_back({num, WStype_TEXT, std::string(text.c_str(), text.length())});
+  }
+  void hostDisconnect(uint8_t num) {
+    std::lock_guard<std::mutex> guard(lock_);
+    clients_[num].connected = false;
+    pending_.push_back({num, WStype_DISCONNECTED, std::string()});
+  }
+  // Copy of what a client has received so far
+  HostWsClient hostClient(uint8_t num) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return clients_[num];
+  }
+
+ private:
+  struct Pending {
+    uint8_t num;
+    WStype_t type;
+    std::string text;
+  };
+
+  std::mutex lock_;
+  WebSocketServerEvent event_;
+  HostWsClient clients_[WEBSOCKETS_SERVER_CLIENT_MAX];
+  std::deque<Pending> pending_;
+};
@@ -0,0 +1,37 @@
+/*
+  WiFi on the host (tests only): always connected, as the loopback interface.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+class WiFiClass {
+ public:
+  bool mode(wifi_mode_t) { return true; }
+  bool setAutoReconnect(bool) { return true; }
+  void persistent(bool) {}
+  wl_status_t begin(const char* ssid, const char* = nullptr) {
+    ssid_ = ssid ? ssid : "";
+    return WL_CONNECTED;
+  }
+  bool disconnect(bool = false) { return true; }
+  wl_status_t status() { return WL_CONNECTED; }
+  String SSID() { return ssid_; }
+  IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+  int8_t RSSI() { return -50; }
+
+ private:
+  String ssid_;
+};
+inline WiFiClass WiFi;
@@ -0,0 +1,185 @@
+/*
+  WiFiClient on the host (tests only): a blocking TCP socket, so a test can point
+  the sketch's HTTP code at a local stand-in server. connect() takes a host name
+  or dotted address; reads never block (available() polls the socket).
+
+  Copies share the socket, as on the ESP32: stop() drops this copy's reference
+  and the socket closes with the last one.
+
+  hostRoute() sends connections for a host and port to a local server instead,
+  so the sketch can keep its production host names. Once any route is set,
+  connections to hosts without one are refused, which keeps a test run from
+  reaching real services.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+struct HostRoute {
+  std::string host;
+  uint16_t port;
+};
+
+struct HostRoutes {
+  std::mutex lock;
+  std::map<std::string, HostRoute> routes;   // "host:port" -> where to connect instead
+};
+
+inline HostRoutes& hostRoutes() {
+  static HostRoutes r;
+  return r;
+}
+
+inline void hostRoute(const char* host, uint16_t port, const char* toHost, uint16_t toPort) {
+  HostRoutes& r = hostRoutes();
+  std::lock_guard<std::mutex> guard(r.lock);
+  r.routes[std::string(host) + ":" + std::to_string(port)] = {toHost, toPort};
+}
+
+// Where a connection to host:port goes; false if routes are set and none matches
+inline bool hostResolveRoute(const char* host, uint16_t port, std::string& toHost, uint16_t& toPort) {
+  HostRoutes& r = hostRoutes();
+  std::lock_guard<std::mutex> guard(r.lock);
+  toHost = host;
+  toPort = port;
+  if (r.routes.empty()) return true;
+  auto it = r.routes.find(std::string(host) + ":" + std::to_string(port));
+  if (it == r.routes.end()) return false;
+  toHost = it->second.host;
+  toPort = it->second.port;
+  return true;
+}
+
+class WiFiClient : public Client {
+ public:
+  WiFiClient() {}
+  // Wraps an accepted connection (WebServer)
+  explicit WiFiClient(int fd) {
+    if (fd >= 0) adopt(fd);
+  }
+  ~WiFiClient() override {}
+
+  int connect(const char* host, uint16_t port) override {
+    stop();
+    std::string toHost;
+    uint16_t toPort;
+    if (!hostResolveRoute(host, port, toHost, toPort)) return 0;
+    addrinfo hints = {}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(toHost.c_str(), String(toPort).c_str(), &hints, &res) != 0 || !res) return 0;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    bool ok = fd >= 0 && ::connect(fd, res->ai_addr, res->ai_addrlen) == 0;
+    freeaddrinfo(res);
+    if (!ok) {
+      if (fd >= 0) close(fd);
+      return 0;
+    }
+    adopt(fd);
+    return 1;
+  }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override {
+    if (!s_) return 0;
+    size_t sent = 0;
+    while (sent < n) {
+      ssize_t k = send(s_->fd, buf + sent, n - sent, MSG_NOSIGNAL);
+      if (k <= 0) {
+        s_->peerClosed = true;
+        break;
+      }
+      sent += k;
+    }
+    return sent;
+  }
+  using Print::write;
+
+  int available() override {
+    if (!s_) return 0;
+    s_->fill(0);
+    return (int)(s_->have - s_->pos);
+  }
+
+  int read() override {
+    if (!available()) return -1;
+    return s_->buf[s_->pos++];
+  }
+
+  int read(uint8_t* out, size_t n) override {
+    size_t got = 0;
+    while (got < n && available()) {
+      size_t k = std::min(n - got, s_->have - s_->pos);
+      memcpy(out + got, s_->buf + s_->pos, k);
+      s_->pos += k;
+      got += k;
+    }
+    return (int)got;
+  }
+
+  int peek() override { return available() ? s_->buf[s_->pos] : -1; }
+
+  uint8_t connected() override {
+    if (!s_) return 0;
+    s_->fill(0);
+    return s_->pos < s_->have || !s_->peerClosed;
+  }
+
+  void stop() override { s_.reset(); }
+
+  void setNoDelay(bool) {}
+
+  IPAddress remoteIP() const {
+    if (!s_) return IPAddress();
+    sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    if (getpeername(s_->fd, (sockaddr*)&addr, &len) != 0) return IPAddress();
+    return IPAddress(addr.sin_addr.s_addr);
+  }
+
+ private:
+  struct Socket {
+    int fd;
+    bool peerClosed = false;
+    uint8_t buf[1460];
+    size_t have = 0, pos = 0;
+
+    explicit Socket(int f) : fd(f) {}
+    ~Socket() { close(fd); }
+
+    // Refills the receive buffer once it is used up; waits at most waitMs for data
+    void fill(int waitMs) {
+      if (pos < have || peerClosed) return;
+      pollfd p = {fd, POLLIN, 0};
+      if (poll(&p, 1, waitMs) <= 0) return;
+      ssize_t k = recv(fd, buf, sizeof(buf), 0);
+      if (k <= 0) {
+        peerClosed = true;
+        return;
+      }
+      have = k;
+      pos = 0;
+    }
+  };
+
+  void adopt(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    s_ = std::make_shared<Socket>(fd);
+  }
+
+  std::shared_ptr<Socket> s_;
+};
@@ -0,0 +1,14 @@
+/*
+  WiFiClientSecure on the host (tests only): plain TCP. The stand-in servers the
+  host tests talk to do not speak TLS; the certificate calls are accepted and ignored.
+*/
+#pragma once
+
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  void setInsecure() {}
+  void setCACert(const char*) {}
+  void setHandshakeTimeout(unsigned long) {}
+};
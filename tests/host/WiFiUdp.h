@@ -0,0 +1,12 @@
+/*
+  UDP on the host (tests only): only declared, the sketch sends no datagrams itself.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+class WiFiUDP {
+ public:
+  uint8_t begin(uint16_t) { return 1; }
+  void stop() {}
+};
@@ -0,0 +1,13 @@
+/*
+  I2C on the host (tests only): the OLED driver in U8g2lib.h models the bus itself.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+ public:
+  bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+  void setClock(uint32_t) {}
+};
+inline TwoWire Wire;
@@ -0,0 +1,127 @@
+/*
+  esp_camera on the host (tests only): a camera that always initializes and
+  hands out a JPEG-framed buffer of a typical QVGA size. A test can replace
+  the frame with hostCameraSetFrame(), e.g. with a real capture.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <mutex>
+#include <vector>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum { LEDC_CHANNEL_0, LEDC_CHANNEL_1 } ledc_channel_t;
+typedef enum { LEDC_TIMER_0, LEDC_TIMER_1 } ledc_timer_t;
+typedef enum { PIXFORMAT_RGB565, PIXFORMAT_YUV422, PIXFORMAT_GRAYSCALE, PIXFORMAT_JPEG } pixformat_t;
+typedef enum { FRAMESIZE_96X96, FRAMESIZE_QQVGA, FRAMESIZE_QCIF, FRAMESIZE_HQVGA, FRAMESIZE_240X240, FRAMESIZE_QVGA, FRAMESIZE_VGA } framesize_t;
+typedef enum { CAMERA_FB_IN_PSRAM, CAMERA_FB_IN_DRAM } camera_fb_location_t;
+typedef enum { CAMERA_GRAB_WHEN_EMPTY, CAMERA_GRAB_LATEST } camera_grab_mode_t;
+
+typedef struct {
+  int pin_pwdn, pin_reset, pin_xclk;
+  int pin_sccb_sda, pin_sccb_scl;
+  int pin_d7, pin_d6, pin_d5, pin_d4, pin_d3, pin_d2, pin_d1, pin_d0;
+  int pin_vsync, pin_href, pin_pclk;
+  int xclk_freq_hz;
+  ledc_timer_t ledc_timer;
+  ledc_channel_t ledc_channel;
+  pixformat_t pixel_format;
+  framesize_t frame_size;
+  int jpeg_quality;
+  size_t fb_count;
+  camera_fb_location_t fb_location;
+  camera_grab_mode_t grab_mode;
+} camera_config_t;
+
+typedef struct {
+  uint8_t* buf;
+  size_t len;
+  size_t width;
+  size_t height;
+  pixformat_t format;
+} camera_fb_t;
+
+typedef struct _sensor sensor_t;
+struct _sensor {
+  int (*set_vflip)(sensor_t*, int);
+  int (*set_hmirror)(sensor_t*, int);
+  int (*set_exposure_ctrl)(sensor_t*, int);
+  int (*set_aec2)(sensor_t*, int);
+  int (*set_gain_ctrl)(sensor_t*, int);
+  int (*set_agc_gain)(sensor_t*, int);
+  int (*set_brightness)(sensor_t*, int);
+  int (*set_quality)(sensor_t*, int);
+};
+
+#define HOST_CAMERA_FRAME_BYTES 9000   // QVGA at quality 12-15
+#define HOST_CAMERA_FRAME_MS 40        // Sensor readout of one frame at 25 fps
+
+struct HostCamera {
+  std::mutex lock;
+  std::vector<uint8_t> frame;
+  uint32_t captures = 0;
+};
+
+inline HostCamera& hostCamera() {
+  static HostCamera camera;
+  return camera;
+}
+
+inline void hostCameraSetFrame(const uint8_t* data, size_t len) {
+  HostCamera& c = hostCamera();
+  std::lock_guard<std::mutex> guard(c.lock);
+  c.frame.assign(data, data + len);
+}
+
+inline int hostSensorSet(sensor_t*, int) { return 0; }
+
+inline esp_err_t esp_camera_init(const camera_config_t*) {
+  HostCamera& c = hostCamera();
+  std::lock_guard<std::mutex> guard(c.lock);
+  if (c.frame.empty()) {
+    // SOI, a JFIF APP0, filler entropy data, EOI
+    c.frame.resize(HOST_CAMERA_FRAME_BYTES);
+    static const uint8_t head[] = {0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00};
+    memcpy(c.frame.data(), head, sizeof(head));
+    uint32_t x = 7;
+    for (size_t i = sizeof(head); i < c.frame.size() - 2; i++) {
+      x = x * 1664525 + 1013904223;
+      c.frame[i] = (uint8_t)(x >> 24) == 0xff ? 0xfe : (uint8_t)(x >> 24);
+    }
+    c.frame[c.frame.size() - 2] = 0xff;
+    c.frame[c.frame.size() - 1] = 0xd9;
+  }
+  return ESP_OK;
+}
+
+inline sensor_t* esp_camera_sensor_get() {
+  static sensor_t s = {hostSensorSet, hostSensorSet, hostSensorSet, hostSensorSet,
+                       hostSensorSet, hostSensorSet, hostSensorSet, hostSensorSet};
+  return &s;
+}
+
+inline camera_fb_t* esp_camera_fb_get() {
+  delay(HOST_CAMERA_FRAME_MS);
+  HostCamera& c = hostCamera();
+  std::lock_guard<std::mutex> guard(c.lock);
+  if (c.frame.empty()) return nullptr;
+  camera_fb_t* fb = new camera_fb_t();
+  fb->buf = (uint8_t*)malloc(c.frame.size());
+  memcpy(fb->buf, c.frame.data(), c.frame.size());
+  fb->len = c.frame.size();
+  fb->width = 320;
+  fb->height = 240;
+  fb->format = PIXFORMAT_JPEG;
+  c.captures++;
+  return fb;
+}
+
+inline void esp_camera_fb_return(camera_fb_t* fb) {
+  if (!fb) return;
+  free(fb->buf);
+  delete fb;
+}
@@ -0,0 +1,297 @@
+/*
+  FreeRTOS on the host (tests only): tasks are detached std::threads,
+  semaphores and queues are a mutex and a condition variable. One tick is one
+  millisecond. vTaskDelete(NULL) ends the calling task by unwinding it;
+  deleting another task is not supported (the sketch never does).
+  uxTaskGetStackHighWaterMark() returns the stack the task was created with.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define errQUEUE_FULL 0
+#define portMAX_DELAY ((TickType_t)0xffffffffu)
+#define portTICK_PERIOD_MS 1
+#define portTICK_RATE_MS portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY 0x7fffffff
+
+namespace host_rtos {
+
+// Waits on cv until ready() or the ticks run out; portMAX_DELAY waits for good
+template <typename Lock, typename Ready>
+bool waitFor(std::condition_variable& cv, Lock& lock, TickType_t ticks, Ready ready) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, ready);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+struct TaskExit {};
+
+}  // namespace host_rtos
+
+// ---------- Tasks ----------
+
+struct HostTask {
+  std::string name;
+  uint32_t stackDepth = 0;
+  std::mutex lock;
+  std::condition_variable cv;
+  uint32_t notifications = 0;
+};
+typedef HostTask* TaskHandle_t;
+
+inline std::mutex& hostTaskRegistryLock() {
+  static std::mutex m;
+  return m;
+}
+inline std::map<std::string, HostTask*>& hostTaskRegistry() {
+  static std::map<std::string, HostTask*> tasks;
+  return tasks;
+}
+inline HostTask*& hostCurrentTask() {
+  thread_local HostTask* current = nullptr;
+  return current;
+}
+
+// The thread that runs setup() and loop() is the Arduino "loopTask"
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+  HostTask*& current = hostCurrentTask();
+  if (!current) {
+    std::lock_guard<std::mutex> guard(hostTaskRegistryLock());
+    auto& tasks = hostTaskRegistry();
+    auto it = tasks.find("loopTask");
+    if (it == tasks.end()) {
+      current = new HostTask();
+      current->name = "loopTask";
+      current->stackDepth = 8192;
+      tasks["loopTask"] = current;
+    } else {
+      current = it->second;
+    }
+  }
+  return current;
+}
+
+inline TaskHandle_t xTaskGetHandle(const char* name) {
+  std::lock_guard<std::mutex> guard(hostTaskRegistryLock());
+  auto it = hostTaskRegistry().find(name);
+  return it == hostTaskRegistry().end() ? nullptr : it->second;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* param,
+                                          UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  HostTask* task = new HostTask();
+  task->name = name ? name : "";
+  task->stackDepth = stackDepth;
+  {
+    std::lock_guard<std::mutex> guard(hostTaskRegistryLock());
+    hostTaskRegistry()[task->name] = task;
+  }
+  if (handle) *handle = task;
+  std::thread([fn, param, task]() {
+    hostCurrentTask() = task;
+    try {
+      fn(param);
+    } catch (host_rtos::TaskExit&) {
+    }
+  }).detach();
+  return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* param,
+                              UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+inline void vTaskDelete(TaskHandle_t task) {
+  if (task == nullptr || task == hostCurrentTask()) throw host_rtos::TaskExit();
+}
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+
+inline TickType_t xTaskGetTickCount() {
+  using namespace std::chrono;
+  static const auto t0 = steady_clock::now();
+  return (TickType_t)duration_cast<milliseconds>(steady_clock::now() - t0).count();
+}
+
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return task ? task->stackDepth : xTaskGetCurrentTaskHandle()->stackDepth;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  std::lock_guard<std::mutex> guard(task->lock);
+  task->notifications++;
+  task->cv.notify_all();
+  return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(task->lock);
+  host_rtos::waitFor(task->cv, lock, ticks, [&] { return task->notifications > 0; });
+  uint32_t value = task->notifications;
+  if (value) task->notifications = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+// ---------- Semaphores ----------
+
+struct HostSemaphore {
+  std::mutex lock;
+  std::condition_variable cv;
+  int count = 0;
+  int maxCount = 1;
+  std::thread::id owner;      // Recursive mutexes only
+  int depth = 0;
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore(); }
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  HostSemaphore* s = new HostSemaphore();
+  s->count = 1;
+  return s;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initial) {
+  HostSemaphore* s = new HostSemaphore();
+  s->maxCount = maxCount;
+  s->count = initial;
+  return s;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return xSemaphoreCreateMutex(); }
+
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(s->lock);
+  if (!host_rtos::waitFor(s->cv, lock, ticks, [&] { return s->count > 0; })) return pdFALSE;
+  s->count--;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> guard(s->lock);
+  if (s->count >= s->maxCount) return pdFALSE;
+  s->count++;
+  s->cv.notify_one();
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(s->lock);
+  std::thread::id self = std::this_thread::get_id();
+  if (s->depth > 0 && s->owner == self) {
+    s->depth++;
+    return pdTRUE;
+  }
+  if (!host_rtos::waitFor(s->cv, lock, ticks, [&] { return s->depth == 0; })) return pdFALSE;
+  s->owner = self;
+  s->depth = 1;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> guard(s->lock);
+  if (s->depth == 0 || s->owner != std::this_thread::get_id()) return pdFALSE;
+  if (--s->depth == 0) s->cv.notify_one();
+  return pdTRUE;
+}
+
+// ---------- Queues ----------
+
+struct HostQueue {
+  std::mutex lock;
+  std::condition_variable cv;
+  std::deque<std::vector<uint8_t>> items;
+  size_t capacity = 0;
+  size_t itemSize = 0;
+};
+typedef HostQueue* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue* q = new HostQueue();
+  q->capacity = length;
+  q->itemSize = itemSize;
+  return q;
+}
+
+inline void vQueueDelete(QueueHandle_t q) { delete q; }
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(q->lock);
+  if (!host_rtos::waitFor(q->cv, lock, ticks, [&] { return q->items.size() < q->capacity; })) return errQUEUE_FULL;
+  const uint8_t* p = (const uint8_t*)item;
+  q->items.emplace_back(p, p + q->itemSize);
+  q->cv.notify_all();
+  return pdTRUE;
+}
+#define xQueueSendToBack xQueueSend
+
+inline BaseType_t xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(q->lock);
+  if (!host_rtos::waitFor(q->cv, lock, ticks, [&] { return q->items.size() < q->capacity; })) return errQUEUE_FULL;
+  const uint8_t* p = (const uint8_t*)item;
+  q->items.emplace_front(p, p + q->itemSize);
+  q->cv.notify_all();
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(q->lock);
+  if (!host_rtos::waitFor(q->cv, lock, ticks, [&] { return !q->items.empty(); })) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  q->cv.notify_all();
+  return pdTRUE;
+}
+
+inline BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(q->lock);
+  if (!host_rtos::waitFor(q->cv, lock, ticks, [&] { return !q->items.empty(); })) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  std::lock_guard<std::mutex> guard(q->lock);
+  return (UBaseType_t)q->items.size();
+}
+
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+  std::lock_guard<std::mutex> guard(q->lock);
+  return (UBaseType_t)(q->capacity - q->items.size());
+}
+
+inline BaseType_t xQueueReset(QueueHandle_t q) {
+  std::lock_guard<std::mutex> guard(q->lock);
+  q->items.clear();
+  q->cv.notify_all();
+  return pdPASS;
+}
@@ -0,0 +1,81 @@
+// Replaces the C allocator (glibc allows this) to count live and peak heap bytes
+#include "host_heap.h"
+
+#include <atomic>
+#include <cerrno>
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+
+namespace {
+std::atomic<size_t> live{0};
+std::atomic<size_t> peak{0};
+std::atomic<uint32_t> allocations{0};
+
+void added(void* p) {
+  if (!p) return;
+  size_t now = live.fetch_add(malloc_usable_size(p)) + malloc_usable_size(p);
+  size_t high = peak.load(std::memory_order_relaxed);
+  while (now > high && !peak.compare_exchange_weak(high, now)) {}
+  allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void removed(void* p) {
+  if (p) live.fetch_sub(malloc_usable_size(p));
+}
+}  // namespace
+
+size_t hostHeapLive() { return live.load(); }
+size_t hostHeapPeak() { return peak.load(); }
+void hostHeapResetPeak() { peak.store(live.load()); }
+uint32_t hostHeapAllocations() { return allocations.load(); }
+
+extern "C" {
+void* malloc(size_t n) {
+  void* p = __libc_malloc(n);
+  added(p);
+  return p;
+}
+
+void* calloc(size_t n, size_t size) {
+  void* p = __libc_calloc(n, size);
+  added(p);
+  return p;
+}
+
+void* realloc(void* old, size_t n) {
+  size_t before = old ? malloc_usable_size(old) : 0;
+  void* p = __libc_realloc(old, n);
+  if (!p) return nullptr;
+  live.fetch_sub(before);
+  if (old) allocations.fetch_sub(1, std::memory_order_relaxed);   // A resize, not a new block
+  added(p);
+  return p;
+}
+
+void free(void* p) {
+  removed(p);
+  __libc_free(p);
+}
+
+void* memalign(size_t align, size_t n) {
+  void* p = __libc_memalign(align, n);
+  added(p);
+  return p;
+}
+
+void* aligned_alloc(size_t align, size_t n) { return memalign(align, n); }
+
+int posix_memalign(void** out, size_t align, size_t n) {
+  void* p = memalign(align, n);
+  if (!p) return ENOMEM;
+  *out = p;
+  return 0;
+}
+}
@@ -0,0 +1,60 @@
+/*
+  Host heap accounting (tests only). host_heap.cpp replaces malloc and friends,
+  so every allocation made by the code under test (String, ArduinoJson, new,
+  ps_malloc) is counted. hostHeapPeak() is the high-water mark since the last
+  hostHeapResetPeak(); the ESP queries report a 320 KB internal heap and an
+  8 MB PSRAM against the same counter.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define HOST_HEAP_SIZE (320 * 1024)
+#define HOST_PSRAM_SIZE (8 * 1024 * 1024)
+
+size_t hostHeapLive();
+size_t hostHeapPeak();
+void hostHeapResetPeak();
+uint32_t hostHeapAllocations();
+
+inline void* ps_malloc(size_t n) { return malloc(n); }
+inline void* ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void* ps_realloc(void* p, size_t n) { return realloc(p, n); }
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+inline void* heap_caps_malloc(size_t n, uint32_t) { return malloc(n); }
+inline void heap_caps_free(void* p) { free(p); }
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+  size_t total = (caps & MALLOC_CAP_SPIRAM) ? HOST_PSRAM_SIZE : HOST_HEAP_SIZE;
+  size_t live = hostHeapLive();
+  return live < total ? total - live : 0;
+}
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  size_t total = (caps & MALLOC_CAP_SPIRAM) ? HOST_PSRAM_SIZE : HOST_HEAP_SIZE;
+  size_t peak = hostHeapPeak();
+  return peak < total ? total - peak : 0;
+}
+
+class EspClass {
+ public:
+  uint32_t getHeapSize() { return HOST_HEAP_SIZE; }
+  uint32_t getFreeHeap() { return heap_caps_get_free_size(MALLOC_CAP_INTERNAL); }
+  uint32_t getMinFreeHeap() { return heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL); }
+  uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+  uint32_t getPsramSize() { return HOST_PSRAM_SIZE; }
+  uint32_t getFreePsram() { return heap_caps_get_free_size(MALLOC_CAP_SPIRAM); }
+  uint32_t getMinFreePsram() { return heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM); }
+  uint32_t getCpuFreqMHz() { return 240; }
+  const char* getSdkVersion() { return "host"; }
+  void restart() { exit(0); }
+};
+inline EspClass ESP;
+
+inline uint32_t esp_random() { return ((uint32_t)rand() << 16) ^ (uint32_t)rand(); }
@@ -0,0 +1,1371 @@
+/*
+================================================================================
+  KIKO - ArduinoJson stand-in for the host harness (tests only)
+================================================================================
+  The part of the ArduinoJson 7 API the sketch uses, so Kiko.ino compiles and
+  runs on a host that has no copy of the library. CMake puts this directory on
+  the include path only when the real ArduinoJson is not found.
+
+  - JsonDocument holds a tree of nodes allocated through its Allocator, so
+    PeakTrackingAllocator (api_response.h) sees every byte a document keeps.
+  - JsonVariant, JsonObject and JsonArray are references into a document.
+    Indexing a missing member only records the path; the members are created
+    by the first write, so reads never grow the document.
+  - deserializeJson() reads String, char buffers, Streams and custom readers,
+    with DeserializationOption::Filter; serializeJson() writes to String,
+    Print and char buffers.
+
+  Not the real thing: no MessagePack, no nesting limit, no string
+  deduplication, and floats print with printf precision.
+================================================================================
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <cerrno>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace ArduinoJson {
+
+class Allocator {
+ public:
+  virtual void* allocate(size_t size) = 0;
+  virtual void deallocate(void* ptr) = 0;
+  virtual void* reallocate(void* ptr, size_t newSize) = 0;
+
+ protected:
+  ~Allocator() = default;
+};
+
+class JsonDocument;
+class JsonVariant;
+class JsonObject;
+class JsonArray;
+
+namespace detail {
+
+class MallocAllocator : public Allocator {
+ public:
+  void* allocate(size_t size) override { return malloc(size); }
+  void deallocate(void* ptr) override { free(ptr); }
+  void* reallocate(void* ptr, size_t newSize) override { return realloc(ptr, newSize); }
+};
+
+inline Allocator* defaultAllocator() {
+  static MallocAllocator allocator;
+  return &allocator;
+}
+
+enum class Type : uint8_t { Null, Bool, Int, UInt, Float, Double, String, Raw, Array, Object };
+
+// One value. Members and elements are a singly linked list of children; an object member
+// carries its key.
+struct Node {
+  Type type = Type::Null;
+  bool boolean = false;
+  int64_t sint = 0;
+  uint64_t uint = 0;
+  double real = 0;
+  char* str = nullptr;   // String and Raw
+  size_t len = 0;
+  char* key = nullptr;
+  Node* first = nullptr;
+  Node* last = nullptr;
+  Node* next = nullptr;
+  size_t count = 0;
+};
+
+// Node and string storage of one document
+class Pool {
+ public:
+  explicit Pool(Allocator* allocator) : allocator_(allocator) {}
+
+  Allocator* allocator() const { return allocator_; }
+  bool overflowed() const { return overflowed_; }
+
+  Node* node() {
+    void* p = allocator_->allocate(sizeof(Node));
+    if (!p) {
+      overflowed_ = true;
+      return nullptr;
+    }
+    return new (p) Node();
+  }
+
+  char* copy(const char* s, size_t len) {
+    char* p = (char*)allocator_->allocate(len + 1);
+    if (!p) {
+      overflowed_ = true;
+      return nullptr;
+    }
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+  }
+
+  // Frees what n holds and makes it null; n itself stays
+  void clear(Node* n) {
+    Node* c = n->first;
+    while (c) {
+      Node* next = c->next;
+      release(c);
+      c = next;
+    }
+    if (n->str) allocator_->deallocate(n->str);
+    n->str = nullptr;
+    n->len = 0;
+    n->first = n->last = nullptr;
+    n->count = 0;
+    n->type = Type::Null;
+  }
+
+  void release(Node* n) {
+    clear(n);
+    if (n->key) allocator_->deallocate(n->key);
+    n->~Node();
+    allocator_->deallocate(n);
+  }
+
+  void append(Node* parent, Node* child) {
+    if (parent->last) parent->last->next = child;
+    else parent->first = child;
+    parent->last = child;
+    parent->count++;
+  }
+
+  void resetOverflow() { overflowed_ = false; }
+
+ private:
+  Allocator* allocator_;
+  bool overflowed_ = false;
+};
+
+inline bool isContainer(const Node* n) { return n && (n->type == Type::Array || n->type == Type::Object); }
+
+inline Node* member(const Node* n, const char* key, size_t len) {
+  if (!n || n->type != Type::Object) return nullptr;
+  for (Node* c = n->first; c; c = c->next) {
+    if (strlen(c->key) == len && memcmp(c->key, key, len) == 0) return c;
+  }
+  return nullptr;
+}
+
+inline Node* element(const Node* n, size_t index) {
+  if (!n || n->type != Type::Array) return nullptr;
+  Node* c = n->first;
+  while (c && index--) c = c->next;
+  return c;
+}
+
+// Where a JsonVariant points: an existing node, plus the member keys and element indexes
+// below it that do not exist yet. Keys point at the caller's strings.
+struct Ref {
+  static const int MAX_DEPTH = 10;
+  struct Step {
+    const char* key;   // Null for an element index
+    size_t len;
+  };
+
+  Pool* pool = nullptr;
+  Node* node = nullptr;
+  uint8_t depth = 0;
+  Step steps[MAX_DEPTH];
+
+  Ref() {}
+  Ref(Pool* p, Node* n) : pool(p), node(n) {}
+
+  Node* find() const {
+    Node* n = node;
+    for (int i = 0; n && i < depth; i++) {
+      n = steps[i].key ? member(n, steps[i].key, steps[i].len) : element(n, steps[i].len);
+    }
+    return n;
+  }
+
+  // Creates the missing members and elements; null if a step crosses a non-container
+  Node* make() const {
+    Node* n = node;
+    for (int i = 0; n && i < depth; i++) n = steps[i].key ? makeMember(n, steps[i].key, steps[i].len) : makeElement(n, steps[i].len);
+    return n;
+  }
+
+  Ref child(const char* key, size_t len) const { return step(key, len); }
+  Ref child(size_t index) const { return step(nullptr, index); }
+
+ private:
+  Ref step(const char* key, size_t len) const {
+    Ref r;
+    r.pool = pool;
+    Node* existing = depth ? find() : node;
+    if (existing || !node) {
+      r.node = existing;
+    } else {
+      r = *this;
+      if (r.depth == MAX_DEPTH) {
+        r.node = nullptr;
+        r.depth = 0;
+        return r;
+      }
+    }
+    r.steps[r.depth++] = {key, len};
+    return r;
+  }
+
+  Node* makeMember(Node* n, const char* key, size_t len) const {
+    if (n->type == Type::Null) n->type = Type::Object;
+    if (n->type != Type::Object) return nullptr;
+    if (Node* m = member(n, key, len)) return m;
+    Node* m = pool->node();
+    if (!m) return nullptr;
+    m->key = pool->copy(key, len);
+    if (!m->key) {
+      pool->release(m);
+      return nullptr;
+    }
+    pool->append(n, m);
+    return m;
+  }
+
+  Node* makeElement(Node* n, size_t index) const {
+    if (n->type == Type::Null) n->type = Type::Array;
+    if (n->type != Type::Array) return nullptr;
+    while (n->count <= index) {
+      Node* e = pool->node();
+      if (!e) return nullptr;
+      pool->append(n, e);
+    }
+    return element(n, index);
+  }
+};
+
+struct RawJson {
+  std::string json;
+};
+
+class VariantBase;
+
+// ---------- Serialization ----------
+
+template <typename Sink>
+class Writer {
+ public:
+  explicit Writer(Sink& sink) : sink_(sink) {}
+
+  void value(const Node* n) {
+    if (!n) return put("null");
+    char buf[32];
+    switch (n->type) {
+      case Type::Null: put("null"); break;
+      case Type::Bool: put(n->boolean ? "true" : "false"); break;
+      case Type::Int: snprintf(buf, sizeof(buf), "%lld", (long long)n->sint); put(buf); break;
+      case Type::UInt: snprintf(buf, sizeof(buf), "%llu", (unsigned long long)n->uint); put(buf); break;
+      case Type::Float:
+      case Type::Double:
+        if (!std::isfinite(n->real)) {
+          put("null");
+        } else {
+          snprintf(buf, sizeof(buf), "%.*g", n->type == Type::Float ? 7 : 15, n->real);
+          put(buf);
+        }
+        break;
+      case Type::String: string(n->str, n->len); break;
+      case Type::Raw: sink_.write(n->str, n->len); count_ += n->len; break;
+      case Type::Array:
+        put("[");
+        for (const Node* c = n->first; c; c = c->next) {
+          if (c != n->first) put(",");
+          value(c);
+        }
+        put("]");
+        break;
+      case Type::Object:
+        put("{");
+        for (const Node* c = n->first; c; c = c->next) {
+          if (c != n->first) put(",");
+          string(c->key, strlen(c->key));
+          put(":");
+          value(c);
+        }
+        put("}");
+        break;
+    }
+  }
+
+  size_t count() const { return count_; }
+
+ private:
+  void put(const char* s) {
+    size_t n = strlen(s);
+    sink_.write(s, n);
+    count_ += n;
+  }
+
+  void string(const char* s, size_t len) {
+    put("\"");
+    size_t run = 0;
+    for (size_t i = 0; i < len; i++) {
+      unsigned char c = (unsigned char)s[i];
+      const char* esc = nullptr;
+      char u[8];
+      switch (c) {
+        case '"': esc = "\\\""; break;
+        case '\\': esc = "\\\\"; break;
+        case '\b': esc = "\\b"; break;
+        case '\f': esc = "\\f"; break;
+        case '\n': esc = "\\n"; break;
+        case '\r': esc = "\\r"; break;
+        case '\t': esc = "\\t"; break;
+        default:
+          if (c < 0x20) {
+            snprintf(u, sizeof(u), "\\u%04x", c);
+            esc = u;
+          }
+      }
+      if (!esc) continue;
+      if (i > run) {
+        sink_.write(s + run, i - run);
+        count_ += i - run;
+      }
+      put(esc);
+      run = i + 1;
+    }
+    if (len > run) {
+      sink_.write(s + run, len - run);
+      count_ += len - run;
+    }
+    put("\"");
+  }
+
+  Sink& sink_;
+  size_t count_ = 0;
+};
+
+struct StringSink {
+  std::string out;
+  void write(const char* s, size_t n) { out.append(s, n); }
+};
+
+struct PrintSink {
+  Print& out;
+  void write(const char* s, size_t n) { out.write((const uint8_t*)s, n); }
+};
+
+struct BufferSink {
+  char* buf;
+  size_t size;
+  size_t used = 0;
+  void write(const char* s, size_t n) {
+    if (!size) return;
+    size_t k = std::min(n, size - 1 - used);
+    memcpy(buf + used, s, k);
+    used += k;
+  }
+};
+
+struct CountingSink {
+  void write(const char*, size_t) {}
+};
+
+inline String toJson(const Node* n) {
+  StringSink sink;
+  Writer<StringSink> writer(sink);
+  writer.value(n);
+  return String(std::move(sink.out));
+}
+
+// Deep copy of src into dst, which must be null
+inline bool copyNode(Pool* pool, Node* dst, const Node* src) {
+  if (!src) return true;
+  dst->type = src->type;
+  dst->boolean = src->boolean;
+  dst->sint = src->sint;
+  dst->uint = src->uint;
+  dst->real = src->real;
+  if (src->str) {
+    dst->str = pool->copy(src->str, src->len);
+    dst->len = src->len;
+    if (!dst->str) return false;
+  }
+  for (const Node* c = src->first; c; c = c->next) {
+    Node* d = pool->node();
+    if (!d) return false;
+    if (c->key && !(d->key = pool->copy(c->key, strlen(c->key)))) {
+      pool->release(d);
+      return false;
+    }
+    pool->append(dst, d);
+    if (!copyNode(pool, d, c)) return false;
+  }
+  return true;
+}
+
+template <typename T>
+struct IsVariant : std::is_base_of<VariantBase, typename std::decay<T>::type> {};
+
+template <typename T>
+struct IsArithmetic
+    : std::integral_constant<bool, (std::is_arithmetic<T>::value || std::is_enum<T>::value) && !std::is_same<T, bool>::value> {};
+
+// What JsonVariant, JsonObject and JsonArray share: reading, writing and creating children
+class VariantBase {
+ public:
+  VariantBase() {}
+  explicit VariantBase(const Ref& ref) : ref_(ref) {}
+
+  bool isNull() const {
+    Node* n = ref_.find();
+    return !n || n->type == Type::Null;
+  }
+
+  size_t size() const {
+    Node* n = ref_.find();
+    return isContainer(n) ? n->count : 0;
+  }
+
+  bool containsKey(const char* key) const { return member(ref_.find(), key, strlen(key)) != nullptr; }
+  bool containsKey(const String& key) const { return member(ref_.find(), key.c_str(), key.length()) != nullptr; }
+
+  template <typename T>
+  T as() const;
+
+  template <typename T>
+  bool is() const;
+
+  // Writing
+
+  bool set(std::nullptr_t) { return setNode([](Node*) { return true; }); }
+  bool set(bool v) {
+    return setNode([&](Node* n) {
+      n->type = Type::Bool;
+      n->boolean = v;
+      return true;
+    });
+  }
+  template <typename T>
+  typename std::enable_if<IsArithmetic<T>::value, bool>::type set(T v) {
+    return setNode([&](Node* n) {
+      if (std::is_floating_point<T>::value) {
+        n->type = std::is_same<T, float>::value ? Type::Float : Type::Double;
+        n->real = (double)v;
+      } else if (std::is_signed<typename std::conditional<std::is_enum<T>::value, int, T>::type>::value) {
+        n->type = Type::Int;
+        n->sint = (int64_t)v;
+      } else {
+        n->type = Type::UInt;
+        n->uint = (uint64_t)v;
+      }
+      return true;
+    });
+  }
+  bool set(const char* s) {
+    if (!s) return set(nullptr);
+    return setString(s, strlen(s), Type::String);
+  }
+  bool set(char* s) { return set((const char*)s); }
+  bool set(const String& s) { return setString(s.c_str(), s.length(), Type::String); }
+  bool set(const RawJson& raw) { return setString(raw.json.data(), raw.json.size(), Type::Raw); }
+  bool set(const VariantBase& v) {
+    const Node* src = v.ref_.find();
+    return setNode([&](Node* n) { return copyNode(ref_.pool, n, src); });
+  }
+
+  // Empties the value and makes it an array or an object
+  template <typename T>
+  T to();
+
+  // Array element appended at the end
+  template <typename T>
+  typename std::enable_if<!IsVariant<T>::value, bool>::type add(const T& value);
+  bool add(const VariantBase& value);
+  template <typename T>
+  typename std::enable_if<IsVariant<T>::value, T>::type add();
+
+  JsonObject createNestedObject();
+  JsonObject createNestedObject(const char* key);
+  JsonObject createNestedObject(const String& key);
+  JsonArray createNestedArray();
+  JsonArray createNestedArray(const char* key);
+  JsonArray createNestedArray(const String& key);
+
+  void remove(const char* key) { removeChild(member(ref_.find(), key, strlen(key))); }
+  void remove(const String& key) { removeChild(member(ref_.find(), key.c_str(), key.length())); }
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type remove(T index) {
+    removeChild(element(ref_.find(), (size_t)index));
+  }
+
+  void clear() {
+    if (Node* n = ref_.find()) {
+      Type t = n->type;
+      ref_.pool->clear(n);
+      if (t == Type::Array || t == Type::Object) n->type = t;
+    }
+  }
+
+  const Ref& ref() const { return ref_; }
+
+ protected:
+  template <typename F>
+  bool setNode(F fill) {
+    Node* n = ref_.make();
+    if (!n) return false;
+    ref_.pool->clear(n);
+    return fill(n);
+  }
+
+  bool setString(const char* s, size_t len, Type type) {
+    return setNode([&](Node* n) {
+      n->str = ref_.pool->copy(s, len);
+      if (!n->str) return false;
+      n->type = type;
+      n->len = len;
+      return true;
+    });
+  }
+
+  void removeChild(Node* child) {
+    Node* n = ref_.find();
+    if (!child || !n) return;
+    Node* prev = nullptr;
+    for (Node* c = n->first; c; prev = c, c = c->next) {
+      if (c != child) continue;
+      if (prev) prev->next = c->next;
+      else n->first = c->next;
+      if (n->last == c) n->last = prev;
+      n->count--;
+      ref_.pool->release(c);
+      return;
+    }
+  }
+
+  Ref ref_;
+};
+
+template <typename T, typename Enable = void>
+struct Converter;
+
+template <typename T>
+struct Converter<T, typename std::enable_if<IsArithmetic<T>::value>::type> {
+  static T from(const Node* n) {
+    if (!n) return T();
+    switch (n->type) {
+      case Type::Bool: return (T)n->boolean;
+      case Type::Int: return (T)n->sint;
+      case Type::UInt: return (T)n->uint;
+      case Type::Float:
+      case Type::Double: return (T)n->real;
+      default: return T();
+    }
+  }
+  static bool is(const Node* n) {
+    if (!n) return false;
+    if (std::is_floating_point<T>::value) return n->type == Type::Int || n->type == Type::UInt || n->type == Type::Float || n->type == Type::Double;
+    return n->type == Type::Int || n->type == Type::UInt;
+  }
+};
+
+template <>
+struct Converter<bool> {
+  static bool from(const Node* n) {
+    if (!n) return false;
+    switch (n->type) {
+      case Type::Bool: return n->boolean;
+      case Type::Int: return n->sint != 0;
+      case Type::UInt: return n->uint != 0;
+      case Type::Float:
+      case Type::Double: return n->real != 0;
+      case Type::Null: return false;
+      default: return true;
+    }
+  }
+  static bool is(const Node* n) { return n && n->type == Type::Bool; }
+};
+
+template <>
+struct Converter<const char*> {
+  static const char* from(const Node* n) { return n && n->type == Type::String ? n->str : nullptr; }
+  static bool is(const Node* n) { return n && n->type == Type::String; }
+};
+
+template <>
+struct Converter<String> {
+  // Strings as they are, anything else as its JSON
+  static String from(const Node* n) {
+    if (n && n->type == Type::String) return String(n->str, n->len);
+    return toJson(n);
+  }
+  static bool is(const Node* n) { return n && n->type == Type::String; }
+};
+
+}  // namespace detail
+
+// ---------- Public types ----------
+
+class JsonString {
+ public:
+  JsonString() {}
+  JsonString(const char* s) : s_(s) {}
+  const char* c_str() const { return s_ ? s_ : ""; }
+  size_t size() const { return s_ ? strlen(s_) : 0; }
+  bool isNull() const { return !s_; }
+  operator String() const { return String(c_str()); }
+  friend bool operator==(const JsonString& a, const char* b) { return strcmp(a.c_str(), b ? b : "") == 0; }
+  friend bool operator!=(const JsonString& a, const char* b) { return !(a == b); }
+  friend bool operator==(const JsonString& a, const String& b) { return b == a.c_str(); }
+
+ private:
+  const char* s_ = nullptr;
+};
+
+class JsonVariant : public detail::VariantBase {
+ public:
+  JsonVariant() {}
+  explicit JsonVariant(const detail::Ref& ref) : VariantBase(ref) {}
+  JsonVariant(const VariantBase& v) : VariantBase(v.ref()) {}
+  JsonVariant(const JsonVariant& v) : VariantBase(v.ref()) {}
+
+  // Assigning to a variant writes the value into the document
+  JsonVariant& operator=(const JsonVariant& v) {
+    set(v);
+    return *this;
+  }
+  template <typename T>
+  JsonVariant& operator=(const T& v) {
+    set(v);
+    return *this;
+  }
+  JsonVariant& operator=(const char* s) {
+    set(s);
+    return *this;
+  }
+
+  JsonVariant operator[](const char* key) const { return JsonVariant(ref_.child(key, strlen(key))); }
+  JsonVariant operator[](char* key) const { return (*this)[(const char*)key]; }
+  JsonVariant operator[](const String& key) const { return JsonVariant(ref_.child(key.c_str(), key.length())); }
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, JsonVariant>::type operator[](T index) const {
+    return JsonVariant(ref_.child((size_t)index));
+  }
+
+  template <typename T, typename = typename std::enable_if<!detail::IsVariant<T>::value>::type>
+  operator T() const {
+    return as<T>();
+  }
+
+  template <typename T>
+  typename std::enable_if<detail::IsArithmetic<T>::value || std::is_same<T, bool>::value, T>::type operator|(T fallback) const {
+    detail::Node* n = ref_.find();
+    return detail::Converter<T>::is(n) ? detail::Converter<T>::from(n) : fallback;
+  }
+  const char* operator|(const char* fallback) const {
+    const char* s = detail::Converter<const char*>::from(ref_.find());
+    return s ? s : fallback;
+  }
+  String operator|(const String& fallback) const {
+    const char* s = detail::Converter<const char*>::from(ref_.find());
+    return s ? String(s) : fallback;
+  }
+};
+
+inline bool operator==(const JsonVariant& v, const char* s) {
+  const char* mine = v.as<const char*>();
+  return mine && s && strcmp(mine, s) == 0;
+}
+inline bool operator!=(const JsonVariant& v, const char* s) { return !(v == s); }
+inline bool operator==(const JsonVariant& v, const String& s) { return v == s.c_str(); }
+inline bool operator!=(const JsonVariant& v, const String& s) { return !(v == s); }
+template <typename T>
+inline typename std::enable_if<detail::IsArithmetic<T>::value || std::is_same<T, bool>::value, bool>::type operator==(const JsonVariant& v, T x) {
+  return detail::Converter<T>::is(v.ref().find()) && v.as<T>() == x;
+}
+template <typename T>
+inline typename std::enable_if<detail::IsArithmetic<T>::value || std::is_same<T, bool>::value, bool>::type operator!=(const JsonVariant& v, T x) {
+  return !(v == x);
+}
+
+class JsonPair {
+ public:
+  JsonPair(detail::Pool* pool, detail::Node* n) : node_(pool, n) {}
+  JsonString key() const { return JsonString(node_.node->key); }
+  JsonVariant value() const { return JsonVariant(node_); }
+
+ private:
+  detail::Ref node_;
+};
+
+namespace detail {
+
+template <typename Item>
+class Iterator {
+ public:
+  Iterator(Pool* pool, Node* n) : pool_(pool), n_(n) {}
+  Item operator*() const { return Item(pool_, n_); }
+  Iterator& operator++() {
+    n_ = n_->next;
+    return *this;
+  }
+  bool operator!=(const Iterator& o) const { return n_ != o.n_; }
+  bool operator==(const Iterator& o) const { return n_ == o.n_; }
+
+ private:
+  Pool* pool_;
+  Node* n_;
+};
+
+struct ElementItem : JsonVariant {
+  ElementItem(Pool* pool, Node* n) : JsonVariant(Ref(pool, n)) {}
+};
+
+}  // namespace detail
+
+class JsonObject : public detail::VariantBase {
+ public:
+  typedef detail::Iterator<JsonPair> iterator;
+
+  JsonObject() {}
+  explicit JsonObject(const detail::Ref& ref) : VariantBase(ref) {}
+  JsonObject(const VariantBase& v) : VariantBase(v.ref()) {}
+
+  JsonVariant operator[](const char* key) const { return JsonVariant(ref_.child(key, strlen(key))); }
+  JsonVariant operator[](char* key) const { return (*this)[(const char*)key]; }
+  JsonVariant operator[](const String& key) const { return JsonVariant(ref_.child(key.c_str(), key.length())); }
+
+  iterator begin() const {
+    detail::Node* n = ref_.find();
+    return iterator(ref_.pool, n && n->type == detail::Type::Object ? n->first : nullptr);
+  }
+  iterator end() const { return iterator(ref_.pool, nullptr); }
+
+  bool isNull() const {
+    detail::Node* n = ref_.find();
+    return !n || n->type != detail::Type::Object;
+  }
+};
+
+class JsonArray : public detail::VariantBase {
+ public:
+  typedef detail::Iterator<detail::ElementItem> iterator;
+
+  JsonArray() {}
+  explicit JsonArray(const detail::Ref& ref) : VariantBase(ref) {}
+  JsonArray(const VariantBase& v) : VariantBase(v.ref()) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, JsonVariant>::type operator[](T index) const {
+    return JsonVariant(ref_.child((size_t)index));
+  }
+
+  iterator begin() const {
+    detail::Node* n = ref_.find();
+    return iterator(ref_.pool, n && n->type == detail::Type::Array ? n->first : nullptr);
+  }
+  iterator end() const { return iterator(ref_.pool, nullptr); }
+
+  bool isNull() const {
+    detail::Node* n = ref_.find();
+    return !n || n->type != detail::Type::Array;
+  }
+};
+
+namespace detail {
+
+template <>
+struct Converter<JsonVariant> {
+  static bool is(const Node*) { return true; }
+};
+template <>
+struct Converter<JsonObject> {
+  static bool is(const Node* n) { return n && n->type == Type::Object; }
+};
+template <>
+struct Converter<JsonArray> {
+  static bool is(const Node* n) { return n && n->type == Type::Array; }
+};
+
+template <typename T>
+inline T VariantBase::as() const {
+  if constexpr (IsVariant<T>::value) {
+    // An object or array view of a value of another type is null
+    Node* n = ref_.find();
+    if (!std::is_same<T, JsonVariant>::value && !Converter<T>::is(n)) return T();
+    return T(ref_);
+  } else {
+    return Converter<T>::from(ref_.find());
+  }
+}
+
+template <typename T>
+inline bool VariantBase::is() const {
+  return Converter<T>::is(ref_.find());
+}
+
+template <typename T>
+inline T VariantBase::to() {
+  Node* n = ref_.make();
+  if (!n) return T();
+  ref_.pool->clear(n);
+  n->type = std::is_same<T, JsonArray>::value ? Type::Array : std::is_same<T, JsonObject>::value ? Type::Object : Type::Null;
+  return T(Ref(ref_.pool, n));
+}
+
+template <typename T>
+inline typename std::enable_if<!IsVariant<T>::value, bool>::type VariantBase::add(const T& value) {
+  Node* n = ref_.make();
+  if (!n) return false;
+  if (n->type == Type::Null) n->type = Type::Array;
+  if (n->type != Type::Array) return false;
+  JsonVariant e(Ref(ref_.pool, n).child(n->count));
+  return e.set(value);
+}
+
+inline bool VariantBase::add(const VariantBase& value) {
+  Node* n = ref_.make();
+  if (!n) return false;
+  if (n->type == Type::Null) n->type = Type::Array;
+  if (n->type != Type::Array) return false;
+  JsonVariant e(Ref(ref_.pool, n).child(n->count));
+  return e.set(value);
+}
+
+template <typename T>
+inline typename std::enable_if<IsVariant<T>::value, T>::type VariantBase::add() {
+  Node* n = ref_.make();
+  if (!n) return T();
+  if (n->type == Type::Null) n->type = Type::Array;
+  if (n->type != Type::Array) return T();
+  return JsonVariant(Ref(ref_.pool, n).child(n->count)).template to<T>();
+}
+
+inline JsonObject VariantBase::createNestedObject() { return add<JsonObject>(); }
+inline JsonArray VariantBase::createNestedArray() { return add<JsonArray>(); }
+inline JsonObject VariantBase::createNestedObject(const char* key) { return JsonVariant(ref_.child(key, strlen(key))).to<JsonObject>(); }
+inline JsonObject VariantBase::createNestedObject(const String& key) { return createNestedObject(key.c_str()); }
+inline JsonArray VariantBase::createNestedArray(const char* key) { return JsonVariant(ref_.child(key, strlen(key))).to<JsonArray>(); }
+inline JsonArray VariantBase::createNestedArray(const String& key) { return createNestedArray(key.c_str()); }
+
+}  // namespace detail
+
+// ---------- JsonDocument ----------
+
+class JsonDocument : public detail::VariantBase {
+ public:
+  JsonDocument() : JsonDocument(detail::defaultAllocator()) {}
+  explicit JsonDocument(Allocator* allocator) : pool_(allocator ? allocator : detail::defaultAllocator()) { rebind(); }
+  JsonDocument(const JsonDocument& other) : pool_(other.pool_.allocator()) {
+    rebind();
+    detail::copyNode(&pool_, &root_, &other.root_);
+  }
+  JsonDocument(JsonDocument&& other) : pool_(other.pool_.allocator()) {
+    rebind();
+    root_ = other.root_;
+    other.root_ = detail::Node();
+  }
+  JsonDocument& operator=(const JsonDocument& other) {
+    if (this != &other) {
+      clear();
+      detail::copyNode(&pool_, &root_, &other.root_);
+    }
+    return *this;
+  }
+  template <typename T>
+  JsonDocument& operator=(const T& value) {
+    set(value);
+    return *this;
+  }
+  ~JsonDocument() { pool_.clear(&root_); }
+
+  void clear() {
+    pool_.clear(&root_);
+    pool_.resetOverflow();
+  }
+  bool overflowed() const { return pool_.overflowed(); }
+  size_t memoryUsage() const { return 0; }
+
+  JsonVariant operator[](const char* key) const { return JsonVariant(ref_.child(key, strlen(key))); }
+  JsonVariant operator[](char* key) const { return (*this)[(const char*)key]; }
+  JsonVariant operator[](const String& key) const { return JsonVariant(ref_.child(key.c_str(), key.length())); }
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, JsonVariant>::type operator[](T index) const {
+    return JsonVariant(ref_.child((size_t)index));
+  }
+
+
+  detail::Pool* pool() { return &pool_; }
+  const detail::Node* root() const { return &root_; }
+  detail::Node* root() { return &root_; }
+
+ private:
+  void rebind() { ref_ = detail::Ref(&pool_, &root_); }
+
+  detail::Pool pool_;
+  detail::Node root_;
+};
+
+// ArduinoJson 7 sizes documents on demand; the capacity is only kept for source compatibility
+template <size_t Capacity>
+class StaticJsonDocument : public JsonDocument {
+ public:
+  using JsonDocument::operator=;
+};
+
+template <typename T>
+inline detail::RawJson serialized(const T& json) {
+  return detail::RawJson{std::string(String(json).c_str())};
+}
+inline detail::RawJson serialized(const char* json, size_t len) { return detail::RawJson{std::string(json, len)}; }
+
+namespace detail {
+
+inline const Node* nodeOf(const JsonDocument& doc) { return doc.root(); }
+inline const Node* nodeOf(const VariantBase& v) { return v.ref().find(); }
+
+}  // namespace detail
+
+template <typename Source>
+size_t serializeJson(const Source& source, String& out) {
+  detail::StringSink sink;
+  detail::Writer<detail::StringSink> writer(sink);
+  writer.value(detail::nodeOf(source));
+  out = String(std::move(sink.out));
+  return writer.count();
+}
+
+template <typename Source>
+size_t serializeJson(const Source& source, Print& out) {
+  detail::PrintSink sink{out};
+  detail::Writer<detail::PrintSink> writer(sink);
+  writer.value(detail::nodeOf(source));
+  return writer.count();
+}
+
+template <typename Source>
+size_t serializeJson(const Source& source, char* buf, size_t size) {
+  detail::BufferSink sink{buf, size};
+  detail::Writer<detail::BufferSink> writer(sink);
+  writer.value(detail::nodeOf(source));
+  if (size) buf[sink.used] = '\0';
+  return sink.used;
+}
+
+template <typename Source>
+size_t measureJson(const Source& source) {
+  detail::CountingSink sink;
+  detail::Writer<detail::CountingSink> writer(sink);
+  writer.value(detail::nodeOf(source));
+  return writer.count();
+}
+
+// ---------- Deserialization ----------
+
+class DeserializationError {
+ public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+  DeserializationError() {}
+  DeserializationError(Code code) : code_(code) {}
+
+  explicit operator bool() const { return code_ != Ok; }
+  Code code() const { return code_; }
+  const char* c_str() const {
+    static const char* const names[] = {"Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep"};
+    return names[code_];
+  }
+
+  friend bool operator==(const DeserializationError& a, Code b) { return a.code_ == b; }
+  friend bool operator!=(const DeserializationError& a, Code b) { return a.code_ != b; }
+  friend bool operator==(const DeserializationError& a, const DeserializationError& b) { return a.code_ == b.code_; }
+  friend bool operator!=(const DeserializationError& a, const DeserializationError& b) { return a.code_ != b.code_; }
+
+ private:
+  Code code_ = Ok;
+};
+
+namespace DeserializationOption {
+
+class Filter {
+ public:
+  explicit Filter(const JsonDocument& doc) : node_(doc.root()) {}
+  explicit Filter(const JsonVariant& v) : node_(v.ref().find()) {}
+  const detail::Node* node() const { return node_; }
+
+ private:
+  const detail::Node* node_;
+};
+
+}  // namespace DeserializationOption
+
+namespace detail {
+
+// What a filter lets through: true keeps everything below it, an object keeps the listed
+// members, an array applies its first element to every element
+class FilterView {
+ public:
+  explicit FilterView(const Node* n, bool all = false) : n_(n), all_(all) {}
+
+  bool allow() const { return all_ || (n_ && !(n_->type == Type::Null || (n_->type == Type::Bool && !n_->boolean))); }
+  bool allowScalar() const { return all_ || (n_ && n_->type == Type::Bool && n_->boolean); }
+  bool allowObject() const { return allowScalar() || (n_ && n_->type == Type::Object); }
+  bool allowArray() const { return allowScalar() || (n_ && n_->type == Type::Array); }
+
+  FilterView memberFilter(const char* key, size_t len) const {
+    if (allowScalar()) return FilterView(nullptr, true);
+    return FilterView(member(n_, key, len));
+  }
+  FilterView elementFilter() const {
+    if (allowScalar()) return FilterView(nullptr, true);
+    return FilterView(element(n_, 0));
+  }
+
+ private:
+  const Node* n_;
+  bool all_;
+};
+
+// Byte sources with one character of lookahead
+template <typename Source>
+class Input {
+ public:
+  explicit Input(Source& s) : s_(s) {}
+  int peek() {
+    if (!have_) {
+      c_ = s_.read();
+      have_ = true;
+    }
+    return c_;
+  }
+  int next() {
+    int c = peek();
+    have_ = false;
+    return c;
+  }
+
+ private:
+  Source& s_;
+  int c_ = -1;
+  bool have_ = false;
+};
+
+struct BufferSource {
+  const char* p;
+  const char* end;
+  int read() { return p < end ? (uint8_t)*p++ : -1; }
+};
+
+struct StreamSource {
+  Stream& s;
+  int read() {
+    char c;
+    return s.readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+  }
+};
+
+template <typename Reader>
+struct ReaderSource {
+  Reader& r;
+  int read() { return r.read(); }
+};
+
+template <typename Source>
+class Parser {
+ public:
+  Parser(Pool* pool, Source& source) : pool_(pool), in_(source) {}
+
+  DeserializationError::Code parse(Node* root, FilterView filter) {
+    skipSpace();
+    if (in_.peek() < 0) return DeserializationError::EmptyInput;
+    return value(filter.allow() ? root : nullptr, filter);
+  }
+
+ private:
+  typedef DeserializationError::Code Code;
+
+  // Parses one value into n, or skips it when n is null
+  Code value(Node* n, FilterView filter) {
+    skipSpace();
+    int c = in_.peek();
+    if (c < 0) return DeserializationError::IncompleteInput;
+    if (c == '{') return object(filter.allowObject() ? n : nullptr, filter);
+    if (c == '[') return array(filter.allowArray() ? n : nullptr, filter);
+    if (!filter.allowScalar()) n = nullptr;
+    if (c == '"' || c == '\'') {
+      Code e = string();
+      if (e != DeserializationError::Ok || !n) return e;
+      n->str = pool_->copy(buf_.data(), buf_.size());
+      if (!n->str) return DeserializationError::NoMemory;
+      n->type = Type::String;
+      n->len = buf_.size();
+      return DeserializationError::Ok;
+    }
+    return literal(n);
+  }
+
+  Code object(Node* n, FilterView filter) {
+    in_.next();
+    if (n) n->type = Type::Object;
+    skipSpace();
+    if (in_.peek() == '}') {
+      in_.next();
+      return DeserializationError::Ok;
+    }
+    for (;;) {
+      skipSpace();
+      if (in_.peek() < 0) return DeserializationError::IncompleteInput;
+      if (in_.peek() != '"' && in_.peek() != '\'') return DeserializationError::InvalidInput;
+      Code e = string();
+      if (e != DeserializationError::Ok) return e;
+      skipSpace();
+      int colon = in_.next();
+      if (colon < 0) return DeserializationError::IncompleteInput;
+      if (colon != ':') return DeserializationError::InvalidInput;
+
+      FilterView memberFilter = filter.memberFilter(buf_.data(), buf_.size());
+      Node* m = nullptr;
+      if (n && memberFilter.allow()) {
+        m = member(n, buf_.data(), buf_.size());
+        if (m) {
+          pool_->clear(m);
+        } else {
+          m = pool_->node();
+          if (!m || !(m->key = pool_->copy(buf_.data(), buf_.size()))) {
+            if (m) pool_->release(m);
+            return DeserializationError::NoMemory;
+          }
+          pool_->append(n, m);
+        }
+      }
+      e = value(m, memberFilter);
+      if (e != DeserializationError::Ok) return e;
+      skipSpace();
+      int c = in_.next();
+      if (c == '}') return DeserializationError::Ok;
+      if (c < 0) return DeserializationError::IncompleteInput;
+      if (c != ',') return DeserializationError::InvalidInput;
+    }
+  }
+
+  Code array(Node* n, FilterView filter) {
+    in_.next();
+    if (n) n->type = Type::Array;
+    skipSpace();
+    if (in_.peek() == ']') {
+      in_.next();
+      return DeserializationError::Ok;
+    }
+    FilterView elementFilter = filter.elementFilter();
+    for (;;) {
+      Node* e = nullptr;
+      if (n && elementFilter.allow()) {
+        e = pool_->node();
+        if (!e) return DeserializationError::NoMemory;
+        pool_->append(n, e);
+      }
+      Code err = value(e, elementFilter);
+      if (err != DeserializationError::Ok) return err;
+      skipSpace();
+      int c = in_.next();
+      if (c == ']') return DeserializationError::Ok;
+      if (c < 0) return DeserializationError::IncompleteInput;
+      if (c != ',') return DeserializationError::InvalidInput;
+    }
+  }
+
+  // Reads a quoted string into buf_ as UTF-8
+  Code string() {
+    int quote = in_.next();
+    buf_.clear();
+    for (;;) {
+      int c = in_.next();
+      if (c < 0) return DeserializationError::IncompleteInput;
+      if (c == quote) return DeserializationError::Ok;
+      if (c != '\\') {
+        buf_ += (char)c;
+        continue;
+      }
+      c = in_.next();
+      switch (c) {
+        case -1: return DeserializationError::IncompleteInput;
+        case 'b': buf_ += '\b'; break;
+        case 'f': buf_ += '\f'; break;
+        case 'n': buf_ += '\n'; break;
+        case 'r': buf_ += '\r'; break;
+        case 't': buf_ += '\t'; break;
+        case 'u': {
+          long cp = hex4();
+          if (cp < 0) return cp == -2 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+          if (cp >= 0xd800 && cp < 0xdc00 && in_.peek() == '\\') {
+            in_.next();
+            if (in_.next() != 'u') return DeserializationError::InvalidInput;
+            long lo = hex4();
+            if (lo < 0) return DeserializationError::InvalidInput;
+            cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+          }
+          utf8(cp);
+          break;
+        }
+        default: buf_ += (char)c;
+      }
+    }
+  }
+
+  long hex4() {
+    long v = 0;
+    for (int i = 0; i < 4; i++) {
+      int c = in_.next();
+      if (c < 0) return -2;
+      int d = isdigit(c) ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+      if (d < 0) return -1;
+      v = v * 16 + d;
+    }
+    return v;
+  }
+
+  void utf8(long cp) {
+    if (cp < 0x80) {
+      buf_ += (char)cp;
+    } else if (cp < 0x800) {
+      buf_ += (char)(0xc0 | (cp >> 6));
+      buf_ += (char)(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+      buf_ += (char)(0xe0 | (cp >> 12));
+      buf_ += (char)(0x80 | ((cp >> 6) & 0x3f));
+      buf_ += (char)(0x80 | (cp & 0x3f));
+    } else {
+      buf_ += (char)(0xf0 | (cp >> 18));
+      buf_ += (char)(0x80 | ((cp >> 12) & 0x3f));
+      buf_ += (char)(0x80 | ((cp >> 6) & 0x3f));
+      buf_ += (char)(0x80 | (cp & 0x3f));
+    }
+  }
+
+  // Numbers, true, false and null
+  Code literal(Node* n) {
+    buf_.clear();
+    for (;;) {
+      int c = in_.peek();
+      if (c < 0 || !(isalnum(c) || c == '-' || c == '+' || c == '.')) break;
+      buf_ += (char)in_.next();
+    }
+    if (buf_.empty()) return in_.peek() < 0 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+    if (buf_ == "true" || buf_ == "false") {
+      if (n) {
+        n->type = Type::Bool;
+        n->boolean = buf_ == "true";
+      }
+      return DeserializationError::Ok;
+    }
+    if (buf_ == "null") return DeserializationError::Ok;
+
+    const char* s = buf_.c_str();
+    char* end = nullptr;
+    bool integer = buf_.find_first_of(".eE") == std::string::npos;
+    errno = 0;
+    if (integer && s[0] == '-') {
+      long long v = strtoll(s, &end, 10);
+      if (*end == '\0' && errno != ERANGE) {
+        if (n) {
+          n->type = Type::Int;
+          n->sint = v;
+        }
+        return DeserializationError::Ok;
+      }
+    } else if (integer) {
+      unsigned long long v = strtoull(s, &end, 10);
+      if (*end == '\0' && errno != ERANGE) {
+        if (n) {
+          if (v <= (unsigned long long)INT64_MAX) {
+            n->type = Type::Int;
+            n->sint = (int64_t)v;
+          } else {
+            n->type = Type::UInt;
+            n->uint = v;
+          }
+        }
+        return DeserializationError::Ok;
+      }
+    }
+    double d = strtod(s, &end);
+    if (*end != '\0') return DeserializationError::InvalidInput;
+    if (n) {
+      n->type = Type::Double;
+      n->real = d;
+    }
+    return DeserializationError::Ok;
+  }
+
+  void skipSpace() {
+    while (in_.peek() == ' ' || in_.peek() == '\t' || in_.peek() == '\r' || in_.peek() == '\n') in_.next();
+  }
+
+  Pool* pool_;
+  Input<Source> in_;
+  std::string buf_;
+};
+
+template <typename Source>
+DeserializationError deserialize(JsonDocument& doc, Source& source, FilterView filter) {
+  doc.clear();
+  Parser<Source> parser(doc.pool(), source);
+  DeserializationError::Code e = parser.parse(doc.root(), filter);
+  if (e != DeserializationError::Ok) doc.clear();
+  return e;
+}
+
+template <typename T>
+struct IsCustomReader
+    : std::integral_constant<bool, std::is_class<T>::value && !std::is_base_of<Stream, T>::value &&
+                                       !std::is_same<T, String>::value && !std::is_same<T, std::string>::value> {};
+
+}  // namespace detail
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len,
+                                            DeserializationOption::Filter filter) {
+  detail::BufferSource source{input, input + len};
+  return detail::deserialize(doc, source, detail::FilterView(filter.node()));
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len) {
+  detail::BufferSource source{input, input + len};
+  return detail::deserialize(doc, source, detail::FilterView(nullptr, true));
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+  return deserializeJson(doc, input, input ? strlen(input) : 0);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::Filter filter) {
+  return deserializeJson(doc, input, input ? strlen(input) : 0, filter);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input) {
+  return deserializeJson(doc, (const char*)input);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input, size_t len) {
+  return deserializeJson(doc, (const char*)input, len);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+  return deserializeJson(doc, input.c_str(), input.length());
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input, DeserializationOption::Filter filter) {
+  return deserializeJson(doc, input.c_str(), input.length(), filter);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& input) {
+  detail::StreamSource source{input};
+  return detail::deserialize(doc, source, detail::FilterView(nullptr, true));
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& input, DeserializationOption::Filter filter) {
+  detail::StreamSource source{input};
+  return detail::deserialize(doc, source, detail::FilterView(filter.node()));
+}
+template <typename Reader, typename = typename std::enable_if<detail::IsCustomReader<Reader>::value>::type>
+DeserializationError deserializeJson(JsonDocument& doc, Reader& input) {
+  detail::ReaderSource<Reader> source{input};
+  return detail::deserialize(doc, source, detail::FilterView(nullptr, true));
+}
+template <typename Reader, typename = typename std::enable_if<detail::IsCustomReader<Reader>::value>::type>
+DeserializationError deserializeJson(JsonDocument& doc, Reader& input, DeserializationOption::Filter filter) {
+  detail::ReaderSource<Reader> source{input};
+  return detail::deserialize(doc, source, detail::FilterView(filter.node()));
+}
+
+}  // namespace ArduinoJson
+
+using namespace ArduinoJson;
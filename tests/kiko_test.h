@@ -0,0 +1,47 @@
+/*
+  Minimal test support for the host tests: CHECK() records a failure and
+  carries on, testResult() prints the summary and gives the exit code, and
+  bench() prints one "bench <name> <value> <unit>" line per measurement.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <chrono>
+#include <cstdio>
+
+inline int& testFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+#define CHECK(cond)                                                 \
+  do {                                                              \
+    if (!(cond)) {                                                  \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+      testFailures()++;                                             \
+    }                                                               \
+  } while (0)
+
+inline int testResult(const char* suite) {
+  if (testFailures()) {
+    printf("%s: %d check(s) failed\n", suite, testFailures());
+    return 1;
+  }
+  printf("%s: ok\n", suite);
+  return 0;
+}
+
+inline void bench(const char* name, double value, const char* unit) {
+  printf("bench %-40s %12.3f %s\n", name, value, unit);
+}
+
+class BenchTimer {
+ public:
+  BenchTimer() : start_(std::chrono::steady_clock::now()) {}
+  double us() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
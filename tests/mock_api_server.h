@@ -0,0 +1,404 @@
+/*
+  Stand-ins for the APIs Kiko.ino talks to, on one loopback HTTP/1.1 port
+  (tests only). Whisper answers with the scripted transcript, chat with the
+  scripted tool call or reply (as server-sent events when the request streams),
+  weather and search with the captured fixtures, and TTS with an MP3-sized body
+  for the sentence. Connections are kept alive, request bodies may be chunked,
+  and every API counts its requests and bytes. MockLatency stands in for the
+  network and the model, so turn latencies have realistic proportions: requests
+  are read no faster than the device's uplink could send them.
+
+  routeSketchHosts() sends the sketch's production hosts here (see hostRoute()
+  in host/WiFiClient.h); nothing else can be reached once it is called.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+#include <netinet/tcp.h>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum MockApi { MOCK_WHISPER, MOCK_CHAT, MOCK_WEATHER, MOCK_SEARCH, MOCK_TTS, MOCK_OTHER, MOCK_API_COUNT };
+static const char* const MOCK_API_NAMES[MOCK_API_COUNT] = {"whisper", "chat", "weather", "search", "tts", "other"};
+
+#define MOCK_TTS_BYTES_PER_CHAR 260   // 32 kbit/s MP3 at ~15 characters of speech per second
+
+struct MockLatency {
+  uint32_t uplinkBytesPerSec = 48000;   // TLS over Wi-Fi from the ESP32-S3; 0 for no limit
+  uint32_t whisperMs = 350;     // Last audio byte -> transcript
+  uint32_t chatFirstMs = 450;   // Request -> first token
+  uint32_t chatTokenMs = 25;    // Between streamed tokens
+  uint32_t toolMs = 200;        // Weather and search
+  uint32_t ttsMs = 150;         // TTS request -> first byte
+};
+
+// What the mocks answer for the current voice turn
+struct MockTurn {
+  std::string transcript;
+  std::string toolName;         // Empty: the model answers right away
+  std::string toolArgs;         // JSON object
+  std::string reply;            // Spoken answer (after the tool result, if any)
+};
+
+struct MockApiStats {
+  std::atomic<uint32_t> requests{0};
+  std::atomic<uint64_t> bytesIn{0};    // Request line, headers and body
+  std::atomic<uint64_t> bytesOut{0};
+  std::atomic<uint32_t> connections{0};
+};
+
+struct MockChatStats {
+  std::atomic<uint32_t> streamed{0};
+  std::atomic<uint32_t> toolCalls{0};      // Responses that asked for a tool
+  std::atomic<uint32_t> toolResults{0};    // Requests that carried a tool result
+  std::atomic<uint32_t> lastBodyBytes{0};
+};
+
+class MockApiServer {
+ public:
+  // Serves the weather and search fixtures from fixturesDir (tests/fixtures/api)
+  bool begin(const std::string& fixturesDir) {
+    weather_ = readFile(fixturesDir + "/weather.json");
+    search_ = readFile(fixturesDir + "/search.json");
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd_, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd_, 32) != 0) return false;
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd_, (sockaddr*)&addr, &len);
+    port_ = ntohs(addr.sin_port);
+    std::thread([this] { acceptLoop(); }).detach();
+    return !weather_.empty() && !search_.empty();
+  }
+
+  uint16_t port() const { return port_; }
+
+  void routeSketchHosts() {
+    const char* hosts[] = {"api.openai.com", "api.openweathermap.org", "www.googleapis.com", "translate.google.com"};
+    for (const char* host : hosts) hostRoute(host, 443, "127.0.0.1", port_);
+  }
+
+  void script(const MockTurn& turn) {
+    std::lock_guard<std::mutex> guard(lock_);
+    turn_ = turn;
+  }
+
+  MockLatency latency;
+  MockApiStats stats[MOCK_API_COUNT];
+  MockChatStats chat;
+
+ private:
+  struct Request {
+    std::string method, target, body;
+    bool close = false;
+    size_t bytes = 0;
+  };
+
+  // Buffered reads from one connection
+  class Conn {
+   public:
+    Conn(int fd, uint32_t bytesPerSec) : fd_(fd), bytesPerSec_(bytesPerSec) {}
+    bool line(std::string& out) {
+      out.clear();
+      for (;;) {
+        int c = get();
+        if (c < 0) return false;
+        if (c == '\n') {
+          if (!out.empty() && out.back() == '\r') out.pop_back();
+          return true;
+        }
+        out += (char)c;
+      }
+    }
+    bool bytes(std::string& out, size_t n) {
+      while (n--) {
+        int c = get();
+        if (c < 0) return false;
+        out += (char)c;
+      }
+      return true;
+    }
+    bool send(const std::string& data) {
+      size_t sent = 0;
+      while (sent < data.size()) {
+        ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+      }
+      return true;
+    }
+    size_t consumed = 0;
+
+   private:
+    int get() {
+      if (pos_ == len_) {
+        ssize_t n = recv(fd_, buf_, sizeof(buf_), 0);
+        if (n <= 0) return -1;
+        len_ = n;
+        pos_ = 0;
+        if (bytesPerSec_) {
+          // The bytes arrive no sooner than the uplink could have carried them
+          auto now = std::chrono::steady_clock::now();
+          if (arrival_ < now) arrival_ = now;
+          arrival_ += std::chrono::microseconds((uint64_t)n * 1000000 / bytesPerSec_);
+          std::this_thread::sleep_until(arrival_);
+        }
+      }
+      consumed++;
+      return (uint8_t)buf_[pos_++];
+    }
+    int fd_;
+    uint32_t bytesPerSec_;
+    std::chrono::steady_clock::time_point arrival_;
+    char buf_[4096];
+    size_t pos_ = 0, len_ = 0;
+  };
+
+  static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  static bool startsWithNoCase(const std::string& s, const char* prefix) {
+    return strncasecmp(s.c_str(), prefix, strlen(prefix)) == 0;
+  }
+
+  static std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+      if (c == '"' || c == '\\') out += '\\';
+      out += c;
+    }
+    return out;
+  }
+
+  void acceptLoop() {
+    for (;;) {
+      int fd = accept(listenFd_, nullptr, nullptr);
+      if (fd < 0) continue;
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      std::thread([this, fd] {
+        serve(fd);
+        close(fd);
+      }).detach();
+    }
+  }
+
+  bool readRequest(Conn& conn, Request& req) {
+    conn.consumed = 0;
+    std::string line;
+    if (!conn.line(line)) return false;
+    size_t sp1 = line.find(' '), sp2 = line.find(' ', sp1 + 1);
+    if (sp1 == std::string::npos || sp2 == std::string::npos) return false;
+    req.method = line.substr(0, sp1);
+    req.target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+    req.body.clear();
+    req.close = false;
+    long length = 0;
+    bool chunked = false;
+    for (;;) {
+      if (!conn.line(line)) return false;
+      if (line.empty()) break;
+      if (startsWithNoCase(line, "Content-Length:")) length = atol(line.c_str() + 15);
+      if (startsWithNoCase(line, "Transfer-Encoding:") && line.find("chunked") != std::string::npos) chunked = true;
+      if (startsWithNoCase(line, "Connection:") && line.find("close") != std::string::npos) req.close = true;
+    }
+    if (chunked) {
+      for (;;) {
+        if (!conn.line(line)) return false;
+        long n = strtol(line.c_str(), nullptr, 16);
+        if (n <= 0) {
+          conn.line(line);   // Blank line after the last chunk
+          break;
+        }
+        if (!conn.bytes(req.body, n) || !conn.line(line)) return false;
+      }
+    } else if (length > 0 && !conn.bytes(req.body, length)) {
+      return false;
+    }
+    req.bytes = conn.consumed;
+    return true;
+  }
+
+  MockApi classify(const Request& req) const {
+    if (req.target.compare(0, 24, "/v1/audio/transcriptions") == 0) return MOCK_WHISPER;
+    if (req.target.compare(0, 20, "/v1/chat/completions") == 0) return MOCK_CHAT;
+    if (req.target.compare(0, 17, "/data/2.5/weather") == 0) return MOCK_WEATHER;
+    if (req.target.compare(0, 16, "/customsearch/v1") == 0) return MOCK_SEARCH;
+    if (req.target.compare(0, 14, "/translate_tts") == 0) return MOCK_TTS;
+    return MOCK_OTHER;
+  }
+
+  void serve(int fd) {
+    Conn conn(fd, latency.uplinkBytesPerSec);
+    Request req;
+    bool counted[MOCK_API_COUNT] = {};
+    while (readRequest(conn, req)) {
+      MockApi api = classify(req);
+      MockApiStats& s = stats[api];
+      if (!counted[api]) {
+        counted[api] = true;
+        s.connections++;
+      }
+      s.requests++;
+      s.bytesIn += req.bytes;
+      MockTurn turn;
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        turn = turn_;
+      }
+      bool ok;
+      switch (api) {
+        case MOCK_WHISPER:
+          delay(latency.whisperMs);
+          ok = respond(conn, s, 200, "application/json", "{\"text\":\"" + jsonEscape(turn.transcript) + "\"}", req.close);
+          break;
+        case MOCK_CHAT:
+          ok = answerChat(conn, s, req, turn);
+          break;
+        case MOCK_WEATHER:
+          delay(latency.toolMs);
+          ok = respond(conn, s, 200, "application/json; charset=utf-8", weather_, req.close);
+          break;
+        case MOCK_SEARCH:
+          delay(latency.toolMs);
+          ok = respond(conn, s, 200, "application/json; charset=UTF-8", search_, req.close);
+          break;
+        case MOCK_TTS:
+          delay(latency.ttsMs);
+          ok = respond(conn, s, 200, "audio/mpeg", std::string(ttsBytes(req.target), '\x55'), req.close);
+          break;
+        default:
+          ok = respond(conn, s, 404, "text/plain", "Not found", true);
+          break;
+      }
+      if (!ok || req.close) return;
+    }
+  }
+
+  // Length of the q= parameter, with %XX counted as one character
+  static size_t ttsBytes(const std::string& target) {
+    size_t q = target.find("&q=");
+    size_t chars = 0;
+    for (size_t i = q == std::string::npos ? target.size() : q + 3; i < target.size() && target[i] != '&'; i++) {
+      if (target[i] == '%') i += 2;
+      chars++;
+    }
+    return std::max<size_t>(chars, 1) * MOCK_TTS_BYTES_PER_CHAR;
+  }
+
+  bool respond(Conn& conn, MockApiStats& s, int code, const char* type, const std::string& body, bool close) {
+    std::string head = "HTTP/1.1 " + std::to_string(code) + (code == 200 ? " OK" : " Not Found") +
+                       "\r\nContent-Type: " + type + "\r\nContent-Length: " + std::to_string(body.size()) +
+                       (close ? "\r\nConnection: close" : "\r\nConnection: keep-alive") + "\r\n\r\n";
+    s.bytesOut += head.size() + body.size();
+    return conn.send(head) && conn.send(body);
+  }
+
+  // One SSE event per HTTP chunk, as the API sends them
+  bool sendEvent(Conn& conn, MockApiStats& s, const std::string& data) {
+    std::string event = "data: " + data + "\n\n";
+    char size[16];
+    snprintf(size, sizeof(size), "%zx\r\n", event.size());
+    std::string chunk = size + event + "\r\n";
+    s.bytesOut += chunk.size();
+    return conn.send(chunk);
+  }
+
+  static std::string delta(const std::string& d, const char* finish = "null") {
+    return "{\"id\":\"chatcmpl-mock\",\"object\":\"chat.completion.chunk\",\"model\":\"gpt-4o-mini\",\"choices\":[{\"index\":0,"
+           "\"delta\":" + d + ",\"finish_reason\":" + finish + "}]}";
+  }
+
+  // Words of the reply with their leading space, as the model streams tokens
+  static std::vector<std::string> tokens(const std::string& text) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start < text.size()) {
+      size_t end = text.find(' ', start + 1);
+      if (end == std::string::npos) end = text.size();
+      out.push_back(text.substr(start, end - start));
+      start = end;
+    }
+    return out;
+  }
+
+  bool answerChat(Conn& conn, MockApiStats& s, const Request& req, const MockTurn& turn) {
+    chat.lastBodyBytes = req.body.size();
+    // Role of the last message: the tools array follows the messages and has no "role"
+    size_t tools = req.body.find("],\"tools\":");
+    size_t role = req.body.rfind("\"role\":\"", tools);
+    bool afterTool = role != std::string::npos && req.body.compare(role + 8, 5, "tool\"") == 0;
+    if (afterTool) chat.toolResults++;
+    bool callTool = !turn.toolName.empty() && !afterTool;
+    std::string reply = turn.reply.empty() ? std::string("I'm not sure about that.") : turn.reply;
+    std::string callId = "call_mock" + std::to_string(chat.toolCalls.load());
+    if (callTool) chat.toolCalls++;
+
+    if (req.body.find("\"stream\":true") == std::string::npos) {
+      std::vector<std::string> words = tokens(reply);
+      delay(latency.chatFirstMs + latency.chatTokenMs * (callTool ? 4 : words.size()));
+      std::string message = callTool
+          ? "{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"id\":\"" + callId +
+                "\",\"type\":\"function\",\"function\":{\"name\":\"" + turn.toolName + "\",\"arguments\":\"" +
+                jsonEscape(turn.toolArgs) + "\"}}]}"
+          : "{\"role\":\"assistant\",\"content\":\"" + jsonEscape(reply) + "\"}";
+      return respond(conn, s, 200, "application/json",
+                     "{\"id\":\"chatcmpl-mock\",\"object\":\"chat.completion\",\"model\":\"gpt-4o-mini\",\"choices\":[{"
+                     "\"index\":0,\"message\":" + message + ",\"finish_reason\":\"" + (callTool ? "tool_calls" : "stop") +
+                     "\"}],\"usage\":{\"prompt_tokens\":" + std::to_string(req.body.size() / 4) +
+                     ",\"completion_tokens\":" + std::to_string(words.size()) + "}}",
+                     req.close);
+    }
+
+    chat.streamed++;
+    delay(latency.chatFirstMs);
+    std::string head = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream; charset=utf-8\r\n"
+                       "Transfer-Encoding: chunked\r\nConnection: keep-alive\r\n\r\n";
+    s.bytesOut += head.size();
+    bool ok = conn.send(head);
+    if (callTool) {
+      std::string args = jsonEscape(turn.toolArgs);
+      size_t half = args.size() / 2;
+      while (half > 0 && args[half - 1] == '\\') half--;   // Never split an escape
+      ok = ok &&
+           sendEvent(conn, s, delta("{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"index\":0,\"id\":\"" + callId +
+                                    "\",\"type\":\"function\",\"function\":{\"name\":\"" + turn.toolName +
+                                    "\",\"arguments\":\"\"}}]}")) &&
+           sendEvent(conn, s, delta("{\"tool_calls\":[{\"index\":0,\"function\":{\"arguments\":\"" + args.substr(0, half) + "\"}}]}")) &&
+           sendEvent(conn, s, delta("{\"tool_calls\":[{\"index\":0,\"function\":{\"arguments\":\"" + args.substr(half) + "\"}}]}")) &&
+           sendEvent(conn, s, delta("{}", "\"tool_calls\""));
+    } else {
+      ok = ok && sendEvent(conn, s, delta("{\"role\":\"assistant\",\"content\":\"\"}"));
+      for (const std::string& token : tokens(reply)) {
+        if (!ok) break;
+        delay(latency.chatTokenMs);
+        ok = sendEvent(conn, s, delta("{\"content\":\"" + jsonEscape(token) + "\"}"));
+      }
+      ok = ok && sendEvent(conn, s, delta("{}", "\"stop\""));
+    }
+    ok = ok && sendEvent(conn, s, "[DONE]");
+    s.bytesOut += 5;
+    return ok && conn.send("0\r\n\r\n");
+  }
+
+  int listenFd_ = -1;
+  uint16_t port_ = 0;
+  std::string weather_, search_;
+  std::mutex lock_;
+  MockTurn turn_;
+};
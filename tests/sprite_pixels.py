@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Writes the pixels of every sprite source in assets/sprites/sprites.txt for
+test_sprite_decoder, using only the image loaders of tools/sprite_compiler.py
+(not its encoder). Per sprite:
+
+  <name> <width> <frame height> <frames>\n
+  then width * height bytes per frame, one per pixel (0 or 1), row by row
+"""
+
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(ROOT, "tools"))
+import sprite_compiler  # noqa: E402
+
+
+def main(out_path):
+    base = os.path.dirname(sprite_compiler.MANIFEST)
+    with open(out_path, "wb") as out:
+        for line in open(sprite_compiler.MANIFEST):
+            line = line.split("#", 1)[0].split()
+            if not line:
+                continue
+            name, source = line[0], line[1]
+            path = os.path.join(base, source)
+            if source.lower().endswith(".gif"):
+                w, h, gif_frames = sprite_compiler.load_gif(path)
+                frames = [rows for rows, _ in gif_frames]
+            else:
+                w, h, rows = sprite_compiler.load_png(path)
+                fh = int(line[2]) if len(line) > 2 else h
+                frames = [rows[i:i + fh] for i in range(0, h, fh)]
+            out.write(("%s %d %d %d\n" % (name, w, len(frames[0]), len(frames))).encode())
+            for rows in frames:
+                out.write(bytes(v for row in rows for v in row))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1]))
@@ -0,0 +1,200 @@
+// AlarmScheduler: thousands of timers fire once each, in due order, and a tick stays O(1)
+#include "alarm_scheduler.h"
+#include "kiko_test.h"
+
+#include <random>
+
+static const uint32_t T0 = 1760000000;
+
+// 4000 alarms over ~230 days (some past the wheels, in the overflow list), every 7th
+// cancelled, one daily alarm; the clock moves in random steps with occasional jumps
+static void testFiringOrder() {
+  AlarmScheduler s;
+  s.begin(5000, T0);
+  std::mt19937 rng(1);
+  std::vector<bool> expected(5000, false);
+  for (int i = 0; i < 4000; i++) {
+    uint32_t due = T0 + 1 + rng() % (i < 3000 ? 200000 : 20000000);
+    char name[ALARM_NAME_LEN];
+    snprintf(name, sizeof(name), "a%d", i);
+    int id = s.add(name, due, 0);
+    CHECK(id >= 0);
+    expected[id] = true;
+  }
+  for (int id = 0; id < 4000; id += 7) {
+    CHECK(s.cancel(id));
+    expected[id] = false;
+  }
+  int daily = s.add("daily", T0 + 100, 86400);
+  CHECK(daily >= 0);
+  CHECK(s.find("daily") == daily);
+
+  std::vector<int> fires(5000, 0);
+  uint32_t last = 0, now = T0;
+  int outOfOrder = 0, late = 0, dailyFires = 0, dailyDrift = 0;
+  while (now < T0 + 21000000) {
+    uint32_t step = (rng() % 50 == 0) ? 3000 : 1 + rng() % 30;
+    if (rng() % 2000 == 0) step = 50000;                     // Beyond ALARM_WHEEL_MAX_CATCHUP: re-file
+    now += step;
+    s.advance(now, [&](const AlarmTimer& t) {
+      if (strcmp(t.name, "daily") == 0) {
+        dailyFires++;
+        if (t.due % 86400 != (T0 + 100) % 86400) dailyDrift++;
+        return;
+      }
+      if (t.due < last) outOfOrder++;
+      last = t.due;
+      if (t.due > now || now - t.due > step) late++;
+      fires[atoi(t.name + 1)]++;
+    });
+  }
+  int missing = 0, twice = 0;
+  for (int i = 0; i < 4000; i++) {   // Ids are handed out in order from an empty pool: a<i> is id i
+    if (expected[i] && fires[i] == 0) missing++;
+    if (fires[i] > 1 || (!expected[i] && fires[i] > 0)) twice++;
+  }
+  CHECK(outOfOrder == 0);
+  CHECK(late == 0);
+  CHECK(missing == 0);
+  CHECK(twice == 0);
+  CHECK(dailyDrift == 0);
+  CHECK(dailyFires >= 21000000 / 86400);
+  CHECK(s.count() == 1);                                     // Only the daily alarm is left
+  CHECK(s.stats().refiles > 0);
+}
+
+// An alarm rescheduled while pending moves instead of being duplicated (snooze of a
+// snoozed alarm), and one rescheduled from its own callback fires again later
+static void testReschedule() {
+  AlarmScheduler s;
+  s.begin(8, T0);
+  int id = s.add("tea", T0 + 60, 0);
+  CHECK(s.find("tea") == id);
+  CHECK(s.reschedule(s.find("tea"), T0 + 600));
+  CHECK(s.count() == 1);
+  int fired = 0;
+  s.advance(T0 + 599, [&](const AlarmTimer&) { fired++; });
+  CHECK(fired == 0);
+  s.advance(T0 + 600, [&](const AlarmTimer& t) { fired++; CHECK(t.due == T0 + 600); });
+  CHECK(fired == 1);
+  CHECK(s.count() == 0);
+
+  int again = s.add("nap", T0 + 700, 0);
+  fired = 0;
+  s.advance(T0 + 800, [&](const AlarmTimer&) {
+    if (fired++ == 0) s.reschedule(again, T0 + 1000);
+  });
+  CHECK(fired == 1);
+  CHECK(s.count() == 1);
+  s.advance(T0 + 1000, [&](const AlarmTimer&) { fired++; });
+  CHECK(fired == 2);
+  CHECK(s.count() == 0);
+}
+
+// Alarms added already due, and a clock jump past several of them, fire in due order
+static void testClockJump() {
+  AlarmScheduler s;
+  s.begin(10, 1000);
+  s.add("x", 2000, 0);
+  s.add("y", 100000, 0);
+  s.add("z", 500, 0);
+  String order;
+  s.advance(50000, [&](const AlarmTimer& t) { order += t.name; });
+  CHECK(order == "zx");
+  CHECK(s.count() == 1);
+  CHECK(s.add("w", 1, 0) >= 0);
+  s.advance(50000, [&](const AlarmTimer& t) { order += t.name; });
+  CHECK(order == "zxw");
+}
+
+// Several alarms added already due fire by due time, and in the order added when due at
+// the same second (two timers set while the pipeline was busy, a resumed missed alarm)
+static void testAlreadyDue() {
+  AlarmScheduler s;
+  s.begin(10, 1000);
+  s.add("first", 990, 0);
+  s.add("second", 995, 0);
+  s.add("third", 995, 0);
+  s.add("zero", 900, 0);
+  String order;
+  s.advance(1000, [&](const AlarmTimer& t) { order += String(t.name) + " "; });
+  CHECK(order == "zero first second third ");
+  CHECK(s.count() == 0);
+}
+
+// A wheel started on uptime and moved onto Unix time keeps each alarm's time left and
+// fires nothing on the move
+static void testRebase() {
+  AlarmScheduler s;
+  s.begin(8, 30);
+  int tea = s.add("tea", 330, 0);
+  int daily = s.add("daily", 90000, 86400);
+  int fired = 0;
+  s.advance(100, [&](const AlarmTimer&) { fired++; });
+  s.rebase(T0 - 100);
+  CHECK(fired == 0);
+  CHECK(s.now() == T0);
+  CHECK(s.get(tea)->due == T0 + 230);
+  CHECK(s.get(daily)->due == T0 + 89900);
+  s.advance(T0 + 229, [&](const AlarmTimer&) { fired++; });
+  CHECK(fired == 0);
+  s.advance(T0 + 230, [&](const AlarmTimer& t) { fired++; CHECK(strcmp(t.name, "tea") == 0); });
+  CHECK(fired == 1);
+  s.advance(T0 + 89900, [&](const AlarmTimer& t) { fired++; CHECK(t.due == T0 + 89900); });
+  CHECK(fired == 2);
+  CHECK(s.get(daily)->due == T0 + 89900 + 86400);
+}
+
+static void testCapacity() {
+  AlarmScheduler s;
+  s.begin(3, T0);
+  CHECK(s.add("a", T0 + 1, 0) >= 0);
+  CHECK(s.add("b", T0 + 2, 0) >= 0);
+  CHECK(s.add("c", T0 + 3, 0) >= 0);
+  CHECK(s.add("d", T0 + 4, 0) < 0);
+  CHECK(s.cancel(s.find("b")));
+  CHECK(s.add("d", T0 + 4, 0) >= 0);
+}
+
+// Cost of a tick with a full wheel, and of add/cancel/reschedule
+static void benchTick() {
+  const int N = 5000;
+  AlarmScheduler s;
+  s.begin(N, T0);
+  std::mt19937 rng(2);
+  for (int i = 0; i < N; i++) s.add("b", T0 + 86400 + rng() % (150 * 86400), 0);
+  const uint32_t seconds = 86400;   // A day of 1 s ticks with nothing due
+  BenchTimer idle;
+  for (uint32_t t = 1; t <= seconds; t++) s.advance(T0 + t, [](const AlarmTimer&) {});
+  bench("alarm.tick_idle_5000_timers", idle.us() * 1000.0 / seconds, "ns/tick");
+  bench("alarm.cascaded_per_day", s.stats().cascaded, "alarms");
+
+  int fired = 0;
+  BenchTimer busy;
+  uint32_t start = s.now();
+  for (uint32_t t = start + 1; t <= start + 150 * 86400u; t += 60) {
+    fired += s.advance(t, [](const AlarmTimer&) {});
+  }
+  double busyUs = busy.us();
+  CHECK(fired == N);
+  bench("alarm.run_150_days_per_alarm_fired", busyUs * 1000.0 / N, "ns");
+
+  s.begin(N, T0);
+  BenchTimer ops;
+  for (int i = 0; i < N; i++) s.add("b", T0 + 1 + rng() % 10000000, 0);
+  for (int i = 0; i < N; i++) s.reschedule(i, T0 + 1 + rng() % 10000000);
+  for (int i = 0; i < N; i++) s.cancel(i);
+  bench("alarm.add_reschedule_cancel", ops.us() * 1000.0 / (3 * N), "ns/op");
+  CHECK(s.count() == 0);
+}
+
+int main() {
+  testFiringOrder();
+  testReschedule();
+  testClockJump();
+  testAlreadyDue();
+  testRebase();
+  testCapacity();
+  benchTick();
+  return testResult("alarm_scheduler");
+}
@@ -0,0 +1,357 @@
+// API responses off the socket: the captured-shape bodies in tests/fixtures/api served with
+// Content-Length, chunked (several chunk sizes) and close-delimited framing, in TCP-sized
+// segments, through readHttpResponseHead() and HttpBodyReader. Checks every framing yields the
+// body byte for byte and leaves a kept-alive socket at the next response, then compares the
+// heap and time of the old path (whole body copied into a String) with reading it in place.
+//
+// Built with ArduinoJson (ARDUINOJSON_INCLUDE_DIR), it also parses every fixture through
+// ApiJsonResponse with the filters Kiko.ino uses, checks the fields the sketch reads, and
+// reports peak document size, heap high-water mark and parse time next to an unfiltered
+// parse of the buffered String.
+//
+// Usage: test_api_response <fixtures/api directory>
+#include "api_connection.h"
+#include "kiko_test.h"
+#if KIKO_HAVE_ARDUINOJSON
+#include "api_response.h"
+#endif
+
+#include <string>
+#include <vector>
+
+enum Framing { FRAMING_LENGTH, FRAMING_CHUNKED, FRAMING_CLOSE };
+static const char* const FRAMING_NAMES[] = {"length", "chunked", "close"};
+
+// A socket with a canned response on it, delivered segmentBytes at a time as TCP would.
+// A close-delimited response ends with the peer closing; otherwise the socket stays open.
+class FixtureClient : public Client {
+ public:
+  FixtureClient(const std::string& bytes, size_t segmentBytes, bool closes)
+      : data_(bytes), segment_(segmentBytes), closes_(closes) {}
+
+  int connect(const char*, uint16_t) override { return 1; }
+  size_t write(uint8_t) override { return 1; }
+  int available() override {
+    size_t left = data_.size() - pos_;
+    return (int)std::min(left, segment_ - pos_ % segment_);
+  }
+  int read() override { return pos_ < data_.size() ? (uint8_t)data_[pos_++] : -1; }
+  uint8_t connected() override { return pos_ < data_.size() || !closes_; }
+  void stop() override { pos_ = data_.size(); }
+
+  size_t position() const { return pos_; }
+
+ private:
+  std::string data_;
+  size_t segment_;
+  bool closes_;
+  size_t pos_ = 0;
+};
+
+static std::string httpResponse(const std::string& body, Framing framing, size_t chunkBytes) {
+  std::string out = framing == FRAMING_CLOSE ? "HTTP/1.0 200 OK\r\n" : "HTTP/1.1 200 OK\r\n";
+  out += "Content-Type: application/json; charset=utf-8\r\n";
+  if (framing == FRAMING_LENGTH) out += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  if (framing == FRAMING_CHUNKED) out += "Transfer-Encoding: chunked\r\n";
+  out += framing == FRAMING_CLOSE ? "Connection: close\r\n\r\n" : "\r\n";
+  if (framing != FRAMING_CHUNKED) return out + body;
+  char size[16];
+  for (size_t i = 0; i < body.size(); i += chunkBytes) {
+    size_t n = std::min(chunkBytes, body.size() - i);
+    snprintf(size, sizeof(size), "%zx\r\n", n);
+    out += size + body.substr(i, n) + "\r\n";
+  }
+  return out + "0\r\n\r\n";
+}
+
+struct Fixture {
+  const char* name;
+  std::string body;
+};
+
+static const char* const FIXTURE_NAMES[] = {"chat", "chat_tool_calls", "chat_error", "whisper", "weather", "search"};
+
+static std::vector<Fixture> loadFixtures(const std::string& dir) {
+  std::vector<Fixture> out;
+  for (const char* name : FIXTURE_NAMES) {
+    FILE* f = fopen((dir + "/" + name + ".json").c_str(), "rb");
+    if (!f) continue;
+    Fixture x{name, ""};
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) x.body.append(buf, n);
+    fclose(f);
+    out.push_back(x);
+  }
+  return out;
+}
+
+// Every framing, chunk size and segment size gives back the body exactly, reports it
+// complete, and leaves a kept-alive socket at the start of the next response
+static void testFraming(const std::vector<Fixture>& fixtures) {
+  const size_t segments[] = {1, 7, 536, 1460};
+  const size_t chunks[] = {1, 13, 256, 4096};
+  for (const Fixture& fx : fixtures) {
+    for (int framing = FRAMING_LENGTH; framing <= FRAMING_CLOSE; framing++) {
+      for (size_t chunk : chunks) {
+        if (framing != FRAMING_CHUNKED && chunk != chunks[0]) continue;
+        std::string first = httpResponse(fx.body, (Framing)framing, chunk);
+        std::string next = framing == FRAMING_CLOSE ? "" : "HTTP/1.1 204 No Content\r\n\r\n";
+        for (size_t segment : segments) {
+          FixtureClient client(first + next, segment, framing == FRAMING_CLOSE);
+          HttpResponseHead head;
+          CHECK(readHttpResponseHead(client, head, 1000));
+          CHECK(head.status == 200 && head.chunked == (framing == FRAMING_CHUNKED));
+          CHECK(head.keepAlive == (framing != FRAMING_CLOSE));
+          HttpBodyReader body(client, head);
+          std::string got;
+          int ch;
+          while ((ch = body.read(millis() + 1000)) >= 0) got += (char)ch;
+          bool ok = got == fx.body && body.complete() && client.position() == first.size();
+          if (!ok) printf("  %s %s chunk %zu segment %zu: body differs\n", fx.name, FRAMING_NAMES[framing], chunk, segment);
+          CHECK(ok);
+          if (framing != FRAMING_CLOSE) {
+            HttpResponseHead second;
+            CHECK(readHttpResponseHead(client, second, 1000) && second.status == 204);
+          }
+        }
+      }
+    }
+  }
+}
+
+// A body cut short is never reported complete, so the socket is not reused
+static void testTruncated(const std::vector<Fixture>& fixtures) {
+  const Fixture& fx = fixtures[0];
+  for (int framing = FRAMING_LENGTH; framing <= FRAMING_CHUNKED; framing++) {
+    std::string full = httpResponse(fx.body, (Framing)framing, 256);
+    for (size_t cut : {full.size() - 1, full.size() - 5, full.size() - fx.body.size() / 2}) {
+      FixtureClient client(full.substr(0, cut), 1460, true);
+      HttpResponseHead head;
+      CHECK(readHttpResponseHead(client, head, 1000));
+      HttpBodyReader body(client, head);
+      while (body.read(millis() + 1000) >= 0) {}
+      CHECK(!body.complete());
+    }
+  }
+}
+
+// A chunk-size line without a hex digit fails the body instead of being read as the last
+// chunk (which could leave a kept-alive socket mid-response); extensions are still accepted
+static void testChunkSize() {
+  const std::string head = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+  const char* const bad[] = {"\r\n", "zz\r\n", "-5\r\n", ";ext\r\n", " 5\r\n", "5x\r\n"};
+  for (const char* size : bad) {
+    FixtureClient client(head + "5\r\nhello\r\n" + size + "hello\r\n0\r\n\r\n", 1460, false);
+    HttpResponseHead h;
+    CHECK(readHttpResponseHead(client, h, 1000));
+    HttpBodyReader body(client, h);
+    std::string got;
+    int ch;
+    while ((ch = body.read(millis() + 1000)) >= 0) got += (char)ch;
+    CHECK(got == "hello");
+    CHECK(!body.complete());
+  }
+  FixtureClient client(head + "5;name=value\r\nhello\r\n0 \r\n\r\n", 1460, false);
+  HttpResponseHead h;
+  CHECK(readHttpResponseHead(client, h, 1000));
+  String out;
+  CHECK(readHttpResponseBody(client, h, out, 1000) && out == "hello");
+}
+
+// Heap high-water mark of fn above what was live when it started
+template <typename Fn>
+static size_t heapPeakOf(Fn fn) {
+  size_t base = hostHeapLive();
+  hostHeapResetPeak();
+  fn();
+  return hostHeapPeak() - base;
+}
+
+// The old path copied the body into a String before parsing; reading in place holds none of it
+static void benchTransport(const std::vector<Fixture>& fixtures) {
+  const int rounds = 2000;
+  for (const Fixture& fx : fixtures) {
+    std::string wire = httpResponse(fx.body, FRAMING_CHUNKED, 256);
+    std::string name = std::string("api.") + fx.name;
+    size_t bufferedPeak = 0, streamingPeak = 0;
+    double bufferedUs = 0, streamingUs = 0;
+    for (int r = 0; r < rounds; r++) {
+      FixtureClient a(wire, 1460, false), b(wire, 1460, false);
+      HttpResponseHead ha, hb;
+      readHttpResponseHead(a, ha, 1000);
+      readHttpResponseHead(b, hb, 1000);
+
+      String copy;
+      BenchTimer t1;
+      bufferedPeak = std::max(bufferedPeak, heapPeakOf([&] { readHttpResponseBody(a, ha, copy, 1000); }));
+      bufferedUs += t1.us();
+      CHECK(copy.length() == fx.body.size());
+
+      HttpBodyReader body(b, hb);
+      size_t bytes = 0;
+      BenchTimer t2;
+      streamingPeak = std::max(streamingPeak, heapPeakOf([&] {
+        unsigned long deadline = millis() + 1000;
+        while (body.read(deadline) >= 0) bytes++;
+      }));
+      streamingUs += t2.us();
+      CHECK(bytes == fx.body.size() && body.complete());
+    }
+    bench((name + ".body").c_str(), fx.body.size(), "bytes");
+    bench((name + ".wire_chunked").c_str(), wire.size(), "bytes");
+    bench((name + ".heap_buffered_body").c_str(), bufferedPeak, "bytes");
+    bench((name + ".heap_streamed_body").c_str(), streamingPeak, "bytes");
+    bench((name + ".read_buffered").c_str(), bufferedUs / rounds, "us");
+    bench((name + ".read_streamed").c_str(), streamingUs / rounds, "us");
+  }
+}
+
+#if KIKO_HAVE_ARDUINOJSON
+
+// The filters of chatWithGpt(), transcribeWithWhisper(), fetchWeather() and fetchGoogleSearch()
+static void kikoFilter(const char* fixture, JsonDocument& filter) {
+  if (strncmp(fixture, "chat", 4) == 0) {
+    filter["choices"][0]["message"]["role"] = true;
+    filter["choices"][0]["message"]["content"] = true;
+    filter["choices"][0]["message"]["tool_calls"] = true;
+    filter["error"]["message"] = true;
+  } else if (strcmp(fixture, "whisper") == 0) {
+    filter["text"] = true;
+    filter["error"]["message"] = true;
+  } else if (strcmp(fixture, "weather") == 0) {
+    filter["weather"][0]["description"] = true;
+    filter["main"]["temp"] = true;
+    filter["name"] = true;
+  } else {
+    filter["items"][0]["snippet"] = true;
+  }
+}
+
+// What the sketch reads from each reply
+static bool fieldsAsKikoReadsThem(const char* fixture, JsonDocument& doc) {
+  if (strcmp(fixture, "chat") == 0) {
+    const char* content = doc["choices"][0]["message"]["content"];
+    return content && strncmp(content, "Sure! A group of flamingos", 26) == 0 && doc["usage"].isNull();
+  }
+  if (strcmp(fixture, "chat_tool_calls") == 0) {
+    JsonArray calls = doc["choices"][0]["message"]["tool_calls"];
+    return calls.size() == 2 && strcmp(calls[0]["function"]["name"] | "", "get_weather") == 0 &&
+           strcmp(calls[1]["function"]["arguments"] | "", "{\"list\":\"groceries\",\"item\":\"umbrella\",\"quantity\":1}") == 0 &&
+           strcmp(calls[1]["id"] | "", "call_3Fj9QwEt6YuIo2Pa5SdGh8Jk") == 0;
+  }
+  if (strcmp(fixture, "chat_error") == 0) {
+    const char* message = doc["error"]["message"];
+    return message && strncmp(message, "Rate limit reached", 18) == 0 && doc["error"]["code"].isNull();
+  }
+  if (strcmp(fixture, "whisper") == 0) {
+    return strcmp(doc["text"] | "", "Hey Kiko, what's the weather like in Lisbon today, and should I bring an umbrella?") == 0;
+  }
+  if (strcmp(fixture, "weather") == 0) {
+    float temp = doc["main"]["temp"];
+    return strcmp(doc["weather"][0]["description"] | "", "light rain") == 0 && fabs(temp - 14.62f) < 0.001f &&
+           strcmp(doc["name"] | "", "Lisbon") == 0 && doc["main"]["humidity"].isNull();
+  }
+  const char* snippet = doc["items"][0]["snippet"];
+  return snippet && strncmp(snippet, "The tower is 330 metres", 23) == 0 && doc["items"][0]["pagemap"].isNull();
+}
+
+static void testFilteredParse(const std::vector<Fixture>& fixtures) {
+  for (const Fixture& fx : fixtures) {
+    for (int framing = FRAMING_LENGTH; framing <= FRAMING_CLOSE; framing++) {
+      FixtureClient client(httpResponse(fx.body, (Framing)framing, 256), 536, framing == FRAMING_CLOSE);
+      HttpResponseHead head;
+      CHECK(readHttpResponseHead(client, head, 1000));
+      HttpBodyReader body(client, head);
+      JsonDocument filter;
+      kikoFilter(fx.name, filter);
+      ApiParseStats stats;
+      ApiJsonResponse reply(stats);
+      bool ok = reply.parse(body, filter, 1000) && body.complete() && fieldsAsKikoReadsThem(fx.name, reply.doc());
+      if (!ok) printf("  %s %s: %s\n", fx.name, FRAMING_NAMES[framing], reply.error().c_str());
+      CHECK(ok);
+      CHECK(stats.responses == 1 && stats.failures == 0 && stats.bodyBytes == fx.body.size());
+    }
+  }
+
+  // Invalid JSON and a body cut short both count as failures
+  ApiParseStats stats;
+  for (const char* bad : {"{\"text\": \"unterminated", "<html>502 Bad Gateway</html>"}) {
+    FixtureClient client(httpResponse(bad, FRAMING_LENGTH, 0), 1460, false);
+    HttpResponseHead head;
+    readHttpResponseHead(client, head, 1000);
+    HttpBodyReader body(client, head);
+    JsonDocument filter;
+    kikoFilter("whisper", filter);
+    ApiJsonResponse reply(stats);
+    CHECK(!reply.parse(body, filter, 1000));
+  }
+  CHECK(stats.responses == 2 && stats.failures == 2);
+}
+
+// ApiJsonResponse on the socket against the old path: the body into a String, then an
+// unfiltered deserializeJson() of it
+static void benchParse(const std::vector<Fixture>& fixtures) {
+  const int rounds = 1000;
+  for (const Fixture& fx : fixtures) {
+    std::string wire = httpResponse(fx.body, FRAMING_CHUNKED, 256);
+    std::string name = std::string("api.") + fx.name;
+    JsonDocument filter;
+    kikoFilter(fx.name, filter);
+    ApiParseStats stats;
+    size_t streamedPeak = 0, bufferedPeak = 0, bufferedDoc = 0;
+    double streamedUs = 0, bufferedUs = 0;
+    for (int r = 0; r < rounds; r++) {
+      FixtureClient a(wire, 1460, false), b(wire, 1460, false);
+      HttpResponseHead ha, hb;
+      readHttpResponseHead(a, ha, 1000);
+      readHttpResponseHead(b, hb, 1000);
+
+      BenchTimer t1;
+      streamedPeak = std::max(streamedPeak, heapPeakOf([&] {
+        HttpBodyReader body(a, ha);
+        ApiJsonResponse reply(stats);
+        reply.parse(body, filter, 1000);
+      }));
+      streamedUs += t1.us();
+
+      BenchTimer t2;
+      bufferedPeak = std::max(bufferedPeak, heapPeakOf([&] {
+        String payload;
+        readHttpResponseBody(b, hb, payload, 1000);
+        PeakTrackingAllocator alloc;
+        JsonDocument doc(&alloc);
+        deserializeJson(doc, payload.c_str(), payload.length());
+        bufferedDoc = std::max(bufferedDoc, alloc.peak());
+      }));
+      bufferedUs += t2.us();
+    }
+    CHECK(stats.failures == 0);
+    CHECK(streamedPeak < bufferedPeak);
+    bench((name + ".doc_peak_filtered").c_str(), stats.peakDocBytes, "bytes");
+    bench((name + ".doc_peak_unfiltered").c_str(), bufferedDoc, "bytes");
+    bench((name + ".heap_peak_streamed_parse").c_str(), streamedPeak, "bytes");
+    bench((name + ".heap_peak_buffered_parse").c_str(), bufferedPeak, "bytes");
+    bench((name + ".parse_streamed").c_str(), streamedUs / rounds, "us");
+    bench((name + ".parse_buffered").c_str(), bufferedUs / rounds, "us");
+  }
+}
+
+#endif
+
+int main(int argc, char** argv) {
+  std::vector<Fixture> fixtures = loadFixtures(argc > 1 ? argv[1] : "fixtures/api");
+  CHECK(fixtures.size() == sizeof(FIXTURE_NAMES) / sizeof(FIXTURE_NAMES[0]));
+  if (fixtures.empty()) return testResult("api_response");
+  testFraming(fixtures);
+  testTruncated(fixtures);
+  testChunkSize();
+  benchTransport(fixtures);
+#if KIKO_HAVE_ARDUINOJSON
+  testFilteredParse(fixtures);
+  benchParse(fixtures);
+#else
+  printf("ArduinoJson not found: document parse not measured (set ARDUINOJSON_INCLUDE_DIR)\n");
+#endif
+  return testResult("api_response");
+}
@@ -0,0 +1,153 @@
+// AudioRing stress test: a producer paced like the I2S capture task, and a consumer
+// that stalls on purpose. Every sample must arrive once and in order; the only gaps
+// allowed are the overruns the ring counted.
+#include "audio_ring.h"
+#include "kiko_test.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define CHUNK 256                 // MIC_CHUNK_SAMPLES
+#define RING_SAMPLES (8000 * 2)   // MIC_RING_SAMPLES
+#define SPEEDUP 8                 // 32 ms chunks arrive every 4 ms: the ring holds 256 ms
+
+struct StressResult {
+  uint32_t produced = 0;
+  uint32_t received = 0;
+  uint32_t gapSamples = 0;        // Samples missing from the received sequence
+  uint32_t outOfOrder = 0;
+  uint32_t overruns = 0;
+  uint32_t dropped = 0;
+  size_t peakFill = 0;
+};
+
+// Runs for chunks chunks; the consumer sleeps stallMs once, after a quarter of the run
+static StressResult stress(int chunks, int stallMs) {
+  AudioRing ring;
+  CHECK(ring.begin(RING_SAMPLES));
+  CHECK(ring.capacity() == 16384);
+  std::atomic<bool> done{false};
+  StressResult r;
+
+  std::thread producer([&] {
+    int16_t chunk[CHUNK];
+    uint16_t next = 0;
+    auto due = std::chrono::steady_clock::now();
+    for (int k = 0; k < chunks; k++) {
+      for (int i = 0; i < CHUNK; i++) chunk[i] = (int16_t)next++;
+      ring.write(chunk, CHUNK);        // Like the capture task, never blocks
+      r.produced += CHUNK;
+      due += std::chrono::microseconds(32000 / SPEEDUP);
+      std::this_thread::sleep_until(due);
+    }
+    done = true;
+  });
+
+  int16_t buf[CHUNK];
+  uint16_t expect = 0;
+  bool stalled = false;
+  for (;;) {
+    if (!stalled && r.received >= (uint32_t)chunks * CHUNK / 4) {
+      stalled = true;
+      delay(stallMs);
+    }
+    size_t n = ring.read(buf, CHUNK);
+    for (size_t i = 0; i < n; i++) {
+      uint16_t v = (uint16_t)buf[i];
+      if (v != expect) {
+        uint16_t gap = v - expect;     // Samples skipped; a "negative" gap is reordering
+        if (gap > 0x8000) r.outOfOrder++;
+        else r.gapSamples += gap;
+      }
+      expect = v + 1;
+    }
+    r.received += n;
+    if (n == 0) {
+      if (done && ring.available() == 0) break;
+      delay(1);
+    }
+  }
+  producer.join();
+  r.overruns = ring.overruns();
+  r.dropped = ring.droppedSamples();
+  r.peakFill = ring.peakFill();
+  return r;
+}
+
+static void testStallWithinCapacity() {
+  StressResult r = stress(400, 150);   // 150 ms stall against 256 ms of ring
+  CHECK(r.outOfOrder == 0);
+  CHECK(r.dropped == 0);
+  CHECK(r.gapSamples == 0);
+  CHECK(r.received == r.produced);
+  CHECK(r.peakFill >= 150 * 8 * SPEEDUP / 2);   // The stall really backed the ring up
+  bench("audio_ring.stall150ms_peak_fill", r.peakFill, "samples");
+}
+
+static void testStallBeyondCapacity() {
+  StressResult r = stress(400, 600);   // Overflows: the newest samples are dropped and counted
+  CHECK(r.outOfOrder == 0);
+  CHECK(r.overruns > 0);
+  CHECK(r.dropped > 0);
+  CHECK(r.gapSamples == r.dropped);
+  CHECK(r.received + r.dropped == r.produced);
+  CHECK(r.peakFill == 16384);
+  bench("audio_ring.stall600ms_dropped", r.dropped, "samples");
+  bench("audio_ring.stall600ms_overruns", r.overruns, "writes");
+}
+
+// Wrap-around of the free-running counters and of the storage, without threads
+static void testWrap() {
+  AudioRing ring;
+  CHECK(ring.begin(1000));
+  CHECK(ring.capacity() == 1024);
+  int16_t in[700], out[700];
+  uint16_t next = 0, expect = 0;
+  for (int round = 0; round < 1000; round++) {
+    for (int i = 0; i < 700; i++) in[i] = (int16_t)next++;
+    CHECK(ring.write(in, 700) == 700);
+    CHECK(ring.read(out, 700) == 700);
+    for (int i = 0; i < 700; i++) CHECK((uint16_t)out[i] == expect++);
+  }
+  CHECK(ring.write(in, 700) == 700);
+  CHECK(ring.write(in, 700) == 324);
+  CHECK(ring.droppedSamples() == 376);
+  ring.discard();
+  CHECK(ring.available() == 0);
+}
+
+// Raw SPSC throughput, one producer and one consumer thread, 256-sample chunks
+static void benchThroughput() {
+  AudioRing ring;
+  ring.begin(RING_SAMPLES);
+  const uint32_t total = 50000000;
+  std::thread producer([&] {
+    int16_t chunk[CHUNK] = {};
+    uint32_t sent = 0;
+    while (sent < total) {
+      size_t n = ring.write(chunk, CHUNK);
+      sent += n;
+      if (n < CHUNK) std::this_thread::yield();
+    }
+  });
+  BenchTimer t;
+  int16_t buf[CHUNK];
+  uint32_t got = 0;
+  while (got < total) {
+    size_t n = ring.read(buf, CHUNK);
+    if (n == 0) std::this_thread::yield();
+    got += n;
+  }
+  double us = t.us();
+  producer.join();
+  bench("audio_ring.spsc_throughput", total / us, "Msamples/s");
+}
+
+int main() {
+  testWrap();
+  testStallWithinCapacity();
+  testStallBeyondCapacity();
+  benchThroughput();
+  return testResult("audio_ring");
+}
@@ -0,0 +1,282 @@
+// Chat request serialization, old and new. The old path is rebuilt here as chatWithGpt() had
+// it: every tool definition built into a StaticJsonDocument<8192> with createNestedObject(),
+// stored tool-call turns re-parsed, and the whole body serialized into a String before it was
+// sent. The new path is Kiko.ino's own: writeChatRequestBody() into a CountingPrint for
+// Content-Length, then again through BufferedClientPrint onto the socket. Checks both bodies
+// are byte for byte the same for each request, then reports per request the heap high-water
+// mark, allocations and serialize time (body onto a socket) of each path.
+//
+// On the device the old document was also 8 KB of task stack (ArduinoJson 6); ArduinoJson 7,
+// and the stand-in in host/json, keep it on the heap, where it is counted here.
+//
+// Usage: test_chat_request
+#include "Kiko.ino"
+#include "kiko_test.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CHAT_REQUEST_ITERATIONS 300
+
+// ---------- Old path ----------
+
+// A history entry as the old sketch kept it (std::vector<ChatMessage> chatHistory)
+struct OldChatMessage {
+  String role;
+  String content;
+  String tool_call_id;
+};
+
+static JsonObject oldTool(JsonArray tools, const char* name, const char* description, bool withParams = true) {
+  JsonObject tool = tools.createNestedObject();
+  tool["type"] = "function";
+  JsonObject func = tool.createNestedObject("function");
+  func["name"] = name;
+  func["description"] = description;
+  if (!withParams) return JsonObject();
+  JsonObject params = func.createNestedObject("parameters");
+  params["type"] = "object";
+  params.createNestedObject("properties");
+  return params;
+}
+
+static void oldProp(JsonObject params, const char* name, const char* type, const char* description) {
+  params["properties"][name]["type"] = type;
+  params["properties"][name]["description"] = description;
+}
+
+// The tool array as the old chatWithGpt() built it, with today's definitions
+static void oldToolDefinitions(JsonArray tools) {
+  JsonObject p = oldTool(tools, "get_weather", "Gets the current weather for a specific city.");
+  oldProp(p, "city", "string", "The city, e.g., 'San Francisco'");
+  p["required"][0] = "city";
+
+  oldTool(tools, "get_network_info", "Gets the device's local network information including WiFi SSID, IP address, and signal strength. This is safe to share as it's the user's own device's information.");
+
+  p = oldTool(tools, "google_search", "Searches Google for real-time information, news, definitions, or facts not in your knowledge base.");
+  oldProp(p, "query", "string", "The search query, e.g., 'latest news on Mars rover'");
+  p["required"][0] = "query";
+
+  p = oldTool(tools, "set_alarm_relative", "Sets an alarm (timer) to go off after a specified duration, e.g., 'in 5 minutes' or 'for 30 seconds'. Several alarms can be set at once.");
+  oldProp(p, "delay_seconds", "number", "The number of seconds from now to set the alarm for.");
+  oldProp(p, "label", "string", "Optional short name for the alarm, e.g., 'pasta'.");
+  p["required"][0] = "delay_seconds";
+
+  p = oldTool(tools, "set_alarm_absolute", "Sets an alarm for a specific time of day, e.g., 'at 2:30 PM' or 'every day at 7 AM'. Several alarms can be set at once.");
+  oldProp(p, "hour", "number", "The target hour, in 1-12 format.");
+  oldProp(p, "minute", "number", "The target minute (0-59).");
+  oldProp(p, "period", "string", "The period of day, either 'AM' or 'PM'.");
+  oldProp(p, "label", "string", "Optional short name for the alarm, e.g., 'wake up'.");
+  p["properties"]["repeat"]["type"] = "string";
+  p["properties"]["repeat"]["enum"][0] = "once";
+  p["properties"]["repeat"]["enum"][1] = "daily";
+  p["properties"]["repeat"]["enum"][2] = "weekly";
+  p["properties"]["repeat"]["description"] = "How often the alarm repeats. Defaults to 'once'.";
+  p["required"][0] = "hour";
+  p["required"][1] = "minute";
+  p["required"][2] = "period";
+
+  oldTool(tools, "get_alarm_status", "Checks which alarms are set and when the next one is scheduled to ring.", false);
+
+  p = oldTool(tools, "cancel_alarm", "Cancels the alarm with the given label, or every alarm if no label is given.");
+  oldProp(p, "label", "string", "The name of the alarm to cancel, e.g., 'pasta'.");
+
+  p = oldTool(tools, "snooze_alarm", "Snoozes the alarm that is ringing or just rang, so it rings again later.");
+  oldProp(p, "minutes", "number", "Minutes until it rings again. Defaults to 9.");
+
+  p = oldTool(tools, "add_todo_item", "Adds an item to a to-do list. If the item already exists, its quantity is increased.");
+  oldProp(p, "list_name", "string", "The name of the list, e.g., 'groceries', 'work'.");
+  oldProp(p, "item", "string", "The name of the item. If units are given (e.g., kg, litres), include them in the name. e.g., 'apples', 'rice (kg)', 'milk (litres)'.");
+  oldProp(p, "quantity", "number", "The quantity for the item. Must be extracted from the user's request (e.g., '1' for '1 kg rice', '3' for '3 apples'). Defaults to 1 if not specified.");
+  p["required"][0] = "list_name";
+  p["required"][1] = "item";
+
+  p = oldTool(tools, "remove_todo_item", "Removes an item from a to-do list. If quantity is provided, it subtracts that amount. If no quantity is provided, it removes the item entirely.");
+  oldProp(p, "list_name", "string", "The name of the list, e.g., 'groceries'.");
+  oldProp(p, "item", "string", "The name of the item to remove. Must match the stored name, e.g., 'apples', 'rice (kg)'.");
+  oldProp(p, "quantity", "number", "The quantity to remove. If not specified, all items of this type are removed.");
+  p["required"][0] = "list_name";
+  p["required"][1] = "item";
+
+  p = oldTool(tools, "list_todo_items", "Gets all items and their quantities from a specific to-do list. If no list_name is given, it lists all available to-do lists.");
+  oldProp(p, "list_name", "string", "The name of the list to read, e.g., 'groceries'.");
+
+  p = oldTool(tools, "clear_todo_list", "Removes all items from a specific to-do list, deleting the list.");
+  oldProp(p, "list_name", "string", "The name of the list to clear, e.g., 'groceries'.");
+  p["required"][0] = "list_name";
+}
+
+static String oldRequestBody(const std::vector<OldChatMessage>& history, const String& timeContext) {
+  StaticJsonDocument<8192> doc;
+  doc["model"] = "gpt-4o-mini";
+  doc["max_tokens"] = 150;
+  JsonArray messages = doc.createNestedArray("messages");
+  String systemPrompt = FPSTR(GPT_SYSTEM_PROMPT);
+  systemPrompt += timeContext;
+  JsonObject systemMessage = messages.createNestedObject();
+  systemMessage["role"] = "system";
+  systemMessage["content"] = systemPrompt;
+
+  for (const auto& msg : history) {
+    JsonObject message = messages.createNestedObject();
+    message["role"] = msg.role;
+    if (msg.role == "assistant") {
+      JsonDocument assistantMsgDoc;
+      if (deserializeJson(assistantMsgDoc, msg.content) == DeserializationError::Ok && assistantMsgDoc.containsKey("tool_calls")) {
+        message.set(assistantMsgDoc.as<JsonObject>());
+      } else {
+        message["content"] = msg.content;
+      }
+    } else if (msg.role == "tool") {
+      message["content"] = msg.content;
+      message["tool_call_id"] = msg.tool_call_id;
+    } else {
+      message["content"] = msg.content;
+    }
+  }
+  oldToolDefinitions(doc.createNestedArray("tools"));
+
+  String requestBody;
+  serializeJson(doc, requestBody);
+  return requestBody;
+}
+
+// ---------- Socket ----------
+
+// The request goes onto a real socket, drained on the other end, as it would be sent
+class DrainedSocket {
+ public:
+  DrainedSocket() {
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds_);
+    drainer_ = std::thread([this] {
+      char buf[16384];
+      ssize_t n;
+      while ((n = recv(fds_[1], buf, sizeof(buf), 0)) > 0) received += n;
+    });
+    client = WiFiClient(fds_[0]);
+  }
+  ~DrainedSocket() {
+    client.stop();
+    shutdown(fds_[0], SHUT_RDWR);
+    drainer_.join();
+    close(fds_[1]);
+  }
+
+  WiFiClient client;
+  std::atomic<uint64_t> received{0};
+
+ private:
+  int fds_[2] = {-1, -1};
+  std::thread drainer_;
+};
+
+// Captures a body as the socket would see it
+class StringPrint : public Print {
+ public:
+  std::string out;
+  size_t write(uint8_t b) override { out += (char)b; return 1; }
+  size_t write(const uint8_t* data, size_t size) override { out.append((const char*)data, size); return size; }
+};
+
+// ---------- Requests ----------
+
+struct RequestCase {
+  const char* name;
+  std::vector<std::pair<ChatRole, std::pair<const char*, const char*>>> history;   // role, content, tool_call_id
+};
+
+static const RequestCase CASES[] = {
+    {"first_turn", {{CHAT_ROLE_USER, {"What's the weather like in Lisbon today?", ""}}}},
+    {"tool_followup",
+     {{CHAT_ROLE_USER, {"What's the weather like in Lisbon today?", ""}},
+      {CHAT_ROLE_ASSISTANT, {"{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"id\":\"call_w1\",\"type\":\"function\",\"function\":{\"name\":\"get_weather\",\"arguments\":\"{\\\"city\\\":\\\"Lisbon\\\"}\"}}]}", ""}},
+      {CHAT_ROLE_TOOL, {"The weather in Lisbon is 21.4°C with clear sky. Humidity is 58%.", "call_w1"}}}},
+    {"conversation",
+     {{CHAT_ROLE_USER, {"Add two litres of milk to the groceries list.", ""}},
+      {CHAT_ROLE_ASSISTANT, {"{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"id\":\"call_t1\",\"type\":\"function\",\"function\":{\"name\":\"add_todo_item\",\"arguments\":\"{\\\"list_name\\\":\\\"groceries\\\",\\\"item\\\":\\\"milk (litres)\\\",\\\"quantity\\\":2}\"}}]}", ""}},
+      {CHAT_ROLE_TOOL, {"Added 2 milk (litres) to groceries.", "call_t1"}},
+      {CHAT_ROLE_ASSISTANT, {"Done! I've added two litres of milk to your groceries list.", ""}},
+      {CHAT_ROLE_USER, {"What else is on it?", ""}},
+      {CHAT_ROLE_ASSISTANT, {"Your groceries list has apples, rice and two litres of milk.", ""}},
+      {CHAT_ROLE_USER, {"Tell me a short fact about octopuses.", ""}},
+      {CHAT_ROLE_ASSISTANT, {"Octopuses have three hearts, and two of them stop beating when they swim!", ""}},
+      {CHAT_ROLE_USER, {"Set a timer for ten minutes for the pasta.", ""}}}},
+};
+
+static const char* const ROLE_NAMES[] = {"user", "assistant", "tool"};
+
+struct PathCost {
+  size_t heapPeak = 0;
+  uint32_t allocations = 0;
+  double us = 0;
+};
+
+template <typename Fn>
+static PathCost measure(Fn sendOnce) {
+  PathCost cost;
+  size_t idle = hostHeapLive();
+  hostHeapResetPeak();
+  uint32_t allocations = hostHeapAllocations();
+  sendOnce();
+  cost.heapPeak = hostHeapPeak() - idle;
+  cost.allocations = hostHeapAllocations() - allocations;
+
+  BenchTimer timer;
+  for (int i = 0; i < CHAT_REQUEST_ITERATIONS; i++) sendOnce();
+  cost.us = timer.us() / CHAT_REQUEST_ITERATIONS;
+  return cost;
+}
+
+static void runCase(const RequestCase& c, const String& timeContext, DrainedSocket& socket) {
+  chatRing.clear();
+  std::vector<OldChatMessage> oldHistory;
+  for (const auto& m : c.history) {
+    chatRing.append(m.first, m.second.first, m.second.second);
+    oldHistory.push_back({ROLE_NAMES[m.first], m.second.first, m.second.second});
+  }
+  CHECK(chatRing.windowStart(CHAT_CONTEXT_TOKEN_BUDGET) == 0);   // Both paths send the whole history
+
+  String oldBody = oldRequestBody(oldHistory, timeContext);
+  StringPrint newBody;
+  writeChatRequestBody(newBody, false, timeContext, "", nullptr);
+  CHECK(newBody.out == oldBody.c_str());
+  if (newBody.out != oldBody.c_str()) {
+    printf("%s old: %s\n%s new: %s\n", c.name, oldBody.c_str(), c.name, newBody.out.c_str());
+  }
+
+  PathCost before = measure([&] {
+    String body = oldRequestBody(oldHistory, timeContext);
+    socket.client.write((const uint8_t*)body.c_str(), body.length());
+  });
+  size_t length = 0;
+  PathCost after = measure([&] {
+    CountingPrint counter;
+    writeChatRequestBody(counter, false, timeContext, "", nullptr);
+    BufferedClientPrint body(socket.client);
+    writeChatRequestBody(body, false, timeContext, "", nullptr);
+    body.flush();
+    length = counter.count;
+  });
+  CHECK(length == newBody.out.size());
+
+  std::string name = std::string("chat_request.") + c.name;
+  bench((name + ".body").c_str(), newBody.out.size(), "bytes");
+  bench((name + ".old_heap_peak").c_str(), before.heapPeak, "bytes");
+  bench((name + ".new_heap_peak").c_str(), after.heapPeak, "bytes");
+  bench((name + ".old_allocations").c_str(), before.allocations, "allocs");
+  bench((name + ".new_allocations").c_str(), after.allocations, "allocs");
+  bench((name + ".old_serialize").c_str(), before.us, "us");
+  bench((name + ".new_serialize").c_str(), after.us, "us");
+}
+
+int main() {
+  bool ready = chatRing.begin();
+  CHECK(ready);
+  if (!ready) return testResult("chat_request");
+  String timeContext = "Current date and time: 3:05 PM on Monday, March 02, 2026";
+  DrainedSocket socket;
+  for (const RequestCase& c : CASES) runCase(c, timeContext, socket);
+  return testResult("chat_request");
+}
@@ -0,0 +1,119 @@
+// ChatHistoryRing: a long conversation with tool exchanges stays bounded, oversized plain
+// text is truncated, and an oversized tool call or result is refused together with the rest
+// of its exchange, so the history never holds a cut tool-call JSON or a call without its
+// results. Reports the cost of an append with the ring full and of picking a window.
+#include "chat_ring.h"
+#include "kiko_test.h"
+
+#include <string>
+
+static std::string toolCall(const char* id, size_t padding = 0) {
+  return "{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"id\":\"" + std::string(id) +
+         "\",\"type\":\"function\",\"function\":{\"name\":\"google_search\",\"arguments\":\"{\\\"query\\\":\\\"" +
+         std::string(padding, 'q') + "\\\"}\"}}]}";
+}
+
+// Every tool result in the ring follows its call or another result of the same exchange
+static bool exchangesWhole(const ChatHistoryRing& ring) {
+  for (size_t i = 0; i < ring.size(); i++) {
+    if (ring.entry(i).kind != CHAT_TOOL_RESULT) continue;
+    if (i == 0 || ring.entry(i - 1).kind == CHAT_PLAIN) return false;
+  }
+  return true;
+}
+
+static void testPlainTruncated() {
+  ChatHistoryRing ring;
+  CHECK(ring.begin());
+  std::string huge(CHAT_ARENA_BYTES, 'x');
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, huge.c_str()));
+  CHECK(ring.size() == 1);
+  CHECK(ring.entry(0).contentLen == CHAT_MAX_CONTENT);
+  CHECK(ring.entry(0).kind == CHAT_PLAIN);
+}
+
+// An oversized call is refused with its results; the exchange before it is left alone
+static void testOversizedCall() {
+  ChatHistoryRing ring;
+  ring.begin();
+  ring.append(CHAT_ROLE_USER, "Search for octopuses");
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, toolCall("call_a").c_str()));
+  CHECK(ring.append(CHAT_ROLE_TOOL, "Octopuses have three hearts.", "call_a"));
+  ring.append(CHAT_ROLE_USER, "Now search for something enormous");
+  CHECK(!ring.append(CHAT_ROLE_ASSISTANT, toolCall("call_b", CHAT_MAX_CONTENT).c_str()));
+  CHECK(!ring.append(CHAT_ROLE_TOOL, "First result.", "call_b"));
+  CHECK(!ring.append(CHAT_ROLE_TOOL, "Second result.", "call_b"));
+  CHECK(ring.size() == 4);
+  CHECK(ring.entry(2).kind == CHAT_TOOL_RESULT);
+  CHECK(strcmp(ring.toolCallId(2), "call_a") == 0);
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, "I couldn't run that search."));
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, toolCall("call_c").c_str()));
+  CHECK(ring.append(CHAT_ROLE_TOOL, "Fine.", "call_c"));
+  CHECK(ring.size() == 7);
+  CHECK(exchangesWhole(ring));
+}
+
+// An oversized result takes its call and the results already added with it
+static void testOversizedResult() {
+  ChatHistoryRing ring;
+  ring.begin();
+  ring.append(CHAT_ROLE_USER, "Weather and news please");
+  size_t used = ring.arenaUsed();
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, toolCall("call_w").c_str()));
+  CHECK(ring.append(CHAT_ROLE_TOOL, "Sunny, 18 degrees.", "call_w"));
+  std::string page(CHAT_MAX_CONTENT + 1, 'n');
+  CHECK(!ring.append(CHAT_ROLE_TOOL, page.c_str(), "call_n"));
+  CHECK(!ring.append(CHAT_ROLE_TOOL, "Late result.", "call_x"));
+  CHECK(ring.size() == 1);
+  CHECK(ring.arenaUsed() == used);
+  CHECK(ring.append(CHAT_ROLE_ASSISTANT, "Sorry, that was too much to read."));
+  CHECK(ring.size() == 2);
+  CHECK(ring.windowStart(100000) == 0);
+}
+
+// Thousands of turns mixing text, tool exchanges and oversized ones
+static void testLongConversation() {
+  ChatHistoryRing ring;
+  ring.begin();
+  std::string big(CHAT_MAX_CONTENT + 10, 'b');
+  for (int turn = 0; turn < 3000; turn++) {
+    ring.append(CHAT_ROLE_USER, ("question " + std::to_string(turn)).c_str());
+    if (turn % 3 == 0) {
+      std::string id = "call_" + std::to_string(turn);
+      ring.append(CHAT_ROLE_ASSISTANT, toolCall(id.c_str(), turn % 997).c_str());
+      ring.append(CHAT_ROLE_TOOL, turn % 11 == 0 ? big.c_str() : std::string(turn % 2000, 'r').c_str(), id.c_str());
+      ring.append(CHAT_ROLE_TOOL, "second", id.c_str());
+    }
+    ring.append(CHAT_ROLE_ASSISTANT, std::string(turn % 1500, 'a').c_str());
+    CHECK(ring.arenaUsed() <= CHAT_ARENA_BYTES);
+    CHECK(ring.size() <= CHAT_RING_MAX_ENTRIES);
+  }
+  CHECK(exchangesWhole(ring));
+  for (size_t i = 0; i < ring.size(); i++) {
+    if (ring.entry(i).kind != CHAT_PLAIN) CHECK(strchr(ring.content(i), 'b') == nullptr);   // No cut result
+  }
+}
+
+static void benchAppend() {
+  ChatHistoryRing ring;
+  ring.begin();
+  std::string text(400, 't');
+  const int N = 200000;
+  BenchTimer appends;
+  for (int i = 0; i < N; i++) ring.append(i % 2 ? CHAT_ROLE_ASSISTANT : CHAT_ROLE_USER, text.c_str());
+  bench("chat_ring.append_full", appends.us() * 1000.0 / N, "ns");
+  size_t sink = 0;
+  BenchTimer window;
+  for (int i = 0; i < N; i++) sink += ring.windowStart(1000 + i % 6000);
+  bench("chat_ring.window_start", window.us() * 1000.0 / N, "ns");
+  CHECK(sink > 0);
+}
+
+int main() {
+  testPlainTruncated();
+  testOversizedCall();
+  testOversizedResult();
+  testLongConversation();
+  benchAppend();
+  return testResult("chat_ring");
+}
@@ -0,0 +1,271 @@
+// Dashboard sync traffic: the bytes the sketch sends to open dashboards over a minute of use,
+// with the sequenced deltas of today's protocol and with the old one, which re-sent the whole
+// chat history, every todo list and the gallery to every connected client on each change and
+// on each new connection. The old broadcasts are rebuilt here from the same history and lists.
+//
+// The minute, on top of a conversation and two lists already on the device: a question, two
+// tool turns that each add an item to a list, and one dashboard reconnecting (a phone waking
+// up). It runs with 1, 3 and 5 dashboards open. Only the chat, todo and gallery content is
+// counted; live status (AI state, alarm, metrics) is sent the same way by both protocols.
+// Checks no dashboard is sent a delta twice and the reconnected one catches up.
+// Bytes are what the frames take on the wire: payload plus the server frame header.
+//
+// Usage: test_dashboard_sync <fixtures directory>
+#include "Kiko.ino"
+#include "kiko_test.h"
+#include "mock_api_server.h"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#define SYNC_OLD_HISTORY_MAX 50     // MAX_HISTORY_MESSAGES of the old sketch
+
+static uint64_t wireBytes(size_t payload) {
+  return payload + (payload < 126 ? 2 : payload < 65536 ? 4 : 10);
+}
+
+// ---------- Old protocol ----------
+
+// What the old sketch kept and broadcast; fed the same changes as the sketch
+struct OldSync {
+  std::vector<std::pair<std::string, std::string>> history;    // role, content
+  std::map<std::string, std::map<std::string, int>> lists;
+  uint64_t bytes = 0;
+  uint32_t messages = 0;
+  int clients = 0;
+
+  void broadcast(const String& json) {
+    bytes += wireBytes(json.length()) * clients;
+    messages += clients;
+  }
+
+  void broadcastChatHistory() {
+    JsonDocument doc;
+    JsonArray out = doc.createNestedArray("history");
+    for (const auto& msg : history) {
+      JsonObject o = out.createNestedObject();
+      o["role"] = msg.first.c_str();
+      o["content"] = msg.second.c_str();
+    }
+    String json;
+    serializeJson(doc, json);
+    broadcast(json);
+  }
+
+  void broadcastTodoLists() {
+    JsonDocument doc;
+    JsonObject out = doc.createNestedObject("lists");
+    for (const auto& list : lists) {
+      JsonObject l = out.createNestedObject(list.first.c_str());
+      for (const auto& item : list.second) l[item.first.c_str()] = item.second;
+    }
+    String json;
+    serializeJson(doc, json);
+    broadcast(json);
+  }
+
+  void broadcastGallery() { broadcast("{\"gallery\":[]}"); }
+
+  // Old addToHistory(): user turns and assistant turns with content were broadcast
+  void added(const char* role, const char* content) {
+    if (history.size() >= SYNC_OLD_HISTORY_MAX) history.erase(history.begin());
+    history.push_back({role, content});
+    if (strcmp(role, "user") == 0 || (strcmp(role, "assistant") == 0 && *content)) broadcastChatHistory();
+  }
+
+  // WStype_CONNECTED: the whole snapshot, to every client
+  void connected() {
+    clients++;
+    broadcastTodoLists();
+    broadcastChatHistory();
+    broadcastGallery();
+  }
+};
+
+// ---------- Workload ----------
+
+static OldSync old;
+
+static void say(const char* role, const char* content, const char* toolCallId = "") {
+  addToHistory(role, content, toolCallId);
+  old.added(role, content);
+}
+
+static void addItem(const char* list, const char* item, int qty) {
+  JsonDocument args;
+  args["list_name"] = list;
+  args["item"] = item;
+  args["quantity"] = qty;
+  runTool(findTool("add_todo_item"), args.as<JsonObject>());
+  old.lists[list][item] += qty;
+  old.broadcastTodoLists();
+}
+
+static void toolTurn(const char* question, const char* callId, const char* list, const char* item, int qty,
+                     const char* reply) {
+  say("user", question);
+  String call = String("{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[{\"id\":\"") + callId +
+                "\",\"type\":\"function\",\"function\":{\"name\":\"add_todo_item\",\"arguments\":\"{\\\"list_name\\\":\\\"" +
+                list + "\\\",\\\"item\\\":\\\"" + item + "\\\",\\\"quantity\\\":" + String(qty) + "}\"}}]}";
+  say("assistant", call.c_str());
+  addItem(list, item, qty);
+  say("tool", (String("Added ") + String(qty) + " " + item + " to " + list + ".").c_str(), callId);
+  say("assistant", reply);
+}
+
+// The conversation and lists on the device before the minute starts
+static void preload() {
+  static const char* const EXCHANGES[][2] = {
+      {"Good morning Kiko, what's the weather like today?", "Good morning! It's 18 degrees and sunny in Lisbon, a lovely day to be outside."},
+      {"Do I need an umbrella this afternoon?", "No umbrella needed, the sky should stay clear until the evening."},
+      {"Tell me a fun fact about octopuses.", "Octopuses have three hearts, and two of them stop beating when they swim!"},
+      {"How far away is the moon?", "The moon is about 384,400 kilometres from Earth, roughly thirty Earths lined up."},
+      {"What should I cook for dinner tonight?", "How about a quick mushroom risotto? It takes about thirty minutes and uses pantry staples."},
+      {"What time is it?", "It's 7:42 PM on Monday."},
+      {"Who wrote The Hobbit?", "The Hobbit was written by J. R. R. Tolkien and published in 1937."},
+      {"Give me a word that rhymes with orange.", "Nothing rhymes perfectly with orange, but door hinge comes close!"},
+      {"How many days until Christmas?", "There are 68 days until Christmas."},
+      {"Thanks Kiko!", "You're welcome! Let me know if you need anything else."},
+  };
+  for (const auto& e : EXCHANGES) {
+    say("user", e[0]);
+    say("assistant", e[1]);
+  }
+  static const char* const GROCERIES[] = {"apples", "rice (kg)", "olive oil", "tomatoes", "bread", "coffee", "onions", "pasta"};
+  for (size_t i = 0; i < sizeof(GROCERIES) / sizeof(GROCERIES[0]); i++) addItem("groceries", GROCERIES[i], 1 + i % 3);
+  static const char* const WORK[] = {"quarterly report", "book meeting room", "reply to anna", "order toner"};
+  for (const char* item : WORK) addItem("work", item, 1);
+}
+
+static void reset() {
+  clearChatHistory();
+  clearTodoLists();
+  old = OldSync();
+}
+
+// ---------- Dashboards ----------
+
+struct Dashboard {
+  int num = -1;
+  uint32_t seq = 0;
+  uint32_t epoch = 0;
+  uint32_t seen = 0;            // Messages read so far
+  uint64_t syncBytes = 0;       // Chat, todo and gallery content, on the wire
+  uint32_t syncMessages = 0;
+  uint32_t repeats = 0;         // Deltas it already had
+};
+
+// Lets the web task deliver the hello and drain the outbox
+static void settle() {
+  uint32_t before;
+  do {
+    before = 0;
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) before += webSocket.hostClient(i).messages;
+    delay(100);
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) before -= webSocket.hostClient(i).messages;
+  } while (before != 0);
+}
+
+// Reads what the sketch sent since the last call, as the dashboard script would
+static void readDashboard(Dashboard& d) {
+  HostWsClient c = webSocket.hostClient(d.num);
+  uint32_t fresh = c.messages - d.seen;
+  CHECK(fresh <= c.received.size());
+  for (size_t i = c.received.size() - std::min<size_t>(fresh, c.received.size()); i < c.received.size(); i++) {
+    const std::string& m = c.received[i];
+    if (m.find("\"op\":") == std::string::npos) continue;
+    JsonDocument doc;
+    if (deserializeJson(doc, m.c_str()) != DeserializationError::Ok) continue;
+    if (doc["op"] != "snapshot" && (uint32_t)(doc["seq"] | 0u) <= d.seq) d.repeats++;
+    d.seq = doc["seq"] | d.seq;
+    d.epoch = doc["epoch"] | d.epoch;
+    d.syncBytes += wireBytes(m.size());
+    d.syncMessages++;
+  }
+  d.seen = c.messages;
+}
+
+static void hello(Dashboard& d) {
+  String json = "{\"type\":\"hello\",\"since\":" + String(d.seq) + ",\"epoch\":" + String(d.epoch) + "}";
+  webSocket.hostSend(d.num, json);
+}
+
+static void runMinute(int dashboards) {
+  reset();
+  preload();
+
+  std::vector<Dashboard> open(dashboards);
+  for (Dashboard& d : open) {
+    d.num = webSocket.hostConnect(IPAddress(192, 168, 1, 20 + (&d - &open[0])));
+    hello(d);
+    old.connected();
+  }
+  settle();
+  for (Dashboard& d : open) {
+    readDashboard(d);
+    d.syncBytes = d.syncMessages = 0;
+  }
+  old.bytes = old.messages = 0;
+
+  // The minute
+  say("user", "What's on my groceries list?");
+  say("assistant", "You have apples, rice, olive oil, tomatoes, bread, coffee, onions and pasta.");
+  toolTurn("Add a dozen eggs to the groceries.", "call_eggs", "groceries", "eggs", 12, "Done, a dozen eggs are on your groceries list.");
+  settle();
+  webSocket.hostDisconnect(open[0].num);
+  old.clients--;
+  settle();
+  toolTurn("And two litres of milk.", "call_milk", "groceries", "milk (litres)", 2, "Added two litres of milk.");
+  open[0].num = webSocket.hostConnect(IPAddress(192, 168, 1, 20));
+  open[0].seen = 0;
+  hello(open[0]);
+  old.connected();
+  settle();
+
+  uint64_t bytes = 0;
+  uint32_t messages = 0;
+  for (Dashboard& d : open) {
+    readDashboard(d);
+    bytes += d.syncBytes;
+    messages += d.syncMessages;
+  }
+  CHECK(bytes > 0 && bytes < old.bytes);
+  CHECK(open[0].seq == open.back().seq);   // The reconnected dashboard caught up
+  for (Dashboard& d : open) CHECK(d.repeats == 0);
+
+  std::string name = "dashboard_sync." + std::to_string(dashboards) + "_dashboards";
+  bench((name + ".old_bytes_per_min").c_str(), old.bytes, "bytes");
+  bench((name + ".new_bytes_per_min").c_str(), bytes, "bytes");
+  bench((name + ".old_messages").c_str(), old.messages, "messages");
+  bench((name + ".new_messages").c_str(), messages, "messages");
+
+  for (Dashboard& d : open) webSocket.hostDisconnect(d.num);
+  settle();
+}
+
+// The sketch's tasks never return, so the test ends the process
+static int finish() {
+  int result = testResult("dashboard_sync");
+  fflush(stdout);
+  _exit(result);
+}
+
+int main(int argc, char** argv) {
+  std::string fixtures = argc > 1 ? argv[1] : "fixtures";
+  static MockApiServer mock;
+  bool mocking = mock.begin(fixtures + "/api");
+  CHECK(mocking);
+  if (!mocking) return finish();
+  mock.routeSketchHosts();
+
+  hostFsRoot() = "dashboard_sync_fs";
+  std::filesystem::remove_all(hostFsRoot());
+  hostSkipDelays() = true;
+  setup();
+  hostSkipDelays() = false;
+
+  for (int dashboards : {1, 3, 5}) runMinute(dashboards);
+  return finish();
+}
@@ -0,0 +1,290 @@
+// FlacEncoder: every stream decodes bit-exactly with an independent reference decoder
+// (a straight reading of the FLAC format: bit-serial reader, bitwise CRCs, SUBFRAME
+// CONSTANT/VERBATIM/FIXED with partitioned Rice residuals), plus size and throughput.
+#include "flac_encoder.h"
+#include "kiko_test.h"
+
+#include <random>
+#include <vector>
+
+// ---------- Reference decoder ----------
+
+class RefBitReader {
+ public:
+  RefBitReader(const std::vector<uint8_t>& b) : b_(b) {}
+
+  uint32_t bits(int n) {
+    uint32_t v = 0;
+    while (n--) {
+      if ((pos_ >> 3) >= b_.size()) { overrun_ = true; return v; }
+      v = (v << 1) | ((b_[pos_ >> 3] >> (7 - (pos_ & 7))) & 1);
+      pos_++;
+    }
+    return v;
+  }
+
+  int32_t signedBits(int n) {
+    uint32_t v = bits(n);
+    return (v >> (n - 1)) ? (int32_t)v - (1 << n) : (int32_t)v;
+  }
+
+  uint32_t unary() {
+    uint32_t q = 0;
+    while (!overrun_ && bits(1) == 0) q++;
+    return q;
+  }
+
+  void align() { pos_ = (pos_ + 7) & ~(size_t)7; }
+  size_t byte() const { return pos_ >> 3; }
+  bool overrun() const { return overrun_; }
+
+ private:
+  const std::vector<uint8_t>& b_;
+  size_t pos_ = 0;
+  bool overrun_ = false;
+};
+
+static uint8_t refCrc8(const uint8_t* p, size_t n) {
+  uint8_t c = 0;
+  while (n--) {
+    c ^= *p++;
+    for (int b = 0; b < 8; b++) c = (c & 0x80) ? (uint8_t)((c << 1) ^ 0x07) : (uint8_t)(c << 1);
+  }
+  return c;
+}
+
+static uint16_t refCrc16(const uint8_t* p, size_t n) {
+  uint16_t c = 0;
+  while (n--) {
+    c ^= *p++ << 8;
+    for (int b = 0; b < 8; b++) c = (c & 0x8000) ? (uint16_t)((c << 1) ^ 0x8005) : (uint16_t)(c << 1);
+  }
+  return c;
+}
+
+struct RefStream {
+  uint32_t sampleRate = 0;
+  uint32_t totalSamples = 0;
+  uint32_t minBlock = 0, maxBlock = 0;
+  int frames = 0;
+  int subframeTypes[3] = {0, 0, 0};      // CONSTANT, VERBATIM, FIXED
+  std::vector<int16_t> samples;
+  const char* error = nullptr;
+};
+
+static bool refDecode(const std::vector<uint8_t>& d, RefStream& s) {
+  RefBitReader br(d);
+  if (d.size() < FLAC_STREAM_HEADER_BYTES || memcmp(d.data(), "fLaC", 4)) return (s.error = "magic"), false;
+  br.bits(32);
+  bool last = br.bits(1);
+  uint32_t type = br.bits(7), len = br.bits(24);
+  if (!last || type != 0 || len != 34) return (s.error = "metadata"), false;
+  s.minBlock = br.bits(16);
+  s.maxBlock = br.bits(16);
+  br.bits(24);
+  br.bits(24);
+  s.sampleRate = br.bits(20);
+  if (br.bits(3) != 0 || br.bits(5) != 15) return (s.error = "format"), false;
+  br.bits(4);                                     // Total samples above 32 bits
+  s.totalSamples = br.bits(32);
+  for (int i = 0; i < 4; i++) br.bits(32);
+
+  while (br.byte() < d.size()) {
+    size_t start = br.byte();
+    if (br.bits(14) != 0x3FFE || br.bits(1) != 0 || br.bits(1) != 0) return (s.error = "sync"), false;
+    uint32_t bsCode = br.bits(4), rateCode = br.bits(4);
+    if (br.bits(4) != 0 || br.bits(3) != 4 || br.bits(1) != 0) return (s.error = "frame format"), false;
+    static const uint32_t rates[] = {0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000};
+    if (rateCode == 0 ? false : rateCode > 11 || rates[rateCode] != s.sampleRate) return (s.error = "rate"), false;
+    uint32_t lead = br.bits(8), number;
+    if (lead < 0x80) {
+      number = lead;
+    } else {
+      int extra = 0;
+      while (lead & (0x40 >> extra)) extra++;
+      number = lead & (0x3F >> extra);
+      for (int i = 0; i < extra; i++) {
+        uint32_t c = br.bits(8);
+        if ((c & 0xC0) != 0x80) return (s.error = "utf8"), false;
+        number = (number << 6) | (c & 0x3F);
+      }
+    }
+    if ((int)number != s.frames) return (s.error = "frame number"), false;
+    s.frames++;
+    int n;
+    if (bsCode == 0xC) n = 4096;
+    else if (bsCode == 0x6) n = br.bits(8) + 1;
+    else if (bsCode == 0x7) n = br.bits(16) + 1;
+    else return (s.error = "block size"), false;
+    uint8_t headerCrc = refCrc8(&d[start], br.byte() - start);
+    if (br.bits(8) != headerCrc) return (s.error = "crc8"), false;
+
+    if (br.bits(1) != 0) return (s.error = "subframe pad"), false;
+    uint32_t t = br.bits(6);
+    if (br.bits(1) != 0) return (s.error = "wasted bits"), false;
+    std::vector<int32_t> x;
+    if (t == 0) {
+      s.subframeTypes[0]++;
+      x.assign(n, br.signedBits(16));
+    } else if (t == 1) {
+      s.subframeTypes[1]++;
+      for (int i = 0; i < n; i++) x.push_back(br.signedBits(16));
+    } else if (t >= 8 && t <= 12) {
+      s.subframeTypes[2]++;
+      int order = t - 8;
+      for (int i = 0; i < order; i++) x.push_back(br.signedBits(16));
+      if (br.bits(2) != 0) return (s.error = "residual coding"), false;
+      int po = br.bits(4);
+      if ((n >> po) < order || (n >> po) << po != n) return (s.error = "partition order"), false;
+      for (int p = 0; p < (1 << po); p++) {
+        int count = (n >> po) - (p == 0 ? order : 0);
+        int k = br.bits(4);
+        if (k == 15) return (s.error = "escape"), false;
+        for (int i = 0; i < count; i++) {
+          uint32_t u = (br.unary() << k) | br.bits(k);
+          int32_t r = (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+          size_t j = x.size();
+          int64_t pred = 0;
+          switch (order) {
+            case 1: pred = x[j - 1]; break;
+            case 2: pred = 2LL * x[j - 1] - x[j - 2]; break;
+            case 3: pred = 3LL * x[j - 1] - 3LL * x[j - 2] + x[j - 3]; break;
+            case 4: pred = 4LL * x[j - 1] - 6LL * x[j - 2] + 4LL * x[j - 3] - x[j - 4]; break;
+          }
+          x.push_back((int32_t)(pred + r));
+        }
+      }
+    } else {
+      return (s.error = "subframe type"), false;
+    }
+    br.align();
+    uint16_t frameCrc = refCrc16(&d[start], br.byte() - start);
+    if (br.bits(16) != frameCrc) return (s.error = "crc16"), false;
+    if (br.overrun()) return (s.error = "truncated"), false;
+    for (int32_t v : x) {
+      if (v < -32768 || v > 32767) return (s.error = "sample range"), false;
+      s.samples.push_back((int16_t)v);
+    }
+  }
+  return true;
+}
+
+// ---------- Encoding the way Kiko.ino does ----------
+
+static std::vector<uint8_t> encode(FlacEncoder& e, const std::vector<int16_t>& x, bool knownLength) {
+  std::vector<uint8_t> out(FLAC_STREAM_HEADER_BYTES + (x.size() / FLAC_BLOCK_SIZE + 1) * FLAC_MAX_FRAME_BYTES);
+  size_t p = e.writeStreamHeader(out.data(), knownLength ? x.size() : 0);
+  for (size_t i = 0; i < x.size(); i += FLAC_BLOCK_SIZE) {
+    int n = std::min<size_t>(FLAC_BLOCK_SIZE, x.size() - i);
+    size_t bytes = e.encodeFrame(&x[i], n, &out[p]);
+    CHECK(bytes <= FLAC_MAX_FRAME_BYTES);
+    p += bytes;
+  }
+  out.resize(p);
+  return out;
+}
+
+static int16_t clip16(double v) { return (int16_t)std::max(-32768.0, std::min(32767.0, v)); }
+
+// Voiced speech-like signal with pauses and a little noise
+static std::vector<int16_t> speechLike(size_t n, uint32_t seed) {
+  std::mt19937 g(seed);
+  std::normal_distribution<double> noise(0, 60);
+  std::vector<int16_t> x(n);
+  for (size_t i = 0; i < n; i++) {
+    double t = i / 8000.0;
+    double env = std::max(0.0, sin(TWO_PI * 2.3 * t));
+    double f0 = 130 + 20 * sin(TWO_PI * 0.7 * t);
+    double v = 0;
+    for (int h = 1; h <= 10; h++) v += sin(TWO_PI * h * f0 * t) / h;
+    x[i] = clip16(6000 * env * v + noise(g));
+  }
+  return x;
+}
+
+static RefStream roundTrip(const char* name, const std::vector<int16_t>& x, bool knownLength) {
+  FlacEncoder e;
+  CHECK(e.begin(8000));
+  std::vector<uint8_t> flac = encode(e, x, knownLength);
+  RefStream s;
+  bool ok = refDecode(flac, s);
+  if (!ok) printf("  %s: decode failed (%s) after %d frames\n", name, s.error, s.frames);
+  CHECK(ok);
+  CHECK(s.sampleRate == 8000);
+  CHECK(s.totalSamples == (knownLength ? x.size() : 0));
+  CHECK(s.frames == (int)((x.size() + FLAC_BLOCK_SIZE - 1) / FLAC_BLOCK_SIZE));
+  CHECK(s.samples.size() == x.size());
+  bool exact = s.samples == x;
+  if (!exact) printf("  %s: samples differ\n", name);
+  CHECK(exact);
+  return s;
+}
+
+static void testRoundTrip() {
+  std::mt19937 g(8);
+  std::vector<int16_t> x;
+
+  RefStream s = roundTrip("speech", speechLike(8000 * 6 + 123, 1), true);
+  CHECK(s.subframeTypes[2] > 0);                  // Speech takes the fixed predictors
+  roundTrip("speech_streamed", speechLike(8000 * 6 + 123, 2), false);
+
+  x.assign(20000, 0);
+  s = roundTrip("silence", x, true);
+  CHECK(s.subframeTypes[0] == s.frames);
+  x.assign(5000, -1400);                          // PDM DC offset: CONSTANT subframes
+  roundTrip("dc", x, false);
+
+  x.resize(10000);                                // White noise at full scale: VERBATIM
+  for (auto& v : x) v = (int16_t)g();
+  s = roundTrip("noise", x, true);
+  CHECK(s.subframeTypes[1] == s.frames);
+
+  x.resize(9000);                                 // Rail-to-rail steps: the largest residuals
+  for (size_t i = 0; i < x.size(); i++) x[i] = (i / 3) % 2 ? 32767 : -32768;
+  roundTrip("extremes", x, true);
+  for (size_t i = 0; i < x.size(); i++) x[i] = (i % 5 == 0) ? -32768 : 32767;
+  roundTrip("alternating", x, true);
+
+  for (int n : {1, 2, 5, 15, 16, 17, 255, 4095, 4096, 4097, 12288}) {   // Short and ragged blocks
+    roundTrip("length", speechLike(n, n), n % 2);
+  }
+
+  // More than 127 frames: multi-byte UTF-8 frame numbers
+  roundTrip("long", speechLike(FLAC_BLOCK_SIZE * 140 + 7, 3), false);
+}
+
+// Frames are stateless apart from their number: encoding one clip twice gives the same bytes
+static void testRepeatable() {
+  FlacEncoder e;
+  e.begin(8000);
+  std::vector<int16_t> x = speechLike(30000, 4);
+  CHECK(encode(e, x, true) == encode(e, x, true));
+}
+
+static void bench() {
+  FlacEncoder e;
+  e.begin(8000);
+  std::vector<int16_t> x = speechLike(8000 * 60, 5);   // A minute of speech-like audio
+  std::vector<uint8_t> flac;
+  const int rounds = 5;
+  BenchTimer t;
+  for (int r = 0; r < rounds; r++) flac = encode(e, x, true);
+  double us = t.us();
+  ::bench("flac.encode_throughput", rounds * x.size() / us, "Msamples/s");
+  ::bench("flac.encode_per_block", us / rounds / (x.size() / FLAC_BLOCK_SIZE), "us");
+  ::bench("flac.speech_wav_bytes", 44 + x.size() * 2, "bytes");
+  ::bench("flac.speech_flac_bytes", flac.size(), "bytes");
+  ::bench("flac.speech_ratio", 100.0 * flac.size() / (x.size() * 2), "%");
+
+  RefStream s;
+  BenchTimer d;
+  refDecode(flac, s);
+  ::bench("flac.reference_decode_throughput", x.size() / d.us(), "Msamples/s");
+}
+
+int main() {
+  testRoundTrip();
+  testRepeatable();
+  bench();
+  return testResult("flac_encoder");
+}
@@ -0,0 +1,161 @@
+// FrameBroker: one capture thread at the stream's frame cap, and sender threads standing in
+// for viewers on fast, slow and stalled links. The fast viewers must keep up with the camera
+// while a slow one drops frames, every frame must be sent or counted as dropped, and every
+// SharedFrame must be freed once the last viewer lets go of it.
+#include "frame_broker.h"
+#include "kiko_test.h"
+
+#include <thread>
+#include <vector>
+
+#define CAPTURE_FPS 20             // Twice the default cap, as set with /api/stream?fps=20
+#define FRAME_BYTES 24000          // A VGA JPEG
+#define RUN_MS 3000
+
+struct SimViewer {
+  const char* name;
+  int sendMs;                      // Time one frame takes on this viewer's socket
+  int stallMs;                     // The socket blocks once this long, a second into the run
+  int slot = -1;
+  uint32_t maxLatencyMs = 0;       // Capture to sent
+  uint32_t maxGapMs = 0;           // Longest time between two sent frames
+};
+
+// The sender task's loop, with the socket write replaced by a delay
+static void viewerLoop(FrameBroker& broker, SimViewer& sim, std::atomic<bool>& stop) {
+  StreamViewer& v = broker.viewer(sim.slot);
+  unsigned long start = millis(), lastSent = 0;
+  bool stalled = sim.stallMs == 0;
+  for (;;) {
+    SharedFrame* f = broker.next(sim.slot, 50);
+    if (!f) {
+      if (stop) break;
+      continue;
+    }
+    if (!stalled && millis() - start > 1000) {
+      stalled = true;
+      delay(sim.stallMs);
+    }
+    delay(sim.sendMs);
+    unsigned long now = millis();
+    sim.maxLatencyMs = std::max<uint32_t>(sim.maxLatencyMs, now - f->capturedAt);
+    if (lastSent) sim.maxGapMs = std::max<uint32_t>(sim.maxGapMs, now - lastSent);
+    lastSent = now;
+    v.framesSent++;
+    v.bytesSent += f->len;
+    sharedFrameRelease(f);
+  }
+}
+
+static uint32_t publishFor(FrameBroker& broker, int ms, const std::vector<uint8_t>& jpeg) {
+  uint32_t seq = 0;
+  unsigned long start = millis();
+  while (millis() - start < (unsigned long)ms) {
+    unsigned long t = millis();
+    SharedFrame* f = sharedFrameCreate(jpeg.data(), jpeg.size(), ++seq);
+    if (f) broker.publish(f);
+    unsigned long spent = millis() - t;
+    if (spent < 1000 / CAPTURE_FPS) delay(1000 / CAPTURE_FPS - spent);
+  }
+  return seq;
+}
+
+static void testSlowViewerDoesNotStallOthers() {
+  FrameBroker broker;
+  broker.begin();
+  std::vector<uint8_t> jpeg(FRAME_BYTES, 0xAB);
+  std::vector<SimViewer> sims = {
+      {"fast_lan", 2, 0}, {"fast_wifi", 15, 0}, {"slow_3fps", 300, 0}, {"stalled_2s", 5, 2000}};
+  for (SimViewer& s : sims) {
+    s.slot = broker.subscribe(0x0A000001 + s.slot);
+    CHECK(s.slot >= 0);
+  }
+  CHECK(broker.subscribe(1) == -1);               // STREAM_MAX_VIEWERS are taken
+  size_t heapBefore = hostHeapLive();
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> senders;
+  for (SimViewer& s : sims) senders.emplace_back([&broker, &s, &stop] { viewerLoop(broker, s, stop); });
+  uint32_t published = publishFor(broker, RUN_MS, jpeg);
+  stop = true;
+  for (auto& t : senders) t.join();
+
+  // Only the broker's latest frame is still alive (plus a little per-thread host bookkeeping)
+  size_t liveAfter = hostHeapLive();
+  CHECK(liveAfter >= heapBefore + FRAME_BYTES && liveAfter < heapBefore + FRAME_BYTES + 4096);
+
+  printf("%-12s %6s %8s %10s %8s\n", "viewer", "sent", "dropped", "latency", "max gap");
+  for (SimViewer& s : sims) {
+    StreamViewer& v = broker.viewer(s.slot);
+    printf("%-12s %6u %8u %8u ms %5u ms\n", s.name, (unsigned)v.framesSent, (unsigned)v.framesDropped,
+           s.maxLatencyMs, s.maxGapMs);
+    CHECK(v.framesSent + v.framesDropped == published);   // Queues drained: nothing lost silently
+    CHECK(v.bytesSent == v.framesSent * FRAME_BYTES);
+  }
+  StreamViewer& fast = broker.viewer(sims[0].slot);
+  StreamViewer& wifi = broker.viewer(sims[1].slot);
+  StreamViewer& slow = broker.viewer(sims[2].slot);
+  StreamViewer& stalled = broker.viewer(sims[3].slot);
+  CHECK(fast.framesDropped == 0);
+  CHECK(wifi.framesDropped == 0);
+  CHECK(sims[0].maxGapMs < 3 * 1000 / CAPTURE_FPS);    // Never waited on the slow or stalled viewer
+  CHECK(sims[1].maxGapMs < 3 * 1000 / CAPTURE_FPS);
+  CHECK(slow.framesSent <= RUN_MS / 300 + 2 && slow.framesDropped > 0);
+  CHECK(stalled.framesDropped >= 2000 / (1000 / CAPTURE_FPS) - STREAM_QUEUE_DEPTH - 2);
+  CHECK(sims[3].maxLatencyMs < 2000 + 3 * 1000 / CAPTURE_FPS);   // Resumes with recent frames
+
+  SharedFrame* last = broker.latest(1000);
+  CHECK(last && last->seq == published);
+  if (last) sharedFrameRelease(last);
+
+  bench("frame_broker.published", published, "frames");
+  bench("frame_broker.fast_viewer_fps", fast.framesSent * 1000.0 / RUN_MS, "fps");
+  bench("frame_broker.fast_viewer_max_gap", sims[0].maxGapMs, "ms");
+  bench("frame_broker.slow_viewer_fps", slow.framesSent * 1000.0 / RUN_MS, "fps");
+  bench("frame_broker.slow_viewer_dropped", slow.framesDropped, "frames");
+  for (SimViewer& s : sims) broker.unsubscribe(s.slot);
+  CHECK(broker.viewerCount() == 0);
+}
+
+// Unsubscribing releases whatever the viewer had queued
+static void testUnsubscribeReleases() {
+  FrameBroker broker;
+  broker.begin();
+  uint8_t jpeg[1000] = {};
+  int slot = broker.subscribe(1);
+  SharedFrame* kept = sharedFrameCreate(jpeg, sizeof(jpeg), 1);
+  sharedFrameRetain(kept);
+  broker.publish(kept);
+  CHECK(kept->refs == 3);                         // Ours, the broker's latest, the queue's
+  broker.publish(sharedFrameCreate(jpeg, sizeof(jpeg), 2));
+  broker.publish(sharedFrameCreate(jpeg, sizeof(jpeg), 3));
+  CHECK(kept->refs == 1);                         // Dropped from the full queue, replaced as latest
+  CHECK(broker.viewer(slot).framesDropped == 1);
+  broker.unsubscribe(slot);
+  SharedFrame* f = broker.next(slot, 0);
+  CHECK(f == nullptr);
+  sharedFrameRelease(kept);
+  f = broker.latest(1000);
+  CHECK(f && f->seq == 3 && broker.latestAge() < 1000);
+  if (f) sharedFrameRelease(f);
+}
+
+// The single-viewer design wrote each frame to every socket in turn; with one slow client
+// in the list, that is the frame rate every viewer would get
+static void benchSerialFanOut() {
+  const int sendMs[] = {2, 15, 300};
+  unsigned long start = millis();
+  int frames = 0;
+  while (millis() - start < 1000) {
+    for (int ms : sendMs) delay(ms);
+    frames++;
+  }
+  bench("frame_broker.serial_fanout_fps", frames * 1000.0 / (millis() - start), "fps");
+}
+
+int main() {
+  testUnsubscribeReleases();
+  testSlowViewerDoesNotStallOthers();
+  benchSerialFanOut();
+  return testResult("frame_broker");
+}
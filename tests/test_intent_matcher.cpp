@@ -0,0 +1,157 @@
+// Intent matcher against a labelled corpus (tests/fixtures/intent_corpus.tsv): precision
+// and recall of the local fast path, per intent and overall, with slots compared exactly,
+// and the cost of a match. A wrong local answer is worse than a trip to the model, so
+// precision is held to a higher bar than recall.
+//
+// The time a local turn saves is measured on the device, not here: Kiko prints a TURN line
+// per turn (path=local|model, reply_ms=...). Point KIKO_TURN_LOG at a captured serial log
+// to have the saving per turn computed for this corpus' mix of requests.
+//
+// Usage: test_intent_matcher <intent_corpus.tsv>
+#include "intent_matcher.h"
+#include "kiko_test.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct Utterance {
+  std::string intent;
+  std::string slots;
+  std::string text;
+};
+
+static std::vector<Utterance> loadCorpus(const char* path) {
+  std::vector<Utterance> out;
+  FILE* f = fopen(path, "r");
+  if (!f) return out;
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    std::string s(line);
+    while (!s.empty() && (s.back() == '\n' || s.back() == '\r')) s.pop_back();
+    if (s.empty() || s[0] == '#') continue;
+    size_t a = s.find('\t'), b = a == std::string::npos ? a : s.find('\t', a + 1);
+    if (b == std::string::npos) continue;
+    out.push_back({s.substr(0, a), s.substr(a + 1, b - a - 1), s.substr(b + 1)});
+  }
+  fclose(f);
+  return out;
+}
+
+// The slots the handlers get, in the corpus' notation
+static std::string slotsOf(const IntentMatch& m) {
+  char buf[160];
+  switch (m.intent) {
+    case INTENT_SET_TIMER:
+      snprintf(buf, sizeof(buf), "seconds=%u", (unsigned)m.seconds);
+      return buf;
+    case INTENT_SET_ALARM:
+      snprintf(buf, sizeof(buf), "time=%u:%02u%s", m.hour, m.minute, m.pm ? "pm" : "am");
+      return buf;
+    case INTENT_ADD_ITEM:
+    case INTENT_REMOVE_ITEM: {
+      std::string s = m.quantity > 0 ? "qty=" + std::to_string(m.quantity) + ";" : "";
+      return s + "item=" + m.item.c_str() + ";list=" + m.list.c_str();
+    }
+    case INTENT_LIST_ITEMS:
+    case INTENT_CLEAR_LIST:
+      return std::string("list=") + m.list.c_str();
+    default:
+      return "-";
+  }
+}
+
+struct Tally {
+  int tp = 0, fp = 0, fn = 0;
+};
+
+static double ratio(int a, int b) { return b ? (double)a / b : 1.0; }
+
+// Mean reply_ms of the TURN lines of each path in a device log
+static bool turnLogMeans(const char* path, double& localMs, double& modelMs) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char line[512];
+  double sum[2] = {0, 0};
+  int n[2] = {0, 0};
+  while (fgets(line, sizeof(line), f)) {
+    const char* turn = strstr(line, "TURN ");
+    const char* reply = turn ? strstr(turn, " reply_ms=") : nullptr;
+    if (!reply) continue;
+    int model = strstr(turn, " path=model") != nullptr;
+    sum[model] += atof(reply + 10);
+    n[model]++;
+  }
+  fclose(f);
+  if (!n[0] || !n[1]) return false;
+  localMs = sum[0] / n[0];
+  modelMs = sum[1] / n[1];
+  return true;
+}
+
+int main(int argc, char** argv) {
+  std::vector<Utterance> corpus = loadCorpus(argc > 1 ? argv[1] : "intent_corpus.tsv");
+  CHECK(corpus.size() > 100);
+
+  IntentMatcher matcher;
+  matcher.begin();
+  std::map<std::string, Tally> perIntent;
+  Tally all;
+  int local = 0;
+  for (const Utterance& u : corpus) {
+    IntentMatch m;
+    matcher.match(u.text.c_str(), m);
+    std::string got = INTENT_NAMES[m.intent], slots = slotsOf(m);
+    bool correct = got == u.intent && (got == "none" || slots == u.slots);
+    bool matched = m.intent != INTENT_NONE, expected = u.intent != "none";
+    if (matched) local++;
+    if (matched && correct) { all.tp++; perIntent[got].tp++; }
+    if (matched && !correct) { all.fp++; perIntent[got].fp++; }
+    if (expected && !correct) { all.fn++; perIntent[u.intent].fn++; }
+    if (!correct) {
+      printf("  %-58s want %s %s, got %s %s\n", u.text.c_str(), u.intent.c_str(), u.slots.c_str(), got.c_str(),
+             matched ? slots.c_str() : "");
+    }
+  }
+
+  printf("%-14s %9s %7s\n", "intent", "precision", "recall");
+  for (int i = 1; i < INTENT_COUNT; i++) {
+    const Tally& t = perIntent[INTENT_NAMES[i]];
+    printf("%-14s %9.3f %7.3f\n", INTENT_NAMES[i], ratio(t.tp, t.tp + t.fp), ratio(t.tp, t.tp + t.fn));
+  }
+  double precision = ratio(all.tp, all.tp + all.fp), recall = ratio(all.tp, all.tp + all.fn);
+  CHECK(precision >= 0.99);
+  CHECK(recall >= 0.90);
+  bench("intent.corpus_utterances", corpus.size(), "utterances");
+  bench("intent.precision", precision, "");
+  bench("intent.recall", recall, "");
+  bench("intent.answered_locally", 100.0 * local / corpus.size(), "%");
+  bench("intent.automaton_nodes", matcher.automatonNodes(), "nodes");
+
+  // Cost of the fast path on a miss as well as on a hit: every turn pays it
+  const int rounds = 200;
+  double total = 0, slowest = 0;
+  for (const Utterance& u : corpus) {
+    BenchTimer t;
+    for (int r = 0; r < rounds; r++) {
+      IntentMatch m;
+      matcher.match(u.text.c_str(), m);
+    }
+    double us = t.us() / rounds;
+    total += us;
+    slowest = std::max(slowest, us);
+  }
+  bench("intent.match_mean", total / corpus.size(), "us");
+  bench("intent.match_slowest_utterance", slowest, "us");
+
+  const char* log = getenv("KIKO_TURN_LOG");
+  double localMs, modelMs;
+  if (log && turnLogMeans(log, localMs, modelMs)) {
+    bench("intent.device_local_reply", localMs, "ms");
+    bench("intent.device_model_reply", modelMs, "ms");
+    bench("intent.saved_per_turn", (modelMs - localMs) * all.tp / corpus.size(), "ms");
+  } else if (log) {
+    printf("%s: needs TURN lines for both path=local and path=model\n", log);
+  }
+  return testResult("intent_matcher");
+}
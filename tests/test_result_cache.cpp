@@ -0,0 +1,119 @@
+// ResultCache: hits, stale-if-error, eviction, and coalescing of concurrent misses,
+// including a failed fetch that must reach every waiter without being repeated
+#include "result_cache.h"
+#include "kiko_test.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static void testHitsAndStale() {
+  ResultCache c;
+  c.begin();
+  String v;
+  int calls = 0;
+  auto ok = [&](String& out) { calls++; out = "sunny"; return true; };
+  auto bad = [&](String& out) { calls++; out = "sorry"; return false; };
+  CHECK(c.get("w|x", 1000, 60, 100, v, ok) && v == "sunny" && calls == 1);
+  CHECK(c.get("w|x", 1030, 60, 100, v, ok) && calls == 1);
+  CHECK(c.get("w|x", 1100, 60, 100, v, bad) && v == "sunny" && calls == 2);   // Stale
+  CHECK(!c.get("w|x", 1200, 60, 100, v, bad) && v == "sorry");                // Too old
+  CHECK(!c.get("w|y", 1200, 60, 100, v, bad) && v == "sorry");
+  ResultCacheStats s = c.stats();
+  CHECK(s.hits == 1 && s.staleServed == 1 && s.fetchFailures == 3);
+
+  for (int i = 0; i < 30; i++) c.get(String(i), 2000 + i, 60, 0, v, ok);
+  CHECK(c.size() == RESULT_CACHE_MAX_ENTRIES);
+}
+
+// n callers ask for one key at once; the leader's fetch takes fetchMs and returns ok
+static int coalesce(int n, bool ok, int fetchMs, std::vector<String>& values, std::vector<bool>& results) {
+  ResultCache c;
+  c.begin();
+  std::atomic<int> calls{0};
+  std::atomic<bool> go{false};
+  values.assign(n, String());
+  results.assign(n, false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < n; i++) {
+    threads.emplace_back([&, i] {
+      while (!go) std::this_thread::yield();
+      if (i > 0) delay(5);                             // Let caller 0 lead
+      String v;
+      results[i] = c.get("weather|paris", 5000, 600, 0, v, [&](String& out) {
+        calls++;
+        delay(fetchMs);
+        out = ok ? "Paris is sunny" : "Sorry, I could not get the weather information.";
+        return ok;
+      });
+      values[i] = v;
+    });
+  }
+  go = true;
+  for (auto& t : threads) t.join();
+  ResultCacheStats s = c.stats();
+  CHECK(s.coalesced == (uint32_t)(n - 1));
+  return calls;
+}
+
+static void testCoalescing() {
+  std::vector<String> values;
+  std::vector<bool> results;
+  CHECK(coalesce(6, true, 80, values, results) == 1);
+  for (int i = 0; i < 6; i++) CHECK(results[i] && values[i] == "Paris is sunny");
+
+  // A failed fetch is not repeated by the waiters: they all get the leader's apology
+  CHECK(coalesce(6, false, 80, values, results) == 1);
+  for (int i = 0; i < 6; i++) {
+    CHECK(!results[i]);
+    CHECK(values[i] == "Sorry, I could not get the weather information.");
+  }
+}
+
+// The entry is free for a new flight once everyone has its answer, and the next miss fetches
+static void testFlightReset() {
+  ResultCache c;
+  c.begin();
+  String v;
+  int calls = 0;
+  auto bad = [&](String& out) { calls++; delay(20); out = "no"; return false; };
+  std::thread waiter([&] {
+    delay(5);
+    String w;
+    CHECK(!c.get("k", 100, 60, 0, w, bad) && w == "no");
+  });
+  CHECK(!c.get("k", 100, 60, 0, v, bad));
+  waiter.join();
+  CHECK(calls == 1);
+  CHECK(c.get("k", 101, 60, 0, v, [&](String& out) { calls++; out = "yes"; return true; }) && v == "yes");
+  CHECK(calls == 2);
+}
+
+// Upstream requests and wall time for a burst of identical lookups, cached vs uncached
+static void benchBurst() {
+  const int n = 8, fetchMs = 50;
+  std::vector<String> values;
+  std::vector<bool> results;
+  BenchTimer t;
+  int calls = coalesce(n, true, fetchMs, values, results);
+  bench("result_cache.burst8_upstream_calls", calls, "requests");
+  bench("result_cache.burst8_wall", t.us() / 1000.0, "ms");
+  bench("result_cache.burst8_uncached_upstream_calls", n, "requests");
+
+  ResultCache c;
+  c.begin();
+  String v;
+  c.get("k", 1, 600, 0, v, [](String& out) { out = "cached"; return true; });
+  const int lookups = 100000;
+  BenchTimer hit;
+  for (int i = 0; i < lookups; i++) c.get("k", 2, 600, 0, v, [](String&) { return false; });
+  bench("result_cache.hit", hit.us() * 1000.0 / lookups, "ns");
+}
+
+int main() {
+  testHitsAndStale();
+  testCoalescing();
+  testFlightReset();
+  benchBurst();
+  return testResult("result_cache");
+}
@@ -0,0 +1,164 @@
+// Sprite decoder: every frame of every sprite in sprites.h, drawn with spriteDraw() into a
+// 128x64 U8g2 page buffer, must equal its source image pixel for pixel. The pixels come from
+// the PNG/GIF sources via sprite_pixels.py (the compiler's image loaders, not its encoder).
+// Also checks clipping at the screen edges and reports flash saved and decode cost.
+//
+// Usage: test_sprite_decoder <sprite_pixels.bin>
+#include "sprites.h"
+#include "kiko_test.h"
+
+#include <string>
+#include <vector>
+
+#define OLED_WIDTH 128
+#define OLED_PAGES 8
+
+struct SourceSprite {
+  std::string name;
+  int width = 0, height = 0;
+  std::vector<std::vector<uint8_t>> frames;   // One byte per pixel, row by row
+};
+
+static const struct { const char* name; const SpriteSet* set; } kSprites[] = {
+    {"time_date_icon", &time_date_icon},
+    {"mic_icon", &mic_icon},
+    {"weather_icon", &weather_icon},
+    {"speaking_sprite", &speaking_sprite},
+};
+
+static std::vector<SourceSprite> loadSources(const char* path) {
+  std::vector<SourceSprite> out;
+  FILE* f = fopen(path, "rb");
+  if (!f) return out;
+  char name[64];
+  int frames;
+  SourceSprite s;
+  while (fscanf(f, "%63s %d %d %d", name, &s.width, &s.height, &frames) == 4 && fgetc(f) == '\n') {
+    s.name = name;
+    s.frames.assign(frames, std::vector<uint8_t>(s.width * s.height));
+    for (auto& px : s.frames) {
+      if (fread(px.data(), 1, px.size(), f) != px.size()) frames = -1;
+    }
+    if (frames < 0) break;
+    out.push_back(s);
+  }
+  fclose(f);
+  return out;
+}
+
+static bool pixel(const uint8_t* buf, int x, int y) { return (buf[(y / 8) * OLED_WIDTH + x] >> (y % 8)) & 1; }
+
+// Draws frame at (x, page) on a buffer filled with fill and compares every screen pixel:
+// inside the sprite it must be the source pixel, outside it must be untouched
+static int compareFrame(const SpriteSet& set, const SourceSprite& src, int frame, int x, int page, uint8_t fill) {
+  uint8_t buf[OLED_WIDTH * OLED_PAGES];
+  memset(buf, fill, sizeof(buf));
+  spriteDraw(buf, OLED_WIDTH, OLED_PAGES, set, frame, x, page);
+  int wrong = 0;
+  for (int y = 0; y < OLED_PAGES * 8; y++) {
+    for (int sx = 0; sx < OLED_WIDTH; sx++) {
+      int u = sx - x, v = y - page * 8;
+      bool inside = u >= 0 && u < src.width && v >= 0 && v < src.height;
+      bool expect = inside ? src.frames[frame][v * src.width + u] : (fill & 1);
+      if (pixel(buf, sx, y) != expect) wrong++;
+    }
+  }
+  return wrong;
+}
+
+static void testMatchesSources(const std::vector<SourceSprite>& sources) {
+  CHECK(sources.size() == sizeof(kSprites) / sizeof(kSprites[0]));
+  for (const auto& k : kSprites) {
+    const SourceSprite* src = nullptr;
+    for (const SourceSprite& s : sources) if (s.name == k.name) src = &s;
+    CHECK(src != nullptr);
+    if (!src) continue;
+    const SpriteSet& set = *k.set;
+    CHECK(set.width == src->width && set.height == src->height);
+    CHECK(set.frameCount == src->frames.size());
+    if (set.width != src->width || set.height != src->height || set.frameCount != src->frames.size()) continue;
+
+    int bad = 0;
+    for (int f = 0; f < set.frameCount; f++) {
+      int x = (OLED_WIDTH - set.width) / 2, page = (OLED_PAGES - set.height / 8) / 2;
+      int wrong = compareFrame(set, *src, f, x, page, 0x00) + compareFrame(set, *src, f, x, page, 0xFF);
+      wrong += compareFrame(set, *src, f, x - 30, page - 1, 0x00);   // Clipped top left
+      wrong += compareFrame(set, *src, f, x + 30, page + 2, 0x00);   // Clipped bottom right
+      if (wrong) {
+        printf("  %s frame %d: %d pixels differ\n", k.name, f, wrong);
+        bad++;
+      }
+    }
+    CHECK(bad == 0);
+  }
+}
+
+// What U8g2's drawXBM did with the old arrays: one pixel at a time from a row-major bitmap
+static void drawXbm(uint8_t* buf, int x, int y, int w, int h, const uint8_t* xbm) {
+  int rowBytes = (w + 7) / 8;
+  for (int v = 0; v < h; v++) {
+    for (int u = 0; u < w; u++) {
+      int dx = x + u, dy = y + v;
+      if (dx < 0 || dx >= OLED_WIDTH || dy < 0 || dy >= OLED_PAGES * 8) continue;
+      uint8_t* d = buf + (dy / 8) * OLED_WIDTH + dx;
+      if ((xbm[v * rowBytes + u / 8] >> (u % 8)) & 1) *d |= 1 << (dy % 8);
+      else *d &= ~(1 << (dy % 8));
+    }
+  }
+}
+
+static void benchSprites(const std::vector<SourceSprite>& sources) {
+  uint32_t rawTotal = 0, encodedTotal = 0;
+  uint8_t buf[OLED_WIDTH * OLED_PAGES];
+  volatile uint8_t sink = 0;
+  for (const auto& k : kSprites) {
+    const SpriteSet& set = *k.set;
+    uint32_t raw = set.frameCount * ((set.width + 7) / 8) * set.height;
+    uint32_t encoded = set.offsets[set.frameCount] + 2 * (set.frameCount + 1);
+    rawTotal += raw;
+    encodedTotal += encoded;
+
+    const int rounds = 2000;
+    double worst = 0;
+    BenchTimer all;
+    for (int f = 0; f < set.frameCount; f++) {
+      BenchTimer one;
+      for (int r = 0; r < rounds; r++) {
+        spriteDraw(buf, OLED_WIDTH, OLED_PAGES, set, f, 0, 0);
+        sink = sink + buf[r & 1023];
+      }
+      worst = std::max(worst, one.us() * 1000.0 / rounds);
+    }
+    std::string name = std::string("sprite.") + k.name;
+    bench((name + "_decode_avg").c_str(), all.us() * 1000.0 / (rounds * set.frameCount), "ns/frame");
+    bench((name + "_decode_worst").c_str(), worst, "ns/frame");
+  }
+  bench("sprite.flash_xbm", rawTotal, "bytes");
+  bench("sprite.flash_encoded", encodedTotal, "bytes");
+  bench("sprite.flash_saved", rawTotal - encodedTotal, "bytes");
+
+  // The old full-screen icon path, for comparison
+  for (const SourceSprite& s : sources) {
+    if (s.name != "time_date_icon") continue;
+    std::vector<uint8_t> xbm((s.width + 7) / 8 * s.height);
+    for (int v = 0; v < s.height; v++)
+      for (int u = 0; u < s.width; u++)
+        if (s.frames[0][v * s.width + u]) xbm[v * ((s.width + 7) / 8) + u / 8] |= 1 << (u % 8);
+    const int rounds = 2000;
+    BenchTimer t;
+    for (int r = 0; r < rounds; r++) {
+      drawXbm(buf, 0, 0, s.width, s.height, xbm.data());
+      sink = sink + buf[r & 1023];
+    }
+    bench("sprite.time_date_icon_drawxbm", t.us() * 1000.0 / rounds, "ns/frame");
+  }
+}
+
+int main(int argc, char** argv) {
+  std::vector<SourceSprite> sources = loadSources(argc > 1 ? argv[1] : "sprite_pixels.bin");
+  CHECK(!sources.empty());
+  if (sources.empty()) printf("no sprite pixels; run tests/sprite_pixels.py\n");
+  testMatchesSources(sources);
+  benchSprites(sources);
+  return testResult("sprite_decoder");
+}
@@ -0,0 +1,178 @@
+// TodoStore: thousands of items under a random edit load, persisted the way Kiko.ino does
+// (journal appends, compaction once the journal outgrows the snapshot) into an in-memory
+// flash. Checks the reloaded store against a plain map model, torn journal tails, and name
+// normalization; reports mutation latency, flash bytes written and load time, next to what
+// the old whole-file JSON rewrite would have written for the same edits.
+#include "todo_store.h"
+#include "kiko_test.h"
+
+#include <map>
+#include <random>
+#include <string>
+
+#define TODO_COMPACT_MIN_BYTES 4096   // As in Kiko.ino
+#define LISTS 10
+#define ITEMS_PER_LIST 500
+#define EDITS 20000                   // After one add per item to fill the lists
+
+// The two SPIFFS files and what was written to them
+struct Flash {
+  std::vector<uint8_t> snapshot, journal;
+  uint64_t bytesWritten = 0;
+  uint32_t compactions = 0;
+};
+
+// compactTodoLists() and saveTodoLists()
+static void compact(TodoStore& store, Flash& flash) {
+  store.writeSnapshot([&](const uint8_t* data, size_t len) {
+    flash.snapshot.assign(data, data + len);
+    flash.bytesWritten += len;
+  });
+  flash.journal.clear();
+  flash.compactions++;
+}
+
+static void save(TodoStore& store, Flash& flash) {
+  store.drainJournal([&](const uint8_t* data, size_t len) {
+    flash.journal.insert(flash.journal.end(), data, data + len);
+    flash.bytesWritten += len;
+  });
+  if (flash.journal.size() > std::max<size_t>(TODO_COMPACT_MIN_BYTES, flash.snapshot.size())) compact(store, flash);
+}
+
+typedef std::map<std::string, std::map<std::string, int>> Model;
+
+static int mismatches(const TodoStore& store, const Model& model) {
+  int bad = 0, items = 0;
+  for (const auto& list : model) {
+    for (const auto& item : list.second) {
+      if (store.quantity(list.first.c_str(), item.first.c_str()) != item.second) bad++;
+      items++;
+    }
+  }
+  int storeItems = 0;
+  store.forEachList([&](int l, const char*) { storeItems += store.itemCount(l); });
+  return bad + abs(storeItems - items);
+}
+
+static void testEditLoad() {
+  TodoStore store;
+  Flash flash;
+  Model model;
+  std::mt19937 rng(21);
+  char list[16], item[24];
+  uint64_t jsonRewriteBytes = 0;
+  double editUs = 0, worstUs = 0;
+  int jsonSamples = 0;
+
+  // Every list filled first, then a mix of adds, partial and full removes and rare list drops
+  for (int n = 0; n < LISTS * ITEMS_PER_LIST + EDITS; n++) {
+    bool filling = n < LISTS * ITEMS_PER_LIST;
+    int r = filling ? 0 : rng() % 2000, qty = 1 + rng() % 3;
+    snprintf(list, sizeof(list), "list%d", filling ? n / ITEMS_PER_LIST : (int)(rng() % LISTS));
+    snprintf(item, sizeof(item), "item%d", filling ? n % ITEMS_PER_LIST : (int)(rng() % ITEMS_PER_LIST));
+    bool add = r < 1100, partial = r < 1600, dropList = r == 1999;
+    BenchTimer t;
+    if (add) store.add(list, item, qty);
+    else if (dropList) store.removeList(list);
+    else store.remove(list, item, partial ? qty : 0);
+    save(store, flash);
+    double us = t.us();
+    editUs += us;
+    worstUs = std::max(worstUs, us);
+
+    if (add) {
+      model[list][item] += qty;
+    } else if (dropList) {
+      model.erase(list);
+    } else {
+      auto l = model.find(list);
+      if (l != model.end() && l->second.count(item)) {
+        int& q = l->second[item];
+        q = partial ? std::max(0, q - qty) : 0;
+        if (q == 0) l->second.erase(item);
+      }
+    }
+
+    // The old saveTodoLists() wrote {"lists":{...}} in full after every edit
+    if (n % 50 == 0) {
+      String json = "{\"lists\":";
+      store.appendJson(json);
+      json += "}";
+      jsonRewriteBytes += json.length();
+      jsonSamples++;
+    }
+  }
+  CHECK(mismatches(store, model) == 0);
+
+  int items = 0;
+  for (const auto& l : model) items += l.second.size();
+  CHECK(items > 2000);
+
+  // Reboot: snapshot then journal, as loadTodoLists() does
+  BenchTimer load;
+  TodoStore reloaded;
+  size_t a = reloaded.replay(flash.snapshot.data(), flash.snapshot.size());
+  size_t b = reloaded.replay(flash.journal.data(), flash.journal.size());
+  double loadUs = load.us();
+  CHECK(a == flash.snapshot.size() && b == flash.journal.size());
+  CHECK(mismatches(reloaded, model) == 0);
+  String before, after;
+  store.appendJson(before);
+  reloaded.appendJson(after);
+  CHECK(before == after);
+
+  bench("todo.items_live", items, "items");
+  bench("todo.edit_mean", editUs / (LISTS * ITEMS_PER_LIST + EDITS), "us");
+  bench("todo.edit_max", worstUs, "us");
+  bench("todo.flash_written_per_edit", (double)flash.bytesWritten / (LISTS * ITEMS_PER_LIST + EDITS), "bytes");
+  bench("todo.flash_written_total", flash.bytesWritten, "bytes");
+  bench("todo.compactions", flash.compactions, "");
+  bench("todo.json_rewrite_per_edit", (double)jsonRewriteBytes / jsonSamples, "bytes");
+  bench("todo.load_bytes", flash.snapshot.size() + flash.journal.size(), "bytes");
+  bench("todo.load", loadUs / 1000.0, "ms");
+  bench("todo.arena", reloaded.arenaBytes(), "bytes");
+}
+
+// Power lost mid-append: the torn record is ignored and everything before it survives
+static void testTornJournal() {
+  TodoStore store;
+  Flash flash;
+  store.add("Groceries", "Apples", 2);
+  save(store, flash);
+  size_t good = flash.journal.size();
+  store.add("Groceries", "Milk", 1);
+  save(store, flash);
+  for (size_t cut = good + 1; cut < flash.journal.size(); cut++) {
+    TodoStore r;
+    CHECK(r.replay(flash.journal.data(), cut) == good);
+    CHECK(r.quantity("groceries", "apple") == 2 && r.quantity("groceries", "milk") == 0);
+  }
+  std::vector<uint8_t> corrupt = flash.journal;
+  corrupt[good + 5] ^= 0x40;
+  TodoStore r;
+  CHECK(r.replay(corrupt.data(), corrupt.size()) == good);
+}
+
+static void testNormalization() {
+  TodoStore s;
+  s.add("My Groceries", "Apples", 2);
+  CHECK(s.add("groceries", "the apple", 1) == 3);
+  CHECK(s.add("Groceries", "Berries", 1) == 1 && s.quantity("groceries", "berry") == 1);
+  CHECK(s.add("Groceries", "tomatoes", 4) == 4 && s.quantity("groceries", "Tomato") == 4);
+  CHECK(s.add("Groceries", "glass", 1) == 1 && s.quantity("groceries", "glas") == 0);
+  CHECK(strcmp(s.itemName("groceries", "APPLES"), "Apples") == 0);
+  CHECK(s.remove("groceries", "apple", 1) == 2);
+  CHECK(s.remove("groceries", "pears", 1) == -1);
+  s.add("groceries", "Milk \"2%\"", 1);
+  String json;
+  s.appendJson(json);
+  CHECK(json == "{\"My Groceries\":{\"Apples\":2,\"Berries\":1,\"tomatoes\":4,\"glass\":1,\"Milk \\\"2%\\\"\":1}}");
+}
+
+int main() {
+  testNormalization();
+  testTornJournal();
+  testEditLoad();
+  return testResult("todo_store");
+}
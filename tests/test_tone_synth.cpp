@@ -0,0 +1,167 @@
+// Tone synthesizer: RTTTL parsing against equal temperament, rendered PCM against a
+// double-precision reference (same notes, same envelope, libm sine), render chunking,
+// the WAV header, and synthesis throughput against the old sin()-per-sample path.
+#include "tone_synth.h"
+#include "kiko_test.h"
+#include "wav_file.h"
+
+#include <cmath>
+#include <vector>
+
+// As in Kiko.ino
+static const char ALARM_RTTTL[] = "Kiko:d=16,o=6,b=140:c,e,g,c7,8p,c,e,g,c7,8p,a5,c,e,a,8p,g5,b5,d,g,4p";
+#define ALARM_SAMPLE_RATE 16000
+#define ALARM_AMPLITUDE 24000
+#define ALARM_MAX_NOTES 64
+#define ALARM_RENDER_SAMPLES 1024
+
+static double equalTemperament(int semitone, int octave) {   // semitone 0 = c
+  return 440.0 * pow(2.0, (semitone - 9) / 12.0 + (octave - 4));
+}
+
+static void testParse() {
+  RtttlNote n[ALARM_MAX_NOTES];
+  int c = rtttlParse(ALARM_RTTTL, n, ALARM_MAX_NOTES);
+  CHECK(c == 20);
+  uint32_t sixteenth = 240000 / 140 / 16;
+  CHECK(n[0].freqHz == (uint16_t)equalTemperament(0, 6) && n[0].durationMs == sixteenth);
+  CHECK(n[3].freqHz == (uint16_t)equalTemperament(0, 7));
+  CHECK(n[4].freqHz == 0 && n[4].durationMs == 240000 / 140 / 8);   // 8p
+  CHECK(n[10].freqHz == 880);                                        // a5
+  CHECK(n[19].freqHz == 0 && n[19].durationMs == 240000 / 140 / 4);
+
+  // Defaults, sharps, both dot positions, b#, and every note within 1 Hz of equal temperament
+  c = rtttlParse("T:d=4,o=5,b=120:c,c#,d.,8d#6,e.6,f4,4f#.,g,g#7,a,a#3,b,b#,p", n, ALARM_MAX_NOTES);
+  CHECK(c == 14);
+  const int semis[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const int octaves[] = {5, 5, 5, 6, 6, 4, 5, 5, 7, 5, 3, 5, 5};
+  for (int i = 0; i < 13; i++) {
+    double expect = equalTemperament(semis[i] % 12, octaves[i] + semis[i] / 12);
+    CHECK(fabs(n[i].freqHz - expect) < 1.0 + expect * 0.001);
+  }
+  CHECK(n[0].durationMs == 500 && n[2].durationMs == 750 && n[3].durationMs == 250);
+  CHECK(n[4].durationMs == 750 && n[6].durationMs == 750);
+  CHECK(n[13].freqHz == 0);
+
+  CHECK(rtttlParse("no colon here", n, ALARM_MAX_NOTES) == -1);
+  CHECK(rtttlParse("T:d=4,o=5", n, ALARM_MAX_NOTES) == -1);
+  CHECK(rtttlParse("T:d=4:c,x,e", n, ALARM_MAX_NOTES) == -1);
+  CHECK(rtttlParse(ALARM_RTTTL, n, 5) == 5);                         // Truncated, not overrun
+}
+
+// The same song rendered in doubles: envelope ramps as in ToneSynth, libm sine, no table
+static std::vector<double> referenceRender(const RtttlNote* notes, int count, uint32_t rate, int amplitude) {
+  std::vector<double> out;
+  uint32_t ramp = rate * TONE_RAMP_MS / 1000;
+  for (int k = 0; k < count; k++) {
+    uint32_t len = (uint32_t)notes[k].durationMs * rate / 1000;
+    for (uint32_t i = 0; i < len; i++) {
+      uint32_t edge = std::min(i, len - 1 - i);
+      double gain = edge >= ramp ? amplitude : (double)amplitude * edge / ramp;
+      out.push_back(notes[k].freqHz ? gain / 32768.0 * 32767.0 * sin(TWO_PI * notes[k].freqHz * i / rate) : 0.0);
+    }
+  }
+  return out;
+}
+
+static std::vector<int16_t> render(const RtttlNote* notes, int count, size_t chunk) {
+  ToneSynth synth;
+  synth.begin(notes, count, ALARM_SAMPLE_RATE, ALARM_AMPLITUDE);
+  std::vector<int16_t> pcm, block(chunk);
+  size_t n;
+  while ((n = synth.render(block.data(), chunk)) > 0) pcm.insert(pcm.end(), block.begin(), block.begin() + n);
+  CHECK(synth.done());
+  return pcm;
+}
+
+static void testPcmMatchesReference() {
+  RtttlNote n[ALARM_MAX_NOTES];
+  int c = rtttlParse(ALARM_RTTTL, n, ALARM_MAX_NOTES);
+  std::vector<int16_t> pcm = render(n, c, ALARM_RENDER_SAMPLES);
+  std::vector<double> ref = referenceRender(n, c, ALARM_SAMPLE_RATE, ALARM_AMPLITUDE);
+  CHECK(pcm.size() == ToneSynth::totalSamples(n, c, ALARM_SAMPLE_RATE));
+  CHECK(pcm.size() == ref.size());
+
+  double maxErr = 0, signal = 0, noise = 0;
+  for (size_t i = 0; i < std::min(pcm.size(), ref.size()); i++) {
+    double e = pcm[i] - ref[i];
+    maxErr = std::max(maxErr, fabs(e));
+    signal += ref[i] * ref[i];
+    noise += e * e;
+  }
+  double snr = 10 * log10(signal / noise);
+  CHECK(maxErr <= 8);                 // 256-entry table with linear interpolation
+  CHECK(snr > 70);
+  bench("tone.pcm_max_error", maxErr, "lsb");
+  bench("tone.pcm_snr", snr, "dB");
+
+  // Chunk size does not change a single sample
+  for (size_t chunk : {1, 7, 160, 333, 4096}) CHECK(render(n, c, chunk) == pcm);
+
+  // Notes start and end at silence: no clicks at the boundaries
+  size_t pos = 0;
+  for (int k = 0; k < c; k++) {
+    pos += (uint32_t)n[k].durationMs * ALARM_SAMPLE_RATE / 1000;
+    CHECK(abs(pcm[pos - 1]) < ALARM_AMPLITUDE / 8);
+  }
+}
+
+// The header plus the rendered PCM is a WAV any reader accepts
+static void testWavFile() {
+  RtttlNote n[ALARM_MAX_NOTES];
+  int c = rtttlParse(ALARM_RTTTL, n, ALARM_MAX_NOTES);
+  std::vector<int16_t> pcm = render(n, c, ALARM_RENDER_SAMPLES);
+  uint8_t header[TONE_WAV_HEADER_BYTES];
+  toneWavHeader(header, ALARM_SAMPLE_RATE, pcm.size() * 2);
+  FILE* f = fopen("alarm_tone.wav", "wb");
+  CHECK(f != nullptr);
+  if (!f) return;
+  fwrite(header, 1, sizeof(header), f);
+  fwrite(pcm.data(), 2, pcm.size(), f);
+  fclose(f);
+  WavClip clip;
+  CHECK(readWav("alarm_tone.wav", clip));
+  CHECK(clip.sampleRate == ALARM_SAMPLE_RATE && clip.samples == pcm);
+}
+
+static void benchSynthesis() {
+  RtttlNote n[ALARM_MAX_NOTES];
+  int c = rtttlParse(ALARM_RTTTL, n, ALARM_MAX_NOTES);
+  uint32_t total = ToneSynth::totalSamples(n, c, ALARM_SAMPLE_RATE);
+  int16_t block[ALARM_RENDER_SAMPLES];
+  volatile int32_t sink = 0;
+  const int rounds = 200;
+
+  BenchTimer t;
+  for (int r = 0; r < rounds; r++) {
+    ToneSynth synth;
+    synth.begin(n, c, ALARM_SAMPLE_RATE, ALARM_AMPLITUDE);
+    while (synth.render(block, ALARM_RENDER_SAMPLES) > 0) sink = sink + block[0];
+  }
+  double us = t.us();
+  bench("tone.synth_throughput", (double)rounds * total / us, "Msamples/s");
+  bench("tone.alarm_render", us / rounds, "us");
+
+  // The old /rtttl/alarm loop: a float phase and sin() per sample
+  BenchTimer old;
+  for (int r = 0; r < rounds; r++) {
+    for (int k = 0; k < c; k++) {
+      uint32_t len = (uint32_t)n[k].durationMs * ALARM_SAMPLE_RATE / 1000;
+      for (uint32_t i = 0; i < len; i++) {
+        float phase = 2.0 * 3.14159265 * n[k].freqHz * i / ALARM_SAMPLE_RATE;
+        sink = sink + (int16_t)(10000.0 * sin(phase));
+      }
+    }
+  }
+  bench("tone.sin_per_sample_throughput", (double)rounds * total / old.us(), "Msamples/s");
+  bench("tone.alarm_send_calls_old", 44 + 2.0 * total, "calls");
+  bench("tone.alarm_send_calls", 1 + (total + ALARM_RENDER_SAMPLES / 2 - 1) / (ALARM_RENDER_SAMPLES / 2), "calls");
+}
+
+int main() {
+  testParse();
+  testPcmMatchesReference();
+  testWavFile();
+  benchSynthesis();
+  return testResult("tone_synth");
+}
@@ -0,0 +1,121 @@
+// Tool dispatch: a model turn that calls several tools, run through runToolCalls() (weather and
+// search on worker tasks, the rest on the calling task) and, as the old dispatcher did, one
+// runTool() after another in call order. The sketch is set up against the mock APIs, which
+// answer weather and search after MockLatency::toolMs. Checks both give the same results in
+// call order, that calls to different APIs overlap, and reports the wall time of each per
+// turn. Calls to the same API still queue for its one pooled connection (two_weathers). Every
+// round asks for a new city and query, so neither path is answered from the tool cache.
+//
+// Usage: test_tool_dispatch <fixtures directory>
+#include "Kiko.ino"
+#include "kiko_test.h"
+#include "mock_api_server.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define TOOL_DISPATCH_ROUNDS 5
+
+static const char* const CITIES[] = {"Lisbon", "Porto", "Madrid", "Paris", "Berlin", "Oslo", "Rome",
+                                     "Vienna", "Prague", "Dublin", "Athens"};
+
+struct DispatchCase {
+  const char* name;
+  std::vector<const char*> tools;
+  bool overlaps;                // Network calls go to different hosts
+};
+
+static const DispatchCase CASES[] = {
+    {"weather_search", {"get_weather", "google_search"}, true},
+    {"weather_search_todo", {"get_weather", "google_search", "add_todo_item"}, true},
+    {"two_weathers", {"get_weather", "get_weather"}, false},
+};
+
+static uint32_t nextArg = 0;
+
+static std::vector<GptToolCall> makeCalls(const DispatchCase& c) {
+  std::vector<GptToolCall> calls;
+  for (size_t i = 0; i < c.tools.size(); i++) {
+    String tool = c.tools[i];
+    String arg = CITIES[nextArg++ % (sizeof(CITIES) / sizeof(CITIES[0]))];
+    arg += " " + String(nextArg);   // Never cached
+    String args = tool == "get_weather"     ? "{\"city\":\"" + arg + "\"}"
+                  : tool == "google_search" ? "{\"query\":\"history of " + arg + "\"}"
+                                            : "{\"list_name\":\"dispatch\",\"item\":\"" + arg + "\"}";
+    calls.push_back({tool, args, "call_" + String((unsigned)i)});
+  }
+  return calls;
+}
+
+// The old dispatcher: every call on the calling task, in order
+static std::vector<String> runSequentially(const std::vector<GptToolCall>& calls) {
+  std::vector<String> results;
+  for (const GptToolCall& call : calls) {
+    JsonDocument args;
+    deserializeJson(args, call.toolArguments);
+    results.push_back(runTool(findTool(call.toolToCall), args.as<JsonObject>()));
+  }
+  saveToolCache();
+  return results;
+}
+
+static bool sameShape(const std::vector<String>& a, const std::vector<String>& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].length() == 0 || b[i].length() == 0 || a[i] == PHRASE_TOOL_FAILED || b[i] == PHRASE_TOOL_FAILED) return false;
+  }
+  return true;
+}
+
+static void runCase(const DispatchCase& c, MockApiServer& mock) {
+  double sequentialMs = 0, concurrentMs = 0;
+  for (int round = 0; round < TOOL_DISPATCH_ROUNDS; round++) {
+    std::vector<GptToolCall> calls = makeCalls(c);
+    BenchTimer sequentialTimer;
+    std::vector<String> sequential = runSequentially(calls);
+    sequentialMs += sequentialTimer.us() / 1000;
+
+    calls = makeCalls(c);
+    uint64_t requests = mock.stats[MOCK_WEATHER].requests + mock.stats[MOCK_SEARCH].requests;
+    bool allBypass = false;
+    BenchTimer concurrentTimer;
+    std::vector<String> concurrent = runToolCalls(calls, allBypass);
+    concurrentMs += concurrentTimer.us() / 1000;
+
+    CHECK(sameShape(sequential, concurrent));
+    CHECK(!allBypass);
+    size_t networkCalls = 0;
+    for (const char* tool : c.tools) networkCalls += strcmp(tool, "add_todo_item") != 0;
+    CHECK(mock.stats[MOCK_WEATHER].requests + mock.stats[MOCK_SEARCH].requests == requests + networkCalls);
+  }
+  if (c.overlaps) CHECK(concurrentMs < sequentialMs * 0.75);
+  std::string name = std::string("tool_dispatch.") + c.name;
+  bench((name + ".sequential").c_str(), sequentialMs / TOOL_DISPATCH_ROUNDS, "ms");
+  bench((name + ".concurrent").c_str(), concurrentMs / TOOL_DISPATCH_ROUNDS, "ms");
+}
+
+// The sketch's tasks never return, so the test ends the process
+static int finish() {
+  int result = testResult("tool_dispatch");
+  fflush(stdout);
+  _exit(result);
+}
+
+int main(int argc, char** argv) {
+  std::string fixtures = argc > 1 ? argv[1] : "fixtures";
+  static MockApiServer mock;
+  bool mocking = mock.begin(fixtures + "/api");
+  CHECK(mocking);
+  if (!mocking) return finish();
+  mock.routeSketchHosts();
+
+  hostFsRoot() = "tool_dispatch_fs";
+  std::filesystem::remove_all(hostFsRoot());
+  hostSkipDelays() = true;
+  setup();
+  hostSkipDelays() = false;
+
+  for (const DispatchCase& c : CASES) runCase(c, mock);
+  return finish();
+}
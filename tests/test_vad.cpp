@@ -0,0 +1,197 @@
+// Voice activity detection: the vector kernel matches the reference, and over a corpus of
+// clips the trimmed upload keeps all speech while dropping silence and speech-free clips.
+//
+// The corpus is synthesized (voiced syllables, fricatives, room and fan noise, a PDM DC
+// offset, pad clicks) and written to vad_corpus/ next to the binary with its labels.
+// Set KIKO_VAD_CORPUS to a directory of 8 kHz WAV recordings to benchmark those instead;
+// unlabeled clips are only measured, not checked.
+#include "vad.h"
+#include "kiko_test.h"
+#include "wav_file.h"
+#include "clip_synth.h"
+
+#include <map>
+#include <random>
+
+#define SAMPLE_RATE 8000
+#define VAD_PREROLL_MS 250         // As in Kiko.ino
+#define VAD_TAIL_MS 300
+#define VAD_END_SILENCE_MS 1200
+
+// ---------- Corpus ----------
+
+static std::vector<LabeledClip> makeCorpus() {
+  std::vector<LabeledClip> corpus;
+  {
+    ClipSynth s(1);   // "What time is it?" in a quiet room, long hold after
+    s.silence(1200);
+    for (int w = 0; w < 4; w++) s.word(120, 2500);
+    s.silence(1600);
+    corpus.push_back(s.finish("quiet_question", 40, 0, 0, 0));
+  }
+  {
+    ClipSynth s(2);   // Starts on a fricative ("set an alarm") next to a fan
+    s.silence(700);
+    s.fricative(120, 900);
+    for (int w = 0; w < 5; w++) s.word(190, 3000);
+    s.silence(1400);
+    corpus.push_back(s.finish("fan_fricative_onset", 40, 350, 0, 0));
+  }
+  {
+    ClipSynth s(3);   // PDM microphone with a large DC offset, quiet talker
+    s.silence(900);
+    for (int w = 0; w < 3; w++) s.word(210, 1200);
+    s.silence(1300);
+    corpus.push_back(s.finish("dc_offset_soft", 30, 0, -1400, 0));
+  }
+  {
+    ClipSynth s(4);   // Thinking pause shorter than the end-of-turn silence
+    s.silence(500);
+    for (int w = 0; w < 3; w++) s.word(140, 2800);
+    s.silence(800);
+    for (int w = 0; w < 3; w++) s.word(140, 2800);
+    s.silence(1500);
+    corpus.push_back(s.finish("mid_pause", 50, 100, 0, 0));
+  }
+  {
+    ClipSynth s(5);   // Held the pad and said nothing
+    s.silence(3000);
+    corpus.push_back(s.finish("silence_only", 40, 0, 0, 0));
+  }
+  {
+    ClipSynth s(6);   // Nothing said, but the pad was tapped and a fan is running
+    s.silence(2500);
+    corpus.push_back(s.finish("clicks_and_fan", 40, 300, 0, 4));
+  }
+  {
+    ClipSynth s(7);   // Speech right from the first frame (pre-roll cannot be used)
+    for (int w = 0; w < 4; w++) s.word(170, 2600);
+    s.silence(1300);
+    corpus.push_back(s.finish("immediate_start", 40, 0, 0, 0));
+  }
+  return corpus;
+}
+
+// ---------- Recording emulation ----------
+
+struct Trim {
+  bool detected = false;
+  int start = 0;                   // Uploaded span [start, end) of the clip
+  int end = 0;
+  float usPerFrame = 0;
+};
+
+// What recordAudio() keeps: pre-roll before the onset, a tail after the last speech
+// frame, recording stopped after VAD_END_SILENCE_MS of silence; nothing without speech
+static Trim runVad(const std::vector<int16_t>& clip) {
+  VoiceActivityDetector vad;
+  vad.reset();
+  int pos = 0;
+  for (; pos + VAD_FRAME_SAMPLES <= (int)clip.size(); pos += VAD_FRAME_SAMPLES) {
+    vad.process(&clip[pos], pos);
+    if (vad.speechDetected() && pos - (int)vad.speechEnd() > SAMPLE_RATE * VAD_END_SILENCE_MS / 1000) break;
+  }
+  Trim t;
+  t.usPerFrame = vad.microsPerFrame();
+  t.detected = vad.speechDetected();
+  if (!t.detected) return t;
+  t.start = std::max(0, (int)vad.speechStart() - SAMPLE_RATE * VAD_PREROLL_MS / 1000);
+  t.end = std::min((int)clip.size(), (int)vad.speechEnd() + SAMPLE_RATE * VAD_TAIL_MS / 1000);
+  return t;
+}
+
+// ---------- Tests ----------
+
+static void testKernelsMatch() {
+  std::mt19937 g(1);
+  int16_t x[VAD_FRAME_SAMPLES];
+  for (int t = 0; t < 20000; t++) {
+    int n = VAD_FRAME_SAMPLES - (t % 4);
+    int range = (t % 3 == 0) ? 65536 : 4000;
+    for (int i = 0; i < n; i++) x[i] = (int16_t)((int)(g() % range) - range / 2);
+    int16_t dc = (int16_t)(g() % 2000 - 1000);
+    VadFrameStats a = vadFrameStatsRef(x, n, dc), b = vadFrameStats(x, n, dc);
+    CHECK(a.sum == b.sum && a.sumSq == b.sumSq && a.crossings == b.crossings);
+  }
+}
+
+static void benchCorpus() {
+  std::vector<LabeledClip> clips;
+  const char* external = getenv("KIKO_VAD_CORPUS");
+  if (external) {
+    for (const std::string& path : listWavs(external)) {
+      WavClip w;
+      if (!readWav(path, w) || w.sampleRate != SAMPLE_RATE) {
+        printf("skipping %s (not 16-bit %d Hz)\n", path.c_str(), SAMPLE_RATE);
+        continue;
+      }
+      LabeledClip c;
+      c.name = strdup(path.c_str());
+      c.samples = w.samples;
+      clips.push_back(c);
+    }
+  } else {
+    clips = makeCorpus();
+    makeDir("vad_corpus");
+    FILE* labels = fopen("vad_corpus/labels.txt", "w");
+    for (const LabeledClip& c : clips) {
+      writeWav(std::string("vad_corpus/") + c.name + ".wav", c.samples, SAMPLE_RATE);
+      if (labels) fprintf(labels, "%s %d %d\n", c.name, c.speechStart, c.speechEnd);
+    }
+    if (labels) fclose(labels);
+  }
+
+  uint64_t capturedBytes = 0, uploadedBytes = 0;
+  double frameUs = 0;
+  int frames = 0;
+  printf("%-22s %8s %8s %6s  %s\n", "clip", "captured", "uploaded", "saved", "speech kept");
+  for (const LabeledClip& c : clips) {
+    Trim t = runVad(c.samples);
+    uint32_t captured = c.samples.size() * 2;
+    uint32_t uploaded = t.detected ? (t.end - t.start) * 2 : 0;
+    capturedBytes += captured;
+    uploadedBytes += uploaded;
+    frameUs += t.usPerFrame * (c.samples.size() / VAD_FRAME_SAMPLES);
+    frames += c.samples.size() / VAD_FRAME_SAMPLES;
+    const char* verdict = "-";
+    if (!external) {
+      bool hasSpeech = c.speechStart >= 0;
+      bool ok = hasSpeech ? (t.detected && t.start <= c.speechStart && t.end >= c.speechEnd) : !t.detected;
+      verdict = hasSpeech ? (ok ? "all" : "CLIPPED") : (ok ? "dropped (no speech)" : "UPLOADED NOISE");
+      CHECK(ok);
+      if (!ok) printf("  %s: truth %d..%d, kept %d..%d\n", c.name, c.speechStart, c.speechEnd, t.start, t.end);
+    }
+    printf("%-22s %8u %8u %5.0f%%  %s\n", c.name, captured, uploaded, 100.0 * (captured - uploaded) / captured, verdict);
+  }
+  bench("vad.corpus_captured", capturedBytes, "bytes");
+  bench("vad.corpus_uploaded", uploadedBytes, "bytes");
+  bench("vad.corpus_saved", 100.0 * (capturedBytes - uploadedBytes) / capturedBytes, "%");
+  bench("vad.process_per_frame", frameUs / frames * 1000.0, "ns");
+}
+
+static void benchKernels() {
+  std::mt19937 g(3);
+  std::vector<int16_t> x(VAD_FRAME_SAMPLES * 1024);
+  for (auto& v : x) v = (int16_t)(g() % 8000 - 4000);
+  const int rounds = 50;
+  volatile uint64_t sink = 0;
+  BenchTimer ref;
+  for (int r = 0; r < rounds; r++) {
+    for (size_t p = 0; p < x.size(); p += VAD_FRAME_SAMPLES) sink = sink + vadFrameStatsRef(&x[p], VAD_FRAME_SAMPLES, 12).sumSq;
+  }
+  double refNs = ref.us() * 1000.0 / (rounds * 1024);
+  BenchTimer fast;
+  for (int r = 0; r < rounds; r++) {
+    for (size_t p = 0; p < x.size(); p += VAD_FRAME_SAMPLES) sink = sink + vadFrameStats(&x[p], VAD_FRAME_SAMPLES, 12).sumSq;
+  }
+  double fastNs = fast.us() * 1000.0 / (rounds * 1024);
+  bench("vad.kernel_reference_per_frame", refNs, "ns");
+  bench("vad.kernel_unrolled_per_frame", fastNs, "ns");
+}
+
+int main() {
+  testKernelsMatch();
+  benchCorpus();
+  benchKernels();
+  return testResult("vad");
+}
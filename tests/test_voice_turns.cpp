@@ -0,0 +1,383 @@
+// Whole-sketch harness: Kiko.ino runs on the host against the shims in host/, with its API
+// hosts routed to the stand-ins in mock_api_server.h. Each row of fixtures/voice_turns.tsv is
+// one voice turn: the pad is held, a synthesized clip is played into the microphone in real
+// time, the pad is released, and the turn is read back from /api/runtime as the dashboard
+// reads it. Checks that every turn is answered on the expected path (local intent, model,
+// model with a tool) and reports per turn and overall: release-to-transcript, reply and
+// time-to-first-audio latency, stage p50/p95, the heap high-water mark above idle, and the
+// bytes sent to each API and to a connected dashboard.
+//
+// Responsiveness while turns run: a dashboard polls /api/state every HARNESS_POLL_MS
+// throughout, and its worst and p95 round trip are reported next to the sketch's own worst
+// web loop gap and touch latency from /api/runtime. Each turn reports how long after the
+// hold was recognized (TOUCH_LONG_PRESS_MS into the press) the pipeline was listening; a last
+// turn presses the pad while the chat reply is still speaking (barge-in).
+//
+// test_voice_turns_buffered is the same sketch with the Whisper upload sent after the release
+// (WHISPER_STREAMING_UPLOAD=0); its .transcribe lines against these show what streaming the
+// upload during the recording saves. The mock reads uploads at the device's uplink rate.
+//
+// Speech plays back HARNESS_PLAYBACK_SPEED times faster than on the device, which shortens
+// the reply and total latencies but none of the others. setup() runs with delay() skipped.
+//
+// Usage: test_voice_turns <fixtures directory>
+#include "Kiko.ino"
+#include "kiko_test.h"
+#include "clip_synth.h"
+#include "mock_api_server.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define HARNESS_PLAYBACK_SPEED 4
+#define HARNESS_TURN_TIMEOUT_MS 40000
+#define HARNESS_POLL_MS 20
+
+// Bench lines are named after the build, so variants of the sketch can be compared
+#ifndef HARNESS_NAME
+#define HARNESS_NAME "voice_turns"
+#endif
+
+struct VoiceTurn {
+  std::string name;
+  int words = 0;
+  float f0 = 0;
+  MockTurn mock;
+  bool local = false;           // Answered by a local intent
+};
+
+static std::vector<VoiceTurn> loadTurns(const std::string& path) {
+  std::vector<VoiceTurn> out;
+  FILE* f = fopen(path.c_str(), "r");
+  if (!f) return out;
+  char line[1024];
+  while (fgets(line, sizeof(line), f)) {
+    std::string s(line);
+    while (!s.empty() && (s.back() == '\n' || s.back() == '\r')) s.pop_back();
+    if (s.empty() || s[0] == '#') continue;
+    std::vector<std::string> cols;
+    for (size_t start = 0;;) {
+      size_t tab = s.find('\t', start);
+      cols.push_back(s.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+      if (tab == std::string::npos) break;
+      start = tab + 1;
+    }
+    if (cols.size() != 6) continue;
+    VoiceTurn t;
+    t.name = cols[0];
+    t.words = atoi(cols[1].c_str());
+    t.f0 = atof(cols[2].c_str());
+    t.mock.transcript = cols[3];
+    if (cols[4] != "-") {
+      size_t sp = cols[4].find(' ');
+      t.mock.toolName = cols[4].substr(0, sp);
+      t.mock.toolArgs = sp == std::string::npos ? "{}" : cols[4].substr(sp + 1);
+    }
+    t.local = cols[5] == "-";
+    if (!t.local) t.mock.reply = cols[5];
+    out.push_back(t);
+  }
+  fclose(f);
+  return out;
+}
+
+// Words at the talker's pitch in a quiet room, with a short pause before the pad is released
+static LabeledClip synthesize(const VoiceTurn& turn, uint32_t seed) {
+  ClipSynth s(seed);
+  s.silence(300);
+  for (int w = 0; w < turn.words; w++) s.word(turn.f0, 2600);
+  s.silence(400);
+  return s.finish(turn.name.c_str(), 40, 0, 0, 0);
+}
+
+// ---------- Dashboard side ----------
+
+// GET from the sketch's web server, as the dashboard does. Returns the status, or -1.
+static int httpGet(const char* path, std::string& body) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(server.hostPort());
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  std::string req = std::string("GET ") + path + " HTTP/1.1\r\nHost: kiko.local\r\nConnection: close\r\n\r\n";
+  send(fd, req.data(), req.size(), MSG_NOSIGNAL);
+  std::string wire;
+  char buf[4096];
+  ssize_t n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) wire.append(buf, n);
+  close(fd);
+  size_t end = wire.find("\r\n\r\n");
+  if (wire.compare(0, 9, "HTTP/1.1 ") != 0 || end == std::string::npos) return -1;
+  body = wire.substr(end + 4);
+  if (wire.find("Transfer-Encoding: chunked") < end) {
+    std::string plain;
+    for (size_t at = 0; at < body.size();) {
+      size_t eol = body.find("\r\n", at);
+      if (eol == std::string::npos) break;
+      size_t len = strtoul(body.c_str() + at, nullptr, 16);
+      if (len == 0) break;
+      plain += body.substr(eol + 2, len);
+      at = eol + 2 + len + 2;
+    }
+    body = plain;
+  }
+  return atoi(wire.c_str() + 9);
+}
+
+struct TurnRecord {
+  uint32_t seq = 0;
+  bool local = false;
+  uint32_t transcribeMs = 0, replyMs = 0, firstAudioMs = 0, totalMs = 0, uploadBytes = 0;
+};
+
+static bool readLastTurn(TurnRecord& r) {
+  std::string body;
+  if (httpGet("/api/runtime", body) != 200) return false;
+  JsonDocument doc;
+  if (deserializeJson(doc, body.c_str()) != DeserializationError::Ok) return false;
+  JsonObject turn = doc["lastTurn"];
+  if (turn.isNull()) return false;
+  r.seq = turn["seq"];
+  r.local = turn["path"] == "local";
+  r.transcribeMs = turn["transcribeMs"];
+  r.replyMs = turn["replyMs"];
+  r.firstAudioMs = turn["firstAudioMs"];
+  r.totalMs = turn["totalMs"];
+  r.uploadBytes = turn["uploadBytes"];
+  return true;
+}
+
+struct RuntimeRecord {
+  uint32_t webLoopMaxGapMs = 0, touchLatencyMaxMs = 0;
+};
+
+static bool readRuntime(RuntimeRecord& r) {
+  std::string body;
+  if (httpGet("/api/runtime", body) != 200) return false;
+  JsonDocument doc;
+  if (deserializeJson(doc, body.c_str()) != DeserializationError::Ok) return false;
+  r.webLoopMaxGapMs = doc["webLoopMaxGapMs"];
+  r.touchLatencyMaxMs = doc["touchLatencyMaxMs"];
+  return true;
+}
+
+// A dashboard polling the state API for as long as the scenario runs
+class DashboardPoller {
+ public:
+  void start() {
+    thread_ = std::thread([this] {
+      while (!stop_) {
+        std::string body;
+        BenchTimer timer;
+        int status = httpGet("/api/state", body);
+        double ms = timer.us() / 1000;
+        if (status == 200) roundTripsMs_.push_back(ms);
+        else failures_++;
+        delay(HARNESS_POLL_MS);
+      }
+    });
+  }
+  void stop() {
+    stop_ = true;
+    thread_.join();
+  }
+  uint32_t failures() const { return failures_; }
+  size_t requests() const { return roundTripsMs_.size(); }
+  double quantileMs(double q) {
+    if (roundTripsMs_.empty()) return 0;
+    std::sort(roundTripsMs_.begin(), roundTripsMs_.end());
+    return roundTripsMs_[std::min(roundTripsMs_.size() - 1, (size_t)(q * roundTripsMs_.size()))];
+  }
+
+ private:
+  std::thread thread_;
+  std::atomic<bool> stop_{false};
+  std::vector<double> roundTripsMs_;
+  uint32_t failures_ = 0;
+};
+
+// ---------- Scenario ----------
+
+template <typename Cond>
+static bool waitUntil(Cond cond, uint32_t timeoutMs) {
+  unsigned long start = millis();
+  while (!cond()) {
+    if (millis() - start > timeoutMs) return false;
+    delay(5);
+  }
+  return true;
+}
+
+struct Totals {
+  uint32_t turns = 0;
+  uint64_t transcribeMs = 0, replyMs = 0, firstAudioMs = 0, totalMs = 0;
+  size_t heapPeak = 0;          // Above what was live when the turn started
+};
+
+static MockApiServer mock;
+static std::vector<VoiceTurn> turns;
+
+static void benchHarness(const std::string& what, double value, const char* unit) {
+  bench((HARNESS_NAME "." + what).c_str(), value, unit);
+}
+
+// loop() and the sketch's tasks never return, so the scenario ends the process
+static void finish() {
+  int result = testResult(HARNESS_NAME);
+  fflush(stdout);
+  _exit(result);
+}
+
+// Holds the pad, plays the clip into the microphone and releases the pad. Returns the time
+// from the hold being recognized to the pipeline listening, or -1 if it never listened.
+static double speakTurn(const VoiceTurn& turn, uint32_t seed) {
+  LabeledClip clip = synthesize(turn, seed);
+  mock.script(turn.mock);
+  BenchTimer pressed;
+  hostPins().touch[BUTTON_PIN] = TOUCH_THRESHOLD + 6000;
+  bool listening = waitUntil([] { return aiState() == AI_LISTENING; }, 3000);
+  double touchMs = pressed.us() / 1000 - TOUCH_LONG_PRESS_MS;
+  CHECK(listening);
+  hostMicPlay(clip.samples.data(), clip.samples.size());
+  waitUntil([] { return hostMicQueued() == 0; }, 20000);
+  hostPins().touch[BUTTON_PIN] = 0;
+  return listening ? touchMs : -1;
+}
+
+// A barge-in turn presses the pad while the previous turn is speaking; that turn is
+// finished (interrupted) before this one, so its answer is the second one after `before`.
+static void runTurn(const VoiceTurn& turn, uint32_t seed, Totals& totals, bool bargeIn = false) {
+  TurnRecord before;
+  readLastTurn(before);
+  uint32_t answerSeq = before.seq + (bargeIn ? 2 : 1);
+  uint32_t toolResults = mock.chat.toolResults;
+  size_t idleHeap = hostHeapLive();
+  hostHeapResetPeak();
+
+  double touchMs = speakTurn(turn, seed);
+
+  TurnRecord r;
+  bool answered = waitUntil([&] { return readLastTurn(r) && r.seq >= answerSeq; }, HARNESS_TURN_TIMEOUT_MS);
+  waitUntil([] { return aiState() == AI_IDLE; }, HARNESS_TURN_TIMEOUT_MS);
+  CHECK(answered);
+  if (!answered) {
+    printf("turn %s: no answer\n", turn.name.c_str());
+    return;
+  }
+  CHECK(r.local == turn.local);
+  if (!turn.mock.toolName.empty()) CHECK(mock.chat.toolResults == toolResults + 1);
+  CHECK(r.uploadBytes > 0);
+
+  benchHarness(turn.name + ".hold_to_listening", touchMs, "ms");
+  benchHarness(turn.name + ".transcribe", r.transcribeMs, "ms");
+  benchHarness(turn.name + ".first_audio", r.firstAudioMs, "ms");
+  benchHarness(turn.name + ".reply", r.replyMs, "ms");
+  benchHarness(turn.name + ".total", r.totalMs, "ms");
+  benchHarness(turn.name + ".upload", r.uploadBytes, "bytes");
+  totals.turns++;
+  totals.transcribeMs += r.transcribeMs;
+  totals.replyMs += r.replyMs;
+  totals.firstAudioMs += r.firstAudioMs;
+  totals.totalMs += r.totalMs;
+  totals.heapPeak = std::max(totals.heapPeak, hostHeapPeak() - idleHeap);
+}
+
+static void runScenario() {
+  bool introDone = waitUntil([] { return __atomic_load_n(&introSpoken, __ATOMIC_ACQUIRE); }, 60000);
+  CHECK(introDone);
+  if (!introDone) finish();
+
+  int dashboard = webSocket.hostConnect(IPAddress(192, 168, 1, 20));
+  webSocket.hostSend(dashboard, "{\"type\":\"hello\",\"since\":0,\"epoch\":0}");
+
+  uint64_t apiBytes[MOCK_API_COUNT][2];
+  for (int i = 0; i < MOCK_API_COUNT; i++) {
+    apiBytes[i][0] = mock.stats[i].bytesIn;
+    apiBytes[i][1] = mock.stats[i].bytesOut;
+  }
+  uint64_t wsBytes = webSocket.hostClient(dashboard).wireBytes;
+
+  DashboardPoller poller;
+  poller.start();
+
+  Totals totals;
+  for (size_t i = 0; i < turns.size(); i++) runTurn(turns[i], i + 1, totals);
+  CHECK(totals.turns == turns.size());
+
+  // Barge-in: the chat turn is interrupted while it speaks by the next press
+  auto talker = std::find_if(turns.begin(), turns.end(), [](const VoiceTurn& t) { return !t.local && t.mock.toolName.empty(); });
+  auto local = std::find_if(turns.begin(), turns.end(), [](const VoiceTurn& t) { return t.local; });
+  if (talker != turns.end() && local != turns.end()) {
+    speakTurn(*talker, turns.size() + 1);
+    bool speaking = waitUntil([] { return aiState() == AI_SPEAKING; }, HARNESS_TURN_TIMEOUT_MS);
+    CHECK(speaking);
+    VoiceTurn bargeIn = *local;
+    bargeIn.name = "barge_in";
+    Totals bargeInTotals;
+    if (speaking) runTurn(bargeIn, turns.size() + 2, bargeInTotals, true);
+    CHECK(bargeInTotals.turns == 1);
+  }
+
+  poller.stop();
+  CHECK(poller.failures() == 0);
+  benchHarness("web_requests", poller.requests(), "requests");
+  benchHarness("web_request_p95", poller.quantileMs(0.95), "ms");
+  benchHarness("web_request_max", poller.quantileMs(1.0), "ms");
+  RuntimeRecord runtime;
+  if (readRuntime(runtime)) {
+    benchHarness("web_loop_max_gap", runtime.webLoopMaxGapMs, "ms");
+    benchHarness("touch_latency_max", runtime.touchLatencyMaxMs, "ms");
+  }
+
+  if (totals.turns) {
+    benchHarness("mean_transcribe", (double)totals.transcribeMs / totals.turns, "ms");
+    benchHarness("mean_first_audio", (double)totals.firstAudioMs / totals.turns, "ms");
+    benchHarness("mean_reply", (double)totals.replyMs / totals.turns, "ms");
+    benchHarness("mean_total", (double)totals.totalMs / totals.turns, "ms");
+  }
+  benchHarness("heap_peak_above_idle", totals.heapPeak, "bytes");
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    if (stageLatency[i].count() == 0) continue;
+    benchHarness(std::string("stage_") + STAGE_NAMES[i] + "_p50", stageLatency[i].quantileMs(0.5f), "ms");
+    benchHarness(std::string("stage_") + STAGE_NAMES[i] + "_p95", stageLatency[i].quantileMs(0.95f), "ms");
+  }
+  for (int i = 0; i < MOCK_API_COUNT; i++) {
+    if (mock.stats[i].requests == 0) continue;
+    std::string name = std::string("api_") + MOCK_API_NAMES[i];
+    benchHarness(name + "_sent", mock.stats[i].bytesIn - apiBytes[i][0], "bytes");
+    benchHarness(name + "_received", mock.stats[i].bytesOut - apiBytes[i][1], "bytes");
+    benchHarness(name + "_connections", mock.stats[i].connections, "connections");
+  }
+  benchHarness("dashboard_ws", webSocket.hostClient(dashboard).wireBytes - wsBytes, "bytes");
+  finish();
+}
+
+int main(int argc, char** argv) {
+  std::string fixtures = argc > 1 ? argv[1] : "fixtures";
+  turns = loadTurns(fixtures + "/voice_turns.tsv");
+  CHECK(!turns.empty());
+  bool mocking = mock.begin(fixtures + "/api");
+  CHECK(mocking);
+  if (turns.empty() || !mocking) return testResult(HARNESS_NAME);
+  mock.routeSketchHosts();
+
+  // A fresh flash per run: a speech cache left over from the last run would change the timings
+  hostFsRoot() = HARNESS_NAME "_fs";
+  std::filesystem::remove_all(hostFsRoot());
+  hostPlaybackSpeed() = HARNESS_PLAYBACK_SPEED;
+
+  hostSkipDelays() = true;
+  setup();
+  hostSkipDelays() = false;
+
+  std::thread(runScenario).detach();
+  for (;;) loop();
+}
@@ -0,0 +1,96 @@
+/*
+  16-bit mono PCM WAV files for the host tests: corpora are written next to
+  the test binary so they can be listened to, and any directory of WAVs
+  (e.g. real recordings) can be fed to the same benchmark.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+struct WavClip {
+  std::string name;
+  uint32_t sampleRate = 0;
+  std::vector<int16_t> samples;
+};
+
+inline void wavPut32(uint8_t* p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+inline bool writeWav(const std::string& path, const std::vector<int16_t>& samples, uint32_t sampleRate) {
+  uint8_t h[44];
+  uint32_t data = samples.size() * 2;
+  memcpy(h, "RIFF", 4);
+  wavPut32(h + 4, 36 + data);
+  memcpy(h + 8, "WAVEfmt ", 8);
+  wavPut32(h + 16, 16);
+  h[20] = 1; h[21] = 0;              // PCM
+  h[22] = 1; h[23] = 0;              // Mono
+  wavPut32(h + 24, sampleRate);
+  wavPut32(h + 28, sampleRate * 2);
+  h[32] = 2; h[33] = 0;
+  h[34] = 16; h[35] = 0;
+  memcpy(h + 36, "data", 4);
+  wavPut32(h + 40, data);
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) return false;
+  bool ok = fwrite(h, 1, 44, f) == 44 && fwrite(samples.data(), 2, samples.size(), f) == samples.size();
+  return fclose(f) == 0 && ok;
+}
+
+// Reads the first channel of a 16-bit PCM WAV; walks the chunks, so extra chunks are fine
+inline bool readWav(const std::string& path, WavClip& clip) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  std::vector<uint8_t> b;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) b.insert(b.end(), buf, buf + n);
+  fclose(f);
+  auto u16 = [&](size_t p) { return (uint32_t)b[p] | (uint32_t)b[p + 1] << 8; };
+  auto u32 = [&](size_t p) { return u16(p) | u16(p + 2) << 16; };
+  if (b.size() < 12 || memcmp(&b[0], "RIFF", 4) || memcmp(&b[8], "WAVE", 4)) return false;
+  uint32_t channels = 0, bits = 0;
+  for (size_t p = 12; p + 8 <= b.size();) {
+    uint32_t len = u32(p + 4);
+    if (!memcmp(&b[p], "fmt ", 4) && p + 24 <= b.size()) {
+      channels = u16(p + 10);
+      clip.sampleRate = u32(p + 12);
+      bits = u16(p + 22);
+    } else if (!memcmp(&b[p], "data", 4)) {
+      if (bits != 16 || channels == 0) return false;
+      size_t end = std::min<size_t>(b.size(), p + 8 + len);
+      for (size_t q = p + 8; q + 2 * channels <= end; q += 2 * channels) clip.samples.push_back((int16_t)u16(q));
+      return true;
+    }
+    p += 8 + len + (len & 1);
+  }
+  return false;
+}
+
+// Every *.wav in dir, sorted by name
+inline std::vector<std::string> listWavs(const std::string& dir) {
+  std::vector<std::string> out;
+  DIR* d = opendir(dir.c_str());
+  if (!d) return out;
+  while (dirent* e = readdir(d)) {
+    std::string name = e->d_name;
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".wav") == 0) out.push_back(dir + "/" + name);
+  }
+  closedir(d);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+inline void makeDir(const std::string& dir) { mkdir(dir.c_str(), 0755); }
@@ -0,0 +1,417 @@
+#!/usr/bin/env python3
+"""
+KIKO - Sprite asset compiler
+
+Turns the PNG/GIF sources listed in assets/sprites/sprites.txt into
+Kiko/sprites.h: run-length / delta encoded frame sets that
+Kiko/sprite_decoder.h draws straight into the U8g2 tile buffer.
+
+  python3 tools/sprite_compiler.py            # rebuild Kiko/sprites.h
+  python3 tools/sprite_compiler.py --check    # fail if sprites.h is out of date
+
+Sources
+  - Lit pixels are bright and opaque (luminance >= 128, alpha >= 128).
+  - PNG: one frame, or a vertical strip of frames of the given height.
+  - GIF: every frame of the animation (frame delays come from the GIF
+    unless the manifest gives one).
+
+Encoding (per frame, bytes in U8g2 page order: 8 vertical pixels per byte,
+one page row of `width` bytes after another)
+  - First byte: 0 = key frame, 1 = delta (XOR with the previous frame).
+  - Then PackBits-style runs:
+      0x00-0x7F  c + 1 literal bytes follow
+      0x80-0xFF  the next byte repeated (c & 0x7F) + 2 times
+  - A delta is used when it is smaller than the key frame, with at most
+    MAX_DELTA_CHAIN deltas in a row so any frame decodes quickly.
+
+Every encoded frame is decoded again before the header is written and must
+match the source pixels byte for byte.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+MANIFEST = os.path.join(ROOT, "assets", "sprites", "sprites.txt")
+OUTPUT = os.path.join(ROOT, "Kiko", "sprites.h")
+
+MAX_DELTA_CHAIN = 7
+KEY, DELTA = 0, 1
+
+
+# ---------- Image loading ----------
+
+def _lit(r, g, b, a):
+    return a >= 128 and (r * 299 + g * 587 + b * 114) // 1000 >= 128
+
+
+def load_png(path):
+    """Returns (width, height, rows of 0/1)."""
+    data = open(path, "rb").read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    pos, idat, palette, trns = 8, b"", None, None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            w, h, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNGs are not supported" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bits = channels * depth
+    stride = (w * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    raw = zlib.decompress(idat)
+    rows, prev, p = [], bytearray(stride), 0
+    for _ in range(h):
+        ftype = raw[p]
+        line = bytearray(raw[p + 1:p + 1 + stride])
+        p += 1 + stride
+        for i in range(stride):
+            left = line[i - bpp] if i >= bpp else 0
+            up = prev[i]
+            ul = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif ftype == 4:
+                pa, pb, pc = abs(up - ul), abs(left - ul), abs(left + up - 2 * ul)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else ul)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+
+        def sample(i):
+            if depth == 8:
+                return line[i]
+            if depth == 16:
+                return line[2 * i]
+            per = 8 // depth
+            shift = 8 - depth * (i % per + 1)
+            return (line[i // per] >> shift) & ((1 << depth) - 1)
+
+        scale = 255 // ((1 << depth) - 1) if depth < 8 else 1
+        row = []
+        for x in range(w):
+            if ctype == 3:
+                idx = sample(x)
+                r, g, b = palette[idx]
+                a = trns[idx] if trns and idx < len(trns) else 255
+            else:
+                v = [sample(x * channels + c) * scale for c in range(channels)]
+                if ctype == 0:
+                    r = g = b = v[0]; a = 255
+                elif ctype == 4:
+                    r = g = b = v[0]; a = v[1]
+                elif ctype == 2:
+                    r, g, b = v; a = 255
+                else:
+                    r, g, b, a = v
+            row.append(1 if _lit(r, g, b, a) else 0)
+        rows.append(row)
+    return w, h, rows
+
+
+def _lzw_decode(data, min_size):
+    clear, end = 1 << min_size, (1 << min_size) + 1
+    size, table, out, prev = min_size + 1, None, [], None
+    bitbuf = nbits = 0
+    for byte in data:
+        bitbuf |= byte << nbits
+        nbits += 8
+        while nbits >= size:
+            code = bitbuf & ((1 << size) - 1)
+            bitbuf >>= size
+            nbits -= size
+            if code == clear:
+                table = [[i] for i in range(clear)] + [None, None]
+                size, prev = min_size + 1, None
+                continue
+            if code == end:
+                return out
+            if prev is None:
+                entry = table[code]
+            elif code < len(table):
+                entry = table[code]
+                table.append(prev + entry[:1])
+            else:
+                entry = prev + prev[:1]
+                table.append(entry)
+            out.extend(entry)
+            prev = entry
+            if len(table) == (1 << size) and size < 12:
+                size += 1
+    return out
+
+
+def load_gif(path):
+    """Returns (width, height, [(rows, delay_ms)]) with frames composited on the canvas."""
+    data = open(path, "rb").read()
+    if data[:3] != b"GIF":
+        raise ValueError("%s: not a GIF" % path)
+    w, h, flags = struct.unpack("<HHB", data[6:11])
+    pos = 13
+    gct = None
+    if flags & 0x80:
+        n = 2 << (flags & 7)
+        gct = [tuple(data[pos + 3 * i:pos + 3 * i + 3]) for i in range(n)]
+        pos += 3 * n
+    canvas = [[0] * w for _ in range(h)]
+    frames, delay, transparent, disposal = [], 0, None, 0
+
+    def sub_blocks(p):
+        out = b""
+        while data[p]:
+            out += data[p + 1:p + 1 + data[p]]
+            p += 1 + data[p]
+        return out, p + 1
+
+    while pos < len(data):
+        tag = data[pos]
+        if tag == 0x3B:
+            break
+        if tag == 0x21:
+            label = data[pos + 1]
+            body, pos = sub_blocks(pos + 2)
+            if label == 0xF9:
+                packed, d, t = struct.unpack("<BHB", body[:4])
+                delay, disposal = d * 10, (packed >> 2) & 7
+                transparent = t if packed & 1 else None
+            continue
+        if tag != 0x2C:
+            raise ValueError("%s: unexpected block 0x%02x" % (path, tag))
+        fx, fy, fw, fh, fflags = struct.unpack("<HHHHB", data[pos + 1:pos + 10])
+        pos += 10
+        table = gct
+        if fflags & 0x80:
+            n = 2 << (fflags & 7)
+            table = [tuple(data[pos + 3 * i:pos + 3 * i + 3]) for i in range(n)]
+            pos += 3 * n
+        min_size = data[pos]
+        body, pos = sub_blocks(pos + 1)
+        indices = _lzw_decode(body, min_size)
+        order = list(range(fh))
+        if fflags & 0x40:
+            order = list(range(0, fh, 8)) + list(range(4, fh, 8)) + list(range(2, fh, 4)) + list(range(1, fh, 2))
+        before = [row[:] for row in canvas]
+        for i, y in enumerate(order):
+            for x in range(fw):
+                idx = indices[i * fw + x]
+                if idx == transparent or fy + y >= h or fx + x >= w:
+                    continue
+                r, g, b = table[idx]
+                canvas[fy + y][fx + x] = 1 if _lit(r, g, b, 255) else 0
+        frames.append(([row[:] for row in canvas], delay))
+        if disposal == 2:
+            for y in range(fy, min(h, fy + fh)):
+                for x in range(fx, min(w, fx + fw)):
+                    canvas[y][x] = 0
+        elif disposal == 3:
+            canvas = before
+        delay, transparent, disposal = 0, None, 0
+    return w, h, frames
+
+
+# ---------- Encoding ----------
+
+def to_pages(rows, width, height):
+    """Pixel rows -> U8g2 page-order bytes (bit k of a byte is row page*8 + k)."""
+    out = bytearray()
+    for page in range(height // 8):
+        for x in range(width):
+            v = 0
+            for k in range(8):
+                if rows[page * 8 + k][x]:
+                    v |= 1 << k
+            out.append(v)
+    return bytes(out)
+
+
+def rle_encode(data):
+    out, i, n = bytearray(), 0, len(data)
+    literal = bytearray()
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    while i < n:
+        run = 1
+        while i + run < n and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            flush()
+            out.append(0x80 | (run - 2))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def rle_decode(stream, length):
+    out, p = bytearray(), 0
+    while p < len(stream):
+        c = stream[p]
+        p += 1
+        if c < 0x80:
+            out.extend(stream[p:p + c + 1])
+            p += c + 1
+        else:
+            out.extend(bytes([stream[p]]) * ((c & 0x7F) + 2))
+            p += 1
+    if len(out) != length:
+        raise AssertionError("decoded %d bytes, expected %d" % (len(out), length))
+    return bytes(out)
+
+
+def encode_frames(pages):
+    streams, prev, chain = [], None, 0
+    for cur in pages:
+        key = bytes([KEY]) + rle_encode(cur)
+        best = key
+        if prev is not None and chain < MAX_DELTA_CHAIN:
+            delta = bytes([DELTA]) + rle_encode(bytes(a ^ b for a, b in zip(prev, cur)))
+            if len(delta) < len(key):
+                best = delta
+        chain = chain + 1 if best[0] == DELTA else 0
+        streams.append(best)
+        prev = cur
+    return streams
+
+
+def verify(streams, pages):
+    """Reference decoder: every frame must come back byte for byte."""
+    prev = None
+    for i, (stream, expected) in enumerate(zip(streams, pages)):
+        body = rle_decode(stream[1:], len(expected))
+        frame = body if stream[0] == KEY else bytes(a ^ b for a, b in zip(prev, body))
+        if frame != expected:
+            raise AssertionError("frame %d does not decode to its source" % i)
+        prev = frame
+
+
+# ---------- Output ----------
+
+def c_bytes(data, indent="  ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def build():
+    assets = []
+    base = os.path.dirname(MANIFEST)
+    for line in open(MANIFEST):
+        line = line.split("#", 1)[0].split()
+        if not line:
+            continue
+        name, source = line[0], line[1]
+        frame_height = int(line[2]) if len(line) > 2 else 0
+        delay = int(line[3]) if len(line) > 3 else None
+        path = os.path.join(base, source)
+        if source.lower().endswith(".gif"):
+            w, h, gif_frames = load_gif(path)
+            frames = [rows for rows, _ in gif_frames]
+            if delay is None:
+                delay = gif_frames[0][1] if gif_frames else 0
+            frame_height = frame_height or h
+        else:
+            w, h, rows = load_png(path)
+            frame_height = frame_height or h
+            if h % frame_height:
+                raise ValueError("%s: height %d is not a multiple of %d" % (source, h, frame_height))
+            frames = [rows[i:i + frame_height] for i in range(0, h, frame_height)]
+        if frame_height % 8 or w > 255 or frame_height > 255 or len(frames) > 255:
+            raise ValueError("%s: frames must be at most 255x255 with a height that is a multiple of 8" % source)
+
+        pages = [to_pages(rows, w, frame_height) for rows in frames]
+        streams = encode_frames(pages)
+        verify(streams, pages)
+        assets.append({
+            "name": name, "source": source, "width": w, "height": frame_height,
+            "delay": delay or 0, "streams": streams,
+            "raw": len(frames) * ((w + 7) // 8) * frame_height,
+            "deltas": sum(1 for s in streams if s[0] == DELTA),
+        })
+    return assets
+
+
+def render(assets):
+    out = [
+        "/*",
+        "  Generated by tools/sprite_compiler.py from assets/sprites/sprites.txt.",
+        "  Do not edit; change the sources and run the compiler again.",
+        "",
+        "  %-16s %6s %6s %10s %8s" % ("sprite", "frames", "deltas", "XBM bytes", "encoded"),
+    ]
+    total_raw = total_enc = 0
+    for a in assets:
+        enc = sum(len(s) for s in a["streams"]) + 2 * (len(a["streams"]) + 1)
+        total_raw += a["raw"]
+        total_enc += enc
+        out.append("  %-16s %6d %6d %10d %8d" % (a["name"], len(a["streams"]), a["deltas"], a["raw"], enc))
+    out.append("  %-16s %6s %6s %10d %8d" % ("total", "", "", total_raw, total_enc))
+    out += ["*/", "#pragma once", "", '#include "sprite_decoder.h"', ""]
+    for a in assets:
+        offsets, pos = [], 0
+        for s in a["streams"]:
+            offsets.append(pos)
+            pos += len(s)
+        offsets.append(pos)
+        if pos > 0xFFFF:
+            raise ValueError("%s: more than 64 KB of encoded data" % a["name"])
+        out.append("// %s" % a["source"])
+        out.append("const uint8_t %s_data[] PROGMEM = {" % a["name"])
+        out.append(c_bytes(b"".join(a["streams"])))
+        out.append("};")
+        out.append("const uint16_t %s_offsets[] PROGMEM = {%s};" % (a["name"], ", ".join(map(str, offsets))))
+        out.append("const SpriteSet %s = {%d, %d, %d, %d, %s_offsets, %s_data};" % (
+            a["name"], a["width"], a["height"], len(a["streams"]), a["delay"], a["name"], a["name"]))
+        out.append("")
+    return "\n".join(out), total_raw, total_enc
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--check", action="store_true", help="fail if Kiko/sprites.h is out of date")
+    args = parser.parse_args()
+
+    text, raw, enc = render(build())
+    if args.check:
+        current = open(OUTPUT).read() if os.path.exists(OUTPUT) else ""
+        if current != text:
+            print("Kiko/sprites.h is out of date; run tools/sprite_compiler.py")
+            return 1
+        print("Kiko/sprites.h is up to date")
+        return 0
+    with open(OUTPUT, "w") as f:
+        f.write(text)
+    print("Wrote %s: %d bytes of sprites as %d (%d saved)" % (os.path.relpath(OUTPUT, ROOT), raw, enc, raw - enc))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
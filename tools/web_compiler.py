@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+KIKO - Dashboard asset compiler
+
+Turns the dashboard sources in assets/web/ into Kiko/web_assets.h: minified,
+gzipped blobs in flash that handleFile() sends as they are, with
+Content-Encoding: gzip and a strong ETag.
+
+  python3 tools/web_compiler.py            # rebuild Kiko/web_assets.h
+  python3 tools/web_compiler.py --check    # fail if web_assets.h is out of date
+
+Assets
+  - style.css and app.js are minified, gzipped and hashed first. index.html
+    refers to them as /style.css and /app.js; those references are rewritten
+    to /style.css?v=<hash>, so the browser may keep them for a year and a new
+    firmware changes the URL instead of waiting for the cache to expire.
+  - index.html is served at / under a fixed URL, so it is revalidated on
+    every load: If-None-Match with its ETag gets a 304 and no body.
+  - The ETag is the first 16 hex digits of the SHA-256 of the minified text.
+
+Minifying is conservative: comments and indentation go, and CSS loses the
+whitespace around braces, semicolons and commas. Strings are left alone.
+gzip output is deterministic (mtime 0), so --check is stable.
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCES = os.path.join(ROOT, "assets", "web")
+OUTPUT = os.path.join(ROOT, "Kiko", "web_assets.h")
+
+# Served path, source file, content type; referenced assets come before index.html
+ASSETS = [
+    ("/style.css", "style.css", "text/css"),
+    ("/app.js", "app.js", "application/javascript"),
+    ("/index.html", "index.html", "text/html"),
+]
+
+
+# ---------- Minifying ----------
+
+def _split_strings(text):
+    """Yields (is_string, chunk) so rewrites can skip quoted text."""
+    pos = 0
+    for m in re.finditer(r"\"(?:\\.|[^\"\\])*\"|'(?:\\.|[^'\\])*'", text):
+        if m.start() > pos:
+            yield False, text[pos:m.start()]
+        yield True, m.group(0)
+        pos = m.end()
+    if pos < len(text):
+        yield False, text[pos:]
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    out = []
+    for quoted, chunk in _split_strings(text):
+        if not quoted:
+            chunk = re.sub(r"\s+", " ", chunk)
+            chunk = re.sub(r" ?([{};,]) ?", r"\1", chunk)
+        out.append(chunk)
+    text = "".join(out).replace(";}", "}")
+    return text.strip()
+
+
+def minify_js(text):
+    # Line by line only: keeping the newlines keeps automatic semicolon insertion intact
+    lines = [l.strip() for l in text.split("\n")]
+    return "\n".join(l for l in lines if l and not l.startswith("//"))
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    lines = [l.strip() for l in text.split("\n")]
+    return "\n".join(l for l in lines if l)
+
+
+MINIFIERS = {"text/css": minify_css, "application/javascript": minify_js, "text/html": minify_html}
+
+
+# ---------- Building ----------
+
+def build():
+    assets, versions = [], {}
+    for path, source, content_type in ASSETS:
+        text = open(os.path.join(SOURCES, source), encoding="utf-8").read()
+        raw = len(text.encode("utf-8"))
+        if content_type == "text/html":
+            for ref, version in versions.items():
+                pattern = r"""((?:href|src)=")%s(")""" % re.escape(ref)
+                text, n = re.subn(pattern, r"\g<1>%s?v=%s\g<2>" % (ref, version), text)
+                if n == 0:
+                    raise ValueError("%s does not reference %s" % (source, ref))
+        minified = MINIFIERS[content_type](text).encode("utf-8")
+        version = hashlib.sha256(minified).hexdigest()[:16]
+        versions[path] = version
+        body = gzip.compress(minified, 9, mtime=0)
+        assets.append({
+            "path": path, "source": source, "type": content_type, "version": version,
+            "raw": raw, "minified": len(minified), "gzip": body,
+        })
+    # Referenced assets are the ones index.html links with ?v=
+    for a in assets:
+        a["versioned"] = a["type"] != "text/html"
+    return assets
+
+
+def c_bytes(data, per_line=16):
+    rows = []
+    for i in range(0, len(data), per_line):
+        rows.append("  " + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(rows)
+
+
+def c_name(path):
+    return "web_" + re.sub(r"[^0-9A-Za-z]", "_", path.strip("/"))
+
+
+def render(assets):
+    out = [
+        "/*",
+        "  Generated by tools/web_compiler.py from assets/web/.",
+        "  Do not edit; change the sources and run the compiler again.",
+        "",
+        "  %-12s %8s %8s %6s  %s" % ("asset", "source", "minified", "gzip", "etag"),
+    ]
+    total_raw = total_gz = 0
+    for a in assets:
+        total_raw += a["raw"]
+        total_gz += len(a["gzip"])
+        out.append("  %-12s %8d %8d %6d  %s" % (a["path"], a["raw"], a["minified"], len(a["gzip"]), a["version"]))
+    out.append("  %-12s %8d %8s %6d" % ("total", total_raw, "", total_gz))
+    out += [
+        "*/",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "  const char* path;",
+        "  const char* contentType;",
+        "  const char* etag;             // Quoted strong ETag",
+        "  const char* version;          // The same hash bare, as used in ?v= URLs",
+        "  bool versioned;               // Linked with ?v=, so it may be cached for good",
+        "  const uint8_t* data;          // gzip",
+        "  uint32_t length;",
+        "  uint32_t rawLength;           // Minified size before gzip",
+        "};",
+        "",
+    ]
+    for a in assets:
+        out.append("// %s" % a["source"])
+        out.append("const uint8_t %s_gz[] PROGMEM = {" % c_name(a["path"]))
+        out.append(c_bytes(a["gzip"]))
+        out.append("};")
+        out.append("")
+    out.append("const WebAsset WEB_ASSETS[] = {")
+    for a in assets:
+        out.append('  {"%s", "%s", "\\"%s\\"", "%s", %s, %s_gz, %d, %d},' % (
+            a["path"], a["type"], a["version"], a["version"], "true" if a["versioned"] else "false",
+            c_name(a["path"]), len(a["gzip"]), a["minified"]))
+    out.append("};")
+    out.append("const int WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    return "\n".join(out), total_raw, total_gz
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--check", action="store_true", help="fail if Kiko/web_assets.h is out of date")
+    args = parser.parse_args()
+
+    text, raw, gz = render(build())
+    if args.check:
+        current = open(OUTPUT).read() if os.path.exists(OUTPUT) else ""
+        if current != text:
+            print("Kiko/web_assets.h is out of date; run tools/web_compiler.py")
+            return 1
+        print("Kiko/web_assets.h is up to date")
+        return 0
+    with open(OUTPUT, "w") as f:
+        f.write(text)
+    print("Wrote %s: %d bytes of dashboard as %d gzipped (%d saved)" % (
+        os.path.relpath(OUTPUT, ROOT), raw, gz, raw - gz))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())